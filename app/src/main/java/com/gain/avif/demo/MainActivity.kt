@@ -14,6 +14,7 @@ import com.gain.avif.demo.composeviews.AVIFViewModel
 import com.gain.avif.demo.ui.navigation.EnterAnimation
 import com.gain.avif.demo.ui.navigation.NavigationScreen
 import com.gain.avif.demo.ui.theme.Libavif_androidTheme
+import com.gain.libavif.AvifCodec
 
 class MainActivity : ComponentActivity() {
     private val mAVIFViewModel: AVIFViewModel by viewModels()
@@ -42,4 +43,9 @@ class MainActivity : ComponentActivity() {
             }
         }
     }
-}
\ No newline at end of file
+
+    override fun onTrimMemory(level: Int) {
+        super.onTrimMemory(level)
+        AvifCodec.trimMemory(level)
+    }
+}
@@ -0,0 +1,397 @@
+#include "avif_codec.h"
+
+#include <string.h>
+
+#include "frame_buffer_pool.h"
+#include "gav1/decoder_settings.h"
+#include "image_cache.h"
+
+#if defined(__ANDROID__)
+#include <android/log.h>
+#define LOG_TAG "avif_jni"
+#define LOGE(...) \
+  ((void)__android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__))
+#else
+#include <stdio.h>
+#define LOGE(...) ((void)fprintf(stderr, __VA_ARGS__), (void)fputc('\n', stderr))
+#endif
+
+namespace avif_sample {
+
+namespace {
+
+// RAII wrapper class that properly frees the decoder related objects on
+// destruction.
+struct AvifDecoderWrapper {
+public:
+    AvifDecoderWrapper() = default;
+
+    // Not copyable or movable.
+    AvifDecoderWrapper(const AvifDecoderWrapper &) = delete;
+
+    AvifDecoderWrapper &operator=(const AvifDecoderWrapper &) = delete;
+
+    ~AvifDecoderWrapper() {
+        if (decoder != nullptr) {
+            avifDecoderDestroy(decoder);
+        }
+    }
+
+    avifDecoder *decoder = nullptr;
+};
+
+struct AvifEncoderWrapper {
+public:
+    AvifEncoderWrapper() = default;
+
+    // Not copyable or movable.
+    AvifEncoderWrapper(const AvifEncoderWrapper &) = delete;
+
+    AvifEncoderWrapper &operator=(const AvifEncoderWrapper &) = delete;
+
+    ~AvifEncoderWrapper() {
+        if (encoder != nullptr) {
+            avifEncoderDestroy(encoder);
+        }
+    }
+
+    avifEncoder *encoder = nullptr;
+};
+
+struct AvifImageWrapper {
+public:
+    explicit AvifImageWrapper(avifImage *image) : image(image) {}
+
+    // Not copyable or movable.
+    AvifImageWrapper(const AvifImageWrapper &) = delete;
+
+    AvifImageWrapper &operator=(const AvifImageWrapper &) = delete;
+
+    ~AvifImageWrapper() {
+        if (image != nullptr) {
+            avifImageDestroy(image);
+        }
+    }
+
+    avifImage *const image;
+};
+
+// libgav1 DecoderSettings::post_filter_mask for |quality|. SuperRes (bit 2)
+// is always kept because the size of the output depends on it.
+uint8_t GetPostFilterMask(DecodeQuality quality) {
+    switch (quality) {
+        case kDecodeQualityFast:
+            return 0x05;
+        case kDecodeQualityFastest:
+        case kDecodeQualityPreview:
+            return 0x04;
+        default:
+            return 0x1f;
+    }
+}
+
+// libgav1 DecoderSettings::preview_shift for |quality|.
+int GetPreviewShift(DecodeQuality quality) {
+    return quality == kDecodeQualityPreview ? 2 : 0;
+}
+
+avifChromaUpsampling GetChromaUpsampling(DecodeQuality quality) {
+    return quality == kDecodeQualityFull ? AVIF_CHROMA_UPSAMPLING_AUTOMATIC
+                                         : AVIF_CHROMA_UPSAMPLING_FASTEST;
+}
+
+// Applies a post filter mask, the preview downscaling, the core preference, the
+// memory limit and the FrameBufferPool to the libgav1 decoders that libavif creates on the calling
+// thread while in scope.
+class ScopedDecoderSettings {
+public:
+    ScopedDecoderSettings(uint8_t post_filter_mask, int preview_shift, bool prefer_fast_cores,
+                          size_t memory_limit)
+            : post_filter_mask_(post_filter_mask),
+              preview_shift_(preview_shift),
+              prefer_fast_cores_(prefer_fast_cores),
+              memory_limit_(memory_limit),
+              install_(post_filter_mask_ != 0x1f || preview_shift_ != 0 || prefer_fast_cores_ ||
+                       memory_limit_ != 0 ||
+                       FrameBufferPool::Global().backing() != kFrameBufferBackingDefault) {
+        if (install_) Libgav1SetDecoderSettingsCallback(Apply, this);
+    }
+
+    // Not copyable or movable.
+    ScopedDecoderSettings(const ScopedDecoderSettings &) = delete;
+
+    ScopedDecoderSettings &operator=(const ScopedDecoderSettings &) = delete;
+
+    ~ScopedDecoderSettings() {
+        if (install_) Libgav1SetDecoderSettingsCallback(nullptr, nullptr);
+    }
+
+private:
+    static void Apply(void *callback_private_data, Libgav1DecoderSettings *settings,
+                      Libgav1DecoderSettingsExtension *extension) {
+        const auto *const self = static_cast<ScopedDecoderSettings *>(callback_private_data);
+        settings->post_filter_mask = self->post_filter_mask_;
+        // libavif is prebuilt against the original Libgav1DecoderSettings, so the newer
+        // settings can only reach its decoders through the extension.
+        extension->preview_shift = self->preview_shift_;
+        extension->prefer_fast_cores = self->prefer_fast_cores_ ? 1 : 0;
+        extension->memory_limit = self->memory_limit_;
+        FrameBufferPool::Global().Install(settings);
+    }
+
+    const uint8_t post_filter_mask_;
+    const int preview_shift_;
+    const bool prefer_fast_cores_;
+    const size_t memory_limit_;
+    const bool install_;
+};
+
+void RecordDecoderStats(StatsCollector *collector, const avifDecoder *decoder) {
+    if (collector == nullptr || !collector->enabled() || decoder == nullptr) return;
+    CodecStats *const stats = collector->stats();
+    stats->color_obu_size = decoder->ioStats.colorOBUSize;
+    stats->alpha_obu_size = decoder->ioStats.alphaOBUSize;
+    stats->threads = decoder->maxThreads;
+}
+
+void RecordEncoderStats(StatsCollector *collector, const avifEncoder *encoder,
+                        const avifRWData &output) {
+    if (collector == nullptr || !collector->enabled() || encoder == nullptr) return;
+    CodecStats *const stats = collector->stats();
+    stats->color_obu_size = encoder->ioStats.colorOBUSize;
+    stats->alpha_obu_size = encoder->ioStats.alphaOBUSize;
+    stats->threads = encoder->maxThreads;
+    stats->bytes_written = output.size;
+}
+
+bool CreateDecoderAndParse(AvifDecoderWrapper *const decoder, const uint8_t *const buffer,
+                           size_t length, int max_threads,
+                           StatsCollector *const collector) {
+    StatsCollector::Scope scope(collector, kStageContainerParse);
+    decoder->decoder = avifDecoderCreate();
+    if (decoder->decoder == nullptr) {
+        LOGE("Failed to create AVIF Decoder.");
+        return false;
+    }
+    decoder->decoder->ignoreXMP = AVIF_TRUE;
+    decoder->decoder->ignoreExif = AVIF_TRUE;
+    decoder->decoder->maxThreads = max_threads;
+    avifResult res = avifDecoderSetIOMemory(decoder->decoder, buffer, length);
+    if (res != AVIF_RESULT_OK) {
+        LOGE("Failed to set AVIF IO to a memory reader.");
+        return false;
+    }
+    res = avifDecoderParse(decoder->decoder);
+    if (res != AVIF_RESULT_OK) {
+        LOGE("Failed to parse AVIF image: %s.", avifResultToString(res));
+        return false;
+    }
+    return true;
+}
+
+// Converts |image| into the pixels of |surface|.
+bool CopyImageToSurface(const avifImage *image, DecodeQuality quality, RgbSurface *surface,
+                        StatsCollector *const collector) {
+    // Ensure that the surface is large enough to store the decoded image.
+    if (surface->width() < image->width || surface->height() < image->height) {
+        LOGE("Surface is not large enough to fit the image. Surface %ux%u Image %ux%u.",
+             surface->width(), surface->height(), image->width, image->height);
+        return false;
+    }
+    RgbFormat format;
+    if (!surface->GetFormat(&format)) {
+        return false;
+    }
+    uint8_t *const pixels = surface->LockPixels();
+    if (pixels == nullptr) {
+        LOGE("Failed to lock surface pixels.");
+        return false;
+    }
+    avifRGBImage rgb_image;
+    avifRGBImageSetDefaults(&rgb_image, image);
+    rgb_image.chromaUpsampling = GetChromaUpsampling(quality);
+    if (format == kRgbFormatRgbaF16) {
+        rgb_image.depth = 16;
+        rgb_image.isFloat = AVIF_TRUE;
+    } else {
+        rgb_image.depth = 8;
+    }
+    rgb_image.pixels = pixels;
+    rgb_image.rowBytes = surface->stride();
+    avifResult res;
+    {
+        StatsCollector::Scope scope(collector, kStageYuvToRgb);
+        res = avifImageYUVToRGB(image, &rgb_image);
+    }
+    surface->UnlockPixels();
+    if (res != AVIF_RESULT_OK) {
+        LOGE("Failed to convert YUV Pixels to RGB. Status: %d", res);
+        return false;
+    }
+    return true;
+}
+
+bool EncodeImage(const avifImage *image, const EncodeOptions &options, avifRWData *output,
+                 StatsCollector *const collector) {
+    AvifEncoderWrapper encode;
+    encode.encoder = avifEncoderCreate();
+    if (encode.encoder == nullptr) {
+        LOGE("Failed to create AVIF Encoder.");
+        return false;
+    }
+    encode.encoder->maxThreads = options.max_threads;
+    encode.encoder->speed = AVIF_SPEED_FASTEST;
+    encode.encoder->maxQuantizer = 24;
+    encode.encoder->minQuantizer = 22;
+
+    // Call avifEncoderAddImage() for each image in your sequence
+    // Only set AVIF_ADD_IMAGE_FLAG_SINGLE if you're not encoding a sequence
+    // Use avifEncoderAddImageGrid() instead with an array of avifImage* to make a grid image
+    avifResult res;
+    {
+        StatsCollector::Scope scope(collector, kStageEncode);
+        res = avifEncoderAddImage(encode.encoder, image, 1, AVIF_ADD_IMAGE_FLAG_SINGLE);
+    }
+    if (res != AVIF_RESULT_OK) {
+        LOGE("Failed to add image to encoder: %s", avifResultToString(res));
+        return false;
+    }
+    {
+        StatsCollector::Scope scope(collector, kStageEncodeFinish);
+        res = avifEncoderFinish(encode.encoder, output);
+    }
+    RecordEncoderStats(collector, encode.encoder, *output);
+    if (res != AVIF_RESULT_OK) {
+        LOGE("Failed to finish encode: %s", avifResultToString(res));
+        avifRWDataFree(output);
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+bool IsAvifImage(const uint8_t *data, size_t length) {
+    const avifROData avif = {data, length};
+    return avifPeekCompatibleFileType(&avif);
+}
+
+bool GetImageInfo(const uint8_t *data, size_t length, ImageInfo *info,
+                  StatsCollector *collector) {
+    if (collector != nullptr && collector->enabled()) {
+        collector->stats()->bytes_read = length;
+    }
+    AvifDecoderWrapper decoder;
+    const bool parsed = CreateDecoderAndParse(&decoder, data, length, 1, collector);
+    RecordDecoderStats(collector, decoder.decoder);
+    if (!parsed) {
+        return false;
+    }
+    info->width = decoder.decoder->image->width;
+    info->height = decoder.decoder->image->height;
+    info->depth = decoder.decoder->image->depth;
+    return true;
+}
+
+bool DecodeToSurface(const uint8_t *data, size_t length, const DecodeOptions &options,
+                     RgbSurface *surface, StatsCollector *collector) {
+    const bool timed = collector != nullptr && collector->enabled();
+    if (timed) collector->stats()->bytes_read = length;
+    ImageCache &cache = ImageCache::Global();
+    const bool use_cache = options.use_cache && cache.enabled();
+    ImageCacheKey key = {};
+    if (use_cache) {
+        key = {HashEncodedData(data, length), length, surface->width(), surface->height(),
+               options.quality};
+        const ImageCache::ImagePtr cached = cache.Lookup(key);
+        if (cached != nullptr) {
+            if (timed) collector->stats()->cache_hit = true;
+            return CopyImageToSurface(cached.get(), options.quality, surface, collector);
+        }
+    }
+    ScopedDecoderSettings decoder_settings(GetPostFilterMask(options.quality),
+                                           GetPreviewShift(options.quality),
+                                           options.prefer_fast_cores, options.memory_limit);
+    AvifDecoderWrapper decoder;
+    if (!CreateDecoderAndParse(&decoder, data, length, options.max_threads, collector)) {
+        RecordDecoderStats(collector, decoder.decoder);
+        return false;
+    }
+    avifResult res;
+    {
+        StatsCollector::Scope scope(collector, kStageImageDecode);
+        res = avifDecoderNextImage(decoder.decoder);
+    }
+    RecordDecoderStats(collector, decoder.decoder);
+    if (res != AVIF_RESULT_OK) {
+        LOGE("Failed to decode AVIF image. Status: %d", res);
+        return false;
+    }
+    if (!CopyImageToSurface(decoder.decoder->image, options.quality, surface, collector)) {
+        return false;
+    }
+    if (use_cache) {
+        cache.Insert(key, decoder.decoder->image);
+    }
+    return true;
+}
+
+bool EncodeRgba8888(const uint8_t *pixels, int width, int height,
+                    const EncodeOptions &options, avifRWData *output,
+                    StatsCollector *collector) {
+    // these values dictate what goes into the final AVIF
+    AvifImageWrapper image(avifImageCreate(width, height, 8, AVIF_PIXEL_FORMAT_YUV444));
+    if (image.image == nullptr) {
+        LOGE("Failed to create AVIF image.");
+        return false;
+    }
+    avifRGBImage rgb;
+    memset(&rgb, 0, sizeof(rgb));
+    avifRGBImageSetDefaults(&rgb, image.image);
+    // The caller's pixels are tightly packed RGBA, which is exactly the
+    // default layout, so convert straight from them without a copy.
+    rgb.pixels = const_cast<uint8_t *>(pixels);
+    rgb.rowBytes = static_cast<uint32_t>(width) * avifRGBImagePixelSize(&rgb);
+
+    avifResult res;
+    {
+        StatsCollector::Scope scope(collector, kStageRgbToYuv);
+        res = avifImageRGBToYUV(image.image, &rgb);
+    }
+    if (res != AVIF_RESULT_OK) {
+        LOGE("Failed to convert to YUV(A): %s", avifResultToString(res));
+        return false;
+    }
+    return EncodeImage(image.image, options, output, collector);
+}
+
+bool EncodeY420(const uint8_t *y, const uint8_t *u, const uint8_t *v, int stride_y,
+                int stride_u, int stride_v, int width, int height,
+                const EncodeOptions &options, avifRWData *output,
+                StatsCollector *collector) {
+    // these values dictate what goes into the final AVIF
+    AvifImageWrapper image(avifImageCreate(width, height, 8, AVIF_PIXEL_FORMAT_YUV420));
+    if (image.image == nullptr) {
+        LOGE("Failed to create AVIF image.");
+        return false;
+    }
+    avifImageAllocatePlanes(image.image, AVIF_PLANES_YUV | AVIF_PLANES_A);
+
+    const int uv_width = (width + 1) / 2;
+    const int uv_height = (height + 1) / 2;
+    for (int row = 0; row < height; ++row) {
+        memcpy(image.image->yuvPlanes[AVIF_CHAN_Y] + row * image.image->yuvRowBytes[AVIF_CHAN_Y],
+               y + row * stride_y, width);
+    }
+    for (int row = 0; row < uv_height; ++row) {
+        memcpy(image.image->yuvPlanes[AVIF_CHAN_U] + row * image.image->yuvRowBytes[AVIF_CHAN_U],
+               u + row * stride_u, uv_width);
+        memcpy(image.image->yuvPlanes[AVIF_CHAN_V] + row * image.image->yuvRowBytes[AVIF_CHAN_V],
+               v + row * stride_v, uv_width);
+    }
+    memset(image.image->alphaPlane, 255, image.image->alphaRowBytes * image.image->height);
+
+    return EncodeImage(image.image, options, output, collector);
+}
+
+}  // namespace avif_sample
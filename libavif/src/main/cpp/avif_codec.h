@@ -0,0 +1,105 @@
+#ifndef AVIF_SAMPLE_AVIF_CODEC_H_
+#define AVIF_SAMPLE_AVIF_CODEC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "avif/avif.h"
+#include "codec_stats.h"
+
+// The decode and encode paths behind AvifCodec, free of JNI and Android
+// types so that they can also be built and benchmarked on a host.
+namespace avif_sample {
+
+enum RgbFormat {
+    kRgbFormatRgba8888,
+    kRgbFormatRgbaF16,
+};
+
+// Destination of a decode, e.g. an Android Bitmap or a plain memory buffer.
+class RgbSurface {
+public:
+    virtual ~RgbSurface() = default;
+
+    virtual uint32_t width() const = 0;
+    virtual uint32_t height() const = 0;
+    virtual uint32_t stride() const = 0;
+    // Returns false if the surface has a format this library cannot write.
+    virtual bool GetFormat(RgbFormat *format) const = 0;
+
+    // Returns the pixels, or nullptr on failure. Every successful call is
+    // paired with UnlockPixels().
+    virtual uint8_t *LockPixels() = 0;
+    virtual void UnlockPixels() = 0;
+};
+
+struct ImageInfo {
+    uint32_t width;
+    uint32_t height;
+    uint32_t depth;
+};
+
+// Decode speed versus fidelity. Keep in sync with the QUALITY_* constants of
+// AvifCodec.
+enum DecodeQuality {
+    // Bit exact output.
+    kDecodeQualityFull,
+    // Skips CDEF, loop restoration and film grain and uses the fastest chroma
+    // upsampling. Keeps deblocking, so block edges stay hidden.
+    kDecodeQualityFast,
+    // Also skips deblocking.
+    kDecodeQualityFastest,
+    // Like kDecodeQualityFastest, at a quarter of the width and height
+    // (rounded up), for thumbnails. Fails on grid images: libavif cannot
+    // stitch tiles that come out smaller than the grid.
+    kDecodeQualityPreview,
+    kNumDecodeQualities
+};
+
+struct DecodeOptions {
+    // avifDecoder::maxThreads.
+    int max_threads = 1;
+    // Whether to consult and fill ImageCache::Global().
+    bool use_cache = true;
+    // The AV1 post filters are only skipped when libavif decodes with libgav1.
+    DecodeQuality quality = kDecodeQualityFull;
+    // libgav1 DecoderSettings::prefer_fast_cores: pin the decoder threads to
+    // the fastest CPU clusters.
+    bool prefer_fast_cores = false;
+    // libgav1 DecoderSettings::memory_limit, in bytes per decoder. 0 means no
+    // limit.
+    size_t memory_limit = 0;
+};
+
+struct EncodeOptions {
+    // avifEncoder::maxThreads.
+    int max_threads = 64;
+};
+
+// Returns true if |data| looks like an AVIF file.
+bool IsAvifImage(const uint8_t *data, size_t length);
+
+// Parses the container and fills |info|. |collector| may be null.
+bool GetImageInfo(const uint8_t *data, size_t length, ImageInfo *info,
+                  StatsCollector *collector);
+
+// Decodes the first image in |data| into |surface|, which must be at least as
+// large as the image. |collector| may be null.
+bool DecodeToSurface(const uint8_t *data, size_t length, const DecodeOptions &options,
+                     RgbSurface *surface, StatsCollector *collector);
+
+// Encodes tightly packed RGBA pixels into |output|, which the caller frees
+// with avifRWDataFree(). |collector| may be null.
+bool EncodeRgba8888(const uint8_t *pixels, int width, int height,
+                    const EncodeOptions &options, avifRWData *output,
+                    StatsCollector *collector);
+
+// Encodes 8-bit 4:2:0 planes with the given strides into |output|.
+bool EncodeY420(const uint8_t *y, const uint8_t *u, const uint8_t *v, int stride_y,
+                int stride_u, int stride_v, int width, int height,
+                const EncodeOptions &options, avifRWData *output,
+                StatsCollector *collector);
+
+}  // namespace avif_sample
+
+#endif  // AVIF_SAMPLE_AVIF_CODEC_H_
@@ -0,0 +1,697 @@
+// Host benchmark for the decode and encode paths behind AvifCodec.
+//
+// Runs every AVIF file given on the command line (directories are scanned for
+// *.avif) through avif_sample::DecodeToSurface() -- the same code the JNI
+// layer calls, with a memory buffer in place of the Android Bitmap -- once per
+// requested decoder thread count and decode quality, and prints a JSON report
+// to stdout (or to --json=<path>). A human readable summary goes to stderr.
+//
+// Usage:
+//   avif_benchmark [--threads=1,2,4] [--iterations=20] [--warmup=2]
+//                  [--format=rgba8888|f16] [--quality=full,fast,fastest,preview]
+//                  [--encode] [--cache] [--max_cpu_tier=c|sse4|avx2|avx512]
+//                  [--frame_buffers=default|prefaulted|huge_pages] [--fast_cores]
+//                  [--memory_limit_mb=N] [--json=<path>] [--trace=<path>]
+//                  <file or directory>...
+//
+// --max_cpu_tier limits the libgav1 SIMD functions to the given instruction
+// set tier (and below), so that the tiers can be compared on one machine.
+//
+// --frame_buffers selects the FrameBufferPool backing of the libgav1 frames;
+// each run reports the page faults the pool avoided.
+//
+// --fast_cores pins the libgav1 worker threads to the fastest CPU clusters
+// (DecoderSettings::prefer_fast_cores), for big.LITTLE and multi-socket hosts.
+//
+// --memory_limit_mb caps the memory of each libgav1 decoder
+// (DecoderSettings::memory_limit); decodes that do not fit fail.
+//
+// --trace writes a Chrome trace of the libgav1 threads over all the runs
+// (chrome://tracing or https://ui.perfetto.dev), to see how the tile and post
+// filter jobs overlap and where threads wait. Use it with few iterations: the
+// most recent kTraceEvents events are kept.
+//
+// Runs at a quality other than full also report the PSNR of their RGB output
+// against a full quality decode (rgba8888 only), to weigh speed against
+// fidelity. Preview runs, whose output is smaller, are not compared.
+//
+// The corpus should cover the shapes that matter on device: small thumbnails
+// and full camera frames, 8 and 10 bit, 4:2:0 and 4:4:4, single and multi
+// tile, with and without alpha and film grain.
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "avif/avif.h"
+#include "avif_codec.h"
+#include "codec_stats.h"
+#include "frame_buffer_pool.h"
+#include "gav1/tracing.h"
+#include "image_cache.h"
+#include "memory_pool.h"
+#include "src/utils/cpu.h"
+
+namespace {
+
+using avif_sample::CodecStats;
+using avif_sample::StatsCollector;
+
+struct Options {
+    std::vector<int> thread_counts;
+    int iterations = 20;
+    int warmup = 2;
+    avif_sample::RgbFormat format = avif_sample::kRgbFormatRgba8888;
+    std::vector<avif_sample::DecodeQuality> qualities;
+    bool encode = false;
+    bool use_cache = false;
+    std::string max_cpu_tier = "avx512";
+    avif_sample::FrameBufferBacking frame_buffers = avif_sample::kFrameBufferBackingDefault;
+    bool prefer_fast_cores = false;
+    size_t memory_limit = 0;
+    std::string json_path;
+    std::string trace_path;
+    std::vector<std::string> inputs;
+};
+
+struct CorpusEntry {
+    std::string path;
+    std::vector<uint8_t> data;
+    avif_sample::ImageInfo info;
+    // Full quality rgba8888 decode, when a lower quality is benchmarked.
+    std::vector<uint8_t> reference_pixels;
+};
+
+// Result of running one corpus entry (or the whole corpus) at one thread
+// count.
+struct RunResult {
+    std::vector<double> latencies_ms;
+    double total_seconds = 0;
+    uint64_t pixels = 0;
+    int failures = 0;
+    // Sum of the per-call CodecStats, for the stage breakdown.
+    int64_t stage_wall_time_ns[avif_sample::kNumCodecStages] = {};
+    int64_t stage_cpu_time_ns[avif_sample::kNumCodecStages] = {};
+    int64_t cpu_time_ns = 0;
+    size_t peak_rss_bytes = 0;
+    size_t peak_pool_bytes = 0;
+    uint64_t page_faults_avoided = 0;
+    // Squared error of the RGB samples against CorpusEntry::reference_pixels.
+    double squared_error = 0;
+    uint64_t compared_samples = 0;
+};
+
+const char *const kStageNames[avif_sample::kNumCodecStages] = {
+        "container_parse", "av1_parse", "av1_tile_decode", "av1_deblock",
+        "av1_cdef", "av1_super_res", "av1_loop_restoration",
+        "av1_border_extension", "av1_film_grain", "av1_output",
+        "image_decode", "yuv_to_rgb", "rgb_to_yuv", "encode", "encode_finish",
+};
+
+constexpr int kTraceEvents = 1 << 20;
+
+const char *const kQualityNames[avif_sample::kNumDecodeQualities] = {"full", "fast", "fastest",
+                                                                     "preview"};
+
+const char *const kFrameBufferNames[avif_sample::kNumFrameBufferBackings] = {
+        "default", "prefaulted", "huge_pages"};
+
+class MemorySurface : public avif_sample::RgbSurface {
+public:
+    MemorySurface(uint32_t width, uint32_t height, avif_sample::RgbFormat format)
+            : width_(width),
+              height_(height),
+              stride_(width * (format == avif_sample::kRgbFormatRgbaF16 ? 8 : 4)),
+              format_(format),
+              pixels_(static_cast<size_t>(stride_) * height) {}
+
+    uint32_t width() const override { return width_; }
+    uint32_t height() const override { return height_; }
+    uint32_t stride() const override { return stride_; }
+
+    bool GetFormat(avif_sample::RgbFormat *format) const override {
+        *format = format_;
+        return true;
+    }
+
+    uint8_t *LockPixels() override { return pixels_.data(); }
+    void UnlockPixels() override {}
+
+    const uint8_t *pixels() const { return pixels_.data(); }
+
+private:
+    const uint32_t width_;
+    const uint32_t height_;
+    const uint32_t stride_;
+    const avif_sample::RgbFormat format_;
+    std::vector<uint8_t> pixels_;
+};
+
+double NowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Resets the kernel's peak RSS counter so that each run reports its own high
+// water mark. Not available in every container; the peak is then cumulative.
+void ResetPeakRss() {
+    FILE *const file = fopen("/proc/self/clear_refs", "w");
+    if (file == nullptr) return;
+    fputs("5", file);
+    fclose(file);
+}
+
+size_t ReadPeakRssBytes() {
+    FILE *const file = fopen("/proc/self/status", "r");
+    if (file == nullptr) return 0;
+    char line[256];
+    size_t kib = 0;
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        if (sscanf(line, "VmHWM: %zu kB", &kib) == 1) break;
+    }
+    fclose(file);
+    return kib * 1024;
+}
+
+double Percentile(std::vector<double> values, double percentile) {
+    if (values.empty()) return 0;
+    std::sort(values.begin(), values.end());
+    const size_t index = std::min(
+            values.size() - 1, static_cast<size_t>(percentile / 100.0 * values.size()));
+    return values[index];
+}
+
+bool ReadFile(const std::string &path, std::vector<uint8_t> *data) {
+    FILE *const file = fopen(path.c_str(), "rb");
+    if (file == nullptr) return false;
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    data->resize(size > 0 ? size : 0);
+    const bool ok = size > 0 && fread(data->data(), 1, data->size(), file) == data->size();
+    fclose(file);
+    return ok;
+}
+
+bool EndsWith(const std::string &s, const char *suffix) {
+    const size_t n = strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+void CollectInputs(const std::string &path, std::vector<std::string> *files) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        fprintf(stderr, "Cannot stat %s\n", path.c_str());
+        return;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        files->push_back(path);
+        return;
+    }
+    DIR *const dir = opendir(path.c_str());
+    if (dir == nullptr) return;
+    std::vector<std::string> entries;
+    while (const struct dirent *entry = readdir(dir)) {
+        const std::string name = entry->d_name;
+        if (name == "." || name == "..") continue;
+        const std::string child = path + "/" + name;
+        if (EndsWith(name, ".avif") || (stat(child.c_str(), &st) == 0 && S_ISDIR(st.st_mode))) {
+            entries.push_back(child);
+        }
+    }
+    closedir(dir);
+    std::sort(entries.begin(), entries.end());
+    for (const std::string &entry : entries) CollectInputs(entry, files);
+}
+
+std::vector<int> ParseIntList(const char *s) {
+    std::vector<int> values;
+    while (*s != '\0') {
+        char *end;
+        const long value = strtol(s, &end, 10);
+        if (end == s) break;
+        if (value > 0) values.push_back(static_cast<int>(value));
+        s = (*end == ',') ? end + 1 : end;
+    }
+    return values;
+}
+
+bool ParseQualityList(const char *s, std::vector<avif_sample::DecodeQuality> *qualities) {
+    while (*s != '\0') {
+        const char *end = strchr(s, ',');
+        if (end == nullptr) end = s + strlen(s);
+        int quality = 0;
+        while (quality < avif_sample::kNumDecodeQualities &&
+               (strlen(kQualityNames[quality]) != static_cast<size_t>(end - s) ||
+                strncmp(s, kQualityNames[quality], end - s) != 0)) {
+            ++quality;
+        }
+        if (quality == avif_sample::kNumDecodeQualities) return false;
+        qualities->push_back(static_cast<avif_sample::DecodeQuality>(quality));
+        s = (*end == ',') ? end + 1 : end;
+    }
+    return true;
+}
+
+// Returns the libgav1 CPU feature mask for |tier|, or 0 with |*ok| false if
+// |tier| is unknown.
+uint32_t CpuTierMask(const std::string &tier, bool *ok) {
+    *ok = true;
+    if (tier == "c") return 0;
+    if (tier == "sse4") return libgav1::kSSE2 | libgav1::kSSSE3 | libgav1::kSSE4_1;
+    if (tier == "avx2") {
+        return libgav1::kSSE2 | libgav1::kSSSE3 | libgav1::kSSE4_1 | libgav1::kAVX |
+               libgav1::kAVX2;
+    }
+    if (tier == "avx512") return ~0u;
+    *ok = false;
+    return 0;
+}
+
+bool ParseOptions(int argc, char **argv, Options *options) {
+    for (int i = 1; i < argc; ++i) {
+        const char *const arg = argv[i];
+        if (strncmp(arg, "--threads=", 10) == 0) {
+            options->thread_counts = ParseIntList(arg + 10);
+        } else if (strncmp(arg, "--iterations=", 13) == 0) {
+            options->iterations = atoi(arg + 13);
+        } else if (strncmp(arg, "--warmup=", 9) == 0) {
+            options->warmup = atoi(arg + 9);
+        } else if (strcmp(arg, "--format=rgba8888") == 0) {
+            options->format = avif_sample::kRgbFormatRgba8888;
+        } else if (strcmp(arg, "--format=f16") == 0) {
+            options->format = avif_sample::kRgbFormatRgbaF16;
+        } else if (strncmp(arg, "--quality=", 10) == 0) {
+            if (!ParseQualityList(arg + 10, &options->qualities)) {
+                fprintf(stderr, "Unknown quality in %s\n", arg);
+                return false;
+            }
+        } else if (strcmp(arg, "--encode") == 0) {
+            options->encode = true;
+        } else if (strcmp(arg, "--cache") == 0) {
+            options->use_cache = true;
+        } else if (strncmp(arg, "--max_cpu_tier=", 15) == 0) {
+            options->max_cpu_tier = arg + 15;
+            bool ok;
+            CpuTierMask(options->max_cpu_tier, &ok);
+            if (!ok) {
+                fprintf(stderr, "Unknown CPU tier %s\n", arg + 15);
+                return false;
+            }
+        } else if (strncmp(arg, "--frame_buffers=", 16) == 0) {
+            int backing = 0;
+            while (backing < avif_sample::kNumFrameBufferBackings &&
+                   strcmp(arg + 16, kFrameBufferNames[backing]) != 0) {
+                ++backing;
+            }
+            if (backing == avif_sample::kNumFrameBufferBackings) {
+                fprintf(stderr, "Unknown frame buffer backing %s\n", arg + 16);
+                return false;
+            }
+            options->frame_buffers = static_cast<avif_sample::FrameBufferBacking>(backing);
+        } else if (strcmp(arg, "--fast_cores") == 0) {
+            options->prefer_fast_cores = true;
+        } else if (strncmp(arg, "--memory_limit_mb=", 18) == 0) {
+            options->memory_limit = static_cast<size_t>(atoi(arg + 18)) * 1024 * 1024;
+        } else if (strncmp(arg, "--json=", 7) == 0) {
+            options->json_path = arg + 7;
+        } else if (strncmp(arg, "--trace=", 8) == 0) {
+            options->trace_path = arg + 8;
+        } else if (arg[0] == '-') {
+            fprintf(stderr, "Unknown option %s\n", arg);
+            return false;
+        } else {
+            options->inputs.push_back(arg);
+        }
+    }
+    if (options->thread_counts.empty()) options->thread_counts = {1, 2, 4};
+    if (options->qualities.empty()) options->qualities = {avif_sample::kDecodeQualityFull};
+    return !options->inputs.empty() && options->iterations > 0 && options->warmup >= 0;
+}
+
+void Accumulate(const CodecStats &stats, RunResult *result) {
+    for (int i = 0; i < avif_sample::kNumCodecStages; ++i) {
+        result->stage_wall_time_ns[i] += stats.wall_time_ns[i];
+        result->stage_cpu_time_ns[i] += stats.cpu_time_ns[i];
+    }
+    result->cpu_time_ns += stats.total_cpu_time_ns;
+}
+
+// Adds the squared error of the RGB samples of |pixels| against
+// |entry.reference_pixels| to |result|.
+void Compare(const CorpusEntry &entry, const uint8_t *pixels, RunResult *result) {
+    const size_t size = entry.reference_pixels.size();
+    for (size_t i = 0; i < size; ++i) {
+        if ((i & 3) == 3) continue;  // Alpha.
+        const int error = pixels[i] - entry.reference_pixels[i];
+        result->squared_error += error * error;
+        ++result->compared_samples;
+    }
+}
+
+// Decodes |entry| |options.warmup + options.iterations| times with |threads|
+// decoder threads at |quality| and records the timed iterations into
+// |result|.
+void RunDecode(const CorpusEntry &entry, int threads, avif_sample::DecodeQuality quality,
+               const Options &options, RunResult *result) {
+    avif_sample::DecodeOptions decode_options;
+    decode_options.max_threads = threads;
+    decode_options.use_cache = options.use_cache;
+    decode_options.quality = quality;
+    decode_options.prefer_fast_cores = options.prefer_fast_cores;
+    decode_options.memory_limit = options.memory_limit;
+    MemorySurface surface(entry.info.width, entry.info.height, options.format);
+    for (int i = 0; i < options.warmup + options.iterations; ++i) {
+        CodecStats stats;
+        const double start = NowSeconds();
+        bool ok;
+        {
+            StatsCollector collector(&stats);
+            ok = avif_sample::DecodeToSurface(entry.data.data(), entry.data.size(),
+                                              decode_options, &surface, &collector);
+        }
+        const double elapsed = NowSeconds() - start;
+        if (i < options.warmup) continue;
+        if (!ok) {
+            ++result->failures;
+            continue;
+        }
+        result->latencies_ms.push_back(elapsed * 1e3);
+        result->total_seconds += elapsed;
+        result->pixels += static_cast<uint64_t>(entry.info.width) * entry.info.height;
+        Accumulate(stats, result);
+    }
+    if (quality != avif_sample::kDecodeQualityFull &&
+        quality != avif_sample::kDecodeQualityPreview && !entry.reference_pixels.empty() &&
+        !result->latencies_ms.empty()) {
+        Compare(entry, surface.pixels(), result);
+    }
+}
+
+// Encodes the decoded pixels of |entry| back to AVIF.
+void RunEncode(const CorpusEntry &entry, int threads, const Options &options,
+               RunResult *result) {
+    MemorySurface surface(entry.info.width, entry.info.height, avif_sample::kRgbFormatRgba8888);
+    avif_sample::DecodeOptions decode_options;
+    decode_options.use_cache = false;
+    if (!avif_sample::DecodeToSurface(entry.data.data(), entry.data.size(), decode_options,
+                                      &surface, nullptr)) {
+        result->failures += options.iterations;
+        return;
+    }
+    avif_sample::EncodeOptions encode_options;
+    encode_options.max_threads = threads;
+    for (int i = 0; i < options.warmup + options.iterations; ++i) {
+        CodecStats stats;
+        avifRWData output = AVIF_DATA_EMPTY;
+        const double start = NowSeconds();
+        bool ok;
+        {
+            StatsCollector collector(&stats);
+            ok = avif_sample::EncodeRgba8888(surface.pixels(), entry.info.width,
+                                             entry.info.height, encode_options, &output,
+                                             &collector);
+        }
+        const double elapsed = NowSeconds() - start;
+        avifRWDataFree(&output);
+        if (i < options.warmup) continue;
+        if (!ok) {
+            ++result->failures;
+            continue;
+        }
+        result->latencies_ms.push_back(elapsed * 1e3);
+        result->total_seconds += elapsed;
+        result->pixels += static_cast<uint64_t>(entry.info.width) * entry.info.height;
+        Accumulate(stats, result);
+    }
+}
+
+void Merge(const RunResult &from, RunResult *to) {
+    to->latencies_ms.insert(to->latencies_ms.end(), from.latencies_ms.begin(),
+                            from.latencies_ms.end());
+    to->total_seconds += from.total_seconds;
+    to->pixels += from.pixels;
+    to->failures += from.failures;
+    for (int i = 0; i < avif_sample::kNumCodecStages; ++i) {
+        to->stage_wall_time_ns[i] += from.stage_wall_time_ns[i];
+        to->stage_cpu_time_ns[i] += from.stage_cpu_time_ns[i];
+    }
+    to->cpu_time_ns += from.cpu_time_ns;
+    to->peak_rss_bytes = std::max(to->peak_rss_bytes, from.peak_rss_bytes);
+    to->peak_pool_bytes = std::max(to->peak_pool_bytes, from.peak_pool_bytes);
+    to->page_faults_avoided += from.page_faults_avoided;
+    to->squared_error += from.squared_error;
+    to->compared_samples += from.compared_samples;
+}
+
+// Returns the PSNR of |result| against the full quality decode, or a negative
+// value if it was not compared and infinity if it matched exactly.
+double Psnr(const RunResult &result) {
+    if (result.compared_samples == 0) return -1;
+    if (result.squared_error == 0) return INFINITY;
+    return 10 * log10(255.0 * 255.0 * result.compared_samples / result.squared_error);
+}
+
+void WriteJsonString(FILE *out, const std::string &s) {
+    fputc('"', out);
+    for (const char c : s) {
+        if (c == '"' || c == '\\') {
+            fputc('\\', out);
+            fputc(c, out);
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            fprintf(out, "\\u%04x", c);
+        } else {
+            fputc(c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+void WriteResult(FILE *out, const RunResult &result, const char *indent) {
+    const size_t count = result.latencies_ms.size();
+    const double images_per_second = result.total_seconds > 0 ? count / result.total_seconds : 0;
+    const double megapixels_per_second =
+            result.total_seconds > 0 ? result.pixels / result.total_seconds / 1e6 : 0;
+    const double cpu_utilisation =
+            result.total_seconds > 0 ? result.cpu_time_ns * 1e-9 / result.total_seconds : 0;
+    fprintf(out, "%s\"iterations\": %zu,\n", indent, count);
+    fprintf(out, "%s\"failures\": %d,\n", indent, result.failures);
+    fprintf(out, "%s\"images_per_second\": %.3f,\n", indent, images_per_second);
+    fprintf(out, "%s\"megapixels_per_second\": %.3f,\n", indent, megapixels_per_second);
+    fprintf(out, "%s\"cpu_utilisation\": %.3f,\n", indent, cpu_utilisation);
+    fprintf(out, "%s\"latency_ms\": {\"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f, \"max\": %.3f},\n",
+            indent, Percentile(result.latencies_ms, 50), Percentile(result.latencies_ms, 90),
+            Percentile(result.latencies_ms, 99), Percentile(result.latencies_ms, 100));
+    fprintf(out, "%s\"peak_rss_bytes\": %zu,\n", indent, result.peak_rss_bytes);
+    fprintf(out, "%s\"peak_pool_bytes\": %zu,\n", indent, result.peak_pool_bytes);
+    fprintf(out, "%s\"page_faults_avoided\": %llu,\n", indent,
+            static_cast<unsigned long long>(result.page_faults_avoided));
+    const double psnr = Psnr(result);
+    if (psnr >= 0) {
+        // JSON has no infinity: an exact match is reported as null.
+        if (std::isinf(psnr)) {
+            fprintf(out, "%s\"psnr_db\": null,\n", indent);
+        } else {
+            fprintf(out, "%s\"psnr_db\": %.3f,\n", indent, psnr);
+        }
+    }
+    fprintf(out, "%s\"stage_mean_ms\": {", indent);
+    bool first = true;
+    for (int i = 0; i < avif_sample::kNumCodecStages; ++i) {
+        if (result.stage_wall_time_ns[i] == 0 || count == 0) continue;
+        fprintf(out, "%s\"%s\": {\"wall\": %.3f, \"cpu\": %.3f}", first ? "" : ", ",
+                kStageNames[i], result.stage_wall_time_ns[i] * 1e-6 / count,
+                result.stage_cpu_time_ns[i] * 1e-6 / count);
+        first = false;
+    }
+    fputc('}', out);
+}
+
+void PrintSummary(const char *mode, const char *quality, int threads, const RunResult &result) {
+    const size_t count = result.latencies_ms.size();
+    fprintf(stderr,
+            "%-6s %-7s threads=%-2d %8.2f img/s %8.2f MP/s  p50 %8.3f ms  p99 %8.3f ms  "
+            "peak RSS %6.1f MiB  failures %d",
+            mode, quality, threads, result.total_seconds > 0 ? count / result.total_seconds : 0,
+            result.total_seconds > 0 ? result.pixels / result.total_seconds / 1e6 : 0,
+            Percentile(result.latencies_ms, 50), Percentile(result.latencies_ms, 99),
+            result.peak_rss_bytes / (1024.0 * 1024.0), result.failures);
+    const double psnr = Psnr(result);
+    if (psnr >= 0) fprintf(stderr, "  PSNR %.2f dB", psnr);
+    fputc('\n', stderr);
+}
+
+// Stops tracing and writes the trace to |path|.
+bool WriteTrace(const std::string &path) {
+    libgav1::StopTracing();
+    std::vector<char> trace(libgav1::GetTraceJson(nullptr, 0) + 1);
+    libgav1::GetTraceJson(trace.data(), trace.size());
+    FILE *const file = fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        fprintf(stderr, "Cannot open %s\n", path.c_str());
+        return false;
+    }
+    fputs(trace.data(), file);
+    fclose(file);
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, &options)) {
+        fprintf(stderr,
+                "Usage: %s [--threads=1,2,4] [--iterations=N] [--warmup=N] "
+                "[--format=rgba8888|f16] [--quality=full,fast,fastest,preview] "
+                "[--encode] [--cache] "
+                "[--max_cpu_tier=c|sse4|avx2|avx512] "
+                "[--frame_buffers=default|prefaulted|huge_pages] [--fast_cores] "
+                "[--memory_limit_mb=N] [--json=<path>] [--trace=<path>] <file or directory>...\n",
+                argv[0]);
+        return 2;
+    }
+    avif_sample::InstallCodecAllocators();
+    avif_sample::FrameBufferPool::Global().SetBacking(options.frame_buffers);
+    // Must precede the first decode, which initializes the Dsp tables.
+    bool tier_ok;
+    libgav1::SetCpuFeatureMask(CpuTierMask(options.max_cpu_tier, &tier_ok));
+
+    std::vector<std::string> files;
+    for (const std::string &input : options.inputs) CollectInputs(input, &files);
+    std::vector<CorpusEntry> corpus;
+    for (const std::string &file : files) {
+        CorpusEntry entry;
+        entry.path = file;
+        if (!ReadFile(file, &entry.data) ||
+            !avif_sample::GetImageInfo(entry.data.data(), entry.data.size(), &entry.info,
+                                       nullptr)) {
+            fprintf(stderr, "Skipping %s: not a readable AVIF file.\n", file.c_str());
+            continue;
+        }
+        corpus.push_back(std::move(entry));
+    }
+    if (corpus.empty()) {
+        fprintf(stderr, "No AVIF files to benchmark.\n");
+        return 1;
+    }
+    const bool compare = options.format == avif_sample::kRgbFormatRgba8888 &&
+                         std::any_of(options.qualities.begin(), options.qualities.end(),
+                                     [](avif_sample::DecodeQuality quality) {
+                                         return quality != avif_sample::kDecodeQualityFull;
+                                     });
+    for (CorpusEntry &entry : corpus) {
+        if (!compare) break;
+        MemorySurface surface(entry.info.width, entry.info.height,
+                              avif_sample::kRgbFormatRgba8888);
+        avif_sample::DecodeOptions decode_options;
+        decode_options.use_cache = false;
+        if (avif_sample::DecodeToSurface(entry.data.data(), entry.data.size(), decode_options,
+                                         &surface, nullptr)) {
+            entry.reference_pixels.assign(
+                    surface.pixels(),
+                    surface.pixels() + static_cast<size_t>(surface.stride()) * surface.height());
+        }
+    }
+
+    FILE *out = stdout;
+    if (!options.json_path.empty()) {
+        out = fopen(options.json_path.c_str(), "w");
+        if (out == nullptr) {
+            fprintf(stderr, "Cannot open %s\n", options.json_path.c_str());
+            return 1;
+        }
+    }
+
+    fprintf(out, "{\n  \"libavif_version\": ");
+    WriteJsonString(out, avifVersion());
+    fprintf(out, ",\n  \"iterations\": %d,\n  \"warmup\": %d,\n  \"format\": \"%s\",\n",
+            options.iterations, options.warmup,
+            options.format == avif_sample::kRgbFormatRgbaF16 ? "f16" : "rgba8888");
+    fprintf(out, "  \"max_cpu_tier\": \"%s\",\n", options.max_cpu_tier.c_str());
+    fprintf(out, "  \"frame_buffers\": \"%s\",\n", kFrameBufferNames[options.frame_buffers]);
+    fprintf(out, "  \"fast_cores\": %s,\n", options.prefer_fast_cores ? "true" : "false");
+    fprintf(out, "  \"memory_limit\": %zu,\n", options.memory_limit);
+    fprintf(out, "  \"corpus\": [\n");
+    for (size_t i = 0; i < corpus.size(); ++i) {
+        fprintf(out, "    {\"path\": ");
+        WriteJsonString(out, corpus[i].path);
+        fprintf(out, ", \"bytes\": %zu, \"width\": %u, \"height\": %u, \"depth\": %u}%s\n",
+                corpus[i].data.size(), corpus[i].info.width, corpus[i].info.height,
+                corpus[i].info.depth, i + 1 < corpus.size() ? "," : "");
+    }
+    fprintf(out, "  ],\n  \"runs\": [\n");
+
+    if (!options.trace_path.empty() && !libgav1::StartTracing(kTraceEvents)) {
+        fprintf(stderr, "Cannot allocate the trace buffer.\n");
+        return 1;
+    }
+    const char *const modes[] = {"decode", "encode"};
+    const int num_modes = options.encode ? 2 : 1;
+    bool first_run = true;
+    for (int mode = 0; mode < num_modes; ++mode) {
+        // Encodes do not depend on the decode quality.
+        const std::vector<avif_sample::DecodeQuality> qualities =
+                (mode == 0) ? options.qualities
+                            : std::vector<avif_sample::DecodeQuality>{
+                                      avif_sample::kDecodeQualityFull};
+        for (const avif_sample::DecodeQuality quality : qualities) {
+            for (const int threads : options.thread_counts) {
+                RunResult total;
+                std::vector<RunResult> per_file(corpus.size());
+                for (size_t i = 0; i < corpus.size(); ++i) {
+                    avif_sample::ImageCache::Global().Clear();
+                    avif_sample::MemoryPool::Global().Trim();
+                    avif_sample::MemoryPool::Global().ResetPeak();
+                    avif_sample::FrameBufferPool::Global().Trim();
+                    const uint64_t page_faults_avoided = avif_sample::FrameBufferPool::Global()
+                                                                 .GetStats()
+                                                                 .page_faults_avoided;
+                    ResetPeakRss();
+                    if (mode == 0) {
+                        RunDecode(corpus[i], threads, quality, options, &per_file[i]);
+                    } else {
+                        RunEncode(corpus[i], threads, options, &per_file[i]);
+                    }
+                    per_file[i].peak_rss_bytes = ReadPeakRssBytes();
+                    per_file[i].peak_pool_bytes =
+                            avif_sample::MemoryPool::Global().GetStats().peak_bytes;
+                    per_file[i].page_faults_avoided =
+                            avif_sample::FrameBufferPool::Global().GetStats().page_faults_avoided -
+                            page_faults_avoided;
+                    Merge(per_file[i], &total);
+                }
+                PrintSummary(modes[mode], kQualityNames[quality], threads, total);
+
+                fprintf(out,
+                        "%s    {\n      \"mode\": \"%s\",\n      \"quality\": \"%s\",\n"
+                        "      \"threads\": %d,\n",
+                        first_run ? "" : ",\n", modes[mode], kQualityNames[quality], threads);
+                first_run = false;
+                WriteResult(out, total, "      ");
+                fprintf(out, ",\n      \"files\": [\n");
+                for (size_t i = 0; i < corpus.size(); ++i) {
+                    fprintf(out, "        {\n          \"path\": ");
+                    WriteJsonString(out, corpus[i].path);
+                    fprintf(out, ",\n");
+                    WriteResult(out, per_file[i], "          ");
+                    fprintf(out, "\n        }%s\n", i + 1 < corpus.size() ? "," : "");
+                }
+                fprintf(out, "      ]\n    }");
+            }
+        }
+    }
+    fprintf(out, "\n  ]\n}\n");
+    if (out != stdout) fclose(out);
+    if (!options.trace_path.empty() && !WriteTrace(options.trace_path)) return 1;
+    return 0;
+}
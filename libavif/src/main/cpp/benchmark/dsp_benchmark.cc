@@ -0,0 +1,1423 @@
+// Microbenchmark of the libgav1 dsp functions.
+//
+// Times the entries of the libgav1 Dsp tables at 8, 10 and 12 bits for every
+// instruction set tier that this build and CPU support (c, sse4, avx2 and
+// avx512 on x86, c and neon on Arm), and prints a JSON report to stdout (or to
+// --json=<path>) with the time and cycles per pixel of each function and its
+// speedup over the C function. A human readable summary goes to stderr. Run it
+// before and after a SIMD change, or on each new device, to track coverage and
+// catch regressions that a whole-image decode averages away.
+//
+// Usage:
+//   libgav1_dsp_benchmark [--filter=<substring>] [--bitdepths=8,10,12]
+//                         [--min_time_ms=20] [--json=<path>]
+//
+// A tier is only timed for the entries it replaces: an avx2 build that keeps
+// the sse4 function for an entry reports that entry under sse4 only. Entries
+// that take the block size as an argument are timed at a few sizes, given
+// after a '/' in the kernel name. For the motion vector kernels a "pixel" is
+// one motion vector, or one 8x8 block for the motion field projection.
+//
+// Cycles are read from the time stamp counter, which ticks at a constant
+// reference rate rather than the core clock, so they are only comparable on
+// one machine; they are null on other architectures. The coverage section
+// counts, for each tier, the Dsp table entries that are not C functions.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define DSP_BENCHMARK_HAS_TSC 1
+#else
+#define DSP_BENCHMARK_HAS_TSC 0
+#endif
+
+#include "src/dsp/dsp.h"
+#include "src/dsp/film_grain_common.h"
+#include "src/utils/array_2d.h"
+#include "src/utils/common.h"
+#include "src/utils/constants.h"
+#include "src/utils/cpu.h"
+#include "src/utils/memory.h"
+#include "src/utils/reference_info.h"
+#include "src/utils/types.h"
+
+namespace {
+
+using libgav1::dsp::Dsp;
+
+// Calls per timed batch. In-place kernels get this many copies of their input,
+// restored between batches outside of the timed section.
+constexpr int kBatch = 16;
+
+// Timed sections of reusable-input kernels are grown to at least this long, so
+// that the clock reads are negligible.
+constexpr int64_t kMinSectionNs = 20000;
+
+constexpr int kMinRounds = 3;
+
+// Stride, in pixels, of the generic destination blocks.
+constexpr int kBlockStride = 160;
+
+const char *const kTransformSizeNames[libgav1::kNumTransformSizes] = {
+        "4x4",   "4x8",   "4x16",  "8x4",   "8x8",   "8x16",  "8x32",
+        "16x4",  "16x8",  "16x16", "16x32", "16x64", "32x8",  "32x16",
+        "32x32", "32x64", "64x16", "64x32", "64x64"};
+
+const char *const kIntraPredictorNames[libgav1::dsp::kNumIntraPredictors] = {
+        "dc_fill", "dc_top",     "dc_left", "dc",
+        "vertical", "horizontal", "paeth",  "smooth",
+        "smooth_vertical", "smooth_horizontal"};
+
+const char *const kTransform1dNames[libgav1::dsp::kNumTransform1ds] = {"dct", "adst",
+                                                                       "identity", "wht"};
+
+const char *const kLoopFilterSizeNames[libgav1::dsp::kNumLoopFilterSizes] = {"4", "6", "8",
+                                                                            "14"};
+
+const char *const kLoopFilterTypeNames[libgav1::kNumLoopFilterTypes] = {"vertical",
+                                                                        "horizontal"};
+
+struct Tier {
+    const char *name;
+    // CpuFeatures for DspInitForCpuFeatures(). Unused by the c tier.
+    uint32_t features;
+};
+
+struct Options {
+    std::string filter;
+    std::vector<int> bitdepths;
+    double min_time_ms = 20;
+    std::string json_path;
+};
+
+struct Result {
+    int tier;
+    double ns_per_call;
+    // Negative when there is no cycle counter.
+    double cycles_per_call;
+};
+
+struct Kernel {
+    std::string name;
+    int bitdepth;
+    int pixels;
+    // The function of each tier, 0 where the table has none.
+    std::vector<uintptr_t> entries;
+    // Restores the inputs of in-place kernels. Empty if the inputs can be
+    // reused as they are.
+    std::function<void()> prepare;
+    // Makes kBatch calls of the function of each tier.
+    std::vector<std::function<void()>> batches;
+    std::vector<Result> results;
+};
+
+struct Coverage {
+    int bitdepth;
+    // Per tier: the non-null entries, and those that are not C functions.
+    std::vector<int> implemented;
+    std::vector<int> simd;
+};
+
+int64_t NowNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+uint64_t ReadCycleCounter() {
+#if DSP_BENCHMARK_HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// Deterministic inputs, so that runs are comparable.
+class Random {
+public:
+    explicit Random(uint32_t seed) : state_(seed) {}
+
+    uint32_t Next() {
+        state_ ^= state_ << 13;
+        state_ ^= state_ >> 17;
+        state_ ^= state_ << 5;
+        return state_;
+    }
+
+    // Returns a value in [min, max].
+    int Range(int min, int max) {
+        return min + static_cast<int>(Next() % static_cast<uint32_t>(max - min + 1));
+    }
+
+    template <typename T>
+    void Fill(T *data, size_t count, int min, int max) {
+        for (size_t i = 0; i < count; ++i) data[i] = static_cast<T>(Range(min, max));
+    }
+
+private:
+    uint32_t state_;
+};
+
+std::vector<Tier> GetTiers() {
+    std::vector<Tier> tiers;
+    tiers.push_back({"c", 0});
+#if LIBGAV1_ENABLE_SSE4_1 || LIBGAV1_ENABLE_AVX2
+    const uint32_t cpu_features = libgav1::GetCpuInfo();
+#if LIBGAV1_ENABLE_SSE4_1
+    const uint32_t sse4 = libgav1::kSSE2 | libgav1::kSSSE3 | libgav1::kSSE4_1;
+    if ((cpu_features & libgav1::kSSE4_1) != 0) tiers.push_back({"sse4", sse4});
+#endif
+#if LIBGAV1_ENABLE_AVX2
+    const uint32_t avx2 = libgav1::kSSE2 | libgav1::kSSSE3 | libgav1::kSSE4_1 |
+                          libgav1::kAVX | libgav1::kAVX2;
+    if ((cpu_features & libgav1::kAVX2) != 0) tiers.push_back({"avx2", avx2});
+#if LIBGAV1_ENABLE_AVX512
+    if ((cpu_features & libgav1::kAVX512) != 0) tiers.push_back({"avx512", ~0u});
+#endif
+#endif
+#endif  // LIBGAV1_ENABLE_SSE4_1 || LIBGAV1_ENABLE_AVX2
+#if LIBGAV1_ENABLE_NEON
+    tiers.push_back({"neon", ~0u});
+#endif
+    return tiers;
+}
+
+// Returns a copy of the |bitdepth| table as initialized for |tier|. The c tier
+// only has the C functions, also on NEON builds, where DspInit() always adds
+// the NEON functions.
+Dsp GetTable(const Tier &tier, int bitdepth) {
+    Dsp *const table = libgav1::dsp_internal::GetWritableDspTable(bitdepth);
+    *table = Dsp();
+    if (strcmp(tier.name, "c") == 0) {
+        libgav1::dsp_internal::DspInit_C();
+    } else {
+        libgav1::dsp_internal::DspInitForCpuFeatures(tier.features);
+    }
+    return *table;
+}
+
+// The Dsp struct only holds function pointers, so it can be compared entry by
+// entry as an array.
+static_assert(sizeof(Dsp) % sizeof(uintptr_t) == 0, "Dsp holds more than function pointers.");
+constexpr size_t kNumDspEntries = sizeof(Dsp) / sizeof(uintptr_t);
+
+Coverage GetCoverage(int bitdepth, const std::vector<Dsp> &tables) {
+    Coverage coverage;
+    coverage.bitdepth = bitdepth;
+    uintptr_t c_entries[kNumDspEntries];
+    memcpy(c_entries, &tables[0], sizeof(c_entries));
+    for (const Dsp &table : tables) {
+        uintptr_t entries[kNumDspEntries];
+        memcpy(entries, &table, sizeof(entries));
+        int implemented = 0;
+        int simd = 0;
+        for (size_t i = 0; i < kNumDspEntries; ++i) {
+            if (entries[i] == 0) continue;
+            ++implemented;
+            if (entries[i] != c_entries[i]) ++simd;
+        }
+        coverage.implemented.push_back(implemented);
+        coverage.simd.push_back(simd);
+    }
+    return coverage;
+}
+
+// Builds the kernels of one bitdepth and owns their buffers.
+class Registry {
+public:
+    Registry(int bitdepth, const std::vector<Dsp> &tables, const std::string &filter,
+             std::vector<Kernel> *kernels)
+            : bitdepth_(bitdepth), tables_(tables), filter_(filter), kernels_(kernels) {}
+
+    int bitdepth() const { return bitdepth_; }
+    int num_tiers() const { return static_cast<int>(tables_.size()); }
+    const Dsp &table(int tier) const { return tables_[tier]; }
+
+    // Returns zeroed memory for |count| elements, aligned for the SIMD
+    // functions, that lives as long as the registry.
+    template <typename T>
+    T *Allocate(size_t count) {
+        T *const memory =
+                static_cast<T *>(libgav1::AlignedAlloc(libgav1::kMaxAlignment, count * sizeof(T)));
+        if (memory == nullptr) abort();
+        memset(static_cast<void *>(memory), 0, count * sizeof(T));
+        owners_.push_back(std::shared_ptr<void>(memory, libgav1::AlignedDeleter()));
+        return memory;
+    }
+
+    // Returns a value initialized T that lives as long as the registry.
+    template <typename T>
+    T *Create() {
+        T *const object = new (std::nothrow) T();
+        if (object == nullptr) abort();
+        owners_.push_back(std::shared_ptr<T>(object));
+        return object;
+    }
+
+    // Adds the kernel |name|, which calls the entry that |select| returns from
+    // a table with |call|(entry, tier, index), |index| going over [0, kBatch).
+    // |pixels| is the number of pixels that one call produces.
+    template <typename Select, typename Call>
+    void Add(const std::string &name, int pixels, Select select, Call call,
+             std::function<void()> prepare = std::function<void()>()) {
+        if (!filter_.empty() && name.find(filter_) == std::string::npos) return;
+        Kernel kernel;
+        kernel.name = name;
+        kernel.bitdepth = bitdepth_;
+        kernel.pixels = pixels;
+        kernel.prepare = prepare;
+        bool any = false;
+        for (int tier = 0; tier < num_tiers(); ++tier) {
+            const auto func = select(tables_[tier]);
+            kernel.entries.push_back(reinterpret_cast<uintptr_t>(func));
+            if (func == nullptr) {
+                kernel.batches.push_back(std::function<void()>());
+                continue;
+            }
+            any = true;
+            kernel.batches.push_back([func, call, tier]() {
+                for (int i = 0; i < kBatch; ++i) call(func, tier, i);
+            });
+        }
+        if (any) kernels_->push_back(std::move(kernel));
+    }
+
+private:
+    const int bitdepth_;
+    const std::vector<Dsp> &tables_;
+    const std::string filter_;
+    std::vector<Kernel> *const kernels_;
+    std::vector<std::shared_ptr<void>> owners_;
+};
+
+std::string SizeName(int width, int height) {
+    return std::to_string(width) + "x" + std::to_string(height);
+}
+
+// Adds the kernels of every Dsp table entry, with the input conventions of the
+// dsp unit tests.
+template <int bitdepth, typename Pixel>
+class KernelSuite {
+public:
+    // Compound predictions: int16_t at 8 bits, uint16_t above.
+    typedef typename std::conditional<bitdepth == 8, int16_t, uint16_t>::type CompoundType;
+    typedef typename std::conditional<bitdepth == 8, int16_t, int32_t>::type Residual;
+    typedef typename std::conditional<bitdepth == 8, int8_t, int16_t>::type GrainType;
+    typedef typename std::conditional<bitdepth == 8, int8_t, int16_t>::type SuperResCoefficient;
+
+    static constexpr int kMaxPixel = (1 << bitdepth) - 1;
+    static constexpr int kCompoundMin = (bitdepth == 8) ? -5132 : (bitdepth == 10) ? 3988 : 3974;
+    static constexpr int kCompoundMax = (bitdepth == 8) ? 9212 : (bitdepth == 10) ? 61532 : 61559;
+    // Only the 10-bit film grain scaling table has an entry per pixel value.
+    static constexpr int kScalingLutShift = (bitdepth == 10) ? 2 : 0;
+
+    explicit KernelSuite(Registry *registry) : registry_(registry), random_(bitdepth) {}
+
+    void AddAll() {
+        AddIntraPredictors();
+        AddDirectionalPredictors();
+        AddCfl();
+        AddIntraEdge();
+        AddInverseTransforms();
+        AddLoopFilters();
+        AddCdef();
+        AddSuperRes();
+        AddLoopRestoration();
+        AddConvolve();
+        AddBlends();
+        AddObmc();
+        AddWarp();
+        AddFilmGrain();
+        // Only the 8-bit table entries are used for these.
+        if (bitdepth == 8) AddMotionVectorKernels();
+    }
+
+private:
+    Pixel *NewPixels(size_t count) {
+        Pixel *const pixels = registry_->Allocate<Pixel>(count);
+        random_.Fill(pixels, count, 0, kMaxPixel);
+        return pixels;
+    }
+
+    // Returns the destination block shared by the kernels that write pixels.
+    Pixel *Destination() {
+        if (destination_ == nullptr) {
+            destination_ = registry_->Allocate<Pixel>(kBlockStride * kBlockStride);
+        }
+        return destination_;
+    }
+
+    //--------------------------------------------------------------------------
+    // Intra prediction.
+
+    void AddIntraPredictors() {
+        // Edges with room for the top-left pixel, the above-right and
+        // below-left extensions, and over-reads.
+        Pixel *const top = NewPixels(320) + 32;
+        Pixel *const left = NewPixels(320) + 32;
+        Pixel *const dst = Destination();
+        const ptrdiff_t stride = kBlockStride * sizeof(Pixel);
+        for (int tx = 0; tx < libgav1::kNumTransformSizes; ++tx) {
+            const int pixels = libgav1::kTransformWidth[tx] * libgav1::kTransformHeight[tx];
+            for (int pred = 0; pred < libgav1::dsp::kNumIntraPredictors; ++pred) {
+                registry_->Add(
+                        std::string("intra_predictors[") + kTransformSizeNames[tx] + "][" +
+                                kIntraPredictorNames[pred] + "]",
+                        pixels,
+                        [tx, pred](const Dsp &dsp) { return dsp.intra_predictors[tx][pred]; },
+                        [=](libgav1::dsp::IntraPredictorFunc func, int, int) {
+                            func(dst, stride, top, left);
+                        });
+            }
+        }
+
+        for (int tx = 0; tx < libgav1::kNumTransformSizes; ++tx) {
+            const int width = libgav1::kTransformWidth[tx];
+            const int height = libgav1::kTransformHeight[tx];
+            if (width > 32 || height > 32) continue;
+            registry_->Add(
+                    std::string("filter_intra_predictor/") + kTransformSizeNames[tx],
+                    width * height,
+                    [](const Dsp &dsp) { return dsp.filter_intra_predictor; },
+                    [=](libgav1::dsp::FilterIntraPredictorFunc func, int, int) {
+                        func(dst, stride, top, left, libgav1::kFilterIntraPredictorPaeth, width,
+                             height);
+                    });
+        }
+    }
+
+    void AddDirectionalPredictors() {
+        Pixel *const top = NewPixels(320) + 32;
+        Pixel *const left = NewPixels(320) + 32;
+        Pixel *const dst = Destination();
+        const ptrdiff_t stride = kBlockStride * sizeof(Pixel);
+        // One angle in each zone, as in Tile::DirectionalPrediction(): 67, 157
+        // and 203 degrees.
+        const int step_67 = libgav1::kDirectionalIntraPredictorDerivative[67 / 2 - 1];
+        const int step_23 = libgav1::kDirectionalIntraPredictorDerivative[23 / 2 - 1];
+        for (int tx = 0; tx < libgav1::kNumTransformSizes; ++tx) {
+            const int width = libgav1::kTransformWidth[tx];
+            const int height = libgav1::kTransformHeight[tx];
+            const std::string size = kTransformSizeNames[tx];
+            registry_->Add(
+                    "directional_intra_predictor_zone1/" + size, width * height,
+                    [](const Dsp &dsp) { return dsp.directional_intra_predictor_zone1; },
+                    [=](libgav1::dsp::DirectionalIntraPredictorZone1Func func, int, int) {
+                        func(dst, stride, top, width, height, step_67, false);
+                    });
+            registry_->Add(
+                    "directional_intra_predictor_zone2/" + size, width * height,
+                    [](const Dsp &dsp) { return dsp.directional_intra_predictor_zone2; },
+                    [=](libgav1::dsp::DirectionalIntraPredictorZone2Func func, int, int) {
+                        func(dst, stride, top, left, width, height, step_23, step_67, false,
+                             false);
+                    });
+            registry_->Add(
+                    "directional_intra_predictor_zone3/" + size, width * height,
+                    [](const Dsp &dsp) { return dsp.directional_intra_predictor_zone3; },
+                    [=](libgav1::dsp::DirectionalIntraPredictorZone3Func func, int, int) {
+                        func(dst, stride, left, width, height, step_67, false);
+                    });
+        }
+    }
+
+    void AddCfl() {
+        typedef int16_t LumaBuffer[libgav1::kCflLumaBufferStride];
+        LumaBuffer *const luma = reinterpret_cast<LumaBuffer *>(registry_->Allocate<int16_t>(
+                libgav1::kCflLumaBufferStride * libgav1::kCflLumaBufferStride));
+        // The subsampled luma has 3 fractional bits, centered on the average.
+        random_.Fill(&luma[0][0],
+                     libgav1::kCflLumaBufferStride * libgav1::kCflLumaBufferStride,
+                     -(kMaxPixel << 2), kMaxPixel << 2);
+        // The luma source of the subsamplers, up to 64x64 at 4:2:0.
+        constexpr int kSourceStride = 80;
+        const Pixel *const source = NewPixels(kSourceStride * 80);
+        Pixel *const dst = Destination();
+        const ptrdiff_t stride = kBlockStride * sizeof(Pixel);
+        const char *const kSubsamplingNames[libgav1::kNumSubsamplingTypes] = {"444", "422",
+                                                                                  "420"};
+        for (int tx = 0; tx < libgav1::kNumTransformSizes; ++tx) {
+            const int width = libgav1::kTransformWidth[tx];
+            const int height = libgav1::kTransformHeight[tx];
+            registry_->Add(
+                    std::string("cfl_intra_predictors[") + kTransformSizeNames[tx] + "]",
+                    width * height,
+                    [tx](const Dsp &dsp) { return dsp.cfl_intra_predictors[tx]; },
+                    [=](libgav1::dsp::CflIntraPredictorFunc func, int, int) {
+                        func(dst, stride, luma, /*alpha=*/5);
+                    });
+            for (int ss = 0; ss < libgav1::kNumSubsamplingTypes; ++ss) {
+                // The visible luma, in chroma pixels except for the 4 wide or
+                // high blocks, as in the intra prediction of Tile.
+                const int luma_width = width << static_cast<int>(width == 4 && ss != 0);
+                const int luma_height = height << static_cast<int>(height == 4 && ss == 2);
+                registry_->Add(
+                        std::string("cfl_subsamplers[") + kTransformSizeNames[tx] + "][" +
+                                kSubsamplingNames[ss] + "]",
+                        width * height,
+                        [tx, ss](const Dsp &dsp) { return dsp.cfl_subsamplers[tx][ss]; },
+                        [=](libgav1::dsp::CflSubsamplerFunc func, int, int) {
+                            func(luma, luma_width, luma_height, source,
+                                 kSourceStride * sizeof(Pixel));
+                        });
+            }
+        }
+    }
+
+    void AddIntraEdge() {
+        // Filtered and upsampled in place: the values stay valid pixels.
+        Pixel *const edge = NewPixels(libgav1::kMaxSuperBlockSizeInPixels + 64) + 16;
+        const int kFilterSizes[] = {16, 64};
+        for (const int size : kFilterSizes) {
+            for (int strength = 1; strength <= 3; strength += 2) {
+                registry_->Add(
+                        "intra_edge_filter/size=" + std::to_string(size) +
+                                ",strength=" + std::to_string(strength),
+                        size, [](const Dsp &dsp) { return dsp.intra_edge_filter; },
+                        [=](libgav1::dsp::IntraEdgeFilterFunc func, int, int) {
+                            func(edge, size, strength);
+                        });
+            }
+        }
+        const int kUpsamplerSizes[] = {4, 8, 16};
+        for (const int size : kUpsamplerSizes) {
+            registry_->Add(
+                    "intra_edge_upsampler/size=" + std::to_string(size), 2 * size,
+                    [](const Dsp &dsp) { return dsp.intra_edge_upsampler; },
+                    [=](libgav1::dsp::IntraEdgeUpsamplerFunc func, int, int) {
+                        func(edge, size);
+                    });
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // Reconstruction.
+
+    void AddInverseTransforms() {
+        const libgav1::TransformSize kSquareSizes[libgav1::dsp::kNumTransform1dSizes] = {
+                libgav1::kTransformSize4x4, libgav1::kTransformSize8x8,
+                libgav1::kTransformSize16x16, libgav1::kTransformSize32x32,
+                libgav1::kTransformSize64x64};
+        // The walsh-hadamard functions are tested with kTransformTypeDctDct as
+        // well.
+        const libgav1::TransformType kTypes[libgav1::dsp::kNumTransform1ds] = {
+                libgav1::kTransformTypeDctDct, libgav1::kTransformTypeAdstAdst,
+                libgav1::kTransformTypeIdentityIdentity, libgav1::kTransformTypeDctDct};
+        constexpr int kResidualSize = 64 * 64;
+        Pixel *const frame_pixels = NewPixels(kResidualSize);
+        libgav1::Array2DView<Pixel> *const frame = registry_->Create<libgav1::Array2DView<Pixel>>();
+        frame->Reset(64, 64, frame_pixels);
+        for (int size = 0; size < libgav1::dsp::kNumTransform1dSizes; ++size) {
+            const libgav1::TransformSize tx_size = kSquareSizes[size];
+            const int width = libgav1::kTransformWidth[tx_size];
+            const int height = libgav1::kTransformHeight[tx_size];
+            // The residual is transformed in place: each call of a batch gets a
+            // copy of |original|. Only the top left 32x32 coefficients of the
+            // 64 point transforms can be non-zero. Limiting the coefficients to
+            // bitdepth + 1 bits keeps the transforms in range.
+            Residual *const original = registry_->Allocate<Residual>(kResidualSize);
+            for (int y = 0; y < std::min(height, 32); ++y) {
+                random_.Fill(original + y * width, std::min(width, 32), -(1 << bitdepth),
+                             (1 << bitdepth) - 1);
+            }
+            Residual *const copies = registry_->Allocate<Residual>(kBatch * kResidualSize);
+            const std::function<void()> prepare = [original, copies]() {
+                for (int i = 0; i < kBatch; ++i) {
+                    memcpy(copies + i * kResidualSize, original, sizeof(Residual) * kResidualSize);
+                }
+            };
+            const int adjusted_tx_height = std::min(height, 32);
+            for (int type = 0; type < libgav1::dsp::kNumTransform1ds; ++type) {
+                const libgav1::TransformType tx_type = kTypes[type];
+                for (int row_column = 0; row_column < 2; ++row_column) {
+                    registry_->Add(
+                            std::string("inverse_transforms[") + kTransform1dNames[type] + "][" +
+                                    std::to_string(4 << size) + "][" +
+                                    (row_column == libgav1::dsp::kRow ? "row" : "column") + "]",
+                            width * height,
+                            [type, size, row_column](const Dsp &dsp) {
+                                return dsp.inverse_transforms[type][size][row_column];
+                            },
+                            [=](libgav1::dsp::InverseTransformAddFunc func, int, int i) {
+                                func(tx_type, tx_size, adjusted_tx_height,
+                                     copies + i * kResidualSize, 0, 0, frame);
+                            },
+                            prepare);
+                }
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // Post filters.
+
+    void AddLoopFilters() {
+        // A smooth block with a step across both edges, so that every filter
+        // takes its full path. Filtering it in place keeps it smooth.
+        constexpr int kStride = 32;
+        Pixel *const block = registry_->Allocate<Pixel>(kStride * kStride);
+        for (int y = 0; y < kStride; ++y) {
+            for (int x = 0; x < kStride; ++x) {
+                const int value = 120 + ((x >= 8) ? 3 : 0) + ((y >= 8) ? 3 : 0) + random_.Range(0, 1);
+                block[y * kStride + x] = static_cast<Pixel>(value << (bitdepth - 8));
+            }
+        }
+        Pixel *const dst = block + 8 + 8 * kStride;
+        const ptrdiff_t stride = kStride * sizeof(Pixel);
+        for (int size = 0; size < libgav1::dsp::kNumLoopFilterSizes; ++size) {
+            for (int type = 0; type < libgav1::kNumLoopFilterTypes; ++type) {
+                const std::string index = std::string("[") + kLoopFilterSizeNames[size] + "][" +
+                                          kLoopFilterTypeNames[type] + "]";
+                const auto call = [=](libgav1::dsp::LoopFilterFunc func, int, int) {
+                    func(dst, stride, /*outer_thresh=*/60, /*inner_thresh=*/20,
+                         /*hev_thresh=*/2);
+                };
+                registry_->Add(
+                        "loop_filters" + index, 4,
+                        [size, type](const Dsp &dsp) { return dsp.loop_filters[size][type]; },
+                        call);
+                registry_->Add(
+                        "loop_filters_x2" + index, 8,
+                        [size, type](const Dsp &dsp) { return dsp.loop_filters_x2[size][type]; },
+                        call);
+            }
+        }
+    }
+
+    void AddCdef() {
+        const Pixel *const block = NewPixels(8 * kBlockStride);
+        registry_->Add(
+                "cdef_direction", 64, [](const Dsp &dsp) { return dsp.cdef_direction; },
+                [=](libgav1::dsp::CdefDirectionFunc func, int, int) {
+                    uint8_t direction;
+                    int variance;
+                    func(block, kBlockStride * sizeof(Pixel), &direction, &variance);
+                });
+
+        // The filter source is 16 bit with a 2 pixel border.
+        constexpr int kSourceStride = libgav1::kMaxSuperBlockSizeInPixels + 2 * 8;
+        uint16_t *const source_buffer = registry_->Allocate<uint16_t>(kSourceStride * 16);
+        random_.Fill(source_buffer, kSourceStride * 16, 0, kMaxPixel);
+        const uint16_t *const source = source_buffer + 2 * kSourceStride + 2;
+        Pixel *const dst = Destination();
+        const int primary = 4 << (bitdepth - 8);
+        const int secondary = 2 << (bitdepth - 8);
+        const char *const kStrengthNames[3] = {"both", "primary", "secondary"};
+        for (int width_index = 0; width_index < 2; ++width_index) {
+            const int size = 4 << width_index;
+            for (int strengths = 0; strengths < 3; ++strengths) {
+                const int primary_strength = (strengths == 2) ? 0 : primary;
+                const int secondary_strength = (strengths == 1) ? 0 : secondary;
+                registry_->Add(
+                        std::string("cdef_filters[") + std::to_string(size) + "][" +
+                                kStrengthNames[strengths] + "]",
+                        size * size,
+                        [width_index, strengths](const Dsp &dsp) {
+                            return dsp.cdef_filters[width_index][strengths];
+                        },
+                        [=](libgav1::dsp::CdefFilteringFunc func, int, int) {
+                            func(source, kSourceStride, size, primary_strength,
+                                 secondary_strength, /*damping=*/5, /*direction=*/3, dst,
+                                 kBlockStride * sizeof(Pixel));
+                        });
+            }
+        }
+    }
+
+    void AddSuperRes() {
+        constexpr int kDownscaledWidth = 96;
+        constexpr int kUpscaledWidth = 192;
+        constexpr int kHeight = 32;
+        constexpr int kStride =
+                (kUpscaledWidth + 2 * libgav1::kSuperResHorizontalBorder + 15) & ~15;
+        constexpr int kCoefficients = libgav1::kSuperResFilterTaps * kUpscaledWidth;
+        // As in PostFilter::ApplySuperRes().
+        const int superres_width = kDownscaledWidth << libgav1::kSuperResScaleBits;
+        const int step = (superres_width + kUpscaledWidth / 2) / kUpscaledWidth;
+        const int error = step * kUpscaledWidth - superres_width;
+        const int initial_subpixel_x =
+                ((-((kUpscaledWidth - kDownscaledWidth) << (libgav1::kSuperResScaleBits - 1)) +
+                  kUpscaledWidth / 2) /
+                         kUpscaledWidth +
+                 (1 << (libgav1::kSuperResExtraBits - 1)) - error / 2) &
+                libgav1::kSuperResScaleMask;
+        // The coefficients are in the layout of each tier's own
+        // super_res_coefficients function.
+        SuperResCoefficient *const coefficients =
+                registry_->Allocate<SuperResCoefficient>(kCoefficients * registry_->num_tiers());
+        for (int tier = 0; tier < registry_->num_tiers(); ++tier) {
+            const libgav1::dsp::SuperResCoefficientsFunc func =
+                    registry_->table(tier).super_res_coefficients;
+            if (func != nullptr) {
+                func(kUpscaledWidth, initial_subpixel_x, step, coefficients + tier * kCoefficients);
+            }
+        }
+        registry_->Add(
+                "super_res_coefficients", kUpscaledWidth,
+                [](const Dsp &dsp) { return dsp.super_res_coefficients; },
+                [=](libgav1::dsp::SuperResCoefficientsFunc func, int tier, int) {
+                    func(kUpscaledWidth, initial_subpixel_x, step,
+                         coefficients + tier * kCoefficients);
+                });
+        // The source rows are extended in place into their borders.
+        Pixel *const source = NewPixels(kStride * kHeight) + libgav1::kSuperResHorizontalBorder;
+        Pixel *const dest = registry_->Allocate<Pixel>(kStride * kHeight);
+        registry_->Add(
+                "super_res/" + SizeName(kDownscaledWidth, kHeight) + "->" +
+                        SizeName(kUpscaledWidth, kHeight),
+                kUpscaledWidth * kHeight, [](const Dsp &dsp) { return dsp.super_res; },
+                [=](libgav1::dsp::SuperResFunc func, int tier, int) {
+                    func(coefficients + tier * kCoefficients, source, kStride, kHeight,
+                         kDownscaledWidth, kUpscaledWidth, initial_subpixel_x, step, dest,
+                         kStride);
+                });
+    }
+
+    void AddLoopRestoration() {
+        constexpr int kWidth = 128;
+        constexpr int kHeight = 64;
+        constexpr int kBorder = 16;
+        constexpr int kStride = kWidth + 2 * kBorder;
+        constexpr int kSize = (kHeight + 2 * kBorder) * kStride;
+        const Pixel *const source = NewPixels(kSize) + kBorder * kStride + kBorder;
+        Pixel *const dest = registry_->Allocate<Pixel>(kSize) + kBorder * kStride + kBorder;
+        const Pixel *const top_border = source - libgav1::kRestorationVerticalBorder * kStride;
+        const Pixel *const bottom_border = source + kHeight * kStride;
+        libgav1::RestorationBuffer *const buffer =
+                registry_->Allocate<libgav1::RestorationBuffer>(1);
+        const std::string size = SizeName(kWidth, kHeight);
+
+        libgav1::RestorationUnitInfo *const wiener =
+                registry_->Create<libgav1::RestorationUnitInfo>();
+        wiener->type = libgav1::kLoopRestorationTypeWiener;
+        for (int i = libgav1::WienerInfo::kVertical; i <= libgav1::WienerInfo::kHorizontal; ++i) {
+            int16_t *const filter = wiener->wiener_info.filter[i];
+            filter[0] = 3;
+            filter[1] = -7;
+            filter[2] = 15;
+            filter[3] = 128 - 2 * (filter[0] + filter[1] + filter[2]);
+            wiener->wiener_info.number_leading_zero_coefficients[i] = 0;
+        }
+        registry_->Add(
+                "loop_restorations[wiener]/" + size, kWidth * kHeight,
+                [](const Dsp &dsp) { return dsp.loop_restorations[0]; },
+                [=](libgav1::dsp::LoopRestorationFunc func, int, int) {
+                    func(*wiener, source, kStride, top_border, kStride, bottom_border, kStride,
+                         kWidth, kHeight, buffer, dest);
+                });
+
+        // Both passes (radii 2 and 1), then each pass on its own, as in the
+        // loop restoration test.
+        const int kSgrIndices[3] = {0, 10, 14};
+        const char *const kSgrPasses[3] = {"both", "r1", "r2"};
+        for (int i = 0; i < 3; ++i) {
+            libgav1::RestorationUnitInfo *const sgr =
+                    registry_->Create<libgav1::RestorationUnitInfo>();
+            sgr->type = libgav1::kLoopRestorationTypeSgrProj;
+            sgr->sgr_proj_info.index = kSgrIndices[i];
+            sgr->sgr_proj_info.multiplier[0] =
+                    (libgav1::kSgrProjParams[kSgrIndices[i]][0] == 0) ? 0 : -20;
+            sgr->sgr_proj_info.multiplier[1] =
+                    (libgav1::kSgrProjParams[kSgrIndices[i]][2] == 0) ? 95 : 40;
+            registry_->Add(
+                    std::string("loop_restorations[sgr]/") + size + "," + kSgrPasses[i],
+                    kWidth * kHeight, [](const Dsp &dsp) { return dsp.loop_restorations[1]; },
+                    [=](libgav1::dsp::LoopRestorationFunc func, int, int) {
+                        func(*sgr, source, kStride, top_border, kStride, bottom_border, kStride,
+                             kWidth, kHeight, buffer, dest);
+                    });
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // Inter prediction.
+
+    void AddConvolve() {
+        // Room for 2:1 scaled 64x64 blocks and the filter taps.
+        constexpr int kReferenceStride = 2 * libgav1::kMaxSuperBlockSizeInPixels + 32;
+        const Pixel *const reference =
+                NewPixels(kReferenceStride * kReferenceStride) + 8 * kReferenceStride + 8;
+        const ptrdiff_t reference_stride = kReferenceStride * sizeof(Pixel);
+        Pixel *const dst = Destination();
+        const ptrdiff_t dst_stride = kBlockStride * sizeof(Pixel);
+        uint16_t *const compound_dst = registry_->Allocate<uint16_t>(
+                libgav1::kMaxSuperBlockSizeInPixels * libgav1::kMaxSuperBlockSizeInPixels);
+
+        const int kSizes[] = {4, 16, 64};
+        for (const int size : kSizes) {
+            // The 4 tap filters are used for dimensions of 4 or less.
+            const int filter_index = (size <= 4) ? 4 : 0;
+            for (int ibc = 0; ibc < 2; ++ibc) {
+                for (int compound = 0; compound < 2; ++compound) {
+                    for (int vertical = 0; vertical < 2; ++vertical) {
+                        for (int horizontal = 0; horizontal < 2; ++horizontal) {
+                            void *const prediction =
+                                    compound ? static_cast<void *>(compound_dst) : dst;
+                            const ptrdiff_t prediction_stride = compound ? size : dst_stride;
+                            const int horizontal_id = horizontal ? 8 : 0;
+                            const int vertical_id = vertical ? 8 : 0;
+                            registry_->Add(
+                                    "convolve[" + std::to_string(ibc) + "][" +
+                                            std::to_string(compound) + "][" +
+                                            std::to_string(vertical) + "][" +
+                                            std::to_string(horizontal) + "]/" +
+                                            SizeName(size, size),
+                                    size * size,
+                                    [ibc, compound, vertical, horizontal](const Dsp &dsp) {
+                                        return dsp.convolve[ibc][compound][vertical][horizontal];
+                                    },
+                                    [=](libgav1::dsp::ConvolveFunc func, int, int) {
+                                        func(reference, reference_stride, filter_index,
+                                             filter_index, horizontal_id, vertical_id, size, size,
+                                             prediction, prediction_stride);
+                                    });
+                        }
+                    }
+                }
+            }
+        }
+
+        const int kScaleSizes[] = {8, 32, 64};
+        for (const int size : kScaleSizes) {
+            const int filter_index = (size <= 4) ? 4 : 0;
+            for (int compound = 0; compound < 2; ++compound) {
+                void *const prediction = compound ? static_cast<void *>(compound_dst) : dst;
+                const ptrdiff_t prediction_stride = compound ? size : dst_stride;
+                // A 2:1 downscale, with steps in units of 1/1024 pixel.
+                registry_->Add(
+                        "convolve_scale[" + std::to_string(compound) + "]/" + SizeName(size, size),
+                        size * size,
+                        [compound](const Dsp &dsp) { return dsp.convolve_scale[compound]; },
+                        [=](libgav1::dsp::ConvolveScaleFunc func, int, int) {
+                            func(reference, reference_stride, filter_index, filter_index,
+                                 /*subpixel_x=*/0, /*subpixel_y=*/0, /*step_x=*/2048,
+                                 /*step_y=*/2048, size, size, prediction, prediction_stride);
+                        });
+            }
+        }
+    }
+
+    CompoundType *NewPrediction(int min, int max) {
+        constexpr int kSize = libgav1::kMaxSuperBlockSizeInPixels * libgav1::kMaxSuperBlockSizeInPixels;
+        CompoundType *const prediction = registry_->Allocate<CompoundType>(kSize);
+        random_.Fill(prediction, kSize, min, max);
+        return prediction;
+    }
+
+    void AddBlends() {
+        const CompoundType *const prediction_0 = NewPrediction(kCompoundMin, kCompoundMax);
+        const CompoundType *const prediction_1 = NewPrediction(kCompoundMin, kCompoundMax);
+        Pixel *const dst = Destination();
+        const ptrdiff_t dst_stride = kBlockStride * sizeof(Pixel);
+
+        const int kSizes[] = {8, 32, 128};
+        for (const int size : kSizes) {
+            registry_->Add(
+                    "average_blend/" + SizeName(size, size), size * size,
+                    [](const Dsp &dsp) { return dsp.average_blend; },
+                    [=](libgav1::dsp::AverageBlendFunc func, int, int) {
+                        func(prediction_0, prediction_1, size, size, dst, dst_stride);
+                    });
+            registry_->Add(
+                    "distance_weighted_blend/" + SizeName(size, size), size * size,
+                    [](const Dsp &dsp) { return dsp.distance_weighted_blend; },
+                    [=](libgav1::dsp::DistanceWeightedBlendFunc func, int, int) {
+                        func(prediction_0, prediction_1, /*weight_0=*/11, /*weight_1=*/5, size,
+                             size, dst, dst_stride);
+                    });
+        }
+
+        constexpr int kMaskStride = libgav1::kMaxSuperBlockSizeInPixels;
+        uint8_t *const mask = registry_->Allocate<uint8_t>(kMaskStride * kMaskStride);
+        random_.Fill(mask, kMaskStride * kMaskStride, 0, 64);
+        for (int width_index = 1; width_index < 6; ++width_index) {
+            for (int height_index = 1; height_index < 6; ++height_index) {
+                const int width = 4 << width_index;
+                const int height = 4 << height_index;
+                for (int inverse = 0; inverse < 2; ++inverse) {
+                    registry_->Add(
+                            "weight_mask[" + SizeName(width, height) + "][" +
+                                    std::to_string(inverse) + "]",
+                            width * height,
+                            [width_index, height_index, inverse](const Dsp &dsp) {
+                                return dsp.weight_mask[width_index][height_index][inverse];
+                            },
+                            [=](libgav1::dsp::WeightMaskFunc func, int, int) {
+                                func(prediction_0, prediction_1, mask, kMaskStride);
+                            });
+                }
+            }
+        }
+
+        // Inter-intra blends take pixels rather than compound predictions.
+        const CompoundType *const inter = NewPrediction(0, kMaxPixel);
+        const CompoundType *const intra = NewPrediction(0, kMaxPixel);
+        const int kMaskBlendSizes[] = {8, 32};
+        for (const int size : kMaskBlendSizes) {
+            for (int subsampling = 0; subsampling < 3; ++subsampling) {
+                for (int inter_intra = 0; inter_intra < 2; ++inter_intra) {
+                    const CompoundType *const source_0 = inter_intra ? inter : prediction_0;
+                    const CompoundType *const source_1 = inter_intra ? intra : prediction_1;
+                    registry_->Add(
+                            "mask_blend[" + std::to_string(subsampling) + "][" +
+                                    std::to_string(inter_intra) + "]/" + SizeName(size, size),
+                            size * size,
+                            [subsampling, inter_intra](const Dsp &dsp) {
+                                return dsp.mask_blend[subsampling][inter_intra];
+                            },
+                            [=](libgav1::dsp::MaskBlendFunc func, int, int) {
+                                func(source_0, source_1, size, mask, kMaskStride, size, size, dst,
+                                     dst_stride);
+                            });
+                }
+            }
+        }
+        if (bitdepth != 8) return;
+        uint8_t *const inter_8bpp = registry_->Allocate<uint8_t>(kMaskStride * kMaskStride);
+        uint8_t *const intra_8bpp = registry_->Allocate<uint8_t>(kMaskStride * kMaskStride);
+        random_.Fill(inter_8bpp, kMaskStride * kMaskStride, 0, 255);
+        random_.Fill(intra_8bpp, kMaskStride * kMaskStride, 0, 255);
+        for (const int size : kMaskBlendSizes) {
+            for (int index = 0; index < 3; ++index) {
+                // |intra_8bpp| is also the output.
+                registry_->Add(
+                        "inter_intra_mask_blend_8bpp[" + std::to_string(index) + "]/" +
+                                SizeName(size, size),
+                        size * size,
+                        [index](const Dsp &dsp) { return dsp.inter_intra_mask_blend_8bpp[index]; },
+                        [=](libgav1::dsp::InterIntraMaskBlendFunc8bpp func, int, int) {
+                            func(inter_8bpp, intra_8bpp, size, mask, kMaskStride, size, size);
+                        });
+            }
+        }
+    }
+
+    void AddObmc() {
+        // Blended in place: the values stay valid pixels.
+        Pixel *const prediction = NewPixels(kBlockStride * 64);
+        const Pixel *const obmc_prediction = NewPixels(kBlockStride * 64);
+        const ptrdiff_t stride = kBlockStride * sizeof(Pixel);
+        const int kWidths[libgav1::kNumObmcDirections][3] = {{8, 16, 32}, {4, 8, 16}};
+        const char *const kDirectionNames[libgav1::kNumObmcDirections] = {"vertical",
+                                                                          "horizontal"};
+        for (int direction = 0; direction < libgav1::kNumObmcDirections; ++direction) {
+            for (int i = 0; i < 3; ++i) {
+                // The overlap is half of the block in the blending direction.
+                const int width = kWidths[direction][i];
+                const int height =
+                        (direction == libgav1::kObmcDirectionVertical) ? width / 2 : width * 2;
+                registry_->Add(
+                        std::string("obmc_blend[") + kDirectionNames[direction] + "]/" +
+                                SizeName(width, height),
+                        width * height,
+                        [direction](const Dsp &dsp) { return dsp.obmc_blend[direction]; },
+                        [=](libgav1::dsp::ObmcBlendFunc func, int, int) {
+                            func(prediction, stride, width, height, obmc_prediction, stride);
+                        });
+            }
+        }
+    }
+
+    void AddWarp() {
+        // A 64x64 source frame with the borders the warp functions need.
+        constexpr int kFrameSize = 64;
+        constexpr int kBorder = 16;
+        constexpr int kStride = kFrameSize + 2 * kBorder;
+        const Pixel *const source =
+                NewPixels(kStride * (kFrameSize + 2 * kBorder + 1)) + kBorder * kStride + kBorder;
+        // A slight zoom and shear, with the shear parameters that
+        // SetupShear() derives from it.
+        static const int kWarpParams[8] = {
+                0, 0, (1 << libgav1::kWarpedModelPrecisionBits) + 512, 1024, 0,
+                1 << libgav1::kWarpedModelPrecisionBits, 0, 0};
+        const int16_t alpha = 512;
+        const int16_t beta = 1024;
+        const int16_t gamma = 0;
+        const int16_t delta = 0;
+        Pixel *const dst = Destination();
+        uint16_t *const compound_dst = registry_->Allocate<uint16_t>(kBlockStride * kFrameSize);
+        const int kSizes[] = {8, 64};
+        for (const int size : kSizes) {
+            registry_->Add(
+                    "warp/" + SizeName(size, size), size * size,
+                    [](const Dsp &dsp) { return dsp.warp; },
+                    [=](libgav1::dsp::WarpFunc func, int, int) {
+                        func(source, kStride * sizeof(Pixel), kFrameSize, kFrameSize, kWarpParams,
+                             0, 0, 0, 0, size, size, alpha, beta, gamma, delta, dst,
+                             kBlockStride * sizeof(Pixel));
+                    });
+            registry_->Add(
+                    "warp_compound/" + SizeName(size, size), size * size,
+                    [](const Dsp &dsp) { return dsp.warp_compound; },
+                    [=](libgav1::dsp::WarpCompoundFunc func, int, int) {
+                        func(source, kStride * sizeof(Pixel), kFrameSize, kFrameSize, kWarpParams,
+                             0, 0, 0, 0, size, size, alpha, beta, gamma, delta, compound_dst,
+                             size);
+                    });
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // Film grain synthesis, on a 256x64 4:2:0 image.
+
+    struct NoiseImage {
+        libgav1::Array2D<GrainType> planes[libgav1::kMaxPlanes];
+    };
+
+    void AddFilmGrain() {
+        constexpr int kWidth = 256;
+        constexpr int kHeight = 64;
+        const int grain_min = libgav1::GetGrainMin<bitdepth>();
+        const int grain_max = libgav1::GetGrainMax<bitdepth>();
+
+        libgav1::FilmGrainParams *const params = registry_->Create<libgav1::FilmGrainParams>();
+        params->num_y_points = 8;
+        for (int i = 0; i < 8; ++i) {
+            params->point_y_value[i] = static_cast<uint8_t>(32 * i);
+            params->point_y_scaling[i] = static_cast<uint8_t>(20 + 10 * i);
+        }
+        params->chroma_scaling = 10;
+        params->auto_regression_shift = 8;
+        random_.Fill(params->auto_regression_coeff_y, 24, -64, 63);
+        random_.Fill(params->auto_regression_coeff_u, 25, -64, 63);
+        random_.Fill(params->auto_regression_coeff_v, 25, -64, 63);
+        params->grain_seed = 1234;
+        params->u_multiplier = 10;
+        params->u_luma_multiplier = 20;
+        params->u_offset = 5;
+        params->v_multiplier = -10;
+        params->v_luma_multiplier = 15;
+        params->v_offset = -5;
+
+        // The grain templates are filtered in place; the results are clipped
+        // to the grain range.
+        constexpr int kLumaGrainSize = libgav1::kLumaHeight * libgav1::kLumaWidth;
+        constexpr int kChromaGrainSize = libgav1::kMaxChromaHeight * libgav1::kMaxChromaWidth;
+        GrainType *const luma_grain = registry_->Allocate<GrainType>(kLumaGrainSize);
+        GrainType *const u_grain = registry_->Allocate<GrainType>(kChromaGrainSize);
+        GrainType *const v_grain = registry_->Allocate<GrainType>(kChromaGrainSize);
+        random_.Fill(luma_grain, kLumaGrainSize, grain_min, grain_max);
+        random_.Fill(u_grain, kChromaGrainSize, grain_min, grain_max);
+        random_.Fill(v_grain, kChromaGrainSize, grain_min, grain_max);
+        for (int lag = 1; lag <= 3; ++lag) {
+            libgav1::FilmGrainParams *const lag_params =
+                    registry_->Create<libgav1::FilmGrainParams>();
+            *lag_params = *params;
+            lag_params->auto_regression_coeff_lag = static_cast<uint8_t>(lag);
+            registry_->Add(
+                    "film_grain.luma_auto_regression[" + std::to_string(lag - 1) + "]",
+                    kLumaGrainSize,
+                    [lag](const Dsp &dsp) { return dsp.film_grain.luma_auto_regression[lag - 1]; },
+                    [=](libgav1::dsp::LumaAutoRegressionFunc func, int, int) {
+                        func(*lag_params, luma_grain);
+                    });
+        }
+        for (int use_luma = 0; use_luma < 2; ++use_luma) {
+            for (int lag = 0; lag <= 3; ++lag) {
+                libgav1::FilmGrainParams *const lag_params =
+                        registry_->Create<libgav1::FilmGrainParams>();
+                *lag_params = *params;
+                lag_params->auto_regression_coeff_lag = static_cast<uint8_t>(lag);
+                lag_params->num_y_points = use_luma ? params->num_y_points : 0;
+                registry_->Add(
+                        "film_grain.chroma_auto_regression[" + std::to_string(use_luma) + "][" +
+                                std::to_string(lag) + "]",
+                        2 * libgav1::kMinChromaHeight * libgav1::kMinChromaWidth,
+                        [use_luma, lag](const Dsp &dsp) {
+                            return dsp.film_grain.chroma_auto_regression[use_luma][lag];
+                        },
+                        [=](libgav1::dsp::ChromaAutoRegressionFunc func, int, int) {
+                            func(*lag_params, luma_grain, 1, 1, u_grain, v_grain);
+                        });
+            }
+        }
+
+        // As in FilmGrain::AllocateNoiseStripes(), for the luma plane.
+        constexpr int kNoiseStripeHeight = 34;
+        const int stripes = ((kHeight + 1) / 2 + 15) / 16;
+        const int stripe_size = kNoiseStripeHeight * kWidth;
+        GrainType *const stripe_buffer = registry_->Allocate<GrainType>(
+                stripes * stripe_size + libgav1::kNoiseStripePadding);
+        random_.Fill(stripe_buffer, stripes * stripe_size, grain_min, grain_max);
+        libgav1::Array2DView<GrainType> *const noise_stripes =
+                registry_->Create<libgav1::Array2DView<GrainType>>();
+        noise_stripes->Reset(stripes, stripe_size, stripe_buffer);
+        for (int overlap = 0; overlap < 2; ++overlap) {
+            registry_->Add(
+                    "film_grain.construct_noise_stripes[" + std::to_string(overlap) + "]",
+                    kWidth * kHeight,
+                    [overlap](const Dsp &dsp) {
+                        return dsp.film_grain.construct_noise_stripes[overlap];
+                    },
+                    [=](libgav1::dsp::ConstructNoiseStripesFunc func, int, int) {
+                        func(luma_grain, 1234, kWidth, kHeight, 0, 0, noise_stripes);
+                    });
+        }
+
+        NoiseImage *const noise_image = registry_->Create<NoiseImage>();
+        if (!noise_image->planes[libgav1::kPlaneY].Reset(
+                    kHeight, kWidth + libgav1::kNoiseImagePadding, true) ||
+            !noise_image->planes[libgav1::kPlaneU].Reset(
+                    kHeight / 2, kWidth / 2 + libgav1::kNoiseImagePadding, true)) {
+            abort();
+        }
+        for (int plane = libgav1::kPlaneY; plane <= libgav1::kPlaneU; ++plane) {
+            libgav1::Array2D<GrainType> &image = noise_image->planes[plane];
+            random_.Fill(image.data(), image.size(), grain_min, grain_max);
+        }
+        registry_->Add(
+                "film_grain.construct_noise_image_overlap", kWidth * kHeight,
+                [](const Dsp &dsp) { return dsp.film_grain.construct_noise_image_overlap; },
+                [=](libgav1::dsp::ConstructNoiseImageOverlapFunc func, int, int) {
+                    func(noise_stripes, kWidth, kHeight, 0, 0,
+                         &noise_image->planes[libgav1::kPlaneY]);
+                });
+
+        const int lut_length =
+                (libgav1::kScalingLookupTableSize + libgav1::kScalingLookupTablePadding)
+                << kScalingLutShift;
+        int16_t *const scaling_lut = registry_->Allocate<int16_t>(lut_length);
+        random_.Fill(scaling_lut, lut_length, 0, 255);
+        int16_t *const initialized_lut = registry_->Allocate<int16_t>(lut_length);
+        registry_->Add(
+                "film_grain.initialize_scaling_lut",
+                libgav1::kScalingLookupTableSize << kScalingLutShift,
+                [](const Dsp &dsp) { return dsp.film_grain.initialize_scaling_lut; },
+                [=](libgav1::dsp::InitializeScalingLutFunc func, int, int) {
+                    func(params->num_y_points, params->point_y_value, params->point_y_scaling,
+                         initialized_lut, lut_length);
+                });
+
+        constexpr int kPlaneStride = kWidth + 32;
+        const Pixel *const source_y = NewPixels(kPlaneStride * kHeight);
+        const Pixel *const source_uv = NewPixels(kPlaneStride * kHeight / 2);
+        Pixel *const dest = registry_->Allocate<Pixel>(kPlaneStride * kHeight);
+        const ptrdiff_t stride = kPlaneStride * sizeof(Pixel);
+        registry_->Add(
+                "film_grain.blend_noise_luma", kWidth * kHeight,
+                [](const Dsp &dsp) { return dsp.film_grain.blend_noise_luma; },
+                [=](libgav1::dsp::BlendNoiseWithImageLumaFunc func, int, int) {
+                    func(noise_image->planes, 0, kMaxPixel, params->chroma_scaling, kWidth,
+                         kHeight, 0, scaling_lut, source_y, stride, dest, stride);
+                });
+        for (int from_luma = 0; from_luma < 2; ++from_luma) {
+            registry_->Add(
+                    "film_grain.blend_noise_chroma[" + std::to_string(from_luma) + "]",
+                    kWidth * kHeight / 4,
+                    [from_luma](const Dsp &dsp) {
+                        return dsp.film_grain.blend_noise_chroma[from_luma];
+                    },
+                    [=](libgav1::dsp::BlendNoiseWithImageChromaFunc func, int, int) {
+                        func(libgav1::kPlaneU, *params, noise_image->planes, 0, kMaxPixel, kWidth,
+                             kHeight, 0, 1, 1, scaling_lut, source_y, stride, source_uv, stride,
+                             dest, stride);
+                    });
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // Motion vector prediction.
+
+    void AddMotionVectorKernels() {
+        // The motion field of a 1024x512 frame, in 8x8 blocks.
+        constexpr int kRows = 64;
+        constexpr int kColumns = 128;
+        libgav1::ReferenceInfo *const reference_info = registry_->Create<libgav1::ReferenceInfo>();
+        libgav1::TemporalMotionField *const motion_field =
+                registry_->Create<libgav1::TemporalMotionField>();
+        if (!reference_info->Reset(kRows, kColumns) ||
+            !motion_field->mv.Reset(kRows, kColumns, true) ||
+            !motion_field->reference_offset.Reset(kRows, kColumns, true)) {
+            abort();
+        }
+        reference_info->skip_references[libgav1::kReferenceFrameIntra] = true;
+        reference_info->projection_divisions[libgav1::kReferenceFrameIntra] = 0;
+        for (int i = libgav1::kReferenceFrameLast; i < libgav1::kNumReferenceFrameTypes; ++i) {
+            reference_info->relative_distance_to[i] = static_cast<int8_t>(i);
+            reference_info->skip_references[i] = false;
+            reference_info->projection_divisions[i] = libgav1::kProjectionMvDivisionLookup[i];
+        }
+        for (int y = 0; y < kRows; ++y) {
+            for (int x = 0; x < kColumns; ++x) {
+                reference_info->motion_field_reference_frame[y][x] =
+                        static_cast<libgav1::ReferenceFrameType>(
+                                random_.Range(0, libgav1::kReferenceFrameAlternate));
+                reference_info->motion_field_mv[y][x].mv[0] =
+                        static_cast<int16_t>(random_.Range(-64, 63));
+                reference_info->motion_field_mv[y][x].mv[1] =
+                        static_cast<int16_t>(random_.Range(-64, 63));
+            }
+        }
+        registry_->Add(
+                "motion_field_projection_kernel", kRows * kColumns,
+                [](const Dsp &dsp) { return dsp.motion_field_projection_kernel; },
+                [=](libgav1::dsp::MotionFieldProjectionKernelFunc func, int, int) {
+                    func(*reference_info, /*reference_to_current_with_sign=*/3, /*dst_sign=*/0,
+                         0, kRows, 0, kColumns, motion_field);
+                });
+
+        libgav1::MotionVector *const temporal_mvs = registry_->Allocate<libgav1::MotionVector>(
+                libgav1::kMaxTemporalMvCandidatesWithPadding);
+        int8_t *const temporal_reference_offsets =
+                registry_->Allocate<int8_t>(libgav1::kMaxTemporalMvCandidatesWithPadding);
+        for (int i = 0; i < libgav1::kMaxTemporalMvCandidatesWithPadding; ++i) {
+            temporal_mvs[i].mv[0] = static_cast<int16_t>(random_.Range(-4096, 4095));
+            temporal_mvs[i].mv[1] = static_cast<int16_t>(random_.Range(-4096, 4095));
+            temporal_reference_offsets[i] =
+                    static_cast<int8_t>(random_.Range(1, libgav1::kMaxFrameDistance));
+        }
+        int *const reference_offsets = registry_->Allocate<int>(2);
+        reference_offsets[0] = 3;
+        reference_offsets[1] = -2;
+        libgav1::CompoundMotionVector *const compound_mvs =
+                registry_->Allocate<libgav1::CompoundMotionVector>(
+                        libgav1::kMaxTemporalMvCandidatesWithPadding);
+        libgav1::MotionVector *const single_mvs = registry_->Allocate<libgav1::MotionVector>(
+                libgav1::kMaxTemporalMvCandidatesWithPadding);
+        const int count = libgav1::kMaxTemporalMvCandidates;
+        for (int index = 0; index < 3; ++index) {
+            registry_->Add(
+                    "mv_projection_compound[" + std::to_string(index) + "]", count,
+                    [index](const Dsp &dsp) { return dsp.mv_projection_compound[index]; },
+                    [=](libgav1::dsp::MvProjectionCompoundFunc func, int, int) {
+                        func(temporal_mvs, temporal_reference_offsets, reference_offsets, count,
+                             compound_mvs);
+                    });
+            registry_->Add(
+                    "mv_projection_single[" + std::to_string(index) + "]", count,
+                    [index](const Dsp &dsp) { return dsp.mv_projection_single[index]; },
+                    [=](libgav1::dsp::MvProjectionSingleFunc func, int, int) {
+                        func(temporal_mvs, temporal_reference_offsets, reference_offsets[0],
+                             count, single_mvs);
+                    });
+        }
+    }
+
+    Registry *const registry_;
+    Random random_;
+    Pixel *destination_ = nullptr;
+};
+
+// Times the |tier| function of |kernel|: the best of the timed sections run in
+// |min_time_ms|, per call.
+Result Measure(const Kernel &kernel, int tier, double min_time_ms) {
+    const std::function<void()> &batch = kernel.batches[tier];
+    int repeats = 1;
+    if (!kernel.prepare) {
+        for (;;) {
+            const int64_t start = NowNs();
+            for (int i = 0; i < repeats; ++i) batch();
+            if (NowNs() - start >= kMinSectionNs || repeats >= (1 << 20)) break;
+            repeats *= 2;
+        }
+    }
+    double best_ns = INFINITY;
+    double best_cycles = INFINITY;
+    const int64_t end = NowNs() + static_cast<int64_t>(min_time_ms * 1e6);
+    int rounds = 0;
+    do {
+        if (kernel.prepare) kernel.prepare();
+        const int64_t start = NowNs();
+        const uint64_t start_cycles = ReadCycleCounter();
+        for (int i = 0; i < repeats; ++i) batch();
+        const uint64_t cycles = ReadCycleCounter() - start_cycles;
+        const int64_t ns = NowNs() - start;
+        best_ns = std::min(best_ns, static_cast<double>(ns));
+        best_cycles = std::min(best_cycles, static_cast<double>(cycles));
+    } while (++rounds < kMinRounds || NowNs() < end);
+    const double calls = static_cast<double>(repeats) * kBatch;
+    Result result;
+    result.tier = tier;
+    result.ns_per_call = best_ns / calls;
+    result.cycles_per_call = DSP_BENCHMARK_HAS_TSC ? best_cycles / calls : -1;
+    return result;
+}
+
+// Times each distinct function of |kernel|, in tier order.
+void MeasureKernel(Kernel *kernel, double min_time_ms) {
+    uintptr_t previous = 0;
+    for (size_t tier = 0; tier < kernel->entries.size(); ++tier) {
+        const uintptr_t entry = kernel->entries[tier];
+        if (entry == 0 || entry == previous) continue;
+        previous = entry;
+        kernel->results.push_back(Measure(*kernel, static_cast<int>(tier), min_time_ms));
+    }
+}
+
+// Returns the time of the C function of |kernel|, or 0 if it has none.
+double CNsPerCall(const Kernel &kernel) {
+    if (kernel.results.empty() || kernel.results[0].tier != 0) return 0;
+    return kernel.results[0].ns_per_call;
+}
+
+std::vector<int> ParseIntList(const char *s) {
+    std::vector<int> values;
+    while (*s != '\0') {
+        char *end;
+        values.push_back(static_cast<int>(strtol(s, &end, 10)));
+        if (end == s) break;
+        s = (*end == ',') ? end + 1 : end;
+    }
+    return values;
+}
+
+bool ParseOptions(int argc, char **argv, Options *options) {
+    for (int i = 1; i < argc; ++i) {
+        const char *const arg = argv[i];
+        if (strncmp(arg, "--filter=", 9) == 0) {
+            options->filter = arg + 9;
+        } else if (strncmp(arg, "--bitdepths=", 12) == 0) {
+            options->bitdepths = ParseIntList(arg + 12);
+        } else if (strncmp(arg, "--min_time_ms=", 14) == 0) {
+            options->min_time_ms = atof(arg + 14);
+        } else if (strncmp(arg, "--json=", 7) == 0) {
+            options->json_path = arg + 7;
+        } else {
+            fprintf(stderr, "Unknown option %s\n", arg);
+            return false;
+        }
+    }
+    if (options->bitdepths.empty()) options->bitdepths = {8, 10};
+    for (const int bitdepth : options->bitdepths) {
+        if (bitdepth != 8 && (bitdepth != 10 || LIBGAV1_MAX_BITDEPTH < 10) &&
+            (bitdepth != 12 || LIBGAV1_MAX_BITDEPTH < 12)) {
+            fprintf(stderr, "Unsupported bitdepth %d\n", bitdepth);
+            return false;
+        }
+    }
+    return options->min_time_ms >= 0;
+}
+
+void WriteJsonString(FILE *out, const std::string &s) {
+    fputc('"', out);
+    for (const char c : s) {
+        if (c == '"' || c == '\\') fputc('\\', out);
+        fputc(c, out);
+    }
+    fputc('"', out);
+}
+
+void WriteKernel(FILE *out, const Kernel &kernel, const std::vector<Tier> &tiers) {
+    fprintf(out, "    {\"name\": ");
+    WriteJsonString(out, kernel.name);
+    fprintf(out, ", \"bitdepth\": %d, \"pixels\": %d,\n     \"results\": [", kernel.bitdepth,
+            kernel.pixels);
+    const double c_ns = CNsPerCall(kernel);
+    for (size_t i = 0; i < kernel.results.size(); ++i) {
+        const Result &result = kernel.results[i];
+        fprintf(out, "%s\n       {\"tier\": \"%s\", \"ns_per_pixel\": %.4f, \"cycles_per_pixel\": ",
+                i == 0 ? "" : ",", tiers[result.tier].name, result.ns_per_call / kernel.pixels);
+        if (result.cycles_per_call >= 0) {
+            fprintf(out, "%.4f", result.cycles_per_call / kernel.pixels);
+        } else {
+            fprintf(out, "null");
+        }
+        if (c_ns > 0) {
+            fprintf(out, ", \"speedup\": %.3f}", c_ns / result.ns_per_call);
+        } else {
+            fprintf(out, ", \"speedup\": null}");
+        }
+    }
+    fprintf(out, "]}");
+}
+
+void PrintSummary(const Kernel &kernel, const std::vector<Tier> &tiers) {
+    fprintf(stderr, "%2d bit %-58s", kernel.bitdepth, kernel.name.c_str());
+    const double c_ns = CNsPerCall(kernel);
+    for (const Result &result : kernel.results) {
+        fprintf(stderr, "  %s %8.3f ns/px", tiers[result.tier].name,
+                result.ns_per_call / kernel.pixels);
+        if (c_ns > 0 && result.tier != 0) fprintf(stderr, " (%.2fx)", c_ns / result.ns_per_call);
+    }
+    fputc('\n', stderr);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, &options)) {
+        fprintf(stderr,
+                "Usage: %s [--filter=<substring>] [--bitdepths=8,10,12] [--min_time_ms=N] "
+                "[--json=<path>]\n",
+                argv[0]);
+        return 2;
+    }
+    const std::vector<Tier> tiers = GetTiers();
+
+    std::vector<Kernel> kernels;
+    std::vector<Coverage> coverage;
+    for (const int bitdepth : options.bitdepths) {
+        std::vector<Dsp> tables;
+        for (const Tier &tier : tiers) tables.push_back(GetTable(tier, bitdepth));
+        coverage.push_back(GetCoverage(bitdepth, tables));
+
+        const size_t first = kernels.size();
+        Registry registry(bitdepth, tables, options.filter, &kernels);
+        if (bitdepth == 8) {
+            KernelSuite<8, uint8_t>(&registry).AddAll();
+#if LIBGAV1_MAX_BITDEPTH >= 10
+        } else if (bitdepth == 10) {
+            KernelSuite<10, uint16_t>(&registry).AddAll();
+#endif
+#if LIBGAV1_MAX_BITDEPTH == 12
+        } else {
+            KernelSuite<12, uint16_t>(&registry).AddAll();
+#endif
+        }
+        for (size_t i = first; i < kernels.size(); ++i) {
+            MeasureKernel(&kernels[i], options.min_time_ms);
+            PrintSummary(kernels[i], tiers);
+            // The buffers go away with |registry|.
+            kernels[i].batches.clear();
+            kernels[i].prepare = std::function<void()>();
+        }
+    }
+
+    FILE *out = stdout;
+    if (!options.json_path.empty()) {
+        out = fopen(options.json_path.c_str(), "w");
+        if (out == nullptr) {
+            fprintf(stderr, "Cannot open %s\n", options.json_path.c_str());
+            return 1;
+        }
+    }
+    fprintf(out, "{\n  \"tiers\": [");
+    for (size_t i = 0; i < tiers.size(); ++i) {
+        fprintf(out, "%s\"%s\"", i == 0 ? "" : ", ", tiers[i].name);
+    }
+    fprintf(out, "],\n  \"min_time_ms\": %.1f,\n  \"cycle_counter\": %s,\n", options.min_time_ms,
+            DSP_BENCHMARK_HAS_TSC ? "\"tsc\"" : "null");
+    fprintf(out, "  \"coverage\": [");
+    for (size_t i = 0; i < coverage.size(); ++i) {
+        fprintf(out, "%s\n    {\"bitdepth\": %d, \"tiers\": {", i == 0 ? "" : ",",
+                coverage[i].bitdepth);
+        for (size_t tier = 0; tier < tiers.size(); ++tier) {
+            fprintf(out, "%s\"%s\": {\"implemented\": %d, \"simd\": %d}", tier == 0 ? "" : ", ",
+                    tiers[tier].name, coverage[i].implemented[tier], coverage[i].simd[tier]);
+        }
+        fprintf(out, "}}");
+    }
+    fprintf(out, "\n  ],\n  \"kernels\": [\n");
+    for (size_t i = 0; i < kernels.size(); ++i) {
+        WriteKernel(out, kernels[i], tiers);
+        fprintf(out, "%s\n", i + 1 < kernels.size() ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+    if (out != stdout) fclose(out);
+    return 0;
+}
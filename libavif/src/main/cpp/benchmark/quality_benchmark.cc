@@ -0,0 +1,329 @@
+// Speed versus quality of the libgav1 post filter masks.
+//
+// Decodes the primary item of each AVIF file with libgav1 with every post
+// filter enabled (mask 0x1f) and with each of --masks, and prints the decode
+// time of each mask (the minimum over --iterations decodes, including decoder
+// creation) and the PSNR of each plane of its output against the full decode.
+// The masks default to those of the AvifCodec quality tiers: 0x1f (FULL), 0x05
+// (FAST) and 0x04 (FASTEST). This measures the YUV output of libgav1 only; the chroma
+// upsampling that the FAST and FASTEST tiers also change is done by libavif
+// and is covered by avif_benchmark --quality.
+//
+// Usage:
+//   libgav1_quality_benchmark [--masks=0x1f,0x05,0x04] [--iterations=20]
+//                             [--threads=1] <file.avif>...
+//
+// Only items stored as one or more extents of the file itself (iloc
+// construction method 0) are supported, which covers the single image AVIF
+// files that libavif and the sample assets write.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "src/gav1/decoder.h"
+
+namespace {
+
+struct Options {
+    std::vector<int> masks = {0x1f, 0x05, 0x04};
+    int iterations = 20;
+    int threads = 1;
+    std::vector<std::string> files;
+};
+
+bool ParseOptions(int argc, char **argv, Options *options) {
+    for (int i = 1; i < argc; ++i) {
+        const char *const arg = argv[i];
+        if (strncmp(arg, "--masks=", 8) == 0) {
+            options->masks.clear();
+            const char *p = arg + 8;
+            while (*p != '\0') {
+                char *end;
+                const long mask = strtol(p, &end, 0);
+                if (end == p || mask < 0 || mask > 0x1f) return false;
+                options->masks.push_back(static_cast<int>(mask));
+                p = (*end == ',') ? end + 1 : end;
+                if (*end != ',' && *end != '\0') return false;
+            }
+        } else if (strncmp(arg, "--iterations=", 13) == 0) {
+            options->iterations = atoi(arg + 13);
+        } else if (strncmp(arg, "--threads=", 10) == 0) {
+            options->threads = atoi(arg + 10);
+        } else if (arg[0] == '-') {
+            return false;
+        } else {
+            options->files.push_back(arg);
+        }
+    }
+    return !options->masks.empty() && options->iterations > 0 && options->threads > 0 &&
+           !options->files.empty();
+}
+
+bool ReadFile(const std::string &path, std::vector<uint8_t> *data) {
+    FILE *const file = fopen(path.c_str(), "rb");
+    if (file == nullptr) return false;
+    uint8_t buffer[65536];
+    size_t size;
+    while ((size = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data->insert(data->end(), buffer, buffer + size);
+    }
+    const bool ok = ferror(file) == 0;
+    fclose(file);
+    return ok;
+}
+
+// Big-endian reader of the ISO BMFF boxes. Reads past the end return 0 and set
+// |failed|.
+class BoxReader {
+public:
+    BoxReader(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+
+    uint64_t Read(int bytes) {
+        if (bytes > static_cast<int>(size_ - std::min(size_, position_))) {
+            failed = true;
+            position_ = size_;
+            return 0;
+        }
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; ++i) value = (value << 8) | data_[position_++];
+        return value;
+    }
+    void Skip(size_t bytes) { position_ = std::min(size_, position_ + bytes); }
+    size_t position() const { return position_; }
+    size_t remaining() const { return size_ - position_; }
+
+    bool failed = false;
+
+private:
+    const uint8_t *const data_;
+    const size_t size_;
+    size_t position_ = 0;
+};
+
+// Calls |visit|(type, payload, payload_size) for each box in |data|. Returns
+// false if a box overruns |data|.
+template <typename Visitor>
+bool ForEachBox(const uint8_t *data, size_t size, Visitor visit) {
+    BoxReader reader(data, size);
+    while (reader.remaining() >= 8) {
+        const size_t start = reader.position();
+        uint64_t box_size = reader.Read(4);
+        const uint32_t type = static_cast<uint32_t>(reader.Read(4));
+        if (box_size == 1) box_size = reader.Read(8);
+        if (box_size == 0) box_size = size - start;
+        const size_t header_size = reader.position() - start;
+        if (reader.failed || box_size < header_size || box_size > size - start) return false;
+        visit(type, data + reader.position(), static_cast<size_t>(box_size) - header_size);
+        reader.Skip(static_cast<size_t>(box_size) - header_size);
+    }
+    return true;
+}
+
+constexpr uint32_t FourCc(const char *name) {
+    return (static_cast<uint32_t>(name[0]) << 24) | (static_cast<uint32_t>(name[1]) << 16) |
+           (static_cast<uint32_t>(name[2]) << 8) | static_cast<uint32_t>(name[3]);
+}
+
+// Copies the AV1 payload of the primary item of the AVIF file |file| to |obus|.
+bool GetPrimaryItem(const std::vector<uint8_t> &file, std::vector<uint8_t> *obus) {
+    const uint8_t *meta = nullptr;
+    size_t meta_size = 0;
+    if (!ForEachBox(file.data(), file.size(), [&](uint32_t type, const uint8_t *payload,
+                                                  size_t size) {
+            if (type == FourCc("meta")) {
+                meta = payload;
+                meta_size = size;
+            }
+        }) ||
+        meta == nullptr || meta_size < 4) {
+        return false;
+    }
+    const uint8_t *pitm = nullptr;
+    size_t pitm_size = 0;
+    const uint8_t *iloc = nullptr;
+    size_t iloc_size = 0;
+    // meta is a FullBox.
+    if (!ForEachBox(meta + 4, meta_size - 4,
+                    [&](uint32_t type, const uint8_t *payload, size_t size) {
+                        if (type == FourCc("pitm")) {
+                            pitm = payload;
+                            pitm_size = size;
+                        } else if (type == FourCc("iloc")) {
+                            iloc = payload;
+                            iloc_size = size;
+                        }
+                    }) ||
+        pitm == nullptr || iloc == nullptr) {
+        return false;
+    }
+
+    BoxReader pitm_reader(pitm, pitm_size);
+    const int pitm_version = static_cast<int>(pitm_reader.Read(1));
+    pitm_reader.Skip(3);
+    const uint64_t primary_id = pitm_reader.Read(pitm_version == 0 ? 2 : 4);
+
+    BoxReader reader(iloc, iloc_size);
+    const int version = static_cast<int>(reader.Read(1));
+    reader.Skip(3);
+    const int offset_size = static_cast<int>(reader.Read(1));
+    const int base_offset_size = static_cast<int>(reader.Read(1));
+    const int length_size = offset_size & 0xf;
+    const int index_size = (version == 1 || version == 2) ? (base_offset_size & 0xf) : 0;
+    const uint64_t item_count = reader.Read(version < 2 ? 2 : 4);
+    for (uint64_t item = 0; item < item_count && !reader.failed; ++item) {
+        const uint64_t item_id = reader.Read(version < 2 ? 2 : 4);
+        int construction_method = 0;
+        if (version == 1 || version == 2) construction_method = reader.Read(2) & 0xf;
+        reader.Skip(2);  // data_reference_index
+        const uint64_t base_offset = reader.Read(base_offset_size >> 4);
+        const uint64_t extent_count = reader.Read(2);
+        for (uint64_t extent = 0; extent < extent_count; ++extent) {
+            reader.Read(index_size);
+            const uint64_t offset = base_offset + reader.Read(offset_size >> 4);
+            const uint64_t length = reader.Read(length_size);
+            if (item_id != primary_id) continue;
+            if (construction_method != 0 || offset > file.size() ||
+                length > file.size() - offset) {
+                return false;
+            }
+            obus->insert(obus->end(), file.begin() + offset, file.begin() + offset + length);
+        }
+        if (item_id == primary_id) return !reader.failed && !obus->empty();
+    }
+    return false;
+}
+
+// The planes of a decoded frame, widened to 16 bits.
+struct Frame {
+    int bitdepth = 0;
+    int num_planes = 0;
+    int width[3] = {};
+    int height[3] = {};
+    std::vector<uint16_t> planes[3];
+};
+
+// Decodes |obus| with |mask|. Stores the decode time in |ms| and, if |frame|
+// is not null, the output in |frame|.
+bool Decode(const std::vector<uint8_t> &obus, int mask, int threads, double *ms, Frame *frame) {
+    const auto start = std::chrono::steady_clock::now();
+    libgav1::DecoderSettings settings;
+    settings.threads = threads;
+    settings.post_filter_mask = static_cast<uint8_t>(mask);
+    libgav1::Decoder decoder;
+    const libgav1::DecoderBuffer *buffer = nullptr;
+    if (decoder.Init(&settings) != libgav1::kStatusOk ||
+        decoder.EnqueueFrame(obus.data(), obus.size(), 0, nullptr) != libgav1::kStatusOk ||
+        decoder.DequeueFrame(&buffer) != libgav1::kStatusOk || buffer == nullptr) {
+        return false;
+    }
+    const std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+    *ms = elapsed.count();
+    if (frame == nullptr) return true;
+    frame->bitdepth = buffer->bitdepth;
+    frame->num_planes = buffer->NumPlanes();
+    for (int plane = 0; plane < frame->num_planes; ++plane) {
+        const int width = buffer->displayed_width[plane];
+        const int height = buffer->displayed_height[plane];
+        frame->width[plane] = width;
+        frame->height[plane] = height;
+        frame->planes[plane].resize(static_cast<size_t>(width) * height);
+        for (int y = 0; y < height; ++y) {
+            const uint8_t *const row = buffer->plane[plane] + y * buffer->stride[plane];
+            for (int x = 0; x < width; ++x) {
+                frame->planes[plane][y * width + x] =
+                        (buffer->bitdepth == 8) ? row[x]
+                                                : reinterpret_cast<const uint16_t *>(row)[x];
+            }
+        }
+    }
+    return true;
+}
+
+// Returns the PSNR of |plane| of |frame| against |reference|, or infinity if
+// they are identical.
+double Psnr(const Frame &reference, const Frame &frame, int plane) {
+    const std::vector<uint16_t> &a = reference.planes[plane];
+    const std::vector<uint16_t> &b = frame.planes[plane];
+    double sum = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        const double difference = static_cast<double>(a[i]) - b[i];
+        sum += difference * difference;
+    }
+    if (sum == 0) return std::numeric_limits<double>::infinity();
+    const double max_value = (1 << reference.bitdepth) - 1;
+    return 10 * std::log10(max_value * max_value * a.size() / sum);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, &options)) {
+        fprintf(stderr,
+                "Usage: %s [--masks=0x1f,0x05,0x04] [--iterations=N] [--threads=N] "
+                "<file.avif>...\n",
+                argv[0]);
+        return 2;
+    }
+    static const char *const kPlaneNames[3] = {"Y", "U", "V"};
+    for (const std::string &path : options.files) {
+        std::vector<uint8_t> file;
+        std::vector<uint8_t> obus;
+        if (!ReadFile(path, &file) || !GetPrimaryItem(file, &obus)) {
+            fprintf(stderr, "%s: cannot read the primary item\n", path.c_str());
+            return 1;
+        }
+        // The full decode comes first and the masks are interleaved, so that
+        // frequency and cache changes during the run affect all of them alike.
+        std::vector<int> masks = options.masks;
+        masks.insert(masks.begin(), 0x1f);
+        std::vector<Frame> frames(masks.size());
+        std::vector<double> min_ms(masks.size(), std::numeric_limits<double>::infinity());
+        for (int iteration = 0; iteration < options.iterations; ++iteration) {
+            for (size_t i = 0; i < masks.size(); ++i) {
+                double ms;
+                if (!Decode(obus, masks[i], options.threads, &ms,
+                            (iteration == 0) ? &frames[i] : nullptr)) {
+                    fprintf(stderr, "%s: decode with mask 0x%02x failed\n", path.c_str(),
+                            masks[i]);
+                    return 1;
+                }
+                min_ms[i] = std::min(min_ms[i], ms);
+            }
+        }
+        const Frame &reference = frames[0];
+        printf("%s: %dx%d, %d bit, %d thread(s), minimum of %d decodes\n", path.c_str(),
+               reference.width[0], reference.height[0], reference.bitdepth, options.threads,
+               options.iterations);
+        for (size_t i = 1; i < masks.size(); ++i) {
+            const Frame &frame = frames[i];
+            printf("  mask 0x%02x: %8.2f ms (%5.1f%% of 0x1f)", masks[i], min_ms[i],
+                   100 * min_ms[i] / min_ms[0]);
+            for (int plane = 0; plane < reference.num_planes; ++plane) {
+                if (frame.width[plane] != reference.width[plane] ||
+                    frame.height[plane] != reference.height[plane]) {
+                    printf("  %s size differs", kPlaneNames[plane]);
+                    continue;
+                }
+                const double psnr = Psnr(reference, frame, plane);
+                if (std::isinf(psnr)) {
+                    printf("  %s identical", kPlaneNames[plane]);
+                } else {
+                    printf("  %s %.2f dB", kPlaneNames[plane], psnr);
+                }
+            }
+            printf("\n");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,180 @@
+# Host (Linux) build of the native codec stack, used to profile with perf, run
+# sanitizers and benchmark SIMD changes off-device. Included by CMakeLists.txt
+# when not building for Android.
+#
+#   cmake -S . -B build -DCMAKE_BUILD_TYPE=Release
+#   cmake --build build && ctest --test-dir build
+#
+# Options:
+#   AVIF_SAMPLE_SANITIZE     Comma separated -fsanitize= list, e.g.
+#                            "address,undefined" or "thread".
+#   AVIF_SAMPLE_ENABLE_TESTS Build the libgav1 and wrapper unit tests (needs
+#                            GoogleTest and Abseil).
+#   AVIF_SAMPLE_LIBAVIF_DIR  Prefix of a host build of libavif 0.10 (static
+#                            libavif.a or shared libavif.so). Enables the
+#                            avif_benchmark executable.
+#
+# libgav1_dsp_benchmark, which times the libgav1 dsp functions of each
+# instruction set, and libgav1_quality_benchmark, which measures the decode
+# time and PSNR of the post filter masks on AVIF files, are always built.
+#
+# libaom is not built: the vendored include/aom tree has no build/cmake
+# scripts and no generated config, which its CMakeLists.txt requires.
+
+set(CMAKE_CXX_STANDARD 11)
+set(CMAKE_CXX_STANDARD_REQUIRED ON)
+set(CMAKE_POSITION_INDEPENDENT_CODE ON)
+if(NOT CMAKE_BUILD_TYPE AND NOT CMAKE_CONFIGURATION_TYPES)
+  set(CMAKE_BUILD_TYPE "Release" CACHE STRING "Build type." FORCE)
+endif()
+
+option(AVIF_SAMPLE_ENABLE_TESTS "Build the libgav1 unit tests." ON)
+set(AVIF_SAMPLE_SANITIZE "" CACHE STRING "Sanitizers to enable, e.g. address,undefined.")
+set(AVIF_SAMPLE_LIBAVIF_DIR "" CACHE PATH "Prefix of a host build of libavif.")
+
+if(AVIF_SAMPLE_SANITIZE)
+  add_compile_options("-fsanitize=${AVIF_SAMPLE_SANITIZE}" -fno-omit-frame-pointer)
+  set(CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS} -fsanitize=${AVIF_SAMPLE_SANITIZE}")
+  set(CMAKE_SHARED_LINKER_FLAGS
+      "${CMAKE_SHARED_LINKER_FLAGS} -fsanitize=${AVIF_SAMPLE_SANITIZE}")
+endif()
+
+find_package(absl CONFIG QUIET)
+
+if(CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64|amd64|i.86)$")
+  set(avif_sample_host_x86 1)
+endif()
+
+include("${PROJECT_SOURCE_DIR}/cmake/libgav1.cmake")
+
+#
+# JNI-independent core of the wrapper.
+#
+add_library(avif_sample_core STATIC
+            "avif_codec.cc"
+            "codec_stats.cc"
+            "frame_buffer_pool.cc"
+            "image_cache.cc"
+            "memory_pool.cc")
+target_include_directories(avif_sample_core PUBLIC "${PROJECT_SOURCE_DIR}"
+                                                   "${PROJECT_SOURCE_DIR}/include")
+target_link_libraries(avif_sample_core PUBLIC libgav1)
+
+#
+# Microbenchmark of the libgav1 dsp functions.
+#
+add_executable(libgav1_dsp_benchmark "benchmark/dsp_benchmark.cc")
+target_link_libraries(libgav1_dsp_benchmark libgav1)
+
+#
+# Decode time versus PSNR of the libgav1 post filter masks.
+#
+add_executable(libgav1_quality_benchmark "benchmark/quality_benchmark.cc")
+target_link_libraries(libgav1_quality_benchmark libgav1)
+
+#
+# Benchmark, which needs a libavif build to link against. The system libavif
+# is deliberately not searched: its version need not match include/avif.
+#
+if(AVIF_SAMPLE_LIBAVIF_DIR)
+  find_library(AVIF_SAMPLE_LIBAVIF_LIBRARY NAMES libavif.a avif
+               HINTS "${AVIF_SAMPLE_LIBAVIF_DIR}"
+               PATH_SUFFIXES lib lib64 NO_DEFAULT_PATH)
+endif()
+if(AVIF_SAMPLE_LIBAVIF_LIBRARY)
+  add_executable(avif_benchmark "benchmark/avif_benchmark.cc")
+  target_link_libraries(avif_benchmark avif_sample_core
+                        "${AVIF_SAMPLE_LIBAVIF_LIBRARY}" libgav1)
+  if(AVIF_SAMPLE_LIBAVIF_LIBRARY MATCHES "\\.a$")
+    # Same allocator redirection as the Android library.
+    target_link_libraries(avif_benchmark
+                          "-Wl,--wrap=avifAlloc,--wrap=avifFree"
+                          "-Wl,--wrap=aom_malloc,--wrap=aom_memalign,--wrap=aom_calloc,--wrap=aom_free")
+  endif()
+else()
+  message(STATUS "avif_benchmark disabled: set AVIF_SAMPLE_LIBAVIF_DIR to a "
+                 "host build of libavif.")
+endif()
+
+#
+# libgav1 unit tests. Only the tests that do not depend on the libgav1 tests/
+# support directory, which is not vendored, are built.
+#
+if(AVIF_SAMPLE_ENABLE_TESTS)
+  find_package(GTest CONFIG QUIET)
+  if(NOT GTest_FOUND OR NOT absl_FOUND)
+    message(STATUS "libgav1 tests disabled: GoogleTest and Abseil are required.")
+  else()
+    enable_testing()
+    set(libgav1_host_tests
+        "${libgav1_root}/buffer_pool_test.cc"
+        "${libgav1_root}/decoder_buffer_test.cc"
+        "${libgav1_root}/decoder_test.cc"
+        "${libgav1_root}/internal_frame_buffer_list_test.cc"
+        "${libgav1_root}/quantizer_test.cc"
+        "${libgav1_root}/residual_buffer_pool_test.cc"
+        "${libgav1_root}/scan_test.cc"
+        "${libgav1_root}/symbol_decoder_context_test.cc"
+        "${libgav1_root}/threading_strategy_test.cc"
+        "${libgav1_root}/version_test.cc"
+        "${libgav1_root}/dsp/film_grain_scaling_test.cc"
+        "${libgav1_root}/utils/array_2d_test.cc"
+        "${libgav1_root}/utils/block_parameters_holder_test.cc"
+        "${libgav1_root}/utils/blocking_counter_test.cc"
+        "${libgav1_root}/utils/common_test.cc"
+        "${libgav1_root}/utils/cpu_test.cc"
+        "${libgav1_root}/utils/cpu_topology_test.cc"
+        "${libgav1_root}/utils/entropy_decoder_test.cc"
+        "${libgav1_root}/utils/lock_free_queue_test.cc"
+        "${libgav1_root}/utils/memory_test.cc"
+        "${libgav1_root}/utils/memory_tracker_test.cc"
+        "${libgav1_root}/utils/queue_test.cc"
+        "${libgav1_root}/utils/segmentation_map_test.cc"
+        "${libgav1_root}/utils/segmentation_test.cc"
+        "${libgav1_root}/utils/stack_test.cc"
+        "${libgav1_root}/utils/stage_timer_test.cc"
+        "${libgav1_root}/utils/threadpool_test.cc"
+        "${libgav1_root}/utils/tracer_test.cc"
+        "${libgav1_root}/utils/unbounded_queue_test.cc"
+        "${libgav1_root}/utils/vector_test.cc"
+        "${libgav1_root}/utils/work_stealing_deque_test.cc")
+    if(avif_sample_host_x86)
+      list(APPEND libgav1_host_tests
+                  "${libgav1_root}/dsp/x86/common_sse4_test.cc"
+                  "${libgav1_root}/dsp/x86/common_avx2_test.cc"
+                  "${libgav1_root}/dsp/x86/cdef_test.cc"
+                  "${libgav1_root}/dsp/x86/convolve_10bit_test.cc"
+                  "${libgav1_root}/dsp/x86/convolve_avx512_test.cc"
+                  "${libgav1_root}/dsp/x86/film_grain_sse4_test.cc"
+                  "${libgav1_root}/dsp/x86/intra_edge_test.cc"
+                  "${libgav1_root}/dsp/x86/intrapred_test.cc"
+                  "${libgav1_root}/dsp/x86/inverse_transform_avx2_test.cc"
+                  "${libgav1_root}/dsp/x86/loop_filter_test.cc"
+                  "${libgav1_root}/dsp/x86/loop_restoration_10bit_test.cc"
+                  "${libgav1_root}/dsp/x86/loop_restoration_avx512_test.cc"
+                  "${libgav1_root}/dsp/x86/warp_test.cc")
+      set_source_files_properties("${libgav1_root}/dsp/x86/common_sse4_test.cc"
+                                  "${libgav1_root}/dsp/x86/film_grain_sse4_test.cc"
+                                  PROPERTIES COMPILE_FLAGS "-msse4.1")
+      set_source_files_properties(
+          "${libgav1_root}/dsp/x86/common_avx2_test.cc"
+          "${libgav1_root}/dsp/x86/inverse_transform_avx2_test.cc"
+          PROPERTIES COMPILE_FLAGS "-mavx2")
+    endif()
+    foreach(test_source ${libgav1_host_tests})
+      get_filename_component(test_name "${test_source}" NAME_WE)
+      set(test_target "libgav1_${test_name}")
+      add_executable(${test_target} "${test_source}")
+      target_link_libraries(${test_target} libgav1 GTest::gtest_main
+                            absl::strings absl::synchronization absl::time)
+      add_test(NAME ${test_target} COMMAND ${test_target})
+    endforeach()
+
+    # Tests of the wrapper itself.
+    add_executable(avif_sample_frame_buffer_pool_test "frame_buffer_pool_test.cc")
+    target_link_libraries(avif_sample_frame_buffer_pool_test avif_sample_core
+                          GTest::gtest_main)
+    add_test(NAME avif_sample_frame_buffer_pool_test
+             COMMAND avif_sample_frame_buffer_pool_test)
+  endif()
+endif()
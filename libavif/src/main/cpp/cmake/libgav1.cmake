@@ -0,0 +1,55 @@
+# libgav1, built from include/libgav1 into the static library target libgav1.
+# Included by both the Android build (CMakeLists.txt) and the host build
+# (avif_sample_host.cmake): the wrapper calls entry points that only exist in
+# the vendored sources, such as Libgav1SetAllocator() and
+# Libgav1SetDecoderSettingsCallback(), so no prebuilt libgav1 can be used.
+#
+# Off Android the thread pool uses absl::Mutex if the includer found Abseil
+# (absl_FOUND), and std::mutex otherwise.
+
+find_package(Threads REQUIRED)
+
+set(libgav1_root "${PROJECT_SOURCE_DIR}/include/libgav1")
+set(libgav1_source "${libgav1_root}")
+include("${libgav1_root}/libgav1_decoder.cmake")
+include("${libgav1_root}/dsp/libgav1_dsp.cmake")
+include("${libgav1_root}/utils/libgav1_utils.cmake")
+
+# libgav1 includes its own headers as "src/...": expose include/libgav1 under
+# that name.
+set(libgav1_include_root "${PROJECT_BINARY_DIR}/libgav1_include")
+file(MAKE_DIRECTORY "${libgav1_include_root}")
+execute_process(COMMAND ${CMAKE_COMMAND} -E create_symlink "${libgav1_root}"
+                        "${libgav1_include_root}/src")
+
+set(libgav1_all_sources ${libgav1_api_sources} ${libgav1_decoder_sources}
+                        ${libgav1_dsp_sources} ${libgav1_utils_sources})
+if(CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64|amd64|i.86)$")
+  list(APPEND libgav1_all_sources ${libgav1_dsp_sources_sse4}
+              ${libgav1_dsp_sources_avx2} ${libgav1_dsp_sources_avx512})
+  # Only the *_sse4.cc, *_avx2.cc and *_avx512.cc files are built for those
+  # instruction sets; everything else stays baseline and dispatches at runtime.
+  set_source_files_properties(${libgav1_dsp_sources_sse4}
+                              PROPERTIES COMPILE_FLAGS "-msse4.1")
+  set_source_files_properties(${libgav1_dsp_sources_avx2}
+                              PROPERTIES COMPILE_FLAGS "-mavx2")
+  set_source_files_properties(
+    ${libgav1_dsp_sources_avx512}
+    PROPERTIES COMPILE_FLAGS "-mavx512f -mavx512bw -mavx512vl")
+elseif(CMAKE_SYSTEM_PROCESSOR MATCHES "^(aarch64|arm64|arm.*)$")
+  list(APPEND libgav1_all_sources ${libgav1_dsp_sources_neon})
+endif()
+
+add_library(libgav1 STATIC ${libgav1_all_sources})
+set_target_properties(libgav1 PROPERTIES OUTPUT_NAME gav1 CXX_STANDARD 11
+                                         CXX_STANDARD_REQUIRED ON)
+target_include_directories(libgav1 PUBLIC "${libgav1_include_root}"
+                                          "${libgav1_root}")
+target_compile_definitions(libgav1 PUBLIC LIBGAV1_MAX_BITDEPTH=12)
+target_link_libraries(libgav1 PUBLIC Threads::Threads)
+if(absl_FOUND AND NOT ANDROID)
+  target_link_libraries(libgav1 PUBLIC absl::base absl::synchronization)
+else()
+  # The thread pool uses absl::Mutex off Android unless told otherwise.
+  target_compile_definitions(libgav1 PUBLIC LIBGAV1_THREADPOOL_USE_STD_MUTEX=1)
+endif()
@@ -0,0 +1,69 @@
+#include "codec_stats.h"
+
+#include <string.h>
+#include <time.h>
+
+#include "memory_pool.h"
+
+namespace avif_sample {
+
+namespace {
+
+int64_t ReadClockNs(clockid_t clock) {
+    struct timespec ts;
+    if (clock_gettime(clock, &ts) != 0) return 0;
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+int64_t WallTimeNs() { return ReadClockNs(CLOCK_MONOTONIC); }
+
+int64_t CpuTimeNs() { return ReadClockNs(CLOCK_PROCESS_CPUTIME_ID); }
+
+}  // namespace
+
+StatsCollector::StatsCollector(CodecStats *stats) : stats_(stats) {
+    if (stats_ == nullptr) return;
+    memset(stats_, 0, sizeof(*stats_));
+    start_wall_ns_ = WallTimeNs();
+    start_cpu_ns_ = CpuTimeNs();
+    libgav1::SetStageTimingCallback(OnLibgav1Stage, this);
+}
+
+void StatsCollector::Finish() {
+    if (stats_ == nullptr || finished_) return;
+    finished_ = true;
+    libgav1::SetStageTimingCallback(nullptr, nullptr);
+    stats_->total_wall_time_ns = WallTimeNs() - start_wall_ns_;
+    stats_->total_cpu_time_ns = CpuTimeNs() - start_cpu_ns_;
+    stats_->peak_memory_bytes = MemoryPool::Global().GetStats().peak_bytes;
+}
+
+void StatsCollector::AddStageTime(CodecStage stage, int64_t wall_time_ns,
+                                  int64_t cpu_time_ns) {
+    if (stats_ == nullptr || finished_) return;
+    stats_->wall_time_ns[stage] += wall_time_ns;
+    stats_->cpu_time_ns[stage] += cpu_time_ns;
+}
+
+void StatsCollector::OnLibgav1Stage(void *callback_private_data, Libgav1DecodeStage stage,
+                                    int64_t wall_time_ns, int64_t cpu_time_ns) {
+    static_cast<StatsCollector *>(callback_private_data)
+            ->AddStageTime(static_cast<CodecStage>(kStageAv1Parse + stage), wall_time_ns,
+                           cpu_time_ns);
+}
+
+StatsCollector::Scope::Scope(StatsCollector *collector, CodecStage stage)
+        : collector_(collector != nullptr && collector->enabled() ? collector : nullptr),
+          stage_(stage) {
+    if (collector_ == nullptr) return;
+    start_wall_ns_ = WallTimeNs();
+    start_cpu_ns_ = CpuTimeNs();
+}
+
+StatsCollector::Scope::~Scope() {
+    if (collector_ == nullptr) return;
+    collector_->AddStageTime(stage_, WallTimeNs() - start_wall_ns_,
+                             CpuTimeNs() - start_cpu_ns_);
+}
+
+}  // namespace avif_sample
@@ -0,0 +1,120 @@
+#ifndef AVIF_SAMPLE_CODEC_STATS_H_
+#define AVIF_SAMPLE_CODEC_STATS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "gav1/stage_timing.h"
+
+namespace avif_sample {
+
+// Stages timed by CodecStats. The AV1 decode stages mirror
+// Libgav1DecodeStage and must stay in the same order. Keep in sync with the
+// STAGE_* constants of AvifCodec.Stats.
+enum CodecStage {
+    // avifDecoderParse(): the ISOBMFF container and the AV1 sequence header.
+    kStageContainerParse,
+    kStageAv1Parse,
+    kStageAv1TileDecode,
+    kStageAv1Deblock,
+    kStageAv1Cdef,
+    kStageAv1SuperRes,
+    kStageAv1LoopRestoration,
+    kStageAv1BorderExtension,
+    kStageAv1FilmGrain,
+    kStageAv1Output,
+    // avifDecoderNextImage() as a whole, including all the AV1 stages above.
+    kStageImageDecode,
+    kStageYuvToRgb,
+    kStageRgbToYuv,
+    // avifEncoderAddImage(), which runs the AV1 encoder.
+    kStageEncode,
+    // avifEncoderFinish(): muxing the container.
+    kStageEncodeFinish,
+    kNumCodecStages
+};
+
+static_assert(kStageAv1Output - kStageAv1Parse + 1 == kLibgav1NumDecodeStages,
+              "CodecStage does not mirror Libgav1DecodeStage");
+
+struct CodecStats {
+    // Accumulated time per CodecStage. CPU time is process-wide, so
+    // cpu / wall above 1 means the stage kept several threads busy.
+    int64_t wall_time_ns[kNumCodecStages];
+    int64_t cpu_time_ns[kNumCodecStages];
+    // Whole call, from entering the JNI function to returning.
+    int64_t total_wall_time_ns;
+    int64_t total_cpu_time_ns;
+    // Encoded bytes consumed by a decode or produced by an encode.
+    uint64_t bytes_read;
+    uint64_t bytes_written;
+    // avifIOStats of the decoder or encoder.
+    uint64_t color_obu_size;
+    uint64_t alpha_obu_size;
+    // Thread limit the codec was configured with.
+    int threads;
+    // MemoryPool high-water mark at the end of the call. The pool is shared
+    // by the whole process, so this is only per call if the caller resets the
+    // peak in between and does not run codecs concurrently.
+    uint64_t peak_memory_bytes;
+    // True if the decode was served from the ImageCache.
+    bool cache_hit;
+};
+
+// Fills a CodecStats for the duration of one JNI call. All methods are no-ops
+// when constructed with a null |stats|, so the untimed path reads no clocks.
+//
+// While alive, the collector also receives libgav1's stage timings for
+// decodes running on the constructing thread; libavif drives libgav1
+// synchronously, so that covers every AV1 decode made by the call.
+class StatsCollector {
+public:
+    explicit StatsCollector(CodecStats *stats);
+
+    // Not copyable or movable.
+    StatsCollector(const StatsCollector &) = delete;
+
+    StatsCollector &operator=(const StatsCollector &) = delete;
+
+    ~StatsCollector() { Finish(); }
+
+    // Stops collecting and records the totals and the memory high-water
+    // mark. Called by the destructor if not called earlier.
+    void Finish();
+
+    bool enabled() const { return stats_ != nullptr; }
+    CodecStats *stats() { return stats_; }
+
+    void AddStageTime(CodecStage stage, int64_t wall_time_ns, int64_t cpu_time_ns);
+
+    // Times the enclosing scope as |stage|. |collector| may be null.
+    class Scope {
+    public:
+        Scope(StatsCollector *collector, CodecStage stage);
+
+        Scope(const Scope &) = delete;
+
+        Scope &operator=(const Scope &) = delete;
+
+        ~Scope();
+
+    private:
+        StatsCollector *const collector_;
+        const CodecStage stage_;
+        int64_t start_wall_ns_ = 0;
+        int64_t start_cpu_ns_ = 0;
+    };
+
+private:
+    static void OnLibgav1Stage(void *callback_private_data, Libgav1DecodeStage stage,
+                               int64_t wall_time_ns, int64_t cpu_time_ns);
+
+    CodecStats *const stats_;
+    bool finished_ = false;
+    int64_t start_wall_ns_ = 0;
+    int64_t start_cpu_ns_ = 0;
+};
+
+}  // namespace avif_sample
+
+#endif  // AVIF_SAMPLE_CODEC_STATS_H_
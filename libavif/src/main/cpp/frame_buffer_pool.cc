@@ -0,0 +1,264 @@
+#include "frame_buffer_pool.h"
+
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <new>
+
+#include "gav1/frame_buffer.h"
+
+namespace avif_sample {
+
+namespace {
+
+// Transparent huge pages are PMD sized: 2 MiB with 4 KiB base pages on x86-64
+// and arm64.
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+// Start of the U and V planes within a slab; generous for any SIMD row.
+constexpr size_t kPlaneAlignment = 64;
+constexpr int kClassesPerDoubling = 4;
+
+size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Minor page faults taken so far by the calling thread, or -1 if unknown.
+int64_t ThreadMinorFaults() {
+#if defined(RUSAGE_THREAD)
+    struct rusage usage;
+    if (getrusage(RUSAGE_THREAD, &usage) == 0) return usage.ru_minflt;
+#endif
+    return -1;
+}
+
+}  // namespace
+
+struct FrameBufferPool::Slab {
+    void *mapping;         // Address returned by mmap().
+    size_t mapping_size;
+    uint8_t *data;         // Start of the usable bytes within |mapping|.
+    size_t capacity;
+    FrameBufferBacking backing;
+    bool huge_pages;       // Whether |data| is advised as transparent huge pages.
+};
+
+FrameBufferPool::FrameBufferPool()
+        : backing_(kFrameBufferBackingDefault),
+          retain_limit_(kDefaultRetainLimit),
+          current_bytes_(0),
+          allocation_count_(0),
+          reuse_count_(0),
+          page_faults_avoided_(0) {
+    const long page_size = sysconf(_SC_PAGESIZE);
+    page_size_ = page_size > 0 ? static_cast<size_t>(page_size) : 4096;
+}
+
+FrameBufferPool::~FrameBufferPool() { Trim(); }
+
+FrameBufferPool &FrameBufferPool::Global() {
+    // Never destroyed: decoders may still release frames during exit.
+    static FrameBufferPool *const pool = new FrameBufferPool();
+    return *pool;
+}
+
+void FrameBufferPool::SetBacking(FrameBufferBacking backing) {
+    backing_.store(backing, std::memory_order_relaxed);
+    Trim();
+}
+
+void FrameBufferPool::Install(Libgav1DecoderSettings *settings) {
+    if (backing() == kFrameBufferBackingDefault || settings->get_frame_buffer != nullptr) {
+        return;
+    }
+    settings->on_frame_buffer_size_changed = nullptr;
+    settings->get_frame_buffer = GetFrameBuffer;
+    settings->release_frame_buffer = ReleaseFrameBuffer;
+    settings->callback_private_data = this;
+}
+
+size_t FrameBufferPool::SlabCapacity(size_t size) {
+    // Four classes per power of two: 1, 1.25, 1.5 and 1.75 times 2^msb.
+    size_t msb = 0;
+    while ((size >> (msb + 1)) != 0) ++msb;
+    if (msb < 2) return size;
+    const size_t step = (size_t{1} << msb) / kClassesPerDoubling;
+    return AlignUp(size, step);
+}
+
+Libgav1StatusCode FrameBufferPool::GetFrameBuffer(void *callback_private_data, int bitdepth,
+                                                  Libgav1ImageFormat image_format, int width,
+                                                  int height, int left_border,
+                                                  int right_border, int top_border,
+                                                  int bottom_border, int stride_alignment,
+                                                  Libgav1FrameBuffer *frame_buffer) {
+    Libgav1FrameBufferInfo info;
+    Libgav1StatusCode status = Libgav1ComputeFrameBufferInfo(
+            bitdepth, image_format, width, height, left_border, right_border, top_border,
+            bottom_border, stride_alignment, &info);
+    if (status != kLibgav1StatusOk) return status;
+    const size_t u_offset = AlignUp(info.y_buffer_size, kPlaneAlignment);
+    const size_t v_offset = u_offset + AlignUp(info.uv_buffer_size, kPlaneAlignment);
+    const size_t size = v_offset + info.uv_buffer_size;
+    Slab *const slab = static_cast<FrameBufferPool *>(callback_private_data)->Acquire(size);
+    if (slab == nullptr) return kLibgav1StatusOutOfMemory;
+    const bool has_uv = info.uv_buffer_size != 0;
+    status = Libgav1SetFrameBuffer(&info, slab->data, has_uv ? slab->data + u_offset : nullptr,
+                                   has_uv ? slab->data + v_offset : nullptr, slab,
+                                   frame_buffer);
+    if (status != kLibgav1StatusOk) {
+        static_cast<FrameBufferPool *>(callback_private_data)->Release(slab);
+    }
+    return status;
+}
+
+void FrameBufferPool::ReleaseFrameBuffer(void *callback_private_data,
+                                         void *buffer_private_data) {
+    static_cast<FrameBufferPool *>(callback_private_data)
+            ->Release(static_cast<Slab *>(buffer_private_data));
+}
+
+FrameBufferPool::Slab *FrameBufferPool::Acquire(size_t size) {
+    const FrameBufferBacking backing = this->backing();
+    // Rounding a frame smaller than a huge page up to one would waste more
+    // memory than the frame itself, so those get prefaulted small pages.
+    const bool huge_pages = backing == kFrameBufferBackingHugePages && size >= kHugePageSize;
+    size_t capacity = AlignUp(SlabCapacity(size), page_size_);
+    if (huge_pages) capacity = AlignUp(capacity, kHugePageSize);
+    // The decoder writes only the pages of |size|, not those of the rounding.
+    const uint64_t pages = AlignUp(size, page_size_) / page_size_;
+    allocation_count_.fetch_add(1, std::memory_order_relaxed);
+    Slab *slab = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < idle_slabs_.size(); ++i) {
+            if (idle_slabs_[i]->capacity == capacity && idle_slabs_[i]->backing == backing &&
+                idle_slabs_[i]->huge_pages == huge_pages) {
+                slab = idle_slabs_[i];
+                idle_slabs_[i] = idle_slabs_.back();
+                idle_slabs_.pop_back();
+                pooled_bytes_ -= capacity;
+                break;
+            }
+        }
+    }
+    if (slab != nullptr) {
+        // Every page of the slab is already backed by memory.
+        reuse_count_.fetch_add(1, std::memory_order_relaxed);
+        page_faults_avoided_.fetch_add(pages, std::memory_order_relaxed);
+    } else {
+        slab = MapSlab(capacity, backing, huge_pages, pages);
+        if (slab == nullptr) return nullptr;
+    }
+    current_bytes_.fetch_add(capacity, std::memory_order_relaxed);
+    return slab;
+}
+
+FrameBufferPool::Slab *FrameBufferPool::MapSlab(size_t capacity, FrameBufferBacking backing,
+                                                 bool huge_pages, uint64_t pages) {
+    // Over-allocate by a huge page so that the slab can start on one.
+    const size_t mapping_size = huge_pages ? capacity + kHugePageSize : capacity;
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    bool populated = false;
+#if defined(MAP_POPULATE)
+    // Let the kernel fault the pages in while mapping them. Huge pages are
+    // populated below, once the range has been advised.
+    if (!huge_pages) {
+        flags |= MAP_POPULATE;
+        populated = true;
+    }
+#endif
+    const int64_t faults_before = ThreadMinorFaults();
+    void *const mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (mapping == MAP_FAILED) return nullptr;
+    uint8_t *data = static_cast<uint8_t *>(mapping);
+    if (huge_pages) {
+        data = reinterpret_cast<uint8_t *>(
+                AlignUp(reinterpret_cast<uintptr_t>(mapping), kHugePageSize));
+#if defined(MADV_HUGEPAGE)
+        madvise(data, capacity, MADV_HUGEPAGE);
+#endif
+    }
+    if (!populated) {
+        // Fault the pages in now rather than during reconstruction. Under THP
+        // only the first write to each 2 MiB region faults.
+        for (size_t offset = 0; offset < capacity; offset += page_size_) {
+            static_cast<volatile uint8_t *>(data)[offset] = 0;
+        }
+    }
+    const int64_t faults_after = ThreadMinorFaults();
+    if (faults_before >= 0 && faults_after >= faults_before) {
+        const uint64_t faults = static_cast<uint64_t>(faults_after - faults_before);
+        if (faults < pages) {
+            page_faults_avoided_.fetch_add(pages - faults, std::memory_order_relaxed);
+        }
+    }
+    Slab *const slab = new (std::nothrow) Slab;
+    if (slab == nullptr) {
+        munmap(mapping, mapping_size);
+        return nullptr;
+    }
+    slab->mapping = mapping;
+    slab->mapping_size = mapping_size;
+    slab->data = data;
+    slab->capacity = capacity;
+    slab->backing = backing;
+    slab->huge_pages = huge_pages;
+    return slab;
+}
+
+void FrameBufferPool::Release(Slab *slab) {
+    current_bytes_.fetch_sub(slab->capacity, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (slab->backing == backing() &&
+            pooled_bytes_ + slab->capacity <= retain_limit_.load(std::memory_order_relaxed)) {
+            idle_slabs_.push_back(slab);
+            pooled_bytes_ += slab->capacity;
+            return;
+        }
+    }
+    munmap(slab->mapping, slab->mapping_size);
+    delete slab;
+}
+
+FrameBufferPoolStats FrameBufferPool::GetStats() const {
+    FrameBufferPoolStats stats;
+    stats.allocation_count = allocation_count_.load(std::memory_order_relaxed);
+    stats.reuse_count = reuse_count_.load(std::memory_order_relaxed);
+    stats.current_bytes = current_bytes_.load(std::memory_order_relaxed);
+    stats.page_faults_avoided = page_faults_avoided_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.pooled_bytes = pooled_bytes_;
+    return stats;
+}
+
+void FrameBufferPool::SetRetainLimit(size_t bytes) {
+    retain_limit_.store(bytes, std::memory_order_relaxed);
+    ReleaseIdle(bytes);
+}
+
+void FrameBufferPool::Trim() { ReleaseIdle(0); }
+
+void FrameBufferPool::ReleaseIdle(size_t target_bytes) {
+    std::vector<Slab *> released;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Release the largest slabs first; they are the most expensive to keep.
+        std::sort(idle_slabs_.begin(), idle_slabs_.end(),
+                  [](const Slab *a, const Slab *b) { return a->capacity < b->capacity; });
+        while (pooled_bytes_ > target_bytes && !idle_slabs_.empty()) {
+            released.push_back(idle_slabs_.back());
+            pooled_bytes_ -= idle_slabs_.back()->capacity;
+            idle_slabs_.pop_back();
+        }
+    }
+    // Unmap outside the lock; tearing down a large mapping is not free.
+    for (Slab *const slab : released) {
+        munmap(slab->mapping, slab->mapping_size);
+        delete slab;
+    }
+}
+
+}  // namespace avif_sample
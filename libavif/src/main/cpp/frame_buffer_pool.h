@@ -0,0 +1,132 @@
+#ifndef AVIF_SAMPLE_FRAME_BUFFER_POOL_H_
+#define AVIF_SAMPLE_FRAME_BUFFER_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "gav1/decoder_settings.h"
+
+namespace avif_sample {
+
+// Where the frame buffers of the libgav1 decoders come from. Keep in sync with
+// the FRAME_BUFFERS_* constants of AvifCodec.
+enum FrameBufferBacking {
+    // libgav1 allocates its own frame buffers (through MemoryPool).
+    kFrameBufferBackingDefault,
+    // Pooled slabs whose pages are faulted in when the slab is mapped.
+    kFrameBufferBackingPrefaulted,
+    // Pooled slabs aligned to and advised as transparent huge pages, so that a
+    // 2 MiB page is faulted in where 512 small ones would be. Frames smaller
+    // than a huge page are prefaulted instead. Falls back to small pages where
+    // the kernel has THP disabled.
+    kFrameBufferBackingHugePages,
+    kNumFrameBufferBackings
+};
+
+struct FrameBufferPoolStats {
+    // Number of frame buffers handed to libgav1.
+    uint64_t allocation_count;
+    // Number of those served by reusing an idle slab.
+    uint64_t reuse_count;
+    // Bytes of the slabs currently held by decoders.
+    size_t current_bytes;
+    // Bytes of the idle slabs kept for reuse.
+    size_t pooled_bytes;
+    // Page faults the decoder did not take while writing its frames, compared
+    // with a freshly allocated buffer that takes one fault per page of the
+    // frame: all those pages for a reused slab, and for a new slab the ones
+    // that the faults measured while mapping it did not account for, i.e.
+    // those covered by a huge page. The rounding of the slab capacity, which
+    // the decoder never writes, is not counted.
+    uint64_t page_faults_avoided;
+};
+
+// Backing store for libgav1 frame buffers, plugged in through the
+// get_frame_buffer and release_frame_buffer callbacks. A 48 MP frame is over
+// 70 MB; libgav1's own buffers are allocated on every size change and come
+// back from the system as untouched pages, so reconstruction takes a page
+// fault for every 4 KiB it writes. The pool maps each frame as one slab,
+// faults all of it in upfront (or lets THP cover it with 2 MiB pages) and
+// keeps released slabs for the next image of the same resolution class.
+//
+// Slab capacities are rounded up to four classes per power of two, so frames
+// of similar sizes share slabs. Thread-safe: the decoder threads get and
+// release buffers concurrently.
+class FrameBufferPool {
+public:
+    static constexpr size_t kDefaultRetainLimit = 256 * 1024 * 1024;
+
+    FrameBufferPool();
+
+    // Not copyable or movable.
+    FrameBufferPool(const FrameBufferPool &) = delete;
+
+    FrameBufferPool &operator=(const FrameBufferPool &) = delete;
+
+    ~FrameBufferPool();
+
+    // The process-wide pool that DecodeToSurface() installs into the libgav1
+    // decoders libavif creates.
+    static FrameBufferPool &Global();
+
+    FrameBufferBacking backing() const { return backing_.load(std::memory_order_relaxed); }
+
+    // Changes how new slabs are mapped and releases the idle ones. Buffers
+    // held by decoders keep their backing until they are released.
+    void SetBacking(FrameBufferBacking backing);
+
+    // Points the frame buffer callbacks of |settings| at this pool, unless the
+    // caller already supplied its own. Does nothing with
+    // kFrameBufferBackingDefault.
+    void Install(Libgav1DecoderSettings *settings);
+
+    FrameBufferPoolStats GetStats() const;
+
+    // Caps the number of idle bytes kept for reuse and releases the excess.
+    void SetRetainLimit(size_t bytes);
+
+    // Returns all idle slabs to the system.
+    void Trim();
+
+private:
+    struct Slab;
+
+    static Libgav1StatusCode GetFrameBuffer(void *callback_private_data, int bitdepth,
+                                            Libgav1ImageFormat image_format, int width,
+                                            int height, int left_border, int right_border,
+                                            int top_border, int bottom_border,
+                                            int stride_alignment,
+                                            Libgav1FrameBuffer *frame_buffer);
+    static void ReleaseFrameBuffer(void *callback_private_data, void *buffer_private_data);
+
+    // Rounds |size| up to its resolution class.
+    static size_t SlabCapacity(size_t size);
+
+    Slab *Acquire(size_t size);
+    // Maps a slab of |capacity| bytes and counts the faults that prefaulting
+    // it saved the decoder, which writes |pages| of them.
+    Slab *MapSlab(size_t capacity, FrameBufferBacking backing, bool huge_pages, uint64_t pages);
+    void Release(Slab *slab);
+    void ReleaseIdle(size_t target_bytes);
+
+    std::atomic<FrameBufferBacking> backing_;
+    std::atomic<size_t> retain_limit_;
+    std::atomic<size_t> current_bytes_;
+    std::atomic<uint64_t> allocation_count_;
+    std::atomic<uint64_t> reuse_count_;
+    std::atomic<uint64_t> page_faults_avoided_;
+    size_t page_size_;
+
+    mutable std::mutex mutex_;
+    // Guarded by |mutex_|.
+    std::vector<Slab *> idle_slabs_;
+    size_t pooled_bytes_ = 0;
+};
+
+}  // namespace avif_sample
+
+#endif  // AVIF_SAMPLE_FRAME_BUFFER_POOL_H_
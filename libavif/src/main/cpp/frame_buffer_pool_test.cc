@@ -0,0 +1,166 @@
+#include "frame_buffer_pool.h"
+
+#include <unistd.h>
+
+#include "gav1/decoder_settings.h"
+#include "gav1/frame_buffer.h"
+#include "gtest/gtest.h"
+
+namespace avif_sample {
+namespace {
+
+constexpr size_t kMiB = 1024 * 1024;
+
+// Gets and releases frame buffers through the libgav1 callbacks that the pool
+// installs. The frames are 8-bit monochrome without borders or stride
+// alignment, so a width x height frame needs exactly width * height bytes.
+class FrameBufferPoolTest : public testing::Test {
+protected:
+    void SetUp() override {
+        const long page_size = sysconf(_SC_PAGESIZE);
+        page_size_ = page_size > 0 ? static_cast<size_t>(page_size) : 4096;
+    }
+
+    void SetBacking(FrameBufferBacking backing) {
+        pool_.SetBacking(backing);
+        Libgav1DecoderSettingsInitDefault(&settings_);
+        pool_.Install(&settings_);
+        ASSERT_NE(settings_.get_frame_buffer, nullptr);
+    }
+
+    // Returns the buffer_private_data of the frame buffer, or nullptr.
+    void *Get(int width, int height) {
+        Libgav1FrameBuffer frame_buffer;
+        if (settings_.get_frame_buffer(settings_.callback_private_data, 8,
+                                       kLibgav1ImageFormatMonochrome400, width, height, 0, 0, 0,
+                                       0, 1, &frame_buffer) != kLibgav1StatusOk) {
+            return nullptr;
+        }
+        EXPECT_NE(frame_buffer.plane[0], nullptr);
+        // The whole frame must be writable.
+        frame_buffer.plane[0][0] = 1;
+        frame_buffer.plane[0][static_cast<size_t>(width) * height - 1] = 1;
+        return frame_buffer.private_data;
+    }
+
+    void Release(void *buffer) {
+        settings_.release_frame_buffer(settings_.callback_private_data, buffer);
+    }
+
+    size_t Pages(size_t bytes) const { return (bytes + page_size_ - 1) / page_size_; }
+
+    FrameBufferPool pool_;
+    Libgav1DecoderSettings settings_;
+    size_t page_size_;
+};
+
+TEST_F(FrameBufferPoolTest, DefaultBackingInstallsNothing) {
+    Libgav1DecoderSettingsInitDefault(&settings_);
+    pool_.Install(&settings_);
+    EXPECT_EQ(settings_.get_frame_buffer, nullptr);
+    EXPECT_EQ(settings_.release_frame_buffer, nullptr);
+}
+
+TEST_F(FrameBufferPoolTest, RoundsToResolutionClasses) {
+    SetBacking(kFrameBufferBackingPrefaulted);
+    // 1.25 MiB is a class of its own.
+    void *const exact = Get(1280, 1024);
+    ASSERT_NE(exact, nullptr);
+    EXPECT_EQ(pool_.GetStats().current_bytes, 5 * kMiB / 4);
+    // 1.27 MiB rounds up to the 1.5 MiB class.
+    void *const rounded = Get(1300, 1024);
+    ASSERT_NE(rounded, nullptr);
+    EXPECT_EQ(pool_.GetStats().current_bytes, 5 * kMiB / 4 + 3 * kMiB / 2);
+    Release(exact);
+    Release(rounded);
+    const FrameBufferPoolStats stats = pool_.GetStats();
+    EXPECT_EQ(stats.current_bytes, 0u);
+    EXPECT_EQ(stats.pooled_bytes, 5 * kMiB / 4 + 3 * kMiB / 2);
+}
+
+TEST_F(FrameBufferPoolTest, HugePagesOnlyForLargeFrames) {
+    SetBacking(kFrameBufferBackingHugePages);
+    // Smaller than a huge page: not rounded up to one.
+    void *const small = Get(1280, 1024);
+    ASSERT_NE(small, nullptr);
+    EXPECT_EQ(pool_.GetStats().current_bytes, 5 * kMiB / 4);
+    Release(small);
+    // 2.5 MiB: rounded up to a whole number of huge pages.
+    void *const large = Get(2560, 1024);
+    ASSERT_NE(large, nullptr);
+    EXPECT_EQ(pool_.GetStats().current_bytes, 4 * kMiB);
+    Release(large);
+}
+
+TEST_F(FrameBufferPoolTest, ReusesIdleSlabs) {
+    SetBacking(kFrameBufferBackingPrefaulted);
+    void *const first = Get(1300, 1024);
+    ASSERT_NE(first, nullptr);
+    Release(first);
+    FrameBufferPoolStats stats = pool_.GetStats();
+    EXPECT_EQ(stats.allocation_count, 1u);
+    EXPECT_EQ(stats.reuse_count, 0u);
+    const uint64_t faults_avoided = stats.page_faults_avoided;
+
+    // A frame of the same class gets the same slab back, and avoids a fault
+    // for each page of the frame, not of the slab.
+    void *const second = Get(1290, 1024);
+    EXPECT_EQ(second, first);
+    stats = pool_.GetStats();
+    EXPECT_EQ(stats.allocation_count, 2u);
+    EXPECT_EQ(stats.reuse_count, 1u);
+    EXPECT_EQ(stats.pooled_bytes, 0u);
+    EXPECT_EQ(stats.page_faults_avoided - faults_avoided, Pages(1290 * 1024));
+
+    // A frame of another class does not.
+    void *const third = Get(1280, 1024);
+    ASSERT_NE(third, nullptr);
+    EXPECT_NE(third, second);
+    EXPECT_EQ(pool_.GetStats().reuse_count, 1u);
+    Release(second);
+    Release(third);
+}
+
+TEST_F(FrameBufferPoolTest, RetainLimitAndTrim) {
+    SetBacking(kFrameBufferBackingPrefaulted);
+    pool_.SetRetainLimit(2 * kMiB);
+    void *const first = Get(1300, 1024);
+    void *const second = Get(1300, 1024);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    Release(first);
+    // Keeping the second 1.5 MiB slab would exceed the limit.
+    Release(second);
+    EXPECT_EQ(pool_.GetStats().pooled_bytes, 3 * kMiB / 2);
+
+    // Lowering the limit releases the excess.
+    pool_.SetRetainLimit(kMiB);
+    EXPECT_EQ(pool_.GetStats().pooled_bytes, 0u);
+
+    pool_.SetRetainLimit(FrameBufferPool::kDefaultRetainLimit);
+    Release(Get(1300, 1024));
+    Release(Get(1280, 1024));
+    EXPECT_EQ(pool_.GetStats().pooled_bytes, 3 * kMiB / 2 + 5 * kMiB / 4);
+    pool_.Trim();
+    const FrameBufferPoolStats stats = pool_.GetStats();
+    EXPECT_EQ(stats.pooled_bytes, 0u);
+    EXPECT_EQ(stats.current_bytes, 0u);
+}
+
+TEST_F(FrameBufferPoolTest, ChangingTheBackingReleasesIdleSlabs) {
+    SetBacking(kFrameBufferBackingPrefaulted);
+    void *const held = Get(1280, 1024);
+    ASSERT_NE(held, nullptr);
+    Release(Get(1300, 1024));
+    EXPECT_EQ(pool_.GetStats().pooled_bytes, 3 * kMiB / 2);
+    SetBacking(kFrameBufferBackingHugePages);
+    EXPECT_EQ(pool_.GetStats().pooled_bytes, 0u);
+    // A slab of the old backing is not kept when released.
+    Release(held);
+    const FrameBufferPoolStats stats = pool_.GetStats();
+    EXPECT_EQ(stats.pooled_bytes, 0u);
+    EXPECT_EQ(stats.current_bytes, 0u);
+}
+
+}  // namespace
+}  // namespace avif_sample
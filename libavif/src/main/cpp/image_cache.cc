@@ -0,0 +1,145 @@
+#include "image_cache.h"
+
+#include <string.h>
+
+namespace avif_sample {
+
+namespace {
+
+constexpr uint64_t kHashMul = 0x9E3779B97F4A7C15ull;
+
+inline uint64_t Mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDull;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+inline uint64_t Load64(const uint8_t *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// Number of bytes held by the YUV and alpha planes of |image|.
+size_t ImageBytes(const avifImage *image) {
+    avifPixelFormatInfo info;
+    avifGetPixelFormatInfo(image->yuvFormat, &info);
+    const size_t uv_height = (image->height + info.chromaShiftY) >> info.chromaShiftY;
+    size_t bytes = static_cast<size_t>(image->yuvRowBytes[AVIF_CHAN_Y]) * image->height;
+    if (!info.monochrome) {
+        bytes += static_cast<size_t>(image->yuvRowBytes[AVIF_CHAN_U]) * uv_height;
+        bytes += static_cast<size_t>(image->yuvRowBytes[AVIF_CHAN_V]) * uv_height;
+    }
+    if (image->alphaPlane != nullptr) {
+        bytes += static_cast<size_t>(image->alphaRowBytes) * image->height;
+    }
+    return bytes;
+}
+
+}  // namespace
+
+uint64_t HashEncodedData(const uint8_t *data, size_t length) {
+    // Four independent lanes keep the multiplies from serialising on one
+    // dependency chain; this hashes several GB/s, well below decode cost.
+    uint64_t lanes[4] = {length * kHashMul, ~length, length ^ kHashMul, 0};
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        for (int lane = 0; lane < 4; ++lane) {
+            lanes[lane] = (lanes[lane] ^ Load64(data + i + lane * 8)) * kHashMul;
+            lanes[lane] ^= lanes[lane] >> 29;
+        }
+    }
+    uint64_t hash = Mix(lanes[0]) ^ Mix(lanes[1] + 1) ^ Mix(lanes[2] + 2) ^
+                    Mix(lanes[3] + 3);
+    for (; i + 8 <= length; i += 8) {
+        hash = Mix(hash ^ Load64(data + i));
+    }
+    uint64_t tail = 0;
+    if (i < length) {
+        memcpy(&tail, data + i, length - i);
+        hash = Mix(hash ^ tail ^ (static_cast<uint64_t>(length - i) << 56));
+    }
+    return Mix(hash);
+}
+
+ImageCache::ImageCache(size_t budget_bytes) : budget_bytes_(budget_bytes) {}
+
+ImageCache &ImageCache::Global() {
+    static ImageCache *const cache = new ImageCache(kDefaultBudgetBytes);
+    return *cache;
+}
+
+ImageCache::ImagePtr ImageCache::Lookup(const ImageCacheKey &key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = map_.find(key);
+    if (it == map_.end()) return nullptr;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->image;
+}
+
+void ImageCache::Insert(const ImageCacheKey &key, const avifImage *image) {
+    if (!enabled()) return;
+    // Copy outside the lock; the planes can be tens of megabytes.
+    avifImage *copy = avifImageCreateEmpty();
+    if (copy == nullptr) return;
+    avifImageCopy(copy, image, AVIF_PLANES_ALL);
+    if (copy->yuvPlanes[AVIF_CHAN_Y] == nullptr) {
+        avifImageDestroy(copy);
+        return;
+    }
+    const size_t bytes = ImageBytes(copy);
+    ImagePtr image_ptr(copy, avifImageDestroy);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (bytes > budget_bytes_) return;
+    auto it = map_.find(key);
+    if (it != map_.end()) {
+        size_bytes_ -= it->second->bytes;
+        lru_.erase(it->second);
+        map_.erase(it);
+    }
+    EvictLocked(budget_bytes_ - bytes);
+    lru_.push_front({key, std::move(image_ptr), bytes});
+    map_[key] = lru_.begin();
+    size_bytes_ += bytes;
+}
+
+void ImageCache::SetBudget(size_t budget_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    budget_bytes_ = budget_bytes;
+    EvictLocked(budget_bytes_);
+}
+
+void ImageCache::Trim(size_t target_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    EvictLocked(target_bytes);
+}
+
+bool ImageCache::enabled() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return budget_bytes_ > 0;
+}
+
+size_t ImageCache::size_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_bytes_;
+}
+
+size_t ImageCache::budget_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return budget_bytes_;
+}
+
+void ImageCache::EvictLocked(size_t target_bytes) {
+    while (size_bytes_ > target_bytes && !lru_.empty()) {
+        const Entry &victim = lru_.back();
+        size_bytes_ -= victim.bytes;
+        map_.erase(victim.key);
+        lru_.pop_back();
+    }
+}
+
+}  // namespace avif_sample
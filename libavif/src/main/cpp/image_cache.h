@@ -0,0 +1,107 @@
+#ifndef AVIF_SAMPLE_IMAGE_CACHE_H_
+#define AVIF_SAMPLE_IMAGE_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "avif/avif.h"
+
+namespace avif_sample {
+
+// Identifies one decoded image: the encoded bytes (by hash and length), the
+// size of the surface the caller is decoding into and the DecodeQuality it was
+// decoded at.
+struct ImageCacheKey {
+    uint64_t hash;
+    size_t length;
+    uint32_t target_width;
+    uint32_t target_height;
+    int quality;
+
+    bool operator==(const ImageCacheKey &other) const {
+        return hash == other.hash && length == other.length &&
+               target_width == other.target_width &&
+               target_height == other.target_height && quality == other.quality;
+    }
+};
+
+// Returns a fast, non-cryptographic 64-bit hash of |length| bytes at |data|.
+uint64_t HashEncodedData(const uint8_t *data, size_t length);
+
+// Thread-safe LRU cache of decoded images. Images are kept as YUV(A) planes,
+// which for 4:2:0 content is less than half the size of the RGBA output, so a
+// hit only costs the colour conversion into the destination bitmap.
+class ImageCache {
+public:
+    using ImagePtr = std::shared_ptr<const avifImage>;
+
+    static constexpr size_t kDefaultBudgetBytes = 32 * 1024 * 1024;
+
+    explicit ImageCache(size_t budget_bytes);
+
+    // Not copyable or movable.
+    ImageCache(const ImageCache &) = delete;
+
+    ImageCache &operator=(const ImageCache &) = delete;
+
+    // The process-wide cache used by the JNI layer.
+    static ImageCache &Global();
+
+    // Returns the cached image for |key| and marks it as most recently used,
+    // or nullptr on a miss. The returned image stays valid even if it is
+    // evicted while the caller is still reading from it.
+    ImagePtr Lookup(const ImageCacheKey &key);
+
+    // Stores a deep copy of |image|'s planes under |key|, evicting least
+    // recently used entries to stay within the budget. Images larger than the
+    // whole budget are not cached.
+    void Insert(const ImageCacheKey &key, const avifImage *image);
+
+    // Changes the byte budget and evicts down to it. A budget of 0 disables
+    // the cache.
+    void SetBudget(size_t budget_bytes);
+
+    // Evicts least recently used entries until at most |target_bytes| are
+    // held. Used to respond to memory pressure without changing the budget.
+    void Trim(size_t target_bytes);
+
+    void Clear() { Trim(0); }
+
+    bool enabled() const;
+    size_t size_bytes() const;
+    size_t budget_bytes() const;
+
+private:
+    struct KeyHash {
+        size_t operator()(const ImageCacheKey &key) const {
+            return static_cast<size_t>(key.hash ^ (key.target_width * 31u) ^
+                                       (static_cast<uint64_t>(key.target_height) << 32) ^
+                                       (static_cast<uint64_t>(key.quality) << 48));
+        }
+    };
+
+    struct Entry {
+        ImageCacheKey key;
+        ImagePtr image;
+        size_t bytes;
+    };
+
+    // Must be called with |mutex_| held.
+    void EvictLocked(size_t target_bytes);
+
+    mutable std::mutex mutex_;
+    size_t budget_bytes_;
+    size_t size_bytes_ = 0;
+    // Most recently used entries are at the front.
+    std::list<Entry> lru_;
+    std::unordered_map<ImageCacheKey, std::list<Entry>::iterator, KeyHash> map_;
+};
+
+}  // namespace avif_sample
+
+#endif  // AVIF_SAMPLE_IMAGE_CACHE_H_
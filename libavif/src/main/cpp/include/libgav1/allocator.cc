@@ -0,0 +1,27 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/gav1/allocator.h"
+
+#include "src/utils/memory.h"
+
+extern "C" {
+
+void Libgav1SetAllocator(Libgav1AlignedAllocCallback alloc,
+                         Libgav1AlignedFreeCallback free,
+                         void* callback_private_data) {
+  libgav1::SetAlignedAllocator(alloc, free, callback_private_data);
+}
+
+}  // extern "C"
@@ -58,9 +58,31 @@ bool RefCountedBuffer::Realloc(int bitdepth, bool is_monochrome, int width,
     return false;
   }
   buffer_private_data_valid_ = true;
+  frame_bytes_ = yuv_buffer_.plane_bytes();
+  MemoryTracker* const memory_tracker = pool_->memory_tracker_;
+  // Frame buffers from the internal list are reported when the list grows.
+  if (memory_tracker != nullptr && !pool_->uses_internal_frame_buffers_ &&
+      !memory_tracker->Reserve(kMemoryClassFrameBuffers, frame_bytes_)) {
+    LIBGAV1_DLOG(ERROR, "Frame buffer exceeds the memory limit.");
+    pool_->release_frame_buffer_(pool_->callback_private_data_,
+                                 buffer_private_data_);
+    buffer_private_data_valid_ = false;
+    frame_bytes_ = 0;
+    return false;
+  }
   return true;
 }
 
+void RefCountedBuffer::SetFilmGrainFrame() {
+  assert(buffer_private_data_valid_);
+  if (is_film_grain_frame_) return;
+  is_film_grain_frame_ = true;
+  if (pool_->memory_tracker_ != nullptr) {
+    pool_->memory_tracker_->Move(kMemoryClassFrameBuffers,
+                                 kMemoryClassFilmGrainFrames, frame_bytes_);
+  }
+}
+
 bool RefCountedBuffer::SetFrameDimensions(const ObuFrameHeader& frame_header) {
   upscaled_width_ = frame_header.upscaled_width;
   frame_width_ = frame_header.width;
@@ -77,7 +99,19 @@ bool RefCountedBuffer::SetFrameDimensions(const ObuFrameHeader& frame_header) {
       return false;
     }
   }
-  return segmentation_map_.Allocate(rows4x4_, columns4x4_);
+  const bool ok = segmentation_map_.Allocate(rows4x4_, columns4x4_);
+  const size_t side_data_bytes =
+      segmentation_map_.allocated_bytes() +
+      reference_info_.motion_field_reference_frame.allocated_bytes() +
+      reference_info_.motion_field_mv.allocated_bytes();
+  if (pool_->memory_tracker_ != nullptr) {
+    pool_->memory_tracker_->Add(
+        kMemoryClassFrameBuffers,
+        static_cast<int64_t>(side_data_bytes) -
+            static_cast<int64_t>(side_data_bytes_));
+  }
+  side_data_bytes_ = side_data_bytes;
+  return ok;
 }
 
 void RefCountedBuffer::SetGlobalMotions(
@@ -131,6 +165,7 @@ BufferPool::BufferPool(
     release_frame_buffer_ = ReleaseInternalFrameBuffer;
     callback_private_data_ = &internal_frame_buffers_;
   }
+  uses_internal_frame_buffers_ = get_frame_buffer == nullptr;
 }
 
 BufferPool::~BufferPool() {
@@ -139,6 +174,12 @@ BufferPool::~BufferPool() {
       assert(false && "RefCountedBuffer still in use at destruction time.");
       LIBGAV1_DLOG(ERROR, "RefCountedBuffer still in use at destruction time.");
     }
+    if (memory_tracker_ != nullptr) {
+      memory_tracker_->Add(
+          kMemoryClassFrameBuffers,
+          -static_cast<int64_t>(sizeof(RefCountedBuffer) +
+                                buffer->side_data_bytes_));
+    }
     delete buffer;
   }
 }
@@ -193,6 +234,10 @@ RefCountedBufferPtr BufferPool::GetFreeBuffer() {
     delete buffer;
     return RefCountedBufferPtr();
   }
+  // Released by ~BufferPool(), which deletes the buffers in |buffers_|.
+  if (memory_tracker_ != nullptr) {
+    memory_tracker_->Add(kMemoryClassFrameBuffers, sizeof(RefCountedBuffer));
+  }
   return RefCountedBufferPtr(buffer, RefCountedBuffer::ReturnToBufferPool);
 }
 
@@ -205,6 +250,11 @@ void BufferPool::Abort() {
   }
 }
 
+void BufferPool::set_memory_tracker(MemoryTracker* const memory_tracker) {
+  memory_tracker_ = memory_tracker;
+  internal_frame_buffers_.set_memory_tracker(memory_tracker);
+}
+
 void BufferPool::ReturnUnusedBuffer(RefCountedBuffer* buffer) {
   std::lock_guard<std::mutex> lock(mutex_);
   assert(buffer->in_use_);
@@ -212,6 +262,19 @@ void BufferPool::ReturnUnusedBuffer(RefCountedBuffer* buffer) {
   if (buffer->buffer_private_data_valid_) {
     release_frame_buffer_(callback_private_data_, buffer->buffer_private_data_);
     buffer->buffer_private_data_valid_ = false;
+    if (memory_tracker_ != nullptr) {
+      if (buffer->is_film_grain_frame_) {
+        memory_tracker_->Move(kMemoryClassFilmGrainFrames,
+                              kMemoryClassFrameBuffers, buffer->frame_bytes_);
+      }
+      // The internal list keeps its buffers for reuse.
+      if (!uses_internal_frame_buffers_) {
+        memory_tracker_->Add(kMemoryClassFrameBuffers,
+                             -static_cast<int64_t>(buffer->frame_bytes_));
+      }
+    }
+    buffer->is_film_grain_frame_ = false;
+    buffer->frame_bytes_ = 0;
   }
 }
 
@@ -33,6 +33,7 @@
 #include "src/symbol_decoder_context.h"
 #include "src/utils/compiler_attributes.h"
 #include "src/utils/constants.h"
+#include "src/utils/memory_tracker.h"
 #include "src/utils/reference_info.h"
 #include "src/utils/segmentation.h"
 #include "src/utils/segmentation_map.h"
@@ -83,6 +84,11 @@ class RefCountedBuffer : public MaxAlignedAllocable {
 
   YuvBuffer* buffer() { return &yuv_buffer_; }
 
+  // Counts the frame buffer as kMemoryClassFilmGrainFrames rather than
+  // kMemoryClassFrameBuffers until it is returned to the pool. Must be called
+  // after Realloc().
+  void SetFilmGrainFrame();
+
   // Returns the buffer private data set by the get frame buffer callback when
   // it allocated the YUV buffer.
   void* buffer_private_data() const {
@@ -290,6 +296,12 @@ class RefCountedBuffer : public MaxAlignedAllocable {
   void* buffer_private_data_ = nullptr;
   YuvBuffer yuv_buffer_;
   bool in_use_ = false;  // Only used by BufferPool.
+  // The bytes of the frame buffer obtained by Realloc(), and whether they are
+  // counted as kMemoryClassFilmGrainFrames.
+  size_t frame_bytes_ = 0;
+  bool is_film_grain_frame_ = false;
+  // The bytes of |segmentation_map_| and |reference_info_|.
+  size_t side_data_bytes_ = 0;
 
   std::mutex mutex_;
   FrameState frame_state_ = kFrameStateUnknown LIBGAV1_GUARDED_BY(mutex_);
@@ -372,6 +384,11 @@ class BufferPool {
   // Aborts all the buffers that are in use.
   void Abort();
 
+  // Reports the memory of the buffers to |memory_tracker|, which must outlive
+  // the pool, and keeps the frame buffers within its limit. Must be called
+  // before the first GetFreeBuffer() call.
+  void set_memory_tracker(MemoryTracker* memory_tracker);
+
  private:
   friend class RefCountedBuffer;
 
@@ -395,6 +412,10 @@ class BufferPool {
   ReleaseFrameBufferCallback release_frame_buffer_;
   // Private data associated with the frame buffer callbacks.
   void* callback_private_data_;
+  // True if the frame buffers come from |internal_frame_buffers_|, which
+  // reports them to |memory_tracker_| itself.
+  bool uses_internal_frame_buffers_;
+  MemoryTracker* memory_tracker_ = nullptr;
 };
 
 }  // namespace libgav1
@@ -27,6 +27,7 @@
 #include "src/gav1/frame_buffer.h"
 #include "src/internal_frame_buffer_list.h"
 #include "src/utils/constants.h"
+#include "src/utils/memory_tracker.h"
 #include "src/utils/types.h"
 #include "src/yuv_buffer.h"
 
@@ -60,6 +61,34 @@ TEST(BufferPoolTest, RefCountedBufferPtr) {
   EXPECT_EQ(buffer_ptr4.use_count(), 2);
 }
 
+// The pool reports its buffers, including their side data, to the memory
+// tracker until it is destroyed.
+TEST(BufferPoolTest, MemoryTracker) {
+  MemoryTracker memory_tracker(0);
+  {
+    InternalFrameBufferList buffer_list;
+    BufferPool buffer_pool(OnInternalFrameBufferSizeChanged,
+                           GetInternalFrameBuffer, ReleaseInternalFrameBuffer,
+                           &buffer_list);
+    buffer_pool.set_memory_tracker(&memory_tracker);
+    RefCountedBufferPtr buffer_ptr = buffer_pool.GetFreeBuffer();
+    ASSERT_NE(buffer_ptr, nullptr);
+    RefCountedBufferPtr buffer_ptr2 = buffer_pool.GetFreeBuffer();
+    ASSERT_NE(buffer_ptr2, nullptr);
+    EXPECT_EQ(memory_tracker.total_bytes(), 2 * sizeof(RefCountedBuffer));
+    ObuFrameHeader frame_header = {};
+    frame_header.rows4x4 = 20;
+    frame_header.columns4x4 = 30;
+    ASSERT_TRUE(buffer_ptr->SetFrameDimensions(frame_header));
+    EXPECT_GT(memory_tracker.total_bytes(), 2 * sizeof(RefCountedBuffer));
+    // Returned buffers stay in the pool, and stay counted, for reuse.
+    buffer_ptr = nullptr;
+    buffer_ptr2 = nullptr;
+    EXPECT_GT(memory_tracker.total_bytes(), 2 * sizeof(RefCountedBuffer));
+  }
+  EXPECT_EQ(memory_tracker.total_bytes(), 0u);
+}
+
 TEST(RefCountedBufferTest, SetFrameDimensions) {
   InternalFrameBufferList buffer_list;
   BufferPool buffer_pool(OnInternalFrameBufferSizeChanged,
@@ -14,19 +14,67 @@
 
 #include "src/gav1/decoder.h"
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <new>
 
 #include "src/decoder_impl.h"
 
+namespace {
+
+struct DecoderSettingsCallbackInfo {
+  Libgav1DecoderSettingsCallback callback;
+  void* callback_private_data;
+};
+
+thread_local DecoderSettingsCallbackInfo thread_decoder_settings_callback = {
+    nullptr, nullptr};
+
+}  // namespace
+
 extern "C" {
 
+void Libgav1SetDecoderSettingsCallback(Libgav1DecoderSettingsCallback callback,
+                                       void* callback_private_data) {
+  thread_decoder_settings_callback = {callback, callback_private_data};
+}
+
 Libgav1StatusCode Libgav1DecoderCreate(const Libgav1DecoderSettings* settings,
                                        Libgav1Decoder** decoder_out) {
+  return Libgav1DecoderCreateWithExtension(settings, nullptr, decoder_out);
+}
+
+Libgav1StatusCode Libgav1DecoderCreateWithExtension(
+    const Libgav1DecoderSettings* settings,
+    const Libgav1DecoderSettingsExtension* extension,
+    Libgav1Decoder** decoder_out) {
+  // Copy the part of |extension| the caller knows about over the defaults, so
+  // that callers built against an older, shorter structure keep working.
+  Libgav1DecoderSettingsExtension full_extension;
+  Libgav1DecoderSettingsExtensionInitDefault(&full_extension);
+  if (extension != nullptr) {
+    if (extension->size < sizeof(extension->size)) {
+      return kLibgav1StatusInvalidArgument;
+    }
+    memcpy(&full_extension, extension,
+           std::min(extension->size, sizeof(full_extension)));
+    full_extension.size = sizeof(full_extension);
+  }
+
   std::unique_ptr<libgav1::Decoder> cxx_decoder(new (std::nothrow)
                                                     libgav1::Decoder());
   if (cxx_decoder == nullptr) return kLibgav1StatusOutOfMemory;
 
+  Libgav1DecoderSettings adjusted_settings;
+  if (thread_decoder_settings_callback.callback != nullptr) {
+    adjusted_settings = *settings;
+    thread_decoder_settings_callback.callback(
+        thread_decoder_settings_callback.callback_private_data,
+        &adjusted_settings, &full_extension);
+    settings = &adjusted_settings;
+  }
+
   libgav1::DecoderSettings cxx_settings;
   cxx_settings.threads = settings->threads;
   cxx_settings.frame_parallel = settings->frame_parallel != 0;
@@ -40,6 +88,12 @@ Libgav1StatusCode Libgav1DecoderCreate(const Libgav1DecoderSettings* settings,
   cxx_settings.output_all_layers = settings->output_all_layers != 0;
   cxx_settings.operating_point = settings->operating_point;
   cxx_settings.post_filter_mask = settings->post_filter_mask;
+  cxx_settings.thread_pool = reinterpret_cast<libgav1::DecoderThreadPool*>(
+      full_extension.thread_pool);
+  cxx_settings.preview_shift = full_extension.preview_shift;
+  cxx_settings.frame_ready = full_extension.frame_ready;
+  cxx_settings.prefer_fast_cores = full_extension.prefer_fast_cores != 0;
+  cxx_settings.memory_limit = full_extension.memory_limit;
 
   const Libgav1StatusCode status = cxx_decoder->Init(&cxx_settings);
   if (status == kLibgav1StatusOk) {
@@ -77,6 +131,12 @@ int Libgav1DecoderGetMaxBitdepth() {
   return libgav1::Decoder::GetMaxBitdepth();
 }
 
+Libgav1StatusCode Libgav1DecoderGetMemoryUsage(const Libgav1Decoder* decoder,
+                                               Libgav1MemoryUsage* usage) {
+  const auto* cxx_decoder = reinterpret_cast<const libgav1::Decoder*>(decoder);
+  return cxx_decoder->GetMemoryUsage(usage);
+}
+
 }  // extern "C"
 
 namespace libgav1 {
@@ -116,4 +176,10 @@ StatusCode Decoder::SignalEOS() {
 // static.
 int Decoder::GetMaxBitdepth() { return DecoderImpl::GetMaxBitdepth(); }
 
+StatusCode Decoder::GetMemoryUsage(MemoryUsage* usage) const {
+  if (impl_ == nullptr) return kStatusNotInitialized;
+  impl_->GetMemoryUsage(usage);
+  return kStatusOk;
+}
+
 }  // namespace libgav1
@@ -38,6 +38,7 @@
 #include "src/utils/logging.h"
 #include "src/utils/raw_bit_reader.h"
 #include "src/utils/segmentation.h"
+#include "src/utils/stage_timer.h"
 #include "src/utils/threadpool.h"
 #include "src/yuv_buffer.h"
 
@@ -68,6 +69,99 @@ int GetBottomBorderPixels(const bool do_cdef, const bool do_restoration,
   return Align(kBorderPixels + extra_border, 2);  // Must be a multiple of 2.
 }
 
+// Returns true if the frame is saved as a reference frame. The only frame of a
+// still picture is not, since no other frame can refer to it. This keeps the
+// reference slots from holding on to its buffer, lets film grain be applied in
+// place, and lets the frame use the smaller kStillPictureBorderPixels borders
+// because they are never extended.
+bool IsReferenceFrame(const ObuSequenceHeader& sequence_header,
+                      const ObuFrameHeader& frame_header) {
+  return frame_header.refresh_frame_flags != 0 &&
+         !sequence_header.still_picture;
+}
+
+// Returns the size of the left and top borders of the frames of the coded video
+// sequence. See the comment on kStillPictureBorderPixels.
+int GetLeftTopBorderPixels(const ObuSequenceHeader& sequence_header) {
+  return sequence_header.still_picture ? kStillPictureBorderPixels
+                                       : kBorderPixels;
+}
+
+// Returns the bytes of a frame buffer for |frame_header|, with the borders
+// that DecodeTiles() allocates except for the extra bottom border rows of the
+// post filters. The rows are aligned to |stride_alignment| bytes.
+size_t GetFrameBufferBytes(const ObuSequenceHeader& sequence_header,
+                           const ObuFrameHeader& frame_header,
+                           int stride_alignment) {
+  const ColorConfig& color_config = sequence_header.color_config;
+  const int left_top_border = GetLeftTopBorderPixels(sequence_header);
+  FrameBufferInfo info;
+  if (ComputeFrameBufferInfo(
+          color_config.bitdepth,
+          ComposeImageFormat(color_config.is_monochrome,
+                             color_config.subsampling_x,
+                             color_config.subsampling_y),
+          frame_header.upscaled_width, frame_header.height, left_top_border,
+          kBorderPixels, left_top_border, kBorderPixels, stride_alignment,
+          &info) != kStatusOk) {
+    return 0;
+  }
+  return info.y_buffer_size + 2 * info.uv_buffer_size;
+}
+
+// Returns a lower bound of the frame scratch memory that a frame thread holds
+// while it decodes a frame of |frame_header|: the block parameter pointers and
+// transform sizes of each 4x4 block, a residual buffer for each superblock
+// (frame threads parse a whole tile before they reconstruct it) and a tile
+// scratch buffer.
+size_t GetFrameScratchBytes(const ObuSequenceHeader& sequence_header,
+                            const ObuFrameHeader& frame_header) {
+  const ColorConfig& color_config = sequence_header.color_config;
+  const size_t blocks4x4 =
+      static_cast<size_t>(frame_header.rows4x4 + kMaxBlockHeight4x4) *
+      (frame_header.columns4x4 + kMaxBlockWidth4x4);
+  const int superblock_shift = sequence_header.use_128x128_superblock ? 5 : 4;
+  const size_t superblocks =
+      static_cast<size_t>(
+          RightShiftWithCeiling(frame_header.rows4x4, superblock_shift)) *
+      RightShiftWithCeiling(frame_header.columns4x4, superblock_shift);
+  const ResidualBufferPool residual_buffer_pool(
+      sequence_header.use_128x128_superblock, color_config.subsampling_x,
+      color_config.subsampling_y,
+      color_config.bitdepth == 8 ? sizeof(int16_t) : sizeof(int32_t));
+  return blocks4x4 * (2 * sizeof(BlockParameters*) + sizeof(uint8_t)) +
+         superblocks * residual_buffer_pool.buffer_bytes() +
+         TileScratchBuffer::AllocatedBytes(color_config.bitdepth);
+}
+
+// Writes the average of each |1 << shift| by |1 << shift| block of the
+// |width| by |height| plane at |source| to one pixel of |dest|. Blocks on the
+// right and bottom edges are clipped to the plane. Strides are in bytes.
+template <typename Pixel>
+void DownscalePlane(const uint8_t* source, ptrdiff_t source_stride, int width,
+                    int height, int shift, uint8_t* dest,
+                    ptrdiff_t dest_stride) {
+  const int dest_width = RightShiftWithCeiling(width, shift);
+  const int dest_height = RightShiftWithCeiling(height, shift);
+  const int block_size = 1 << shift;
+  for (int y = 0; y < dest_height; ++y) {
+    const int rows = std::min(block_size, height - (y << shift));
+    auto* const dst = reinterpret_cast<Pixel*>(dest + y * dest_stride);
+    for (int x = 0; x < dest_width; ++x) {
+      const int columns = std::min(block_size, width - (x << shift));
+      const uint8_t* row = source + (y << shift) * source_stride;
+      uint32_t sum = 0;
+      for (int i = 0; i < rows; ++i) {
+        const auto* const src = reinterpret_cast<const Pixel*>(row);
+        for (int j = 0; j < columns; ++j) sum += src[(x << shift) + j];
+        row += source_stride;
+      }
+      const uint32_t count = rows * columns;
+      dst[x] = static_cast<Pixel>((sum + (count >> 1)) / count);
+    }
+  }
+}
+
 // Sets |frame_scratch_buffer->tile_decoding_failed| to true (while holding on
 // to |frame_scratch_buffer->superblock_row_mutex|) and notifies the first
 // |count| condition variables in
@@ -86,21 +180,72 @@ void SetFailureAndNotifyAll(FrameScratchBuffer* const frame_scratch_buffer,
   }
 }
 
+// Reports the growth (or shrinkage) of |frame_scratch_buffer| since the last
+// call to |memory_tracker|. The tile scratch buffers and residual buffers are
+// counted only while they are back in their pools, so this is called both
+// before and after the tiles are decoded.
+void UpdateScratchMemory(FrameScratchBuffer* const frame_scratch_buffer,
+                         MemoryTracker* const memory_tracker) {
+  FrameScratchBuffer& buffer = *frame_scratch_buffer;
+  size_t bytes[kNumMemoryClasses] = {};
+  bytes[kMemoryClassFrameScratch] =
+      sizeof(FrameScratchBuffer) +
+      buffer.loop_restoration_info.allocated_bytes() +
+      buffer.cdef_index.allocated_bytes() + buffer.cdef_skip.allocated_bytes() +
+      buffer.inter_transform_sizes.allocated_bytes() +
+      buffer.block_parameters_holder.allocated_bytes() +
+      buffer.motion_field.mv.allocated_bytes() +
+      buffer.motion_field.reference_offset.allocated_bytes() +
+      buffer.post_filter_band_progress.allocated_bytes() +
+      buffer.superblock_row_progress.allocated_bytes() +
+      buffer.superblock_row_progress_condvar.allocated_bytes();
+  if (buffer.residual_buffer_pool != nullptr) {
+    bytes[kMemoryClassResiduals] =
+        buffer.residual_buffer_pool->allocated_bytes();
+  }
+  bytes[kMemoryClassTileScratch] =
+      buffer.tile_scratch_buffer_pool.allocated_bytes() +
+      buffer.intra_prediction_buffers.allocated_bytes();
+  for (size_t i = 0; i < buffer.intra_prediction_buffers.size(); ++i) {
+    for (const auto& plane_buffer : buffer.intra_prediction_buffers.get()[i]) {
+      bytes[kMemoryClassTileScratch] += plane_buffer.allocated_bytes();
+    }
+  }
+  bytes[kMemoryClassPostFilterBorders] =
+      buffer.cdef_border.allocated_bytes() +
+      buffer.loop_restoration_border.allocated_bytes() +
+      buffer.superres_line_buffer.allocated_bytes();
+  for (const auto& coefficients : buffer.superres_coefficients) {
+    bytes[kMemoryClassPostFilterBorders] += coefficients.allocated_bytes();
+  }
+  for (int i = 0; i < kNumMemoryClasses; ++i) {
+    if (bytes[i] == buffer.accounted_bytes[i]) continue;
+    memory_tracker->Add(static_cast<MemoryClass>(i),
+                        static_cast<int64_t>(bytes[i]) -
+                            static_cast<int64_t>(buffer.accounted_bytes[i]));
+    buffer.accounted_bytes[i] = bytes[i];
+  }
+}
+
 // Helper class that releases the frame scratch buffer in the destructor.
 class FrameScratchBufferReleaser {
  public:
   FrameScratchBufferReleaser(
       FrameScratchBufferPool* frame_scratch_buffer_pool,
-      std::unique_ptr<FrameScratchBuffer>* frame_scratch_buffer)
+      std::unique_ptr<FrameScratchBuffer>* frame_scratch_buffer,
+      MemoryTracker* memory_tracker)
       : frame_scratch_buffer_pool_(frame_scratch_buffer_pool),
-        frame_scratch_buffer_(frame_scratch_buffer) {}
+        frame_scratch_buffer_(frame_scratch_buffer),
+        memory_tracker_(memory_tracker) {}
   ~FrameScratchBufferReleaser() {
+    UpdateScratchMemory(frame_scratch_buffer_->get(), memory_tracker_);
     frame_scratch_buffer_pool_->Release(std::move(*frame_scratch_buffer_));
   }
 
  private:
   FrameScratchBufferPool* const frame_scratch_buffer_pool_;
   std::unique_ptr<FrameScratchBuffer>* const frame_scratch_buffer_;
+  MemoryTracker* const memory_tracker_;
 };
 
 // Sets the |frame|'s segmentation map for two cases. The third case is handled
@@ -136,10 +281,14 @@ StatusCode DecodeTilesNonFrameParallel(
   if (tile_scratch_buffer == nullptr) return kLibgav1StatusOutOfMemory;
   for (int row4x4 = 0; row4x4 < frame_header.rows4x4;
        row4x4 += block_width4x4) {
-    for (const auto& tile_ptr : tiles) {
-      if (!tile_ptr->ProcessSuperBlockRow<kProcessingModeParseAndDecode, true>(
-              row4x4, tile_scratch_buffer.get())) {
-        return kLibgav1StatusUnknownError;
+    {
+      ScopedStageTimer timer(kLibgav1DecodeStageTileDecode);
+      for (const auto& tile_ptr : tiles) {
+        if (!tile_ptr
+                 ->ProcessSuperBlockRow<kProcessingModeParseAndDecode, true>(
+                     row4x4, tile_scratch_buffer.get())) {
+          return kLibgav1StatusUnknownError;
+        }
       }
     }
     post_filter->ApplyFilteringForOneSuperBlockRow(
@@ -151,8 +300,37 @@ StatusCode DecodeTilesNonFrameParallel(
   return kStatusOk;
 }
 
+// The decoder does not prefetch more than this many bytes of a tile's data.
+// The hardware prefetcher keeps up once the symbol decoder starts streaming
+// through the data.
+constexpr size_t kMaxTilePrefetchSize = 16384;
+
+// Creates the tile with number |index| using |create_tile| and stores it in
+// |tiles|. The start of the tile data is prefetched first so that the cache
+// misses overlap with the tile's allocations. Returns nullptr on failure, in
+// which case the tile is counted as failed in |pending_tiles|.
+template <typename TileFactory>
+Tile* CreateTile(const TileFactory& create_tile,
+                 const Vector<TileBuffer>& tile_buffers, int index,
+                 Vector<std::unique_ptr<Tile>>* const tiles,
+                 BlockingCounterWithStatus* const pending_tiles) {
+  PrefetchForRead(tile_buffers[index].data,
+                  std::min(tile_buffers[index].size, kMaxTilePrefetchSize));
+  (*tiles)[index] = create_tile(index);
+  if ((*tiles)[index] == nullptr) {
+    LIBGAV1_DLOG(ERROR, "Failed to create tile #%d", index);
+    pending_tiles->Decrement(false);
+  }
+  return (*tiles)[index].get();
+}
+
+// |tiles| holds a nullptr for every tile. The tiles are created by the workers
+// as they claim them, so that decoding of the first tiles starts while the
+// later ones are still being set up.
+template <typename TileFactory>
 StatusCode DecodeTilesThreadedNonFrameParallel(
-    const Vector<std::unique_ptr<Tile>>& tiles,
+    const TileFactory& create_tile, const Vector<TileBuffer>& tile_buffers,
+    Vector<std::unique_ptr<Tile>>* const tiles,
     FrameScratchBuffer* const frame_scratch_buffer,
     PostFilter* const post_filter,
     BlockingCounterWithStatus* const pending_tiles) {
@@ -161,12 +339,15 @@ StatusCode DecodeTilesThreadedNonFrameParallel(
   const int num_workers = threading_strategy.tile_thread_count();
   BlockingCounterWithStatus pending_workers(num_workers);
   std::atomic<int> tile_counter(0);
-  const int tile_count = static_cast<int>(tiles.size());
+  const int tile_count = static_cast<int>(tiles->size());
   bool tile_decoding_failed = false;
+  // The post filter is timed stage by stage inside ApplyFilteringThreaded().
+  ScopedStageTimer tile_decode_timer(kLibgav1DecodeStageTileDecode);
   // Submit tile decoding jobs to the thread pool.
   for (int i = 0; i < num_workers; ++i) {
-    threading_strategy.tile_thread_pool()->Schedule([&tiles, tile_count,
-                                                     &tile_counter,
+    threading_strategy.tile_thread_pool()->Schedule([&create_tile,
+                                                     &tile_buffers, tiles,
+                                                     tile_count, &tile_counter,
                                                      &pending_workers,
                                                      &pending_tiles]() {
       bool failed = false;
@@ -174,9 +355,12 @@ StatusCode DecodeTilesThreadedNonFrameParallel(
       while ((index = tile_counter.fetch_add(1, std::memory_order_relaxed)) <
              tile_count) {
         if (!failed) {
-          const auto& tile_ptr = tiles[index];
-          if (!tile_ptr->ParseAndDecode()) {
-            LIBGAV1_DLOG(ERROR, "Error decoding tile #%d", tile_ptr->number());
+          Tile* const tile = CreateTile(create_tile, tile_buffers, index,
+                                        tiles, pending_tiles);
+          if (tile == nullptr) {
+            failed = true;
+          } else if (!tile->ParseAndDecode()) {
+            LIBGAV1_DLOG(ERROR, "Error decoding tile #%d", tile->number());
             failed = true;
           }
         } else {
@@ -191,9 +375,12 @@ StatusCode DecodeTilesThreadedNonFrameParallel(
   while ((index = tile_counter.fetch_add(1, std::memory_order_relaxed)) <
          tile_count) {
     if (!tile_decoding_failed) {
-      const auto& tile_ptr = tiles[index];
-      if (!tile_ptr->ParseAndDecode()) {
-        LIBGAV1_DLOG(ERROR, "Error decoding tile #%d", tile_ptr->number());
+      Tile* const tile =
+          CreateTile(create_tile, tile_buffers, index, tiles, pending_tiles);
+      if (tile == nullptr) {
+        tile_decoding_failed = true;
+      } else if (!tile->ParseAndDecode()) {
+        LIBGAV1_DLOG(ERROR, "Error decoding tile #%d", tile->number());
         tile_decoding_failed = true;
       }
     } else {
@@ -201,10 +388,12 @@ StatusCode DecodeTilesThreadedNonFrameParallel(
     }
   }
   // Wait until all the workers are done. This ensures that all the tiles have
-  // been parsed.
-  tile_decoding_failed |= !pending_workers.Wait();
+  // been parsed. The current thread runs the queued superblock jobs meanwhile.
+  ThreadPool* const thread_pool = threading_strategy.thread_pool();
+  tile_decoding_failed |= !pending_workers.Wait(thread_pool);
   // Wait until all the tiles have been decoded.
-  tile_decoding_failed |= !pending_tiles->Wait();
+  tile_decoding_failed |= !pending_tiles->Wait(thread_pool);
+  tile_decode_timer.Stop();
   if (tile_decoding_failed) return kStatusUnknownError;
   assert(threading_strategy.post_filter_thread_pool() != nullptr);
   post_filter->ApplyFilteringThreaded();
@@ -460,7 +649,7 @@ StatusCode DecodeTilesThreadedFrameParallel(
 
   // Wait until all the parse workers are done. This ensures that all the tiles
   // have been parsed.
-  if (!parse_workers.Wait() || failed) {
+  if (!parse_workers.Wait(&thread_pool) || failed) {
     return kLibgav1StatusUnknownError;
   }
   if (frame_header.enable_frame_end_update_cdf) {
@@ -567,7 +756,7 @@ StatusCode DecodeTilesThreadedFrameParallel(
   }
   // Wait until all the pending jobs are done. This ensures that all the tiles
   // have been decoded and wrapped up.
-  pending_jobs.Wait();
+  pending_jobs.Wait(&thread_pool);
   {
     std::lock_guard<std::mutex> lock(
         frame_scratch_buffer->superblock_row_mutex);
@@ -589,6 +778,11 @@ StatusCode DecoderImpl::Create(const DecoderSettings* settings,
     LIBGAV1_DLOG(ERROR, "Invalid settings->threads: %d.", settings->threads);
     return kStatusInvalidArgument;
   }
+  if (settings->thread_pool != nullptr &&
+      settings->thread_pool->impl_ == nullptr) {
+    LIBGAV1_DLOG(ERROR, "settings->thread_pool is not initialized.");
+    return kStatusInvalidArgument;
+  }
   if (settings->frame_parallel) {
     if (settings->release_input_buffer == nullptr) {
       LIBGAV1_DLOG(ERROR,
@@ -597,6 +791,11 @@ StatusCode DecoderImpl::Create(const DecoderSettings* settings,
       return kStatusInvalidArgument;
     }
   }
+  if (settings->preview_shift < 0 || settings->preview_shift > 3) {
+    LIBGAV1_DLOG(ERROR, "Invalid settings->preview_shift: %d.",
+                 settings->preview_shift);
+    return kStatusInvalidArgument;
+  }
   std::unique_ptr<DecoderImpl> impl(new (std::nothrow) DecoderImpl(settings));
   if (impl == nullptr) {
     LIBGAV1_DLOG(ERROR, "Failed to allocate DecoderImpl.");
@@ -609,10 +808,19 @@ StatusCode DecoderImpl::Create(const DecoderSettings* settings,
 }
 
 DecoderImpl::DecoderImpl(const DecoderSettings* settings)
-    : buffer_pool_(settings->on_frame_buffer_size_changed,
+    : memory_tracker_(settings->memory_limit),
+      buffer_pool_(settings->on_frame_buffer_size_changed,
                    settings->get_frame_buffer, settings->release_frame_buffer,
                    settings->callback_private_data),
-      settings_(*settings) {
+      settings_(*settings),
+      shared_thread_pool_((settings->thread_pool != nullptr)
+                              ? settings->thread_pool->impl_.get()
+                              : nullptr),
+      // Previews keep only SuperRes, which the output size depends on.
+      post_filter_mask_((settings->preview_shift != 0)
+                            ? settings->post_filter_mask & 0x04
+                            : settings->post_filter_mask) {
+  buffer_pool_.set_memory_tracker(&memory_tracker_);
   dsp::DspInit();
 }
 
@@ -634,13 +842,24 @@ StatusCode DecoderImpl::Init() {
     LIBGAV1_DLOG(ERROR, "output_frame_queue_.Init() failed.");
     return kStatusOutOfMemory;
   }
+  // The threads of a shared pool belong to the application. Pinning only pays
+  // off if some CPUs are faster than others.
+  if (settings_.prefer_fast_cores && shared_thread_pool_ == nullptr) {
+    CpuTopology topology;
+    if (topology.Read("/sys/devices/system/cpu") &&
+        topology.num_clusters() > 1) {
+      cpu_placement_.reset(new (std::nothrow) CpuPlacement(topology));
+    }
+  }
   return kStatusOk;
 }
 
 StatusCode DecoderImpl::InitializeFrameThreadPoolAndTemporalUnitQueue(
     const uint8_t* data, size_t size) {
   is_frame_parallel_ = false;
-  if (settings_.frame_parallel) {
+  // The frame threads block while they wait for their reference frames, so
+  // they cannot be run on a pool that other decoders depend on.
+  if (settings_.frame_parallel && shared_thread_pool_ == nullptr) {
     DecoderState state;
     std::unique_ptr<ObuParser> obu(new (std::nothrow) ObuParser(
         data, size, settings_.operating_point, &buffer_pool_, &state));
@@ -654,14 +873,34 @@ StatusCode DecoderImpl::InitializeFrameThreadPoolAndTemporalUnitQueue(
       LIBGAV1_DLOG(ERROR, "Failed to parse OBU.");
       return status;
     }
+    // Frame parallel mode keeps a frame buffer per frame thread in flight on
+    // top of the reference frames, a film grain copy of each and a frame
+    // scratch buffer per frame thread. Do not use it if that would not fit in
+    // the memory limit. |current_frame| has not been allocated yet, so the
+    // sizes are computed from the headers.
+    bool frame_parallel_fits = true;
+    if (memory_tracker_.limit() != 0 && settings_.threads > 1) {
+      const uint64_t threads = static_cast<uint64_t>(settings_.threads);
+      const uint64_t frame_bytes =
+          GetFrameBufferBytes(obu->sequence_header(), obu->frame_header(),
+                              current_frame->buffer()->alignment());
+      const uint64_t scratch_bytes =
+          GetFrameScratchBytes(obu->sequence_header(), obu->frame_header());
+      frame_parallel_fits =
+          (kNumReferenceFrameTypes + 2 * threads) * frame_bytes +
+              threads * scratch_bytes <=
+          memory_tracker_.limit();
+      if (!frame_parallel_fits) memory_tracker_.CountReduction();
+    }
     current_frame = nullptr;
     // We assume that the first frame that was parsed will contain the frame
     // header. This assumption is usually true in practice. So we will simply
     // not use frame parallel mode if this is not the case.
-    if (settings_.threads > 1 &&
+    if (settings_.threads > 1 && frame_parallel_fits &&
         !InitializeThreadPoolsForFrameParallel(
             settings_.threads, obu->frame_header().tile_info.tile_count,
-            obu->frame_header().tile_info.tile_columns, &frame_thread_pool_,
+            obu->frame_header().tile_info.tile_columns, cpu_placement_.get(),
+            &frame_thread_pool_,
             &frame_scratch_buffer_pool_)) {
       return kStatusOutOfMemory;
     }
@@ -674,6 +913,20 @@ StatusCode DecoderImpl::InitializeFrameThreadPoolAndTemporalUnitQueue(
     return kStatusOutOfMemory;
   }
   is_frame_parallel_ = frame_thread_pool_ != nullptr;
+  if (!is_frame_parallel_ && settings_.frame_ready != nullptr) {
+    // A decoder that keeps several threads busy waits for its own jobs, which
+    // may be queued behind temporal units running on all the workers of the
+    // shared pool. So only single threaded decoders run on the shared pool.
+    async_thread_pool_ =
+        (shared_thread_pool_ != nullptr && settings_.threads == 1)
+            ? ThreadPool::Create(shared_thread_pool_, 1)
+            : ThreadPool::Create("libgav1-async", 1, cpu_placement_.get());
+    if (async_thread_pool_ == nullptr) {
+      LIBGAV1_DLOG(ERROR, "Failed to create the asynchronous decode thread.");
+      return kStatusOutOfMemory;
+    }
+    is_async_ = true;
+  }
   return kStatusOk;
 }
 
@@ -699,6 +952,12 @@ StatusCode DecoderImpl::EnqueueFrame(const uint8_t* data, size_t size,
   TemporalUnit temporal_unit(data, size, user_private_data,
                              buffer_private_data);
   temporal_units_.Push(std::move(temporal_unit));
+  if (is_async_) {
+    TemporalUnit* const async_temporal_unit = &temporal_units_.Back();
+    async_thread_pool_->Schedule([this, async_temporal_unit]() {
+      DecodeTemporalUnitAsync(async_temporal_unit);
+    });
+  }
   return kStatusOk;
 }
 
@@ -714,6 +973,7 @@ StatusCode DecoderImpl::SignalFailure(StatusCode status) {
   // Make sure all waiting threads exit.
   buffer_pool_.Abort();
   frame_thread_pool_ = nullptr;
+  async_thread_pool_ = nullptr;
   while (!temporal_units_.Empty()) {
     if (settings_.release_input_buffer != nullptr) {
       settings_.release_input_buffer(
@@ -742,7 +1002,7 @@ StatusCode DecoderImpl::DequeueFrame(const DecoderBuffer** out_ptr) {
     return kStatusNothingToDequeue;
   }
   TemporalUnit& temporal_unit = temporal_units_.Front();
-  if (!is_frame_parallel_) {
+  if (!is_frame_parallel_ && !is_async_) {
     // If |output_frame_queue_| is not empty, then return the first frame from
     // that queue.
     if (!output_frame_queue_.Empty()) {
@@ -799,8 +1059,11 @@ StatusCode DecoderImpl::DequeueFrame(const DecoderBuffer** out_ptr) {
                                    temporal_unit.buffer_private_data);
   }
   if (temporal_unit.status != kStatusOk) {
+    const StatusCode status = temporal_unit.status;
     temporal_units_.Pop();
-    return SignalFailure(temporal_unit.status);
+    // As in the synchronous mode, a temporal unit that fails to decode does
+    // not stop the decoding of the next ones in asynchronous mode.
+    return is_async_ ? status : SignalFailure(status);
   }
   if (!temporal_unit.has_displayable_frame) {
     *out_ptr = nullptr;
@@ -870,7 +1133,8 @@ StatusCode DecoderImpl::ParseAndSchedule(const uint8_t* data, size_t size,
       if (!buffer_pool_.OnFrameBufferSizeChanged(
               sequence_header.color_config.bitdepth, image_format,
               sequence_header.max_frame_width, sequence_header.max_frame_height,
-              kBorderPixels, kBorderPixels, kBorderPixels, max_bottom_border)) {
+              GetLeftTopBorderPixels(sequence_header), kBorderPixels,
+              GetLeftTopBorderPixels(sequence_header), max_bottom_border)) {
         LIBGAV1_DLOG(ERROR, "buffer_pool_.OnFrameBufferSizeChanged failed.");
         return kStatusUnknownError;
       }
@@ -888,16 +1152,21 @@ StatusCode DecoderImpl::ParseAndSchedule(const uint8_t* data, size_t size,
       LIBGAV1_DLOG(ERROR, "temporal_unit.frames.emplace_back failed.");
       return kStatusOutOfMemory;
     }
-    state_.UpdateReferenceFrames(current_frame,
-                                 obu->frame_header().refresh_frame_flags);
+    if (IsReferenceFrame(obu->sequence_header(), obu->frame_header())) {
+      state_.UpdateReferenceFrames(current_frame,
+                                   obu->frame_header().refresh_frame_flags);
+    }
   }
   // This function cannot fail after this point. So it is okay to move the
   // |temporal_unit| into |temporal_units_| queue.
   temporal_units_.Push(std::move(temporal_unit));
   if (temporal_units_.Back().frames.empty()) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    temporal_units_.Back().has_displayable_frame = false;
-    temporal_units_.Back().decoded = true;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      temporal_units_.Back().has_displayable_frame = false;
+      temporal_units_.Back().decoded = true;
+    }
+    SignalFrameReady(user_private_data);
     return kStatusOk;
   }
   for (auto& frame : temporal_units_.Back().frames) {
@@ -909,7 +1178,7 @@ StatusCode DecoderImpl::ParseAndSchedule(const uint8_t* data, size_t size,
       encoded_frame->state = {};
       encoded_frame->frame = nullptr;
       TemporalUnit& temporal_unit = *encoded_frame->temporal_unit;
-      std::lock_guard<std::mutex> lock(mutex_);
+      std::unique_lock<std::mutex> lock(mutex_);
       if (failure_status_ != kStatusOk) return;
       // temporal_unit's status defaults to kStatusOk. So we need to set it only
       // on error. If |failure_status_| is not kStatusOk at this point, it means
@@ -932,6 +1201,9 @@ StatusCode DecoderImpl::ParseAndSchedule(const uint8_t* data, size_t size,
       }
       if (temporal_unit.decoded || failure_status_ != kStatusOk) {
         decoded_condvar_.notify_one();
+        const int64_t user_private_data = temporal_unit.user_private_data;
+        lock.unlock();
+        SignalFrameReady(user_private_data);
       }
     });
   }
@@ -952,7 +1224,7 @@ StatusCode DecoderImpl::DecodeFrame(EncodedFrame* const encoded_frame) {
   // |frame_scratch_buffer| will be released when this local variable goes out
   // of scope (i.e.) on any return path in this function.
   FrameScratchBufferReleaser frame_scratch_buffer_releaser(
-      &frame_scratch_buffer_pool_, &frame_scratch_buffer);
+      &frame_scratch_buffer_pool_, &frame_scratch_buffer, &memory_tracker_);
 
   StatusCode status;
   if (!frame_header.show_existing_frame) {
@@ -985,6 +1257,11 @@ StatusCode DecoderImpl::DecodeFrame(EncodedFrame* const encoded_frame) {
   if (status != kStatusOk) {
     return status;
   }
+  RefCountedBufferPtr output_frame;
+  status = ApplyPreviewShift(film_grain_frame, &output_frame);
+  if (status != kStatusOk) {
+    return status;
+  }
 
   TemporalUnit& temporal_unit = *encoded_frame->temporal_unit;
   std::lock_guard<std::mutex> lock(mutex_);
@@ -1005,7 +1282,7 @@ StatusCode DecoderImpl::DecodeFrame(EncodedFrame* const encoded_frame) {
   }
   temporal_unit.has_displayable_frame = true;
   temporal_unit.output_layers[temporal_unit.output_layer_count].frame =
-      std::move(film_grain_frame);
+      std::move(output_frame);
   temporal_unit.output_layers[temporal_unit.output_layer_count]
       .position_in_temporal_unit = encoded_frame->position_in_temporal_unit;
   ++temporal_unit.output_layer_count;
@@ -1016,6 +1293,28 @@ StatusCode DecoderImpl::DecodeFrame(EncodedFrame* const encoded_frame) {
 
 StatusCode DecoderImpl::DecodeTemporalUnit(const TemporalUnit& temporal_unit,
                                            const DecoderBuffer** out_ptr) {
+  StatusCode status = DecodeFramesInTemporalUnit(temporal_unit);
+  if (status != kStatusOk) return status;
+  if (output_frame_queue_.Empty()) {
+    // No displayable frame in the temporal unit. Not an error.
+    *out_ptr = nullptr;
+    return kStatusOk;
+  }
+  {
+    ScopedStageTimer timer(kLibgav1DecodeStageOutput);
+    status = CopyFrameToOutputBuffer(output_frame_queue_.Front());
+  }
+  output_frame_queue_.Pop();
+  if (status != kStatusOk) {
+    return status;
+  }
+  buffer_.user_private_data = temporal_unit.user_private_data;
+  *out_ptr = &buffer_;
+  return kStatusOk;
+}
+
+StatusCode DecoderImpl::DecodeFramesInTemporalUnit(
+    const TemporalUnit& temporal_unit) {
   std::unique_ptr<ObuParser> obu(new (std::nothrow) ObuParser(
       temporal_unit.data, temporal_unit.size, settings_.operating_point,
       &buffer_pool_, &state_));
@@ -1036,11 +1335,14 @@ StatusCode DecoderImpl::DecodeTemporalUnit(const TemporalUnit& temporal_unit,
   // |frame_scratch_buffer| will be released when this local variable goes out
   // of scope (i.e.) on any return path in this function.
   FrameScratchBufferReleaser frame_scratch_buffer_releaser(
-      &frame_scratch_buffer_pool_, &frame_scratch_buffer);
+      &frame_scratch_buffer_pool_, &frame_scratch_buffer, &memory_tracker_);
 
   while (obu->HasData()) {
     RefCountedBufferPtr current_frame;
-    status = obu->ParseOneFrame(&current_frame);
+    {
+      ScopedStageTimer timer(kLibgav1DecodeStageParse);
+      status = obu->ParseOneFrame(&current_frame);
+    }
     if (status != kStatusOk) {
       LIBGAV1_DLOG(ERROR, "Failed to parse OBU.");
       return status;
@@ -1065,7 +1367,8 @@ StatusCode DecoderImpl::DecodeTemporalUnit(const TemporalUnit& temporal_unit,
       if (!buffer_pool_.OnFrameBufferSizeChanged(
               sequence_header.color_config.bitdepth, image_format,
               sequence_header.max_frame_width, sequence_header.max_frame_height,
-              kBorderPixels, kBorderPixels, kBorderPixels, max_bottom_border)) {
+              GetLeftTopBorderPixels(sequence_header), kBorderPixels,
+              GetLeftTopBorderPixels(sequence_header), max_bottom_border)) {
         LIBGAV1_DLOG(ERROR, "buffer_pool_.OnFrameBufferSizeChanged failed.");
         return kStatusUnknownError;
       }
@@ -1085,8 +1388,10 @@ StatusCode DecoderImpl::DecodeTemporalUnit(const TemporalUnit& temporal_unit,
         return status;
       }
     }
-    state_.UpdateReferenceFrames(current_frame,
-                                 obu->frame_header().refresh_frame_flags);
+    if (IsReferenceFrame(obu->sequence_header(), obu->frame_header())) {
+      state_.UpdateReferenceFrames(current_frame,
+                                   obu->frame_header().refresh_frame_flags);
+    }
     if (obu->frame_header().show_frame ||
         obu->frame_header().show_existing_frame) {
       if (!output_frame_queue_.Empty() && !settings_.output_all_layers) {
@@ -1098,27 +1403,59 @@ StatusCode DecoderImpl::DecodeTemporalUnit(const TemporalUnit& temporal_unit,
         output_frame_queue_.Pop();
       }
       RefCountedBufferPtr film_grain_frame;
-      status = ApplyFilmGrain(
-          obu->sequence_header(), obu->frame_header(), current_frame,
-          &film_grain_frame,
-          frame_scratch_buffer->threading_strategy.film_grain_thread_pool());
+      {
+        ScopedStageTimer timer(kLibgav1DecodeStageFilmGrain);
+        status = ApplyFilmGrain(
+            obu->sequence_header(), obu->frame_header(), current_frame,
+            &film_grain_frame,
+            frame_scratch_buffer->threading_strategy.film_grain_thread_pool());
+      }
       if (status != kStatusOk) return status;
-      output_frame_queue_.Push(std::move(film_grain_frame));
+      RefCountedBufferPtr output_frame;
+      {
+        ScopedStageTimer timer(kLibgav1DecodeStageOutput);
+        status = ApplyPreviewShift(film_grain_frame, &output_frame);
+      }
+      if (status != kStatusOk) return status;
+      output_frame_queue_.Push(std::move(output_frame));
     }
   }
-  if (output_frame_queue_.Empty()) {
-    // No displayable frame in the temporal unit. Not an error.
-    *out_ptr = nullptr;
-    return kStatusOk;
+  return kStatusOk;
+}
+
+void DecoderImpl::DecodeTemporalUnitAsync(TemporalUnit* const temporal_unit) {
+  if (HasFailure()) return;
+  const StatusCode status = DecodeFramesInTemporalUnit(*temporal_unit);
+  // |output_layers| is consumed from the back, in the order the frames were
+  // output.
+  int output_layer_count = 0;
+  if (status == kStatusOk) {
+    output_layer_count = static_cast<int>(output_frame_queue_.Size());
+    for (int i = output_layer_count - 1; i >= 0; --i) {
+      temporal_unit->output_layers[i].frame =
+          std::move(output_frame_queue_.Front());
+      output_frame_queue_.Pop();
+    }
+  } else {
+    output_frame_queue_.Clear();
   }
-  status = CopyFrameToOutputBuffer(output_frame_queue_.Front());
-  output_frame_queue_.Pop();
-  if (status != kStatusOk) {
-    return status;
+  // |temporal_unit| may be dequeued as soon as it is marked decoded.
+  const int64_t user_private_data = temporal_unit->user_private_data;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    temporal_unit->status = status;
+    temporal_unit->has_displayable_frame = output_layer_count > 0;
+    temporal_unit->output_layer_count = output_layer_count;
+    temporal_unit->decoded = true;
+  }
+  decoded_condvar_.notify_one();
+  SignalFrameReady(user_private_data);
+}
+
+void DecoderImpl::SignalFrameReady(int64_t user_private_data) {
+  if (settings_.frame_ready != nullptr) {
+    settings_.frame_ready(settings_.callback_private_data, user_private_data);
   }
-  buffer_.user_private_data = temporal_unit.user_private_data;
-  *out_ptr = &buffer_;
-  return kStatusOk;
 }
 
 StatusCode DecoderImpl::CopyFrameToOutputBuffer(
@@ -1200,22 +1537,36 @@ StatusCode DecoderImpl::DecodeTiles(
   }
   ThreadingStrategy& threading_strategy =
       frame_scratch_buffer->threading_strategy;
+  int thread_count = settings_.threads;
+  if (memory_tracker_.limit() != 0 && thread_count > 2) {
+    // Every thread ends up holding a tile scratch buffer. Keep at least two
+    // threads so that the threaded decode path still applies.
+    const size_t thread_bytes = TileScratchBuffer::AllocatedBytes(
+        sequence_header.color_config.bitdepth);
+    const size_t max_threads =
+        1 + memory_tracker_.available_bytes() / thread_bytes;
+    if (max_threads < static_cast<size_t>(thread_count)) {
+      thread_count = std::max(2, static_cast<int>(max_threads));
+      memory_tracker_.CountReduction();
+    }
+  }
   if (!is_frame_parallel_ &&
-      !threading_strategy.Reset(frame_header, settings_.threads)) {
+      !threading_strategy.Reset(frame_header, thread_count, shared_thread_pool_,
+                                cpu_placement_.get())) {
     return kStatusOutOfMemory;
   }
-  const bool do_cdef =
-      PostFilter::DoCdef(frame_header, settings_.post_filter_mask);
+  const bool do_cdef = PostFilter::DoCdef(frame_header, post_filter_mask_);
   const int num_planes = sequence_header.color_config.is_monochrome
                              ? kMaxPlanesMonochrome
                              : kMaxPlanes;
   const bool do_restoration = PostFilter::DoRestoration(
-      frame_header.loop_restoration, settings_.post_filter_mask, num_planes);
+      frame_header.loop_restoration, post_filter_mask_, num_planes);
   const bool do_superres =
-      PostFilter::DoSuperRes(frame_header, settings_.post_filter_mask);
-  // Use kBorderPixels for the left, right, and top borders. Only the bottom
-  // border may need to be bigger. Cdef border is needed only if we apply Cdef
-  // without multithreading.
+      PostFilter::DoSuperRes(frame_header, post_filter_mask_);
+  // Use kBorderPixels for the left, right, and top borders (smaller left and
+  // top borders for still pictures). Only the bottom border may need to be
+  // bigger. Cdef border is needed only if we apply Cdef without
+  // multithreading.
   const int bottom_border = GetBottomBorderPixels(
       do_cdef && threading_strategy.post_filter_thread_pool() == nullptr,
       do_restoration, do_superres, sequence_header.color_config.subsampling_y);
@@ -1226,9 +1577,10 @@ StatusCode DecoderImpl::DecodeTiles(
                               frame_header.upscaled_width, frame_header.height,
                               sequence_header.color_config.subsampling_x,
                               sequence_header.color_config.subsampling_y,
-                              /*left_border=*/kBorderPixels,
+                              GetLeftTopBorderPixels(sequence_header),
                               /*right_border=*/kBorderPixels,
-                              /*top_border=*/kBorderPixels, bottom_border)) {
+                              GetLeftTopBorderPixels(sequence_header),
+                              bottom_border)) {
     LIBGAV1_DLOG(ERROR, "Failed to allocate memory for the decoder buffer.");
     return kStatusOutOfMemory;
   }
@@ -1497,20 +1849,36 @@ StatusCode DecoderImpl::DecodeTiles(
       }
     }
   }
+  UpdateScratchMemory(frame_scratch_buffer, &memory_tracker_);
+  if (memory_tracker_.limit() != 0 &&
+      memory_tracker_.total_bytes() > memory_tracker_.limit()) {
+    LIBGAV1_DLOG(ERROR, "Frame scratch buffers exceed the memory limit.");
+    return kStatusOutOfMemory;
+  }
 
   PostFilter post_filter(frame_header, sequence_header, frame_scratch_buffer,
-                         current_frame->buffer(), dsp,
-                         settings_.post_filter_mask);
+                         current_frame->buffer(), dsp, post_filter_mask_);
   SymbolDecoderContext saved_symbol_decoder_context;
   BlockingCounterWithStatus pending_tiles(tile_count);
-  for (int tile_number = 0; tile_number < tile_count; ++tile_number) {
-    std::unique_ptr<Tile> tile = Tile::Create(
+  const auto create_tile = [&](int tile_number) {
+    return Tile::Create(
         tile_number, tile_buffers[tile_number].data,
         tile_buffers[tile_number].size, sequence_header, frame_header,
         current_frame, state, frame_scratch_buffer, wedge_masks_,
         quantizer_matrix_, &saved_symbol_decoder_context, prev_segment_ids,
         &post_filter, dsp, threading_strategy.row_thread_pool(tile_number),
         &pending_tiles, is_frame_parallel_, use_intra_prediction_buffer);
+  };
+  // In the threaded non frame parallel case the tile workers create the tiles
+  // themselves. Otherwise all the tiles are created upfront.
+  const bool create_tiles_in_workers =
+      !is_frame_parallel_ && settings_.threads > 1;
+  for (int tile_number = 0; tile_number < tile_count; ++tile_number) {
+    if (create_tiles_in_workers) {
+      tiles.push_back_unchecked(nullptr);
+      continue;
+    }
+    std::unique_ptr<Tile> tile = create_tile(tile_number);
     if (tile == nullptr) {
       LIBGAV1_DLOG(ERROR, "Failed to create tile.");
       return kStatusOutOfMemory;
@@ -1533,8 +1901,9 @@ StatusCode DecoderImpl::DecodeTiles(
     status = DecodeTilesNonFrameParallel(sequence_header, frame_header, tiles,
                                          frame_scratch_buffer, &post_filter);
   } else {
-    status = DecodeTilesThreadedNonFrameParallel(tiles, frame_scratch_buffer,
-                                                 &post_filter, &pending_tiles);
+    status = DecodeTilesThreadedNonFrameParallel(
+        create_tile, tile_buffers, &tiles, frame_scratch_buffer, &post_filter,
+        &pending_tiles);
   }
   if (status != kStatusOk) return status;
   if (frame_header.enable_frame_end_update_cdf) {
@@ -1552,14 +1921,14 @@ StatusCode DecoderImpl::ApplyFilmGrain(
     RefCountedBufferPtr* film_grain_frame, ThreadPool* thread_pool) {
   if (!sequence_header.film_grain_params_present ||
       !displayable_frame->film_grain_params().apply_grain ||
-      (settings_.post_filter_mask & 0x10) == 0) {
+      (post_filter_mask_ & 0x10) == 0) {
     *film_grain_frame = displayable_frame;
     return kStatusOk;
   }
   if (!frame_header.show_existing_frame &&
-      frame_header.refresh_frame_flags == 0) {
+      !IsReferenceFrame(sequence_header, frame_header)) {
     // If show_existing_frame is true, then the current frame is a previously
-    // saved reference frame. If refresh_frame_flags is nonzero, then the
+    // saved reference frame. If IsReferenceFrame() is true, then the
     // state_.UpdateReferenceFrames() call above has saved the current frame as
     // a reference frame. Therefore, if both of these conditions are false, then
     // the current frame is not saved as a reference frame. displayable_frame
@@ -1586,6 +1955,7 @@ StatusCode DecoderImpl::ApplyFilmGrain(
       LIBGAV1_DLOG(ERROR, "film_grain_frame->Realloc() failed.");
       return kStatusOutOfMemory;
     }
+    (*film_grain_frame)->SetFilmGrainFrame();
     (*film_grain_frame)
         ->set_chroma_sample_position(
             displayable_frame->chroma_sample_position());
@@ -1601,6 +1971,31 @@ StatusCode DecoderImpl::ApplyFilmGrain(
   assert((*film_grain_frame)->buffer()->stride(kPlaneU) ==
          (*film_grain_frame)->buffer()->stride(kPlaneV));
   const int output_stride_uv = (*film_grain_frame)->buffer()->stride(kPlaneU);
+#if LIBGAV1_MAX_BITDEPTH == 12
+  if (displayable_frame->buffer()->bitdepth() == 12) {
+    FilmGrain<12> film_grain(displayable_frame->film_grain_params(),
+                             displayable_frame->buffer()->is_monochrome(),
+                             color_matrix_is_identity,
+                             displayable_frame->buffer()->subsampling_x(),
+                             displayable_frame->buffer()->subsampling_y(),
+                             displayable_frame->upscaled_width(),
+                             displayable_frame->frame_height(), thread_pool,
+                             &film_grain_scaling_lut_cache_12bpp_);
+    if (!film_grain.AddNoise(
+            displayable_frame->buffer()->data(kPlaneY),
+            displayable_frame->buffer()->stride(kPlaneY),
+            displayable_frame->buffer()->data(kPlaneU),
+            displayable_frame->buffer()->data(kPlaneV), input_stride_uv,
+            (*film_grain_frame)->buffer()->data(kPlaneY),
+            (*film_grain_frame)->buffer()->stride(kPlaneY),
+            (*film_grain_frame)->buffer()->data(kPlaneU),
+            (*film_grain_frame)->buffer()->data(kPlaneV), output_stride_uv)) {
+      LIBGAV1_DLOG(ERROR, "film_grain.AddNoise() failed.");
+      return kStatusOutOfMemory;
+    }
+    return kStatusOk;
+  }
+#endif  // LIBGAV1_MAX_BITDEPTH == 12
 #if LIBGAV1_MAX_BITDEPTH >= 10
   if (displayable_frame->buffer()->bitdepth() > 8) {
     FilmGrain<10> film_grain(displayable_frame->film_grain_params(),
@@ -1609,7 +2004,8 @@ StatusCode DecoderImpl::ApplyFilmGrain(
                              displayable_frame->buffer()->subsampling_x(),
                              displayable_frame->buffer()->subsampling_y(),
                              displayable_frame->upscaled_width(),
-                             displayable_frame->frame_height(), thread_pool);
+                             displayable_frame->frame_height(), thread_pool,
+                             &film_grain_scaling_lut_cache_10bpp_);
     if (!film_grain.AddNoise(
             displayable_frame->buffer()->data(kPlaneY),
             displayable_frame->buffer()->stride(kPlaneY),
@@ -1631,7 +2027,8 @@ StatusCode DecoderImpl::ApplyFilmGrain(
                           displayable_frame->buffer()->subsampling_x(),
                           displayable_frame->buffer()->subsampling_y(),
                           displayable_frame->upscaled_width(),
-                          displayable_frame->frame_height(), thread_pool);
+                          displayable_frame->frame_height(), thread_pool,
+                          &film_grain_scaling_lut_cache_8bpp_);
   if (!film_grain.AddNoise(
           displayable_frame->buffer()->data(kPlaneY),
           displayable_frame->buffer()->stride(kPlaneY),
@@ -1647,6 +2044,56 @@ StatusCode DecoderImpl::ApplyFilmGrain(
   return kStatusOk;
 }
 
+StatusCode DecoderImpl::ApplyPreviewShift(
+    const RefCountedBufferPtr& displayable_frame,
+    RefCountedBufferPtr* preview_frame) {
+  const int shift = settings_.preview_shift;
+  if (shift == 0) {
+    *preview_frame = displayable_frame;
+    return kStatusOk;
+  }
+  const YuvBuffer& source = *displayable_frame->buffer();
+  *preview_frame = buffer_pool_.GetFreeBuffer();
+  if (*preview_frame == nullptr) {
+    LIBGAV1_DLOG(ERROR, "Could not get preview_frame from the buffer pool.");
+    return kStatusResourceExhausted;
+  }
+  // The preview is only read by the application, so it needs no borders.
+  if (!(*preview_frame)
+           ->Realloc(source.bitdepth(), source.is_monochrome(),
+                     RightShiftWithCeiling(displayable_frame->upscaled_width(),
+                                           shift),
+                     RightShiftWithCeiling(displayable_frame->frame_height(),
+                                           shift),
+                     source.subsampling_x(), source.subsampling_y(),
+                     /*left_border=*/0, /*right_border=*/0,
+                     /*top_border=*/0, /*bottom_border=*/0)) {
+    LIBGAV1_DLOG(ERROR, "preview_frame->Realloc() failed.");
+    return kStatusOutOfMemory;
+  }
+  (*preview_frame)
+      ->set_chroma_sample_position(displayable_frame->chroma_sample_position());
+  (*preview_frame)->set_spatial_id(displayable_frame->spatial_id());
+  (*preview_frame)->set_temporal_id(displayable_frame->temporal_id());
+  YuvBuffer* const dest = (*preview_frame)->buffer();
+  const int num_planes =
+      source.is_monochrome() ? kMaxPlanesMonochrome : kMaxPlanes;
+  for (int plane = kPlaneY; plane < num_planes; ++plane) {
+#if LIBGAV1_MAX_BITDEPTH >= 10
+    if (source.bitdepth() > 8) {
+      DownscalePlane<uint16_t>(source.data(plane), source.stride(plane),
+                               source.width(plane), source.height(plane),
+                               shift, dest->data(plane), dest->stride(plane));
+      continue;
+    }
+#endif
+    DownscalePlane<uint8_t>(source.data(plane), source.stride(plane),
+                            source.width(plane), source.height(plane), shift,
+                            dest->data(plane), dest->stride(plane));
+  }
+  return kStatusOk;
+}
+
 bool DecoderImpl::IsNewSequenceHeader(const ObuParser& obu) {
   if (std::find_if(obu.obu_headers().begin(), obu.obu_headers().end(),
                    [](const ObuHeader& obu_header) {
@@ -27,9 +27,12 @@
 #include "src/buffer_pool.h"
 #include "src/decoder_state.h"
 #include "src/dsp/constants.h"
+#include "src/film_grain.h"
 #include "src/frame_scratch_buffer.h"
 #include "src/gav1/decoder_buffer.h"
 #include "src/gav1/decoder_settings.h"
+#include "src/gav1/decoder_thread_pool.h"
+#include "src/gav1/memory_usage.h"
 #include "src/gav1/status_code.h"
 #include "src/obu_parser.h"
 #include "src/quantizer.h"
@@ -40,7 +43,9 @@
 #include "src/utils/block_parameters_holder.h"
 #include "src/utils/compiler_attributes.h"
 #include "src/utils/constants.h"
+#include "src/utils/cpu_topology.h"
 #include "src/utils/memory.h"
+#include "src/utils/memory_tracker.h"
 #include "src/utils/queue.h"
 #include "src/utils/segmentation_map.h"
 #include "src/utils/types.h"
@@ -95,7 +100,8 @@ struct TemporalUnit : public Allocable {
   int64_t user_private_data;
   void* buffer_private_data;
 
-  // The following members are used only in frame parallel mode.
+  // The following members are used only in frame parallel mode and in
+  // asynchronous mode (when |settings_.frame_ready| is set).
   bool decoded;
   StatusCode status;
   bool has_displayable_frame;
@@ -140,9 +146,18 @@ class DecoderImpl : public Allocable {
   StatusCode EnqueueFrame(const uint8_t* data, size_t size,
                           int64_t user_private_data, void* buffer_private_data);
   StatusCode DequeueFrame(const DecoderBuffer** out_ptr);
+  void GetMemoryUsage(MemoryUsage* usage) const {
+    memory_tracker_.GetUsage(usage);
+  }
+  // The film grain scaling lookup table cache of 8-bit frames. Exposed for
+  // tests.
+  const FilmGrainScalingLutCache<8>& film_grain_scaling_lut_cache_8bpp() const {
+    return film_grain_scaling_lut_cache_8bpp_;
+  }
   static constexpr int GetMaxBitdepth() {
-    static_assert(LIBGAV1_MAX_BITDEPTH == 8 || LIBGAV1_MAX_BITDEPTH == 10,
-                  "LIBGAV1_MAX_BITDEPTH must be 8 or 10.");
+    static_assert(LIBGAV1_MAX_BITDEPTH == 8 || LIBGAV1_MAX_BITDEPTH == 10 ||
+                      LIBGAV1_MAX_BITDEPTH == 12,
+                  "LIBGAV1_MAX_BITDEPTH must be 8, 10 or 12.");
     return LIBGAV1_MAX_BITDEPTH;
   }
 
@@ -177,6 +192,18 @@ class DecoderImpl : public Allocable {
   // non frame parallel mode.
   StatusCode DecodeTemporalUnit(const TemporalUnit& temporal_unit,
                                 const DecoderBuffer** out_ptr);
+  // Decodes all the frames contained in |temporal_unit| and pushes the
+  // displayable ones into |output_frame_queue_|. Used only in non frame
+  // parallel mode.
+  StatusCode DecodeFramesInTemporalUnit(const TemporalUnit& temporal_unit);
+  // Used only in asynchronous mode. Decodes |temporal_unit| on
+  // |async_thread_pool_|, moves its output frames into
+  // |temporal_unit->output_layers| as the frame threads do, marks it decoded
+  // and calls |settings_.frame_ready|.
+  void DecodeTemporalUnitAsync(TemporalUnit* temporal_unit);
+  // Calls |settings_.frame_ready|, if set, for the temporal unit that was
+  // enqueued with |user_private_data|. Must not be called with |mutex_| held.
+  void SignalFrameReady(int64_t user_private_data);
   // Used only in frame parallel mode. Does the OBU parsing for |data| and
   // schedules the individual frames for decoding in the |frame_thread_pool_|.
   StatusCode ParseAndSchedule(const uint8_t* data, size_t size,
@@ -203,6 +230,11 @@ class DecoderImpl : public Allocable {
                             const RefCountedBufferPtr& displayable_frame,
                             RefCountedBufferPtr* film_grain_frame,
                             ThreadPool* thread_pool);
+  // Downscales |displayable_frame| by |settings_.preview_shift| into
+  // |preview_frame|, which is |displayable_frame| itself when the shift is 0.
+  // Returns kStatusOk on success.
+  StatusCode ApplyPreviewShift(const RefCountedBufferPtr& displayable_frame,
+                               RefCountedBufferPtr* preview_frame);
 
   bool IsNewSequenceHeader(const ObuParser& obu);
 
@@ -219,6 +251,11 @@ class DecoderImpl : public Allocable {
   // |wedge_masks_initialized_| to true.
   bool MaybeInitializeWedgeMasks(FrameType frame_type);
 
+  // Reports the memory of the frame buffers and the frame scratch buffers
+  // against |settings_.memory_limit|. Declared first so that it outlives the
+  // buffers.
+  MemoryTracker memory_tracker_;
+
   // Elements in this queue cannot be moved with std::move since the
   // |EncodedFrame.temporal_unit| stores a pointer to elements in this queue.
   Queue<TemporalUnit> temporal_units_;
@@ -241,6 +278,16 @@ class DecoderImpl : public Allocable {
   QuantizerMatrix quantizer_matrix_;
   bool quantizer_matrix_initialized_ = false;
   FrameScratchBufferPool frame_scratch_buffer_pool_;
+  // The scaling lookup tables of the last film grain scaling points of each
+  // bitdepth. Streams usually keep the scaling points from frame to frame,
+  // while the random seed changes with every frame.
+  FilmGrainScalingLutCache<8> film_grain_scaling_lut_cache_8bpp_;
+#if LIBGAV1_MAX_BITDEPTH >= 10
+  FilmGrainScalingLutCache<10> film_grain_scaling_lut_cache_10bpp_;
+#endif
+#if LIBGAV1_MAX_BITDEPTH == 12
+  FilmGrainScalingLutCache<12> film_grain_scaling_lut_cache_12bpp_;
+#endif
 
   // Used to synchronize the accesses into |temporal_units_| in order to update
   // the "decoded" state of an temporal unit.
@@ -248,6 +295,12 @@ class DecoderImpl : public Allocable {
   std::condition_variable decoded_condvar_;
   bool is_frame_parallel_;
   std::unique_ptr<ThreadPool> frame_thread_pool_;
+  // True if |settings_.frame_ready| is set and the decoder is not in frame
+  // parallel mode. The temporal units are then decoded one at a time on
+  // |async_thread_pool_| instead of in DequeueFrame(), and dequeued as in
+  // frame parallel mode.
+  bool is_async_ = false;
+  std::unique_ptr<ThreadPool> async_thread_pool_;
 
   // In frame parallel mode, there are two primary points of failure:
   //  1) ParseAndSchedule()
@@ -263,6 +316,14 @@ class DecoderImpl : public Allocable {
   bool has_sequence_header_ = false;
 
   const DecoderSettings& settings_;
+  // The threads of |settings_.thread_pool|, or nullptr if the decoder creates
+  // its own.
+  ThreadPool* const shared_thread_pool_;
+  // Places the worker threads the decoder creates if
+  // |settings_.prefer_fast_cores| is set, or nullptr.
+  std::unique_ptr<CpuPlacement> cpu_placement_;
+  // |settings_.post_filter_mask|, less the filters that previews skip.
+  const int post_filter_mask_;
   bool seen_first_frame_ = false;
 };
 
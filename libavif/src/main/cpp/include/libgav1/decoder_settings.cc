@@ -30,4 +30,14 @@ void Libgav1DecoderSettingsInitDefault(Libgav1DecoderSettings* settings) {
   settings->post_filter_mask = 0x1f;
 }
 
+void Libgav1DecoderSettingsExtensionInitDefault(
+    Libgav1DecoderSettingsExtension* extension) {
+  extension->size = sizeof(*extension);
+  extension->thread_pool = nullptr;
+  extension->preview_shift = 0;
+  extension->frame_ready = nullptr;
+  extension->prefer_fast_cores = 0;  // false
+  extension->memory_limit = 0;
+}
+
 }  // extern "C"
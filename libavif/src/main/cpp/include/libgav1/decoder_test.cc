@@ -14,12 +14,27 @@
 
 #include "src/gav1/decoder.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>              // NOLINT (unapproved c++11 header)
+#include <condition_variable>  // NOLINT (unapproved c++11 header)
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <mutex>  // NOLINT (unapproved c++11 header)
 #include <new>
+#include <thread>  // NOLINT (unapproved c++11 header)
+#include <utility>
+#include <vector>
 
 #include "gtest/gtest.h"
+#include "src/decoder_impl.h"
+#include "src/decoder_test_data.h"
+#include "src/film_grain.h"
+#include "src/gav1/allocator.h"
+#include "src/utils/constants.h"
+#include "src/utils/memory.h"
 
 namespace libgav1 {
 namespace {
@@ -348,5 +363,635 @@ TEST_F(DecoderTest, NonFrameParallelModeInvalidFrameAfterEOS) {
   EXPECT_EQ(frames_in_use_, 0);
 }
 
+// Two decoders run on one shared thread pool and produce the same output as a
+// single-threaded decoder.
+TEST(DecoderThreadPoolTest, DecodersShareThreadPool) {
+  DecoderThreadPool thread_pool;
+  EXPECT_EQ(thread_pool.Init(0), kStatusInvalidArgument);
+  ASSERT_EQ(thread_pool.Init(2), kStatusOk);
+  EXPECT_EQ(thread_pool.Init(2), kStatusAlready);
+
+  DecoderSettings settings;
+  Decoder reference_decoder;
+  ASSERT_EQ(reference_decoder.Init(&settings), kStatusOk);
+  settings.threads = 4;
+  settings.thread_pool = &thread_pool;
+  Decoder decoders[2];
+  for (auto& decoder : decoders) {
+    ASSERT_EQ(decoder.Init(&settings), kStatusOk);
+  }
+
+  for (const auto& frame : {std::make_pair(kFrame1, sizeof(kFrame1)),
+                            std::make_pair(kFrame2, sizeof(kFrame2))}) {
+    const DecoderBuffer* reference_buffer;
+    ASSERT_EQ(reference_decoder.EnqueueFrame(frame.first, frame.second, 0,
+                                             nullptr),
+              kStatusOk);
+    ASSERT_EQ(reference_decoder.DequeueFrame(&reference_buffer), kStatusOk);
+    ASSERT_NE(reference_buffer, nullptr);
+    for (auto& decoder : decoders) {
+      const DecoderBuffer* buffer;
+      ASSERT_EQ(decoder.EnqueueFrame(frame.first, frame.second, 0, nullptr),
+                kStatusOk);
+      ASSERT_EQ(decoder.DequeueFrame(&buffer), kStatusOk);
+      ASSERT_NE(buffer, nullptr);
+      for (int plane = 0; plane < buffer->NumPlanes(); ++plane) {
+        const int height = (plane == 0) ? buffer->displayed_height[0]
+                                        : buffer->displayed_height[1];
+        const int width = (plane == 0) ? buffer->displayed_width[0]
+                                       : buffer->displayed_width[1];
+        for (int y = 0; y < height; ++y) {
+          EXPECT_EQ(memcmp(buffer->plane[plane] + y * buffer->stride[plane],
+                           reference_buffer->plane[plane] +
+                               y * reference_buffer->stride[plane],
+                           width),
+                    0);
+        }
+      }
+    }
+  }
+}
+
+TEST(DecoderThreadPoolTest, UninitializedThreadPool) {
+  DecoderThreadPool thread_pool;
+  DecoderSettings settings;
+  settings.threads = 2;
+  settings.thread_pool = &thread_pool;
+  Decoder decoder;
+  EXPECT_EQ(decoder.Init(&settings), kStatusInvalidArgument);
+}
+
+// A preview is the box average of the frame decoded without post filters.
+TEST(DecoderPreviewTest, PreviewIsDownscaledFrame) {
+  DecoderSettings settings;
+  settings.preview_shift = 4;
+  Decoder invalid_decoder;
+  EXPECT_EQ(invalid_decoder.Init(&settings), kStatusInvalidArgument);
+
+  settings.preview_shift = 2;
+  Decoder decoder;
+  ASSERT_EQ(decoder.Init(&settings), kStatusOk);
+  settings.preview_shift = 0;
+  settings.post_filter_mask = 0;
+  Decoder reference_decoder;
+  ASSERT_EQ(reference_decoder.Init(&settings), kStatusOk);
+
+  for (const auto& frame : {std::make_pair(kFrame1, sizeof(kFrame1)),
+                            std::make_pair(kFrame2, sizeof(kFrame2))}) {
+    const DecoderBuffer* reference_buffer;
+    ASSERT_EQ(reference_decoder.EnqueueFrame(frame.first, frame.second, 0,
+                                             nullptr),
+              kStatusOk);
+    ASSERT_EQ(reference_decoder.DequeueFrame(&reference_buffer), kStatusOk);
+    ASSERT_NE(reference_buffer, nullptr);
+    const DecoderBuffer* buffer;
+    ASSERT_EQ(decoder.EnqueueFrame(frame.first, frame.second, 0, nullptr),
+              kStatusOk);
+    ASSERT_EQ(decoder.DequeueFrame(&buffer), kStatusOk);
+    ASSERT_NE(buffer, nullptr);
+    ASSERT_EQ(buffer->bitdepth, 8);
+    ASSERT_EQ(buffer->NumPlanes(), reference_buffer->NumPlanes());
+    for (int plane = 0; plane < buffer->NumPlanes(); ++plane) {
+      const int width = buffer->displayed_width[plane];
+      const int height = buffer->displayed_height[plane];
+      const int full_width = reference_buffer->displayed_width[plane];
+      const int full_height = reference_buffer->displayed_height[plane];
+      const uint8_t* const full = reference_buffer->plane[plane];
+      const int full_stride = reference_buffer->stride[plane];
+      ASSERT_EQ(width, (full_width + 3) >> 2);
+      ASSERT_EQ(height, (full_height + 3) >> 2);
+      for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+          int sum = 0;
+          int count = 0;
+          for (int i = 4 * y; i < std::min(4 * y + 4, full_height); ++i) {
+            for (int j = 4 * x; j < std::min(4 * x + 4, full_width); ++j) {
+              sum += full[i * full_stride + j];
+              ++count;
+            }
+          }
+          EXPECT_EQ(buffer->plane[plane][y * buffer->stride[plane] + x],
+                    (sum + count / 2) / count);
+        }
+      }
+    }
+  }
+}
+
+// Decodes kFrame1 and kFrame2 and returns the status of the first call that
+// fails, or kStatusOk.
+StatusCode DecodeTestFrames(Decoder* const decoder) {
+  for (const auto& frame : {std::make_pair(kFrame1, sizeof(kFrame1)),
+                            std::make_pair(kFrame2, sizeof(kFrame2))}) {
+    StatusCode status =
+        decoder->EnqueueFrame(frame.first, frame.second, 0, nullptr);
+    if (status != kStatusOk) return status;
+    const DecoderBuffer* buffer;
+    status = decoder->DequeueFrame(&buffer);
+    if (status != kStatusOk) return status;
+  }
+  return kStatusOk;
+}
+
+using TestFrames = std::vector<std::pair<const uint8_t*, size_t>>;
+
+const TestFrames& FilmGrainFrames() {
+  static const TestFrames* const frames = new TestFrames{
+      {kFilmGrainFrame1, sizeof(kFilmGrainFrame1)},
+      {kFilmGrainFrame2, sizeof(kFilmGrainFrame2)},
+      {kFilmGrainFrame3, sizeof(kFilmGrainFrame3)},
+      {kFilmGrainFrame4, sizeof(kFilmGrainFrame4)}};
+  return *frames;
+}
+
+extern "C" {
+
+static void IgnoreInputBuffer(void* /*callback_private_data*/,
+                              void* /*buffer_private_data*/) {}
+
+}  // extern "C"
+
+// Decodes |frames| with a decoder created with |settings| and returns the
+// status of the first call that fails, or kStatusOk. Works in frame parallel
+// mode too, where the calls may have to be retried. Stores the memory usage of
+// the decoder in |usage|.
+StatusCode DecodeFrames(DecoderSettings settings, const TestFrames& frames,
+                        MemoryUsage* const usage) {
+  settings.release_input_buffer = IgnoreInputBuffer;
+  Decoder decoder;
+  StatusCode status = decoder.Init(&settings);
+  size_t enqueued = 0;
+  size_t dequeued = 0;
+  while (status == kStatusOk && dequeued < frames.size()) {
+    if (enqueued < frames.size()) {
+      status = decoder.EnqueueFrame(frames[enqueued].first,
+                                    frames[enqueued].second, 0, nullptr);
+      if (status == kStatusOk) {
+        ++enqueued;
+        continue;
+      }
+      if (status != kStatusTryAgain) break;
+    }
+    const DecoderBuffer* buffer;
+    status = decoder.DequeueFrame(&buffer);
+    if (status == kStatusOk) ++dequeued;
+    if (status == kStatusTryAgain) status = kStatusOk;
+  }
+  if (decoder.GetMemoryUsage(usage) != kStatusOk) *usage = {};
+  return status;
+}
+
+// The decoder reports the memory it holds and fails once the limit is too small
+// for the frame buffers.
+TEST(DecoderMemoryTest, ReportsAndLimitsMemory) {
+  MemoryUsage usage;
+  Decoder uninitialized_decoder;
+  EXPECT_EQ(uninitialized_decoder.GetMemoryUsage(&usage),
+            kStatusNotInitialized);
+
+  DecoderSettings settings;
+  Decoder decoder;
+  ASSERT_EQ(decoder.Init(&settings), kStatusOk);
+  ASSERT_EQ(DecodeTestFrames(&decoder), kStatusOk);
+  ASSERT_EQ(decoder.GetMemoryUsage(&usage), kStatusOk);
+  EXPECT_GT(usage.bytes[kMemoryClassFrameBuffers], 0u);
+  EXPECT_GT(usage.bytes[kMemoryClassFrameScratch], 0u);
+  EXPECT_EQ(usage.bytes[kMemoryClassFilmGrainFrames], 0u);
+  size_t total_bytes = 0;
+  for (const size_t bytes : usage.bytes) total_bytes += bytes;
+  EXPECT_EQ(usage.total_bytes, total_bytes);
+  EXPECT_GE(usage.peak_total_bytes, usage.total_bytes);
+  EXPECT_EQ(usage.limit_bytes, 0u);
+  EXPECT_EQ(usage.num_reductions, 0);
+
+  // The same decode fits in its own peak.
+  const size_t peak_total_bytes = usage.peak_total_bytes;
+  settings.memory_limit = peak_total_bytes;
+  Decoder limited_decoder;
+  ASSERT_EQ(limited_decoder.Init(&settings), kStatusOk);
+  ASSERT_EQ(DecodeTestFrames(&limited_decoder), kStatusOk);
+  ASSERT_EQ(limited_decoder.GetMemoryUsage(&usage), kStatusOk);
+  EXPECT_LE(usage.peak_total_bytes, peak_total_bytes);
+  EXPECT_EQ(usage.limit_bytes, peak_total_bytes);
+
+  settings.memory_limit = usage.bytes[kMemoryClassFrameBuffers] / 2;
+  Decoder starved_decoder;
+  ASSERT_EQ(starved_decoder.Init(&settings), kStatusOk);
+  EXPECT_EQ(DecodeTestFrames(&starved_decoder), kStatusOutOfMemory);
+}
+
+// Within the limit, the decoder uses fewer tile threads and falls back from
+// frame parallel mode, and it applies film grain to a still picture in place.
+TEST(DecoderMemoryTest, ReducesMemoryToFitTheLimit) {
+  DecoderSettings settings;
+  settings.threads = 8;
+  MemoryUsage usage;
+  ASSERT_EQ(DecodeFrames(settings, FilmGrainFrames(), &usage), kStatusOk);
+  EXPECT_EQ(usage.num_reductions, 0);
+  const size_t threaded_peak_bytes = usage.peak_total_bytes;
+  // Its own peak leaves no room for a tile scratch buffer per thread.
+  settings.memory_limit = threaded_peak_bytes;
+  ASSERT_EQ(DecodeFrames(settings, FilmGrainFrames(), &usage), kStatusOk);
+  EXPECT_GT(usage.num_reductions, 0);
+  EXPECT_LE(usage.peak_total_bytes, threaded_peak_bytes);
+
+  settings.memory_limit = 0;
+  settings.frame_parallel = true;
+  ASSERT_EQ(DecodeFrames(settings, FilmGrainFrames(), &usage), kStatusOk);
+  EXPECT_EQ(usage.num_reductions, 0);
+  const size_t frame_parallel_peak_bytes = usage.peak_total_bytes;
+  ASSERT_GT(frame_parallel_peak_bytes, threaded_peak_bytes);
+  settings.memory_limit = (threaded_peak_bytes + frame_parallel_peak_bytes) / 2;
+  ASSERT_EQ(DecodeFrames(settings, FilmGrainFrames(), &usage), kStatusOk);
+  EXPECT_GT(usage.num_reductions, 0);
+  EXPECT_LE(usage.peak_total_bytes, settings.memory_limit);
+
+  // No film grain frame is allocated for the still picture, with or without a
+  // limit.
+  const TestFrames still_frames = {
+      {kStillFilmGrainFrame, sizeof(kStillFilmGrainFrame)}};
+  settings = DecoderSettings();
+  ASSERT_EQ(DecodeFrames(settings, still_frames, &usage), kStatusOk);
+  EXPECT_EQ(usage.bytes[kMemoryClassFilmGrainFrames], 0u);
+  const size_t still_peak_bytes = usage.peak_total_bytes;
+  settings.memory_limit = still_peak_bytes;
+  ASSERT_EQ(DecodeFrames(settings, still_frames, &usage), kStatusOk);
+  EXPECT_EQ(usage.peak_total_bytes, still_peak_bytes);
+  EXPECT_EQ(usage.num_reductions, 0);
+}
+
+// The still picture fast path (no reference slot, film grain in place, smaller
+// borders) outputs the same picture as the regular path, which the same
+// temporal unit takes once its sequence header no longer sets still_picture.
+TEST(DecoderStillPictureTest, MatchesRegularDecode) {
+  std::vector<uint8_t> regular_frame(
+      kStillFilmGrainFrame, kStillFilmGrainFrame + sizeof(kStillFilmGrainFrame));
+  // The first byte of the sequence header OBU payload holds seq_profile (3
+  // bits), still_picture and reduced_still_picture_header.
+  ASSERT_EQ(regular_frame[4] & 0x10, 0x10);
+  regular_frame[4] &= ~0x10;
+
+  DecoderSettings settings;
+  Decoder still_decoder;
+  ASSERT_EQ(still_decoder.Init(&settings), kStatusOk);
+  Decoder regular_decoder;
+  ASSERT_EQ(regular_decoder.Init(&settings), kStatusOk);
+  const DecoderBuffer* still_buffer;
+  ASSERT_EQ(still_decoder.EnqueueFrame(kStillFilmGrainFrame,
+                                       sizeof(kStillFilmGrainFrame), 0,
+                                       nullptr),
+            kStatusOk);
+  ASSERT_EQ(still_decoder.DequeueFrame(&still_buffer), kStatusOk);
+  ASSERT_NE(still_buffer, nullptr);
+  const DecoderBuffer* regular_buffer;
+  ASSERT_EQ(regular_decoder.EnqueueFrame(regular_frame.data(),
+                                         regular_frame.size(), 0, nullptr),
+            kStatusOk);
+  ASSERT_EQ(regular_decoder.DequeueFrame(&regular_buffer), kStatusOk);
+  ASSERT_NE(regular_buffer, nullptr);
+
+  ASSERT_EQ(still_buffer->bitdepth, regular_buffer->bitdepth);
+  ASSERT_EQ(still_buffer->NumPlanes(), regular_buffer->NumPlanes());
+  const int pixel_size = (still_buffer->bitdepth == 8) ? 1 : 2;
+  for (int plane = 0; plane < still_buffer->NumPlanes(); ++plane) {
+    const int width = still_buffer->displayed_width[plane];
+    const int height = still_buffer->displayed_height[plane];
+    ASSERT_EQ(width, regular_buffer->displayed_width[plane]);
+    ASSERT_EQ(height, regular_buffer->displayed_height[plane]);
+    for (int y = 0; y < height; ++y) {
+      ASSERT_EQ(memcmp(still_buffer->plane[plane] +
+                           y * still_buffer->stride[plane],
+                       regular_buffer->plane[plane] +
+                           y * regular_buffer->stride[plane],
+                       width * pixel_size),
+                0)
+          << "plane " << plane << ", row " << y;
+    }
+  }
+
+  // Only the regular path keeps a separate film grain frame.
+  MemoryUsage still_usage;
+  ASSERT_EQ(still_decoder.GetMemoryUsage(&still_usage), kStatusOk);
+  MemoryUsage regular_usage;
+  ASSERT_EQ(regular_decoder.GetMemoryUsage(&regular_usage), kStatusOk);
+  EXPECT_EQ(still_usage.bytes[kMemoryClassFilmGrainFrames], 0u);
+  EXPECT_GT(regular_usage.bytes[kMemoryClassFilmGrainFrames], 0u);
+  EXPECT_LT(still_usage.peak_total_bytes, regular_usage.peak_total_bytes);
+}
+
+// Decodes the temporal unit |data| of |size| bytes with a decoder created with
+// |settings| and stores the displayed samples of its planes, row after row, in
+// |pixels|.
+void DecodeToPixels(const DecoderSettings& settings, const uint8_t* data,
+                    size_t size, std::vector<uint8_t>* const pixels) {
+  Decoder decoder;
+  ASSERT_EQ(decoder.Init(&settings), kStatusOk);
+  ASSERT_EQ(decoder.EnqueueFrame(data, size, 0, nullptr), kStatusOk);
+  const DecoderBuffer* buffer;
+  ASSERT_EQ(decoder.DequeueFrame(&buffer), kStatusOk);
+  ASSERT_NE(buffer, nullptr);
+  const int pixel_size = (buffer->bitdepth == 8) ? 1 : 2;
+  pixels->clear();
+  for (int plane = 0; plane < buffer->NumPlanes(); ++plane) {
+    for (int y = 0; y < buffer->displayed_height[plane]; ++y) {
+      const uint8_t* const row =
+          buffer->plane[plane] + y * buffer->stride[plane];
+      pixels->insert(pixels->end(), row,
+                     row + buffer->displayed_width[plane] * pixel_size);
+    }
+  }
+}
+
+// The threaded post filter runs deblocking, CDEF and loop restoration band by
+// band without SuperRes and one filter at a time over the frame with it. Both
+// match the single-threaded post filter on a frame of several bands.
+TEST(DecoderPostFilterTest, ThreadedMatchesSingleThreaded) {
+  for (const auto& frame :
+       {std::make_pair(kPostFilterBandFrame, sizeof(kPostFilterBandFrame)),
+        std::make_pair(kPostFilterBandSuperResFrame,
+                       sizeof(kPostFilterBandSuperResFrame))}) {
+    DecoderSettings settings;
+    std::vector<uint8_t> expected;
+    DecodeToPixels(settings, frame.first, frame.second, &expected);
+    ASSERT_FALSE(expected.empty());
+
+    // Each of the filters changes the frame.
+    for (const uint8_t post_filter_mask : {0x1e, 0x1d, 0x17}) {
+      settings.post_filter_mask = post_filter_mask;
+      std::vector<uint8_t> unfiltered;
+      DecodeToPixels(settings, frame.first, frame.second, &unfiltered);
+      EXPECT_NE(unfiltered, expected)
+          << "post_filter_mask " << static_cast<int>(post_filter_mask);
+    }
+    settings.post_filter_mask = 0x1f;
+
+    for (const int threads : {2, 3, 4, 8}) {
+      settings.threads = threads;
+      std::vector<uint8_t> pixels;
+      DecodeToPixels(settings, frame.first, frame.second, &pixels);
+      EXPECT_EQ(pixels, expected) << threads << " threads";
+    }
+  }
+}
+
+// Fails the allocation of the residual buffer that Tile::Init() makes for an
+// 8-bit tile decoded by a single thread, on every thread but |caller|.
+struct WorkerTileAllocationFailure {
+  static constexpr size_t kResidualBufferSize =
+      (4096 + 32 * kResidualPaddingVertical) * sizeof(int16_t);
+
+  std::thread::id caller;
+  std::atomic<int> failures{0};
+};
+
+extern "C" {
+
+static void* FailWorkerTileAllocation(void* callback_private_data,
+                                      size_t alignment, size_t size) {
+  auto* const failure =
+      static_cast<WorkerTileAllocationFailure*>(callback_private_data);
+  if (size == WorkerTileAllocationFailure::kResidualBufferSize &&
+      std::this_thread::get_id() != failure->caller) {
+    failure->failures.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  return SystemAlignedAlloc(alignment, size);
+}
+
+static void FreeWorkerTileAllocation(void* /*callback_private_data*/,
+                                     void* ptr) {
+  SystemAlignedFree(ptr);
+}
+
+}  // extern "C"
+
+// A tile that a tile worker fails to create fails the decode instead of
+// leaving the calling thread waiting for it.
+TEST(DecoderTileThreadsTest, WorkerTileCreationFailureFailsDecode) {
+  WorkerTileAllocationFailure failure;
+  failure.caller = std::this_thread::get_id();
+  SetAllocator(FailWorkerTileAllocation, FreeWorkerTileAllocation, &failure);
+  DecoderSettings settings;
+  settings.threads = 4;
+  bool worker_failed = false;
+  // The calling thread also creates and decodes tiles, so retry until a
+  // worker has claimed one.
+  for (int attempt = 0; attempt < 100 && !worker_failed; ++attempt) {
+    failure.failures = 0;
+    Decoder decoder;
+    ASSERT_EQ(decoder.Init(&settings), kStatusOk);
+    ASSERT_EQ(
+        decoder.EnqueueFrame(kFourTileFrame, sizeof(kFourTileFrame), 0, nullptr),
+        kStatusOk);
+    const DecoderBuffer* buffer;
+    const StatusCode status = decoder.DequeueFrame(&buffer);
+    worker_failed = failure.failures > 0;
+    if (worker_failed) {
+      EXPECT_NE(status, kStatusOk);
+    } else {
+      EXPECT_EQ(status, kStatusOk);
+    }
+  }
+  SetAllocator(nullptr, nullptr, nullptr);
+  EXPECT_TRUE(worker_failed);
+
+  // The same frame decodes once the allocations succeed.
+  Decoder decoder;
+  ASSERT_EQ(decoder.Init(&settings), kStatusOk);
+  ASSERT_EQ(
+      decoder.EnqueueFrame(kFourTileFrame, sizeof(kFourTileFrame), 0, nullptr),
+      kStatusOk);
+  const DecoderBuffer* buffer;
+  EXPECT_EQ(decoder.DequeueFrame(&buffer), kStatusOk);
+}
+
+// The film grain frames keep the scaling points and change the random seed, so
+// the scaling lookup tables are generated for the first frame only.
+TEST(DecoderFilmGrainTest, ReusesScalingLookupTables) {
+  DecoderSettings settings;
+  std::unique_ptr<DecoderImpl> decoder;
+  ASSERT_EQ(DecoderImpl::Create(&settings, &decoder), kStatusOk);
+  for (const auto& frame : FilmGrainFrames()) {
+    ASSERT_EQ(decoder->EnqueueFrame(frame.first, frame.second, 0, nullptr),
+              kStatusOk);
+    const DecoderBuffer* buffer;
+    ASSERT_EQ(decoder->DequeueFrame(&buffer), kStatusOk);
+    ASSERT_NE(buffer, nullptr);
+  }
+  const FilmGrainScalingLutCache<8>& cache =
+      decoder->film_grain_scaling_lut_cache_8bpp();
+  EXPECT_EQ(cache.num_misses(), 1);
+  EXPECT_EQ(cache.num_hits(), static_cast<int>(FilmGrainFrames().size()) - 1);
+}
+
+// Records the temporal units that the frame_ready callback signals.
+class FrameReadyRecorder {
+ public:
+  void Signal(int64_t user_private_data) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ready_.push_back(user_private_data);
+    condvar_.notify_all();
+  }
+
+  // Returns false if |user_private_data| is not signaled within 10 seconds.
+  bool WaitFor(int64_t user_private_data) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return condvar_.wait_for(lock, std::chrono::seconds(10), [&]() {
+      return std::find(ready_.begin(), ready_.end(), user_private_data) !=
+             ready_.end();
+    });
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable condvar_;
+  std::vector<int64_t> ready_;
+};
+
+extern "C" {
+
+static void FrameReady(void* callback_private_data, int64_t user_private_data) {
+  static_cast<FrameReadyRecorder*>(callback_private_data)
+      ->Signal(user_private_data);
+}
+
+}  // extern "C"
+
+// With a frame_ready callback the temporal units are decoded in the background
+// and signaled once DequeueFrame() can return them: on a thread of the
+// decoder, on a shared pool and on the frame threads.
+TEST(DecoderAsyncTest, SignalsDecodedFrames) {
+  DecoderThreadPool thread_pool;
+  ASSERT_EQ(thread_pool.Init(2), kStatusOk);
+  for (int mode = 0; mode < 3; ++mode) {
+    SCOPED_TRACE(mode);
+    FrameReadyRecorder recorder;
+    DecoderSettings settings;
+    settings.release_input_buffer = IgnoreInputBuffer;
+    settings.callback_private_data = &recorder;
+    settings.frame_ready = FrameReady;
+    if (mode == 1) settings.thread_pool = &thread_pool;
+    if (mode == 2) {
+      settings.threads = 2;
+      settings.frame_parallel = true;
+    }
+    Decoder decoder;
+    ASSERT_EQ(decoder.Init(&settings), kStatusOk);
+    Decoder reference_decoder;
+    ASSERT_EQ(reference_decoder.Init(nullptr), kStatusOk);
+
+    const DecoderBuffer* buffer;
+    EXPECT_EQ(decoder.DequeueFrame(&buffer), kStatusNothingToDequeue);
+    int64_t user_private_data = 0;
+    for (const auto& frame : {std::make_pair(kFrame1, sizeof(kFrame1)),
+                              std::make_pair(kFrame2, sizeof(kFrame2))}) {
+      ++user_private_data;
+      ASSERT_EQ(decoder.EnqueueFrame(frame.first, frame.second,
+                                     user_private_data, nullptr),
+                kStatusOk);
+      ASSERT_TRUE(recorder.WaitFor(user_private_data));
+      ASSERT_EQ(decoder.DequeueFrame(&buffer), kStatusOk);
+      ASSERT_NE(buffer, nullptr);
+      EXPECT_EQ(buffer->user_private_data, user_private_data);
+
+      const DecoderBuffer* reference_buffer;
+      ASSERT_EQ(reference_decoder.EnqueueFrame(frame.first, frame.second, 0,
+                                               nullptr),
+                kStatusOk);
+      ASSERT_EQ(reference_decoder.DequeueFrame(&reference_buffer), kStatusOk);
+      ASSERT_NE(reference_buffer, nullptr);
+      ASSERT_EQ(buffer->NumPlanes(), reference_buffer->NumPlanes());
+      for (int plane = 0; plane < buffer->NumPlanes(); ++plane) {
+        ASSERT_EQ(buffer->displayed_width[plane],
+                  reference_buffer->displayed_width[plane]);
+        ASSERT_EQ(buffer->displayed_height[plane],
+                  reference_buffer->displayed_height[plane]);
+        for (int y = 0; y < buffer->displayed_height[plane]; ++y) {
+          EXPECT_EQ(memcmp(buffer->plane[plane] + y * buffer->stride[plane],
+                           reference_buffer->plane[plane] +
+                               y * reference_buffer->stride[plane],
+                           buffer->displayed_width[plane]),
+                    0);
+        }
+      }
+    }
+    EXPECT_EQ(decoder.DequeueFrame(&buffer), kStatusNothingToDequeue);
+  }
+}
+
+extern "C" {
+
+static void SetPreviewShift(void* callback_private_data,
+                            Libgav1DecoderSettings* /*settings*/,
+                            Libgav1DecoderSettingsExtension* extension) {
+  ++*static_cast<int*>(callback_private_data);
+  extension->preview_shift = 2;
+}
+
+}  // extern "C"
+
+// The settings callback applies to decoders created through the C API on the
+// thread that installed it.
+TEST(DecoderSettingsCallbackTest, AdjustsSettings) {
+  int calls = 0;
+  Libgav1SetDecoderSettingsCallback(SetPreviewShift, &calls);
+  for (const int expected_width : {8, 32}) {
+    Libgav1DecoderSettings settings;
+    Libgav1DecoderSettingsInitDefault(&settings);
+    Libgav1Decoder* decoder;
+    ASSERT_EQ(Libgav1DecoderCreate(&settings, &decoder), kLibgav1StatusOk);
+    ASSERT_EQ(Libgav1DecoderEnqueueFrame(decoder, kFrame1, sizeof(kFrame1), 0,
+                                         nullptr),
+              kLibgav1StatusOk);
+    const Libgav1DecoderBuffer* buffer;
+    ASSERT_EQ(Libgav1DecoderDequeueFrame(decoder, &buffer), kLibgav1StatusOk);
+    ASSERT_NE(buffer, nullptr);
+    EXPECT_EQ(buffer->displayed_width[0], expected_width);
+    Libgav1DecoderDestroy(decoder);
+    Libgav1SetDecoderSettingsCallback(nullptr, nullptr);
+  }
+  EXPECT_EQ(calls, 1);
+}
+
+// Decodes kFrame1 with a C API decoder created with |extension| and returns
+// the displayed width of the output.
+int DecodeWithExtension(const Libgav1DecoderSettingsExtension* extension) {
+  Libgav1DecoderSettings settings;
+  Libgav1DecoderSettingsInitDefault(&settings);
+  Libgav1Decoder* decoder;
+  if (Libgav1DecoderCreateWithExtension(&settings, extension, &decoder) !=
+      kLibgav1StatusOk) {
+    return -1;
+  }
+  int width = -1;
+  const Libgav1DecoderBuffer* buffer;
+  if (Libgav1DecoderEnqueueFrame(decoder, kFrame1, sizeof(kFrame1), 0,
+                                 nullptr) == kLibgav1StatusOk &&
+      Libgav1DecoderDequeueFrame(decoder, &buffer) == kLibgav1StatusOk &&
+      buffer != nullptr) {
+    width = buffer->displayed_width[0];
+  }
+  Libgav1DecoderDestroy(decoder);
+  return width;
+}
+
+// The fields past Libgav1DecoderSettingsExtension::size take their defaults,
+// so callers built against a shorter structure keep working.
+TEST(DecoderSettingsExtensionTest, HonorsSize) {
+  EXPECT_EQ(DecodeWithExtension(nullptr), 32);
+
+  Libgav1DecoderSettingsExtension extension;
+  Libgav1DecoderSettingsExtensionInitDefault(&extension);
+  EXPECT_EQ(extension.size, sizeof(extension));
+  extension.preview_shift = 2;
+  EXPECT_EQ(DecodeWithExtension(&extension), 8);
+
+  extension.size = offsetof(Libgav1DecoderSettingsExtension, preview_shift);
+  EXPECT_EQ(DecodeWithExtension(&extension), 32);
+
+  extension.size = 0;
+  EXPECT_EQ(DecodeWithExtension(&extension), -1);
+}
+
 }  // namespace
 }  // namespace libgav1
@@ -0,0 +1,361 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBGAV1_SRC_DECODER_TEST_DATA_H_
+#define LIBGAV1_SRC_DECODER_TEST_DATA_H_
+
+#include <cstdint>
+
+namespace libgav1 {
+
+// Four 64x64 8-bit 4:2:0 temporal units with film grain, encoded by libaom
+// 3.6.0 with --film-grain-test=1 --end-usage=q --cq-level=63 --cpu-used=6
+// --lag-in-frames=0. Film grain test vector 1 gives every frame a different
+// random seed.
+constexpr uint8_t kFilmGrainFrame1[] = {
+    0x12, 0x00, 0x0a, 0x0a, 0x00, 0x00, 0x00, 0x02, 0xaf, 0xff, 0x9b, 0x5f,
+    0x20, 0x18, 0x32, 0xd4, 0x02, 0x10, 0x00, 0xd3, 0x80, 0x61, 0x82, 0x08,
+    0x28, 0xb2, 0xeb, 0x61, 0x5f, 0xc2, 0x00, 0x03, 0x31, 0x04, 0x32, 0x05,
+    0x34, 0x06, 0x15, 0x07, 0x11, 0x08, 0x70, 0x0a, 0x52, 0x0c, 0x33, 0x0e,
+    0x32, 0x10, 0x16, 0x11, 0xf5, 0x13, 0xd6, 0x16, 0x57, 0x08, 0x10, 0x00,
+    0x14, 0x40, 0x1c, 0x58, 0x3c, 0x68, 0x5a, 0x88, 0x69, 0xa0, 0x86, 0xa8,
+    0xa8, 0xd0, 0x91, 0x00, 0x01, 0xc6, 0x03, 0x85, 0x04, 0x26, 0x05, 0x06,
+    0x86, 0xc6, 0x07, 0xa7, 0x08, 0x97, 0x0a, 0x9b, 0x0e, 0x80, 0x80, 0x46,
+    0x80, 0x80, 0x80, 0x34, 0xe4, 0x55, 0x80, 0x4d, 0xd2, 0x80, 0x80, 0x4f,
+    0x80, 0x80, 0x80, 0x5c, 0x96, 0x62, 0x80, 0x5a, 0x87, 0xa7, 0x80, 0x80,
+    0x51, 0x80, 0x80, 0x80, 0x61, 0x9f, 0x67, 0x80, 0x60, 0x8d, 0x1c, 0x8f,
+    0x7c, 0x00, 0x97, 0x2e, 0x00, 0xd9, 0xdb, 0x4c, 0x35, 0xb0, 0x09, 0x99,
+    0x9f, 0x94, 0x3f, 0xf3, 0x74, 0x0d, 0xd9, 0x8c, 0xad, 0xd3, 0x5d, 0x15,
+    0xe7, 0xff, 0x8a, 0x99, 0x2d, 0x25, 0x4c, 0x04, 0xeb, 0x5c, 0x5e, 0x71,
+    0x92, 0x88, 0xab, 0xdc, 0x77, 0x91, 0x52, 0x42, 0x5c, 0x02, 0x28, 0xbb,
+    0x7f, 0x52, 0xa8, 0x90, 0xd6, 0xa9, 0x55, 0xb0, 0xb3, 0x8b, 0xa2, 0x65,
+    0x1b, 0xce, 0x87, 0xbd, 0x63, 0x4e, 0x4f, 0x7d, 0x62, 0x97, 0x34, 0x52,
+    0x07, 0x1c, 0xfc, 0xd4, 0x40, 0x8d, 0xfd, 0x0a, 0xad, 0xdb, 0x16, 0x6d,
+    0x0f, 0xbd, 0x65, 0x36, 0x0b, 0x6a, 0x6f, 0x02, 0x9b, 0xbd, 0x36, 0xf4,
+    0x55, 0x18, 0x2c, 0xfc, 0xb8, 0x0e, 0x03, 0x58, 0xdd, 0x64, 0x35, 0xe7,
+    0xb5, 0xc7, 0x32, 0x04, 0xf0, 0xb5, 0x03, 0x17, 0x29, 0xc0, 0xfa, 0x73,
+    0x54, 0xc4, 0x8e, 0x30, 0x8b, 0x2d, 0x9a, 0xfe, 0x0d, 0xf3, 0x2a, 0xa8,
+    0x0b, 0xdf, 0xeb, 0x93, 0xf2, 0x05, 0xd0, 0xe8, 0xa6, 0xf8, 0x77, 0x8f,
+    0x00, 0x09, 0xac, 0xee, 0x61, 0x8d, 0xd8, 0xbf, 0x9f, 0x36, 0x06, 0xcb,
+    0x35, 0x17, 0x86, 0x89, 0xc9, 0xad, 0xfc, 0xb8, 0x41, 0x3d, 0x0e, 0xa8,
+    0xe8, 0x4d, 0xd5, 0x22, 0x19, 0xa0, 0xaa, 0xec, 0x31, 0xd3, 0xf3, 0x48,
+    0x28, 0x66, 0x47, 0x24, 0x68, 0xa7, 0xce, 0x4c, 0x11, 0xa6, 0x99, 0xff,
+    0x5a, 0x34, 0x57, 0x29, 0xd8, 0xce, 0x5e, 0x15, 0x38, 0x32, 0x98, 0x32,
+    0x08, 0x00, 0xea, 0x15, 0x31, 0x5b, 0x8c, 0xad, 0x27, 0xfa, 0x73, 0xb8,
+    0x5c, 0x86, 0x40, 0x95, 0x95, 0x11, 0x94, 0x2c, 0xcd};
+
+constexpr uint8_t kFilmGrainFrame2[] = {
+    0x12, 0x00, 0x32, 0xab, 0x02, 0x30, 0x03, 0x80, 0x80, 0x00, 0x00, 0x06,
+    0xe9, 0x00, 0xa2, 0x88, 0x20, 0x2c, 0xba, 0xea, 0x01, 0xbd, 0xe4, 0xf0,
+    0x80, 0x00, 0xcc, 0x41, 0x0c, 0x81, 0x4d, 0x01, 0x85, 0x41, 0xc4, 0x42,
+    0x1c, 0x02, 0x94, 0x83, 0x0c, 0xc3, 0x8c, 0x84, 0x05, 0x84, 0x7d, 0x44,
+    0xf5, 0x85, 0x95, 0xc2, 0x04, 0x00, 0x05, 0x10, 0x07, 0x16, 0x0f, 0x1a,
+    0x16, 0xa2, 0x1a, 0x68, 0x21, 0xaa, 0x2a, 0x34, 0x24, 0x40, 0x00, 0x71,
+    0x80, 0xe1, 0x41, 0x09, 0x81, 0x41, 0xa1, 0xb1, 0x81, 0xe9, 0xc2, 0x25,
+    0xc2, 0xa6, 0xc3, 0xa0, 0x20, 0x11, 0xa0, 0x20, 0x20, 0x0d, 0x39, 0x15,
+    0x60, 0x13, 0x74, 0xa0, 0x20, 0x13, 0xe0, 0x20, 0x20, 0x17, 0x25, 0x98,
+    0xa0, 0x16, 0xa1, 0xe9, 0xe0, 0x20, 0x14, 0x60, 0x20, 0x20, 0x18, 0x67,
+    0xd9, 0xe0, 0x18, 0x23, 0x47, 0x23, 0xdf, 0x00, 0x25, 0xcb, 0x80, 0x36,
+    0x40, 0xb2, 0x1c, 0x1a, 0x09, 0x42, 0xfe, 0xbf, 0xa1, 0xbd, 0xef, 0x39,
+    0xde, 0x65, 0xbc, 0x61, 0xab, 0x2b, 0xdb, 0xb4, 0xc0, 0xca, 0x95, 0xc4,
+    0x32, 0xc6, 0x49, 0x25, 0x50, 0x8c, 0xc2, 0x50, 0x64, 0x5a, 0x03, 0xcc,
+    0xb5, 0xd3, 0xd4, 0x43, 0x8c, 0xf7, 0xef, 0xc2, 0x8e, 0x63, 0xa1, 0x20,
+    0x48, 0xe6, 0xeb, 0xf2, 0x01, 0xae, 0x12, 0x9e, 0xa6, 0xb6, 0xa5, 0x66,
+    0xcd, 0x75, 0x95, 0x45, 0x32, 0x68, 0x26, 0x68, 0xa7, 0x95, 0xc5, 0xfa,
+    0x0b, 0xbe, 0xc2, 0x1b, 0xac, 0x8f, 0x26, 0x08, 0xd9, 0x9a, 0xf0, 0xd7,
+    0x64, 0x3c, 0xdb, 0x77, 0x99, 0x0c, 0x9d, 0x5e, 0x11, 0x9e, 0x50, 0x95,
+    0x76, 0x77, 0x3e, 0xdd, 0x0a, 0x3a, 0xb0, 0x58, 0x6a, 0xa7, 0x5d, 0xfe,
+    0x70, 0xe9, 0x69, 0x37, 0xe6, 0x32, 0x15, 0x6b, 0x62, 0xc3, 0xee, 0x2a,
+    0x2f, 0xe9, 0xa9, 0xeb, 0x45, 0xb3, 0x74, 0x2e, 0x4c, 0xb0, 0xe7, 0xec,
+    0xec, 0xae, 0x87, 0x4e, 0x81, 0xe4, 0xf5, 0xf7, 0x6b, 0x97, 0xcd, 0x34,
+    0x95, 0x3e, 0xd2, 0xa6, 0xd4, 0x88, 0x93, 0xc7, 0x77, 0xc6, 0x89, 0x30,
+    0xa5, 0x62, 0xac, 0xbe, 0xf6, 0x60, 0xb7, 0x2a, 0xdc, 0x7f, 0x98, 0xa8,
+    0xb2, 0x91, 0x10, 0xc0};
+
+constexpr uint8_t kFilmGrainFrame3[] = {
+    0x12, 0x00, 0x32, 0xab, 0x05, 0x30, 0x04, 0xc1, 0x00, 0x02, 0x00, 0x46,
+    0xa8, 0x00, 0x51, 0x4a, 0x28, 0x24, 0xb2, 0xea, 0x01, 0xcb, 0x19, 0xf0,
+    0x80, 0x00, 0xcc, 0x41, 0x0c, 0x81, 0x4d, 0x01, 0x85, 0x41, 0xc4, 0x42,
+    0x1c, 0x02, 0x94, 0x83, 0x0c, 0xc3, 0x8c, 0x84, 0x05, 0x84, 0x7d, 0x44,
+    0xf5, 0x85, 0x95, 0xc2, 0x04, 0x00, 0x05, 0x10, 0x07, 0x16, 0x0f, 0x1a,
+    0x16, 0xa2, 0x1a, 0x68, 0x21, 0xaa, 0x2a, 0x34, 0x24, 0x40, 0x00, 0x71,
+    0x80, 0xe1, 0x41, 0x09, 0x81, 0x41, 0xa1, 0xb1, 0x81, 0xe9, 0xc2, 0x25,
+    0xc2, 0xa6, 0xc3, 0xa0, 0x20, 0x11, 0xa0, 0x20, 0x20, 0x0d, 0x39, 0x15,
+    0x60, 0x13, 0x74, 0xa0, 0x20, 0x13, 0xe0, 0x20, 0x20, 0x17, 0x25, 0x98,
+    0xa0, 0x16, 0xa1, 0xe9, 0xe0, 0x20, 0x14, 0x60, 0x20, 0x20, 0x18, 0x67,
+    0xd9, 0xe0, 0x18, 0x23, 0x47, 0x23, 0xdf, 0x00, 0x25, 0xcb, 0x80, 0x36,
+    0x40, 0xd6, 0xf3, 0x5b, 0xb6, 0x1b, 0x46, 0xc1, 0x63, 0x73, 0xb2, 0x5d,
+    0x50, 0xed, 0x20, 0xc0, 0x09, 0xf5, 0x43, 0xe9, 0xd3, 0xe3, 0x49, 0x9a,
+    0x97, 0x13, 0x52, 0x65, 0x31, 0x30, 0x1c, 0xed, 0x6e, 0xc1, 0x12, 0x79,
+    0x53, 0xa2, 0x9d, 0xc9, 0xc5, 0x93, 0xde, 0xee, 0x23, 0x05, 0x26, 0xac,
+    0x1d, 0x84, 0x5c, 0xc3, 0x9c, 0x88, 0x80, 0x96, 0x9c, 0x6c, 0x5e, 0xe9,
+    0x0c, 0xbe, 0x21, 0xe8, 0xb6, 0x23, 0x0d, 0x4f, 0x60, 0x8f, 0x96, 0x0e,
+    0x82, 0x8a, 0x22, 0xa5, 0x67, 0xfb, 0x62, 0x5f, 0xa2, 0xca, 0xf7, 0xc5,
+    0x4e, 0x96, 0xe8, 0x93, 0x14, 0x82, 0xff, 0xff, 0x73, 0xfe, 0x49, 0x64,
+    0xcf, 0x8d, 0xc3, 0xed, 0x5f, 0x7b, 0x9e, 0xe0, 0x5e, 0x67, 0x40, 0x4a,
+    0x09, 0xa9, 0x4f, 0xc9, 0xe2, 0x3f, 0xff, 0xf9, 0x5d, 0x7b, 0x08, 0x79,
+    0x76, 0x7b, 0x8d, 0x79, 0x68, 0x2c, 0x7d, 0xe5, 0xc7, 0xfc, 0x09, 0x2f,
+    0x96, 0xd0, 0x9b, 0x47, 0x5e, 0x7b, 0x95, 0xeb, 0xa8, 0x30, 0x39, 0xa1,
+    0x30, 0xaf, 0x67, 0xdd, 0x05, 0xe7, 0x59, 0xbc, 0xd3, 0x55, 0x52, 0xc5,
+    0x63, 0xd4, 0x22, 0x2d, 0xaf, 0x26, 0x33, 0x07, 0xee, 0x5c, 0x9a, 0x04,
+    0xff, 0xd8, 0x1e, 0xa5, 0x75, 0x8c, 0x78, 0xf4, 0x63, 0x43, 0x48, 0x40,
+    0x46, 0x58, 0x20, 0xde, 0xbc, 0x86, 0x4f, 0xe9, 0x56, 0xc7, 0xa6, 0x6d,
+    0x50, 0x5a, 0x18, 0x2d, 0x9e, 0xe8, 0x79, 0x1e, 0xa1, 0x5b, 0xac, 0xff,
+    0x44, 0x64, 0xf9, 0xa2, 0x6c, 0x28, 0x44, 0xf5, 0xb7, 0xf6, 0x89, 0xc5,
+    0x08, 0x74, 0x63, 0xd9, 0xfd, 0xcd, 0x52, 0x26, 0x41, 0x9e, 0x32, 0xea,
+    0x74, 0x8b, 0x5f, 0x69, 0x2d, 0xf6, 0x85, 0xea, 0xc3, 0xe0, 0x78, 0x10,
+    0xd5, 0x87, 0xe6, 0xc2, 0xce, 0x12, 0x17, 0xaa, 0x5d, 0x4c, 0x90, 0xb2,
+    0xb5, 0x69, 0xac, 0x40, 0xad, 0x9c, 0x5e, 0xd0, 0x08, 0x0b, 0x7e, 0x67,
+    0x31, 0x6a, 0xf4, 0xd0, 0xf7, 0xb1, 0x16, 0xf6, 0x22, 0x82, 0x0c, 0x3e,
+    0x7f, 0x97, 0xbd, 0xda, 0x23, 0x73, 0xe3, 0xf9, 0xb3, 0x71, 0xba, 0xe9,
+    0xd6, 0x0a, 0xd2, 0xf4, 0xa2, 0xf2, 0xf0, 0x1f, 0x04, 0x4b, 0x6d, 0xb0,
+    0x7f, 0x4f, 0xa3, 0x5f, 0xba, 0xb8, 0x06, 0xdf, 0x91, 0xa5, 0xe1, 0xd5,
+    0xed, 0x69, 0xfb, 0x43, 0x12, 0x27, 0x29, 0x3e, 0x44, 0x26, 0xba, 0x0d,
+    0x56, 0x09, 0xc7, 0xac, 0xbe, 0xbc, 0x22, 0x8e, 0x95, 0x80, 0xad, 0xb8,
+    0xc6, 0x84, 0xde, 0x31, 0x18, 0x87, 0xd5, 0x9f, 0xa8, 0x05, 0x88, 0xab,
+    0xda, 0x46, 0x2a, 0x14, 0x87, 0x46, 0x7b, 0xd1, 0x73, 0xdc, 0xca, 0x46,
+    0xbd, 0x55, 0x48, 0xcf, 0x82, 0x0e, 0x8d, 0x94, 0xab, 0x32, 0xc9, 0xd9,
+    0x1b, 0x4b, 0xae, 0xa4, 0x45, 0xf7, 0x2e, 0x72, 0x53, 0x0f, 0x5b, 0x1c,
+    0xa8, 0x35, 0x87, 0xb6, 0xac, 0xd9, 0x7b, 0x3b, 0x48, 0x4a, 0xdb, 0x2c,
+    0x5e, 0x5e, 0x6e, 0x6b, 0x81, 0xae, 0xc6, 0xfe, 0x58, 0x65, 0xba, 0x2b,
+    0xeb, 0x3d, 0xbc, 0xd3, 0x1d, 0xc2, 0x66, 0x38, 0x29, 0x08, 0xec, 0xd6,
+    0x74, 0x11, 0xab, 0x25, 0xaf, 0x10, 0x21, 0x7a, 0x5b, 0x52, 0xfb, 0xe6,
+    0x5a, 0xb6, 0xde, 0xec, 0xea, 0x9e, 0x52, 0x05, 0x77, 0x8a, 0xe8, 0xd9,
+    0x98, 0x00, 0x44, 0x9c, 0x93, 0x43, 0x02, 0x71, 0xbe, 0xab, 0x22, 0x55,
+    0x4f, 0x2d, 0x7b, 0x88, 0x82, 0x78, 0x10, 0xaa, 0xb6, 0x9f, 0x52, 0x5f,
+    0xbe, 0x82, 0x37, 0xb4, 0xd5, 0x41, 0xeb, 0xb5, 0x1b, 0x84, 0x3d, 0xe0,
+    0xe0, 0x54, 0xd2, 0x2f, 0xc4, 0xb9, 0x3c, 0x44, 0x40, 0xf9, 0x61, 0x04,
+    0x83, 0xd9, 0xf0, 0xca, 0x75, 0x95, 0x22, 0xda, 0x6b, 0xaf, 0x00, 0x4a,
+    0x6e, 0x6f, 0x8b, 0x47, 0x10, 0x4a, 0x5e, 0xd6, 0x50, 0xf7, 0x26, 0xe3,
+    0xd1, 0xa7, 0xda, 0xed, 0x17, 0xdb, 0xc5, 0x00, 0xae, 0x7d, 0xac, 0xf2,
+    0x2d, 0x7a, 0x0c, 0xfa, 0x78, 0x72, 0x85, 0x2f, 0x29, 0xb4, 0xd4, 0x25,
+    0x46, 0x33, 0x46, 0x69, 0xd7, 0xac, 0x15, 0xe7, 0x03, 0xe1, 0xff, 0x17,
+    0x31, 0x12, 0x74, 0xd0};
+
+constexpr uint8_t kFilmGrainFrame4[] = {
+    0x12, 0x00, 0x32, 0x9f, 0x03, 0x30, 0x06, 0xc2, 0x04, 0x04, 0x00, 0x46,
+    0xa8, 0x00, 0x51, 0x4a, 0x28, 0x24, 0xb2, 0xea, 0x01, 0xd8, 0x4e, 0xf0,
+    0x80, 0x00, 0xcc, 0x41, 0x0c, 0x81, 0x4d, 0x01, 0x85, 0x41, 0xc4, 0x42,
+    0x1c, 0x02, 0x94, 0x83, 0x0c, 0xc3, 0x8c, 0x84, 0x05, 0x84, 0x7d, 0x44,
+    0xf5, 0x85, 0x95, 0xc2, 0x04, 0x00, 0x05, 0x10, 0x07, 0x16, 0x0f, 0x1a,
+    0x16, 0xa2, 0x1a, 0x68, 0x21, 0xaa, 0x2a, 0x34, 0x24, 0x40, 0x00, 0x71,
+    0x80, 0xe1, 0x41, 0x09, 0x81, 0x41, 0xa1, 0xb1, 0x81, 0xe9, 0xc2, 0x25,
+    0xc2, 0xa6, 0xc3, 0xa0, 0x20, 0x11, 0xa0, 0x20, 0x20, 0x0d, 0x39, 0x15,
+    0x60, 0x13, 0x74, 0xa0, 0x20, 0x13, 0xe0, 0x20, 0x20, 0x17, 0x25, 0x98,
+    0xa0, 0x16, 0xa1, 0xe9, 0xe0, 0x20, 0x14, 0x60, 0x20, 0x20, 0x18, 0x67,
+    0xd9, 0xe0, 0x18, 0x23, 0x47, 0x23, 0xdf, 0x00, 0x25, 0xcb, 0x80, 0x36,
+    0x40, 0xd6, 0xb0, 0xd3, 0xc0, 0x14, 0x51, 0x65, 0xd0, 0xc6, 0xaf, 0x5e,
+    0x46, 0xb4, 0x09, 0xa7, 0x00, 0xd8, 0xf5, 0x29, 0x00, 0x68, 0x6c, 0x99,
+    0xf4, 0xcf, 0xe6, 0x4c, 0x07, 0xb9, 0x94, 0x75, 0x16, 0xeb, 0x88, 0xe3,
+    0x34, 0x9a, 0x20, 0x77, 0x0b, 0x82, 0x0b, 0x37, 0x36, 0x36, 0x6f, 0xde,
+    0xdf, 0x52, 0xd5, 0xd3, 0xef, 0x3b, 0xb3, 0x0f, 0xec, 0x73, 0x95, 0x77,
+    0x63, 0x0c, 0x8d, 0x0f, 0x2f, 0x98, 0x34, 0x17, 0x5c, 0xc9, 0xfc, 0x6a,
+    0x27, 0x7e, 0xe1, 0x2f, 0xd0, 0xf1, 0x7c, 0x01, 0x48, 0xc9, 0xd0, 0x11,
+    0x3d, 0xe1, 0x72, 0x2c, 0x52, 0x8c, 0x0b, 0xb9, 0xab, 0x67, 0x91, 0x15,
+    0x12, 0x76, 0x72, 0x76, 0xfd, 0xe9, 0x32, 0xf0, 0x69, 0xfa, 0x77, 0xb3,
+    0x6d, 0xf5, 0xb7, 0x4a, 0xf8, 0x8c, 0x21, 0xdc, 0x0b, 0xe8, 0xd0, 0x1b,
+    0x03, 0xf0, 0x26, 0x0e, 0xb9, 0x55, 0xf0, 0x1a, 0x96, 0xc5, 0x55, 0xba,
+    0x9a, 0x7c, 0x0a, 0x19, 0x9d, 0xf5, 0x5f, 0x00, 0xcd, 0xa5, 0xae, 0xba,
+    0x34, 0x28, 0xe8, 0x27, 0x0d, 0x39, 0xba, 0x65, 0x25, 0x9f, 0xd4, 0xc7,
+    0x68, 0x7e, 0x0f, 0x16, 0x17, 0x11, 0x1a, 0x17, 0x65, 0x25, 0x52, 0xcf,
+    0x42, 0x0d, 0xc9, 0x0c, 0xd7, 0x2b, 0xeb, 0x5f, 0x67, 0x7c, 0x76, 0x4d,
+    0xdc, 0xbc, 0x6e, 0x45, 0xa0, 0x52, 0x63, 0xb6, 0xff, 0x72, 0xd8, 0xee,
+    0x19, 0xd0, 0xbe, 0x1f, 0x2b, 0x80, 0x6c, 0xe5, 0xb0, 0xda, 0xb3, 0xc9,
+    0xd4, 0xff, 0xe1, 0x8a, 0x6e, 0x1e, 0x3f, 0x4a, 0x89, 0xcc, 0x86, 0x04,
+    0x11, 0x95, 0x52, 0x8e, 0xfa, 0x4c, 0xb0, 0x92, 0x3c, 0x0a, 0xc4, 0xc8,
+    0x7a, 0x26, 0x94, 0xcf, 0x46, 0xb8, 0x7f, 0x4f, 0x4b, 0x18, 0x36, 0x3d,
+    0x38, 0x4d, 0x44, 0x71, 0xac, 0x74, 0xd8, 0xab, 0x7f, 0xef, 0xb3, 0xdd,
+    0x85, 0xd6, 0xa3, 0xac, 0xf0, 0xc7, 0x34, 0xc2, 0x20, 0xfb, 0x68, 0xb3,
+    0xd7, 0x8c, 0x4e, 0x1f, 0xb9, 0x49, 0x5b, 0xaa, 0xdf, 0xd2, 0x22, 0x52,
+    0xf3, 0xb5, 0x31, 0x47, 0x56, 0x0c, 0x8b, 0x6b, 0x44, 0xed, 0x2a, 0xa0};
+
+// A 64x64 8-bit 4:2:0 still picture with film grain, encoded like
+// kFilmGrainFrame1 with --limit=1 --full-still-picture-hdr. Its sequence header
+// is not reduced, so clearing still_picture leaves a valid key frame that is
+// decoded the same way as any other.
+constexpr uint8_t kStillFilmGrainFrame[] = {
+    0x12, 0x00, 0x0a, 0x0a, 0x10, 0x00, 0x00, 0x02, 0xaf, 0xff, 0x9b, 0x5f,
+    0x20, 0x18, 0x32, 0xd3, 0x01, 0x10, 0x00, 0xff, 0x80, 0xc3, 0x04, 0x92,
+    0x2c, 0xb8, 0x2b, 0x61, 0x5f, 0xc2, 0x00, 0x03, 0x31, 0x04, 0x32, 0x05,
+    0x34, 0x06, 0x15, 0x07, 0x11, 0x08, 0x70, 0x0a, 0x52, 0x0c, 0x33, 0x0e,
+    0x32, 0x10, 0x16, 0x11, 0xf5, 0x13, 0xd6, 0x16, 0x57, 0x08, 0x10, 0x00,
+    0x14, 0x40, 0x1c, 0x58, 0x3c, 0x68, 0x5a, 0x88, 0x69, 0xa0, 0x86, 0xa8,
+    0xa8, 0xd0, 0x91, 0x00, 0x01, 0xc6, 0x03, 0x85, 0x04, 0x26, 0x05, 0x06,
+    0x86, 0xc6, 0x07, 0xa7, 0x08, 0x97, 0x0a, 0x9b, 0x0e, 0x80, 0x80, 0x46,
+    0x80, 0x80, 0x80, 0x34, 0xe4, 0x55, 0x80, 0x4d, 0xd2, 0x80, 0x80, 0x4f,
+    0x80, 0x80, 0x80, 0x5c, 0x96, 0x62, 0x80, 0x5a, 0x87, 0xa7, 0x80, 0x80,
+    0x51, 0x80, 0x80, 0x80, 0x61, 0x9f, 0x67, 0x80, 0x60, 0x8d, 0x1c, 0x8f,
+    0x7c, 0x00, 0x97, 0x2e, 0x00, 0xd9, 0xb5, 0x6c, 0x8c, 0x0a, 0x9f, 0x53,
+    0xd8, 0xee, 0x54, 0x62, 0xa3, 0x07, 0x13, 0x89, 0x77, 0xa1, 0x31, 0xba,
+    0xe7, 0xb8, 0x0d, 0xbe, 0xb5, 0x04, 0x56, 0x85, 0x2d, 0x74, 0xbc, 0x1a,
+    0xa9, 0x5b, 0x08, 0xe9, 0x69, 0x11, 0xf6, 0xa3, 0x4e, 0x9f, 0xda, 0xba,
+    0xb8, 0x05, 0x3d, 0x93, 0xc7, 0x0f, 0x02, 0x60, 0x0e, 0xcf, 0x36, 0x25,
+    0x09, 0xfc, 0x63, 0xf3, 0x5a, 0xb1, 0x41, 0xb5, 0xc4, 0x72, 0x4d, 0x28,
+    0xd1, 0x77, 0x17, 0x4a, 0x15, 0x42, 0xfd, 0xc3, 0xed, 0x19, 0xdf, 0xb0,
+    0x10, 0x6b, 0x4f, 0xee, 0x2b, 0x67, 0xea, 0xe0, 0xb9, 0xaa, 0x56, 0x90};
+
+// A 64x160 8-bit 4:2:0 still picture encoded by libaom 3.6.0 with
+// --end-usage=q --cq-level=40 --cpu-used=3 --enable-restoration=1, with
+// deblocking, CDEF and loop restoration all in use. Its 160 rows make three
+// 64-row post filter bands.
+constexpr uint8_t kPostFilterBandFrame[] = {
+    0x12, 0x00, 0x0a, 0x0a, 0x10, 0x00, 0x00, 0x02, 0xbf, 0xf3, 0xe6, 0xd7,
+    0xcc, 0x02, 0x32, 0xc0, 0x04, 0x10, 0x00, 0xa8, 0x00, 0x3c, 0x90, 0x00,
+    0x14, 0x71, 0x14, 0x14, 0xe0, 0x51, 0xeb, 0x0c, 0xbe, 0xe4, 0xd3, 0x7d,
+    0x33, 0x8c, 0x31, 0x1a, 0x19, 0x9d, 0x80, 0x8e, 0xa4, 0x13, 0xdc, 0xb5,
+    0x10, 0xc2, 0xd8, 0xd9, 0xd1, 0xc2, 0x90, 0xca, 0x53, 0xc7, 0x87, 0xf4,
+    0x13, 0x35, 0x44, 0x1c, 0xc8, 0xce, 0x10, 0xc0, 0xa0, 0x4b, 0x9c, 0xc0,
+    0xcb, 0x25, 0xe1, 0x00, 0xd2, 0x32, 0xee, 0xb1, 0x92, 0x3f, 0x83, 0x9e,
+    0x73, 0x5b, 0xab, 0xd6, 0x55, 0x4d, 0x26, 0x59, 0x1e, 0xa1, 0x87, 0xac,
+    0x6e, 0x3d, 0x32, 0x36, 0xf1, 0x96, 0x40, 0x6a, 0x93, 0x5d, 0x3f, 0x1d,
+    0x33, 0x73, 0x80, 0x1d, 0xa4, 0xf8, 0x35, 0x09, 0x2d, 0x58, 0x1d, 0xbf,
+    0x50, 0x4c, 0x64, 0x51, 0xdb, 0xb4, 0x42, 0x28, 0x5d, 0xd4, 0x8b, 0x05,
+    0xf9, 0xa8, 0x40, 0xe1, 0xe3, 0xbb, 0xa5, 0x7e, 0x75, 0xd0, 0x6d, 0x45,
+    0x78, 0x90, 0x31, 0xb6, 0xff, 0x4d, 0xd2, 0xe0, 0x0f, 0xde, 0x90, 0x97,
+    0x32, 0xfa, 0x68, 0x36, 0x84, 0xfc, 0x7b, 0x3a, 0xd8, 0xb4, 0xcb, 0xa0,
+    0x99, 0x49, 0xc6, 0x59, 0x9e, 0x3b, 0x0c, 0x32, 0x84, 0xd3, 0x97, 0xb7,
+    0xc0, 0x99, 0xcd, 0xf0, 0x0c, 0x59, 0xbd, 0xd7, 0xf1, 0x0e, 0x57, 0x25,
+    0x17, 0xa2, 0x67, 0xc1, 0xa7, 0xdc, 0x53, 0x88, 0x64, 0x7b, 0xe7, 0x3e,
+    0x78, 0xd0, 0xd0, 0xbd, 0x08, 0x5d, 0x23, 0xd9, 0xc7, 0x8b, 0x8e, 0xc0,
+    0xda, 0x9f, 0x02, 0x72, 0xb5, 0x52, 0xa7, 0x5f, 0xbf, 0x2f, 0x8f, 0x0f,
+    0x49, 0x7e, 0x8a, 0x06, 0x9a, 0xf7, 0xac, 0x7a, 0x53, 0xf3, 0x41, 0x1a,
+    0x68, 0xa6, 0x58, 0xc4, 0x74, 0xf6, 0xba, 0x02, 0x75, 0x10, 0x87, 0xfb,
+    0xd3, 0x18, 0x9f, 0x31, 0x69, 0x69, 0x7d, 0x26, 0x70, 0x01, 0xe0, 0xac,
+    0x89, 0xd4, 0x9a, 0x87, 0x5f, 0x8a, 0x95, 0x38, 0x74, 0x68, 0x54, 0x9b,
+    0xe4, 0x24, 0x49, 0xce, 0x99, 0x81, 0xfc, 0x21, 0x8f, 0xfe, 0xcb, 0x6c,
+    0xea, 0x7a, 0xee, 0x69, 0xcf, 0xa4, 0x16, 0xc4, 0xc3, 0x1e, 0x8f, 0xa4,
+    0xba, 0xd2, 0x88, 0x9a, 0x72, 0xb0, 0x1f, 0x59, 0xef, 0x69, 0x1e, 0x12,
+    0x8b, 0xfb, 0x9a, 0x7a, 0x1c, 0x44, 0xd6, 0x28, 0xef, 0xfd, 0x07, 0xb5,
+    0xe7, 0x4a, 0x29, 0x7d, 0xe2, 0xa3, 0x8d, 0xdb, 0x23, 0xcf, 0xc0, 0x77,
+    0xeb, 0x96, 0xa7, 0x72, 0xb7, 0xa7, 0x6d, 0x1a, 0xd1, 0x45, 0x53, 0x17,
+    0xb4, 0x22, 0xe4, 0x2c, 0xd4, 0xcd, 0xdc, 0xd7, 0x67, 0x4a, 0xbd, 0xb1,
+    0xee, 0x66, 0x34, 0xc2, 0x73, 0x89, 0x8b, 0xac, 0xae, 0xa3, 0xee, 0x8a,
+    0x0c, 0x2d, 0x90, 0x48, 0x4e, 0xcb, 0x0a, 0xdb, 0xbc, 0x0d, 0x25, 0x33,
+    0x05, 0xcd, 0xcb, 0x52, 0x03, 0x97, 0x19, 0x19, 0xb3, 0xd7, 0xe8, 0x3d,
+    0x38, 0xc1, 0x41, 0xb2, 0xfd, 0xa7, 0x56, 0xb3, 0x89, 0xf0, 0xef, 0xf2,
+    0x6e, 0x04, 0x15, 0x08, 0xee, 0xf0, 0x0d, 0x8b, 0xf7, 0x2f, 0x42, 0xef,
+    0x87, 0x49, 0x46, 0x90, 0x95, 0x12, 0xcc, 0xb9, 0xf6, 0xd6, 0xef, 0xef,
+    0xf3, 0x22, 0x55, 0x17, 0xb4, 0x4a, 0x3a, 0xa6, 0x16, 0x05, 0x2d, 0x58,
+    0x14, 0x0a, 0x46, 0xf0, 0xdb, 0x00, 0xd8, 0x18, 0xe4, 0x1d, 0xa7, 0xae,
+    0x01, 0xe8, 0xe0, 0xf6, 0xb2, 0x17, 0x67, 0xa8, 0x00, 0x70, 0x6a, 0x39,
+    0xcf, 0x24, 0xcb, 0x90, 0xee, 0x85, 0xa1, 0x3c, 0xbe, 0x00, 0x00, 0x9a,
+    0xe0, 0x52, 0x87, 0xe7, 0xbd, 0x05, 0x92, 0xd2, 0x8f, 0x29, 0x4b, 0xa2,
+    0x82, 0xfc, 0x7a, 0x5f, 0x56, 0x71, 0xeb, 0xa7, 0x03, 0x8b, 0x54, 0x06,
+    0x12, 0x50, 0x6f, 0xd2, 0x47, 0x6f, 0xba, 0x67, 0x83, 0x52, 0x65, 0x46,
+    0x0f, 0x5d, 0x90, 0x6e, 0x5c, 0xcd, 0xb8, 0x1d, 0x24, 0x67, 0xaa, 0x49,
+    0x8c, 0xac, 0xf9, 0x5b, 0x45, 0xed, 0xa4, 0x27, 0xa3, 0x5e, 0x40, 0xea,
+    0x3e, 0xd5, 0x35, 0xa5, 0xd0, 0xed, 0xba, 0x2d, 0x56, 0x6e, 0x12, 0xe7,
+    0x63, 0x69, 0x59, 0x2f, 0x2a, 0x2c, 0x2a, 0x8b, 0x8b, 0xcb, 0xa1, 0x70,
+    0xea, 0xc2, 0x52, 0x67, 0xc8, 0x52, 0x72, 0xc0, 0xbb, 0x12, 0x3b, 0x7e,
+    0x5d, 0x52, 0xc3, 0xbd, 0xf8, 0xda, 0x91, 0x8b, 0x3a, 0xe7, 0x9c, 0x6b,
+    0x5a, 0x0f, 0xbe, 0xd3, 0x40};
+
+// The same picture encoded with --superres-mode=1 --superres-denominator=16
+// --superres-kf-denominator=16 in addition, so that it is coded 32 pixels
+// wide and upscaled.
+constexpr uint8_t kPostFilterBandSuperResFrame[] = {
+    0x12, 0x00, 0x0a, 0x0a, 0x10, 0x00, 0x00, 0x02, 0xbf, 0xf3, 0xee, 0xd7,
+    0xdc, 0x02, 0x32, 0xf7, 0x04, 0x10, 0x03, 0xca, 0x80, 0x05, 0x55, 0x3c,
+    0xf1, 0x47, 0x1c, 0x1e, 0x40, 0xd1, 0x76, 0xbb, 0x7f, 0xd9, 0xef, 0xf8,
+    0x84, 0x6d, 0x74, 0x36, 0x85, 0x12, 0x98, 0x6f, 0x89, 0xe0, 0xd2, 0x0b,
+    0x94, 0x17, 0xef, 0x41, 0x71, 0x62, 0x29, 0xb4, 0xfa, 0x15, 0xff, 0xc4,
+    0x05, 0x5a, 0xf2, 0xac, 0x55, 0xb4, 0x9d, 0x6c, 0xa0, 0xde, 0xed, 0xe8,
+    0xca, 0x17, 0x1e, 0x1a, 0xc5, 0x99, 0x69, 0x8c, 0xe8, 0xb3, 0xf9, 0x87,
+    0x07, 0x4a, 0x02, 0xa4, 0x05, 0x79, 0x2d, 0x8d, 0x57, 0x38, 0x35, 0xbd,
+    0xef, 0x70, 0x97, 0xd3, 0x44, 0x4d, 0xfd, 0xb8, 0x48, 0x20, 0x28, 0x7f,
+    0x58, 0x2c, 0x34, 0x6f, 0x4d, 0x52, 0x54, 0x8c, 0x6f, 0xc8, 0xe4, 0xdc,
+    0x8d, 0x6b, 0x00, 0xc3, 0x88, 0x21, 0xe1, 0x44, 0x05, 0x9a, 0x89, 0x79,
+    0x12, 0xb6, 0xd4, 0x70, 0x9e, 0xc2, 0x82, 0x4d, 0xdf, 0xc8, 0x55, 0x06,
+    0x1b, 0xf3, 0x4d, 0x66, 0x95, 0xdd, 0x1c, 0x8d, 0xcf, 0x8b, 0xb7, 0xfd,
+    0xf7, 0x76, 0x5b, 0x3a, 0xd1, 0xe2, 0xa0, 0x48, 0x02, 0x47, 0xaa, 0xb1,
+    0x21, 0x49, 0xa1, 0x22, 0x55, 0x59, 0xa8, 0xcc, 0xff, 0x79, 0xc2, 0x23,
+    0xee, 0xac, 0xbf, 0x28, 0x90, 0x27, 0xcf, 0x7a, 0xd9, 0x74, 0x14, 0x35,
+    0x91, 0xc0, 0xa0, 0x83, 0xa6, 0x48, 0xb3, 0xb3, 0x9e, 0x78, 0x81, 0x2c,
+    0xcd, 0x07, 0x4b, 0x35, 0x9d, 0xf2, 0x0e, 0x47, 0xf4, 0x26, 0x95, 0xd1,
+    0xdf, 0xb3, 0x2b, 0x02, 0x56, 0x4b, 0xef, 0x1a, 0xfd, 0xdf, 0xd3, 0xb9,
+    0xc9, 0x56, 0xf2, 0x70, 0xc8, 0x71, 0x1c, 0xa4, 0x2e, 0x26, 0x4b, 0xfe,
+    0x38, 0x90, 0xde, 0x03, 0xc5, 0x9b, 0x94, 0xc8, 0x0f, 0xb9, 0x9c, 0x45,
+    0xb0, 0x13, 0xb1, 0x02, 0xda, 0x61, 0x2a, 0x18, 0x46, 0xe4, 0x8c, 0xf7,
+    0x53, 0x1d, 0xbb, 0xf2, 0x7c, 0x88, 0xc4, 0xf5, 0x32, 0xbb, 0xca, 0xc7,
+    0xde, 0xb4, 0xd9, 0xea, 0x85, 0x1d, 0x8e, 0x47, 0x98, 0xc1, 0xa9, 0x4f,
+    0x28, 0xe7, 0x7b, 0xad, 0x02, 0x7d, 0x82, 0x8e, 0xf0, 0xd1, 0x2b, 0x34,
+    0x28, 0xf0, 0x3a, 0xfb, 0x7f, 0x66, 0x75, 0xa0, 0x3c, 0x02, 0x45, 0xa6,
+    0xc3, 0x12, 0x9f, 0x0a, 0x3f, 0xa4, 0xcf, 0x8f, 0x1e, 0xf4, 0x6f, 0xd3,
+    0xdf, 0x99, 0x6b, 0xa9, 0x7c, 0x86, 0x1a, 0x22, 0x79, 0x03, 0x78, 0x0d,
+    0x05, 0x46, 0x94, 0xd6, 0x5c, 0x10, 0x38, 0x99, 0x4b, 0x1e, 0xcc, 0xe5,
+    0x43, 0x43, 0xd2, 0x80, 0xec, 0x43, 0x41, 0x51, 0x11, 0x33, 0x23, 0xf5,
+    0x88, 0xb9, 0xa7, 0x34, 0xeb, 0x67, 0x54, 0xdc, 0xf4, 0xcd, 0x84, 0xfd,
+    0x97, 0xae, 0x60, 0x4e, 0x73, 0x09, 0xa7, 0xd9, 0xec, 0x6d, 0x0d, 0x97,
+    0x91, 0x4c, 0x61, 0x2f, 0x6c, 0xb0, 0x03, 0xcf, 0x29, 0xb3, 0xe3, 0x17,
+    0xcf, 0x14, 0x9c, 0x96, 0x10, 0xa2, 0xb2, 0xab, 0x54, 0x8c, 0xf8, 0xb7,
+    0xfe, 0xa2, 0x75, 0xfb, 0x35, 0xc0, 0xed, 0x97, 0x8b, 0xcb, 0x39, 0xbe,
+    0x2a, 0x31, 0x16, 0x1c, 0xe3, 0x7a, 0x26, 0x86, 0x15, 0x40, 0x17, 0xb3,
+    0xf0, 0xc0, 0xbf, 0xf9, 0x6b, 0x73, 0xbb, 0x27, 0x01, 0xf1, 0xda, 0x83,
+    0x07, 0x78, 0xc4, 0xf5, 0xa7, 0x00, 0x43, 0xf9, 0xc7, 0xa7, 0xb7, 0x20,
+    0xd6, 0x9b, 0x83, 0xe5, 0xa3, 0x3b, 0xda, 0x8e, 0x28, 0x7c, 0xf0, 0xa6,
+    0x25, 0x33, 0x86, 0xfb, 0xe8, 0xa8, 0x83, 0x59, 0x18, 0x8f, 0x05, 0x26,
+    0xa7, 0x4c, 0x99, 0x71, 0xe2, 0x88, 0xa5, 0x39, 0xf8, 0x49, 0x7f, 0xf5,
+    0x9b, 0xe2, 0x79, 0xfc, 0x30, 0x60, 0x45, 0xd0, 0x36, 0xb0, 0xdf, 0xfd,
+    0xb8, 0x5c, 0x14, 0x0d, 0xa3, 0x1c, 0x1f, 0x31, 0x40, 0x5e, 0xd5, 0x22,
+    0xc0, 0x68, 0x9a, 0x00, 0x5f, 0x5c, 0x6f, 0x49, 0x19, 0x8d, 0xbc, 0x43,
+    0xbc, 0xff, 0x20, 0xa4, 0x20, 0x94, 0xf7, 0xa0, 0x5b, 0x99, 0xd5, 0x23,
+    0xf4, 0x02, 0x47, 0x06, 0x69, 0xe3, 0x65, 0x26, 0xcb, 0xa4, 0x4b, 0xa7,
+    0x3e, 0x1c, 0x5b, 0x86, 0xbe, 0x8b, 0xe5, 0x8a, 0xcc, 0x6a, 0xc1, 0x84,
+    0x8e, 0xf6, 0x59, 0xe4, 0x98, 0xe8, 0x7f, 0x4d, 0x01, 0x7e, 0xfb, 0xa8,
+    0x54, 0x0a, 0xb8, 0x97, 0xd7, 0xd3, 0xee, 0xfe, 0x0c, 0x9d, 0x5a, 0x42,
+    0xdd, 0x5d, 0x12, 0x34, 0xbe, 0xdf, 0x9d, 0x53, 0x46, 0x6d, 0xa5, 0x60,
+    0x66, 0xc2, 0x41, 0x15, 0xbf, 0x56, 0xd9, 0xbd, 0x09, 0xbf, 0x94, 0x3a,
+    0x7c, 0x38, 0xb0, 0x31, 0x0b, 0x1d, 0x72, 0xb1, 0xd1, 0x0a, 0x46, 0x7d,
+    0x4b, 0xcc, 0x79, 0xa6, 0xc2, 0x84, 0x1e, 0xae, 0xf6, 0xee, 0xd3, 0x16,
+    0x7f, 0x72, 0x82, 0x71, 0x8d, 0xbc, 0x8b, 0xb4, 0x61, 0x3d, 0xe9, 0xc0};
+
+// A 128x128 8-bit 4:2:0 still picture with 2x2 tiles, encoded by libaom 3.6.0
+// with --end-usage=q --cq-level=63 --cpu-used=6 --tile-columns=1
+// --tile-rows=1.
+constexpr uint8_t kFourTileFrame[] = {
+    0x12, 0x00, 0x0a, 0x0a, 0x10, 0x00, 0x00, 0x03, 0x37, 0xff, 0xe6, 0xd7,
+    0xc8, 0x02, 0x32, 0xdb, 0x02, 0x10, 0x00, 0xf9, 0xfe, 0x03, 0x0c, 0x18,
+    0x70, 0xb2, 0xe0, 0xa0, 0x00, 0x52, 0xb5, 0x6c, 0x85, 0x8f, 0xc1, 0x23,
+    0x59, 0x92, 0xe2, 0xd8, 0xd0, 0xe5, 0x42, 0x5c, 0x73, 0xdc, 0x3a, 0x69,
+    0x16, 0xe3, 0xb4, 0x00, 0xe0, 0xf6, 0xc3, 0x8a, 0xe7, 0x84, 0xb0, 0x63,
+    0xb8, 0x52, 0xe0, 0xb1, 0xa9, 0xaf, 0x9b, 0xf6, 0x74, 0xd7, 0x9b, 0xca,
+    0x3b, 0x39, 0x76, 0x1d, 0xa8, 0x0b, 0x49, 0xdd, 0x65, 0x6e, 0x0f, 0x69,
+    0x0c, 0xcf, 0xf3, 0x39, 0xa0, 0xf1, 0xd5, 0x94, 0xe2, 0x01, 0xde, 0x02,
+    0xdd, 0xc6, 0x01, 0x84, 0x52, 0x75, 0x28, 0xd2, 0x2d, 0xf8, 0x7c, 0x2a,
+    0x4f, 0x40, 0xc1, 0xa5, 0x80, 0x47, 0xd8, 0x0f, 0x68, 0x60, 0x51, 0x02,
+    0xdd, 0x6d, 0xc0, 0xf4, 0x78, 0xc1, 0xf0, 0xc4, 0xc6, 0x4d, 0xc4, 0x26,
+    0x13, 0xe0, 0xe7, 0xad, 0xf9, 0x24, 0x8d, 0xe1, 0x36, 0xfa, 0xc1, 0x96,
+    0xf8, 0x77, 0x0e, 0x7a, 0x10, 0x1d, 0x3f, 0x34, 0xba, 0x36, 0x35, 0x72,
+    0x1e, 0xf8, 0xb2, 0xbc, 0xdb, 0x5c, 0xfc, 0xbd, 0x3c, 0x65, 0x49, 0xda,
+    0x40, 0x93, 0x03, 0x69, 0x56, 0x75, 0x0e, 0x40, 0x6d, 0x9f, 0xa0, 0x80,
+    0x79, 0x48, 0x29, 0x98, 0x76, 0x68, 0x50, 0xd8, 0x00, 0x8c, 0x01, 0xec,
+    0x66, 0x36, 0xec, 0x26, 0xbc, 0xb8, 0x40, 0x25, 0x3b, 0xfc, 0x3d, 0x1f,
+    0x92, 0x28, 0xc8, 0x3c, 0x94, 0x50, 0x50, 0x72, 0x33, 0x8b, 0xc0, 0xf8,
+    0x6d, 0x51, 0xbc, 0x38, 0x8c, 0xb4, 0x1a, 0xea, 0xcf, 0xe1, 0xef, 0xd8,
+    0x01, 0x7a, 0xb3, 0xef, 0xd6, 0xab, 0xb8, 0x44, 0xa7, 0xb1, 0xd8, 0xd4,
+    0x37, 0x7c, 0x43, 0x7d, 0x2a, 0xbf, 0xd7, 0xe8, 0xbf, 0x09, 0x61, 0x69,
+    0x81, 0x48, 0x0f, 0x2e, 0xce, 0x4c, 0x83, 0x17, 0x2c, 0xf5, 0xdd, 0x6f,
+    0xca, 0x3f, 0xf5, 0x8c, 0xd8, 0x00, 0x8c, 0xb6, 0x86, 0x4e, 0x7b, 0x0a,
+    0xe9, 0x4d, 0x71, 0x03, 0x54, 0x7e, 0xf4, 0xf0, 0x51, 0xcd, 0x39, 0x41,
+    0xa0, 0x32, 0xb2, 0x66, 0x93, 0xea, 0xc1, 0x04, 0x57, 0xac, 0xcb, 0xca,
+    0xf3, 0x9b, 0x46, 0x35, 0xec, 0x10, 0x7b, 0xae, 0x3d, 0xa2, 0x4a, 0xa3,
+    0x4e, 0x17, 0xcc, 0x51, 0x2f, 0xcf, 0x92, 0x5c, 0x0b, 0xd6, 0x78, 0xad,
+    0x64, 0x8f, 0xdf, 0x9a, 0x68, 0x6e, 0x2d, 0x4f, 0x49, 0x8a, 0xc3, 0x93,
+    0x6d, 0x89, 0x9f, 0xac, 0xae, 0x42, 0x02, 0x1d, 0xa4, 0x9e, 0x96, 0x18,
+    0x35, 0x37, 0x39, 0xc0, 0x7c, 0xd7, 0x93, 0x7c, 0x45, 0x2b, 0x39, 0xcb,
+    0x21, 0x37, 0x9d, 0xca};
+
+}  // namespace libgav1
+
+#endif  // LIBGAV1_SRC_DECODER_TEST_DATA_H_
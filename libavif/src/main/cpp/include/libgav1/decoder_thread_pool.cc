@@ -0,0 +1,58 @@
+// Copyright 2021 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/gav1/decoder_thread_pool.h"
+
+#include <memory>
+#include <new>
+
+#include "src/utils/threadpool.h"
+
+extern "C" {
+
+Libgav1StatusCode Libgav1DecoderThreadPoolCreate(
+    int threads, Libgav1DecoderThreadPool** thread_pool_out) {
+  std::unique_ptr<libgav1::DecoderThreadPool> cxx_thread_pool(
+      new (std::nothrow) libgav1::DecoderThreadPool());
+  if (cxx_thread_pool == nullptr) return kLibgav1StatusOutOfMemory;
+  const Libgav1StatusCode status = cxx_thread_pool->Init(threads);
+  if (status == kLibgav1StatusOk) {
+    *thread_pool_out =
+        reinterpret_cast<Libgav1DecoderThreadPool*>(cxx_thread_pool.release());
+  }
+  return status;
+}
+
+void Libgav1DecoderThreadPoolDestroy(Libgav1DecoderThreadPool* thread_pool) {
+  auto* cxx_thread_pool =
+      reinterpret_cast<libgav1::DecoderThreadPool*>(thread_pool);
+  delete cxx_thread_pool;
+}
+
+}  // extern "C"
+
+namespace libgav1 {
+
+DecoderThreadPool::DecoderThreadPool() = default;
+
+DecoderThreadPool::~DecoderThreadPool() = default;
+
+StatusCode DecoderThreadPool::Init(int threads) {
+  if (impl_ != nullptr) return kStatusAlready;
+  if (threads <= 0) return kStatusInvalidArgument;
+  impl_ = ThreadPool::Create("libgav1-shared", threads);
+  return (impl_ != nullptr) ? kStatusOk : kStatusOutOfMemory;
+}
+
+}  // namespace libgav1
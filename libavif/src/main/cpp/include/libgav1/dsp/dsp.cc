@@ -77,90 +77,114 @@ dsp::Dsp* GetWritableDspTable(int bitdepth) {
       static dsp::Dsp dsp_10bpp;
       return &dsp_10bpp;
     }
+#endif
+#if LIBGAV1_MAX_BITDEPTH == 12
+    case 12: {
+      static dsp::Dsp dsp_12bpp;
+      return &dsp_12bpp;
+    }
 #endif
   }
   return nullptr;
 }
 
-}  // namespace dsp_internal
-
-namespace dsp {
-
-void DspInit() {
-  static std::once_flag once;
-  std::call_once(once, []() {
-    dsp_internal::DspInit_C();
+void DspInitForCpuFeatures(uint32_t cpu_features) {
+  DspInit_C();
 #if LIBGAV1_ENABLE_SSE4_1 || LIBGAV1_ENABLE_AVX2
-    const uint32_t cpu_features = GetCpuInfo();
 #if LIBGAV1_ENABLE_SSE4_1
-    if ((cpu_features & kSSE4_1) != 0) {
-      AverageBlendInit_SSE4_1();
-      CdefInit_SSE4_1();
-      ConvolveInit_SSE4_1();
-      DistanceWeightedBlendInit_SSE4_1();
-      FilmGrainInit_SSE4_1();
-      IntraEdgeInit_SSE4_1();
-      IntraPredCflInit_SSE4_1();
-      IntraPredDirectionalInit_SSE4_1();
-      IntraPredFilterInit_SSE4_1();
-      IntraPredInit_SSE4_1();
-      IntraPredCflInit_SSE4_1();
-      IntraPredSmoothInit_SSE4_1();
-      InverseTransformInit_SSE4_1();
-      LoopFilterInit_SSE4_1();
-      LoopRestorationInit_SSE4_1();
-      MaskBlendInit_SSE4_1();
-      MotionFieldProjectionInit_SSE4_1();
-      MotionVectorSearchInit_SSE4_1();
-      ObmcInit_SSE4_1();
-      SuperResInit_SSE4_1();
-      WarpInit_SSE4_1();
-      WeightMaskInit_SSE4_1();
+  if ((cpu_features & kSSE4_1) != 0) {
+    dsp::AverageBlendInit_SSE4_1();
+    dsp::CdefInit_SSE4_1();
+    dsp::ConvolveInit_SSE4_1();
+    dsp::DistanceWeightedBlendInit_SSE4_1();
+    dsp::FilmGrainInit_SSE4_1();
+    dsp::IntraEdgeInit_SSE4_1();
+    dsp::IntraPredCflInit_SSE4_1();
+    dsp::IntraPredDirectionalInit_SSE4_1();
+    dsp::IntraPredFilterInit_SSE4_1();
+    dsp::IntraPredInit_SSE4_1();
+    dsp::IntraPredCflInit_SSE4_1();
+    dsp::IntraPredSmoothInit_SSE4_1();
+    dsp::InverseTransformInit_SSE4_1();
+    dsp::LoopFilterInit_SSE4_1();
+    dsp::LoopRestorationInit_SSE4_1();
+    dsp::MaskBlendInit_SSE4_1();
+    dsp::MotionFieldProjectionInit_SSE4_1();
+    dsp::MotionVectorSearchInit_SSE4_1();
+    dsp::ObmcInit_SSE4_1();
+    dsp::SuperResInit_SSE4_1();
+    dsp::WarpInit_SSE4_1();
+    dsp::WeightMaskInit_SSE4_1();
 #if LIBGAV1_MAX_BITDEPTH >= 10
-      LoopRestorationInit10bpp_SSE4_1();
+    dsp::ConvolveInit10bpp_SSE4_1();
+    dsp::LoopRestorationInit10bpp_SSE4_1();
 #endif  // LIBGAV1_MAX_BITDEPTH >= 10
-    }
+  }
 #endif  // LIBGAV1_ENABLE_SSE4_1
 #if LIBGAV1_ENABLE_AVX2
-    if ((cpu_features & kAVX2) != 0) {
-      CdefInit_AVX2();
-      ConvolveInit_AVX2();
-      LoopRestorationInit_AVX2();
+  if ((cpu_features & kAVX2) != 0) {
+    dsp::CdefInit_AVX2();
+    dsp::ConvolveInit_AVX2();
+    dsp::IntraEdgeInit_AVX2();
+    dsp::InverseTransformInit_AVX2();
+    dsp::LoopFilterInit_AVX2();
+    dsp::LoopRestorationInit_AVX2();
 #if LIBGAV1_MAX_BITDEPTH >= 10
-      LoopRestorationInit10bpp_AVX2();
+    dsp::ConvolveInit10bpp_AVX2();
+    dsp::LoopRestorationInit10bpp_AVX2();
 #endif  // LIBGAV1_MAX_BITDEPTH >= 10
+#if LIBGAV1_ENABLE_AVX512
+    // These fall back to the AVX2 functions registered above.
+    if ((cpu_features & kAVX512) != 0) {
+      dsp::CdefInit_AVX512();
+      dsp::ConvolveInit_AVX512();
+      dsp::InverseTransformInit_AVX512();
+      dsp::LoopRestorationInit_AVX512();
     }
+#endif  // LIBGAV1_ENABLE_AVX512
+  }
 #endif  // LIBGAV1_ENABLE_AVX2
+#else
+  static_cast<void>(cpu_features);
 #endif  // LIBGAV1_ENABLE_SSE4_1 || LIBGAV1_ENABLE_AVX2
 #if LIBGAV1_ENABLE_NEON
-    AverageBlendInit_NEON();
-    CdefInit_NEON();
-    ConvolveInit_NEON();
-    DistanceWeightedBlendInit_NEON();
-    FilmGrainInit_NEON();
-    IntraEdgeInit_NEON();
-    IntraPredCflInit_NEON();
-    IntraPredDirectionalInit_NEON();
-    IntraPredFilterInit_NEON();
-    IntraPredInit_NEON();
-    IntraPredSmoothInit_NEON();
-    InverseTransformInit_NEON();
-    LoopFilterInit_NEON();
-    LoopRestorationInit_NEON();
-    MaskBlendInit_NEON();
-    MotionFieldProjectionInit_NEON();
-    MotionVectorSearchInit_NEON();
-    ObmcInit_NEON();
-    SuperResInit_NEON();
-    WarpInit_NEON();
-    WeightMaskInit_NEON();
+  dsp::AverageBlendInit_NEON();
+  dsp::CdefInit_NEON();
+  dsp::ConvolveInit_NEON();
+  dsp::DistanceWeightedBlendInit_NEON();
+  dsp::FilmGrainInit_NEON();
+  dsp::IntraEdgeInit_NEON();
+  dsp::IntraPredCflInit_NEON();
+  dsp::IntraPredDirectionalInit_NEON();
+  dsp::IntraPredFilterInit_NEON();
+  dsp::IntraPredInit_NEON();
+  dsp::IntraPredSmoothInit_NEON();
+  dsp::InverseTransformInit_NEON();
+  dsp::LoopFilterInit_NEON();
+  dsp::LoopRestorationInit_NEON();
+  dsp::MaskBlendInit_NEON();
+  dsp::MotionFieldProjectionInit_NEON();
+  dsp::MotionVectorSearchInit_NEON();
+  dsp::ObmcInit_NEON();
+  dsp::SuperResInit_NEON();
+  dsp::WarpInit_NEON();
+  dsp::WeightMaskInit_NEON();
 #if LIBGAV1_MAX_BITDEPTH >= 10
-    ConvolveInit10bpp_NEON();
-    InverseTransformInit10bpp_NEON();
-    LoopRestorationInit10bpp_NEON();
+  dsp::ConvolveInit10bpp_NEON();
+  dsp::InverseTransformInit10bpp_NEON();
+  dsp::LoopRestorationInit10bpp_NEON();
 #endif  // LIBGAV1_MAX_BITDEPTH >= 10
 #endif  // LIBGAV1_ENABLE_NEON
-  });
+}
+
+}  // namespace dsp_internal
+
+namespace dsp {
+
+void DspInit() {
+  static std::once_flag once;
+  std::call_once(once,
+                 []() { dsp_internal::DspInitForCpuFeatures(GetCpuInfo()); });
 }
 
 const Dsp* GetDspTable(int bitdepth) {
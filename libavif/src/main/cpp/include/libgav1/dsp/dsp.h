@@ -344,6 +344,13 @@ using LoopFilterFunc = void (*)(void* dst, ptrdiff_t stride, int outer_thresh,
 using LoopFilterFuncs =
     LoopFilterFunc[kNumLoopFilterSizes][kNumLoopFilterTypes];
 
+// Paired loop filter functions use the LoopFilterFunc signature but filter two
+// adjacent 4-pixel edge segments, 8 pixels along the edge, with the same
+// thresholds. For kLoopFilterTypeVertical the second segment is 4 rows below
+// |dst|; for kLoopFilterTypeHorizontal it is 4 pixels to the right. These
+// entries are optional: a nullptr means the caller should make two
+// |loop_filters| calls.
+
 // Cdef direction function signature. Section 7.15.2.
 // |src| is a pointer to the source block. Pixel size is determined by bitdepth
 // with |stride| given in bytes. |direction| and |variance| are output
@@ -887,6 +894,7 @@ struct Dsp {
   IntraPredictorFuncs intra_predictors;
   InverseTransformAddFuncs inverse_transforms;
   LoopFilterFuncs loop_filters;
+  LoopFilterFuncs loop_filters_x2;
   LoopRestorationFuncs loop_restorations;
   MaskBlendFuncs mask_blend;
   MotionFieldProjectionKernelFunc motion_field_projection_kernel;
@@ -941,12 +949,24 @@ namespace dsp_internal {
 #define DSP_ENABLED_10BPP_AVX2(func)   \
   (LIBGAV1_ENABLE_ALL_DSP_FUNCTIONS || \
    LIBGAV1_Dsp10bpp_##func == LIBGAV1_CPU_AVX2)
+#define DSP_ENABLED_12BPP_AVX2(func)   \
+  (LIBGAV1_ENABLE_ALL_DSP_FUNCTIONS || \
+   LIBGAV1_Dsp12bpp_##func == LIBGAV1_CPU_AVX2)
+// The AVX-512 functions refine the AVX2 ones. They replace them at runtime on
+// processors with AVX-512 BW and VL and fall back to them for the block sizes
+// they do not handle, so they are enabled wherever the AVX2 version is.
+#define DSP_ENABLED_8BPP_AVX512(func) DSP_ENABLED_8BPP_AVX2(func)
+#define DSP_ENABLED_10BPP_AVX512(func) DSP_ENABLED_10BPP_AVX2(func)
+#define DSP_ENABLED_12BPP_AVX512(func) DSP_ENABLED_12BPP_AVX2(func)
 #define DSP_ENABLED_8BPP_SSE4_1(func)  \
   (LIBGAV1_ENABLE_ALL_DSP_FUNCTIONS || \
    LIBGAV1_Dsp8bpp_##func == LIBGAV1_CPU_SSE4_1)
 #define DSP_ENABLED_10BPP_SSE4_1(func) \
   (LIBGAV1_ENABLE_ALL_DSP_FUNCTIONS || \
    LIBGAV1_Dsp10bpp_##func == LIBGAV1_CPU_SSE4_1)
+#define DSP_ENABLED_12BPP_SSE4_1(func) \
+  (LIBGAV1_ENABLE_ALL_DSP_FUNCTIONS || \
+   LIBGAV1_Dsp12bpp_##func == LIBGAV1_CPU_SSE4_1)
 
 // Initializes C-only function pointers. Note some entries may be set to
 // nullptr if LIBGAV1_ENABLE_ALL_DSP_FUNCTIONS is not defined. This is meant
@@ -957,6 +977,13 @@ void DspInit_C();
 // exist. This version is meant for use by test or dsp/*Init() functions only.
 dsp::Dsp* GetWritableDspTable(int bitdepth);
 
+// Initializes the function pointers with the C functions followed by the
+// SIMD functions for |cpu_features| (a bit-wise OR of CpuFeatures), as
+// DspInit() does with GetCpuInfo(). NEON functions are always used when
+// built. This is meant for use in tests and benchmarks that compare the
+// instruction sets in one process, it is not thread-safe.
+void DspInitForCpuFeatures(uint32_t cpu_features);
+
 }  // namespace dsp_internal
 }  // namespace libgav1
 
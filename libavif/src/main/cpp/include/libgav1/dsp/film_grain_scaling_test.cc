@@ -0,0 +1,195 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Checks the film grain scaling lookup table and the luma noise blending of
+// the registered dsp functions against a direct transcription of the scaling
+// function in section 7.18.3.5 of the AV1 specification, at every bitdepth.
+// Unlike film_grain_test.cc this needs no test vectors.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/dsp/constants.h"
+#include "src/dsp/dsp.h"
+#include "src/dsp/film_grain_common.h"
+#include "src/utils/array_2d.h"
+#include "src/utils/common.h"
+#include "src/utils/constants.h"
+
+namespace libgav1 {
+namespace dsp {
+namespace {
+
+constexpr int kWidth = 64;
+constexpr int kHeight = 64;
+// The most points a scaling function can have (num_y_points).
+constexpr int kMaxScalingPoints = 14;
+
+struct ScalingPoints {
+  int num_points;
+  uint8_t value[kMaxScalingPoints];
+  uint8_t scaling[kMaxScalingPoints];
+};
+
+// ScalingLut[] of the specification: one entry per 8-bit value.
+void BuildSpecScalingLut(const ScalingPoints& points, int scaling_lut[256]) {
+  for (int x = 0; x < 256; ++x) {
+    if (points.num_points == 0) {
+      scaling_lut[x] = 0;
+    } else if (x < points.value[0]) {
+      scaling_lut[x] = points.scaling[0];
+    } else if (x >= points.value[points.num_points - 1]) {
+      scaling_lut[x] = points.scaling[points.num_points - 1];
+    } else {
+      int i = 0;
+      while (x >= points.value[i + 1]) ++i;
+      const int delta_y = points.scaling[i + 1] - points.scaling[i];
+      const int delta_x = points.value[i + 1] - points.value[i];
+      const int delta = delta_y * ((65536 + (delta_x >> 1)) / delta_x);
+      scaling_lut[x] =
+          points.scaling[i] + (((x - points.value[i]) * delta + 32768) >> 16);
+    }
+  }
+}
+
+// scale_lut() of the specification.
+int SpecScaleLut(const int scaling_lut[256], int bitdepth, int index) {
+  const int shift = bitdepth - 8;
+  const int x = index >> shift;
+  const int remainder = index - (x << shift);
+  if (bitdepth == 8 || x == 255) return scaling_lut[x];
+  const int start = scaling_lut[x];
+  const int end = scaling_lut[x + 1];
+  return start + RightShiftWithRounding((end - start) * remainder, shift);
+}
+
+ScalingPoints RandomPoints(std::mt19937* rng) {
+  ScalingPoints points = {};
+  points.num_points =
+      std::uniform_int_distribution<int>(1, kMaxScalingPoints)(*rng);
+  // Strictly increasing point values, as the specification requires.
+  std::vector<int> values(256);
+  for (int i = 0; i < 256; ++i) values[i] = i;
+  std::shuffle(values.begin(), values.end(), *rng);
+  std::sort(values.begin(), values.begin() + points.num_points);
+  for (int i = 0; i < points.num_points; ++i) {
+    points.value[i] = values[i];
+    points.scaling[i] = std::uniform_int_distribution<int>(0, 255)(*rng);
+  }
+  return points;
+}
+
+template <int bitdepth>
+void TestLumaBlend(int seed) {
+  using Pixel = typename std::conditional<bitdepth == 8, uint8_t,
+                                          uint16_t>::type;
+  using GrainType =
+      typename std::conditional<bitdepth == 8, int8_t, int16_t>::type;
+  const Dsp* const dsp = GetDspTable(bitdepth);
+  ASSERT_NE(dsp, nullptr);
+  ASSERT_NE(dsp->film_grain.initialize_scaling_lut, nullptr);
+  ASSERT_NE(dsp->film_grain.blend_noise_luma, nullptr);
+
+  // The length FilmGrain<bitdepth> allocates: only 10-bit tables hold an
+  // entry per pixel value, the others are indexed by 8-bit value.
+  constexpr int kScalingLutLength =
+      (bitdepth == kBitdepth10)
+          ? (kScalingLookupTableSize + kScalingLookupTablePadding) << 2
+          : kScalingLookupTableSize + kScalingLookupTablePadding;
+  constexpr int kMaxPixel = (1 << bitdepth) - 1;
+  constexpr int kGrainMin = -(128 << (bitdepth - 8));
+  constexpr int kGrainMax = (128 << (bitdepth - 8)) - 1;
+
+  std::mt19937 rng(seed);
+  for (int iteration = 0; iteration < 20; ++iteration) {
+    const ScalingPoints points = RandomPoints(&rng);
+    int16_t scaling_lut[kScalingLutLength];
+    dsp->film_grain.initialize_scaling_lut(points.num_points, points.value,
+                                           points.scaling, scaling_lut,
+                                           kScalingLutLength);
+    int spec_scaling_lut[256];
+    BuildSpecScalingLut(points, spec_scaling_lut);
+
+    Array2D<GrainType> noise_image[kMaxPlanes];
+    ASSERT_TRUE(noise_image[kPlaneY].Reset(kHeight, kWidth,
+                                           /*zero_initialize=*/false));
+    std::uniform_int_distribution<int> grain(kGrainMin, kGrainMax);
+    std::uniform_int_distribution<int> pixel(0, kMaxPixel);
+    std::vector<Pixel> source(kWidth * kHeight);
+    for (int y = 0; y < kHeight; ++y) {
+      for (int x = 0; x < kWidth; ++x) {
+        noise_image[kPlaneY][y][x] = grain(rng);
+        // Cover every pixel value, in random order across the iterations.
+        source[y * kWidth + x] = (iteration & 1)
+                                     ? pixel(rng)
+                                     : ((y * kWidth + x) * 67 + iteration) &
+                                           kMaxPixel;
+      }
+    }
+    const bool clip_to_restricted_range = (iteration & 2) != 0;
+    const int min_value = clip_to_restricted_range ? 16 << (bitdepth - 8) : 0;
+    const int max_luma =
+        clip_to_restricted_range ? 235 << (bitdepth - 8) : kMaxPixel;
+    const int scaling_shift = 8 + (iteration & 3);
+    std::vector<Pixel> dest(kWidth * kHeight);
+    dsp->film_grain.blend_noise_luma(
+        noise_image, min_value, max_luma, scaling_shift, kWidth, kHeight,
+        /*start_height=*/0, scaling_lut, source.data(), kWidth * sizeof(Pixel),
+        dest.data(), kWidth * sizeof(Pixel));
+
+    for (int y = 0; y < kHeight; ++y) {
+      for (int x = 0; x < kWidth; ++x) {
+        const int orig = source[y * kWidth + x];
+        const int noise = RightShiftWithRounding(
+            SpecScaleLut(spec_scaling_lut, bitdepth, orig) *
+                noise_image[kPlaneY][y][x],
+            scaling_shift);
+        const int expected = Clip3(orig + noise, min_value, max_luma);
+        ASSERT_EQ(dest[y * kWidth + x], expected)
+            << "bitdepth " << bitdepth << ", iteration " << iteration
+            << ", pixel " << orig << ", (" << x << ", " << y << ")";
+      }
+    }
+  }
+}
+
+class FilmGrainScalingTest : public testing::Test {
+ protected:
+  void SetUp() override { DspInit(); }
+};
+
+TEST_F(FilmGrainScalingTest, LumaBlendMatchesSpec8bpp) {
+  TestLumaBlend<kBitdepth8>(8);
+}
+
+#if LIBGAV1_MAX_BITDEPTH >= 10
+TEST_F(FilmGrainScalingTest, LumaBlendMatchesSpec10bpp) {
+  TestLumaBlend<kBitdepth10>(10);
+}
+#endif
+
+#if LIBGAV1_MAX_BITDEPTH == 12
+TEST_F(FilmGrainScalingTest, LumaBlendMatchesSpec12bpp) {
+  TestLumaBlend<kBitdepth12>(12);
+}
+#endif
+
+}  // namespace
+}  // namespace dsp
+}  // namespace libgav1
@@ -17,8 +17,6 @@ if(LIBGAV1_SRC_DSP_LIBGAV1_DSP_CMAKE_)
 endif() # LIBGAV1_SRC_DSP_LIBGAV1_DSP_CMAKE_
 set(LIBGAV1_SRC_DSP_LIBGAV1_DSP_CMAKE_ 1)
 
-include("${libgav1_root}/cmake/libgav1_targets.cmake")
-
 list(APPEND libgav1_dsp_sources
             "${libgav1_source}/dsp/average_blend.cc"
             "${libgav1_source}/dsp/average_blend.h"
@@ -78,12 +76,33 @@ list(APPEND libgav1_dsp_sources_avx2
             ${libgav1_dsp_sources_avx2}
             "${libgav1_source}/dsp/x86/cdef_avx2.cc"
             "${libgav1_source}/dsp/x86/cdef_avx2.h"
+            "${libgav1_source}/dsp/x86/convolve_10bit_avx2.cc"
             "${libgav1_source}/dsp/x86/convolve_avx2.cc"
             "${libgav1_source}/dsp/x86/convolve_avx2.h"
+            "${libgav1_source}/dsp/x86/intra_edge_avx2.cc"
+            "${libgav1_source}/dsp/x86/intra_edge_avx2.h"
+            "${libgav1_source}/dsp/x86/inverse_transform_avx2.cc"
+            "${libgav1_source}/dsp/x86/inverse_transform_avx2.h"
+            "${libgav1_source}/dsp/x86/inverse_transform_avx2.inc"
+            "${libgav1_source}/dsp/x86/loop_filter_avx2.cc"
+            "${libgav1_source}/dsp/x86/loop_filter_avx2.h"
             "${libgav1_source}/dsp/x86/loop_restoration_10bit_avx2.cc"
             "${libgav1_source}/dsp/x86/loop_restoration_avx2.cc"
             "${libgav1_source}/dsp/x86/loop_restoration_avx2.h")
 
+list(APPEND libgav1_dsp_sources_avx512
+            ${libgav1_dsp_sources_avx512}
+            "${libgav1_source}/dsp/x86/cdef_avx512.cc"
+            "${libgav1_source}/dsp/x86/cdef_avx512.h"
+            "${libgav1_source}/dsp/x86/common_avx512.h"
+            "${libgav1_source}/dsp/x86/common_avx512.inc"
+            "${libgav1_source}/dsp/x86/convolve_avx512.cc"
+            "${libgav1_source}/dsp/x86/convolve_avx512.h"
+            "${libgav1_source}/dsp/x86/inverse_transform_avx512.cc"
+            "${libgav1_source}/dsp/x86/inverse_transform_avx512.h"
+            "${libgav1_source}/dsp/x86/loop_restoration_avx512.cc"
+            "${libgav1_source}/dsp/x86/loop_restoration_avx512.h")
+
 list(APPEND libgav1_dsp_sources_neon
             ${libgav1_dsp_sources_neon}
             "${libgav1_source}/dsp/arm/average_blend_neon.cc"
@@ -140,6 +159,8 @@ list(APPEND libgav1_dsp_sources_sse4
             "${libgav1_source}/dsp/x86/common_sse4.h"
             "${libgav1_source}/dsp/x86/cdef_sse4.cc"
             "${libgav1_source}/dsp/x86/cdef_sse4.h"
+            "${libgav1_source}/dsp/x86/convolve_10bit_sse4.cc"
+            "${libgav1_source}/dsp/x86/convolve_10bit_sse4.inc"
             "${libgav1_source}/dsp/x86/convolve_sse4.cc"
             "${libgav1_source}/dsp/x86/convolve_sse4.h"
             "${libgav1_source}/dsp/x86/convolve_sse4.inc"
@@ -186,6 +207,7 @@ macro(libgav1_add_dsp_targets)
   unset(dsp_sources)
   list(APPEND dsp_sources ${libgav1_dsp_sources}
               ${libgav1_dsp_sources_neon}
+              ${libgav1_dsp_sources_avx512}
               ${libgav1_dsp_sources_avx2}
               ${libgav1_dsp_sources_sse4})
 
@@ -0,0 +1,417 @@
+// Copyright 2021 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/dsp/cdef.h"
+#include "src/utils/cpu.h"
+
+#if LIBGAV1_TARGETING_AVX512
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "src/dsp/constants.h"
+#include "src/dsp/dsp.h"
+#include "src/dsp/x86/common_avx512.h"
+#include "src/utils/common.h"
+#include "src/utils/constants.h"
+
+namespace libgav1 {
+namespace dsp {
+namespace {
+
+const int8_t (*const kCdefDirections)[2][2] = kCdefDirectionsPadded + 2;
+
+// The AVX2 version filters one row of 8 (or two rows of 4) per iteration, with
+// the two taps of each direction in separate lanes. Here each 128-bit lane
+// holds a different row pair, so 4 rows of 8 or 8 rows of 4 are filtered at
+// once and the taps are summed without folding the lanes.
+//
+// Lanes 0 and 1 are loaded from |src| and |src| + |step|, lanes 2 and 3 from
+// |src| + |upper| and |src| + |upper| + |step|. A 4x4 block sets |upper| to 0
+// and so filters its rows twice.
+template <int width>
+inline __m512i LoadLanes(const uint16_t* LIBGAV1_RESTRICT const src,
+                         const ptrdiff_t stride, const ptrdiff_t step,
+                         const ptrdiff_t upper) {
+  if (width == 8) {
+    return SetrM128i(LoadUnaligned16(src), LoadUnaligned16(src + step),
+                     LoadUnaligned16(src + upper),
+                     LoadUnaligned16(src + upper + step));
+  }
+  const auto load_row_pair = [stride](const uint16_t* const p) {
+    return LoadHi8(LoadLo8(p), p + stride);
+  };
+  return SetrM128i(load_row_pair(src), load_row_pair(src + step),
+                   load_row_pair(src + upper),
+                   load_row_pair(src + upper + step));
+}
+
+// Loads the 4 values of |direction|, see LoadDirection() in cdef_avx2.cc.
+template <int width>
+inline void LoadDirection(const uint16_t* LIBGAV1_RESTRICT const src,
+                          const ptrdiff_t stride, const ptrdiff_t step,
+                          const ptrdiff_t upper, __m512i* output,
+                          const int direction) {
+  const int y_0 = kCdefDirections[direction][0][0];
+  const int x_0 = kCdefDirections[direction][0][1];
+  const int y_1 = kCdefDirections[direction][1][0];
+  const int x_1 = kCdefDirections[direction][1][1];
+  output[0] = LoadLanes<width>(src - y_0 * stride - x_0, stride, step, upper);
+  output[1] = LoadLanes<width>(src + y_0 * stride + x_0, stride, step, upper);
+  output[2] = LoadLanes<width>(src - y_1 * stride - x_1, stride, step, upper);
+  output[3] = LoadLanes<width>(src + y_1 * stride + x_1, stride, step, upper);
+}
+
+inline __m512i Constrain(const __m512i& pixel, const __m512i& reference,
+                         const __m128i& damping, const __m512i& threshold) {
+  const __m512i diff = _mm512_sub_epi16(pixel, reference);
+  const __m512i abs_diff = _mm512_abs_epi16(diff);
+  // sign(diff) * Clip3(threshold - (std::abs(diff) >> damping),
+  //                    0, std::abs(diff))
+  const __m512i shifted_diff = _mm512_srl_epi16(abs_diff, damping);
+  // If pixel == kCdefLargeValue(0x4000), shifted_diff will always be larger
+  // than threshold. Subtract using saturation will return 0 when pixel ==
+  // kCdefLargeValue.
+  static_assert(kCdefLargeValue == 0x4000, "Invalid kCdefLargeValue");
+  const __m512i thresh_minus_shifted_diff =
+      _mm512_subs_epu16(threshold, shifted_diff);
+  const __m512i clamp_abs_diff =
+      _mm512_min_epi16(thresh_minus_shifted_diff, abs_diff);
+  // Restore the sign. There is no 512-bit form of _mm256_sign_epi16().
+  return _mm512_mask_sub_epi16(clamp_abs_diff, _mm512_movepi16_mask(diff),
+                               _mm512_setzero_si512(), clamp_abs_diff);
+}
+
+inline __m512i ApplyConstrainAndTap(const __m512i& pixel, const __m512i& val,
+                                    const __m512i& tap, const __m128i& damping,
+                                    const __m512i& threshold) {
+  const __m512i constrained = Constrain(val, pixel, damping, threshold);
+  return _mm512_mullo_epi16(constrained, tap);
+}
+
+// See GetMax() in cdef_avx2.cc.
+template <typename Pixel>
+inline __m512i GetMax(const __m512i* const values, const int num_values,
+                      const __m512i max, const __m512i cdef_large_value_mask) {
+  if (sizeof(Pixel) == 1) {
+    __m512i max_values = values[0];
+    for (int i = 1; i < num_values; ++i) {
+      max_values = _mm512_max_epu8(max_values, values[i]);
+    }
+    return _mm512_max_epu16(
+        max, _mm512_and_si512(max_values, cdef_large_value_mask));
+  }
+  __m512i max_values = max;
+  for (int i = 0; i < num_values; ++i) {
+    max_values = _mm512_max_epu16(
+        max_values, _mm512_and_si512(values[i], cdef_large_value_mask));
+  }
+  return max_values;
+}
+
+inline __m512i GetMin(const __m512i* const values, const int num_values,
+                      const __m512i min) {
+  __m512i min_values = min;
+  for (int i = 0; i < num_values; ++i) {
+    min_values = _mm512_min_epu16(min_values, values[i]);
+  }
+  return min_values;
+}
+
+// Stores the |num_rows| rows of 8 held in |sum|.
+inline void StoreRows8(uint8_t* dst, const ptrdiff_t dst_stride,
+                       const __m512i sum, const int num_rows) {
+  const __m256i result = _mm512_cvtusepi16_epi8(
+      _mm512_max_epi16(sum, _mm512_setzero_si512()));
+  const __m128i result_lo = _mm256_castsi256_si128(result);
+  const __m128i result_hi = _mm256_extracti128_si256(result, 1);
+  StoreLo8(dst, result_lo);
+  StoreHi8(dst + dst_stride, result_lo);
+  if (num_rows == 2) return;
+  StoreLo8(dst + 2 * dst_stride, result_hi);
+  StoreHi8(dst + 3 * dst_stride, result_hi);
+}
+
+inline void StoreRows8(uint16_t* dst, const ptrdiff_t dst_stride,
+                       const __m512i sum, const int num_rows) {
+  StoreUnaligned16(dst, _mm512_castsi512_si128(sum));
+  StoreUnaligned16(dst + dst_stride, _mm512_extracti32x4_epi32(sum, 1));
+  if (num_rows == 2) return;
+  StoreUnaligned16(dst + 2 * dst_stride, _mm512_extracti32x4_epi32(sum, 2));
+  StoreUnaligned16(dst + 3 * dst_stride, _mm512_extracti32x4_epi32(sum, 3));
+}
+
+// Stores the |num_rows| rows of 4 held in |sum|.
+inline void StoreRows4(uint8_t* dst, const ptrdiff_t dst_stride,
+                       const __m512i sum, const int num_rows) {
+  const __m256i result = _mm512_cvtusepi16_epi8(
+      _mm512_max_epi16(sum, _mm512_setzero_si512()));
+  for (int i = 0; i < num_rows; i += 4) {
+    const __m128i rows = (i == 0) ? _mm256_castsi256_si128(result)
+                                  : _mm256_extracti128_si256(result, 1);
+    Store4(dst, rows);
+    Store4(dst + dst_stride, _mm_srli_si128(rows, 4));
+    Store4(dst + 2 * dst_stride, _mm_srli_si128(rows, 8));
+    Store4(dst + 3 * dst_stride, _mm_srli_si128(rows, 12));
+    dst += 4 * dst_stride;
+  }
+}
+
+inline void StoreRows4(uint16_t* dst, const ptrdiff_t dst_stride,
+                       const __m512i sum, const int num_rows) {
+  const __m128i rows[4] = {
+      _mm512_castsi512_si128(sum), _mm512_extracti32x4_epi32(sum, 1),
+      _mm512_extracti32x4_epi32(sum, 2), _mm512_extracti32x4_epi32(sum, 3)};
+  for (int i = 0; i < num_rows >> 1; ++i) {
+    StoreLo8(dst, rows[i]);
+    StoreHi8(dst + dst_stride, rows[i]);
+    dst += 2 * dst_stride;
+  }
+}
+
+template <int width, int bitdepth, typename Pixel,
+          bool enable_primary = true, bool enable_secondary = true>
+void CdefFilter_AVX512(const uint16_t* LIBGAV1_RESTRICT src,
+                       const ptrdiff_t src_stride, const int height,
+                       const int primary_strength, const int secondary_strength,
+                       const int damping, const int direction,
+                       void* LIBGAV1_RESTRICT dest,
+                       const ptrdiff_t dest_stride) {
+  static_assert(width == 8 || width == 4, "Invalid CDEF width.");
+  static_assert(enable_primary || enable_secondary, "");
+  assert(height == 4 || height == 8);
+  constexpr bool clipping_required = enable_primary && enable_secondary;
+  auto* dst = static_cast<Pixel*>(dest);
+  const ptrdiff_t dst_stride = dest_stride / sizeof(Pixel);
+  __m128i primary_damping_shift, secondary_damping_shift;
+
+  // See CdefFilter_AVX2() for the ranges of the damping and strengths.
+  if (enable_primary) {
+    primary_damping_shift =
+        _mm_cvtsi32_si128(std::max(0, damping - FloorLog2(primary_strength)));
+  }
+  if (enable_secondary) {
+    secondary_damping_shift = _mm_cvtsi32_si128(
+        std::max(0, damping - FloorLog2(secondary_strength)));
+  }
+  constexpr int coeff_shift = bitdepth - kBitdepth8;
+  const int primary_tap_index = (primary_strength >> coeff_shift) & 1;
+  const __m512i primary_tap_0 =
+      _mm512_set1_epi16(kCdefPrimaryTaps[primary_tap_index][0]);
+  const __m512i primary_tap_1 =
+      _mm512_set1_epi16(kCdefPrimaryTaps[primary_tap_index][1]);
+  const __m512i secondary_tap_0 = _mm512_set1_epi16(kCdefSecondaryTap0);
+  const __m512i secondary_tap_1 = _mm512_set1_epi16(kCdefSecondaryTap1);
+  const __m512i cdef_large_value_mask =
+      _mm512_set1_epi16(static_cast<int16_t>(~kCdefLargeValue));
+  const __m512i primary_threshold = _mm512_set1_epi16(primary_strength);
+  const __m512i secondary_threshold = _mm512_set1_epi16(secondary_strength);
+
+  // Rows of 8 are filtered 4 at a time. Rows of 4 are paired within each lane
+  // and the 4x8 block is filtered in one pass.
+  const ptrdiff_t step = (width == 8) ? src_stride : 2 * src_stride;
+  const ptrdiff_t upper = (width == 8 || height == 8) ? 2 * step : 0;
+  const int rows_per_pass = std::min(height, (width == 8) ? 4 : 8);
+  int y = height;
+  do {
+    const __m512i pixel = LoadLanes<width>(src, src_stride, step, upper);
+    __m512i min = pixel;
+    __m512i max = pixel;
+    __m512i sum;
+
+    if (enable_primary) {
+      // Primary |direction|.
+      __m512i primary_val[4];
+      LoadDirection<width>(src, src_stride, step, upper, primary_val,
+                           direction);
+      if (clipping_required) {
+        min = GetMin(primary_val, 4, min);
+        max = GetMax<Pixel>(primary_val, 4, max, cdef_large_value_mask);
+      }
+
+      sum = ApplyConstrainAndTap(pixel, primary_val[0], primary_tap_0,
+                                 primary_damping_shift, primary_threshold);
+      sum = _mm512_add_epi16(
+          sum, ApplyConstrainAndTap(pixel, primary_val[1], primary_tap_0,
+                                    primary_damping_shift, primary_threshold));
+      sum = _mm512_add_epi16(
+          sum, ApplyConstrainAndTap(pixel, primary_val[2], primary_tap_1,
+                                    primary_damping_shift, primary_threshold));
+      sum = _mm512_add_epi16(
+          sum, ApplyConstrainAndTap(pixel, primary_val[3], primary_tap_1,
+                                    primary_damping_shift, primary_threshold));
+    } else {
+      sum = _mm512_setzero_si512();
+    }
+
+    if (enable_secondary) {
+      // Secondary |direction| values (+/- 2). Clamp |direction|.
+      __m512i secondary_val[8];
+      LoadDirection<width>(src, src_stride, step, upper, secondary_val,
+                           direction + 2);
+      LoadDirection<width>(src, src_stride, step, upper, secondary_val + 4,
+                           direction - 2);
+      if (clipping_required) {
+        min = GetMin(secondary_val, 8, min);
+        max = GetMax<Pixel>(secondary_val, 8, max, cdef_large_value_mask);
+      }
+
+      for (int i = 0; i < 8; i += 4) {
+        sum = _mm512_add_epi16(
+            sum,
+            ApplyConstrainAndTap(pixel, secondary_val[i + 0], secondary_tap_0,
+                                 secondary_damping_shift, secondary_threshold));
+        sum = _mm512_add_epi16(
+            sum,
+            ApplyConstrainAndTap(pixel, secondary_val[i + 1], secondary_tap_0,
+                                 secondary_damping_shift, secondary_threshold));
+        sum = _mm512_add_epi16(
+            sum,
+            ApplyConstrainAndTap(pixel, secondary_val[i + 2], secondary_tap_1,
+                                 secondary_damping_shift, secondary_threshold));
+        sum = _mm512_add_epi16(
+            sum,
+            ApplyConstrainAndTap(pixel, secondary_val[i + 3], secondary_tap_1,
+                                 secondary_damping_shift, secondary_threshold));
+      }
+    }
+
+    // Clip3(pixel + ((8 + sum - (sum < 0)) >> 4), min, max))
+    const __m512i sum_lt_0 = _mm512_srai_epi16(sum, 15);
+    // 8 + sum
+    sum = _mm512_add_epi16(sum, _mm512_set1_epi16(8));
+    // (... - (sum < 0)) >> 4
+    sum = _mm512_add_epi16(sum, sum_lt_0);
+    sum = _mm512_srai_epi16(sum, 4);
+    // pixel + ...
+    sum = _mm512_add_epi16(sum, pixel);
+    if (clipping_required) {
+      // Clip3
+      sum = _mm512_min_epi16(sum, max);
+      sum = _mm512_max_epi16(sum, min);
+    }
+
+    if (width == 8) {
+      StoreRows8(dst, dst_stride, sum, rows_per_pass);
+    } else {
+      StoreRows4(dst, dst_stride, sum, rows_per_pass);
+    }
+    src += rows_per_pass * src_stride;
+    dst += rows_per_pass * dst_stride;
+    y -= rows_per_pass;
+  } while (y != 0);
+}
+
+}  // namespace
+
+namespace low_bitdepth {
+namespace {
+
+void Init8bpp() {
+  Dsp* const dsp = dsp_internal::GetWritableDspTable(kBitdepth8);
+  assert(dsp != nullptr);
+  static_cast<void>(dsp);
+#if DSP_ENABLED_8BPP_AVX512(CdefFilters)
+  dsp->cdef_filters[0][0] = CdefFilter_AVX512<4, kBitdepth8, uint8_t>;
+  dsp->cdef_filters[0][1] =
+      CdefFilter_AVX512<4, kBitdepth8, uint8_t, /*enable_primary=*/true,
+                        /*enable_secondary=*/false>;
+  dsp->cdef_filters[0][2] =
+      CdefFilter_AVX512<4, kBitdepth8, uint8_t, /*enable_primary=*/false>;
+  dsp->cdef_filters[1][0] = CdefFilter_AVX512<8, kBitdepth8, uint8_t>;
+  dsp->cdef_filters[1][1] =
+      CdefFilter_AVX512<8, kBitdepth8, uint8_t, /*enable_primary=*/true,
+                        /*enable_secondary=*/false>;
+  dsp->cdef_filters[1][2] =
+      CdefFilter_AVX512<8, kBitdepth8, uint8_t, /*enable_primary=*/false>;
+#endif
+}
+
+}  // namespace
+}  // namespace low_bitdepth
+
+#if LIBGAV1_MAX_BITDEPTH >= 10
+namespace high_bitdepth {
+namespace {
+
+void Init10bpp() {
+  Dsp* const dsp = dsp_internal::GetWritableDspTable(kBitdepth10);
+  assert(dsp != nullptr);
+  static_cast<void>(dsp);
+#if DSP_ENABLED_10BPP_AVX512(CdefFilters)
+  dsp->cdef_filters[0][0] = CdefFilter_AVX512<4, kBitdepth10, uint16_t>;
+  dsp->cdef_filters[0][1] =
+      CdefFilter_AVX512<4, kBitdepth10, uint16_t, /*enable_primary=*/true,
+                        /*enable_secondary=*/false>;
+  dsp->cdef_filters[0][2] =
+      CdefFilter_AVX512<4, kBitdepth10, uint16_t, /*enable_primary=*/false>;
+  dsp->cdef_filters[1][0] = CdefFilter_AVX512<8, kBitdepth10, uint16_t>;
+  dsp->cdef_filters[1][1] =
+      CdefFilter_AVX512<8, kBitdepth10, uint16_t, /*enable_primary=*/true,
+                        /*enable_secondary=*/false>;
+  dsp->cdef_filters[1][2] =
+      CdefFilter_AVX512<8, kBitdepth10, uint16_t, /*enable_primary=*/false>;
+#endif
+}
+
+#if LIBGAV1_MAX_BITDEPTH == 12
+void Init12bpp() {
+  Dsp* const dsp = dsp_internal::GetWritableDspTable(kBitdepth12);
+  assert(dsp != nullptr);
+  static_cast<void>(dsp);
+#if DSP_ENABLED_12BPP_AVX512(CdefFilters)
+  dsp->cdef_filters[0][0] = CdefFilter_AVX512<4, kBitdepth12, uint16_t>;
+  dsp->cdef_filters[0][1] =
+      CdefFilter_AVX512<4, kBitdepth12, uint16_t, /*enable_primary=*/true,
+                        /*enable_secondary=*/false>;
+  dsp->cdef_filters[0][2] =
+      CdefFilter_AVX512<4, kBitdepth12, uint16_t, /*enable_primary=*/false>;
+  dsp->cdef_filters[1][0] = CdefFilter_AVX512<8, kBitdepth12, uint16_t>;
+  dsp->cdef_filters[1][1] =
+      CdefFilter_AVX512<8, kBitdepth12, uint16_t, /*enable_primary=*/true,
+                        /*enable_secondary=*/false>;
+  dsp->cdef_filters[1][2] =
+      CdefFilter_AVX512<8, kBitdepth12, uint16_t, /*enable_primary=*/false>;
+#endif
+}
+#endif  // LIBGAV1_MAX_BITDEPTH == 12
+
+}  // namespace
+}  // namespace high_bitdepth
+#endif  // LIBGAV1_MAX_BITDEPTH >= 10
+
+void CdefInit_AVX512() {
+  low_bitdepth::Init8bpp();
+#if LIBGAV1_MAX_BITDEPTH >= 10
+  high_bitdepth::Init10bpp();
+#endif
+#if LIBGAV1_MAX_BITDEPTH == 12
+  high_bitdepth::Init12bpp();
+#endif
+}
+
+}  // namespace dsp
+}  // namespace libgav1
+#else   // !LIBGAV1_TARGETING_AVX512
+namespace libgav1 {
+namespace dsp {
+
+void CdefInit_AVX512() {}
+
+}  // namespace dsp
+}  // namespace libgav1
+#endif  // LIBGAV1_TARGETING_AVX512
@@ -35,7 +35,6 @@
 
 namespace libgav1 {
 namespace dsp {
-namespace low_bitdepth {
 namespace {
 
 #include "src/dsp/cdef.inc"
@@ -241,9 +240,12 @@ LIBGAV1_ALWAYS_INLINE void AddPartial_D5_D7(__m128i* v_src, __m128i* partial_lo,
   *partial_hi = _mm_add_epi16(*partial_hi, _mm_srli_si128(v_pair_add[3], 10));
 }
 
-LIBGAV1_ALWAYS_INLINE void AddPartial(const uint8_t* LIBGAV1_RESTRICT src,
+template <int bitdepth>
+LIBGAV1_ALWAYS_INLINE void AddPartial(const void* LIBGAV1_RESTRICT const source,
                                       ptrdiff_t stride, __m128i* partial_lo,
                                       __m128i* partial_hi) {
+  const auto* src = static_cast<const uint8_t*>(source);
+
   // 8x8 input
   // 00 01 02 03 04 05 06 07
   // 10 11 12 13 14 15 16 17
@@ -254,9 +256,19 @@ LIBGAV1_ALWAYS_INLINE void AddPartial(const uint8_t* LIBGAV1_RESTRICT src,
   // 60 61 62 63 64 65 66 67
   // 70 71 72 73 74 75 76 77
   __m128i v_src[8];
-  for (auto& i : v_src) {
-    i = LoadLo8(src);
-    src += stride;
+  if (bitdepth == kBitdepth8) {
+    for (auto& i : v_src) {
+      i = LoadLo8(src);
+      src += stride;
+    }
+  } else {
+    // The direction search only uses the 8 most significant bits.
+    for (auto& i : v_src) {
+      const __m128i v_src_16 =
+          _mm_srli_epi16(LoadUnaligned16(src), bitdepth - kBitdepth8);
+      i = _mm_packus_epi16(v_src_16, v_src_16);
+      src += stride;
+    }
   }
 
   const __m128i v_zero = _mm_setzero_si128();
@@ -395,6 +407,7 @@ inline uint32_t SquareSum_S16(const __m128i a) {
   return SumVector_S32(square);
 }
 
+template <int bitdepth>
 void CdefDirection_SSE4_1(const void* LIBGAV1_RESTRICT const source,
                           ptrdiff_t stride,
                           uint8_t* LIBGAV1_RESTRICT const direction,
@@ -405,7 +418,7 @@ void CdefDirection_SSE4_1(const void* LIBGAV1_RESTRICT const source,
   uint32_t cost[8];
   __m128i partial_lo[8], partial_hi[8];
 
-  AddPartial(src, stride, partial_lo, partial_hi);
+  AddPartial<bitdepth>(src, stride, partial_lo, partial_hi);
 
   cost[2] = kCdefDivisionTable[7] * SquareSum_S16(partial_lo[2]);
   cost[6] = kCdefDivisionTable[7] * SquareSum_S16(partial_lo[6]);
@@ -491,9 +504,11 @@ inline __m128i Constrain(const __m128i& pixel, const __m128i& reference,
   //                    0, std::abs(diff))
   const __m128i shifted_diff = _mm_srl_epi16(abs_diff, damping);
   // For bitdepth == 8, the threshold range is [0, 15] and the damping range is
-  // [3, 6]. If pixel == kCdefLargeValue(0x4000), shifted_diff will always be
-  // larger than threshold. Subtract using saturation will return 0 when pixel
-  // == kCdefLargeValue.
+  // [3, 6]. For bitdepth == 10 both are scaled, to [0, 15 << 2] and [3, 6 + 2],
+  // and for bitdepth == 12 to [0, 15 << 4] and [3, 6 + 4].
+  // If pixel == kCdefLargeValue(0x4000), shifted_diff will always be larger
+  // than threshold. Subtract using saturation will return 0 when pixel ==
+  // kCdefLargeValue.
   static_assert(kCdefLargeValue == 0x4000, "Invalid kCdefLargeValue");
   const __m128i thresh_minus_shifted_diff =
       _mm_subs_epu16(threshold, shifted_diff);
@@ -510,7 +525,30 @@ inline __m128i ApplyConstrainAndTap(const __m128i& pixel, const __m128i& val,
   return _mm_mullo_epi16(constrained, tap);
 }
 
-template <int width, bool enable_primary = true, bool enable_secondary = true>
+// The source is 16 bits, however, for 8-bit pixels only the lower 8 bits are of
+// interest. The upper 8 bits contain the "large" flag. After the max has been
+// calculated with _mm_max_epu8(), zero out the flag to find the "16 bit" max.
+// 10-bit pixels use the upper byte, so the flag is cleared in each value first.
+template <typename Pixel>
+inline __m128i GetMax(const __m128i* const values, const int num_values,
+                      const __m128i max, const __m128i cdef_large_value_mask) {
+  if (sizeof(Pixel) == 1) {
+    __m128i max_values = values[0];
+    for (int i = 1; i < num_values; ++i) {
+      max_values = _mm_max_epu8(max_values, values[i]);
+    }
+    return _mm_max_epu16(max, _mm_and_si128(max_values, cdef_large_value_mask));
+  }
+  __m128i max_values = max;
+  for (int i = 0; i < num_values; ++i) {
+    max_values = _mm_max_epu16(max_values,
+                               _mm_and_si128(values[i], cdef_large_value_mask));
+  }
+  return max_values;
+}
+
+template <int width, int bitdepth, typename Pixel,
+          bool enable_primary = true, bool enable_secondary = true>
 void CdefFilter_SSE4_1(const uint16_t* LIBGAV1_RESTRICT src,
                        const ptrdiff_t src_stride, const int height,
                        const int primary_strength, const int secondary_strength,
@@ -525,24 +563,34 @@ void CdefFilter_SSE4_1(const uint16_t* LIBGAV1_RESTRICT src,
 
   // FloorLog2() requires input to be > 0.
   // 8-bit damping range: Y: [3, 6], UV: [2, 5].
+  // 10-bit damping range: Y: [3, 6 + 2], UV: [2, 5 + 2].
   if (enable_primary) {
-    // primary_strength: [0, 15] -> FloorLog2: [0, 3] so a clamp is necessary
-    // for UV filtering.
+    // 8-bit primary_strength: [0, 15] -> FloorLog2: [0, 3] so a clamp is
+    // necessary for UV filtering.
+    // 10-bit primary_strength: [0, 15 << 2].
     primary_damping_shift =
         _mm_cvtsi32_si128(std::max(0, damping - FloorLog2(primary_strength)));
   }
   if (enable_secondary) {
-    // secondary_strength: [0, 4] -> FloorLog2: [0, 2] so no clamp to 0 is
-    // necessary.
-    assert(damping - FloorLog2(secondary_strength) >= 0);
-    secondary_damping_shift =
-        _mm_cvtsi32_si128(damping - FloorLog2(secondary_strength));
+    if (sizeof(Pixel) == 1) {
+      // secondary_strength: [0, 4] -> FloorLog2: [0, 2] so no clamp to 0 is
+      // necessary.
+      assert(damping - FloorLog2(secondary_strength) >= 0);
+      secondary_damping_shift =
+          _mm_cvtsi32_si128(damping - FloorLog2(secondary_strength));
+    } else {
+      // secondary_strength: [0, 4 << 2]
+      secondary_damping_shift = _mm_cvtsi32_si128(
+          std::max(0, damping - FloorLog2(secondary_strength)));
+    }
   }
 
+  constexpr int coeff_shift = bitdepth - kBitdepth8;
+  const int primary_tap_index = (primary_strength >> coeff_shift) & 1;
   const __m128i primary_tap_0 =
-      _mm_set1_epi16(kCdefPrimaryTaps[primary_strength & 1][0]);
+      _mm_set1_epi16(kCdefPrimaryTaps[primary_tap_index][0]);
   const __m128i primary_tap_1 =
-      _mm_set1_epi16(kCdefPrimaryTaps[primary_strength & 1][1]);
+      _mm_set1_epi16(kCdefPrimaryTaps[primary_tap_index][1]);
   const __m128i secondary_tap_0 = _mm_set1_epi16(kCdefSecondaryTap0);
   const __m128i secondary_tap_1 = _mm_set1_epi16(kCdefSecondaryTap1);
   const __m128i cdef_large_value_mask =
@@ -578,14 +626,7 @@ void CdefFilter_SSE4_1(const uint16_t* LIBGAV1_RESTRICT src,
         min = _mm_min_epu16(min, primary_val[2]);
         min = _mm_min_epu16(min, primary_val[3]);
 
-        // The source is 16 bits, however, we only really care about the lower
-        // 8 bits.  The upper 8 bits contain the "large" flag.  After the final
-        // primary max has been calculated, zero out the upper 8 bits.  Use this
-        // to find the "16 bit" max.
-        const __m128i max_p01 = _mm_max_epu8(primary_val[0], primary_val[1]);
-        const __m128i max_p23 = _mm_max_epu8(primary_val[2], primary_val[3]);
-        const __m128i max_p = _mm_max_epu8(max_p01, max_p23);
-        max = _mm_max_epu16(max, _mm_and_si128(max_p, cdef_large_value_mask));
+        max = GetMax<Pixel>(primary_val, 4, max, cdef_large_value_mask);
       }
 
       sum = ApplyConstrainAndTap(pixel, primary_val[0], primary_tap_0,
@@ -624,17 +665,7 @@ void CdefFilter_SSE4_1(const uint16_t* LIBGAV1_RESTRICT src,
         min = _mm_min_epu16(min, secondary_val[6]);
         min = _mm_min_epu16(min, secondary_val[7]);
 
-        const __m128i max_s01 =
-            _mm_max_epu8(secondary_val[0], secondary_val[1]);
-        const __m128i max_s23 =
-            _mm_max_epu8(secondary_val[2], secondary_val[3]);
-        const __m128i max_s45 =
-            _mm_max_epu8(secondary_val[4], secondary_val[5]);
-        const __m128i max_s67 =
-            _mm_max_epu8(secondary_val[6], secondary_val[7]);
-        const __m128i max_s = _mm_max_epu8(_mm_max_epu8(max_s01, max_s23),
-                                           _mm_max_epu8(max_s45, max_s67));
-        max = _mm_max_epu16(max, _mm_and_si128(max_s, cdef_large_value_mask));
+        max = GetMax<Pixel>(secondary_val, 8, max, cdef_large_value_mask);
       }
 
       sum = _mm_add_epi16(
@@ -685,41 +716,109 @@ void CdefFilter_SSE4_1(const uint16_t* LIBGAV1_RESTRICT src,
       sum = _mm_max_epi16(sum, min);
     }
 
-    const __m128i result = _mm_packus_epi16(sum, sum);
-    if (width == 8) {
-      src += src_stride;
-      StoreLo8(dst, result);
-      dst += dst_stride;
-      --y;
+    if (sizeof(Pixel) == 1) {
+      const __m128i result = _mm_packus_epi16(sum, sum);
+      if (width == 8) {
+        StoreLo8(dst, result);
+      } else {
+        Store4(dst, result);
+        Store4(dst + dst_stride, _mm_srli_si128(result, 4));
+      }
     } else {
-      src += src_stride << 1;
-      Store4(dst, result);
-      dst += dst_stride;
-      Store4(dst, _mm_srli_si128(result, 4));
-      dst += dst_stride;
-      y -= 2;
+      if (width == 8) {
+        StoreUnaligned16(dst, sum);
+      } else {
+        StoreLo8(dst, sum);
+        StoreHi8(dst + dst_stride, sum);
+      }
     }
+    src += (width == 8) ? src_stride : src_stride << 1;
+    dst += (width == 8) ? dst_stride : dst_stride << 1;
+    y -= (width == 8) ? 1 : 2;
   } while (y != 0);
 }
 
+}  // namespace
+
+namespace low_bitdepth {
+namespace {
+
 void Init8bpp() {
-  Dsp* const dsp = dsp_internal::GetWritableDspTable(8);
+  Dsp* const dsp = dsp_internal::GetWritableDspTable(kBitdepth8);
   assert(dsp != nullptr);
-  dsp->cdef_direction = CdefDirection_SSE4_1;
-  dsp->cdef_filters[0][0] = CdefFilter_SSE4_1<4>;
+  dsp->cdef_direction = CdefDirection_SSE4_1<kBitdepth8>;
+  dsp->cdef_filters[0][0] = CdefFilter_SSE4_1<4, kBitdepth8, uint8_t>;
   dsp->cdef_filters[0][1] =
-      CdefFilter_SSE4_1<4, /*enable_primary=*/true, /*enable_secondary=*/false>;
-  dsp->cdef_filters[0][2] = CdefFilter_SSE4_1<4, /*enable_primary=*/false>;
-  dsp->cdef_filters[1][0] = CdefFilter_SSE4_1<8>;
+      CdefFilter_SSE4_1<4, kBitdepth8, uint8_t, /*enable_primary=*/true,
+                        /*enable_secondary=*/false>;
+  dsp->cdef_filters[0][2] =
+      CdefFilter_SSE4_1<4, kBitdepth8, uint8_t, /*enable_primary=*/false>;
+  dsp->cdef_filters[1][0] = CdefFilter_SSE4_1<8, kBitdepth8, uint8_t>;
   dsp->cdef_filters[1][1] =
-      CdefFilter_SSE4_1<8, /*enable_primary=*/true, /*enable_secondary=*/false>;
-  dsp->cdef_filters[1][2] = CdefFilter_SSE4_1<8, /*enable_primary=*/false>;
+      CdefFilter_SSE4_1<8, kBitdepth8, uint8_t, /*enable_primary=*/true,
+                        /*enable_secondary=*/false>;
+  dsp->cdef_filters[1][2] =
+      CdefFilter_SSE4_1<8, kBitdepth8, uint8_t, /*enable_primary=*/false>;
 }
 
 }  // namespace
 }  // namespace low_bitdepth
 
-void CdefInit_SSE4_1() { low_bitdepth::Init8bpp(); }
+#if LIBGAV1_MAX_BITDEPTH >= 10
+namespace high_bitdepth {
+namespace {
+
+void Init10bpp() {
+  Dsp* const dsp = dsp_internal::GetWritableDspTable(kBitdepth10);
+  assert(dsp != nullptr);
+  dsp->cdef_direction = CdefDirection_SSE4_1<kBitdepth10>;
+  dsp->cdef_filters[0][0] = CdefFilter_SSE4_1<4, kBitdepth10, uint16_t>;
+  dsp->cdef_filters[0][1] =
+      CdefFilter_SSE4_1<4, kBitdepth10, uint16_t, /*enable_primary=*/true,
+                        /*enable_secondary=*/false>;
+  dsp->cdef_filters[0][2] =
+      CdefFilter_SSE4_1<4, kBitdepth10, uint16_t, /*enable_primary=*/false>;
+  dsp->cdef_filters[1][0] = CdefFilter_SSE4_1<8, kBitdepth10, uint16_t>;
+  dsp->cdef_filters[1][1] =
+      CdefFilter_SSE4_1<8, kBitdepth10, uint16_t, /*enable_primary=*/true,
+                        /*enable_secondary=*/false>;
+  dsp->cdef_filters[1][2] =
+      CdefFilter_SSE4_1<8, kBitdepth10, uint16_t, /*enable_primary=*/false>;
+}
+
+#if LIBGAV1_MAX_BITDEPTH == 12
+void Init12bpp() {
+  Dsp* const dsp = dsp_internal::GetWritableDspTable(kBitdepth12);
+  assert(dsp != nullptr);
+  dsp->cdef_direction = CdefDirection_SSE4_1<kBitdepth12>;
+  dsp->cdef_filters[0][0] = CdefFilter_SSE4_1<4, kBitdepth12, uint16_t>;
+  dsp->cdef_filters[0][1] =
+      CdefFilter_SSE4_1<4, kBitdepth12, uint16_t, /*enable_primary=*/true,
+                        /*enable_secondary=*/false>;
+  dsp->cdef_filters[0][2] =
+      CdefFilter_SSE4_1<4, kBitdepth12, uint16_t, /*enable_primary=*/false>;
+  dsp->cdef_filters[1][0] = CdefFilter_SSE4_1<8, kBitdepth12, uint16_t>;
+  dsp->cdef_filters[1][1] =
+      CdefFilter_SSE4_1<8, kBitdepth12, uint16_t, /*enable_primary=*/true,
+                        /*enable_secondary=*/false>;
+  dsp->cdef_filters[1][2] =
+      CdefFilter_SSE4_1<8, kBitdepth12, uint16_t, /*enable_primary=*/false>;
+}
+#endif  // LIBGAV1_MAX_BITDEPTH == 12
+
+}  // namespace
+}  // namespace high_bitdepth
+#endif  // LIBGAV1_MAX_BITDEPTH >= 10
+
+void CdefInit_SSE4_1() {
+  low_bitdepth::Init8bpp();
+#if LIBGAV1_MAX_BITDEPTH >= 10
+  high_bitdepth::Init10bpp();
+#endif
+#if LIBGAV1_MAX_BITDEPTH == 12
+  high_bitdepth::Init12bpp();
+#endif
+}
 
 }  // namespace dsp
 }  // namespace libgav1
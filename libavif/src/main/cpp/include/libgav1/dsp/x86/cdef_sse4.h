@@ -40,6 +40,22 @@ void CdefInit_SSE4_1();
 #define LIBGAV1_Dsp8bpp_CdefFilters LIBGAV1_CPU_SSE4_1
 #endif
 
+#ifndef LIBGAV1_Dsp10bpp_CdefDirection
+#define LIBGAV1_Dsp10bpp_CdefDirection LIBGAV1_CPU_SSE4_1
+#endif
+
+#ifndef LIBGAV1_Dsp10bpp_CdefFilters
+#define LIBGAV1_Dsp10bpp_CdefFilters LIBGAV1_CPU_SSE4_1
+#endif
+
+#ifndef LIBGAV1_Dsp12bpp_CdefDirection
+#define LIBGAV1_Dsp12bpp_CdefDirection LIBGAV1_CPU_SSE4_1
+#endif
+
+#ifndef LIBGAV1_Dsp12bpp_CdefFilters
+#define LIBGAV1_Dsp12bpp_CdefFilters LIBGAV1_CPU_SSE4_1
+#endif
+
 #endif  // LIBGAV1_TARGETING_SSE4_1
 
 #endif  // LIBGAV1_SRC_DSP_X86_CDEF_SSE4_H_
@@ -0,0 +1,238 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the SSE4.1, AVX2 and AVX-512 CDEF direction search and filters
+// (cdef_sse4.cc, cdef_avx2.cc and cdef_avx512.cc) with the C ones at each
+// bitdepth, on random and extreme pixels, with borders padded as at the frame
+// edges, and every direction, damping and strength a frame header may code.
+//
+// The SIMD functions are reached through their Init functions, so this file
+// is built without SIMD flags and each tier is skipped on CPUs without it.
+
+#include "src/dsp/cdef.h"
+
+#include "gtest/gtest.h"
+#include "src/utils/cpu.h"
+
+#if LIBGAV1_ENABLE_SSE4_1
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "src/dsp/dsp.h"
+#include "src/dsp/x86/cdef_avx2.h"
+#include "src/dsp/x86/cdef_avx512.h"
+#include "src/dsp/x86/cdef_sse4.h"
+#include "src/utils/constants.h"
+
+namespace libgav1 {
+namespace dsp {
+namespace {
+
+struct CdefTier {
+  const char* name;
+  CpuFeatures feature;
+  void (*init)();
+};
+
+// CdefInit_AVX512() must follow CdefInit_AVX2(), as in DspInit().
+void CdefInitAvx2AndAvx512() {
+  CdefInit_AVX2();
+  CdefInit_AVX512();
+}
+
+const CdefTier kCdefTiers[] = {{"SSE4_1", kSSE4_1, CdefInit_SSE4_1},
+                               {"AVX2", kAVX2, CdefInit_AVX2},
+                               {"AVX512", kAVX512, CdefInitAvx2AndAvx512}};
+
+class CdefTest : public testing::TestWithParam<CdefTier> {
+ protected:
+  static constexpr int kStride = kCdefUnitSizeWithBorders;
+
+  void SetUp() override {
+    if ((GetCpuInfo() & GetParam().feature) == 0) {
+      GTEST_SKIP() << GetParam().name << " is not supported by this CPU.";
+    }
+    DspInit();
+  }
+
+  template <int bitdepth, typename Pixel>
+  void TestDirection();
+  template <int bitdepth, typename Pixel>
+  void TestFilters();
+
+  // Pixels are random on even iterations and either 0 or the maximum on odd
+  // ones.
+  template <int bitdepth, typename T>
+  void RandomPixels(int iteration, std::vector<T>* pixels) {
+    constexpr int kPixelMax = (1 << bitdepth) - 1;
+    std::uniform_int_distribution<int> pixel(0, kPixelMax);
+    std::uniform_int_distribution<int> extreme(0, 1);
+    for (auto& value : *pixels) {
+      value = static_cast<T>(((iteration & 1) == 0)
+                                 ? pixel(rng_)
+                                 : extreme(rng_) * kPixelMax);
+    }
+  }
+
+  std::mt19937 rng_{kCdefUnitSize};
+};
+
+template <int bitdepth, typename Pixel>
+void CdefTest::TestDirection() {
+  // cdef.cc is built without SIMD flags, so CdefInit_C() installs every C
+  // function. The tier then replaces the ones it has.
+  CdefInit_C();
+  const CdefDirectionFunc c_direction = GetDspTable(bitdepth)->cdef_direction;
+  GetParam().init();
+  const CdefDirectionFunc simd_direction =
+      GetDspTable(bitdepth)->cdef_direction;
+  if (simd_direction == c_direction) {
+    GTEST_SKIP() << "No " << GetParam().name << " direction search at "
+                 << bitdepth << "bpp.";
+  }
+  std::vector<Pixel> source(kStride * 8);
+  for (int iteration = 0; iteration < 1000; ++iteration) {
+    RandomPixels<bitdepth>(iteration, &source);
+    uint8_t c_result = 0;
+    uint8_t simd_result = 0;
+    int c_variance = 0;
+    int simd_variance = 0;
+    c_direction(source.data(), kStride * sizeof(Pixel), &c_result,
+                &c_variance);
+    simd_direction(source.data(), kStride * sizeof(Pixel), &simd_result,
+                   &simd_variance);
+    ASSERT_EQ(c_result, simd_result) << "iteration " << iteration;
+    ASSERT_EQ(c_variance, simd_variance) << "iteration " << iteration;
+  }
+}
+
+template <int bitdepth, typename Pixel>
+void CdefTest::TestFilters() {
+  CdefInit_C();
+  CdefFilteringFuncs c_filters;
+  memcpy(c_filters, GetDspTable(bitdepth)->cdef_filters, sizeof(c_filters));
+  GetParam().init();
+  CdefFilteringFuncs simd_filters;
+  memcpy(simd_filters, GetDspTable(bitdepth)->cdef_filters,
+         sizeof(simd_filters));
+  constexpr int kCoeffShift = bitdepth - 8;
+  constexpr int kSecondaryStrengths[] = {1, 2, 4};
+  std::vector<uint16_t> source(kStride * kStride);
+  std::vector<Pixel> c_dest(kStride * 8);
+  std::vector<Pixel> simd_dest(kStride * 8);
+  const uint16_t* const src =
+      source.data() + kCdefBorder * kStride + kCdefBorder;
+  std::uniform_int_distribution<int> primary_strength(1, 15);
+  std::uniform_int_distribution<int> secondary_strength(0, 2);
+  std::uniform_int_distribution<int> damping(2, 6);
+  std::uniform_int_distribution<int> frame_edge(0, 15);
+  int num_simd = 0;
+  // Width 4 is chroma, 4x4 for 4:2:0 and 4x8 for 4:2:2.
+  for (int width_index = 0; width_index < 2; ++width_index) {
+    for (int strength_index = 0; strength_index < 3; ++strength_index) {
+      if (simd_filters[width_index][strength_index] ==
+          c_filters[width_index][strength_index]) {
+        continue;
+      }
+      ++num_simd;
+      for (const int block_height : {4, 8}) {
+        if (width_index == 1 && block_height == 4) continue;
+        for (int direction = 0; direction < 8; ++direction) {
+          for (int iteration = 0; iteration < 32; ++iteration) {
+            RandomPixels<bitdepth>(iteration, &source);
+            // Pad the sides that are at a frame edge as PrepareCdefBlock()
+            // does.
+            const int edges = frame_edge(rng_);
+            for (int y = 0; y < block_height + 2 * kCdefBorder; ++y) {
+              for (int x = 0; x < 8 + 2 * kCdefBorder; ++x) {
+                if (((edges & 1) != 0 && y < kCdefBorder) ||
+                    ((edges & 2) != 0 && y >= block_height + kCdefBorder) ||
+                    ((edges & 4) != 0 && x < kCdefBorder) ||
+                    ((edges & 8) != 0 && x >= 4 + 4 * width_index +
+                                                  kCdefBorder)) {
+                  source[y * kStride + x] = kCdefLargeValue;
+                }
+              }
+            }
+            const int primary =
+                (strength_index == 2)
+                    ? 0
+                    : (primary_strength(rng_) << kCoeffShift);
+            const int secondary =
+                (strength_index == 1)
+                    ? 0
+                    : (kSecondaryStrengths[secondary_strength(rng_)]
+                       << kCoeffShift);
+            // The frame damping is 3 to 6 and chroma uses one less.
+            const int damping_value = damping(rng_) + kCoeffShift;
+            std::fill(c_dest.begin(), c_dest.end(), 0);
+            std::fill(simd_dest.begin(), simd_dest.end(), 0);
+            c_filters[width_index][strength_index](
+                src, kStride, block_height, primary, secondary, damping_value,
+                direction, c_dest.data(), kStride * sizeof(Pixel));
+            simd_filters[width_index][strength_index](
+                src, kStride, block_height, primary, secondary, damping_value,
+                direction, simd_dest.data(), kStride * sizeof(Pixel));
+            ASSERT_TRUE(std::equal(c_dest.begin(), c_dest.end(),
+                                   simd_dest.begin()))
+                << bitdepth << "bpp " << (4 + 4 * width_index) << "x"
+                << block_height << ", strengths " << primary << "/"
+                << secondary << ", damping " << damping_value
+                << ", direction " << direction << ", iteration " << iteration;
+          }
+        }
+      }
+    }
+  }
+  if (num_simd == 0) {
+    GTEST_SKIP() << "No " << GetParam().name << " filters at " << bitdepth
+                 << "bpp.";
+  }
+}
+
+TEST_P(CdefTest, Direction8bpp) { TestDirection<kBitdepth8, uint8_t>(); }
+TEST_P(CdefTest, Filters8bpp) { TestFilters<kBitdepth8, uint8_t>(); }
+
+#if LIBGAV1_MAX_BITDEPTH >= 10
+TEST_P(CdefTest, Direction10bpp) { TestDirection<kBitdepth10, uint16_t>(); }
+TEST_P(CdefTest, Filters10bpp) { TestFilters<kBitdepth10, uint16_t>(); }
+#endif  // LIBGAV1_MAX_BITDEPTH >= 10
+
+#if LIBGAV1_MAX_BITDEPTH == 12
+TEST_P(CdefTest, Direction12bpp) { TestDirection<kBitdepth12, uint16_t>(); }
+TEST_P(CdefTest, Filters12bpp) { TestFilters<kBitdepth12, uint16_t>(); }
+#endif  // LIBGAV1_MAX_BITDEPTH == 12
+
+INSTANTIATE_TEST_SUITE_P(X86, CdefTest, testing::ValuesIn(kCdefTiers),
+                         [](const testing::TestParamInfo<CdefTier>& info) {
+                           return std::string(info.param.name);
+                         });
+
+}  // namespace
+}  // namespace dsp
+}  // namespace libgav1
+
+#else  // !LIBGAV1_ENABLE_SSE4_1
+
+TEST(CdefTest, X86) {
+  GTEST_SKIP() << "Build this module for x86(-64) to enable the tests.";
+}
+
+#endif  // LIBGAV1_ENABLE_SSE4_1
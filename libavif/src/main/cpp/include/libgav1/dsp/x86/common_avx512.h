@@ -0,0 +1,74 @@
+/*
+ * Copyright 2021 The libgav1 Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LIBGAV1_SRC_DSP_X86_COMMON_AVX512_H_
+#define LIBGAV1_SRC_DSP_X86_COMMON_AVX512_H_
+
+#include "src/utils/compiler_attributes.h"
+#include "src/utils/cpu.h"
+
+#if LIBGAV1_TARGETING_AVX512
+
+#include <immintrin.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace libgav1 {
+namespace dsp {
+namespace avx512 {
+
+#include "src/dsp/x86/common_avx2.inc"
+#include "src/dsp/x86/common_avx512.inc"
+#include "src/dsp/x86/common_sse4.inc"
+
+}  // namespace avx512
+
+// NOLINTBEGIN(misc-unused-using-decls)
+// These function aliases shall not be visible to external code. They are
+// restricted to x86/*_avx512.cc files only, which must not include
+// common_avx2.h or common_sse4.h.
+
+// common_sse4.inc
+using avx512::Load4;
+using avx512::LoadHi8;
+using avx512::LoadLo8;
+using avx512::LoadUnaligned16;
+using avx512::RightShiftWithRounding_S16;
+using avx512::RightShiftWithRounding_S32;
+using avx512::Store4;
+using avx512::StoreHi8;
+using avx512::StoreLo8;
+using avx512::StoreUnaligned16;
+
+// common_avx2.inc
+using avx512::LoadUnaligned32;
+using avx512::SetrM128i;
+using avx512::StoreUnaligned32;
+
+// common_avx512.inc
+using avx512::LoadBytes;
+using avx512::LoadUnaligned64;
+using avx512::StoreUnaligned64;
+// NOLINTEND
+
+}  // namespace dsp
+}  // namespace libgav1
+
+#endif  // LIBGAV1_TARGETING_AVX512
+#endif  // LIBGAV1_SRC_DSP_X86_COMMON_AVX512_H_
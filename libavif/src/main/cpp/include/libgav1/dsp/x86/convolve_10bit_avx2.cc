@@ -0,0 +1,459 @@
+// Copyright 2021 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/dsp/convolve.h"
+#include "src/utils/cpu.h"
+
+#if LIBGAV1_TARGETING_AVX2 && LIBGAV1_MAX_BITDEPTH >= 10
+#include <immintrin.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "src/dsp/constants.h"
+#include "src/dsp/dsp.h"
+#include "src/dsp/x86/common_avx2.h"
+#include "src/utils/common.h"
+#include "src/utils/compiler_attributes.h"
+#include "src/utils/constants.h"
+
+namespace libgav1 {
+namespace dsp {
+namespace {
+
+// The 128-bit kernels handle |width| <= 8.
+#include "src/dsp/x86/convolve_10bit_sse4.inc"
+
+template <int num_taps>
+LIBGAV1_ALWAYS_INLINE void SetupTaps(const int8_t* const filter,
+                                     __m256i* const v_tap) {
+  __m128i v_tap_128[4];
+  SetupTaps<num_taps>(filter, v_tap_128);
+  for (int i = 0; i < num_taps >> 1; ++i) {
+    v_tap[i] = _mm256_broadcastsi128_si256(v_tap_128[i]);
+  }
+}
+
+// The unpack and pack instructions work within 128-bit lanes, so the low lane
+// of |sums[0]| and |sums[1]| holds pixels 0-7 and the high lane pixels 8-15.
+template <int num_taps>
+LIBGAV1_ALWAYS_INLINE void SumOnePassTaps(const __m256i* const src,
+                                          const __m256i* const v_tap,
+                                          __m256i* const sums) {
+  sums[0] = _mm256_madd_epi16(_mm256_unpacklo_epi16(src[0], src[1]), v_tap[0]);
+  sums[1] = _mm256_madd_epi16(_mm256_unpackhi_epi16(src[0], src[1]), v_tap[0]);
+  if (num_taps >= 4) {
+    sums[0] = _mm256_add_epi32(
+        sums[0],
+        _mm256_madd_epi16(_mm256_unpacklo_epi16(src[2], src[3]), v_tap[1]));
+    sums[1] = _mm256_add_epi32(
+        sums[1],
+        _mm256_madd_epi16(_mm256_unpackhi_epi16(src[2], src[3]), v_tap[1]));
+  }
+  if (num_taps >= 6) {
+    sums[0] = _mm256_add_epi32(
+        sums[0],
+        _mm256_madd_epi16(_mm256_unpacklo_epi16(src[4], src[5]), v_tap[2]));
+    sums[1] = _mm256_add_epi32(
+        sums[1],
+        _mm256_madd_epi16(_mm256_unpackhi_epi16(src[4], src[5]), v_tap[2]));
+  }
+  if (num_taps == 8) {
+    sums[0] = _mm256_add_epi32(
+        sums[0],
+        _mm256_madd_epi16(_mm256_unpacklo_epi16(src[6], src[7]), v_tap[3]));
+    sums[1] = _mm256_add_epi32(
+        sums[1],
+        _mm256_madd_epi16(_mm256_unpackhi_epi16(src[6], src[7]), v_tap[3]));
+  }
+}
+
+// Filters the 16 pixels starting at |src|, which points to the outermost tap.
+// Reads 24 values.
+template <int num_taps>
+LIBGAV1_ALWAYS_INLINE void SumHorizontalTaps(const uint16_t* const src,
+                                             const __m256i* const v_tap,
+                                             __m256i* const sums) {
+  // _mm256_alignr_epi8() shifts within each lane, so the second source starts
+  // 8 pixels later.
+  const __m256i src_lo = LoadUnaligned32(src);
+  const __m256i src_hi = LoadUnaligned32(src + 8);
+  __m256i v_src[num_taps];
+  v_src[0] = src_lo;
+  v_src[1] = _mm256_alignr_epi8(src_hi, src_lo, 2);
+  if (num_taps >= 4) {
+    v_src[2] = _mm256_alignr_epi8(src_hi, src_lo, 4);
+    v_src[3] = _mm256_alignr_epi8(src_hi, src_lo, 6);
+  }
+  if (num_taps >= 6) {
+    v_src[4] = _mm256_alignr_epi8(src_hi, src_lo, 8);
+    v_src[5] = _mm256_alignr_epi8(src_hi, src_lo, 10);
+  }
+  if (num_taps == 8) {
+    v_src[6] = _mm256_alignr_epi8(src_hi, src_lo, 12);
+    v_src[7] = _mm256_alignr_epi8(src_hi, src_lo, 14);
+  }
+  SumOnePassTaps<num_taps>(v_src, v_tap, sums);
+}
+
+template <bool is_compound, bool is_2d>
+LIBGAV1_ALWAYS_INLINE __m256i PackHorizontalSums(const __m256i sum_lo,
+                                                 const __m256i sum_hi) {
+  if (is_2d) {
+    return _mm256_packs_epi32(
+        RightShiftWithRounding_S32(sum_lo, kInterRoundBitsHorizontal - 1),
+        RightShiftWithRounding_S32(sum_hi, kInterRoundBitsHorizontal - 1));
+  }
+  if (is_compound) {
+    const __m256i v_compound_offset = _mm256_set1_epi32(kCompoundOffset);
+    return _mm256_packus_epi32(
+        _mm256_add_epi32(
+            RightShiftWithRounding_S32(sum_lo, kInterRoundBitsHorizontal - 1),
+            v_compound_offset),
+        _mm256_add_epi32(
+            RightShiftWithRounding_S32(sum_hi, kInterRoundBitsHorizontal - 1),
+            v_compound_offset));
+  }
+  const __m256i v_rounding = _mm256_set1_epi32(kHorizontalRounding);
+  const __m256i d = _mm256_packus_epi32(
+      _mm256_srai_epi32(_mm256_add_epi32(sum_lo, v_rounding), kFilterBits - 1),
+      _mm256_srai_epi32(_mm256_add_epi32(sum_hi, v_rounding), kFilterBits - 1));
+  return _mm256_min_epu16(d, _mm256_set1_epi16((1 << kBitdepth10) - 1));
+}
+
+template <bool is_compound, bool is_2d>
+LIBGAV1_ALWAYS_INLINE __m256i PackVerticalSums(const __m256i sum_lo,
+                                               const __m256i sum_hi) {
+  constexpr int kSingleRoundBits =
+      is_2d ? int{kInterRoundBitsVertical} : int{kFilterBits};
+  constexpr int kCompoundRoundBits = is_2d
+                                         ? int{kInterRoundBitsCompoundVertical}
+                                         : int{kInterRoundBitsHorizontal};
+  constexpr int kRoundBits =
+      (is_compound ? kCompoundRoundBits : kSingleRoundBits) - 1;
+  const __m256i d_lo = RightShiftWithRounding_S32(sum_lo, kRoundBits);
+  const __m256i d_hi = RightShiftWithRounding_S32(sum_hi, kRoundBits);
+  if (is_compound) {
+    const __m256i v_compound_offset = _mm256_set1_epi32(kCompoundOffset);
+    return _mm256_packus_epi32(_mm256_add_epi32(d_lo, v_compound_offset),
+                               _mm256_add_epi32(d_hi, v_compound_offset));
+  }
+  return _mm256_min_epu16(_mm256_packus_epi32(d_lo, d_hi),
+                          _mm256_set1_epi16((1 << kBitdepth10) - 1));
+}
+
+template <int num_taps, bool is_compound = false, bool is_2d = false>
+void FilterHorizontalWidth16AndUp(const uint16_t* LIBGAV1_RESTRICT src,
+                                  const ptrdiff_t src_stride,
+                                  void* LIBGAV1_RESTRICT const dest,
+                                  const ptrdiff_t pred_stride, const int width,
+                                  const int height,
+                                  const __m256i* const v_tap) {
+  auto* dest16 = static_cast<uint16_t*>(dest);
+  __m256i sums[2];
+  int y = height;
+  do {
+    int x = 0;
+    do {
+      SumHorizontalTaps<num_taps>(src + x, v_tap, sums);
+      StoreUnaligned32(dest16 + x, PackHorizontalSums<is_compound, is_2d>(
+                                       sums[0], sums[1]));
+      x += 16;
+    } while (x < width);
+    src += src_stride;
+    dest16 += pred_stride;
+  } while (--y != 0);
+}
+
+template <int num_taps, bool is_compound = false, bool is_2d = false>
+void FilterVerticalWidth16AndUp(const uint16_t* LIBGAV1_RESTRICT const src,
+                                const ptrdiff_t src_stride,
+                                void* LIBGAV1_RESTRICT const dest,
+                                const ptrdiff_t dest_stride, const int width,
+                                const int height, const __m256i* const v_tap) {
+  auto* const dest16 = static_cast<uint16_t*>(dest);
+  __m256i srcs[num_taps];
+  __m256i sums[2];
+  int x = 0;
+  do {
+    const uint16_t* src_x = src + x;
+    uint16_t* dest_x = dest16 + x;
+    for (int i = 0; i < num_taps - 1; ++i) {
+      srcs[i] = LoadUnaligned32(src_x);
+      src_x += src_stride;
+    }
+    int y = height;
+    do {
+      srcs[num_taps - 1] = LoadUnaligned32(src_x);
+      src_x += src_stride;
+      SumOnePassTaps<num_taps>(srcs, v_tap, sums);
+      StoreUnaligned32(dest_x,
+                       PackVerticalSums<is_compound, is_2d>(sums[0], sums[1]));
+      dest_x += dest_stride;
+      for (int i = 0; i < num_taps - 1; ++i) srcs[i] = srcs[i + 1];
+    } while (--y != 0);
+    x += 16;
+  } while (x < width);
+}
+
+template <int num_taps, bool is_compound, bool is_2d>
+LIBGAV1_ALWAYS_INLINE void FilterHorizontalAnyWidth(
+    const uint16_t* LIBGAV1_RESTRICT const src, const ptrdiff_t src_stride,
+    void* LIBGAV1_RESTRICT const dst, const ptrdiff_t dst_stride,
+    const int width, const int height, const int8_t* const filter) {
+  if (width >= 16) {
+    __m256i v_tap[4];
+    SetupTaps<num_taps>(filter, v_tap);
+    FilterHorizontalWidth16AndUp<num_taps, is_compound, is_2d>(
+        src, src_stride, dst, dst_stride, width, height, v_tap);
+  } else {
+    __m128i v_tap[4];
+    SetupTaps<num_taps>(filter, v_tap);
+    FilterHorizontal<num_taps, is_compound, is_2d>(
+        src, src_stride, dst, dst_stride, width, height, v_tap);
+  }
+}
+
+template <int num_taps, bool is_compound, bool is_2d>
+LIBGAV1_ALWAYS_INLINE void FilterVerticalAnyWidth(
+    const uint16_t* LIBGAV1_RESTRICT const src, const ptrdiff_t src_stride,
+    void* LIBGAV1_RESTRICT const dst, const ptrdiff_t dst_stride,
+    const int width, const int height, const int8_t* const filter) {
+  if (width >= 16) {
+    __m256i v_tap[4];
+    SetupTaps<num_taps>(filter, v_tap);
+    FilterVerticalWidth16AndUp<num_taps, is_compound, is_2d>(
+        src, src_stride, dst, dst_stride, width, height, v_tap);
+  } else {
+    __m128i v_tap[4];
+    SetupTaps<num_taps>(filter, v_tap);
+    FilterVertical<num_taps, is_compound, is_2d>(
+        src, src_stride, dst, dst_stride, width, height, v_tap);
+  }
+}
+
+template <bool is_compound = false, bool is_2d = false>
+LIBGAV1_ALWAYS_INLINE void DoHorizontalPass(
+    const uint16_t* LIBGAV1_RESTRICT const src, const ptrdiff_t src_stride,
+    void* LIBGAV1_RESTRICT const dst, const ptrdiff_t dst_stride,
+    const int width, const int height, const int filter_id,
+    const int filter_index) {
+  assert(filter_id != 0);
+  const int8_t* const filter = kHalfSubPixelFilters[filter_index][filter_id];
+  if (filter_index == 2) {  // 8 tap.
+    FilterHorizontalAnyWidth<8, is_compound, is_2d>(
+        src, src_stride, dst, dst_stride, width, height, filter);
+  } else if (filter_index < 2) {  // 6 tap.
+    FilterHorizontalAnyWidth<6, is_compound, is_2d>(
+        src + 1, src_stride, dst, dst_stride, width, height, filter);
+  } else if (filter_index > 3) {  // 4 tap.
+    FilterHorizontalAnyWidth<4, is_compound, is_2d>(
+        src + 2, src_stride, dst, dst_stride, width, height, filter);
+  } else {  // 2 tap.
+    FilterHorizontalAnyWidth<2, is_compound, is_2d>(
+        src + 3, src_stride, dst, dst_stride, width, height, filter);
+  }
+}
+
+// |src| points to the outermost tap of the first row.
+template <bool is_compound = false, bool is_2d = false>
+LIBGAV1_ALWAYS_INLINE void DoVerticalPass(
+    const uint16_t* LIBGAV1_RESTRICT const src, const ptrdiff_t src_stride,
+    void* LIBGAV1_RESTRICT const dst, const ptrdiff_t dst_stride,
+    const int width, const int height, const int filter_id,
+    const int filter_index) {
+  assert(filter_id != 0);
+  const int8_t* const filter = kHalfSubPixelFilters[filter_index][filter_id];
+  if (filter_index == 2) {  // 8 tap.
+    FilterVerticalAnyWidth<8, is_compound, is_2d>(
+        src, src_stride, dst, dst_stride, width, height, filter);
+  } else if (filter_index < 2) {  // 6 tap.
+    FilterVerticalAnyWidth<6, is_compound, is_2d>(
+        src, src_stride, dst, dst_stride, width, height, filter);
+  } else if (filter_index > 3) {  // 4 tap.
+    FilterVerticalAnyWidth<4, is_compound, is_2d>(
+        src, src_stride, dst, dst_stride, width, height, filter);
+  } else {  // 2 tap.
+    FilterVerticalAnyWidth<2, is_compound, is_2d>(
+        src, src_stride, dst, dst_stride, width, height, filter);
+  }
+}
+
+void ConvolveHorizontal_AVX2(
+    const void* LIBGAV1_RESTRICT const reference,
+    const ptrdiff_t reference_stride, const int horizontal_filter_index,
+    const int /*vertical_filter_index*/, const int horizontal_filter_id,
+    const int /*vertical_filter_id*/, const int width, const int height,
+    void* LIBGAV1_RESTRICT prediction, const ptrdiff_t pred_stride) {
+  const int filter_index = GetFilterIndex(horizontal_filter_index, width);
+  // Set |src| to the outermost tap.
+  const auto* const src =
+      static_cast<const uint16_t*>(reference) - kHorizontalOffset;
+  auto* const dest = static_cast<uint16_t*>(prediction);
+  const ptrdiff_t src_stride = reference_stride >> 1;
+  const ptrdiff_t dest_stride = pred_stride >> 1;
+
+  DoHorizontalPass(src, src_stride, dest, dest_stride, width, height,
+                   horizontal_filter_id, filter_index);
+}
+
+void ConvolveCompoundHorizontal_AVX2(
+    const void* LIBGAV1_RESTRICT const reference,
+    const ptrdiff_t reference_stride, const int horizontal_filter_index,
+    const int /*vertical_filter_index*/, const int horizontal_filter_id,
+    const int /*vertical_filter_id*/, const int width, const int height,
+    void* LIBGAV1_RESTRICT prediction, const ptrdiff_t /*pred_stride*/) {
+  const int filter_index = GetFilterIndex(horizontal_filter_index, width);
+  const auto* const src =
+      static_cast<const uint16_t*>(reference) - kHorizontalOffset;
+  auto* const dest = static_cast<uint16_t*>(prediction);
+  const ptrdiff_t src_stride = reference_stride >> 1;
+  // All compound functions output to the predictor buffer with |pred_stride|
+  // equal to |width|.
+  assert(width >= 4 && height >= 4);
+
+  DoHorizontalPass</*is_compound=*/true>(src, src_stride, dest, width, width,
+                                         height, horizontal_filter_id,
+                                         filter_index);
+}
+
+void ConvolveVertical_AVX2(
+    const void* LIBGAV1_RESTRICT const reference,
+    const ptrdiff_t reference_stride, const int /*horizontal_filter_index*/,
+    const int vertical_filter_index, const int /*horizontal_filter_id*/,
+    const int vertical_filter_id, const int width, const int height,
+    void* LIBGAV1_RESTRICT prediction, const ptrdiff_t pred_stride) {
+  const int filter_index = GetFilterIndex(vertical_filter_index, height);
+  const int vertical_taps = GetNumTapsInFilter(filter_index);
+  const ptrdiff_t src_stride = reference_stride >> 1;
+  const auto* const src = static_cast<const uint16_t*>(reference) -
+                          (vertical_taps / 2 - 1) * src_stride;
+  auto* const dest = static_cast<uint16_t*>(prediction);
+  const ptrdiff_t dest_stride = pred_stride >> 1;
+
+  DoVerticalPass(src, src_stride, dest, dest_stride, width, height,
+                 vertical_filter_id, filter_index);
+}
+
+void ConvolveCompoundVertical_AVX2(
+    const void* LIBGAV1_RESTRICT const reference,
+    const ptrdiff_t reference_stride, const int /*horizontal_filter_index*/,
+    const int vertical_filter_index, const int /*horizontal_filter_id*/,
+    const int vertical_filter_id, const int width, const int height,
+    void* LIBGAV1_RESTRICT prediction, const ptrdiff_t /*pred_stride*/) {
+  const int filter_index = GetFilterIndex(vertical_filter_index, height);
+  const int vertical_taps = GetNumTapsInFilter(filter_index);
+  const ptrdiff_t src_stride = reference_stride >> 1;
+  const auto* const src = static_cast<const uint16_t*>(reference) -
+                          (vertical_taps / 2 - 1) * src_stride;
+  auto* const dest = static_cast<uint16_t*>(prediction);
+  assert(width >= 4 && height >= 4);
+
+  DoVerticalPass</*is_compound=*/true>(src, src_stride, dest, width, width,
+                                       height, vertical_filter_id,
+                                       filter_index);
+}
+
+template <bool is_compound>
+void Convolve2D(const void* LIBGAV1_RESTRICT const reference,
+                const ptrdiff_t reference_stride,
+                const int horizontal_filter_index,
+                const int vertical_filter_index,
+                const int horizontal_filter_id, const int vertical_filter_id,
+                const int width, const int height,
+                void* LIBGAV1_RESTRICT prediction,
+                const ptrdiff_t pred_stride) {
+  const int horiz_filter_index = GetFilterIndex(horizontal_filter_index, width);
+  const int vert_filter_index = GetFilterIndex(vertical_filter_index, height);
+  const int vertical_taps = GetNumTapsInFilter(vert_filter_index);
+
+  // The output of the horizontal filter is guaranteed to fit in int16_t and is
+  // stored with the same bit pattern in the uint16_t buffer. Only the rows read
+  // by the vertical filter are generated.
+  alignas(32) uint16_t
+      intermediate_result[kMaxSuperBlockSizeInPixels *
+                          (kMaxSuperBlockSizeInPixels + kSubPixelTaps - 1)];
+  const int intermediate_height = height + vertical_taps - 1;
+
+  const ptrdiff_t src_stride = reference_stride >> 1;
+  const auto* const src = static_cast<const uint16_t*>(reference) -
+                          (vertical_taps / 2 - 1) * src_stride -
+                          kHorizontalOffset;
+  DoHorizontalPass</*is_compound=*/false, /*is_2d=*/true>(
+      src, src_stride, intermediate_result, width, width, intermediate_height,
+      horizontal_filter_id, horiz_filter_index);
+
+  auto* const dest = static_cast<uint16_t*>(prediction);
+  const ptrdiff_t dest_stride = is_compound ? width : pred_stride >> 1;
+  DoVerticalPass<is_compound, /*is_2d=*/true>(
+      intermediate_result, width, dest, dest_stride, width, height,
+      vertical_filter_id, vert_filter_index);
+}
+
+void Convolve2D_AVX2(const void* LIBGAV1_RESTRICT const reference,
+                     const ptrdiff_t reference_stride,
+                     const int horizontal_filter_index,
+                     const int vertical_filter_index,
+                     const int horizontal_filter_id,
+                     const int vertical_filter_id, const int width,
+                     const int height, void* LIBGAV1_RESTRICT prediction,
+                     const ptrdiff_t pred_stride) {
+  Convolve2D</*is_compound=*/false>(
+      reference, reference_stride, horizontal_filter_index,
+      vertical_filter_index, horizontal_filter_id, vertical_filter_id, width,
+      height, prediction, pred_stride);
+}
+
+void ConvolveCompound2D_AVX2(
+    const void* LIBGAV1_RESTRICT const reference,
+    const ptrdiff_t reference_stride, const int horizontal_filter_index,
+    const int vertical_filter_index, const int horizontal_filter_id,
+    const int vertical_filter_id, const int width, const int height,
+    void* LIBGAV1_RESTRICT prediction, const ptrdiff_t pred_stride) {
+  assert(width >= 4 && height >= 4);
+  Convolve2D</*is_compound=*/true>(
+      reference, reference_stride, horizontal_filter_index,
+      vertical_filter_index, horizontal_filter_id, vertical_filter_id, width,
+      height, prediction, pred_stride);
+}
+
+void Init10bpp() {
+  Dsp* const dsp = dsp_internal::GetWritableDspTable(kBitdepth10);
+  assert(dsp != nullptr);
+  dsp->convolve[0][0][0][1] = ConvolveHorizontal_AVX2;
+  dsp->convolve[0][0][1][0] = ConvolveVertical_AVX2;
+  dsp->convolve[0][0][1][1] = Convolve2D_AVX2;
+
+  dsp->convolve[0][1][0][1] = ConvolveCompoundHorizontal_AVX2;
+  dsp->convolve[0][1][1][0] = ConvolveCompoundVertical_AVX2;
+  dsp->convolve[0][1][1][1] = ConvolveCompound2D_AVX2;
+}
+
+}  // namespace
+
+void ConvolveInit10bpp_AVX2() { Init10bpp(); }
+
+}  // namespace dsp
+}  // namespace libgav1
+
+#else   // !(LIBGAV1_TARGETING_AVX2 && LIBGAV1_MAX_BITDEPTH >= 10)
+namespace libgav1 {
+namespace dsp {
+
+void ConvolveInit10bpp_AVX2() {}
+
+}  // namespace dsp
+}  // namespace libgav1
+#endif  // LIBGAV1_TARGETING_AVX2 && LIBGAV1_MAX_BITDEPTH >= 10
@@ -0,0 +1,305 @@
+// Copyright 2021 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/dsp/convolve.h"
+#include "src/utils/cpu.h"
+
+#if LIBGAV1_TARGETING_SSE4_1 && LIBGAV1_MAX_BITDEPTH >= 10
+#include <smmintrin.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "src/dsp/constants.h"
+#include "src/dsp/dsp.h"
+#include "src/dsp/x86/common_sse4.h"
+#include "src/utils/common.h"
+#include "src/utils/compiler_attributes.h"
+#include "src/utils/constants.h"
+
+namespace libgav1 {
+namespace dsp {
+namespace {
+
+#include "src/dsp/x86/convolve_10bit_sse4.inc"
+
+template <bool is_compound = false, bool is_2d = false>
+LIBGAV1_ALWAYS_INLINE void DoHorizontalPass(
+    const uint16_t* LIBGAV1_RESTRICT const src, const ptrdiff_t src_stride,
+    void* LIBGAV1_RESTRICT const dst, const ptrdiff_t dst_stride,
+    const int width, const int height, const int filter_id,
+    const int filter_index) {
+  assert(filter_id != 0);
+  const int8_t* const filter = kHalfSubPixelFilters[filter_index][filter_id];
+  __m128i v_tap[4];
+
+  if (filter_index == 2) {  // 8 tap.
+    SetupTaps<8>(filter, v_tap);
+    FilterHorizontal<8, is_compound, is_2d>(src, src_stride, dst, dst_stride,
+                                            width, height, v_tap);
+  } else if (filter_index < 2) {  // 6 tap.
+    SetupTaps<6>(filter, v_tap);
+    FilterHorizontal<6, is_compound, is_2d>(src + 1, src_stride, dst,
+                                            dst_stride, width, height, v_tap);
+  } else if (filter_index > 3) {  // 4 tap.
+    SetupTaps<4>(filter, v_tap);
+    FilterHorizontal<4, is_compound, is_2d>(src + 2, src_stride, dst,
+                                            dst_stride, width, height, v_tap);
+  } else {  // 2 tap.
+    SetupTaps<2>(filter, v_tap);
+    FilterHorizontal<2, is_compound, is_2d>(src + 3, src_stride, dst,
+                                            dst_stride, width, height, v_tap);
+  }
+}
+
+// |src| points to the outermost tap of the first row.
+template <bool is_compound = false, bool is_2d = false>
+LIBGAV1_ALWAYS_INLINE void DoVerticalPass(
+    const uint16_t* LIBGAV1_RESTRICT const src, const ptrdiff_t src_stride,
+    void* LIBGAV1_RESTRICT const dst, const ptrdiff_t dst_stride,
+    const int width, const int height, const int filter_id,
+    const int filter_index) {
+  assert(filter_id != 0);
+  const int8_t* const filter = kHalfSubPixelFilters[filter_index][filter_id];
+  __m128i v_tap[4];
+
+  if (filter_index == 2) {  // 8 tap.
+    SetupTaps<8>(filter, v_tap);
+    FilterVertical<8, is_compound, is_2d>(src, src_stride, dst, dst_stride,
+                                          width, height, v_tap);
+  } else if (filter_index < 2) {  // 6 tap.
+    SetupTaps<6>(filter, v_tap);
+    FilterVertical<6, is_compound, is_2d>(src, src_stride, dst, dst_stride,
+                                          width, height, v_tap);
+  } else if (filter_index > 3) {  // 4 tap.
+    SetupTaps<4>(filter, v_tap);
+    FilterVertical<4, is_compound, is_2d>(src, src_stride, dst, dst_stride,
+                                          width, height, v_tap);
+  } else {  // 2 tap.
+    SetupTaps<2>(filter, v_tap);
+    FilterVertical<2, is_compound, is_2d>(src, src_stride, dst, dst_stride,
+                                          width, height, v_tap);
+  }
+}
+
+void ConvolveHorizontal_SSE4_1(
+    const void* LIBGAV1_RESTRICT const reference,
+    const ptrdiff_t reference_stride, const int horizontal_filter_index,
+    const int /*vertical_filter_index*/, const int horizontal_filter_id,
+    const int /*vertical_filter_id*/, const int width, const int height,
+    void* LIBGAV1_RESTRICT prediction, const ptrdiff_t pred_stride) {
+  const int filter_index = GetFilterIndex(horizontal_filter_index, width);
+  // Set |src| to the outermost tap.
+  const auto* const src =
+      static_cast<const uint16_t*>(reference) - kHorizontalOffset;
+  auto* const dest = static_cast<uint16_t*>(prediction);
+  const ptrdiff_t src_stride = reference_stride >> 1;
+  const ptrdiff_t dest_stride = pred_stride >> 1;
+
+  DoHorizontalPass(src, src_stride, dest, dest_stride, width, height,
+                   horizontal_filter_id, filter_index);
+}
+
+void ConvolveCompoundHorizontal_SSE4_1(
+    const void* LIBGAV1_RESTRICT const reference,
+    const ptrdiff_t reference_stride, const int horizontal_filter_index,
+    const int /*vertical_filter_index*/, const int horizontal_filter_id,
+    const int /*vertical_filter_id*/, const int width, const int height,
+    void* LIBGAV1_RESTRICT prediction, const ptrdiff_t /*pred_stride*/) {
+  const int filter_index = GetFilterIndex(horizontal_filter_index, width);
+  const auto* const src =
+      static_cast<const uint16_t*>(reference) - kHorizontalOffset;
+  auto* const dest = static_cast<uint16_t*>(prediction);
+  const ptrdiff_t src_stride = reference_stride >> 1;
+  // All compound functions output to the predictor buffer with |pred_stride|
+  // equal to |width|.
+  assert(width >= 4 && height >= 4);
+
+  DoHorizontalPass</*is_compound=*/true>(src, src_stride, dest, width, width,
+                                         height, horizontal_filter_id,
+                                         filter_index);
+}
+
+void ConvolveVertical_SSE4_1(
+    const void* LIBGAV1_RESTRICT const reference,
+    const ptrdiff_t reference_stride, const int /*horizontal_filter_index*/,
+    const int vertical_filter_index, const int /*horizontal_filter_id*/,
+    const int vertical_filter_id, const int width, const int height,
+    void* LIBGAV1_RESTRICT prediction, const ptrdiff_t pred_stride) {
+  const int filter_index = GetFilterIndex(vertical_filter_index, height);
+  const int vertical_taps = GetNumTapsInFilter(filter_index);
+  const ptrdiff_t src_stride = reference_stride >> 1;
+  const auto* const src = static_cast<const uint16_t*>(reference) -
+                          (vertical_taps / 2 - 1) * src_stride;
+  auto* const dest = static_cast<uint16_t*>(prediction);
+  const ptrdiff_t dest_stride = pred_stride >> 1;
+
+  DoVerticalPass(src, src_stride, dest, dest_stride, width, height,
+                 vertical_filter_id, filter_index);
+}
+
+void ConvolveCompoundVertical_SSE4_1(
+    const void* LIBGAV1_RESTRICT const reference,
+    const ptrdiff_t reference_stride, const int /*horizontal_filter_index*/,
+    const int vertical_filter_index, const int /*horizontal_filter_id*/,
+    const int vertical_filter_id, const int width, const int height,
+    void* LIBGAV1_RESTRICT prediction, const ptrdiff_t /*pred_stride*/) {
+  const int filter_index = GetFilterIndex(vertical_filter_index, height);
+  const int vertical_taps = GetNumTapsInFilter(filter_index);
+  const ptrdiff_t src_stride = reference_stride >> 1;
+  const auto* const src = static_cast<const uint16_t*>(reference) -
+                          (vertical_taps / 2 - 1) * src_stride;
+  auto* const dest = static_cast<uint16_t*>(prediction);
+  assert(width >= 4 && height >= 4);
+
+  DoVerticalPass</*is_compound=*/true>(src, src_stride, dest, width, width,
+                                       height, vertical_filter_id,
+                                       filter_index);
+}
+
+template <bool is_compound>
+void Convolve2D(const void* LIBGAV1_RESTRICT const reference,
+                const ptrdiff_t reference_stride,
+                const int horizontal_filter_index,
+                const int vertical_filter_index,
+                const int horizontal_filter_id, const int vertical_filter_id,
+                const int width, const int height,
+                void* LIBGAV1_RESTRICT prediction,
+                const ptrdiff_t pred_stride) {
+  const int horiz_filter_index = GetFilterIndex(horizontal_filter_index, width);
+  const int vert_filter_index = GetFilterIndex(vertical_filter_index, height);
+  const int vertical_taps = GetNumTapsInFilter(vert_filter_index);
+
+  // The output of the horizontal filter is guaranteed to fit in int16_t and is
+  // stored with the same bit pattern in the uint16_t buffer. Only the rows read
+  // by the vertical filter are generated.
+  alignas(16) uint16_t
+      intermediate_result[kMaxSuperBlockSizeInPixels *
+                          (kMaxSuperBlockSizeInPixels + kSubPixelTaps - 1)];
+  const int intermediate_height = height + vertical_taps - 1;
+
+  const ptrdiff_t src_stride = reference_stride >> 1;
+  const auto* const src = static_cast<const uint16_t*>(reference) -
+                          (vertical_taps / 2 - 1) * src_stride -
+                          kHorizontalOffset;
+  DoHorizontalPass</*is_compound=*/false, /*is_2d=*/true>(
+      src, src_stride, intermediate_result, width, width, intermediate_height,
+      horizontal_filter_id, horiz_filter_index);
+
+  auto* const dest = static_cast<uint16_t*>(prediction);
+  const ptrdiff_t dest_stride = is_compound ? width : pred_stride >> 1;
+  DoVerticalPass<is_compound, /*is_2d=*/true>(
+      intermediate_result, width, dest, dest_stride, width, height,
+      vertical_filter_id, vert_filter_index);
+}
+
+void Convolve2D_SSE4_1(const void* LIBGAV1_RESTRICT const reference,
+                       const ptrdiff_t reference_stride,
+                       const int horizontal_filter_index,
+                       const int vertical_filter_index,
+                       const int horizontal_filter_id,
+                       const int vertical_filter_id, const int width,
+                       const int height, void* LIBGAV1_RESTRICT prediction,
+                       const ptrdiff_t pred_stride) {
+  Convolve2D</*is_compound=*/false>(
+      reference, reference_stride, horizontal_filter_index,
+      vertical_filter_index, horizontal_filter_id, vertical_filter_id, width,
+      height, prediction, pred_stride);
+}
+
+void ConvolveCompound2D_SSE4_1(
+    const void* LIBGAV1_RESTRICT const reference,
+    const ptrdiff_t reference_stride, const int horizontal_filter_index,
+    const int vertical_filter_index, const int horizontal_filter_id,
+    const int vertical_filter_id, const int width, const int height,
+    void* LIBGAV1_RESTRICT prediction, const ptrdiff_t pred_stride) {
+  assert(width >= 4 && height >= 4);
+  Convolve2D</*is_compound=*/true>(
+      reference, reference_stride, horizontal_filter_index,
+      vertical_filter_index, horizontal_filter_id, vertical_filter_id, width,
+      height, prediction, pred_stride);
+}
+
+void ConvolveCompoundCopy_SSE4_1(
+    const void* LIBGAV1_RESTRICT const reference,
+    const ptrdiff_t reference_stride, const int /*horizontal_filter_index*/,
+    const int /*vertical_filter_index*/, const int /*horizontal_filter_id*/,
+    const int /*vertical_filter_id*/, const int width, const int height,
+    void* LIBGAV1_RESTRICT prediction, const ptrdiff_t /*pred_stride*/) {
+  const auto* src = static_cast<const uint16_t*>(reference);
+  const ptrdiff_t src_stride = reference_stride >> 1;
+  auto* dest = static_cast<uint16_t*>(prediction);
+  constexpr int kRoundBitsVertical =
+      kInterRoundBitsVertical - kInterRoundBitsCompoundVertical;
+  // (src + (1 << 10) + (1 << 9)) << 4 fits in 16 bits.
+  const __m128i v_offset =
+      _mm_set1_epi16((1 << kBitdepth10) + (1 << (kBitdepth10 - 1)));
+  assert(width >= 4 && height >= 4);
+
+  int y = height;
+  if (width >= 8) {
+    do {
+      int x = 0;
+      do {
+        const __m128i v_src = LoadUnaligned16(&src[x]);
+        StoreUnaligned16(&dest[x], _mm_slli_epi16(_mm_add_epi16(v_src, v_offset),
+                                                  kRoundBitsVertical));
+        x += 8;
+      } while (x < width);
+      src += src_stride;
+      dest += width;
+    } while (--y != 0);
+    return;
+  }
+
+  do {
+    const __m128i v_src = LoadHi8(LoadLo8(&src[0]), &src[src_stride]);
+    StoreUnaligned16(&dest[0], _mm_slli_epi16(_mm_add_epi16(v_src, v_offset),
+                                              kRoundBitsVertical));
+    src += src_stride << 1;
+    dest += 8;
+    y -= 2;
+  } while (y != 0);
+}
+
+void Init10bpp() {
+  Dsp* const dsp = dsp_internal::GetWritableDspTable(kBitdepth10);
+  assert(dsp != nullptr);
+  dsp->convolve[0][0][0][1] = ConvolveHorizontal_SSE4_1;
+  dsp->convolve[0][0][1][0] = ConvolveVertical_SSE4_1;
+  dsp->convolve[0][0][1][1] = Convolve2D_SSE4_1;
+
+  dsp->convolve[0][1][0][0] = ConvolveCompoundCopy_SSE4_1;
+  dsp->convolve[0][1][0][1] = ConvolveCompoundHorizontal_SSE4_1;
+  dsp->convolve[0][1][1][0] = ConvolveCompoundVertical_SSE4_1;
+  dsp->convolve[0][1][1][1] = ConvolveCompound2D_SSE4_1;
+}
+
+}  // namespace
+
+void ConvolveInit10bpp_SSE4_1() { Init10bpp(); }
+
+}  // namespace dsp
+}  // namespace libgav1
+
+#else   // !(LIBGAV1_TARGETING_SSE4_1 && LIBGAV1_MAX_BITDEPTH >= 10)
+namespace libgav1 {
+namespace dsp {
+
+void ConvolveInit10bpp_SSE4_1() {}
+
+}  // namespace dsp
+}  // namespace libgav1
+#endif  // LIBGAV1_TARGETING_SSE4_1 && LIBGAV1_MAX_BITDEPTH >= 10
@@ -0,0 +1,220 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the 10bpp SSE4.1 and AVX2 convolves (convolve_10bit_sse4.cc and
+// convolve_10bit_avx2.cc) with the C ones: every function a tier installs,
+// for each block size a 10-bit stream predicts, every filter type and random
+// filter ids, on random and extreme pixels.
+//
+// The SIMD functions are reached through their Init functions, so this file
+// is built without SIMD flags and each tier is skipped on CPUs without it.
+
+#include "src/dsp/convolve.h"
+
+#include "gtest/gtest.h"
+#include "src/utils/cpu.h"
+
+#if LIBGAV1_ENABLE_SSE4_1 && LIBGAV1_MAX_BITDEPTH >= 10
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "src/dsp/dsp.h"
+#include "src/dsp/x86/convolve_avx2.h"
+#include "src/dsp/x86/convolve_sse4.h"
+#include "src/utils/constants.h"
+
+namespace libgav1 {
+namespace dsp {
+namespace {
+
+struct ConvolveTier {
+  const char* name;
+  CpuFeatures feature;
+  void (*init)();
+};
+
+const ConvolveTier kConvolveTiers[] = {
+    {"SSE4_1", kSSE4_1, ConvolveInit10bpp_SSE4_1},
+    {"AVX2", kAVX2, ConvolveInit10bpp_AVX2}};
+
+// Every luma block size and the 4:2:0 chroma block of each, which goes down
+// to 2x2.
+std::vector<std::pair<int, int>> BlockDimensions() {
+  std::vector<std::pair<int, int>> dimensions;
+  for (int size = 0; size < kMaxBlockSizes; ++size) {
+    const int width = kBlockWidthPixels[size];
+    const int height = kBlockHeightPixels[size];
+    for (const auto& dimension :
+         {std::make_pair(width, height),
+          std::make_pair(width >> 1, height >> 1)}) {
+      if (std::find(dimensions.begin(), dimensions.end(), dimension) ==
+          dimensions.end()) {
+        dimensions.push_back(dimension);
+      }
+    }
+  }
+  return dimensions;
+}
+
+class Convolve10bppTest : public testing::TestWithParam<ConvolveTier> {
+ protected:
+  // The reference block has room for the 8-tap filters and for SIMD loads
+  // that read past the end of a row.
+  static constexpr int kBorder = 32;
+  static constexpr int kMaxBlockSize = 128;
+  static constexpr int kSourceStride = kMaxBlockSize + 2 * kBorder;
+  static constexpr int kDestStride = kMaxBlockSize + 16;
+  static constexpr int kPixelMax = (1 << kBitdepth10) - 1;
+
+  void SetUp() override {
+    if ((GetCpuInfo() & GetParam().feature) == 0) {
+      GTEST_SKIP() << GetParam().name << " is not supported by this CPU.";
+    }
+    DspInit();
+    // convolve.cc is built without SIMD flags, so ConvolveInit_C() installs
+    // every C function. The tier then replaces the ones it has.
+    ConvolveInit_C();
+    memcpy(c_, GetDspTable(kBitdepth10)->convolve, sizeof(c_));
+    GetParam().init();
+    memcpy(simd_, GetDspTable(kBitdepth10)->convolve, sizeof(simd_));
+  }
+
+  // Pixels are random on even iterations and either 0 or the maximum on odd
+  // ones, which drives the filter sums to their extremes.
+  void FillSource(int iteration) {
+    std::uniform_int_distribution<int> pixel(0, kPixelMax);
+    std::uniform_int_distribution<int> extreme(0, 1);
+    for (auto& value : source_) {
+      value = static_cast<uint16_t>(
+          ((iteration & 1) == 0) ? pixel(rng_) : extreme(rng_) * kPixelMax);
+    }
+  }
+
+  void TestFunction(bool is_compound, bool has_vertical_filter,
+                    bool has_horizontal_filter, int width, int height);
+
+  ConvolveFuncs c_;
+  ConvolveFuncs simd_;
+  std::vector<uint16_t> source_ =
+      std::vector<uint16_t>(kSourceStride * kSourceStride);
+  std::mt19937 rng_{kBitdepth10};
+};
+
+void Convolve10bppTest::TestFunction(bool is_compound,
+                                     bool has_vertical_filter,
+                                     bool has_horizontal_filter, int width,
+                                     int height) {
+  const ConvolveFunc c_func =
+      c_[0][is_compound][has_vertical_filter][has_horizontal_filter];
+  const ConvolveFunc simd_func =
+      simd_[0][is_compound][has_vertical_filter][has_horizontal_filter];
+  const uint16_t* const reference =
+      source_.data() + kBorder * kSourceStride + kBorder;
+  // Compound predictions are packed with a stride of |width| uint16_t. The
+  // others are Pixels with a stride in bytes.
+  const ptrdiff_t dest_stride = is_compound ? width : kDestStride;
+  const ptrdiff_t pred_stride =
+      is_compound ? width : kDestStride * sizeof(uint16_t);
+  std::vector<uint16_t> c_dest(kDestStride * kMaxBlockSize);
+  std::vector<uint16_t> simd_dest(kDestStride * kMaxBlockSize);
+  std::uniform_int_distribution<int> filter_id(1, kSubPixelMask);
+  const int num_horizontal_filters =
+      has_horizontal_filter ? kNumInterpolationFilters - 1 : 1;
+  const int num_vertical_filters =
+      has_vertical_filter ? kNumInterpolationFilters - 1 : 1;
+  for (int horizontal_filter = 0; horizontal_filter < num_horizontal_filters;
+       ++horizontal_filter) {
+    for (int vertical_filter = 0; vertical_filter < num_vertical_filters;
+         ++vertical_filter) {
+      for (int iteration = 0; iteration < 2; ++iteration) {
+        FillSource(iteration);
+        const int horizontal_filter_id =
+            has_horizontal_filter ? filter_id(rng_) : 0;
+        const int vertical_filter_id =
+            has_vertical_filter ? filter_id(rng_) : 0;
+        std::fill(c_dest.begin(), c_dest.end(), 0);
+        std::fill(simd_dest.begin(), simd_dest.end(), 0);
+        c_func(reference, kSourceStride * sizeof(uint16_t), horizontal_filter,
+               vertical_filter, horizontal_filter_id, vertical_filter_id,
+               width, height, c_dest.data(), pred_stride);
+        simd_func(reference, kSourceStride * sizeof(uint16_t),
+                  horizontal_filter, vertical_filter, horizontal_filter_id,
+                  vertical_filter_id, width, height, simd_dest.data(),
+                  pred_stride);
+        for (int y = 0; y < height; ++y) {
+          const uint16_t* const c_row = c_dest.data() + y * dest_stride;
+          const uint16_t* const simd_row = simd_dest.data() + y * dest_stride;
+          ASSERT_TRUE(std::equal(c_row, c_row + width, simd_row))
+              << width << "x" << height << (is_compound ? " compound" : "")
+              << ", filters " << horizontal_filter << "/" << vertical_filter
+              << ", ids " << horizontal_filter_id << "/" << vertical_filter_id
+              << ", row " << y << ", iteration " << iteration;
+        }
+      }
+    }
+  }
+}
+
+TEST_P(Convolve10bppTest, MatchesC) {
+  int num_simd = 0;
+  for (const auto& dimension : BlockDimensions()) {
+    const int width = dimension.first;
+    const int height = dimension.second;
+    for (int is_compound = 0; is_compound < 2; ++is_compound) {
+      // Compound prediction needs blocks of at least 8x8, so chroma blocks of
+      // at least 4x4.
+      if (is_compound == 1 && (width < 4 || height < 4)) continue;
+      for (int vertical = 0; vertical < 2; ++vertical) {
+        for (int horizontal = 0; horizontal < 2; ++horizontal) {
+          if (simd_[0][is_compound][vertical][horizontal] ==
+              c_[0][is_compound][vertical][horizontal]) {
+            continue;
+          }
+          ++num_simd;
+          TestFunction(is_compound == 1, vertical == 1, horizontal == 1, width,
+                       height);
+          if (HasFatalFailure()) return;
+        }
+      }
+    }
+  }
+  // Make sure that the SIMD functions were installed and compared.
+  EXPECT_GT(num_simd, 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(X86, Convolve10bppTest,
+                         testing::ValuesIn(kConvolveTiers),
+                         [](const testing::TestParamInfo<ConvolveTier>& info) {
+                           return std::string(info.param.name);
+                         });
+
+}  // namespace
+}  // namespace dsp
+}  // namespace libgav1
+
+#else  // !(LIBGAV1_ENABLE_SSE4_1 && LIBGAV1_MAX_BITDEPTH >= 10)
+
+TEST(Convolve10bppTest, X86) {
+  GTEST_SKIP() << "Build this module for x86(-64) with 10-bit support to "
+                  "enable the tests.";
+}
+
+#endif  // LIBGAV1_ENABLE_SSE4_1 && LIBGAV1_MAX_BITDEPTH >= 10
@@ -0,0 +1,323 @@
+// Copyright 2021 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/dsp/convolve.h"
+#include "src/utils/cpu.h"
+
+#if LIBGAV1_TARGETING_AVX512
+#include <immintrin.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "src/dsp/constants.h"
+#include "src/dsp/dsp.h"
+#include "src/dsp/x86/common_avx512.h"
+#include "src/utils/common.h"
+#include "src/utils/constants.h"
+
+namespace libgav1 {
+namespace dsp {
+namespace low_bitdepth {
+namespace {
+
+#include "src/dsp/convolve.inc"
+
+// The 2D functions registered by ConvolveInit_AVX2(), used for blocks narrower
+// than 32.
+ConvolveFunc convolve_2d_avx2;
+ConvolveFunc convolve_compound_2d_avx2;
+
+// Each 128-bit lane k holds bytes 8k to 8k + 15 of |src|, which are the inputs
+// of outputs 8k to 8k + 7.
+inline __m512i LoadHorizontalSource(const uint8_t* const src) {
+  const __m512i s = LoadBytes(src, 40);
+  return _mm512_permutexvar_epi64(_mm512_setr_epi64(0, 1, 1, 2, 2, 3, 3, 4),
+                                  s);
+}
+
+// See SumHorizontalTaps() in convolve_avx2.cc. The filters in |taps[]| are
+// pre-shifted by 1. This prevents the final sum from outranging int16_t.
+template <int filter_index>
+__m512i SumHorizontalTaps(const __m512i src, const __m512i* const taps) {
+  const __m512i src_dup_lo = _mm512_unpacklo_epi8(src, src);
+  const __m512i src_dup_hi = _mm512_unpackhi_epi8(src, src);
+  __m512i sum;
+  if (filter_index < 2) {
+    // 6 taps.
+    const __m512i v_madd_21 = _mm512_maddubs_epi16(
+        _mm512_alignr_epi8(src_dup_hi, src_dup_lo, 3), taps[0]);  // k2k1
+    const __m512i v_madd_43 = _mm512_maddubs_epi16(
+        _mm512_alignr_epi8(src_dup_hi, src_dup_lo, 7), taps[1]);  // k4k3
+    const __m512i v_madd_65 = _mm512_maddubs_epi16(
+        _mm512_alignr_epi8(src_dup_hi, src_dup_lo, 11), taps[2]);  // k6k5
+    sum = _mm512_add_epi16(v_madd_21, v_madd_43);
+    sum = _mm512_add_epi16(sum, v_madd_65);
+  } else if (filter_index == 2) {
+    // 8 taps.
+    const __m512i v_madd_10 = _mm512_maddubs_epi16(
+        _mm512_alignr_epi8(src_dup_hi, src_dup_lo, 1), taps[0]);  // k1k0
+    const __m512i v_madd_32 = _mm512_maddubs_epi16(
+        _mm512_alignr_epi8(src_dup_hi, src_dup_lo, 5), taps[1]);  // k3k2
+    const __m512i v_madd_54 = _mm512_maddubs_epi16(
+        _mm512_alignr_epi8(src_dup_hi, src_dup_lo, 9), taps[2]);  // k5k4
+    const __m512i v_madd_76 = _mm512_maddubs_epi16(
+        _mm512_alignr_epi8(src_dup_hi, src_dup_lo, 13), taps[3]);  // k7k6
+    const __m512i v_sum_3210 = _mm512_add_epi16(v_madd_10, v_madd_32);
+    const __m512i v_sum_7654 = _mm512_add_epi16(v_madd_54, v_madd_76);
+    sum = _mm512_add_epi16(v_sum_7654, v_sum_3210);
+  } else if (filter_index == 3) {
+    // 2 taps.
+    sum = _mm512_maddubs_epi16(_mm512_alignr_epi8(src_dup_hi, src_dup_lo, 7),
+                               taps[0]);  // k4k3
+  } else {
+    // 4 taps.
+    const __m512i v_madd_32 = _mm512_maddubs_epi16(
+        _mm512_alignr_epi8(src_dup_hi, src_dup_lo, 5), taps[0]);  // k3k2
+    const __m512i v_madd_54 = _mm512_maddubs_epi16(
+        _mm512_alignr_epi8(src_dup_hi, src_dup_lo, 9), taps[1]);  // k5k4
+    sum = _mm512_add_epi16(v_madd_32, v_madd_54);
+  }
+  return sum;
+}
+
+template <int filter_index>
+void FilterHorizontal32xH(const uint8_t* LIBGAV1_RESTRICT src,
+                          const ptrdiff_t src_stride,
+                          uint16_t* LIBGAV1_RESTRICT dest, const int width,
+                          const int height, const __m512i* const taps) {
+  int y = height;
+  do {
+    int x = 0;
+    do {
+      const __m512i sum =
+          SumHorizontalTaps<filter_index>(LoadHorizontalSource(src + x), taps);
+      StoreUnaligned64(dest + x, RightShiftWithRounding_S16(
+                                     sum, kInterRoundBitsHorizontal - 1));
+      x += 32;
+    } while (x < width);
+    src += src_stride;
+    dest += width;
+  } while (--y != 0);
+}
+
+void DoHorizontalPass(const uint8_t* LIBGAV1_RESTRICT const src,
+                      const ptrdiff_t src_stride,
+                      uint16_t* LIBGAV1_RESTRICT const dst, const int width,
+                      const int height, const int filter_id,
+                      const int filter_index) {
+  assert(filter_id != 0);
+  const int8_t* const filter = kHalfSubPixelFilters[filter_index][filter_id];
+  const auto pair = [filter](const int k) {
+    return _mm512_set1_epi16(static_cast<int16_t>(
+        static_cast<uint8_t>(filter[k]) |
+        (static_cast<uint8_t>(filter[k + 1]) << 8)));
+  };
+  __m512i taps[4];
+  if (filter_index == 2) {  // 8 tap.
+    taps[0] = pair(0);
+    taps[1] = pair(2);
+    taps[2] = pair(4);
+    taps[3] = pair(6);
+    FilterHorizontal32xH<2>(src, src_stride, dst, width, height, taps);
+  } else if (filter_index < 2) {  // 6 tap.
+    taps[0] = pair(1);
+    taps[1] = pair(3);
+    taps[2] = pair(5);
+    if (filter_index == 1) {
+      FilterHorizontal32xH<1>(src, src_stride, dst, width, height, taps);
+    } else {
+      FilterHorizontal32xH<0>(src, src_stride, dst, width, height, taps);
+    }
+  } else if (filter_index > 3) {  // 4 tap.
+    taps[0] = pair(2);
+    taps[1] = pair(4);
+    if (filter_index == 4) {
+      FilterHorizontal32xH<4>(src, src_stride, dst, width, height, taps);
+    } else {
+      FilterHorizontal32xH<5>(src, src_stride, dst, width, height, taps);
+    }
+  } else {  // 2 tap.
+    taps[0] = pair(3);
+    FilterHorizontal32xH<3>(src, src_stride, dst, width, height, taps);
+  }
+}
+
+template <int num_taps, bool is_compound>
+__m512i SimpleSum2DVerticalTaps(const __m512i* const src,
+                                const __m512i* const taps) {
+  __m512i sum_lo =
+      _mm512_madd_epi16(_mm512_unpacklo_epi16(src[0], src[1]), taps[0]);
+  __m512i sum_hi =
+      _mm512_madd_epi16(_mm512_unpackhi_epi16(src[0], src[1]), taps[0]);
+  for (int i = 1; i < num_taps / 2; ++i) {
+    const __m512i lo = _mm512_unpacklo_epi16(src[2 * i], src[2 * i + 1]);
+    const __m512i hi = _mm512_unpackhi_epi16(src[2 * i], src[2 * i + 1]);
+    sum_lo = _mm512_add_epi32(sum_lo, _mm512_madd_epi16(lo, taps[i]));
+    sum_hi = _mm512_add_epi32(sum_hi, _mm512_madd_epi16(hi, taps[i]));
+  }
+
+  constexpr int shift = is_compound ? kInterRoundBitsCompoundVertical - 1
+                                    : kInterRoundBitsVertical - 1;
+  return _mm512_packs_epi32(RightShiftWithRounding_S32(sum_lo, shift),
+                            RightShiftWithRounding_S32(sum_hi, shift));
+}
+
+template <int num_taps, bool is_compound>
+void Filter2DVertical32xH(const uint16_t* LIBGAV1_RESTRICT src,
+                          void* LIBGAV1_RESTRICT const dst,
+                          const ptrdiff_t dst_stride, const int width,
+                          const int height, const __m512i* const taps) {
+  assert(width >= 32);
+  constexpr int next_row = num_taps - 1;
+  // The Horizontal pass uses |width| as |stride| for the intermediate buffer.
+  const ptrdiff_t src_stride = width;
+
+  auto* dst8 = static_cast<uint8_t*>(dst);
+  auto* dst16 = static_cast<uint16_t*>(dst);
+
+  int x = 0;
+  do {
+    __m512i srcs[8];
+    const uint16_t* src_x = src + x;
+    for (int i = 0; i < next_row; ++i) {
+      srcs[i] = LoadUnaligned64(src_x);
+      src_x += src_stride;
+    }
+
+    auto* dst8_x = dst8 + x;
+    auto* dst16_x = dst16 + x;
+    int y = height;
+    do {
+      srcs[next_row] = LoadUnaligned64(src_x);
+      src_x += src_stride;
+
+      const __m512i sum =
+          SimpleSum2DVerticalTaps<num_taps, is_compound>(srcs, taps);
+      if (is_compound) {
+        StoreUnaligned64(dst16_x, sum);
+        dst16_x += dst_stride;
+      } else {
+        StoreUnaligned32(dst8_x, _mm512_cvtusepi16_epi8(_mm512_max_epi16(
+                                     sum, _mm512_setzero_si512())));
+        dst8_x += dst_stride;
+      }
+
+      for (int i = 0; i < next_row; ++i) srcs[i] = srcs[i + 1];
+    } while (--y != 0);
+    x += 32;
+  } while (x < width);
+}
+
+template <bool is_compound>
+void DoVerticalPass(const uint16_t* LIBGAV1_RESTRICT const src,
+                    void* LIBGAV1_RESTRICT const dst,
+                    const ptrdiff_t dst_stride, const int width,
+                    const int height, const int filter_id,
+                    const int filter_index, const int num_taps) {
+  assert(filter_id != 0);
+  const int8_t* const filter = kHalfSubPixelFilters[filter_index][filter_id];
+  // Pairs of taps, starting with the first nonzero tap for |num_taps|.
+  const int first_tap = (8 - num_taps) >> 1;
+  __m512i taps[4];
+  for (int i = 0; i < num_taps / 2; ++i) {
+    const int k = first_tap + 2 * i;
+    taps[i] = _mm512_set1_epi32(static_cast<int>(
+        static_cast<uint16_t>(filter[k]) |
+        (static_cast<uint32_t>(static_cast<uint16_t>(filter[k + 1])) << 16)));
+  }
+  if (num_taps == 8) {
+    Filter2DVertical32xH<8, is_compound>(src, dst, dst_stride, width, height,
+                                         taps);
+  } else if (num_taps == 6) {
+    Filter2DVertical32xH<6, is_compound>(src, dst, dst_stride, width, height,
+                                         taps);
+  } else if (num_taps == 4) {
+    Filter2DVertical32xH<4, is_compound>(src, dst, dst_stride, width, height,
+                                         taps);
+  } else {  // |num_taps| == 2
+    Filter2DVertical32xH<2, is_compound>(src, dst, dst_stride, width, height,
+                                         taps);
+  }
+}
+
+// The AVX2 version filters 16 values per register in the vertical pass. Here
+// both passes produce 32 values per register, so blocks narrower than 32 are
+// left to the AVX2 version.
+template <bool is_compound>
+void Convolve2D_AVX512(const void* LIBGAV1_RESTRICT const reference,
+                       const ptrdiff_t reference_stride,
+                       const int horizontal_filter_index,
+                       const int vertical_filter_index,
+                       const int horizontal_filter_id,
+                       const int vertical_filter_id, const int width,
+                       const int height, void* LIBGAV1_RESTRICT prediction,
+                       const ptrdiff_t pred_stride) {
+  if (width < 32) {
+    const ConvolveFunc convolve_2d =
+        is_compound ? convolve_compound_2d_avx2 : convolve_2d_avx2;
+    convolve_2d(reference, reference_stride, horizontal_filter_index,
+                vertical_filter_index, horizontal_filter_id,
+                vertical_filter_id, width, height, prediction, pred_stride);
+    return;
+  }
+  const int horiz_filter_index = GetFilterIndex(horizontal_filter_index, width);
+  const int vert_filter_index = GetFilterIndex(vertical_filter_index, height);
+  const int vertical_taps = GetNumTapsInFilter(vert_filter_index);
+
+  // The output of the horizontal filter is guaranteed to fit in 16 bits.
+  alignas(64) uint16_t
+      intermediate_result[kMaxSuperBlockSizeInPixels *
+                          (kMaxSuperBlockSizeInPixels + kSubPixelTaps - 1)];
+  const int intermediate_height = height + vertical_taps - 1;
+
+  const ptrdiff_t src_stride = reference_stride;
+  const auto* src = static_cast<const uint8_t*>(reference) -
+                    (vertical_taps / 2 - 1) * src_stride - kHorizontalOffset;
+  DoHorizontalPass(src, src_stride, intermediate_result, width,
+                   intermediate_height, horizontal_filter_id,
+                   horiz_filter_index);
+  DoVerticalPass<is_compound>(intermediate_result, prediction, pred_stride,
+                              width, height, vertical_filter_id,
+                              vert_filter_index, vertical_taps);
+}
+
+void Init8bpp() {
+  Dsp* const dsp = dsp_internal::GetWritableDspTable(kBitdepth8);
+  assert(dsp != nullptr);
+  // ConvolveInit_AVX2() sets these entries unconditionally.
+  convolve_2d_avx2 = dsp->convolve[0][0][1][1];
+  convolve_compound_2d_avx2 = dsp->convolve[0][1][1][1];
+  dsp->convolve[0][0][1][1] = Convolve2D_AVX512</*is_compound=*/false>;
+  dsp->convolve[0][1][1][1] = Convolve2D_AVX512</*is_compound=*/true>;
+}
+
+}  // namespace
+}  // namespace low_bitdepth
+
+void ConvolveInit_AVX512() { low_bitdepth::Init8bpp(); }
+
+}  // namespace dsp
+}  // namespace libgav1
+
+#else   // !LIBGAV1_TARGETING_AVX512
+namespace libgav1 {
+namespace dsp {
+
+void ConvolveInit_AVX512() {}
+
+}  // namespace dsp
+}  // namespace libgav1
+#endif  // LIBGAV1_TARGETING_AVX512
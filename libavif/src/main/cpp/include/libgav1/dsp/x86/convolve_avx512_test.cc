@@ -0,0 +1,191 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the 8bpp AVX-512 2D and compound 2D convolves (convolve_avx512.cc)
+// with the C ones, for each block size an 8-bit stream predicts, including
+// those narrower than 32 that fall back to AVX2, every filter type and random
+// filter ids, on random and extreme pixels.
+//
+// The AVX-512 functions are reached through their Init function, so this file
+// is built without SIMD flags and the tests are skipped on CPUs without
+// AVX-512.
+
+#include "src/dsp/convolve.h"
+
+#include "gtest/gtest.h"
+#include "src/utils/cpu.h"
+
+#if LIBGAV1_ENABLE_AVX512
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "src/dsp/dsp.h"
+#include "src/dsp/x86/convolve_avx2.h"
+#include "src/dsp/x86/convolve_avx512.h"
+#include "src/dsp/x86/convolve_sse4.h"
+#include "src/utils/constants.h"
+
+namespace libgav1 {
+namespace dsp {
+namespace {
+
+// Every luma block size and the 4:2:0 chroma block of each, which goes down
+// to 2x2.
+std::vector<std::pair<int, int>> BlockDimensions() {
+  std::vector<std::pair<int, int>> dimensions;
+  for (int size = 0; size < kMaxBlockSizes; ++size) {
+    const int width = kBlockWidthPixels[size];
+    const int height = kBlockHeightPixels[size];
+    for (const auto& dimension :
+         {std::make_pair(width, height),
+          std::make_pair(width >> 1, height >> 1)}) {
+      if (std::find(dimensions.begin(), dimensions.end(), dimension) ==
+          dimensions.end()) {
+        dimensions.push_back(dimension);
+      }
+    }
+  }
+  return dimensions;
+}
+
+class ConvolveAvx512Test : public testing::Test {
+ protected:
+  // The reference block has room for the 8-tap filters and for SIMD loads
+  // that read past the end of a row.
+  static constexpr int kBorder = 32;
+  static constexpr int kMaxBlockSize = 128;
+  static constexpr int kSourceStride = kMaxBlockSize + 2 * kBorder;
+  static constexpr int kDestStride = kMaxBlockSize + 16;
+  static constexpr int kPixelMax = (1 << kBitdepth8) - 1;
+
+  void SetUp() override {
+    if ((GetCpuInfo() & kAVX512) == 0) {
+      GTEST_SKIP() << "AVX-512 is not supported by this CPU.";
+    }
+    DspInit();
+    // convolve.cc is built without SIMD flags, so ConvolveInit_C() installs
+    // every C function. ConvolveInit_AVX512() keeps the AVX2 2D functions for
+    // the narrow blocks, so the tiers are installed in the DspInit() order.
+    ConvolveInit_C();
+    memcpy(c_, GetDspTable(kBitdepth8)->convolve, sizeof(c_));
+    ConvolveInit_SSE4_1();
+    ConvolveInit_AVX2();
+    memcpy(avx2_, GetDspTable(kBitdepth8)->convolve, sizeof(avx2_));
+    ConvolveInit_AVX512();
+    memcpy(simd_, GetDspTable(kBitdepth8)->convolve, sizeof(simd_));
+  }
+
+  // Pixels are random on even iterations and either 0 or the maximum on odd
+  // ones, which drives the filter sums to their extremes.
+  void FillSource(int iteration) {
+    std::uniform_int_distribution<int> pixel(0, kPixelMax);
+    std::uniform_int_distribution<int> extreme(0, 1);
+    for (auto& value : source_) {
+      value = static_cast<uint8_t>(
+          ((iteration & 1) == 0) ? pixel(rng_) : extreme(rng_) * kPixelMax);
+    }
+  }
+
+  void Test2D(bool is_compound, int width, int height);
+
+  ConvolveFuncs c_;
+  ConvolveFuncs avx2_;
+  ConvolveFuncs simd_;
+  std::vector<uint8_t> source_ =
+      std::vector<uint8_t>(kSourceStride * kSourceStride);
+  std::mt19937 rng_{kBitdepth8};
+};
+
+void ConvolveAvx512Test::Test2D(bool is_compound, int width, int height) {
+  const ConvolveFunc c_func = c_[0][is_compound][1][1];
+  const ConvolveFunc simd_func = simd_[0][is_compound][1][1];
+  const uint8_t* const reference =
+      source_.data() + kBorder * kSourceStride + kBorder;
+  // Compound predictions are uint16_t with a stride of |width|. The others
+  // are uint8_t with a stride of kDestStride.
+  const size_t element_size = is_compound ? sizeof(uint16_t) : 1;
+  const ptrdiff_t pred_stride = is_compound ? width : kDestStride;
+  const ptrdiff_t row_bytes = pred_stride * element_size;
+  std::vector<uint16_t> c_dest(kDestStride * kMaxBlockSize);
+  std::vector<uint16_t> simd_dest(kDestStride * kMaxBlockSize);
+  const auto* const c_bytes = reinterpret_cast<const uint8_t*>(c_dest.data());
+  const auto* const simd_bytes =
+      reinterpret_cast<const uint8_t*>(simd_dest.data());
+  std::uniform_int_distribution<int> filter_id(1, kSubPixelMask);
+  for (int horizontal_filter = 0;
+       horizontal_filter < kNumInterpolationFilters - 1; ++horizontal_filter) {
+    for (int vertical_filter = 0;
+         vertical_filter < kNumInterpolationFilters - 1; ++vertical_filter) {
+      for (int iteration = 0; iteration < 2; ++iteration) {
+        FillSource(iteration);
+        const int horizontal_filter_id = filter_id(rng_);
+        const int vertical_filter_id = filter_id(rng_);
+        std::fill(c_dest.begin(), c_dest.end(), 0);
+        std::fill(simd_dest.begin(), simd_dest.end(), 0);
+        c_func(reference, kSourceStride, horizontal_filter, vertical_filter,
+               horizontal_filter_id, vertical_filter_id, width, height,
+               c_dest.data(), pred_stride);
+        simd_func(reference, kSourceStride, horizontal_filter, vertical_filter,
+                  horizontal_filter_id, vertical_filter_id, width, height,
+                  simd_dest.data(), pred_stride);
+        for (int y = 0; y < height; ++y) {
+          ASSERT_TRUE(std::equal(c_bytes + y * row_bytes,
+                                 c_bytes + y * row_bytes + width * element_size,
+                                 simd_bytes + y * row_bytes))
+              << width << "x" << height << (is_compound ? " compound" : "")
+              << ", filters " << horizontal_filter << "/" << vertical_filter
+              << ", ids " << horizontal_filter_id << "/" << vertical_filter_id
+              << ", row " << y << ", iteration " << iteration;
+        }
+      }
+    }
+  }
+}
+
+TEST_F(ConvolveAvx512Test, Convolve2D8bpp) {
+  int num_avx512 = 0;
+  for (int is_compound = 0; is_compound < 2; ++is_compound) {
+    if (simd_[0][is_compound][1][1] == avx2_[0][is_compound][1][1]) continue;
+    ++num_avx512;
+    for (const auto& dimension : BlockDimensions()) {
+      const int width = dimension.first;
+      const int height = dimension.second;
+      // Compound prediction needs blocks of at least 8x8, so chroma blocks of
+      // at least 4x4.
+      if (is_compound == 1 && (width < 4 || height < 4)) continue;
+      Test2D(is_compound == 1, width, height);
+      if (HasFatalFailure()) return;
+    }
+  }
+  // Make sure that the AVX-512 functions were installed and compared.
+  EXPECT_GT(num_avx512, 0);
+}
+
+}  // namespace
+}  // namespace dsp
+}  // namespace libgav1
+
+#else  // !LIBGAV1_ENABLE_AVX512
+
+TEST(ConvolveAvx512Test, X86) {
+  GTEST_SKIP() << "Build this module for x86(-64) to enable the tests.";
+}
+
+#endif  // LIBGAV1_ENABLE_AVX512
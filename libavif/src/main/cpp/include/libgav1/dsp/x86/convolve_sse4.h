@@ -23,9 +23,10 @@
 namespace libgav1 {
 namespace dsp {
 
-// Initializes Dsp::convolve, see the defines below for specifics. This
-// function is not thread-safe.
+// Initializes Dsp::convolve, see the defines below for specifics. These
+// functions are not thread-safe.
 void ConvolveInit_SSE4_1();
+void ConvolveInit10bpp_SSE4_1();
 
 }  // namespace dsp
 }  // namespace libgav1
@@ -70,6 +71,34 @@ void ConvolveInit_SSE4_1();
 #define LIBGAV1_Dsp8bpp_ConvolveCompoundScale2D LIBGAV1_CPU_SSE4_1
 #endif
 
+#ifndef LIBGAV1_Dsp10bpp_ConvolveHorizontal
+#define LIBGAV1_Dsp10bpp_ConvolveHorizontal LIBGAV1_CPU_SSE4_1
+#endif
+
+#ifndef LIBGAV1_Dsp10bpp_ConvolveVertical
+#define LIBGAV1_Dsp10bpp_ConvolveVertical LIBGAV1_CPU_SSE4_1
+#endif
+
+#ifndef LIBGAV1_Dsp10bpp_Convolve2D
+#define LIBGAV1_Dsp10bpp_Convolve2D LIBGAV1_CPU_SSE4_1
+#endif
+
+#ifndef LIBGAV1_Dsp10bpp_ConvolveCompoundCopy
+#define LIBGAV1_Dsp10bpp_ConvolveCompoundCopy LIBGAV1_CPU_SSE4_1
+#endif
+
+#ifndef LIBGAV1_Dsp10bpp_ConvolveCompoundHorizontal
+#define LIBGAV1_Dsp10bpp_ConvolveCompoundHorizontal LIBGAV1_CPU_SSE4_1
+#endif
+
+#ifndef LIBGAV1_Dsp10bpp_ConvolveCompoundVertical
+#define LIBGAV1_Dsp10bpp_ConvolveCompoundVertical LIBGAV1_CPU_SSE4_1
+#endif
+
+#ifndef LIBGAV1_Dsp10bpp_ConvolveCompound2D
+#define LIBGAV1_Dsp10bpp_ConvolveCompound2D LIBGAV1_CPU_SSE4_1
+#endif
+
 #endif  // LIBGAV1_TARGETING_SSE4_1
 
 #endif  // LIBGAV1_SRC_DSP_X86_CONVOLVE_SSE4_H_
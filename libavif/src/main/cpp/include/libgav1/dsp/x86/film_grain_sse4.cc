@@ -18,6 +18,7 @@
 #if LIBGAV1_TARGETING_SSE4_1
 #include <smmintrin.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -31,6 +32,7 @@
 #include "src/utils/common.h"
 #include "src/utils/compiler_attributes.h"
 #include "src/utils/logging.h"
+#include "src/utils/memory.h"
 
 namespace libgav1 {
 namespace dsp {
@@ -309,6 +311,446 @@ void BlendNoiseWithImageChromaWithCfl_SSE4_1(
       source_stride_y, in_uv, source_stride_uv, out_uv, dest_stride_uv);
 }
 
+
+// Load 16 values from source, widening to int16_t intermediate value size.
+template <typename GrainType>
+inline void LoadSource16(const GrainType* src, __m128i* lo, __m128i* hi) {
+  *lo = LoadSource(src);
+  *hi = LoadSource(src + 8);
+}
+
+// Store 8 values to dest, narrowing to int8_t with saturation.
+inline void StoreSigned(int8_t* dest, const __m128i data) {
+  StoreLo8(dest, _mm_packs_epi16(data, data));
+}
+
+#if LIBGAV1_MAX_BITDEPTH >= 10
+// Store 8 values to dest.
+inline void StoreSigned(int16_t* dest, const __m128i data) {
+  StoreUnaligned16(dest, data);
+}
+#endif  // LIBGAV1_MAX_BITDEPTH >= 10
+
+// Computes subsampled luma for use with chroma, by averaging in the x direction
+// or y direction when applicable.
+template <typename GrainType>
+inline __m128i GetSubsampledLuma(const GrainType* const luma, int subsampling_x,
+                                 int subsampling_y, ptrdiff_t stride) {
+  if (subsampling_y != 0) {
+    assert(subsampling_x != 0);
+    __m128i src0_lo, src0_hi, src1_lo, src1_hi;
+    LoadSource16(luma, &src0_lo, &src0_hi);
+    LoadSource16(luma + stride, &src1_lo, &src1_hi);
+    const __m128i sum = _mm_add_epi16(_mm_hadd_epi16(src0_lo, src0_hi),
+                                      _mm_hadd_epi16(src1_lo, src1_hi));
+    return RightShiftWithRounding_S16(sum, 2);
+  }
+  if (subsampling_x != 0) {
+    __m128i src_lo, src_hi;
+    LoadSource16(luma, &src_lo, &src_hi);
+    return RightShiftWithRounding_S16(_mm_hadd_epi16(src_lo, src_hi), 1);
+  }
+  return LoadSource(luma);
+}
+
+// Packs the autoregression coefficients of the preceding rows in pairs, for
+// use with _mm_madd_epi16. Each row has 2 * |auto_regression_coeff_lag| + 1
+// taps, so the final pair of each row is padded with a zero coefficient.
+template <int auto_regression_coeff_lag>
+inline void GetCoefficientPairs(const int8_t* const coeffs,
+                                __m128i coeff_pairs[3][4]) {
+  constexpr int kNumTaps = 2 * auto_regression_coeff_lag + 1;
+  for (int row = 0; row < auto_regression_coeff_lag; ++row) {
+    const int8_t* const row_coeffs = coeffs + row * kNumTaps;
+    for (int tap = 0; tap < kNumTaps; tap += 2) {
+      const int coeff0 = row_coeffs[tap];
+      const int coeff1 = (tap + 1 < kNumTaps) ? row_coeffs[tap + 1] : 0;
+      coeff_pairs[row][tap >> 1] =
+          _mm_set1_epi32(LeftShift(coeff1, 16) | (coeff0 & 0xFFFF));
+    }
+  }
+}
+
+// Each element in |sum| represents one destination value's running
+// autoregression formula. |grain_lo| and |grain_hi| hold 16 consecutive values
+// of a preceding row. The taps at |offset| and |offset| + 1 are weighted by
+// |coeffs| in a single _mm_madd_epi16 per 4 destination values.
+template <int offset>
+inline void AccumulateWeightedGrain(const __m128i grain_lo,
+                                    const __m128i grain_hi,
+                                    const __m128i coeffs, __m128i sum[2]) {
+  const __m128i grain0 = _mm_alignr_epi8(grain_hi, grain_lo, 2 * offset);
+  const __m128i grain1 = _mm_alignr_epi8(grain_hi, grain_lo, 2 * offset + 2);
+  sum[0] = _mm_add_epi32(
+      sum[0], _mm_madd_epi16(_mm_unpacklo_epi16(grain0, grain1), coeffs));
+  sum[1] = _mm_add_epi32(
+      sum[1], _mm_madd_epi16(_mm_unpackhi_epi16(grain0, grain1), coeffs));
+}
+
+// Accumulates the contribution of the |auto_regression_coeff_lag| rows above
+// the 8 destination values starting at |grain|.
+template <int auto_regression_coeff_lag, typename GrainType>
+inline void AccumulatePrecedingRows(const GrainType* const grain,
+                                    ptrdiff_t stride,
+                                    const __m128i coeff_pairs[3][4],
+                                    __m128i sum[2]) {
+  for (int row = 0; row < auto_regression_coeff_lag; ++row) {
+    // These loads may overflow to the next row, but they are never called on
+    // the final row of a grain block. Therefore, they will never exceed the
+    // block boundaries.
+    __m128i grain_lo, grain_hi;
+    LoadSource16(grain + (row - auto_regression_coeff_lag) * stride -
+                     auto_regression_coeff_lag,
+                 &grain_lo, &grain_hi);
+    AccumulateWeightedGrain<0>(grain_lo, grain_hi, coeff_pairs[row][0], sum);
+    AccumulateWeightedGrain<2>(grain_lo, grain_hi, coeff_pairs[row][1], sum);
+    if (auto_regression_coeff_lag > 1) {
+      AccumulateWeightedGrain<4>(grain_lo, grain_hi, coeff_pairs[row][2], sum);
+    }
+    if (auto_regression_coeff_lag > 2) {
+      AccumulateWeightedGrain<6>(grain_lo, grain_hi, coeff_pairs[row][3], sum);
+    }
+  }
+}
+
+// Because the autoregressive filter requires the output of each pixel to
+// compute pixels that come after in the row, we have to finish the calculations
+// one at a time. |coeffs| points to the coefficients of the current row.
+template <int bitdepth, int auto_regression_coeff_lag, typename GrainType>
+inline void WriteFinalAutoRegression(GrainType* const grain_cursor,
+                                     const __m128i sum[2],
+                                     const int8_t* const coeffs, int num_lanes,
+                                     int shift) {
+  alignas(16) int32_t sums[8];
+  StoreAligned16(sums, sum[0]);
+  StoreAligned16(sums + 4, sum[1]);
+  for (int lane = 0; lane < num_lanes; ++lane) {
+    int result = sums[lane];
+    for (int delta_col = -auto_regression_coeff_lag; delta_col < 0;
+         ++delta_col) {
+      result += grain_cursor[lane + delta_col] *
+                coeffs[delta_col + auto_regression_coeff_lag];
+    }
+    grain_cursor[lane] = libgav1::Clip3(
+        grain_cursor[lane] + RightShiftWithRounding(result, shift),
+        GetGrainMin<bitdepth>(), GetGrainMax<bitdepth>());
+  }
+}
+
+// Applies an auto-regressive filter to the white noise in luma_grain.
+template <int bitdepth, typename GrainType, int auto_regression_coeff_lag>
+void ApplyAutoRegressiveFilterToLumaGrain_SSE4_1(const FilmGrainParams& params,
+                                                 void* luma_grain_buffer) {
+  static_assert(auto_regression_coeff_lag > 0, "");
+  const int8_t* const auto_regression_coeff_y = params.auto_regression_coeff_y;
+  const int8_t* const final_row_coeffs =
+      auto_regression_coeff_y +
+      auto_regression_coeff_lag * (2 * auto_regression_coeff_lag + 1);
+  const int shift = params.auto_regression_shift;
+  __m128i coeff_pairs[3][4];
+  GetCoefficientPairs<auto_regression_coeff_lag>(auto_regression_coeff_y,
+                                                 coeff_pairs);
+
+  int y = kAutoRegressionBorder;
+  auto* luma_grain =
+      static_cast<GrainType*>(luma_grain_buffer) + kLumaWidth * y;
+  do {
+    // Each row is computed 8 values at a time. The final iteration writes the
+    // remaining 4 values.
+    int x = kAutoRegressionBorder;
+    do {
+      __m128i sum[2] = {_mm_setzero_si128(), _mm_setzero_si128()};
+      AccumulatePrecedingRows<auto_regression_coeff_lag>(
+          luma_grain + x, kLumaWidth, coeff_pairs, sum);
+      const int num_lanes = std::min(8, kLumaWidth - kAutoRegressionBorder - x);
+      WriteFinalAutoRegression<bitdepth, auto_regression_coeff_lag>(
+          luma_grain + x, sum, final_row_coeffs, num_lanes, shift);
+      x += 8;
+    } while (x < kLumaWidth - kAutoRegressionBorder);
+    luma_grain += kLumaWidth;
+  } while (++y < kLumaHeight);
+}
+
+template <int bitdepth, typename GrainType, int auto_regression_coeff_lag,
+          bool use_luma>
+void ApplyAutoRegressiveFilterToChromaGrains_SSE4_1(
+    const FilmGrainParams& params,
+    const void* LIBGAV1_RESTRICT luma_grain_buffer, int subsampling_x,
+    int subsampling_y, void* LIBGAV1_RESTRICT u_grain_buffer,
+    void* LIBGAV1_RESTRICT v_grain_buffer) {
+  static_assert(auto_regression_coeff_lag <= 3, "Invalid autoregression lag.");
+  const auto* luma_grain = static_cast<const GrainType*>(luma_grain_buffer);
+  auto* u_grain = static_cast<GrainType*>(u_grain_buffer);
+  auto* v_grain = static_cast<GrainType*>(v_grain_buffer);
+  const int shift = params.auto_regression_shift;
+  const int chroma_width =
+      (subsampling_x == 0) ? kMaxChromaWidth : kMinChromaWidth;
+  const int chroma_height =
+      (subsampling_y == 0) ? kMaxChromaHeight : kMinChromaHeight;
+  constexpr int kFinalRowPos =
+      auto_regression_coeff_lag * (2 * auto_regression_coeff_lag + 1);
+  __m128i coeff_pairs_u[3][4];
+  __m128i coeff_pairs_v[3][4];
+  GetCoefficientPairs<auto_regression_coeff_lag>(params.auto_regression_coeff_u,
+                                                 coeff_pairs_u);
+  GetCoefficientPairs<auto_regression_coeff_lag>(params.auto_regression_coeff_v,
+                                                 coeff_pairs_v);
+  // Luma samples get the final coefficient in the formula.
+  const __m128i luma_coeff_u = _mm_set1_epi32(
+      params.auto_regression_coeff_u[kFinalRowPos + auto_regression_coeff_lag]);
+  const __m128i luma_coeff_v = _mm_set1_epi32(
+      params.auto_regression_coeff_v[kFinalRowPos + auto_regression_coeff_lag]);
+
+  int y = kAutoRegressionBorder;
+  luma_grain += kLumaWidth * y;
+  u_grain += chroma_width * y;
+  v_grain += chroma_width * y;
+  do {
+    int x = kAutoRegressionBorder;
+    int luma_x = kAutoRegressionBorder;
+    do {
+      const int num_lanes =
+          std::min(8, chroma_width - kAutoRegressionBorder - x);
+      __m128i sum_u[2] = {_mm_setzero_si128(), _mm_setzero_si128()};
+      __m128i sum_v[2] = {_mm_setzero_si128(), _mm_setzero_si128()};
+      AccumulatePrecedingRows<auto_regression_coeff_lag>(
+          u_grain + x, chroma_width, coeff_pairs_u, sum_u);
+      AccumulatePrecedingRows<auto_regression_coeff_lag>(
+          v_grain + x, chroma_width, coeff_pairs_v, sum_v);
+
+      if (use_luma) {
+        __m128i luma;
+        if (num_lanes == 8) {
+          luma = GetSubsampledLuma(luma_grain + luma_x, subsampling_x,
+                                   subsampling_y, kLumaWidth);
+        } else {
+          // The final iteration would read past the end of the luma block.
+          GrainType luma_buffer[2][16] = {};
+          const int luma_width = num_lanes << subsampling_x;
+          memcpy(luma_buffer[0], luma_grain + luma_x,
+                 luma_width * sizeof(luma_buffer[0][0]));
+          if (subsampling_y != 0) {
+            memcpy(luma_buffer[1], luma_grain + luma_x + kLumaWidth,
+                   luma_width * sizeof(luma_buffer[0][0]));
+          }
+          luma = GetSubsampledLuma(luma_buffer[0], subsampling_x,
+                                   subsampling_y, 16);
+        }
+        const __m128i luma_lo = _mm_cvtepi16_epi32(luma);
+        const __m128i luma_hi = _mm_cvtepi16_epi32(_mm_srli_si128(luma, 8));
+        sum_u[0] =
+            _mm_add_epi32(sum_u[0], _mm_mullo_epi32(luma_lo, luma_coeff_u));
+        sum_u[1] =
+            _mm_add_epi32(sum_u[1], _mm_mullo_epi32(luma_hi, luma_coeff_u));
+        sum_v[0] =
+            _mm_add_epi32(sum_v[0], _mm_mullo_epi32(luma_lo, luma_coeff_v));
+        sum_v[1] =
+            _mm_add_epi32(sum_v[1], _mm_mullo_epi32(luma_hi, luma_coeff_v));
+      }
+      WriteFinalAutoRegression<bitdepth, auto_regression_coeff_lag>(
+          u_grain + x, sum_u, params.auto_regression_coeff_u + kFinalRowPos,
+          num_lanes, shift);
+      WriteFinalAutoRegression<bitdepth, auto_regression_coeff_lag>(
+          v_grain + x, sum_v, params.auto_regression_coeff_v + kFinalRowPos,
+          num_lanes, shift);
+      x += 8;
+      luma_x += 8 << subsampling_x;
+    } while (x < chroma_width - kAutoRegressionBorder);
+
+    luma_grain += kLumaWidth << subsampling_y;
+    u_grain += chroma_width;
+    v_grain += chroma_width;
+  } while (++y < chroma_height);
+}
+
+// Fills |scaling_lut| with one entry per 8-bit value. Each segment between two
+// points is interpolated 8 values at a time, so up to 7 values past the end of
+// a segment may be written. They are overwritten by the next segment or by the
+// final fill, and the last of them is within kScalingLookupTablePadding.
+inline void InitializeScalingLookupTable8bpp_SSE4_1(
+    int num_points, const uint8_t point_value[], const uint8_t point_scaling[],
+    int16_t* scaling_lut, const int scaling_lut_length) {
+  Memset(scaling_lut, point_scaling[0],
+         std::max(static_cast<int>(point_value[0]), 1));
+  const __m128i steps = _mm_set_epi32(3, 2, 1, 0);
+  const __m128i rounding = _mm_set1_epi32(32768);
+  for (int i = 0; i < num_points - 1; ++i) {
+    const int delta_y = point_scaling[i + 1] - point_scaling[i];
+    const int delta_x = point_value[i + 1] - point_value[i];
+    // |delta| corresponds to b, for the function y = a + b*x.
+    const int delta = delta_y * ((65536 + (delta_x >> 1)) / delta_x);
+    // Each lane holds x * delta + 32768 for one of 8 consecutive x.
+    __m128i upscaled_points0 =
+        _mm_add_epi32(rounding, _mm_mullo_epi32(steps, _mm_set1_epi32(delta)));
+    __m128i upscaled_points1 =
+        _mm_add_epi32(upscaled_points0, _mm_set1_epi32(delta * 4));
+    const __m128i line_increment8 = _mm_set1_epi32(delta * 8);
+    const __m128i base_point = _mm_set1_epi16(point_scaling[i]);
+    int x = 0;
+    do {
+      const __m128i interp_points =
+          _mm_packs_epi32(_mm_srai_epi32(upscaled_points0, 16),
+                          _mm_srai_epi32(upscaled_points1, 16));
+      StoreUnaligned16(&scaling_lut[point_value[i] + x],
+                       _mm_add_epi16(interp_points, base_point));
+      upscaled_points0 = _mm_add_epi32(upscaled_points0, line_increment8);
+      upscaled_points1 = _mm_add_epi32(upscaled_points1, line_increment8);
+      x += 8;
+    } while (x < delta_x);
+  }
+  const int last_point_value = point_value[num_points - 1];
+  Memset(&scaling_lut[last_point_value], point_scaling[num_points - 1],
+         scaling_lut_length - last_point_value);
+}
+
+template <int bitdepth>
+void InitializeScalingLookupTable_SSE4_1(int num_points,
+                                         const uint8_t point_value[],
+                                         const uint8_t point_scaling[],
+                                         int16_t* scaling_lut,
+                                         const int scaling_lut_length) {
+  static_assert(bitdepth < kBitdepth12,
+                "SSE4 Scaling lookup table only supports 8bpp and 10bpp.");
+  if (num_points == 0) {
+    memset(scaling_lut, 0, sizeof(scaling_lut[0]) * scaling_lut_length);
+    return;
+  }
+  static_assert(sizeof(scaling_lut[0]) == 2, "");
+  if (bitdepth == kBitdepth8) {
+    InitializeScalingLookupTable8bpp_SSE4_1(num_points, point_value,
+                                            point_scaling, scaling_lut,
+                                            scaling_lut_length);
+    return;
+  }
+  // For 10bpp, every fourth entry is taken from the 8bpp table and the three
+  // entries in between are interpolated from its neighbors:
+  //   lut[(i << 2) + k] = start + RightShiftWithRounding(k * (end - start), 2)
+  constexpr int kScalingLut8bppLength =
+      kScalingLookupTableSize + kScalingLookupTablePadding;
+  int16_t scaling_lut_8bpp[kScalingLut8bppLength];
+  InitializeScalingLookupTable8bpp_SSE4_1(num_points, point_value,
+                                          point_scaling, scaling_lut_8bpp,
+                                          kScalingLut8bppLength);
+  const int last_point_value = point_value[num_points - 1];
+  for (int i = 0; i < last_point_value; i += 8) {
+    const __m128i start = LoadUnaligned16(&scaling_lut_8bpp[i]);
+    const __m128i end = LoadUnaligned16(&scaling_lut_8bpp[i + 1]);
+    const __m128i delta = _mm_sub_epi16(end, start);
+    const __m128i double_delta = _mm_slli_epi16(delta, 1);
+    const __m128i interp1 =
+        _mm_add_epi16(start, RightShiftWithRounding_S16(delta, 2));
+    const __m128i interp2 =
+        _mm_add_epi16(start, RightShiftWithRounding_S16(double_delta, 2));
+    const __m128i interp3 = _mm_add_epi16(
+        start,
+        RightShiftWithRounding_S16(_mm_add_epi16(delta, double_delta), 2));
+    const __m128i points01_lo = _mm_unpacklo_epi16(start, interp1);
+    const __m128i points01_hi = _mm_unpackhi_epi16(start, interp1);
+    const __m128i points23_lo = _mm_unpacklo_epi16(interp2, interp3);
+    const __m128i points23_hi = _mm_unpackhi_epi16(interp2, interp3);
+    int16_t* const dst = &scaling_lut[i << 2];
+    StoreUnaligned16(dst, _mm_unpacklo_epi32(points01_lo, points23_lo));
+    StoreUnaligned16(dst + 8, _mm_unpackhi_epi32(points01_lo, points23_lo));
+    StoreUnaligned16(dst + 16, _mm_unpacklo_epi32(points01_hi, points23_hi));
+    StoreUnaligned16(dst + 24, _mm_unpackhi_epi32(points01_hi, points23_hi));
+  }
+  const int x_base = last_point_value << (bitdepth - kBitdepth8);
+  Memset(&scaling_lut[x_base], point_scaling[num_points - 1],
+         scaling_lut_length - x_base);
+}
+
+template <int bitdepth, typename GrainType>
+inline void WriteOverlapLine_SSE4_1(
+    const GrainType* LIBGAV1_RESTRICT noise_stripe_row,
+    const GrainType* LIBGAV1_RESTRICT noise_stripe_row_prev, int plane_width,
+    const __m128i grain_coeff, const __m128i old_coeff,
+    GrainType* LIBGAV1_RESTRICT noise_image_row) {
+  const __m128i grain_min = _mm_set1_epi16(GetGrainMin<bitdepth>());
+  const __m128i grain_max = _mm_set1_epi16(GetGrainMax<bitdepth>());
+  int x = 0;
+  do {
+    // Note that these reads may exceed noise_stripe_row's width by up to 7
+    // values.
+    const __m128i source_grain = LoadSource(noise_stripe_row + x);
+    const __m128i source_old = LoadSource(noise_stripe_row_prev + x);
+    // Maximum magnitude is 512 * (22 + 23) = 0x5A00.
+    const __m128i weighted_grain =
+        _mm_add_epi16(_mm_mullo_epi16(source_grain, grain_coeff),
+                      _mm_mullo_epi16(source_old, old_coeff));
+    const __m128i grain = Clip3(RightShiftWithRounding_S16(weighted_grain, 5),
+                                grain_min, grain_max);
+    // Note that this write may exceed noise_image_row's width by up to 7
+    // values.
+    StoreSigned(noise_image_row + x, grain);
+    x += 8;
+  } while (x < plane_width);
+}
+
+template <int bitdepth, typename GrainType>
+void ConstructNoiseImageOverlap_SSE4_1(
+    const void* LIBGAV1_RESTRICT noise_stripes_buffer, int width, int height,
+    int subsampling_x, int subsampling_y,
+    void* LIBGAV1_RESTRICT noise_image_buffer) {
+  static_assert(bitdepth < kBitdepth12,
+                "SSE4 noise image overlap only supports 8bpp and 10bpp.");
+  const auto* noise_stripes =
+      static_cast<const Array2DView<GrainType>*>(noise_stripes_buffer);
+  auto* noise_image = static_cast<Array2D<GrainType>*>(noise_image_buffer);
+  const int plane_width = (width + subsampling_x) >> subsampling_x;
+  const int plane_height = (height + subsampling_y) >> subsampling_y;
+  const int stripe_height = 32 >> subsampling_y;
+  const int stripe_mask = stripe_height - 1;
+  int y = stripe_height;
+  int luma_num = 1;
+  if (subsampling_y == 0) {
+    const __m128i first_row_grain_coeff = _mm_set1_epi16(17);
+    const __m128i first_row_old_coeff = _mm_set1_epi16(27);
+    const __m128i second_row_grain_coeff = first_row_old_coeff;
+    const __m128i second_row_old_coeff = first_row_grain_coeff;
+    for (; y < (plane_height & ~stripe_mask); ++luma_num, y += stripe_height) {
+      const GrainType* noise_stripe = (*noise_stripes)[luma_num];
+      const GrainType* noise_stripe_prev = (*noise_stripes)[luma_num - 1];
+      WriteOverlapLine_SSE4_1<bitdepth>(
+          noise_stripe, &noise_stripe_prev[32 * plane_width], plane_width,
+          first_row_grain_coeff, first_row_old_coeff, (*noise_image)[y]);
+
+      WriteOverlapLine_SSE4_1<bitdepth>(
+          &noise_stripe[plane_width],
+          &noise_stripe_prev[(32 + 1) * plane_width], plane_width,
+          second_row_grain_coeff, second_row_old_coeff, (*noise_image)[y + 1]);
+    }
+    // Either one partial stripe remains (remaining_height > 0),
+    // OR image is less than one stripe high (remaining_height < 0),
+    // OR all stripes are completed (remaining_height == 0).
+    const int remaining_height = plane_height - y;
+    if (remaining_height <= 0) {
+      return;
+    }
+    const GrainType* noise_stripe = (*noise_stripes)[luma_num];
+    const GrainType* noise_stripe_prev = (*noise_stripes)[luma_num - 1];
+    WriteOverlapLine_SSE4_1<bitdepth>(
+        noise_stripe, &noise_stripe_prev[32 * plane_width], plane_width,
+        first_row_grain_coeff, first_row_old_coeff, (*noise_image)[y]);
+
+    if (remaining_height > 1) {
+      WriteOverlapLine_SSE4_1<bitdepth>(
+          &noise_stripe[plane_width],
+          &noise_stripe_prev[(32 + 1) * plane_width], plane_width,
+          second_row_grain_coeff, second_row_old_coeff, (*noise_image)[y + 1]);
+    }
+  } else {  // subsampling_y == 1
+    const __m128i first_row_grain_coeff = _mm_set1_epi16(22);
+    const __m128i first_row_old_coeff = _mm_set1_epi16(23);
+    for (; y < plane_height; ++luma_num, y += stripe_height) {
+      const GrainType* noise_stripe = (*noise_stripes)[luma_num];
+      const GrainType* noise_stripe_prev = (*noise_stripes)[luma_num - 1];
+      WriteOverlapLine_SSE4_1<bitdepth>(
+          noise_stripe, &noise_stripe_prev[16 * plane_width], plane_width,
+          first_row_grain_coeff, first_row_old_coeff, (*noise_image)[y]);
+    }
+  }
+}
+
 }  // namespace
 
 namespace low_bitdepth {
@@ -442,6 +884,46 @@ void Init8bpp() {
   Dsp* const dsp = dsp_internal::GetWritableDspTable(kBitdepth8);
   assert(dsp != nullptr);
 
+  // LumaAutoRegressionFunc
+  dsp->film_grain.luma_auto_regression[0] =
+      ApplyAutoRegressiveFilterToLumaGrain_SSE4_1<kBitdepth8, int8_t, 1>;
+  dsp->film_grain.luma_auto_regression[1] =
+      ApplyAutoRegressiveFilterToLumaGrain_SSE4_1<kBitdepth8, int8_t, 2>;
+  dsp->film_grain.luma_auto_regression[2] =
+      ApplyAutoRegressiveFilterToLumaGrain_SSE4_1<kBitdepth8, int8_t, 3>;
+
+  // ChromaAutoRegressionFunc[use_luma][auto_regression_coeff_lag]
+  // Chroma autoregression should never be called when lag is 0 and use_luma
+  // is false.
+  dsp->film_grain.chroma_auto_regression[0][0] = nullptr;
+  dsp->film_grain.chroma_auto_regression[0][1] =
+      ApplyAutoRegressiveFilterToChromaGrains_SSE4_1<kBitdepth8, int8_t, 1,
+                                                     false>;
+  dsp->film_grain.chroma_auto_regression[0][2] =
+      ApplyAutoRegressiveFilterToChromaGrains_SSE4_1<kBitdepth8, int8_t, 2,
+                                                     false>;
+  dsp->film_grain.chroma_auto_regression[0][3] =
+      ApplyAutoRegressiveFilterToChromaGrains_SSE4_1<kBitdepth8, int8_t, 3,
+                                                     false>;
+  dsp->film_grain.chroma_auto_regression[1][0] =
+      ApplyAutoRegressiveFilterToChromaGrains_SSE4_1<kBitdepth8, int8_t, 0,
+                                                     true>;
+  dsp->film_grain.chroma_auto_regression[1][1] =
+      ApplyAutoRegressiveFilterToChromaGrains_SSE4_1<kBitdepth8, int8_t, 1,
+                                                     true>;
+  dsp->film_grain.chroma_auto_regression[1][2] =
+      ApplyAutoRegressiveFilterToChromaGrains_SSE4_1<kBitdepth8, int8_t, 2,
+                                                     true>;
+  dsp->film_grain.chroma_auto_regression[1][3] =
+      ApplyAutoRegressiveFilterToChromaGrains_SSE4_1<kBitdepth8, int8_t, 3,
+                                                     true>;
+
+  dsp->film_grain.construct_noise_image_overlap =
+      ConstructNoiseImageOverlap_SSE4_1<kBitdepth8, int8_t>;
+
+  dsp->film_grain.initialize_scaling_lut =
+      InitializeScalingLookupTable_SSE4_1<kBitdepth8>;
+
   dsp->film_grain.blend_noise_luma =
       BlendNoiseWithImageLuma_SSE4_1<kBitdepth8, int8_t, uint8_t>;
   dsp->film_grain.blend_noise_chroma[0] = BlendNoiseWithImageChroma8bpp_SSE4_1;
@@ -460,6 +942,46 @@ void Init10bpp() {
   Dsp* const dsp = dsp_internal::GetWritableDspTable(kBitdepth10);
   assert(dsp != nullptr);
 
+  // LumaAutoRegressionFunc
+  dsp->film_grain.luma_auto_regression[0] =
+      ApplyAutoRegressiveFilterToLumaGrain_SSE4_1<kBitdepth10, int16_t, 1>;
+  dsp->film_grain.luma_auto_regression[1] =
+      ApplyAutoRegressiveFilterToLumaGrain_SSE4_1<kBitdepth10, int16_t, 2>;
+  dsp->film_grain.luma_auto_regression[2] =
+      ApplyAutoRegressiveFilterToLumaGrain_SSE4_1<kBitdepth10, int16_t, 3>;
+
+  // ChromaAutoRegressionFunc[use_luma][auto_regression_coeff_lag]
+  // Chroma autoregression should never be called when lag is 0 and use_luma
+  // is false.
+  dsp->film_grain.chroma_auto_regression[0][0] = nullptr;
+  dsp->film_grain.chroma_auto_regression[0][1] =
+      ApplyAutoRegressiveFilterToChromaGrains_SSE4_1<kBitdepth10, int16_t, 1,
+                                                     false>;
+  dsp->film_grain.chroma_auto_regression[0][2] =
+      ApplyAutoRegressiveFilterToChromaGrains_SSE4_1<kBitdepth10, int16_t, 2,
+                                                     false>;
+  dsp->film_grain.chroma_auto_regression[0][3] =
+      ApplyAutoRegressiveFilterToChromaGrains_SSE4_1<kBitdepth10, int16_t, 3,
+                                                     false>;
+  dsp->film_grain.chroma_auto_regression[1][0] =
+      ApplyAutoRegressiveFilterToChromaGrains_SSE4_1<kBitdepth10, int16_t, 0,
+                                                     true>;
+  dsp->film_grain.chroma_auto_regression[1][1] =
+      ApplyAutoRegressiveFilterToChromaGrains_SSE4_1<kBitdepth10, int16_t, 1,
+                                                     true>;
+  dsp->film_grain.chroma_auto_regression[1][2] =
+      ApplyAutoRegressiveFilterToChromaGrains_SSE4_1<kBitdepth10, int16_t, 2,
+                                                     true>;
+  dsp->film_grain.chroma_auto_regression[1][3] =
+      ApplyAutoRegressiveFilterToChromaGrains_SSE4_1<kBitdepth10, int16_t, 3,
+                                                     true>;
+
+  dsp->film_grain.construct_noise_image_overlap =
+      ConstructNoiseImageOverlap_SSE4_1<kBitdepth10, int16_t>;
+
+  dsp->film_grain.initialize_scaling_lut =
+      InitializeScalingLookupTable_SSE4_1<kBitdepth10>;
+
   dsp->film_grain.blend_noise_luma =
       BlendNoiseWithImageLuma_SSE4_1<kBitdepth10, int16_t, uint16_t>;
   dsp->film_grain.blend_noise_chroma[1] =
@@ -0,0 +1,298 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the SSE4.1 film grain template generation functions with the C
+// ones on random grain, parameters and scaling points.
+
+#include "src/dsp/x86/film_grain_sse4.h"
+
+#include "gtest/gtest.h"
+
+#if LIBGAV1_TARGETING_SSE4_1
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "src/dsp/dsp.h"
+#include "src/dsp/film_grain.h"
+#include "src/dsp/film_grain_common.h"
+#include "src/utils/array_2d.h"
+#include "src/utils/common.h"
+#include "src/utils/constants.h"
+#include "src/utils/cpu.h"
+#include "src/utils/types.h"
+
+namespace libgav1 {
+namespace dsp {
+namespace {
+
+template <int bitdepth>
+class FilmGrainSse4Test : public testing::Test {
+ protected:
+  using GrainType =
+      typename std::conditional<bitdepth == 8, int8_t, int16_t>::type;
+  static constexpr int kGrainMin = -(1 << (bitdepth - 1));
+  static constexpr int kGrainMax = (1 << (bitdepth - 1)) - 1;
+
+  void SetUp() override {
+    if ((GetCpuInfo() & kSSE4_1) == 0) {
+      GTEST_SKIP() << "SSE4.1 is not supported by this CPU.";
+    }
+    DspInit();
+    // film_grain.cc is built without SSE4.1, so FilmGrainInit_C() installs
+    // every C function. FilmGrainInit_SSE4_1() then restores the table that
+    // DspInit() set up.
+    FilmGrainInit_C();
+    c_ = GetDspTable(bitdepth)->film_grain;
+    FilmGrainInit_SSE4_1();
+    sse4_ = GetDspTable(bitdepth)->film_grain;
+  }
+
+  void RandomGrain(GrainType* grain, int size) {
+    std::uniform_int_distribution<int> distribution(kGrainMin, kGrainMax);
+    for (int i = 0; i < size; ++i) grain[i] = distribution(rng_);
+  }
+
+  void RandomAutoRegressionParams(int lag, FilmGrainParams* params) {
+    std::uniform_int_distribution<int> coeff(-128, 127);
+    *params = {};
+    params->auto_regression_coeff_lag = lag;
+    params->auto_regression_shift =
+        std::uniform_int_distribution<int>(6, 9)(rng_);
+    for (auto& c : params->auto_regression_coeff_y) c = coeff(rng_);
+    for (auto& c : params->auto_regression_coeff_u) c = coeff(rng_);
+    for (auto& c : params->auto_regression_coeff_v) c = coeff(rng_);
+  }
+
+  void TestLumaAutoRegression();
+  void TestChromaAutoRegression();
+  void TestConstructNoiseImageOverlap();
+  void TestInitializeScalingLut();
+
+  FilmGrainFuncs c_;
+  FilmGrainFuncs sse4_;
+  std::mt19937 rng_{bitdepth};
+};
+
+template <int bitdepth>
+void FilmGrainSse4Test<bitdepth>::TestLumaAutoRegression() {
+  for (int lag = 1; lag <= 3; ++lag) {
+    const LumaAutoRegressionFunc c_func = c_.luma_auto_regression[lag - 1];
+    const LumaAutoRegressionFunc sse4_func =
+        sse4_.luma_auto_regression[lag - 1];
+    ASSERT_NE(c_func, nullptr);
+    ASSERT_NE(sse4_func, nullptr);
+    ASSERT_NE(c_func, sse4_func);
+    for (int iteration = 0; iteration < 10; ++iteration) {
+      FilmGrainParams params;
+      RandomAutoRegressionParams(lag, &params);
+      std::vector<GrainType> c_grain(kLumaHeight * kLumaWidth);
+      RandomGrain(c_grain.data(), kLumaHeight * kLumaWidth);
+      std::vector<GrainType> sse4_grain = c_grain;
+      c_func(params, c_grain.data());
+      sse4_func(params, sse4_grain.data());
+      ASSERT_EQ(c_grain, sse4_grain)
+          << "lag " << lag << ", iteration " << iteration;
+    }
+  }
+}
+
+template <int bitdepth>
+void FilmGrainSse4Test<bitdepth>::TestChromaAutoRegression() {
+  static constexpr int kSubsampling[3][2] = {{0, 0}, {1, 0}, {1, 1}};
+  constexpr int kChromaSize = kMaxChromaHeight * kMaxChromaWidth;
+  for (int use_luma = 0; use_luma < 2; ++use_luma) {
+    for (int lag = 0; lag <= 3; ++lag) {
+      const ChromaAutoRegressionFunc c_func =
+          c_.chroma_auto_regression[use_luma][lag];
+      const ChromaAutoRegressionFunc sse4_func =
+          sse4_.chroma_auto_regression[use_luma][lag];
+      // Without luma, lag 0 is the identity filter and has no function.
+      if (use_luma == 0 && lag == 0) continue;
+      ASSERT_NE(c_func, nullptr);
+      ASSERT_NE(sse4_func, nullptr);
+      ASSERT_NE(c_func, sse4_func);
+      for (const auto& subsampling : kSubsampling) {
+        for (int iteration = 0; iteration < 4; ++iteration) {
+          FilmGrainParams params;
+          RandomAutoRegressionParams(lag, &params);
+          std::vector<GrainType> luma_grain(kLumaHeight * kLumaWidth);
+          RandomGrain(luma_grain.data(), kLumaHeight * kLumaWidth);
+          std::vector<GrainType> c_u(kChromaSize);
+          std::vector<GrainType> c_v(kChromaSize);
+          RandomGrain(c_u.data(), kChromaSize);
+          RandomGrain(c_v.data(), kChromaSize);
+          std::vector<GrainType> sse4_u = c_u;
+          std::vector<GrainType> sse4_v = c_v;
+          c_func(params, luma_grain.data(), subsampling[0], subsampling[1],
+                 c_u.data(), c_v.data());
+          sse4_func(params, luma_grain.data(), subsampling[0], subsampling[1],
+                    sse4_u.data(), sse4_v.data());
+          ASSERT_EQ(c_u, sse4_u)
+              << "use_luma " << use_luma << ", lag " << lag << ", subsampling "
+              << subsampling[0] << subsampling[1];
+          ASSERT_EQ(c_v, sse4_v)
+              << "use_luma " << use_luma << ", lag " << lag << ", subsampling "
+              << subsampling[0] << subsampling[1];
+        }
+      }
+    }
+  }
+}
+
+template <int bitdepth>
+void FilmGrainSse4Test<bitdepth>::TestConstructNoiseImageOverlap() {
+  static constexpr int kSubsampling[3][2] = {{0, 0}, {1, 0}, {1, 1}};
+  static constexpr int kWidths[] = {1, 2, 17, 64, 93, 200};
+  static constexpr int kHeights[] = {1, 31, 33, 64, 95, 130};
+  constexpr int kNoiseStripeHeight = 34;
+  ASSERT_NE(c_.construct_noise_image_overlap, nullptr);
+  ASSERT_NE(sse4_.construct_noise_image_overlap, nullptr);
+  ASSERT_NE(c_.construct_noise_image_overlap,
+            sse4_.construct_noise_image_overlap);
+  for (const auto& subsampling : kSubsampling) {
+    for (const int width : kWidths) {
+      for (const int height : kHeights) {
+        // Laid out as FilmGrain::AllocateNoiseStripes() and
+        // FilmGrain::AllocateNoiseImage() do.
+        const int max_luma_num = DivideBy16(DivideBy2(height + 1) + 15);
+        const int plane_width = SubsampledValue(width, subsampling[0]);
+        const int plane_height = SubsampledValue(height, subsampling[1]);
+        const int stripe_size =
+            (kNoiseStripeHeight >> subsampling[1]) * plane_width;
+        std::vector<GrainType> stripes(max_luma_num * stripe_size +
+                                       kNoiseStripePadding);
+        RandomGrain(stripes.data(), static_cast<int>(stripes.size()));
+        const Array2DView<GrainType> noise_stripes(max_luma_num, stripe_size,
+                                                   stripes.data());
+        Array2D<GrainType> c_image;
+        Array2D<GrainType> sse4_image;
+        ASSERT_TRUE(c_image.Reset(plane_height,
+                                  plane_width + kNoiseImagePadding,
+                                  /*zero_initialize=*/false));
+        ASSERT_TRUE(sse4_image.Reset(plane_height,
+                                     plane_width + kNoiseImagePadding,
+                                     /*zero_initialize=*/false));
+        for (int y = 0; y < plane_height; ++y) {
+          RandomGrain(c_image[y], plane_width);
+          std::copy(c_image[y], c_image[y] + plane_width, sse4_image[y]);
+        }
+        c_.construct_noise_image_overlap(&noise_stripes, width, height,
+                                         subsampling[0], subsampling[1],
+                                         &c_image);
+        sse4_.construct_noise_image_overlap(&noise_stripes, width, height,
+                                            subsampling[0], subsampling[1],
+                                            &sse4_image);
+        for (int y = 0; y < plane_height; ++y) {
+          for (int x = 0; x < plane_width; ++x) {
+            ASSERT_EQ(c_image[y][x], sse4_image[y][x])
+                << width << "x" << height << ", subsampling " << subsampling[0]
+                << subsampling[1] << ", (" << x << ", " << y << ")";
+          }
+        }
+      }
+    }
+  }
+}
+
+template <int bitdepth>
+void FilmGrainSse4Test<bitdepth>::TestInitializeScalingLut() {
+  // The length FilmGrain<bitdepth> allocates.
+  constexpr int kScalingLutLength =
+      (bitdepth == kBitdepth10)
+          ? (kScalingLookupTableSize + kScalingLookupTablePadding) << 2
+          : kScalingLookupTableSize + kScalingLookupTablePadding;
+  // The most points a scaling function can have (num_y_points).
+  constexpr int kMaxScalingPoints = 14;
+  ASSERT_NE(c_.initialize_scaling_lut, nullptr);
+  ASSERT_NE(sse4_.initialize_scaling_lut, nullptr);
+  ASSERT_NE(c_.initialize_scaling_lut, sse4_.initialize_scaling_lut);
+  std::vector<int> values(256);
+  for (int i = 0; i < 256; ++i) values[i] = i;
+  for (int iteration = 0; iteration < 50; ++iteration) {
+    const int num_points =
+        (iteration == 0)
+            ? 0
+            : std::uniform_int_distribution<int>(1, kMaxScalingPoints)(rng_);
+    // Strictly increasing point values, as the specification requires.
+    std::shuffle(values.begin(), values.end(), rng_);
+    std::sort(values.begin(), values.begin() + num_points);
+    uint8_t point_value[kMaxScalingPoints];
+    uint8_t point_scaling[kMaxScalingPoints];
+    for (int i = 0; i < num_points; ++i) {
+      point_value[i] = values[i];
+      point_scaling[i] = std::uniform_int_distribution<int>(0, 255)(rng_);
+    }
+    std::vector<int16_t> c_lut(kScalingLutLength, -1);
+    std::vector<int16_t> sse4_lut(kScalingLutLength, -1);
+    c_.initialize_scaling_lut(num_points, point_value, point_scaling,
+                              c_lut.data(), kScalingLutLength);
+    sse4_.initialize_scaling_lut(num_points, point_value, point_scaling,
+                                 sse4_lut.data(), kScalingLutLength);
+    ASSERT_EQ(c_lut, sse4_lut)
+        << "iteration " << iteration << ", num_points " << num_points;
+  }
+}
+
+using FilmGrainSse4Test8bpp = FilmGrainSse4Test<kBitdepth8>;
+
+TEST_F(FilmGrainSse4Test8bpp, LumaAutoRegression) { TestLumaAutoRegression(); }
+
+TEST_F(FilmGrainSse4Test8bpp, ChromaAutoRegression) {
+  TestChromaAutoRegression();
+}
+
+TEST_F(FilmGrainSse4Test8bpp, ConstructNoiseImageOverlap) {
+  TestConstructNoiseImageOverlap();
+}
+
+TEST_F(FilmGrainSse4Test8bpp, InitializeScalingLut) {
+  TestInitializeScalingLut();
+}
+
+#if LIBGAV1_MAX_BITDEPTH >= 10
+using FilmGrainSse4Test10bpp = FilmGrainSse4Test<kBitdepth10>;
+
+TEST_F(FilmGrainSse4Test10bpp, LumaAutoRegression) {
+  TestLumaAutoRegression();
+}
+
+TEST_F(FilmGrainSse4Test10bpp, ChromaAutoRegression) {
+  TestChromaAutoRegression();
+}
+
+TEST_F(FilmGrainSse4Test10bpp, ConstructNoiseImageOverlap) {
+  TestConstructNoiseImageOverlap();
+}
+
+TEST_F(FilmGrainSse4Test10bpp, InitializeScalingLut) {
+  TestInitializeScalingLut();
+}
+#endif  // LIBGAV1_MAX_BITDEPTH >= 10
+
+}  // namespace
+}  // namespace dsp
+}  // namespace libgav1
+
+#else  // !LIBGAV1_TARGETING_SSE4_1
+
+TEST(FilmGrainSse4Test, SSE4) {
+  GTEST_SKIP() << "Build this module for x86(-64) with SSE4 enabled to enable "
+                  "the tests.";
+}
+
+#endif  // LIBGAV1_TARGETING_SSE4_1
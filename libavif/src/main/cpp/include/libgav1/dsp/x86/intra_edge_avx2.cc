@@ -0,0 +1,199 @@
+// Copyright 2021 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/dsp/intra_edge.h"
+#include "src/utils/cpu.h"
+
+#if LIBGAV1_TARGETING_AVX2
+#include <immintrin.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "src/dsp/constants.h"
+#include "src/dsp/dsp.h"
+#include "src/dsp/x86/common_avx2.h"
+#include "src/utils/common.h"
+
+namespace libgav1 {
+namespace dsp {
+namespace {
+
+constexpr int kKernelTaps = 5;
+// Only the outer, inner and center taps differ, see Section 7.11.2.12.
+constexpr int16_t kKernels[3][3] = {{0, 4, 8}, {0, 5, 6}, {2, 4, 4}};
+constexpr int kMaxEdgeBufferSize = 129;
+// The filter reads kKernelTaps - 1 values past each 16 outputs.
+constexpr int kFilterPadding = 2 * 16;
+
+// Stores the 16 filter outputs in |sum|, widened to 16 bits.
+inline void StoreEdge(uint8_t* dst, const __m256i& sum) {
+  // Pack each 128-bit lane down to the low 8 bytes and join them.
+  const __m256i packed = _mm256_packus_epi16(sum, sum);
+  StoreUnaligned16(dst, _mm256_castsi256_si128(
+                            _mm256_permute4x64_epi64(packed, 0x88)));
+}
+
+inline void StoreEdge(uint16_t* dst, const __m256i& sum) {
+  StoreUnaligned32(dst, sum);
+}
+
+// Copies |size| values of |source| to |edge| + 2, widened to 16 bits. Both
+// buffers must be padded to a multiple of 16 values.
+inline void LoadEdge(uint16_t* const edge, const uint8_t* const source,
+                     const int size) {
+  int i = 0;
+  do {
+    StoreUnaligned32(edge + 2 + i,
+                     _mm256_cvtepu8_epi16(LoadUnaligned16(source + i)));
+    i += 16;
+  } while (i < size);
+}
+
+inline void LoadEdge(uint16_t* const edge, const uint16_t* const source,
+                     const int size) {
+  memcpy(edge + 2, source, size * sizeof(source[0]));
+}
+
+// The SSE4.1 8-bit version applies each kernel to 8 or 12 values with
+// shifts. Here the edge is widened to 16 bits once, with the end values
+// replicated twice on each side so that no tap needs its index clipped, and 16
+// outputs are produced per iteration. The largest sum, 16 * 1023, fits in 16
+// bits.
+template <typename Pixel>
+void IntraEdgeFilter_AVX2(void* buffer, int size, int strength) {
+  assert(strength > 0 && strength <= 3);
+  // Only process |size| - 1 elements. Nothing to do in this case.
+  if (size == 1) return;
+  auto* const dst_buffer = static_cast<Pixel*>(buffer);
+  alignas(32) Pixel source[kMaxEdgeBufferSize + kFilterPadding];
+  memcpy(source, dst_buffer, size * sizeof(source[0]));
+  alignas(32) uint16_t edge[kMaxEdgeBufferSize + 2 * kFilterPadding];
+  LoadEdge(edge, source, size);
+  edge[0] = edge[1] = source[0];
+  const __m256i last = _mm256_set1_epi16(source[size - 1]);
+  StoreUnaligned32(edge + size + 2, last);
+  StoreUnaligned32(edge + size + 18, last);
+
+  const int kernel_index = strength - 1;
+  const __m256i outer_tap = _mm256_set1_epi16(kKernels[kernel_index][0]);
+  const __m256i inner_tap = _mm256_set1_epi16(kKernels[kernel_index][1]);
+  const __m256i center_tap = _mm256_set1_epi16(kKernels[kernel_index][2]);
+  alignas(32) Pixel result[kMaxEdgeBufferSize + kFilterPadding];
+  // Output i reads edge[i] through edge[i + kKernelTaps - 1].
+  static_assert(kKernelTaps == 5, "");
+  int i = 1;
+  do {
+    const __m256i outer = _mm256_add_epi16(LoadUnaligned32(edge + i),
+                                           LoadUnaligned32(edge + i + 4));
+    const __m256i inner = _mm256_add_epi16(LoadUnaligned32(edge + i + 1),
+                                           LoadUnaligned32(edge + i + 3));
+    const __m256i center = LoadUnaligned32(edge + i + 2);
+    __m256i sum = _mm256_mullo_epi16(outer, outer_tap);
+    sum = _mm256_add_epi16(sum, _mm256_mullo_epi16(inner, inner_tap));
+    sum = _mm256_add_epi16(sum, _mm256_mullo_epi16(center, center_tap));
+    StoreEdge(result + i, RightShiftWithRounding_S16(sum, 4));
+    i += 16;
+  } while (i < size);
+  memcpy(dst_buffer + 1, result + 1, (size - 1) * sizeof(result[0]));
+}
+
+#if LIBGAV1_MAX_BITDEPTH >= 10
+constexpr int kMaxUpsampleSize = 16;
+
+// Applies the upsampling kernel [-1, 9, 9, -1] to alternating pixels, and
+// interleaves the results with the original values. This implementation assumes
+// that it is safe to write the maximum number of upsampled pixels (32) to the
+// edge buffer, even when |size| is small.
+void IntraEdgeUpsampler10bpp_AVX2(void* buffer, int size) {
+  assert(size % 4 == 0 && size <= kMaxUpsampleSize);
+  auto* const pixel_buffer = static_cast<uint16_t*>(buffer);
+  alignas(32) uint16_t temp[kMaxUpsampleSize + 19];
+  temp[0] = temp[1] = pixel_buffer[-1];
+  memcpy(temp + 2, pixel_buffer, sizeof(temp[0]) * size);
+  temp[size + 2] = pixel_buffer[size - 1];
+
+  pixel_buffer[-2] = temp[0];
+  const __m256i src_0 = LoadUnaligned32(temp);
+  const __m256i src_1 = LoadUnaligned32(temp + 1);
+  const __m256i src_2 = LoadUnaligned32(temp + 2);
+  const __m256i src_3 = LoadUnaligned32(temp + 3);
+  const __m256i inner = _mm256_add_epi16(src_1, src_2);
+  const __m256i outer = _mm256_add_epi16(src_0, src_3);
+  // 9 * (src_1 + src_2) - (src_0 + src_3), at most 18 * 1023.
+  const __m256i sum = _mm256_sub_epi16(
+      _mm256_add_epi16(inner, _mm256_slli_epi16(inner, 3)), outer);
+  const __m256i upsampled = _mm256_min_epi16(
+      _mm256_max_epi16(RightShiftWithRounding_S16(sum, 4),
+                       _mm256_setzero_si256()),
+      _mm256_set1_epi16((1 << kBitdepth10) - 1));
+  // The unpacks interleave within each 128-bit lane, giving outputs 0-3 and
+  // 8-11 in |result_lo| and 4-7 and 12-15 in |result_hi|.
+  const __m256i result_lo = _mm256_unpacklo_epi16(upsampled, src_2);
+  const __m256i result_hi = _mm256_unpackhi_epi16(upsampled, src_2);
+  StoreUnaligned32(pixel_buffer - 1,
+                   _mm256_permute2x128_si256(result_lo, result_hi, 0x20));
+  if (size > 8) {
+    StoreUnaligned32(pixel_buffer + 15,
+                     _mm256_permute2x128_si256(result_lo, result_hi, 0x31));
+  }
+}
+#endif  // LIBGAV1_MAX_BITDEPTH >= 10
+
+void Init8bpp() {
+  Dsp* const dsp = dsp_internal::GetWritableDspTable(kBitdepth8);
+  assert(dsp != nullptr);
+  static_cast<void>(dsp);
+#if DSP_ENABLED_8BPP_AVX2(IntraEdgeFilter)
+  dsp->intra_edge_filter = IntraEdgeFilter_AVX2<uint8_t>;
+#endif
+}
+
+#if LIBGAV1_MAX_BITDEPTH >= 10
+void Init10bpp() {
+  Dsp* const dsp = dsp_internal::GetWritableDspTable(kBitdepth10);
+  assert(dsp != nullptr);
+  static_cast<void>(dsp);
+#if DSP_ENABLED_10BPP_AVX2(IntraEdgeFilter)
+  dsp->intra_edge_filter = IntraEdgeFilter_AVX2<uint16_t>;
+#endif
+#if DSP_ENABLED_10BPP_AVX2(IntraEdgeUpsampler)
+  dsp->intra_edge_upsampler = IntraEdgeUpsampler10bpp_AVX2;
+#endif
+}
+#endif  // LIBGAV1_MAX_BITDEPTH >= 10
+
+}  // namespace
+
+void IntraEdgeInit_AVX2() {
+  Init8bpp();
+#if LIBGAV1_MAX_BITDEPTH >= 10
+  Init10bpp();
+#endif
+}
+
+}  // namespace dsp
+}  // namespace libgav1
+
+#else   // !LIBGAV1_TARGETING_AVX2
+namespace libgav1 {
+namespace dsp {
+
+void IntraEdgeInit_AVX2() {}
+
+}  // namespace dsp
+}  // namespace libgav1
+#endif  // LIBGAV1_TARGETING_AVX2
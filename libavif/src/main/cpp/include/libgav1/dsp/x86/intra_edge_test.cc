@@ -0,0 +1,180 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the SSE4.1 and AVX2 intra edge filter and upsampler
+// (intra_edge_sse4.cc and intra_edge_avx2.cc) with the C ones at 8 and 10bpp,
+// on random and extreme pixels, for every edge length and strength
+// Tile::IntraPrediction() may pass.
+//
+// The SIMD functions are reached through their Init functions, so this file
+// is built without SIMD flags and each tier is skipped on CPUs without it.
+
+#include "src/dsp/intra_edge.h"
+
+#include "gtest/gtest.h"
+#include "src/utils/cpu.h"
+
+#if LIBGAV1_ENABLE_SSE4_1
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "src/dsp/dsp.h"
+#include "src/dsp/x86/intra_edge_avx2.h"
+#include "src/dsp/x86/intra_edge_sse4.h"
+#include "src/utils/constants.h"
+
+namespace libgav1 {
+namespace dsp {
+namespace {
+
+struct IntraEdgeTier {
+  const char* name;
+  CpuFeatures feature;
+  void (*init)();
+};
+
+const IntraEdgeTier kIntraEdgeTiers[] = {
+    {"SSE4_1", kSSE4_1, IntraEdgeInit_SSE4_1},
+    {"AVX2", kAVX2, IntraEdgeInit_AVX2}};
+
+class IntraEdgeTest : public testing::TestWithParam<IntraEdgeTier> {
+ protected:
+  // The longest filtered edge is 64 + 64 + 1 pixels and the longest
+  // upsampled one 16 pixels. The buffers leave room on both sides for SIMD
+  // loads and stores past the edge.
+  static constexpr int kMaxFilterSize = 129;
+  static constexpr int kMaxUpsampleSize = 16;
+  static constexpr int kBorder = 32;
+  static constexpr int kBufferSize = kMaxFilterSize + 2 * kBorder;
+
+  void SetUp() override {
+    if ((GetCpuInfo() & GetParam().feature) == 0) {
+      GTEST_SKIP() << GetParam().name << " is not supported by this CPU.";
+    }
+    DspInit();
+  }
+
+  // Pixels are random on even iterations and either 0 or the maximum on odd
+  // ones.
+  template <int bitdepth, typename Pixel>
+  void RandomPixels(int iteration, std::vector<Pixel>* pixels) {
+    constexpr int kPixelMax = (1 << bitdepth) - 1;
+    std::uniform_int_distribution<int> pixel(0, kPixelMax);
+    std::uniform_int_distribution<int> extreme(0, 1);
+    for (auto& value : *pixels) {
+      value = static_cast<Pixel>(((iteration & 1) == 0)
+                                     ? pixel(rng_)
+                                     : extreme(rng_) * kPixelMax);
+    }
+  }
+
+  template <int bitdepth, typename Pixel>
+  void TestFilter();
+  template <int bitdepth, typename Pixel>
+  void TestUpsampler();
+
+  std::mt19937 rng_{kMaxFilterSize};
+};
+
+template <int bitdepth, typename Pixel>
+void IntraEdgeTest::TestFilter() {
+  // intra_edge.cc is built without SIMD flags, so IntraEdgeInit_C() installs
+  // every C function. The tier then replaces the ones it has.
+  IntraEdgeInit_C();
+  const IntraEdgeFilterFunc c_filter = GetDspTable(bitdepth)->intra_edge_filter;
+  GetParam().init();
+  const IntraEdgeFilterFunc simd_filter =
+      GetDspTable(bitdepth)->intra_edge_filter;
+  if (simd_filter == c_filter) {
+    GTEST_SKIP() << "No " << GetParam().name << " edge filter at " << bitdepth
+                 << "bpp.";
+  }
+  std::vector<Pixel> c_buffer(kBufferSize);
+  std::vector<Pixel> simd_buffer(kBufferSize);
+  for (int size = 1; size <= kMaxFilterSize; ++size) {
+    for (int strength = 1; strength <= 3; ++strength) {
+      for (int iteration = 0; iteration < 8; ++iteration) {
+        RandomPixels<bitdepth>(iteration, &c_buffer);
+        simd_buffer = c_buffer;
+        c_filter(c_buffer.data() + kBorder, size, strength);
+        simd_filter(simd_buffer.data() + kBorder, size, strength);
+        ASSERT_EQ(c_buffer, simd_buffer)
+            << bitdepth << "bpp size " << size << ", strength " << strength
+            << ", iteration " << iteration;
+      }
+    }
+  }
+}
+
+template <int bitdepth, typename Pixel>
+void IntraEdgeTest::TestUpsampler() {
+  IntraEdgeInit_C();
+  const IntraEdgeUpsamplerFunc c_upsampler =
+      GetDspTable(bitdepth)->intra_edge_upsampler;
+  GetParam().init();
+  const IntraEdgeUpsamplerFunc simd_upsampler =
+      GetDspTable(bitdepth)->intra_edge_upsampler;
+  if (simd_upsampler == c_upsampler) {
+    GTEST_SKIP() << "No " << GetParam().name << " edge upsampler at "
+                 << bitdepth << "bpp.";
+  }
+  std::vector<Pixel> c_buffer(kBufferSize);
+  std::vector<Pixel> simd_buffer(kBufferSize);
+  for (int size = 4; size <= kMaxUpsampleSize; size += 4) {
+    for (int iteration = 0; iteration < 256; ++iteration) {
+      RandomPixels<bitdepth>(iteration, &c_buffer);
+      simd_buffer = c_buffer;
+      c_upsampler(c_buffer.data() + kBorder, size);
+      simd_upsampler(simd_buffer.data() + kBorder, size);
+      // The SIMD upsamplers may write up to 32 pixels whatever the size, so
+      // only the upsampled edge, from index -2 to 2 * size - 2, is compared.
+      ASSERT_TRUE(std::equal(c_buffer.begin() + kBorder - 2,
+                             c_buffer.begin() + kBorder + 2 * size - 1,
+                             simd_buffer.begin() + kBorder - 2))
+          << bitdepth << "bpp size " << size << ", iteration " << iteration;
+    }
+  }
+}
+
+TEST_P(IntraEdgeTest, Filter8bpp) { TestFilter<kBitdepth8, uint8_t>(); }
+TEST_P(IntraEdgeTest, Upsampler8bpp) { TestUpsampler<kBitdepth8, uint8_t>(); }
+
+#if LIBGAV1_MAX_BITDEPTH >= 10
+TEST_P(IntraEdgeTest, Filter10bpp) { TestFilter<kBitdepth10, uint16_t>(); }
+TEST_P(IntraEdgeTest, Upsampler10bpp) {
+  TestUpsampler<kBitdepth10, uint16_t>();
+}
+#endif  // LIBGAV1_MAX_BITDEPTH >= 10
+
+INSTANTIATE_TEST_SUITE_P(
+    X86, IntraEdgeTest, testing::ValuesIn(kIntraEdgeTiers),
+    [](const testing::TestParamInfo<IntraEdgeTier>& info) {
+      return std::string(info.param.name);
+    });
+
+}  // namespace
+}  // namespace dsp
+}  // namespace libgav1
+
+#else  // !LIBGAV1_ENABLE_SSE4_1
+
+TEST(IntraEdgeTest, X86) {
+  GTEST_SKIP() << "Build this module for x86(-64) to enable the tests.";
+}
+
+#endif  // LIBGAV1_ENABLE_SSE4_1
@@ -1442,6 +1442,182 @@ inline void DirectionalIntraPredictorZone1_SSE4_1(
   }
 }
 
+//------------------------------------------------------------------------------
+// 7.11.2.4 (8) 90 < angle < 180 and (9) angle > 180
+
+// Produce a weighted average whose weights sum to 32. With 10-bit inputs the
+// weighted sum fits in 16 bits.
+inline __m128i InterpolatePairs(const __m128i& vals_0, const __m128i& vals_1,
+                                const int shift) {
+  const __m128i prod_0 = _mm_mullo_epi16(vals_0, _mm_set1_epi16(32 - shift));
+  const __m128i prod_1 = _mm_mullo_epi16(vals_1, _mm_set1_epi16(shift));
+  return RightShiftWithRounding_U16(_mm_add_epi16(prod_0, prod_1),
+                                    5 /*log2(32)*/);
+}
+
+// Returns 8 predicted values from the edge |src|. Output i interpolates
+// src[base + (i << upsample_shift)] with the following pixel. Reads up to 16
+// values from |src + base|.
+inline __m128i DirectionalSample8(const uint16_t* LIBGAV1_RESTRICT const src,
+                                  const int base, const int shift,
+                                  const bool upsampled) {
+  if (upsampled) {
+    // Separate the even and odd pixels into the low and high halves.
+    const __m128i deinterleave =
+        _mm_set_epi8(15, 14, 11, 10, 7, 6, 3, 2, 13, 12, 9, 8, 5, 4, 1, 0);
+    const __m128i vals_0 =
+        _mm_shuffle_epi8(LoadUnaligned16(src + base), deinterleave);
+    const __m128i vals_1 =
+        _mm_shuffle_epi8(LoadUnaligned16(src + base + 8), deinterleave);
+    return InterpolatePairs(_mm_unpacklo_epi64(vals_0, vals_1),
+                            _mm_unpackhi_epi64(vals_0, vals_1), shift);
+  }
+  return InterpolatePairs(LoadUnaligned16(src + base),
+                          LoadUnaligned16(src + base + 1), shift);
+}
+
+// Returns 8 rows of a column predicted from |left|. Within a column the
+// fractional position is constant and each row steps to the next base pixel.
+// |left_y| is the position of the first row.
+inline __m128i DirectionalLeftColumn8(
+    const uint16_t* LIBGAV1_RESTRICT const left, const int left_y,
+    const bool upsampled) {
+  const int upsample_shift = static_cast<int>(upsampled);
+  // Note this assumes an arithmetic shift to handle negative values.
+  const int left_base_y = left_y >> (6 - upsample_shift);
+  const int shift = ((left_y * (1 << upsample_shift)) & 0x3F) >> 1;
+  return DirectionalSample8(left, left_base_y, shift, upsampled);
+}
+
+inline void StoreTile(uint16_t* LIBGAV1_RESTRICT dst, const ptrdiff_t stride,
+                      const __m128i* const rows, const int tile_width,
+                      const int tile_height) {
+  int y = 0;
+  do {
+    if (tile_width == 4) {
+      StoreLo8(dst, rows[y]);
+    } else {
+      StoreUnaligned16(dst, rows[y]);
+    }
+    dst += stride;
+  } while (++y < tile_height);
+}
+
+// 7.11.2.4 (9) angle > 180
+// The block is computed in 8x8 tiles (4 wide or tall for the smallest sizes).
+// Each tile is built a column at a time and then transposed.
+inline void DirectionalIntraPredictorZone3_SSE4_1(
+    void* LIBGAV1_RESTRICT dest, ptrdiff_t stride,
+    const void* LIBGAV1_RESTRICT const left_column, const int width,
+    const int height, const int ystep, const bool upsampled) {
+  const auto* const left = static_cast<const uint16_t*>(left_column);
+  auto* const dst = static_cast<uint16_t*>(dest);
+  stride /= sizeof(uint16_t);
+  const int upsample_shift = static_cast<int>(upsampled);
+  const int tile_width = std::min(width, 8);
+  const int tile_height = std::min(height, 8);
+  // The unused columns of 4xH blocks are left zero.
+  __m128i columns[8] = {};
+  __m128i rows[8];
+  int y = 0;
+  do {
+    const uint16_t* const left_y0 = left + (y << upsample_shift);
+    int x = 0;
+    do {
+      for (int i = 0; i < tile_width; ++i) {
+        columns[i] =
+            DirectionalLeftColumn8(left_y0, (x + i + 1) * ystep, upsampled);
+      }
+      Transpose8x8_U16(columns, rows);
+      StoreTile(dst + y * stride + x, stride, rows, tile_width, tile_height);
+      x += 8;
+    } while (x < width);
+    y += 8;
+  } while (y < height);
+}
+
+// 7.11.2.4 (8) 90 < angle < 180
+// Within a block the top row is used above and to the right of a boundary line
+// and the left column below it, so each 8x8 tile is classified as top-only,
+// left-only or mixed. Left columns are computed only when their bottom pixel
+// uses |left|; this keeps every load within the 16 pixels of padding that
+// precede |top_row| and |left_column|, as the base indices of the used pixels
+// are at least -(1 << upsample_shift) and a tile spans at most 7 more steps.
+inline void DirectionalIntraPredictorZone2_SSE4_1(
+    void* LIBGAV1_RESTRICT dest, ptrdiff_t stride,
+    const void* LIBGAV1_RESTRICT const top_row,
+    const void* LIBGAV1_RESTRICT const left_column, const int width,
+    const int height, const int xstep, const int ystep,
+    const bool upsampled_top, const bool upsampled_left) {
+  const auto* const top = static_cast<const uint16_t*>(top_row);
+  const auto* const left = static_cast<const uint16_t*>(left_column);
+  auto* const dst = static_cast<uint16_t*>(dest);
+  stride /= sizeof(uint16_t);
+
+  assert(xstep > 0);
+  assert(ystep > 0);
+
+  const int upsample_top_shift = static_cast<int>(upsampled_top);
+  const int upsample_left_shift = static_cast<int>(upsampled_left);
+  const int scale_bits_x = 6 - upsample_top_shift;
+  const int min_base_x = -(1 << upsample_top_shift);
+  const int base_step_x = 1 << upsample_top_shift;
+  const int tile_width = std::min(width, 8);
+  const int tile_height = std::min(height, 8);
+  const __m128i min_base_x_vect = _mm_set1_epi16(min_base_x);
+  const __m128i base_offsets = _mm_slli_epi16(
+      _mm_set_epi16(7, 6, 5, 4, 3, 2, 1, 0), upsample_top_shift);
+  __m128i rows[8];
+  int y = 0;
+  do {
+    const int last_top_base_x = (-(y + tile_height) * xstep) >> scale_bits_x;
+    const uint16_t* const left_y0 = left + (y << upsample_left_shift);
+    int x = 0;
+    do {
+      if (last_top_base_x + x * base_step_x >= min_base_x) {
+        // Top-only tile.
+        for (int i = 0; i < tile_height; ++i) {
+          const int top_x = -(y + i + 1) * xstep;
+          const int top_base_x = (top_x >> scale_bits_x) + x * base_step_x;
+          const int shift = ((top_x * (1 << upsample_top_shift)) & 0x3F) >> 1;
+          rows[i] = DirectionalSample8(top, top_base_x, shift, upsampled_top);
+        }
+      } else {
+        __m128i columns[8];
+        for (int i = 0; i < 8; ++i) {
+          if (i < tile_width &&
+              last_top_base_x + (x + i) * base_step_x < min_base_x) {
+            columns[i] = DirectionalLeftColumn8(
+                left_y0, -(x + i + 1) * ystep, upsampled_left);
+          } else {
+            // The whole column is predicted from |top|.
+            columns[i] = _mm_setzero_si128();
+          }
+        }
+        Transpose8x8_U16(columns, rows);
+        // Merge in the top-predicted pixels, stopping at the first row that
+        // is entirely predicted from |left|.
+        for (int i = 0; i < tile_height; ++i) {
+          const int top_x = -(y + i + 1) * xstep;
+          const int top_base_x = (top_x >> scale_bits_x) + x * base_step_x;
+          if (top_base_x + (tile_width - 1) * base_step_x < min_base_x) break;
+          const int shift = ((top_x * (1 << upsample_top_shift)) & 0x3F) >> 1;
+          const __m128i top_vals =
+              DirectionalSample8(top, top_base_x, shift, upsampled_top);
+          const __m128i top_indices =
+              _mm_add_epi16(_mm_set1_epi16(top_base_x), base_offsets);
+          const __m128i use_left =
+              _mm_cmpgt_epi16(min_base_x_vect, top_indices);
+          rows[i] = _mm_blendv_epi8(top_vals, rows[i], use_left);
+        }
+      }
+      StoreTile(dst + y * stride + x, stride, rows, tile_width, tile_height);
+      x += 8;
+    } while (x < width);
+    y += 8;
+  } while (y < height);
+}
+
 void Init10bpp() {
   Dsp* const dsp = dsp_internal::GetWritableDspTable(10);
   assert(dsp != nullptr);
@@ -1450,6 +1626,14 @@ void Init10bpp() {
   dsp->directional_intra_predictor_zone1 =
       DirectionalIntraPredictorZone1_SSE4_1;
 #endif
+#if DSP_ENABLED_10BPP_SSE4_1(DirectionalIntraPredictorZone2)
+  dsp->directional_intra_predictor_zone2 =
+      DirectionalIntraPredictorZone2_SSE4_1;
+#endif
+#if DSP_ENABLED_10BPP_SSE4_1(DirectionalIntraPredictorZone3)
+  dsp->directional_intra_predictor_zone3 =
+      DirectionalIntraPredictorZone3_SSE4_1;
+#endif
 }
 
 }  // namespace
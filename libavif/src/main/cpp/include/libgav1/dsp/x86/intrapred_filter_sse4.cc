@@ -417,7 +417,108 @@ void Init8bpp() {
 
 }  // namespace
 
-void IntraPredFilterInit_SSE4_1() { Init8bpp(); }
+//------------------------------------------------------------------------------
+#if LIBGAV1_MAX_BITDEPTH >= 10
+namespace high_bitdepth {
+namespace {
+
+// The 8-bit version sums the products with _mm_maddubs_epi16(), which only
+// accepts 8-bit pixels. Here the pixels are widened to 16 bits and each of the
+// 8 filters is applied with _mm_madd_epi16(), giving 4 partial sums per output.
+// |pixels| contains p0-p6 as shown above, with a zero in the 8th lane.
+// |taps| contains the 7 taps (and a zero) of each filter, widened to 16 bits.
+inline void Filter4x2_SSE4_1(uint16_t* LIBGAV1_RESTRICT dst,
+                             const ptrdiff_t stride, const __m128i& pixels,
+                             const __m128i* const taps) {
+  const __m128i mul_0 = _mm_madd_epi16(pixels, taps[0]);
+  const __m128i mul_1 = _mm_madd_epi16(pixels, taps[1]);
+  const __m128i mul_2 = _mm_madd_epi16(pixels, taps[2]);
+  const __m128i mul_3 = _mm_madd_epi16(pixels, taps[3]);
+  const __m128i mul_4 = _mm_madd_epi16(pixels, taps[4]);
+  const __m128i mul_5 = _mm_madd_epi16(pixels, taps[5]);
+  const __m128i mul_6 = _mm_madd_epi16(pixels, taps[6]);
+  const __m128i mul_7 = _mm_madd_epi16(pixels, taps[7]);
+  // f0-f3 and f4-f7.
+  const __m128i output_row0 = _mm_hadd_epi32(_mm_hadd_epi32(mul_0, mul_1),
+                                             _mm_hadd_epi32(mul_2, mul_3));
+  const __m128i output_row1 = _mm_hadd_epi32(_mm_hadd_epi32(mul_4, mul_5),
+                                             _mm_hadd_epi32(mul_6, mul_7));
+  // Section 7.11.2.3 specifies Clip1(Round2Signed(pr, 4)). The negative values
+  // are clipped to 0 by the pack, so Round2() is sufficient.
+  const __m128i output = _mm_min_epi16(
+      _mm_packus_epi32(RightShiftWithRounding_S32(output_row0, 4),
+                       RightShiftWithRounding_S32(output_row1, 4)),
+      _mm_set1_epi16((1 << kBitdepth10) - 1));
+  StoreLo8(dst, output);
+  StoreHi8(dst + stride, output);
+}
+
+void FilterIntraPredictor_SSE4_1(void* LIBGAV1_RESTRICT const dest,
+                                 ptrdiff_t stride,
+                                 const void* LIBGAV1_RESTRICT const top_row,
+                                 const void* LIBGAV1_RESTRICT const left_column,
+                                 FilterIntraPredictor pred, const int width,
+                                 const int height) {
+  const auto* const top = static_cast<const uint16_t*>(top_row);
+  const auto* const left = static_cast<const uint16_t*>(left_column);
+  auto* dst = static_cast<uint16_t*>(dest);
+  stride /= sizeof(uint16_t);
+
+  assert(width <= 32 && height <= 32);
+
+  // There is one set of 7 taps for each of the 4x2 output pixels.
+  __m128i taps[8];
+  for (int i = 0; i < 8; ++i) {
+    taps[i] = _mm_cvtepi8_epi16(LoadLo8(kFilterIntraTaps[pred][i]));
+  }
+
+  // The first 4x2 row reads p0-p4 from |top|, the rest from the previous
+  // output rows.
+  const uint16_t* above = top;
+  int y = 0;
+  do {
+    // The top-left pixel of the leftmost block comes from |left| for all but
+    // the first row.
+    uint16_t top_left = (y == 0) ? top[-1] : left[y - 1];
+    uint16_t left_0 = left[y];
+    uint16_t left_1 = left[y + 1];
+    int x = 0;
+    do {
+      __m128i pixels = _mm_slli_si128(LoadLo8(above + x), 2);
+      pixels = _mm_insert_epi16(pixels, top_left, 0);
+      pixels = _mm_insert_epi16(pixels, left_0, 5);
+      pixels = _mm_insert_epi16(pixels, left_1, 6);
+      Filter4x2_SSE4_1(dst + x, stride, pixels, taps);
+      top_left = above[x + 3];
+      left_0 = dst[x + 3];
+      left_1 = dst[stride + x + 3];
+      x += 4;
+    } while (x < width);
+    above = dst + stride;
+    dst += stride << 1;
+    y += 2;
+  } while (y < height);
+}
+
+void Init10bpp() {
+  Dsp* const dsp = dsp_internal::GetWritableDspTable(kBitdepth10);
+  assert(dsp != nullptr);
+  static_cast<void>(dsp);
+#if DSP_ENABLED_10BPP_SSE4_1(FilterIntraPredictor)
+  dsp->filter_intra_predictor = FilterIntraPredictor_SSE4_1;
+#endif
+}
+
+}  // namespace
+}  // namespace high_bitdepth
+#endif  // LIBGAV1_MAX_BITDEPTH >= 10
+
+void IntraPredFilterInit_SSE4_1() {
+  Init8bpp();
+#if LIBGAV1_MAX_BITDEPTH >= 10
+  high_bitdepth::Init10bpp();
+#endif
+}
 
 }  // namespace dsp
 }  // namespace libgav1
@@ -36,6 +36,10 @@ void IntraPredFilterInit_SSE4_1();
 #ifndef LIBGAV1_Dsp8bpp_FilterIntraPredictor
 #define LIBGAV1_Dsp8bpp_FilterIntraPredictor LIBGAV1_CPU_SSE4_1
 #endif
+
+#ifndef LIBGAV1_Dsp10bpp_FilterIntraPredictor
+#define LIBGAV1_Dsp10bpp_FilterIntraPredictor LIBGAV1_CPU_SSE4_1
+#endif
 #endif  // LIBGAV1_TARGETING_SSE4_1
 
 #endif  // LIBGAV1_SRC_DSP_X86_INTRAPRED_FILTER_SSE4_H_
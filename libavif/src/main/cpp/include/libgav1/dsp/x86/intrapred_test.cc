@@ -0,0 +1,364 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the SSE4.1 intra predictors (intrapred_sse4.cc,
+// intrapred_smooth_sse4.cc, intrapred_directional_sse4.cc and
+// intrapred_filter_sse4.cc) with the C ones at 8 and 10bpp, on random and
+// extreme edges: the per transform size predictors, each directional zone at
+// every angle a block may code, with and without upsampled edges, and filter
+// intra.
+//
+// The SIMD functions are reached through their Init functions, so this file
+// is built without SIMD flags and each tier is skipped on CPUs without it.
+
+#include "src/dsp/intrapred.h"
+
+#include "gtest/gtest.h"
+#include "src/utils/cpu.h"
+
+#if LIBGAV1_ENABLE_SSE4_1
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "src/dsp/dsp.h"
+#include "src/dsp/intrapred_directional.h"
+#include "src/dsp/intrapred_filter.h"
+#include "src/dsp/intrapred_smooth.h"
+#include "src/dsp/x86/intrapred_directional_sse4.h"
+#include "src/dsp/x86/intrapred_filter_sse4.h"
+#include "src/dsp/x86/intrapred_smooth_sse4.h"
+#include "src/dsp/x86/intrapred_sse4.h"
+#include "src/utils/common.h"
+#include "src/utils/constants.h"
+#include "src/utils/memory.h"
+
+namespace libgav1 {
+namespace dsp {
+namespace {
+
+void InitIntraPredictors_C() {
+  IntraPredInit_C();
+  IntraPredSmoothInit_C();
+  IntraPredDirectionalInit_C();
+  IntraPredFilterInit_C();
+}
+
+void InitIntraPredictors_SSE4_1() {
+  IntraPredInit_SSE4_1();
+  IntraPredSmoothInit_SSE4_1();
+  IntraPredDirectionalInit_SSE4_1();
+  IntraPredFilterInit_SSE4_1();
+}
+
+struct IntraPredTier {
+  const char* name;
+  CpuFeatures feature;
+  void (*init)();
+};
+
+const IntraPredTier kIntraPredTiers[] = {
+    {"SSE4_1", kSSE4_1, InitIntraPredictors_SSE4_1}};
+
+// The same as in tile/prediction.cc.
+int GetDirectionalIntraPredictorDerivative(const int angle) {
+  return kDirectionalIntraPredictorDerivative[DivideBy2(angle) - 1];
+}
+
+// The same as in tile/prediction.cc. |filter_type| -1 stands for a sequence
+// without the intra edge filter.
+bool DoIntraEdgeUpsampling(int width, int height, int filter_type, int delta) {
+  if (filter_type < 0) return false;
+  const int sum = width + height;
+  delta = std::abs(delta);
+  if (delta >= 40) return false;
+  return (filter_type == 1) ? sum <= 8 : sum <= 16;
+}
+
+// The prediction angles of the directional modes: the base angle of each mode
+// plus a delta of -9 to 9 in steps of 3, less 90 and 180.
+std::vector<int> PredictionAngles() {
+  std::vector<int> angles;
+  for (const int base : {45, 67, 113, 135, 157, 203, 90, 180}) {
+    for (int delta = -9; delta <= 9; delta += 3) {
+      const int angle = base + delta;
+      if (angle != 90 && angle != 180) angles.push_back(angle);
+    }
+  }
+  std::sort(angles.begin(), angles.end());
+  angles.erase(std::unique(angles.begin(), angles.end()), angles.end());
+  return angles;
+}
+
+class IntraPredTest : public testing::TestWithParam<IntraPredTier> {
+ protected:
+  // The edge buffers of Tile::IntraPrediction(): 160 pixels, used from an
+  // offset of 16 so that predictors may read in front of the edges.
+  static constexpr int kEdgeSize = 160;
+  static constexpr int kEdgeOffset = 16;
+  static constexpr int kStride = 64 + 16;
+
+  void SetUp() override {
+    if ((GetCpuInfo() & GetParam().feature) == 0) {
+      GTEST_SKIP() << GetParam().name << " is not supported by this CPU.";
+    }
+    DspInit();
+  }
+
+  // Saves the C and then the tier's table of |bitdepth|.
+  void InitTables(int bitdepth) {
+    InitIntraPredictors_C();
+    c_ = *GetDspTable(bitdepth);
+    GetParam().init();
+    simd_ = *GetDspTable(bitdepth);
+  }
+
+  // Edges are random on even iterations and either 0 or the maximum on odd
+  // ones.
+  template <int bitdepth, typename Pixel>
+  void RandomEdges(int iteration, Pixel* top_row_data,
+                   Pixel* left_column_data) {
+    constexpr int kPixelMax = (1 << bitdepth) - 1;
+    std::uniform_int_distribution<int> pixel(0, kPixelMax);
+    std::uniform_int_distribution<int> extreme(0, 1);
+    for (Pixel* const edge : {top_row_data, left_column_data}) {
+      for (int i = 0; i < kEdgeSize; ++i) {
+        edge[i] = static_cast<Pixel>(((iteration & 1) == 0)
+                                         ? pixel(rng_)
+                                         : extreme(rng_) * kPixelMax);
+      }
+    }
+  }
+
+  template <int bitdepth, typename Pixel>
+  void TestPredictors();
+  template <int bitdepth, typename Pixel>
+  void TestDirectional();
+  template <int bitdepth, typename Pixel>
+  void TestFilterIntra();
+
+  // Runs |predict| with the C and the SIMD destination and compares the
+  // |width|x|height| blocks.
+  template <int bitdepth, typename Pixel, typename Predict>
+  void Compare(int width, int height, int iteration, const Predict& predict,
+               const std::string& name);
+
+  Dsp c_;
+  Dsp simd_;
+  std::mt19937 rng_{kEdgeSize};
+};
+
+template <int bitdepth, typename Pixel, typename Predict>
+void IntraPredTest::Compare(int width, int height, int iteration,
+                            const Predict& predict, const std::string& name) {
+  std::vector<Pixel> c_dest(kStride * 64);
+  std::vector<Pixel> simd_dest(kStride * 64);
+  predict(&c_, c_dest.data());
+  predict(&simd_, simd_dest.data());
+  for (int y = 0; y < height; ++y) {
+    const Pixel* const c_row = c_dest.data() + y * kStride;
+    const Pixel* const simd_row = simd_dest.data() + y * kStride;
+    ASSERT_TRUE(std::equal(c_row, c_row + width, simd_row))
+        << bitdepth << "bpp " << name << " " << width << "x" << height
+        << ", row " << y << ", iteration " << iteration;
+  }
+}
+
+template <int bitdepth, typename Pixel>
+void IntraPredTest::TestPredictors() {
+  InitTables(bitdepth);
+  AlignedUniquePtr<Pixel> top_row_data =
+      MakeAlignedUniquePtr<Pixel>(kMaxAlignment, kEdgeSize);
+  AlignedUniquePtr<Pixel> left_column_data =
+      MakeAlignedUniquePtr<Pixel>(kMaxAlignment, kEdgeSize);
+  ASSERT_NE(top_row_data, nullptr);
+  ASSERT_NE(left_column_data, nullptr);
+  const Pixel* const top_row = top_row_data.get() + kEdgeOffset;
+  const Pixel* const left_column = left_column_data.get() + kEdgeOffset;
+  int num_simd = 0;
+  for (int size = 0; size < kNumTransformSizes; ++size) {
+    const auto tx_size = static_cast<TransformSize>(size);
+    for (int predictor = 0; predictor < kNumIntraPredictors; ++predictor) {
+      const IntraPredictorFunc c_func = c_.intra_predictors[size][predictor];
+      if (simd_.intra_predictors[size][predictor] == c_func) continue;
+      ++num_simd;
+      for (int iteration = 0; iteration < 16; ++iteration) {
+        RandomEdges<bitdepth>(iteration, top_row_data.get(),
+                              left_column_data.get());
+        Compare<bitdepth, Pixel>(
+            kTransformWidth[tx_size], kTransformHeight[tx_size], iteration,
+            [&](const Dsp* dsp, Pixel* dest) {
+              dsp->intra_predictors[size][predictor](
+                  dest, kStride * sizeof(Pixel), top_row, left_column);
+            },
+            "predictor " + std::to_string(predictor));
+        if (HasFatalFailure()) return;
+      }
+    }
+  }
+  if (num_simd == 0) {
+    GTEST_SKIP() << "No " << GetParam().name << " predictors at " << bitdepth
+                 << "bpp.";
+  }
+}
+
+template <int bitdepth, typename Pixel>
+void IntraPredTest::TestDirectional() {
+  InitTables(bitdepth);
+  const bool test_zone[3] = {
+      simd_.directional_intra_predictor_zone1 !=
+          c_.directional_intra_predictor_zone1,
+      simd_.directional_intra_predictor_zone2 !=
+          c_.directional_intra_predictor_zone2,
+      simd_.directional_intra_predictor_zone3 !=
+          c_.directional_intra_predictor_zone3};
+  if (!test_zone[0] && !test_zone[1] && !test_zone[2]) {
+    GTEST_SKIP() << "No " << GetParam().name << " directional predictors at "
+                 << bitdepth << "bpp.";
+  }
+  AlignedUniquePtr<Pixel> top_row_data =
+      MakeAlignedUniquePtr<Pixel>(kMaxAlignment, kEdgeSize);
+  AlignedUniquePtr<Pixel> left_column_data =
+      MakeAlignedUniquePtr<Pixel>(kMaxAlignment, kEdgeSize);
+  ASSERT_NE(top_row_data, nullptr);
+  ASSERT_NE(left_column_data, nullptr);
+  const Pixel* const top_row = top_row_data.get() + kEdgeOffset;
+  const Pixel* const left_column = left_column_data.get() + kEdgeOffset;
+  for (int size = 0; size < kNumTransformSizes; ++size) {
+    const int width = kTransformWidth[size];
+    const int height = kTransformHeight[size];
+    for (const int angle : PredictionAngles()) {
+      const int zone = (angle < 90) ? 0 : (angle < 180) ? 1 : 2;
+      if (!test_zone[zone]) continue;
+      for (int filter_type = -1; filter_type <= 1; ++filter_type) {
+        const bool upsampled_top =
+            DoIntraEdgeUpsampling(width, height, filter_type, angle - 90);
+        const bool upsampled_left =
+            DoIntraEdgeUpsampling(width, height, filter_type, angle - 180);
+        for (int iteration = 0; iteration < 4; ++iteration) {
+          RandomEdges<bitdepth>(iteration, top_row_data.get(),
+                                left_column_data.get());
+          Compare<bitdepth, Pixel>(
+              width, height, iteration,
+              [&](const Dsp* dsp, Pixel* dest) {
+                const ptrdiff_t stride = kStride * sizeof(Pixel);
+                if (zone == 0) {
+                  dsp->directional_intra_predictor_zone1(
+                      dest, stride, top_row, width, height,
+                      GetDirectionalIntraPredictorDerivative(angle),
+                      upsampled_top);
+                } else if (zone == 1) {
+                  dsp->directional_intra_predictor_zone2(
+                      dest, stride, top_row, left_column, width, height,
+                      GetDirectionalIntraPredictorDerivative(180 - angle),
+                      GetDirectionalIntraPredictorDerivative(angle - 90),
+                      upsampled_top, upsampled_left);
+                } else {
+                  dsp->directional_intra_predictor_zone3(
+                      dest, stride, left_column, width, height,
+                      GetDirectionalIntraPredictorDerivative(270 - angle),
+                      upsampled_left);
+                }
+              },
+              "zone " + std::to_string(zone + 1) + " angle " +
+                  std::to_string(angle) + " upsampled " +
+                  std::to_string(upsampled_top) + "/" +
+                  std::to_string(upsampled_left));
+          if (HasFatalFailure()) return;
+        }
+      }
+    }
+  }
+}
+
+template <int bitdepth, typename Pixel>
+void IntraPredTest::TestFilterIntra() {
+  InitTables(bitdepth);
+  if (simd_.filter_intra_predictor == c_.filter_intra_predictor) {
+    GTEST_SKIP() << "No " << GetParam().name << " filter intra at "
+                 << bitdepth << "bpp.";
+  }
+  AlignedUniquePtr<Pixel> top_row_data =
+      MakeAlignedUniquePtr<Pixel>(kMaxAlignment, kEdgeSize);
+  AlignedUniquePtr<Pixel> left_column_data =
+      MakeAlignedUniquePtr<Pixel>(kMaxAlignment, kEdgeSize);
+  ASSERT_NE(top_row_data, nullptr);
+  ASSERT_NE(left_column_data, nullptr);
+  const Pixel* const top_row = top_row_data.get() + kEdgeOffset;
+  const Pixel* const left_column = left_column_data.get() + kEdgeOffset;
+  for (int size = 0; size < kNumTransformSizes; ++size) {
+    const int width = kTransformWidth[size];
+    const int height = kTransformHeight[size];
+    // Filter intra is only allowed for blocks of up to 32x32.
+    if (width > 32 || height > 32) continue;
+    for (int pred = 0; pred < kNumFilterIntraPredictors; ++pred) {
+      for (int iteration = 0; iteration < 8; ++iteration) {
+        RandomEdges<bitdepth>(iteration, top_row_data.get(),
+                              left_column_data.get());
+        Compare<bitdepth, Pixel>(
+            width, height, iteration,
+            [&](const Dsp* dsp, Pixel* dest) {
+              dsp->filter_intra_predictor(
+                  dest, kStride * sizeof(Pixel), top_row, left_column,
+                  static_cast<FilterIntraPredictor>(pred), width, height);
+            },
+            "filter intra " + std::to_string(pred));
+        if (HasFatalFailure()) return;
+      }
+    }
+  }
+}
+
+TEST_P(IntraPredTest, Predictors8bpp) { TestPredictors<kBitdepth8, uint8_t>(); }
+TEST_P(IntraPredTest, Directional8bpp) {
+  TestDirectional<kBitdepth8, uint8_t>();
+}
+TEST_P(IntraPredTest, FilterIntra8bpp) {
+  TestFilterIntra<kBitdepth8, uint8_t>();
+}
+
+#if LIBGAV1_MAX_BITDEPTH >= 10
+TEST_P(IntraPredTest, Predictors10bpp) {
+  TestPredictors<kBitdepth10, uint16_t>();
+}
+TEST_P(IntraPredTest, Directional10bpp) {
+  TestDirectional<kBitdepth10, uint16_t>();
+}
+TEST_P(IntraPredTest, FilterIntra10bpp) {
+  TestFilterIntra<kBitdepth10, uint16_t>();
+}
+#endif  // LIBGAV1_MAX_BITDEPTH >= 10
+
+INSTANTIATE_TEST_SUITE_P(X86, IntraPredTest, testing::ValuesIn(kIntraPredTiers),
+                         [](const testing::TestParamInfo<IntraPredTier>& info) {
+                           return std::string(info.param.name);
+                         });
+
+}  // namespace
+}  // namespace dsp
+}  // namespace libgav1
+
+#else  // !LIBGAV1_ENABLE_SSE4_1
+
+TEST(IntraPredTest, X86) {
+  GTEST_SKIP() << "Build this module for x86(-64) to enable the tests.";
+}
+
+#endif  // LIBGAV1_ENABLE_SSE4_1
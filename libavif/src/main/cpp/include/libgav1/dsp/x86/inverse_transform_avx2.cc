@@ -0,0 +1,1592 @@
+// Copyright 2021 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/dsp/inverse_transform.h"
+#include "src/utils/cpu.h"
+
+#if LIBGAV1_TARGETING_AVX2
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#include "src/dsp/constants.h"
+#include "src/dsp/dsp.h"
+#include "src/dsp/x86/common_avx2.h"
+#include "src/utils/array_2d.h"
+#include "src/utils/common.h"
+#include "src/utils/compiler_attributes.h"
+
+namespace libgav1 {
+namespace dsp {
+namespace low_bitdepth {
+namespace {
+
+// Include the constants and utility functions inside the anonymous namespace.
+#include "src/dsp/inverse_transform.inc"
+
+// Each register holds 16 int16_t values. Row transforms process up to 16 rows
+// per pass, rows 0-7 in the low 128-bit lane and rows 8-15 in the high lane.
+// Column transforms process up to 16 columns per pass.
+
+LIBGAV1_ALWAYS_INLINE void ButterflyRotation(__m256i* a, __m256i* b,
+                                             const int angle,
+                                             const bool flip) {
+  const int16_t cos128 = Cos128(angle);
+  const int16_t sin128 = Sin128(angle);
+  const __m256i psin_pcos = _mm256_set1_epi32(
+      static_cast<uint16_t>(cos128) | (static_cast<uint32_t>(sin128) << 16));
+  const __m256i sign = _mm256_set1_epi32(static_cast<int>(0x80000001));
+  // -sin cos, -sin cos, -sin cos, -sin cos
+  const __m256i msin_pcos = _mm256_sign_epi16(psin_pcos, sign);
+  const __m256i ba = _mm256_unpacklo_epi16(*a, *b);
+  const __m256i ab = _mm256_unpacklo_epi16(*b, *a);
+  const __m256i ba_hi = _mm256_unpackhi_epi16(*a, *b);
+  const __m256i ab_hi = _mm256_unpackhi_epi16(*b, *a);
+  const __m256i x0 = _mm256_madd_epi16(ba, msin_pcos);
+  const __m256i y0 = _mm256_madd_epi16(ab, psin_pcos);
+  const __m256i x0_hi = _mm256_madd_epi16(ba_hi, msin_pcos);
+  const __m256i y0_hi = _mm256_madd_epi16(ab_hi, psin_pcos);
+  const __m256i x1 = RightShiftWithRounding_S32(x0, 12);
+  const __m256i y1 = RightShiftWithRounding_S32(y0, 12);
+  const __m256i x1_hi = RightShiftWithRounding_S32(x0_hi, 12);
+  const __m256i y1_hi = RightShiftWithRounding_S32(y0_hi, 12);
+  const __m256i x = _mm256_packs_epi32(x1, x1_hi);
+  const __m256i y = _mm256_packs_epi32(y1, y1_hi);
+  if (flip) {
+    *a = y;
+    *b = x;
+  } else {
+    *a = x;
+    *b = y;
+  }
+}
+
+LIBGAV1_ALWAYS_INLINE void ButterflyRotation_FirstIsZero(__m256i* a, __m256i* b,
+                                                         const int angle,
+                                                         const bool flip) {
+  const int16_t cos128 = Cos128(angle);
+  const int16_t sin128 = Sin128(angle);
+  const __m256i pcos = _mm256_set1_epi16(cos128 << 3);
+  const __m256i psin = _mm256_set1_epi16(-(sin128 << 3));
+  const __m256i x = _mm256_mulhrs_epi16(*b, psin);
+  const __m256i y = _mm256_mulhrs_epi16(*b, pcos);
+  if (flip) {
+    *a = y;
+    *b = x;
+  } else {
+    *a = x;
+    *b = y;
+  }
+}
+
+LIBGAV1_ALWAYS_INLINE void ButterflyRotation_SecondIsZero(__m256i* a,
+                                                          __m256i* b,
+                                                          const int angle,
+                                                          const bool flip) {
+  const int16_t cos128 = Cos128(angle);
+  const int16_t sin128 = Sin128(angle);
+  const __m256i pcos = _mm256_set1_epi16(cos128 << 3);
+  const __m256i psin = _mm256_set1_epi16(sin128 << 3);
+  const __m256i x = _mm256_mulhrs_epi16(*a, pcos);
+  const __m256i y = _mm256_mulhrs_epi16(*a, psin);
+  if (flip) {
+    *a = y;
+    *b = x;
+  } else {
+    *a = x;
+    *b = y;
+  }
+}
+
+// For 8bpp the intermediate range of both passes is 16 bits, so the
+// saturating adds and subtracts already clamp to it and |min| and |max| are
+// not used.
+LIBGAV1_ALWAYS_INLINE void HadamardRotation(__m256i* a, __m256i* b, bool flip,
+                                            const __m256i /*min*/,
+                                            const __m256i /*max*/) {
+  __m256i x, y;
+  if (flip) {
+    y = _mm256_adds_epi16(*b, *a);
+    x = _mm256_subs_epi16(*b, *a);
+  } else {
+    x = _mm256_adds_epi16(*a, *b);
+    y = _mm256_subs_epi16(*a, *b);
+  }
+  *a = x;
+  *b = y;
+}
+
+LIBGAV1_ALWAYS_INLINE __m256i Negate(const __m256i x) {
+  return _mm256_subs_epi16(_mm256_setzero_si256(), x);
+}
+
+using TransformVector = __m256i;
+using Transform1dFunc = void (*)(__m256i* x, __m256i min, __m256i max);
+using DcOnlyColumnFunc = void (*)(__m256i* x);
+
+#include "src/dsp/x86/inverse_transform_avx2.inc"
+
+LIBGAV1_ALWAYS_INLINE __m256i ShiftResidual(const __m256i residual,
+                                            const __m256i v_row_shift_add,
+                                            const __m128i v_row_shift) {
+  const __m256i k7ffd = _mm256_set1_epi16(0x7ffd);
+  // The max row_shift is 2, so int16_t values greater than 0x7ffd may
+  // overflow.  Generate a mask for this case.
+  const __m256i mask = _mm256_cmpgt_epi16(residual, k7ffd);
+  const __m256i x = _mm256_add_epi16(residual, v_row_shift_add);
+  // Assume int16_t values.
+  const __m256i a = _mm256_sra_epi16(x, v_row_shift);
+  // Assume uint16_t values.
+  const __m256i b = _mm256_srl_epi16(x, v_row_shift);
+  // Select the correct shifted value.
+  return _mm256_blendv_epi8(a, b, mask);
+}
+
+// Transposes the 8x8 blocks held in the low and high lanes of |in|
+// independently.
+LIBGAV1_ALWAYS_INLINE void Transpose8x8_U16(const __m256i* const in,
+                                            __m256i* const out) {
+  const __m256i a0 = _mm256_unpacklo_epi16(in[0], in[1]);
+  const __m256i a1 = _mm256_unpacklo_epi16(in[2], in[3]);
+  const __m256i a2 = _mm256_unpacklo_epi16(in[4], in[5]);
+  const __m256i a3 = _mm256_unpacklo_epi16(in[6], in[7]);
+  const __m256i a4 = _mm256_unpackhi_epi16(in[0], in[1]);
+  const __m256i a5 = _mm256_unpackhi_epi16(in[2], in[3]);
+  const __m256i a6 = _mm256_unpackhi_epi16(in[4], in[5]);
+  const __m256i a7 = _mm256_unpackhi_epi16(in[6], in[7]);
+
+  const __m256i b0 = _mm256_unpacklo_epi32(a0, a1);
+  const __m256i b1 = _mm256_unpacklo_epi32(a2, a3);
+  const __m256i b2 = _mm256_unpacklo_epi32(a4, a5);
+  const __m256i b3 = _mm256_unpacklo_epi32(a6, a7);
+  const __m256i b4 = _mm256_unpackhi_epi32(a0, a1);
+  const __m256i b5 = _mm256_unpackhi_epi32(a2, a3);
+  const __m256i b6 = _mm256_unpackhi_epi32(a4, a5);
+  const __m256i b7 = _mm256_unpackhi_epi32(a6, a7);
+
+  out[0] = _mm256_unpacklo_epi64(b0, b1);
+  out[1] = _mm256_unpackhi_epi64(b0, b1);
+  out[2] = _mm256_unpacklo_epi64(b4, b5);
+  out[3] = _mm256_unpackhi_epi64(b4, b5);
+  out[4] = _mm256_unpacklo_epi64(b2, b3);
+  out[5] = _mm256_unpackhi_epi64(b2, b3);
+  out[6] = _mm256_unpacklo_epi64(b6, b7);
+  out[7] = _mm256_unpackhi_epi64(b6, b7);
+}
+
+// Loads |num_rows| (at most 16) rows of |tx_width| coefficients from |src| so
+// that x[i] holds coefficient i of every row. Rows past |num_rows| are zero.
+template <int tx_width>
+LIBGAV1_ALWAYS_INLINE void LoadRows(const int16_t* LIBGAV1_RESTRICT src,
+                                    const int num_rows, __m256i* x) {
+  // The last 32 values of every row are always zero if the |tx_width| is 64.
+  constexpr int kNonZeroWidth = (tx_width < 64) ? tx_width : 32;
+  for (int j = 0; j < kNonZeroWidth; j += 8) {
+    __m256i in[8];
+    if (num_rows == 16) {
+      for (int i = 0; i < 8; ++i) {
+        in[i] = SetrM128i(LoadUnaligned16(&src[i * tx_width + j]),
+                          LoadUnaligned16(&src[(i + 8) * tx_width + j]));
+      }
+    } else {
+      for (int i = 0; i < 8; ++i) {
+        const __m128i lo = (i < num_rows)
+                               ? LoadUnaligned16(&src[i * tx_width + j])
+                               : _mm_setzero_si128();
+        const __m128i hi = (i + 8 < num_rows)
+                               ? LoadUnaligned16(&src[(i + 8) * tx_width + j])
+                               : _mm_setzero_si128();
+        in[i] = SetrM128i(lo, hi);
+      }
+    }
+    Transpose8x8_U16(in, &x[j]);
+  }
+}
+
+// The inverse of LoadRows(). Only the first |num_rows| rows are written.
+template <int tx_width>
+LIBGAV1_ALWAYS_INLINE void StoreRows(int16_t* LIBGAV1_RESTRICT dst,
+                                     const int num_rows, const __m256i* x) {
+  for (int j = 0; j < tx_width; j += 8) {
+    __m256i out[8];
+    Transpose8x8_U16(&x[j], out);
+    for (int i = 0; i < 8 && i < num_rows; ++i) {
+      StoreUnaligned16(&dst[i * tx_width + j], _mm256_castsi256_si128(out[i]));
+    }
+    for (int i = 8; i < num_rows; ++i) {
+      StoreUnaligned16(&dst[i * tx_width + j],
+                       _mm256_extracti128_si256(out[i - 8], 1));
+    }
+  }
+}
+
+// Applies |transform1d| to the first |adjusted_tx_height| rows of |src|,
+// folding in the rounding of rectangular transforms and the row shift.
+template <int tx_width, Transform1dFunc transform1d>
+LIBGAV1_ALWAYS_INLINE void TransformRows(int16_t* src, int adjusted_tx_height,
+                                         bool should_round, int row_shift) {
+  constexpr int kNonZeroWidth = (tx_width < 64) ? tx_width : 32;
+  const __m256i min = _mm256_set1_epi16(INT16_MIN);
+  const __m256i max = _mm256_set1_epi16(INT16_MAX);
+  const __m256i v_kTransformRowMultiplier =
+      _mm256_set1_epi16(kTransformRowMultiplier << 3);
+  const __m256i v_row_shift_add = _mm256_set1_epi16(row_shift);
+  const __m128i v_row_shift = _mm_cvtsi32_si128(row_shift);
+  int i = 0;
+  do {
+    const int num_rows = std::min(adjusted_tx_height - i, 16);
+    int16_t* const rows = &src[i * tx_width];
+    __m256i x[tx_width];
+    LoadRows<tx_width>(rows, num_rows, x);
+    if (should_round) {
+      for (int j = 0; j < kNonZeroWidth; ++j) {
+        x[j] = _mm256_mulhrs_epi16(x[j], v_kTransformRowMultiplier);
+      }
+    }
+    transform1d(x, min, max);
+    if (row_shift > 0) {
+      for (int j = 0; j < tx_width; ++j) {
+        x[j] = ShiftResidual(x[j], v_row_shift_add, v_row_shift);
+      }
+    }
+    StoreRows<tx_width>(rows, num_rows, x);
+    i += 16;
+  } while (i < adjusted_tx_height);
+}
+
+template <int block_width>
+LIBGAV1_ALWAYS_INLINE __m256i LoadColumns(const int16_t* src) {
+  if (block_width == 16) return LoadUnaligned32(src);
+  if (block_width == 8) return _mm256_castsi128_si256(LoadUnaligned16(src));
+  return _mm256_castsi128_si256(LoadLo8(src));
+}
+
+template <int block_width>
+LIBGAV1_ALWAYS_INLINE void StoreToFrameWithRound(uint8_t* LIBGAV1_RESTRICT dst,
+                                                 const __m256i residual) {
+  const __m256i v_eight = _mm256_set1_epi16(8);
+  // Saturate to prevent overflowing int16_t
+  const __m256i a = _mm256_adds_epi16(residual, v_eight);
+  const __m256i b = _mm256_srai_epi16(a, 4);
+  if (block_width == 16) {
+    const __m256i c = _mm256_cvtepu8_epi16(LoadUnaligned16(dst));
+    const __m256i d = _mm256_adds_epi16(c, b);
+    StoreUnaligned16(dst, _mm_packus_epi16(_mm256_castsi256_si128(d),
+                                           _mm256_extracti128_si256(d, 1)));
+  } else if (block_width == 8) {
+    const __m128i c = _mm_cvtepu8_epi16(LoadLo8(dst));
+    const __m128i d = _mm_adds_epi16(c, _mm256_castsi256_si128(b));
+    StoreLo8(dst, _mm_packus_epi16(d, d));
+  } else {
+    const __m128i c = _mm_cvtepu8_epi16(Load4(dst));
+    const __m128i d = _mm_adds_epi16(c, _mm256_castsi256_si128(b));
+    Store4(dst, _mm_packus_epi16(d, d));
+  }
+}
+
+// Applies |transform1d| (or |dc_only| when only the first row is non-zero) to
+// |block_width| columns of |src| and adds the result to |dst|.
+template <int tx_height, int block_width, Transform1dFunc transform1d,
+          DcOnlyColumnFunc dc_only>
+LIBGAV1_ALWAYS_INLINE void TransformColumnBlock(
+    const int16_t* LIBGAV1_RESTRICT src, const int tx_width,
+    const int adjusted_tx_height, const bool flip_rows,
+    uint8_t* LIBGAV1_RESTRICT dst, const int stride) {
+  // The last 32 rows are always zero if the |tx_height| is 64.
+  constexpr int kNonZeroHeight = (tx_height < 64) ? tx_height : 32;
+  const __m256i min = _mm256_set1_epi16(INT16_MIN);
+  const __m256i max = _mm256_set1_epi16(INT16_MAX);
+  __m256i x[tx_height];
+  if (adjusted_tx_height == 1) {
+    x[0] = LoadColumns<block_width>(src);
+    dc_only(x);
+  } else {
+    for (int i = 0; i < kNonZeroHeight; ++i) {
+      x[i] = LoadColumns<block_width>(&src[i * tx_width]);
+    }
+    transform1d(x, min, max);
+  }
+  for (int i = 0; i < tx_height; ++i) {
+    const int row = flip_rows ? tx_height - i - 1 : i;
+    StoreToFrameWithRound<block_width>(dst, x[row]);
+    dst += stride;
+  }
+}
+
+template <int tx_height, Transform1dFunc transform1d, DcOnlyColumnFunc dc_only>
+LIBGAV1_ALWAYS_INLINE void TransformColumns(const int16_t* src, int tx_width,
+                                            int adjusted_tx_height,
+                                            bool flip_rows, int start_x,
+                                            int start_y, void* dst_frame) {
+  auto& frame = *static_cast<Array2DView<uint8_t>*>(dst_frame);
+  const int stride = frame.columns();
+  uint8_t* const dst = frame[start_y] + start_x;
+  if (tx_width == 4) {
+    TransformColumnBlock<tx_height, 4, transform1d, dc_only>(
+        src, 4, adjusted_tx_height, flip_rows, dst, stride);
+  } else if (tx_width == 8) {
+    TransformColumnBlock<tx_height, 8, transform1d, dc_only>(
+        src, 8, adjusted_tx_height, flip_rows, dst, stride);
+  } else {
+    int j = 0;
+    do {
+      TransformColumnBlock<tx_height, 16, transform1d, dc_only>(
+          &src[j], tx_width, adjusted_tx_height, flip_rows, &dst[j], stride);
+      j += 16;
+    } while (j < tx_width);
+  }
+}
+
+template <int tx_height>
+LIBGAV1_ALWAYS_INLINE void FlipColumns(int16_t* source, int tx_width) {
+  const __m256i word_reverse_8 =
+      _mm256_set_epi32(0x01000302, 0x05040706, 0x09080b0a, 0x0d0c0f0e,
+                       0x01000302, 0x05040706, 0x09080b0a, 0x0d0c0f0e);
+  if (tx_width >= 16) {
+    for (int i = 0; i < 16 * tx_height; i += 16) {
+      const __m256i a = LoadUnaligned32(&source[i]);
+      const __m256i b = _mm256_shuffle_epi8(a, word_reverse_8);
+      StoreUnaligned32(&source[i], _mm256_permute4x64_epi64(b, 0x4e));
+    }
+  } else if (tx_width == 8) {
+    // Process two rows per iteration.
+    for (int i = 0; i < 8 * tx_height; i += 16) {
+      const __m256i a = LoadUnaligned32(&source[i]);
+      StoreUnaligned32(&source[i], _mm256_shuffle_epi8(a, word_reverse_8));
+    }
+  } else {
+    const __m256i dual_word_reverse_4 =
+        _mm256_set_epi32(0x09080b0a, 0x0d0c0f0e, 0x01000302, 0x05040706,
+                         0x09080b0a, 0x0d0c0f0e, 0x01000302, 0x05040706);
+    // Process four rows per iteration.
+    for (int i = 0; i < 4 * tx_height; i += 16) {
+      const __m256i a = LoadUnaligned32(&source[i]);
+      StoreUnaligned32(&source[i], _mm256_shuffle_epi8(a, dual_word_reverse_4));
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Dc only paths.
+
+template <int width>
+LIBGAV1_ALWAYS_INLINE bool DctDcOnly(void* dest, int adjusted_tx_height,
+                                     bool should_round, int row_shift) {
+  if (adjusted_tx_height > 1) return false;
+
+  auto* dst = static_cast<int16_t*>(dest);
+  const __m256i v_src = _mm256_set1_epi16(dst[0]);
+  const __m256i v_mask =
+      _mm256_set1_epi16(should_round ? static_cast<int16_t>(0xffff) : 0);
+  const __m256i v_kTransformRowMultiplier =
+      _mm256_set1_epi16(kTransformRowMultiplier << 3);
+  const __m256i v_src_round =
+      _mm256_mulhrs_epi16(v_src, v_kTransformRowMultiplier);
+  const __m256i s0 = _mm256_blendv_epi8(v_src, v_src_round, v_mask);
+  const int16_t cos128 = Cos128(32);
+  const __m256i xy = _mm256_mulhrs_epi16(s0, _mm256_set1_epi16(cos128 << 3));
+  const __m256i xy_shifted = ShiftResidual(
+      xy, _mm256_set1_epi16(row_shift), _mm_cvtsi32_si128(row_shift));
+
+  if (width == 8) {
+    StoreUnaligned16(dst, _mm256_castsi256_si128(xy_shifted));
+  } else {
+    for (int i = 0; i < width; i += 16) {
+      StoreUnaligned32(&dst[i], xy_shifted);
+    }
+  }
+  return true;
+}
+
+template <int height>
+LIBGAV1_ALWAYS_INLINE void DctDcOnlyColumn(__m256i* x) {
+  const int16_t cos128 = Cos128(32);
+  const __m256i xy = _mm256_mulhrs_epi16(x[0], _mm256_set1_epi16(cos128 << 3));
+  for (int i = 0; i < height; ++i) {
+    x[i] = xy;
+  }
+}
+
+LIBGAV1_ALWAYS_INLINE void Adst8DcOnlyColumn(__m256i* x) {
+  __m256i s[8];
+  s[1] = x[0];
+  Adst8DcOnlyInternal(s, x);
+}
+
+LIBGAV1_ALWAYS_INLINE void Adst16DcOnlyColumn(__m256i* x) {
+  __m256i s[16];
+  s[1] = x[0];
+  Adst16DcOnlyInternal(s, x);
+}
+
+//------------------------------------------------------------------------------
+// Transform loops.
+
+// The row transforms of the Adst have no separate dc only path: a single row
+// is loaded and the remaining lanes are zero.
+
+template <int tx_width, Transform1dFunc transform1d>
+LIBGAV1_ALWAYS_INLINE void DctTransformLoopRow(TransformSize tx_size,
+                                               int adjusted_tx_height,
+                                               void* src_buffer) {
+  auto* src = static_cast<int16_t*>(src_buffer);
+  const bool should_round = kShouldRound[tx_size];
+  const uint8_t row_shift = kTransformRowShift[tx_size];
+
+  if (DctDcOnly<tx_width>(src, adjusted_tx_height, should_round, row_shift)) {
+    return;
+  }
+  TransformRows<tx_width, transform1d>(src, adjusted_tx_height, should_round,
+                                       row_shift);
+}
+
+void Dct8TransformLoopRow_AVX2(TransformType /*tx_type*/,
+                               TransformSize tx_size, int adjusted_tx_height,
+                               void* src_buffer, int /*start_x*/,
+                               int /*start_y*/, void* /*dst_frame*/) {
+  DctTransformLoopRow<8, Dct8>(tx_size, adjusted_tx_height, src_buffer);
+}
+
+void Dct8TransformLoopColumn_AVX2(TransformType tx_type, TransformSize tx_size,
+                                  int adjusted_tx_height,
+                                  void* LIBGAV1_RESTRICT src_buffer,
+                                  int start_x, int start_y,
+                                  void* LIBGAV1_RESTRICT dst_frame) {
+  auto* src = static_cast<int16_t*>(src_buffer);
+  const int tx_width = kTransformWidth[tx_size];
+
+  if (kTransformFlipColumnsMask.Contains(tx_type)) {
+    FlipColumns<8>(src, tx_width);
+  }
+  TransformColumns<8, Dct8, DctDcOnlyColumn<8>>(src, tx_width,
+                                                adjusted_tx_height,
+                                                /*flip_rows=*/false, start_x,
+                                                start_y, dst_frame);
+}
+
+void Dct16TransformLoopRow_AVX2(TransformType /*tx_type*/,
+                                TransformSize tx_size, int adjusted_tx_height,
+                                void* src_buffer, int /*start_x*/,
+                                int /*start_y*/, void* /*dst_frame*/) {
+  DctTransformLoopRow<16, Dct16>(tx_size, adjusted_tx_height, src_buffer);
+}
+
+void Dct16TransformLoopColumn_AVX2(TransformType tx_type,
+                                   TransformSize tx_size,
+                                   int adjusted_tx_height,
+                                   void* LIBGAV1_RESTRICT src_buffer,
+                                   int start_x, int start_y,
+                                   void* LIBGAV1_RESTRICT dst_frame) {
+  auto* src = static_cast<int16_t*>(src_buffer);
+  const int tx_width = kTransformWidth[tx_size];
+
+  if (kTransformFlipColumnsMask.Contains(tx_type)) {
+    FlipColumns<16>(src, tx_width);
+  }
+  TransformColumns<16, Dct16, DctDcOnlyColumn<16>>(src, tx_width,
+                                                   adjusted_tx_height,
+                                                   /*flip_rows=*/false,
+                                                   start_x, start_y, dst_frame);
+}
+
+void Dct32TransformLoopRow_AVX2(TransformType /*tx_type*/,
+                                TransformSize tx_size, int adjusted_tx_height,
+                                void* src_buffer, int /*start_x*/,
+                                int /*start_y*/, void* /*dst_frame*/) {
+  DctTransformLoopRow<32, Dct32>(tx_size, adjusted_tx_height, src_buffer);
+}
+
+void Dct32TransformLoopColumn_AVX2(TransformType /*tx_type*/,
+                                   TransformSize tx_size,
+                                   int adjusted_tx_height,
+                                   void* LIBGAV1_RESTRICT src_buffer,
+                                   int start_x, int start_y,
+                                   void* LIBGAV1_RESTRICT dst_frame) {
+  TransformColumns<32, Dct32, DctDcOnlyColumn<32>>(
+      static_cast<int16_t*>(src_buffer), kTransformWidth[tx_size],
+      adjusted_tx_height, /*flip_rows=*/false, start_x, start_y, dst_frame);
+}
+
+void Dct64TransformLoopRow_AVX2(TransformType /*tx_type*/,
+                                TransformSize tx_size, int adjusted_tx_height,
+                                void* src_buffer, int /*start_x*/,
+                                int /*start_y*/, void* /*dst_frame*/) {
+  DctTransformLoopRow<64, Dct64>(tx_size, adjusted_tx_height, src_buffer);
+}
+
+void Dct64TransformLoopColumn_AVX2(TransformType /*tx_type*/,
+                                   TransformSize tx_size,
+                                   int adjusted_tx_height,
+                                   void* LIBGAV1_RESTRICT src_buffer,
+                                   int start_x, int start_y,
+                                   void* LIBGAV1_RESTRICT dst_frame) {
+  TransformColumns<64, Dct64, DctDcOnlyColumn<64>>(
+      static_cast<int16_t*>(src_buffer), kTransformWidth[tx_size],
+      adjusted_tx_height, /*flip_rows=*/false, start_x, start_y, dst_frame);
+}
+
+void Adst8TransformLoopRow_AVX2(TransformType /*tx_type*/,
+                                TransformSize tx_size, int adjusted_tx_height,
+                                void* src_buffer, int /*start_x*/,
+                                int /*start_y*/, void* /*dst_frame*/) {
+  TransformRows<8, Adst8>(static_cast<int16_t*>(src_buffer),
+                          adjusted_tx_height, kShouldRound[tx_size],
+                          kTransformRowShift[tx_size]);
+}
+
+void Adst8TransformLoopColumn_AVX2(TransformType tx_type, TransformSize tx_size,
+                                   int adjusted_tx_height,
+                                   void* LIBGAV1_RESTRICT src_buffer,
+                                   int start_x, int start_y,
+                                   void* LIBGAV1_RESTRICT dst_frame) {
+  auto* src = static_cast<int16_t*>(src_buffer);
+  const int tx_width = kTransformWidth[tx_size];
+
+  if (kTransformFlipColumnsMask.Contains(tx_type)) {
+    FlipColumns<8>(src, tx_width);
+  }
+  TransformColumns<8, Adst8, Adst8DcOnlyColumn>(
+      src, tx_width, adjusted_tx_height,
+      kTransformFlipRowsMask.Contains(tx_type), start_x, start_y, dst_frame);
+}
+
+void Adst16TransformLoopRow_AVX2(TransformType /*tx_type*/,
+                                 TransformSize tx_size, int adjusted_tx_height,
+                                 void* src_buffer, int /*start_x*/,
+                                 int /*start_y*/, void* /*dst_frame*/) {
+  TransformRows<16, Adst16>(static_cast<int16_t*>(src_buffer),
+                            adjusted_tx_height, kShouldRound[tx_size],
+                            kTransformRowShift[tx_size]);
+}
+
+void Adst16TransformLoopColumn_AVX2(TransformType tx_type,
+                                    TransformSize tx_size,
+                                    int adjusted_tx_height,
+                                    void* LIBGAV1_RESTRICT src_buffer,
+                                    int start_x, int start_y,
+                                    void* LIBGAV1_RESTRICT dst_frame) {
+  auto* src = static_cast<int16_t*>(src_buffer);
+  const int tx_width = kTransformWidth[tx_size];
+
+  if (kTransformFlipColumnsMask.Contains(tx_type)) {
+    FlipColumns<16>(src, tx_width);
+  }
+  TransformColumns<16, Adst16, Adst16DcOnlyColumn>(
+      src, tx_width, adjusted_tx_height,
+      kTransformFlipRowsMask.Contains(tx_type), start_x, start_y, dst_frame);
+}
+
+void Init8bpp() {
+  Dsp* const dsp = dsp_internal::GetWritableDspTable(kBitdepth8);
+  assert(dsp != nullptr);
+
+  // The 4 point transforms, the identity transforms and the Wht gain little
+  // from the wider registers and are left to the SSE4.1 implementation.
+#if DSP_ENABLED_8BPP_AVX2(Transform1dSize8_Transform1dDct)
+  dsp->inverse_transforms[kTransform1dDct][kTransform1dSize8][kRow] =
+      Dct8TransformLoopRow_AVX2;
+  dsp->inverse_transforms[kTransform1dDct][kTransform1dSize8][kColumn] =
+      Dct8TransformLoopColumn_AVX2;
+#endif
+#if DSP_ENABLED_8BPP_AVX2(Transform1dSize16_Transform1dDct)
+  dsp->inverse_transforms[kTransform1dDct][kTransform1dSize16][kRow] =
+      Dct16TransformLoopRow_AVX2;
+  dsp->inverse_transforms[kTransform1dDct][kTransform1dSize16][kColumn] =
+      Dct16TransformLoopColumn_AVX2;
+#endif
+#if DSP_ENABLED_8BPP_AVX2(Transform1dSize32_Transform1dDct)
+  dsp->inverse_transforms[kTransform1dDct][kTransform1dSize32][kRow] =
+      Dct32TransformLoopRow_AVX2;
+  dsp->inverse_transforms[kTransform1dDct][kTransform1dSize32][kColumn] =
+      Dct32TransformLoopColumn_AVX2;
+#endif
+#if DSP_ENABLED_8BPP_AVX2(Transform1dSize64_Transform1dDct)
+  dsp->inverse_transforms[kTransform1dDct][kTransform1dSize64][kRow] =
+      Dct64TransformLoopRow_AVX2;
+  dsp->inverse_transforms[kTransform1dDct][kTransform1dSize64][kColumn] =
+      Dct64TransformLoopColumn_AVX2;
+#endif
+#if DSP_ENABLED_8BPP_AVX2(Transform1dSize8_Transform1dAdst)
+  dsp->inverse_transforms[kTransform1dAdst][kTransform1dSize8][kRow] =
+      Adst8TransformLoopRow_AVX2;
+  dsp->inverse_transforms[kTransform1dAdst][kTransform1dSize8][kColumn] =
+      Adst8TransformLoopColumn_AVX2;
+#endif
+#if DSP_ENABLED_8BPP_AVX2(Transform1dSize16_Transform1dAdst)
+  dsp->inverse_transforms[kTransform1dAdst][kTransform1dSize16][kRow] =
+      Adst16TransformLoopRow_AVX2;
+  dsp->inverse_transforms[kTransform1dAdst][kTransform1dSize16][kColumn] =
+      Adst16TransformLoopColumn_AVX2;
+#endif
+}
+
+}  // namespace
+}  // namespace low_bitdepth
+
+//------------------------------------------------------------------------------
+#if LIBGAV1_MAX_BITDEPTH >= 10
+namespace high_bitdepth {
+namespace {
+
+// Include the constants and utility functions inside the anonymous namespace.
+#include "src/dsp/inverse_transform.inc"
+
+// Each register holds 8 int32_t values. Row transforms process up to 8 rows
+// per pass and column transforms up to 8 columns.
+
+LIBGAV1_ALWAYS_INLINE void ButterflyRotation(__m256i* a, __m256i* b,
+                                             const int angle,
+                                             const bool flip) {
+  const __m256i pcos = _mm256_set1_epi32(Cos128(angle));
+  const __m256i psin = _mm256_set1_epi32(Sin128(angle));
+  const __m256i x0 = _mm256_sub_epi32(_mm256_mullo_epi32(*a, pcos),
+                                      _mm256_mullo_epi32(*b, psin));
+  const __m256i y0 = _mm256_add_epi32(_mm256_mullo_epi32(*a, psin),
+                                      _mm256_mullo_epi32(*b, pcos));
+  const __m256i x = RightShiftWithRounding_S32(x0, 12);
+  const __m256i y = RightShiftWithRounding_S32(y0, 12);
+  if (flip) {
+    *a = y;
+    *b = x;
+  } else {
+    *a = x;
+    *b = y;
+  }
+}
+
+LIBGAV1_ALWAYS_INLINE void ButterflyRotation_FirstIsZero(__m256i* a, __m256i* b,
+                                                         const int angle,
+                                                         const bool flip) {
+  const __m256i pcos = _mm256_set1_epi32(Cos128(angle));
+  const __m256i msin = _mm256_set1_epi32(-Sin128(angle));
+  const __m256i x =
+      RightShiftWithRounding_S32(_mm256_mullo_epi32(*b, msin), 12);
+  const __m256i y =
+      RightShiftWithRounding_S32(_mm256_mullo_epi32(*b, pcos), 12);
+  if (flip) {
+    *a = y;
+    *b = x;
+  } else {
+    *a = x;
+    *b = y;
+  }
+}
+
+LIBGAV1_ALWAYS_INLINE void ButterflyRotation_SecondIsZero(__m256i* a,
+                                                          __m256i* b,
+                                                          const int angle,
+                                                          const bool flip) {
+  const __m256i pcos = _mm256_set1_epi32(Cos128(angle));
+  const __m256i psin = _mm256_set1_epi32(Sin128(angle));
+  const __m256i x =
+      RightShiftWithRounding_S32(_mm256_mullo_epi32(*a, pcos), 12);
+  const __m256i y =
+      RightShiftWithRounding_S32(_mm256_mullo_epi32(*a, psin), 12);
+  if (flip) {
+    *a = y;
+    *b = x;
+  } else {
+    *a = x;
+    *b = y;
+  }
+}
+
+LIBGAV1_ALWAYS_INLINE void HadamardRotation(__m256i* a, __m256i* b, bool flip,
+                                            const __m256i min,
+                                            const __m256i max) {
+  __m256i x, y;
+  if (flip) {
+    y = _mm256_add_epi32(*b, *a);
+    x = _mm256_sub_epi32(*b, *a);
+  } else {
+    x = _mm256_add_epi32(*a, *b);
+    y = _mm256_sub_epi32(*a, *b);
+  }
+  *a = _mm256_min_epi32(_mm256_max_epi32(x, min), max);
+  *b = _mm256_min_epi32(_mm256_max_epi32(y, min), max);
+}
+
+LIBGAV1_ALWAYS_INLINE __m256i Negate(const __m256i x) {
+  return _mm256_sub_epi32(_mm256_setzero_si256(), x);
+}
+
+using TransformVector = __m256i;
+using Transform1dFunc = void (*)(__m256i* x, __m256i min, __m256i max);
+using DcOnlyColumnFunc = void (*)(__m256i* x);
+
+#include "src/dsp/x86/inverse_transform_avx2.inc"
+
+LIBGAV1_ALWAYS_INLINE void Adst4(__m256i* x, const __m256i /*min*/,
+                                 const __m256i /*max*/) {
+  const __m256i kAdst4Multiplier_0 = _mm256_set1_epi32(kAdst4Multiplier[0]);
+  const __m256i kAdst4Multiplier_1 = _mm256_set1_epi32(kAdst4Multiplier[1]);
+  const __m256i kAdst4Multiplier_2 = _mm256_set1_epi32(kAdst4Multiplier[2]);
+  const __m256i kAdst4Multiplier_3 = _mm256_set1_epi32(kAdst4Multiplier[3]);
+  __m256i s[7];
+
+  // stage 1.
+  s[0] = _mm256_mullo_epi32(kAdst4Multiplier_0, x[0]);
+  s[1] = _mm256_mullo_epi32(kAdst4Multiplier_1, x[0]);
+  s[2] = _mm256_mullo_epi32(kAdst4Multiplier_2, x[1]);
+  s[3] = _mm256_mullo_epi32(kAdst4Multiplier_3, x[2]);
+  s[4] = _mm256_mullo_epi32(kAdst4Multiplier_0, x[2]);
+  s[5] = _mm256_mullo_epi32(kAdst4Multiplier_1, x[3]);
+  s[6] = _mm256_mullo_epi32(kAdst4Multiplier_3, x[3]);
+
+  // stage 2.
+  const __m256i a7 = _mm256_sub_epi32(x[0], x[2]);
+  const __m256i b7 = _mm256_add_epi32(a7, x[3]);
+
+  // stage 3.
+  s[0] = _mm256_add_epi32(s[0], s[3]);
+  s[1] = _mm256_sub_epi32(s[1], s[4]);
+  s[3] = s[2];
+  s[2] = _mm256_mullo_epi32(kAdst4Multiplier_2, b7);
+
+  // stage 4.
+  s[0] = _mm256_add_epi32(s[0], s[5]);
+  s[1] = _mm256_sub_epi32(s[1], s[6]);
+
+  // stages 5 and 6.
+  const __m256i x0 = _mm256_add_epi32(s[0], s[3]);
+  const __m256i x1 = _mm256_add_epi32(s[1], s[3]);
+  const __m256i x3 = _mm256_sub_epi32(_mm256_add_epi32(s[0], s[1]), s[3]);
+  x[0] = RightShiftWithRounding_S32(x0, 12);
+  x[1] = RightShiftWithRounding_S32(x1, 12);
+  x[2] = RightShiftWithRounding_S32(s[2], 12);
+  x[3] = RightShiftWithRounding_S32(x3, 12);
+}
+
+// Applies the rounding row shift and clamps the result to the 16 bit
+// intermediate range of the column transforms.
+LIBGAV1_ALWAYS_INLINE __m256i ShiftResidual(const __m256i residual,
+                                            const __m256i v_row_shift_add,
+                                            const __m128i v_row_shift) {
+  const __m256i a = _mm256_sra_epi32(
+      _mm256_add_epi32(residual, v_row_shift_add), v_row_shift);
+  return _mm256_min_epi32(_mm256_max_epi32(a, _mm256_set1_epi32(INT16_MIN)),
+                          _mm256_set1_epi32(INT16_MAX));
+}
+
+LIBGAV1_ALWAYS_INLINE void Transpose8x8_U32(const __m256i* const in,
+                                            __m256i* const out) {
+  // a0: 00 10 01 11 | 04 14 05 15
+  // a1: 02 12 03 13 | 06 16 07 17
+  const __m256i a0 = _mm256_unpacklo_epi32(in[0], in[1]);
+  const __m256i a1 = _mm256_unpackhi_epi32(in[0], in[1]);
+  const __m256i a2 = _mm256_unpacklo_epi32(in[2], in[3]);
+  const __m256i a3 = _mm256_unpackhi_epi32(in[2], in[3]);
+  const __m256i a4 = _mm256_unpacklo_epi32(in[4], in[5]);
+  const __m256i a5 = _mm256_unpackhi_epi32(in[4], in[5]);
+  const __m256i a6 = _mm256_unpacklo_epi32(in[6], in[7]);
+  const __m256i a7 = _mm256_unpackhi_epi32(in[6], in[7]);
+
+  // b0: 00 10 20 30 | 04 14 24 34
+  // b4: 40 50 60 70 | 44 54 64 74
+  const __m256i b0 = _mm256_unpacklo_epi64(a0, a2);
+  const __m256i b1 = _mm256_unpackhi_epi64(a0, a2);
+  const __m256i b2 = _mm256_unpacklo_epi64(a1, a3);
+  const __m256i b3 = _mm256_unpackhi_epi64(a1, a3);
+  const __m256i b4 = _mm256_unpacklo_epi64(a4, a6);
+  const __m256i b5 = _mm256_unpackhi_epi64(a4, a6);
+  const __m256i b6 = _mm256_unpacklo_epi64(a5, a7);
+  const __m256i b7 = _mm256_unpackhi_epi64(a5, a7);
+
+  out[0] = _mm256_permute2x128_si256(b0, b4, 0x20);
+  out[1] = _mm256_permute2x128_si256(b1, b5, 0x20);
+  out[2] = _mm256_permute2x128_si256(b2, b6, 0x20);
+  out[3] = _mm256_permute2x128_si256(b3, b7, 0x20);
+  out[4] = _mm256_permute2x128_si256(b0, b4, 0x31);
+  out[5] = _mm256_permute2x128_si256(b1, b5, 0x31);
+  out[6] = _mm256_permute2x128_si256(b2, b6, 0x31);
+  out[7] = _mm256_permute2x128_si256(b3, b7, 0x31);
+}
+
+// Transposes the 4x4 blocks held in the low and high lanes of |in|
+// independently.
+LIBGAV1_ALWAYS_INLINE void Transpose4x4_U32(const __m256i* const in,
+                                            __m256i* const out) {
+  const __m256i a0 = _mm256_unpacklo_epi32(in[0], in[1]);
+  const __m256i a1 = _mm256_unpackhi_epi32(in[0], in[1]);
+  const __m256i a2 = _mm256_unpacklo_epi32(in[2], in[3]);
+  const __m256i a3 = _mm256_unpackhi_epi32(in[2], in[3]);
+  out[0] = _mm256_unpacklo_epi64(a0, a2);
+  out[1] = _mm256_unpackhi_epi64(a0, a2);
+  out[2] = _mm256_unpacklo_epi64(a1, a3);
+  out[3] = _mm256_unpackhi_epi64(a1, a3);
+}
+
+// Loads |num_rows| (at most 8) rows of |tx_width| coefficients from |src| so
+// that x[i] holds coefficient i of every row. Rows past |num_rows| are zero.
+// Rows of 4 are paired in the two lanes: rows 0-3 low and rows 4-7 high.
+template <int tx_width>
+LIBGAV1_ALWAYS_INLINE void LoadRows(const int32_t* LIBGAV1_RESTRICT src,
+                                    const int num_rows, __m256i* x) {
+  if (tx_width == 4) {
+    __m256i in[4];
+    for (int i = 0; i < 4; ++i) {
+      const __m128i lo = (i < num_rows) ? LoadUnaligned16(&src[i * 4])
+                                        : _mm_setzero_si128();
+      const __m128i hi = (i + 4 < num_rows) ? LoadUnaligned16(&src[(i + 4) * 4])
+                                            : _mm_setzero_si128();
+      in[i] = SetrM128i(lo, hi);
+    }
+    Transpose4x4_U32(in, x);
+    return;
+  }
+  // The last 32 values of every row are always zero if the |tx_width| is 64.
+  constexpr int kNonZeroWidth = (tx_width < 64) ? tx_width : 32;
+  for (int j = 0; j < kNonZeroWidth; j += 8) {
+    __m256i in[8];
+    if (num_rows == 8) {
+      for (int i = 0; i < 8; ++i) {
+        in[i] = LoadUnaligned32(&src[i * tx_width + j]);
+      }
+    } else {
+      for (int i = 0; i < 8; ++i) {
+        in[i] = (i < num_rows) ? LoadUnaligned32(&src[i * tx_width + j])
+                               : _mm256_setzero_si256();
+      }
+    }
+    Transpose8x8_U32(in, &x[j]);
+  }
+}
+
+// The inverse of LoadRows(). Only the first |num_rows| rows are written.
+template <int tx_width>
+LIBGAV1_ALWAYS_INLINE void StoreRows(int32_t* LIBGAV1_RESTRICT dst,
+                                     const int num_rows, const __m256i* x) {
+  if (tx_width == 4) {
+    __m256i out[4];
+    Transpose4x4_U32(x, out);
+    for (int i = 0; i < 4 && i < num_rows; ++i) {
+      StoreUnaligned16(&dst[i * 4], _mm256_castsi256_si128(out[i]));
+    }
+    for (int i = 4; i < num_rows; ++i) {
+      StoreUnaligned16(&dst[i * 4], _mm256_extracti128_si256(out[i - 4], 1));
+    }
+    return;
+  }
+  for (int j = 0; j < tx_width; j += 8) {
+    __m256i out[8];
+    Transpose8x8_U32(&x[j], out);
+    for (int i = 0; i < num_rows; ++i) {
+      StoreUnaligned32(&dst[i * tx_width + j], out[i]);
+    }
+  }
+}
+
+// Applies |transform1d| to the first |adjusted_tx_height| rows of |src|,
+// folding in the rounding of rectangular transforms, the row shift and the
+// clamp to the column input range.
+template <int tx_width, Transform1dFunc transform1d>
+LIBGAV1_ALWAYS_INLINE void TransformRows(int32_t* src, int adjusted_tx_height,
+                                         bool should_round, int row_shift) {
+  constexpr int kNonZeroWidth = (tx_width < 64) ? tx_width : 32;
+  // The row transforms clamp to bitdepth + 8 bits.
+  const __m256i min = _mm256_set1_epi32(-(1 << (kBitdepth10 + 7)));
+  const __m256i max = _mm256_set1_epi32((1 << (kBitdepth10 + 7)) - 1);
+  const __m256i v_kTransformRowMultiplier =
+      _mm256_set1_epi32(kTransformRowMultiplier);
+  const __m256i v_row_shift_add = _mm256_set1_epi32((1 << row_shift) >> 1);
+  const __m128i v_row_shift = _mm_cvtsi32_si128(row_shift);
+  int i = 0;
+  do {
+    const int num_rows = std::min(adjusted_tx_height - i, 8);
+    int32_t* const rows = &src[i * tx_width];
+    __m256i x[tx_width];
+    LoadRows<tx_width>(rows, num_rows, x);
+    if (should_round) {
+      for (int j = 0; j < kNonZeroWidth; ++j) {
+        x[j] = RightShiftWithRounding_S32(
+            _mm256_mullo_epi32(x[j], v_kTransformRowMultiplier), 12);
+      }
+    }
+    transform1d(x, min, max);
+    for (int j = 0; j < tx_width; ++j) {
+      x[j] = ShiftResidual(x[j], v_row_shift_add, v_row_shift);
+    }
+    StoreRows<tx_width>(rows, num_rows, x);
+    i += 8;
+  } while (i < adjusted_tx_height);
+}
+
+template <int block_width>
+LIBGAV1_ALWAYS_INLINE __m256i LoadColumns(const int32_t* src) {
+  if (block_width == 8) return LoadUnaligned32(src);
+  return _mm256_castsi128_si256(LoadUnaligned16(src));
+}
+
+template <int block_width>
+LIBGAV1_ALWAYS_INLINE void StoreToFrame(uint16_t* LIBGAV1_RESTRICT dst,
+                                        const __m256i residual) {
+  const __m256i v_max = _mm256_set1_epi32((1 << kBitdepth10) - 1);
+  if (block_width == 8) {
+    const __m256i a = _mm256_cvtepu16_epi32(LoadUnaligned16(dst));
+    const __m256i b = _mm256_min_epi32(_mm256_add_epi32(a, residual), v_max);
+    // The lower clip to 0 is done by the unsigned saturation.
+    StoreUnaligned16(dst, _mm_packus_epi32(_mm256_castsi256_si128(b),
+                                           _mm256_extracti128_si256(b, 1)));
+  } else {
+    const __m128i a = _mm_cvtepu16_epi32(LoadLo8(dst));
+    const __m128i b = _mm_min_epi32(
+        _mm_add_epi32(a, _mm256_castsi256_si128(residual)),
+        _mm256_castsi256_si128(v_max));
+    StoreLo8(dst, _mm_packus_epi32(b, b));
+  }
+}
+
+// Applies |transform1d| (or |dc_only| when only the first row is non-zero) to
+// |block_width| columns of |src| and adds the result to |dst|.
+template <int tx_height, int block_width, Transform1dFunc transform1d,
+          DcOnlyColumnFunc dc_only>
+LIBGAV1_ALWAYS_INLINE void TransformColumnBlock(
+    const int32_t* LIBGAV1_RESTRICT src, const int tx_width,
+    const int adjusted_tx_height, const bool flip_rows,
+    uint16_t* LIBGAV1_RESTRICT dst, const int stride) {
+  // The last 32 rows are always zero if the |tx_height| is 64.
+  constexpr int kNonZeroHeight = (tx_height < 64) ? tx_height : 32;
+  // The column transforms clamp to Max(bitdepth + 6, 16) bits.
+  const __m256i min = _mm256_set1_epi32(INT16_MIN);
+  const __m256i max = _mm256_set1_epi32(INT16_MAX);
+  __m256i x[tx_height];
+  if (adjusted_tx_height == 1) {
+    x[0] = LoadColumns<block_width>(src);
+    dc_only(x);
+  } else {
+    for (int i = 0; i < kNonZeroHeight; ++i) {
+      x[i] = LoadColumns<block_width>(&src[i * tx_width]);
+    }
+    transform1d(x, min, max);
+  }
+  for (int i = 0; i < tx_height; ++i) {
+    const int row = flip_rows ? tx_height - i - 1 : i;
+    StoreToFrame<block_width>(dst, RightShiftWithRounding_S32(x[row], 4));
+    dst += stride;
+  }
+}
+
+template <int tx_height, Transform1dFunc transform1d, DcOnlyColumnFunc dc_only>
+LIBGAV1_ALWAYS_INLINE void TransformColumns(const int32_t* src, int tx_width,
+                                            int adjusted_tx_height,
+                                            bool flip_rows, int start_x,
+                                            int start_y, void* dst_frame) {
+  auto& frame = *static_cast<Array2DView<uint16_t>*>(dst_frame);
+  const int stride = frame.columns();
+  uint16_t* const dst = frame[start_y] + start_x;
+  if (tx_width == 4) {
+    TransformColumnBlock<tx_height, 4, transform1d, dc_only>(
+        src, 4, adjusted_tx_height, flip_rows, dst, stride);
+  } else {
+    int j = 0;
+    do {
+      TransformColumnBlock<tx_height, 8, transform1d, dc_only>(
+          &src[j], tx_width, adjusted_tx_height, flip_rows, &dst[j], stride);
+      j += 8;
+    } while (j < tx_width);
+  }
+}
+
+template <int tx_height>
+LIBGAV1_ALWAYS_INLINE void FlipColumns(int32_t* source, int tx_width) {
+  const __m256i dword_reverse_8 = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+  if (tx_width >= 16) {
+    for (int i = 0; i < 16 * tx_height; i += 16) {
+      const __m256i a = LoadUnaligned32(&source[i]);
+      const __m256i b = LoadUnaligned32(&source[i + 8]);
+      StoreUnaligned32(&source[i],
+                       _mm256_permutevar8x32_epi32(b, dword_reverse_8));
+      StoreUnaligned32(&source[i + 8],
+                       _mm256_permutevar8x32_epi32(a, dword_reverse_8));
+    }
+  } else if (tx_width == 8) {
+    for (int i = 0; i < 8 * tx_height; i += 8) {
+      const __m256i a = LoadUnaligned32(&source[i]);
+      StoreUnaligned32(&source[i],
+                       _mm256_permutevar8x32_epi32(a, dword_reverse_8));
+    }
+  } else {
+    // Process two rows per iteration.
+    for (int i = 0; i < 4 * tx_height; i += 8) {
+      const __m256i a = LoadUnaligned32(&source[i]);
+      StoreUnaligned32(&source[i], _mm256_shuffle_epi32(a, 0x1b));
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Dc only paths.
+
+template <int width>
+LIBGAV1_ALWAYS_INLINE bool DctDcOnly(void* dest, int adjusted_tx_height,
+                                     bool should_round, int row_shift) {
+  if (adjusted_tx_height > 1) return false;
+
+  auto* dst = static_cast<int32_t*>(dest);
+  const __m256i v_kTransformRowMultiplier =
+      _mm256_set1_epi32(kTransformRowMultiplier);
+  __m256i s0 = _mm256_set1_epi32(dst[0]);
+  if (should_round) {
+    s0 = RightShiftWithRounding_S32(
+        _mm256_mullo_epi32(s0, v_kTransformRowMultiplier), 12);
+  }
+  const __m256i xy = RightShiftWithRounding_S32(
+      _mm256_mullo_epi32(s0, _mm256_set1_epi32(Cos128(32))), 12);
+  const __m256i xy_shifted =
+      ShiftResidual(xy, _mm256_set1_epi32((1 << row_shift) >> 1),
+                    _mm_cvtsi32_si128(row_shift));
+
+  if (width == 4) {
+    StoreUnaligned16(dst, _mm256_castsi256_si128(xy_shifted));
+  } else {
+    for (int i = 0; i < width; i += 8) {
+      StoreUnaligned32(&dst[i], xy_shifted);
+    }
+  }
+  return true;
+}
+
+template <int height>
+LIBGAV1_ALWAYS_INLINE void DctDcOnlyColumn(__m256i* x) {
+  const __m256i xy = RightShiftWithRounding_S32(
+      _mm256_mullo_epi32(x[0], _mm256_set1_epi32(Cos128(32))), 12);
+  for (int i = 0; i < height; ++i) {
+    x[i] = xy;
+  }
+}
+
+LIBGAV1_ALWAYS_INLINE void Adst4DcOnlyColumn(__m256i* x) {
+  x[1] = _mm256_setzero_si256();
+  x[2] = _mm256_setzero_si256();
+  x[3] = _mm256_setzero_si256();
+  Adst4(x, x[1], x[1]);
+}
+
+// The dc only Adst outputs are clamped to the 16 bit intermediate range like
+// those of the reference implementation.
+LIBGAV1_ALWAYS_INLINE void Adst8DcOnlyColumn(__m256i* x) {
+  const __m256i min = _mm256_set1_epi32(INT16_MIN);
+  const __m256i max = _mm256_set1_epi32(INT16_MAX);
+  __m256i s[8];
+  s[1] = x[0];
+  Adst8DcOnlyInternal(s, x);
+  for (int i = 0; i < 8; ++i) {
+    x[i] = _mm256_min_epi32(_mm256_max_epi32(x[i], min), max);
+  }
+}
+
+LIBGAV1_ALWAYS_INLINE void Adst16DcOnlyColumn(__m256i* x) {
+  const __m256i min = _mm256_set1_epi32(INT16_MIN);
+  const __m256i max = _mm256_set1_epi32(INT16_MAX);
+  __m256i s[16];
+  s[1] = x[0];
+  Adst16DcOnlyInternal(s, x);
+  for (int i = 0; i < 16; ++i) {
+    x[i] = _mm256_min_epi32(_mm256_max_epi32(x[i], min), max);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Identity Transforms.
+//
+// The identity transforms scale each coefficient independently, so they are
+// applied to the buffer in place without any transposes.
+
+constexpr int kTransformColumnShift = 4;
+
+template <int identity_size>
+LIBGAV1_ALWAYS_INLINE __m256i IdentityRow(const __m256i v,
+                                          const __m256i v_rounding,
+                                          const __m128i v_shift) {
+  __m256i a;
+  if (identity_size == 4) {
+    a = _mm256_mullo_epi32(v, _mm256_set1_epi32(kIdentity4Multiplier));
+  } else if (identity_size == 8) {
+    a = _mm256_slli_epi32(v, 1);
+  } else if (identity_size == 16) {
+    a = _mm256_mullo_epi32(v, _mm256_set1_epi32(kIdentity16Multiplier));
+  } else {
+    a = _mm256_slli_epi32(v, 2);
+  }
+  const __m256i b = _mm256_sra_epi32(_mm256_add_epi32(a, v_rounding), v_shift);
+  return _mm256_min_epi32(_mm256_max_epi32(b, _mm256_set1_epi32(INT16_MIN)),
+                          _mm256_set1_epi32(INT16_MAX));
+}
+
+template <int identity_size>
+LIBGAV1_ALWAYS_INLINE void IdentityTransformLoopRow(TransformSize tx_size,
+                                                    int adjusted_tx_height,
+                                                    void* src_buffer) {
+  auto* src = static_cast<int32_t*>(src_buffer);
+  const bool should_round = kShouldRound[tx_size];
+  const int row_shift = kTransformRowShift[tx_size];
+  // The identity transforms fold the row shift into their own rounding.
+  int rounding;
+  int shift;
+  if (identity_size == 4) {
+    rounding = (1 + (row_shift << 1)) << 11;
+    shift = 12 + row_shift;
+  } else if (identity_size == 16) {
+    rounding = (1 + (1 << row_shift)) << 11;
+    shift = 12 + row_shift;
+  } else {
+    rounding = (1 << row_shift) >> 1;
+    shift = row_shift;
+  }
+  const __m256i v_rounding = _mm256_set1_epi32(rounding);
+  const __m128i v_shift = _mm_cvtsi32_si128(shift);
+  const __m256i v_kTransformRowMultiplier =
+      _mm256_set1_epi32(kTransformRowMultiplier);
+  // Only a 4x1 block has fewer than 8 values, it is handled in the low lane.
+  const int num_values = adjusted_tx_height * identity_size;
+  int i = 0;
+  do {
+    __m256i v = (num_values == 4)
+                    ? _mm256_castsi128_si256(LoadUnaligned16(&src[i]))
+                    : LoadUnaligned32(&src[i]);
+    if (should_round) {
+      v = RightShiftWithRounding_S32(
+          _mm256_mullo_epi32(v, v_kTransformRowMultiplier), 12);
+    }
+    v = IdentityRow<identity_size>(v, v_rounding, v_shift);
+    if (num_values == 4) {
+      StoreUnaligned16(&src[i], _mm256_castsi256_si128(v));
+    } else {
+      StoreUnaligned32(&src[i], v);
+    }
+    i += 8;
+  } while (i < num_values);
+}
+
+template <int identity_size>
+LIBGAV1_ALWAYS_INLINE __m256i IdentityColumn(const __m256i v) {
+  if (identity_size == 4) {
+    const __m256i a =
+        _mm256_mullo_epi32(v, _mm256_set1_epi32(kIdentity4Multiplier));
+    const __m256i rounding =
+        _mm256_set1_epi32((1 + (1 << kTransformColumnShift)) << 11);
+    return _mm256_srai_epi32(_mm256_add_epi32(a, rounding),
+                             12 + kTransformColumnShift);
+  }
+  if (identity_size == 8) {
+    return RightShiftWithRounding_S32(v, kTransformColumnShift - 1);
+  }
+  if (identity_size == 16) {
+    const __m256i a =
+        _mm256_mullo_epi32(v, _mm256_set1_epi32(kIdentity16Multiplier));
+    const __m256i rounding =
+        _mm256_set1_epi32((1 + (1 << kTransformColumnShift)) << 11);
+    return _mm256_srai_epi32(_mm256_add_epi32(a, rounding),
+                             12 + kTransformColumnShift);
+  }
+  return RightShiftWithRounding_S32(v, kTransformColumnShift - 2);
+}
+
+template <int identity_size>
+LIBGAV1_ALWAYS_INLINE void IdentityTransformLoopColumn(
+    TransformType tx_type, TransformSize tx_size, void* src_buffer,
+    int start_x, int start_y, void* dst_frame) {
+  auto* src = static_cast<int32_t*>(src_buffer);
+  const int tx_width = kTransformWidth[tx_size];
+
+  if (kTransformFlipColumnsMask.Contains(tx_type)) {
+    FlipColumns<identity_size>(src, tx_width);
+  }
+
+  auto& frame = *static_cast<Array2DView<uint16_t>*>(dst_frame);
+  const int stride = frame.columns();
+  uint16_t* dst = frame[start_y] + start_x;
+  for (int i = 0; i < identity_size; ++i) {
+    if (tx_width == 4) {
+      const __m256i v = LoadColumns<4>(&src[i * 4]);
+      StoreToFrame<4>(dst, IdentityColumn<identity_size>(v));
+    } else {
+      for (int j = 0; j < tx_width; j += 8) {
+        const __m256i v = LoadColumns<8>(&src[i * tx_width + j]);
+        StoreToFrame<8>(&dst[j], IdentityColumn<identity_size>(v));
+      }
+    }
+    dst += stride;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Transform loops.
+
+// Except for the Dct, the row transforms have no separate dc only path: a
+// single row is loaded and the remaining lanes are zero.
+
+template <int tx_width, Transform1dFunc transform1d>
+LIBGAV1_ALWAYS_INLINE void DctTransformLoopRow(TransformSize tx_size,
+                                               int adjusted_tx_height,
+                                               void* src_buffer) {
+  auto* src = static_cast<int32_t*>(src_buffer);
+  const bool should_round = kShouldRound[tx_size];
+  const uint8_t row_shift = kTransformRowShift[tx_size];
+
+  if (DctDcOnly<tx_width>(src, adjusted_tx_height, should_round, row_shift)) {
+    return;
+  }
+  TransformRows<tx_width, transform1d>(src, adjusted_tx_height, should_round,
+                                       row_shift);
+}
+
+template <int tx_width, Transform1dFunc transform1d>
+LIBGAV1_ALWAYS_INLINE void AdstTransformLoopRow(TransformSize tx_size,
+                                                int adjusted_tx_height,
+                                                void* src_buffer) {
+  TransformRows<tx_width, transform1d>(
+      static_cast<int32_t*>(src_buffer), adjusted_tx_height,
+      kShouldRound[tx_size], kTransformRowShift[tx_size]);
+}
+
+template <int tx_height, Transform1dFunc transform1d, DcOnlyColumnFunc dc_only,
+          bool is_adst>
+LIBGAV1_ALWAYS_INLINE void TransformLoopColumn(TransformType tx_type,
+                                               TransformSize tx_size,
+                                               int adjusted_tx_height,
+                                               void* src_buffer, int start_x,
+                                               int start_y, void* dst_frame) {
+  auto* src = static_cast<int32_t*>(src_buffer);
+  const int tx_width = kTransformWidth[tx_size];
+
+  // There are no flipped transforms for sizes above 16.
+  if (tx_height <= 16 && kTransformFlipColumnsMask.Contains(tx_type)) {
+    FlipColumns<tx_height>(src, tx_width);
+  }
+  const bool flip_rows = is_adst && kTransformFlipRowsMask.Contains(tx_type);
+  TransformColumns<tx_height, transform1d, dc_only>(
+      src, tx_width, adjusted_tx_height, flip_rows, start_x, start_y,
+      dst_frame);
+}
+
+void Dct4TransformLoopRow_AVX2(TransformType /*tx_type*/,
+                               TransformSize tx_size, int adjusted_tx_height,
+                               void* src_buffer, int /*start_x*/,
+                               int /*start_y*/, void* /*dst_frame*/) {
+  DctTransformLoopRow<4, Dct4>(tx_size, adjusted_tx_height, src_buffer);
+}
+
+void Dct4TransformLoopColumn_AVX2(TransformType tx_type, TransformSize tx_size,
+                                  int adjusted_tx_height,
+                                  void* LIBGAV1_RESTRICT src_buffer,
+                                  int start_x, int start_y,
+                                  void* LIBGAV1_RESTRICT dst_frame) {
+  TransformLoopColumn<4, Dct4, DctDcOnlyColumn<4>, false>(
+      tx_type, tx_size, adjusted_tx_height, src_buffer, start_x, start_y,
+      dst_frame);
+}
+
+void Dct8TransformLoopRow_AVX2(TransformType /*tx_type*/,
+                               TransformSize tx_size, int adjusted_tx_height,
+                               void* src_buffer, int /*start_x*/,
+                               int /*start_y*/, void* /*dst_frame*/) {
+  DctTransformLoopRow<8, Dct8>(tx_size, adjusted_tx_height, src_buffer);
+}
+
+void Dct8TransformLoopColumn_AVX2(TransformType tx_type, TransformSize tx_size,
+                                  int adjusted_tx_height,
+                                  void* LIBGAV1_RESTRICT src_buffer,
+                                  int start_x, int start_y,
+                                  void* LIBGAV1_RESTRICT dst_frame) {
+  TransformLoopColumn<8, Dct8, DctDcOnlyColumn<8>, false>(
+      tx_type, tx_size, adjusted_tx_height, src_buffer, start_x, start_y,
+      dst_frame);
+}
+
+void Dct16TransformLoopRow_AVX2(TransformType /*tx_type*/,
+                                TransformSize tx_size, int adjusted_tx_height,
+                                void* src_buffer, int /*start_x*/,
+                                int /*start_y*/, void* /*dst_frame*/) {
+  DctTransformLoopRow<16, Dct16>(tx_size, adjusted_tx_height, src_buffer);
+}
+
+void Dct16TransformLoopColumn_AVX2(TransformType tx_type,
+                                   TransformSize tx_size,
+                                   int adjusted_tx_height,
+                                   void* LIBGAV1_RESTRICT src_buffer,
+                                   int start_x, int start_y,
+                                   void* LIBGAV1_RESTRICT dst_frame) {
+  TransformLoopColumn<16, Dct16, DctDcOnlyColumn<16>, false>(
+      tx_type, tx_size, adjusted_tx_height, src_buffer, start_x, start_y,
+      dst_frame);
+}
+
+void Dct32TransformLoopRow_AVX2(TransformType /*tx_type*/,
+                                TransformSize tx_size, int adjusted_tx_height,
+                                void* src_buffer, int /*start_x*/,
+                                int /*start_y*/, void* /*dst_frame*/) {
+  DctTransformLoopRow<32, Dct32>(tx_size, adjusted_tx_height, src_buffer);
+}
+
+void Dct32TransformLoopColumn_AVX2(TransformType tx_type,
+                                   TransformSize tx_size,
+                                   int adjusted_tx_height,
+                                   void* LIBGAV1_RESTRICT src_buffer,
+                                   int start_x, int start_y,
+                                   void* LIBGAV1_RESTRICT dst_frame) {
+  TransformLoopColumn<32, Dct32, DctDcOnlyColumn<32>, false>(
+      tx_type, tx_size, adjusted_tx_height, src_buffer, start_x, start_y,
+      dst_frame);
+}
+
+void Dct64TransformLoopRow_AVX2(TransformType /*tx_type*/,
+                                TransformSize tx_size, int adjusted_tx_height,
+                                void* src_buffer, int /*start_x*/,
+                                int /*start_y*/, void* /*dst_frame*/) {
+  DctTransformLoopRow<64, Dct64>(tx_size, adjusted_tx_height, src_buffer);
+}
+
+void Dct64TransformLoopColumn_AVX2(TransformType tx_type,
+                                   TransformSize tx_size,
+                                   int adjusted_tx_height,
+                                   void* LIBGAV1_RESTRICT src_buffer,
+                                   int start_x, int start_y,
+                                   void* LIBGAV1_RESTRICT dst_frame) {
+  TransformLoopColumn<64, Dct64, DctDcOnlyColumn<64>, false>(
+      tx_type, tx_size, adjusted_tx_height, src_buffer, start_x, start_y,
+      dst_frame);
+}
+
+void Adst4TransformLoopRow_AVX2(TransformType /*tx_type*/,
+                                TransformSize tx_size, int adjusted_tx_height,
+                                void* src_buffer, int /*start_x*/,
+                                int /*start_y*/, void* /*dst_frame*/) {
+  AdstTransformLoopRow<4, Adst4>(tx_size, adjusted_tx_height, src_buffer);
+}
+
+void Adst4TransformLoopColumn_AVX2(TransformType tx_type,
+                                   TransformSize tx_size,
+                                   int adjusted_tx_height,
+                                   void* LIBGAV1_RESTRICT src_buffer,
+                                   int start_x, int start_y,
+                                   void* LIBGAV1_RESTRICT dst_frame) {
+  TransformLoopColumn<4, Adst4, Adst4DcOnlyColumn, true>(
+      tx_type, tx_size, adjusted_tx_height, src_buffer, start_x, start_y,
+      dst_frame);
+}
+
+void Adst8TransformLoopRow_AVX2(TransformType /*tx_type*/,
+                                TransformSize tx_size, int adjusted_tx_height,
+                                void* src_buffer, int /*start_x*/,
+                                int /*start_y*/, void* /*dst_frame*/) {
+  AdstTransformLoopRow<8, Adst8>(tx_size, adjusted_tx_height, src_buffer);
+}
+
+void Adst8TransformLoopColumn_AVX2(TransformType tx_type,
+                                   TransformSize tx_size,
+                                   int adjusted_tx_height,
+                                   void* LIBGAV1_RESTRICT src_buffer,
+                                   int start_x, int start_y,
+                                   void* LIBGAV1_RESTRICT dst_frame) {
+  TransformLoopColumn<8, Adst8, Adst8DcOnlyColumn, true>(
+      tx_type, tx_size, adjusted_tx_height, src_buffer, start_x, start_y,
+      dst_frame);
+}
+
+void Adst16TransformLoopRow_AVX2(TransformType /*tx_type*/,
+                                 TransformSize tx_size, int adjusted_tx_height,
+                                 void* src_buffer, int /*start_x*/,
+                                 int /*start_y*/, void* /*dst_frame*/) {
+  AdstTransformLoopRow<16, Adst16>(tx_size, adjusted_tx_height, src_buffer);
+}
+
+void Adst16TransformLoopColumn_AVX2(TransformType tx_type,
+                                    TransformSize tx_size,
+                                    int adjusted_tx_height,
+                                    void* LIBGAV1_RESTRICT src_buffer,
+                                    int start_x, int start_y,
+                                    void* LIBGAV1_RESTRICT dst_frame) {
+  TransformLoopColumn<16, Adst16, Adst16DcOnlyColumn, true>(
+      tx_type, tx_size, adjusted_tx_height, src_buffer, start_x, start_y,
+      dst_frame);
+}
+
+void Identity4TransformLoopRow_AVX2(TransformType /*tx_type*/,
+                                    TransformSize tx_size,
+                                    int adjusted_tx_height, void* src_buffer,
+                                    int /*start_x*/, int /*start_y*/,
+                                    void* /*dst_frame*/) {
+  IdentityTransformLoopRow<4>(tx_size, adjusted_tx_height, src_buffer);
+}
+
+void Identity4TransformLoopColumn_AVX2(TransformType tx_type,
+                                       TransformSize tx_size,
+                                       int /*adjusted_tx_height*/,
+                                       void* LIBGAV1_RESTRICT src_buffer,
+                                       int start_x, int start_y,
+                                       void* LIBGAV1_RESTRICT dst_frame) {
+  IdentityTransformLoopColumn<4>(tx_type, tx_size, src_buffer, start_x,
+                                 start_y, dst_frame);
+}
+
+void Identity8TransformLoopRow_AVX2(TransformType /*tx_type*/,
+                                    TransformSize tx_size,
+                                    int adjusted_tx_height, void* src_buffer,
+                                    int /*start_x*/, int /*start_y*/,
+                                    void* /*dst_frame*/) {
+  IdentityTransformLoopRow<8>(tx_size, adjusted_tx_height, src_buffer);
+}
+
+void Identity8TransformLoopColumn_AVX2(TransformType tx_type,
+                                       TransformSize tx_size,
+                                       int /*adjusted_tx_height*/,
+                                       void* LIBGAV1_RESTRICT src_buffer,
+                                       int start_x, int start_y,
+                                       void* LIBGAV1_RESTRICT dst_frame) {
+  IdentityTransformLoopColumn<8>(tx_type, tx_size, src_buffer, start_x,
+                                 start_y, dst_frame);
+}
+
+void Identity16TransformLoopRow_AVX2(TransformType /*tx_type*/,
+                                     TransformSize tx_size,
+                                     int adjusted_tx_height, void* src_buffer,
+                                     int /*start_x*/, int /*start_y*/,
+                                     void* /*dst_frame*/) {
+  IdentityTransformLoopRow<16>(tx_size, adjusted_tx_height, src_buffer);
+}
+
+void Identity16TransformLoopColumn_AVX2(TransformType tx_type,
+                                        TransformSize tx_size,
+                                        int /*adjusted_tx_height*/,
+                                        void* LIBGAV1_RESTRICT src_buffer,
+                                        int start_x, int start_y,
+                                        void* LIBGAV1_RESTRICT dst_frame) {
+  IdentityTransformLoopColumn<16>(tx_type, tx_size, src_buffer, start_x,
+                                  start_y, dst_frame);
+}
+
+void Identity32TransformLoopRow_AVX2(TransformType /*tx_type*/,
+                                     TransformSize tx_size,
+                                     int adjusted_tx_height, void* src_buffer,
+                                     int /*start_x*/, int /*start_y*/,
+                                     void* /*dst_frame*/) {
+  IdentityTransformLoopRow<32>(tx_size, adjusted_tx_height, src_buffer);
+}
+
+void Identity32TransformLoopColumn_AVX2(TransformType tx_type,
+                                        TransformSize tx_size,
+                                        int /*adjusted_tx_height*/,
+                                        void* LIBGAV1_RESTRICT src_buffer,
+                                        int start_x, int start_y,
+                                        void* LIBGAV1_RESTRICT dst_frame) {
+  IdentityTransformLoopColumn<32>(tx_type, tx_size, src_buffer, start_x,
+                                  start_y, dst_frame);
+}
+
+void Init10bpp() {
+  Dsp* const dsp = dsp_internal::GetWritableDspTable(kBitdepth10);
+  assert(dsp != nullptr);
+
+  // The Wht is only used by lossless frames and is left to the C
+  // implementation.
+#if DSP_ENABLED_10BPP_AVX2(Transform1dSize4_Transform1dDct)
+  dsp->inverse_transforms[kTransform1dDct][kTransform1dSize4][kRow] =
+      Dct4TransformLoopRow_AVX2;
+  dsp->inverse_transforms[kTransform1dDct][kTransform1dSize4][kColumn] =
+      Dct4TransformLoopColumn_AVX2;
+#endif
+#if DSP_ENABLED_10BPP_AVX2(Transform1dSize8_Transform1dDct)
+  dsp->inverse_transforms[kTransform1dDct][kTransform1dSize8][kRow] =
+      Dct8TransformLoopRow_AVX2;
+  dsp->inverse_transforms[kTransform1dDct][kTransform1dSize8][kColumn] =
+      Dct8TransformLoopColumn_AVX2;
+#endif
+#if DSP_ENABLED_10BPP_AVX2(Transform1dSize16_Transform1dDct)
+  dsp->inverse_transforms[kTransform1dDct][kTransform1dSize16][kRow] =
+      Dct16TransformLoopRow_AVX2;
+  dsp->inverse_transforms[kTransform1dDct][kTransform1dSize16][kColumn] =
+      Dct16TransformLoopColumn_AVX2;
+#endif
+#if DSP_ENABLED_10BPP_AVX2(Transform1dSize32_Transform1dDct)
+  dsp->inverse_transforms[kTransform1dDct][kTransform1dSize32][kRow] =
+      Dct32TransformLoopRow_AVX2;
+  dsp->inverse_transforms[kTransform1dDct][kTransform1dSize32][kColumn] =
+      Dct32TransformLoopColumn_AVX2;
+#endif
+#if DSP_ENABLED_10BPP_AVX2(Transform1dSize64_Transform1dDct)
+  dsp->inverse_transforms[kTransform1dDct][kTransform1dSize64][kRow] =
+      Dct64TransformLoopRow_AVX2;
+  dsp->inverse_transforms[kTransform1dDct][kTransform1dSize64][kColumn] =
+      Dct64TransformLoopColumn_AVX2;
+#endif
+#if DSP_ENABLED_10BPP_AVX2(Transform1dSize4_Transform1dAdst)
+  dsp->inverse_transforms[kTransform1dAdst][kTransform1dSize4][kRow] =
+      Adst4TransformLoopRow_AVX2;
+  dsp->inverse_transforms[kTransform1dAdst][kTransform1dSize4][kColumn] =
+      Adst4TransformLoopColumn_AVX2;
+#endif
+#if DSP_ENABLED_10BPP_AVX2(Transform1dSize8_Transform1dAdst)
+  dsp->inverse_transforms[kTransform1dAdst][kTransform1dSize8][kRow] =
+      Adst8TransformLoopRow_AVX2;
+  dsp->inverse_transforms[kTransform1dAdst][kTransform1dSize8][kColumn] =
+      Adst8TransformLoopColumn_AVX2;
+#endif
+#if DSP_ENABLED_10BPP_AVX2(Transform1dSize16_Transform1dAdst)
+  dsp->inverse_transforms[kTransform1dAdst][kTransform1dSize16][kRow] =
+      Adst16TransformLoopRow_AVX2;
+  dsp->inverse_transforms[kTransform1dAdst][kTransform1dSize16][kColumn] =
+      Adst16TransformLoopColumn_AVX2;
+#endif
+#if DSP_ENABLED_10BPP_AVX2(Transform1dSize4_Transform1dIdentity)
+  dsp->inverse_transforms[kTransform1dIdentity][kTransform1dSize4][kRow] =
+      Identity4TransformLoopRow_AVX2;
+  dsp->inverse_transforms[kTransform1dIdentity][kTransform1dSize4][kColumn] =
+      Identity4TransformLoopColumn_AVX2;
+#endif
+#if DSP_ENABLED_10BPP_AVX2(Transform1dSize8_Transform1dIdentity)
+  dsp->inverse_transforms[kTransform1dIdentity][kTransform1dSize8][kRow] =
+      Identity8TransformLoopRow_AVX2;
+  dsp->inverse_transforms[kTransform1dIdentity][kTransform1dSize8][kColumn] =
+      Identity8TransformLoopColumn_AVX2;
+#endif
+#if DSP_ENABLED_10BPP_AVX2(Transform1dSize16_Transform1dIdentity)
+  dsp->inverse_transforms[kTransform1dIdentity][kTransform1dSize16][kRow] =
+      Identity16TransformLoopRow_AVX2;
+  dsp->inverse_transforms[kTransform1dIdentity][kTransform1dSize16][kColumn] =
+      Identity16TransformLoopColumn_AVX2;
+#endif
+#if DSP_ENABLED_10BPP_AVX2(Transform1dSize32_Transform1dIdentity)
+  dsp->inverse_transforms[kTransform1dIdentity][kTransform1dSize32][kRow] =
+      Identity32TransformLoopRow_AVX2;
+  dsp->inverse_transforms[kTransform1dIdentity][kTransform1dSize32][kColumn] =
+      Identity32TransformLoopColumn_AVX2;
+#endif
+}
+
+}  // namespace
+}  // namespace high_bitdepth
+#endif  // LIBGAV1_MAX_BITDEPTH >= 10
+
+void InverseTransformInit_AVX2() {
+  low_bitdepth::Init8bpp();
+#if LIBGAV1_MAX_BITDEPTH >= 10
+  high_bitdepth::Init10bpp();
+#endif
+}
+
+}  // namespace dsp
+}  // namespace libgav1
+#else   // !LIBGAV1_TARGETING_AVX2
+namespace libgav1 {
+namespace dsp {
+
+void InverseTransformInit_AVX2() {}
+
+}  // namespace dsp
+}  // namespace libgav1
+#endif  // LIBGAV1_TARGETING_AVX2
@@ -0,0 +1,270 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the AVX2 inverse transforms, and the 8-bit AVX-512 ones installed
+// on top of them, with the C ones: the row and column transforms of every
+// transform size and type, on random coefficients, for each number of rows
+// that Reconstruct() may ask for.
+
+#include "src/dsp/x86/inverse_transform_avx2.h"
+
+#include "gtest/gtest.h"
+
+#if LIBGAV1_TARGETING_AVX2
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "src/dsp/dsp.h"
+#include "src/dsp/inverse_transform.h"
+#include "src/dsp/x86/inverse_transform_avx512.h"
+#include "src/utils/array_2d.h"
+#include "src/utils/constants.h"
+#include "src/utils/cpu.h"
+#include "src/utils/memory.h"
+
+namespace libgav1 {
+namespace dsp {
+namespace {
+
+// The same mappings as in reconstruction.cc.
+constexpr Transform1d kRowTransform[kNumTransformTypes] = {
+    kTransform1dDct,      kTransform1dAdst,     kTransform1dDct,
+    kTransform1dAdst,     kTransform1dAdst,     kTransform1dDct,
+    kTransform1dAdst,     kTransform1dAdst,     kTransform1dAdst,
+    kTransform1dIdentity, kTransform1dIdentity, kTransform1dDct,
+    kTransform1dIdentity, kTransform1dAdst,     kTransform1dIdentity,
+    kTransform1dAdst};
+constexpr Transform1d kColumnTransform[kNumTransformTypes] = {
+    kTransform1dDct,      kTransform1dDct,      kTransform1dAdst,
+    kTransform1dAdst,     kTransform1dDct,      kTransform1dAdst,
+    kTransform1dAdst,     kTransform1dAdst,     kTransform1dAdst,
+    kTransform1dIdentity, kTransform1dDct,      kTransform1dIdentity,
+    kTransform1dAdst,     kTransform1dIdentity, kTransform1dAdst,
+    kTransform1dIdentity};
+
+// Returns true if a bitstream may code |tx_type| for |tx_size| (section 5.11.48
+// of the spec): 64 point transforms are only DCT, 32 point ones DCT or
+// identity, and 16 point ones do not pair the ADST with the identity.
+bool IsTransformTypeAllowed(TransformSize tx_size, TransformType tx_type) {
+  const int max_size =
+      std::max(kTransformWidth[tx_size], kTransformHeight[tx_size]);
+  if (max_size == 64) return tx_type == kTransformTypeDctDct;
+  if (max_size == 32) {
+    return tx_type == kTransformTypeDctDct ||
+           tx_type == kTransformTypeIdentityIdentity;
+  }
+  if (max_size == 16) {
+    return tx_type != kTransformTypeIdentityAdst &&
+           tx_type != kTransformTypeAdstIdentity &&
+           tx_type != kTransformTypeIdentityFlipadst &&
+           tx_type != kTransformTypeFlipadstIdentity;
+  }
+  return true;
+}
+
+// |feature| is kAVX2 or kAVX512. The AVX-512 functions replace some of the
+// AVX2 ones and fall back to them for the smaller blocks, so both tables are
+// compared with the C one.
+template <int bitdepth, typename Residual, typename Pixel, CpuFeatures feature>
+class InverseTransformSimdTest : public testing::Test {
+ protected:
+  // Room for the largest transform, with a margin on the right and below so
+  // that writes outside of the block are caught.
+  static constexpr int kFrameSize = 80;
+
+  void SetUp() override {
+    if ((GetCpuInfo() & feature) == 0) {
+      GTEST_SKIP() << ((feature == kAVX512) ? "AVX-512" : "AVX2")
+                   << " is not supported by this CPU.";
+    }
+    DspInit();
+    // inverse_transform.cc is built without AVX2, so InverseTransformInit_C()
+    // installs every C function. InverseTransformInit_AVX2() then replaces
+    // the ones it has, and InverseTransformInit_AVX512() some of those.
+    InverseTransformInit_C();
+    memcpy(c_, GetDspTable(bitdepth)->inverse_transforms, sizeof(c_));
+    InverseTransformInit_AVX2();
+    memcpy(avx2_, GetDspTable(bitdepth)->inverse_transforms, sizeof(avx2_));
+    if (feature == kAVX512) InverseTransformInit_AVX512();
+    memcpy(simd_, GetDspTable(bitdepth)->inverse_transforms, sizeof(simd_));
+  }
+
+  // Fills the first |rows| rows of |residual| with random coefficients. Only
+  // the first coefficient is set if |rows| is 1. The coefficients of 64 point
+  // transforms beyond the first 32 are always zero.
+  void RandomCoefficients(TransformSize tx_size, int rows, Residual* residual) {
+    const int tx_width = kTransformWidth[tx_size];
+    const int tx_height = kTransformHeight[tx_size];
+    std::fill(residual, residual + tx_width * tx_height, 0);
+    // The 10-bit transforms take the whole row transform input range of the
+    // spec, int(bitdepth + 8). The 8-bit SIMD transforms, SSE4.1 included,
+    // keep 16-bit intermediates that random coefficients beyond int(14) can
+    // overflow, which conformant streams do not do.
+    const int magnitude_bits = (bitdepth == 8) ? 13 : bitdepth + 7;
+    const int max_value = (1 << magnitude_bits) - 1;
+    // Most coefficients are small, as in real streams, but every magnitude is
+    // tried.
+    std::uniform_int_distribution<int> shift(0, magnitude_bits);
+    std::uniform_int_distribution<int> value(-max_value - 1, max_value);
+    const int columns = (rows == 1) ? 1 : std::min(tx_width, 32);
+    for (int y = 0; y < rows; ++y) {
+      for (int x = 0; x < columns; ++x) {
+        residual[y * tx_width + x] =
+            static_cast<Residual>(value(rng_) >> shift(rng_));
+      }
+    }
+  }
+
+  void RandomFrame(Array2D<Pixel>* frame) {
+    std::uniform_int_distribution<int> pixel(0, (1 << bitdepth) - 1);
+    for (int y = 0; y < kFrameSize; ++y) {
+      for (int x = 0; x < kFrameSize; ++x) (*frame)[y][x] = pixel(rng_);
+    }
+  }
+
+  // Runs the row and then the column transform of |funcs| over |residual|
+  // and adds the result to |frame|, as Reconstruct() does.
+  static void Transform(const InverseTransformAddFuncs& funcs,
+                        TransformType tx_type, TransformSize tx_size,
+                        bool lossless, int rows, Residual* residual,
+                        Array2D<Pixel>* frame) {
+    const auto row_size =
+        static_cast<Transform1dSize>(kTransformWidthLog2[tx_size] - 2);
+    const auto column_size =
+        static_cast<Transform1dSize>(kTransformHeightLog2[tx_size] - 2);
+    const Transform1d row = lossless ? kTransform1dWht : kRowTransform[tx_type];
+    const Transform1d column =
+        lossless ? kTransform1dWht : kColumnTransform[tx_type];
+    Array2DView<Pixel> frame_view(kFrameSize, kFrameSize, (*frame)[0]);
+    ASSERT_NE(funcs[row][row_size][kRow], nullptr);
+    ASSERT_NE(funcs[column][column_size][kColumn], nullptr);
+    funcs[row][row_size][kRow](tx_type, tx_size, rows, residual, 0, 0,
+                               &frame_view);
+    funcs[column][column_size][kColumn](tx_type, tx_size, rows, residual, 0,
+                                        0, &frame_view);
+  }
+
+  void TestTransform(TransformType tx_type, TransformSize tx_size,
+                     bool lossless);
+  void TestAllTransforms();
+
+  InverseTransformAddFuncs c_;
+  InverseTransformAddFuncs avx2_;
+  InverseTransformAddFuncs simd_;
+  std::mt19937 rng_{bitdepth};
+};
+
+template <int bitdepth, typename Residual, typename Pixel, CpuFeatures feature>
+void InverseTransformSimdTest<bitdepth, Residual, Pixel,
+                              feature>::TestTransform(
+    TransformType tx_type, TransformSize tx_size, bool lossless) {
+  const int tx_height = kTransformHeight[tx_size];
+  // The numbers of rows that Reconstruct() passes: 1 for a lone DC
+  // coefficient, otherwise 4 or a multiple of 8 up to 32 or the height.
+  std::vector<int> row_counts = {1};
+  for (int rows = 4; rows <= std::min(tx_height, 32); rows += 4) {
+    if (rows == 4 || rows % 8 == 0) row_counts.push_back(rows);
+  }
+  AlignedUniquePtr<Residual> c_residual =
+      MakeAlignedUniquePtr<Residual>(kMaxAlignment, 64 * 64);
+  AlignedUniquePtr<Residual> simd_residual =
+      MakeAlignedUniquePtr<Residual>(kMaxAlignment, 64 * 64);
+  ASSERT_NE(c_residual, nullptr);
+  ASSERT_NE(simd_residual, nullptr);
+  Array2D<Pixel> c_frame;
+  Array2D<Pixel> simd_frame;
+  ASSERT_TRUE(c_frame.Reset(kFrameSize, kFrameSize));
+  ASSERT_TRUE(simd_frame.Reset(kFrameSize, kFrameSize));
+  for (const int rows : row_counts) {
+    for (int iteration = 0; iteration < 4; ++iteration) {
+      RandomCoefficients(tx_size, rows, c_residual.get());
+      std::copy(c_residual.get(), c_residual.get() + 64 * 64,
+                simd_residual.get());
+      RandomFrame(&c_frame);
+      std::copy(c_frame[0], c_frame[0] + kFrameSize * kFrameSize,
+                simd_frame[0]);
+      Transform(c_, tx_type, tx_size, lossless, rows, c_residual.get(),
+                &c_frame);
+      Transform(simd_, tx_type, tx_size, lossless, rows, simd_residual.get(),
+                &simd_frame);
+      ASSERT_TRUE(std::equal(c_frame[0], c_frame[0] + kFrameSize * kFrameSize,
+                             simd_frame[0]))
+          << ToString(tx_size) << " " << ToString(tx_type)
+          << (lossless ? " lossless" : "") << ", rows " << rows
+          << ", iteration " << iteration;
+    }
+  }
+}
+
+template <int bitdepth, typename Residual, typename Pixel, CpuFeatures feature>
+void InverseTransformSimdTest<bitdepth, Residual, Pixel,
+                              feature>::TestAllTransforms() {
+  const InverseTransformAddFuncs& previous = (feature == kAVX512) ? avx2_ : c_;
+  int num_simd = 0;
+  for (int size = 0; size < kNumTransformSizes; ++size) {
+    const auto tx_size = static_cast<TransformSize>(size);
+    for (int type = 0; type < kNumTransformTypes; ++type) {
+      const auto tx_type = static_cast<TransformType>(type);
+      if (!IsTransformTypeAllowed(tx_size, tx_type)) continue;
+      TestTransform(tx_type, tx_size, /*lossless=*/false);
+      if (HasFatalFailure()) return;
+    }
+  }
+  TestTransform(kTransformTypeDctDct, kTransformSize4x4, /*lossless=*/true);
+  for (int transform = 0; transform < kNumTransform1ds; ++transform) {
+    for (int size = 0; size < kNumTransform1dSizes; ++size) {
+      for (int direction = kRow; direction <= kColumn; ++direction) {
+        num_simd += static_cast<int>(previous[transform][size][direction] !=
+                                     simd_[transform][size][direction]);
+      }
+    }
+  }
+  // Make sure that the functions of the tier were installed and compared.
+  EXPECT_GT(num_simd, 0);
+}
+
+using InverseTransformAvx2Test8bpp =
+    InverseTransformSimdTest<kBitdepth8, int16_t, uint8_t, kAVX2>;
+
+TEST_F(InverseTransformAvx2Test8bpp, AllTransforms) { TestAllTransforms(); }
+
+using InverseTransformAvx512Test8bpp =
+    InverseTransformSimdTest<kBitdepth8, int16_t, uint8_t, kAVX512>;
+
+TEST_F(InverseTransformAvx512Test8bpp, AllTransforms) { TestAllTransforms(); }
+
+#if LIBGAV1_MAX_BITDEPTH >= 10
+using InverseTransformAvx2Test10bpp =
+    InverseTransformSimdTest<kBitdepth10, int32_t, uint16_t, kAVX2>;
+
+TEST_F(InverseTransformAvx2Test10bpp, AllTransforms) { TestAllTransforms(); }
+#endif  // LIBGAV1_MAX_BITDEPTH >= 10
+
+}  // namespace
+}  // namespace dsp
+}  // namespace libgav1
+
+#else  // !LIBGAV1_TARGETING_AVX2
+
+TEST(InverseTransformAvx2Test, AVX2) {
+  GTEST_SKIP() << "Build this module for x86(-64) with AVX2 enabled to enable "
+                  "the tests.";
+}
+
+#endif  // LIBGAV1_TARGETING_AVX2
@@ -0,0 +1,450 @@
+// Copyright 2021 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/dsp/inverse_transform.h"
+#include "src/utils/cpu.h"
+
+#if LIBGAV1_TARGETING_AVX512
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+#include "src/dsp/constants.h"
+#include "src/dsp/dsp.h"
+#include "src/dsp/x86/common_avx512.h"
+#include "src/utils/array_2d.h"
+#include "src/utils/common.h"
+#include "src/utils/compiler_attributes.h"
+#include "src/utils/constants.h"
+
+namespace libgav1 {
+namespace dsp {
+namespace low_bitdepth {
+namespace {
+
+// Include the constants and utility functions inside the anonymous namespace.
+#include "src/dsp/inverse_transform.inc"
+
+// The 32 and 64 point DCT functions registered by InverseTransformInit_AVX2(),
+// used for row passes of at most 16 rows and for blocks narrower than 32.
+InverseTransformAddFunc dct32_row_avx2;
+InverseTransformAddFunc dct32_column_avx2;
+InverseTransformAddFunc dct64_row_avx2;
+InverseTransformAddFunc dct64_column_avx2;
+
+// Each register holds 32 int16_t values. Row transforms process up to 32 rows
+// per pass, rows 8k to 8k + 7 in 128-bit lane k. Column transforms process 32
+// columns per pass.
+
+LIBGAV1_ALWAYS_INLINE void ButterflyRotation(__m512i* a, __m512i* b,
+                                             const int angle,
+                                             const bool flip) {
+  const int16_t cos128 = Cos128(angle);
+  const int16_t sin128 = Sin128(angle);
+  const __m512i psin_pcos = _mm512_set1_epi32(
+      static_cast<uint16_t>(cos128) |
+      (static_cast<uint32_t>(static_cast<uint16_t>(sin128)) << 16));
+  // There is no 512-bit _mm_sign_epi16(), so negate sin before broadcasting.
+  const __m512i msin_pcos = _mm512_set1_epi32(
+      static_cast<uint16_t>(cos128) |
+      (static_cast<uint32_t>(static_cast<uint16_t>(-sin128)) << 16));
+  const __m512i ba = _mm512_unpacklo_epi16(*a, *b);
+  const __m512i ab = _mm512_unpacklo_epi16(*b, *a);
+  const __m512i ba_hi = _mm512_unpackhi_epi16(*a, *b);
+  const __m512i ab_hi = _mm512_unpackhi_epi16(*b, *a);
+  const __m512i x0 = _mm512_madd_epi16(ba, msin_pcos);
+  const __m512i y0 = _mm512_madd_epi16(ab, psin_pcos);
+  const __m512i x0_hi = _mm512_madd_epi16(ba_hi, msin_pcos);
+  const __m512i y0_hi = _mm512_madd_epi16(ab_hi, psin_pcos);
+  const __m512i x1 = RightShiftWithRounding_S32(x0, 12);
+  const __m512i y1 = RightShiftWithRounding_S32(y0, 12);
+  const __m512i x1_hi = RightShiftWithRounding_S32(x0_hi, 12);
+  const __m512i y1_hi = RightShiftWithRounding_S32(y0_hi, 12);
+  const __m512i x = _mm512_packs_epi32(x1, x1_hi);
+  const __m512i y = _mm512_packs_epi32(y1, y1_hi);
+  if (flip) {
+    *a = y;
+    *b = x;
+  } else {
+    *a = x;
+    *b = y;
+  }
+}
+
+LIBGAV1_ALWAYS_INLINE void ButterflyRotation_FirstIsZero(__m512i* a, __m512i* b,
+                                                         const int angle,
+                                                         const bool flip) {
+  const int16_t cos128 = Cos128(angle);
+  const int16_t sin128 = Sin128(angle);
+  const __m512i pcos = _mm512_set1_epi16(cos128 << 3);
+  const __m512i psin = _mm512_set1_epi16(-(sin128 << 3));
+  const __m512i x = _mm512_mulhrs_epi16(*b, psin);
+  const __m512i y = _mm512_mulhrs_epi16(*b, pcos);
+  if (flip) {
+    *a = y;
+    *b = x;
+  } else {
+    *a = x;
+    *b = y;
+  }
+}
+
+LIBGAV1_ALWAYS_INLINE void ButterflyRotation_SecondIsZero(__m512i* a,
+                                                          __m512i* b,
+                                                          const int angle,
+                                                          const bool flip) {
+  const int16_t cos128 = Cos128(angle);
+  const int16_t sin128 = Sin128(angle);
+  const __m512i pcos = _mm512_set1_epi16(cos128 << 3);
+  const __m512i psin = _mm512_set1_epi16(sin128 << 3);
+  const __m512i x = _mm512_mulhrs_epi16(*a, pcos);
+  const __m512i y = _mm512_mulhrs_epi16(*a, psin);
+  if (flip) {
+    *a = y;
+    *b = x;
+  } else {
+    *a = x;
+    *b = y;
+  }
+}
+
+// The saturating adds and subtracts clamp to the 16-bit intermediate range, so
+// |min| and |max| are not used.
+LIBGAV1_ALWAYS_INLINE void HadamardRotation(__m512i* a, __m512i* b, bool flip,
+                                            const __m512i /*min*/,
+                                            const __m512i /*max*/) {
+  __m512i x, y;
+  if (flip) {
+    y = _mm512_adds_epi16(*b, *a);
+    x = _mm512_subs_epi16(*b, *a);
+  } else {
+    x = _mm512_adds_epi16(*a, *b);
+    y = _mm512_subs_epi16(*a, *b);
+  }
+  *a = x;
+  *b = y;
+}
+
+LIBGAV1_ALWAYS_INLINE __m512i Negate(const __m512i x) {
+  return _mm512_subs_epi16(_mm512_setzero_si512(), x);
+}
+
+using TransformVector = __m512i;
+using Transform1dFunc = void (*)(__m512i* x, __m512i min, __m512i max);
+using DcOnlyColumnFunc = void (*)(__m512i* x);
+
+#include "src/dsp/x86/inverse_transform_avx2.inc"
+
+LIBGAV1_ALWAYS_INLINE __m512i ShiftResidual(const __m512i residual,
+                                            const __m512i v_row_shift_add,
+                                            const __m128i v_row_shift) {
+  // The max row_shift is 2, so int16_t values greater than 0x7ffd may
+  // overflow.  Generate a mask for this case.
+  const __mmask32 mask =
+      _mm512_cmpgt_epi16_mask(residual, _mm512_set1_epi16(0x7ffd));
+  const __m512i x = _mm512_add_epi16(residual, v_row_shift_add);
+  // Assume int16_t values.
+  const __m512i a = _mm512_sra_epi16(x, v_row_shift);
+  // Assume uint16_t values.
+  const __m512i b = _mm512_srl_epi16(x, v_row_shift);
+  // Select the correct shifted value.
+  return _mm512_mask_blend_epi16(mask, a, b);
+}
+
+// Transposes the 8x8 blocks held in each 128-bit lane of |in| independently.
+LIBGAV1_ALWAYS_INLINE void Transpose8x8_U16(const __m512i* const in,
+                                            __m512i* const out) {
+  const __m512i a0 = _mm512_unpacklo_epi16(in[0], in[1]);
+  const __m512i a1 = _mm512_unpacklo_epi16(in[2], in[3]);
+  const __m512i a2 = _mm512_unpacklo_epi16(in[4], in[5]);
+  const __m512i a3 = _mm512_unpacklo_epi16(in[6], in[7]);
+  const __m512i a4 = _mm512_unpackhi_epi16(in[0], in[1]);
+  const __m512i a5 = _mm512_unpackhi_epi16(in[2], in[3]);
+  const __m512i a6 = _mm512_unpackhi_epi16(in[4], in[5]);
+  const __m512i a7 = _mm512_unpackhi_epi16(in[6], in[7]);
+
+  const __m512i b0 = _mm512_unpacklo_epi32(a0, a1);
+  const __m512i b1 = _mm512_unpacklo_epi32(a2, a3);
+  const __m512i b2 = _mm512_unpacklo_epi32(a4, a5);
+  const __m512i b3 = _mm512_unpacklo_epi32(a6, a7);
+  const __m512i b4 = _mm512_unpackhi_epi32(a0, a1);
+  const __m512i b5 = _mm512_unpackhi_epi32(a2, a3);
+  const __m512i b6 = _mm512_unpackhi_epi32(a4, a5);
+  const __m512i b7 = _mm512_unpackhi_epi32(a6, a7);
+
+  out[0] = _mm512_unpacklo_epi64(b0, b1);
+  out[1] = _mm512_unpackhi_epi64(b0, b1);
+  out[2] = _mm512_unpacklo_epi64(b4, b5);
+  out[3] = _mm512_unpackhi_epi64(b4, b5);
+  out[4] = _mm512_unpacklo_epi64(b2, b3);
+  out[5] = _mm512_unpackhi_epi64(b2, b3);
+  out[6] = _mm512_unpacklo_epi64(b6, b7);
+  out[7] = _mm512_unpackhi_epi64(b6, b7);
+}
+
+// Loads row |row| of |src| at column |j|, or zero if it is past |num_rows|.
+LIBGAV1_ALWAYS_INLINE __m128i LoadRow(const int16_t* LIBGAV1_RESTRICT src,
+                                      const int tx_width, const int num_rows,
+                                      const int row, const int j) {
+  return (row < num_rows) ? LoadUnaligned16(&src[row * tx_width + j])
+                          : _mm_setzero_si128();
+}
+
+// Loads |num_rows| (at most 32) rows of |tx_width| coefficients from |src| so
+// that x[i] holds coefficient i of every row. Rows past |num_rows| are zero.
+template <int tx_width>
+LIBGAV1_ALWAYS_INLINE void LoadRows(const int16_t* LIBGAV1_RESTRICT src,
+                                    const int num_rows, __m512i* x) {
+  // The last 32 values of every row are always zero if the |tx_width| is 64.
+  constexpr int kNonZeroWidth = (tx_width < 64) ? tx_width : 32;
+  for (int j = 0; j < kNonZeroWidth; j += 8) {
+    __m512i in[8];
+    for (int i = 0; i < 8; ++i) {
+      in[i] = SetrM128i(LoadRow(src, tx_width, num_rows, i, j),
+                        LoadRow(src, tx_width, num_rows, i + 8, j),
+                        LoadRow(src, tx_width, num_rows, i + 16, j),
+                        LoadRow(src, tx_width, num_rows, i + 24, j));
+    }
+    Transpose8x8_U16(in, &x[j]);
+  }
+}
+
+// The inverse of LoadRows(). Only the first |num_rows| rows are written.
+template <int tx_width>
+LIBGAV1_ALWAYS_INLINE void StoreRows(int16_t* LIBGAV1_RESTRICT dst,
+                                     const int num_rows, const __m512i* x) {
+  for (int j = 0; j < tx_width; j += 8) {
+    __m512i out[8];
+    Transpose8x8_U16(&x[j], out);
+    for (int i = 0; i < 8 && i < num_rows; ++i) {
+      StoreUnaligned16(&dst[i * tx_width + j], _mm512_castsi512_si128(out[i]));
+    }
+    for (int i = 8; i < 16 && i < num_rows; ++i) {
+      StoreUnaligned16(&dst[i * tx_width + j],
+                       _mm512_extracti32x4_epi32(out[i - 8], 1));
+    }
+    for (int i = 16; i < 24 && i < num_rows; ++i) {
+      StoreUnaligned16(&dst[i * tx_width + j],
+                       _mm512_extracti32x4_epi32(out[i - 16], 2));
+    }
+    for (int i = 24; i < num_rows; ++i) {
+      StoreUnaligned16(&dst[i * tx_width + j],
+                       _mm512_extracti32x4_epi32(out[i - 24], 3));
+    }
+  }
+}
+
+// Applies |transform1d| to the first |adjusted_tx_height| rows of |src|,
+// folding in the rounding of rectangular transforms and the row shift.
+template <int tx_width, Transform1dFunc transform1d>
+LIBGAV1_ALWAYS_INLINE void TransformRows(int16_t* src, int adjusted_tx_height,
+                                         bool should_round, int row_shift) {
+  constexpr int kNonZeroWidth = (tx_width < 64) ? tx_width : 32;
+  const __m512i min = _mm512_set1_epi16(INT16_MIN);
+  const __m512i max = _mm512_set1_epi16(INT16_MAX);
+  const __m512i v_kTransformRowMultiplier =
+      _mm512_set1_epi16(kTransformRowMultiplier << 3);
+  const __m512i v_row_shift_add = _mm512_set1_epi16(row_shift);
+  const __m128i v_row_shift = _mm_cvtsi32_si128(row_shift);
+  int i = 0;
+  do {
+    const int num_rows = std::min(adjusted_tx_height - i, 32);
+    int16_t* const rows = &src[i * tx_width];
+    __m512i x[tx_width];
+    LoadRows<tx_width>(rows, num_rows, x);
+    if (should_round) {
+      for (int j = 0; j < kNonZeroWidth; ++j) {
+        x[j] = _mm512_mulhrs_epi16(x[j], v_kTransformRowMultiplier);
+      }
+    }
+    transform1d(x, min, max);
+    if (row_shift > 0) {
+      for (int j = 0; j < tx_width; ++j) {
+        x[j] = ShiftResidual(x[j], v_row_shift_add, v_row_shift);
+      }
+    }
+    StoreRows<tx_width>(rows, num_rows, x);
+    i += 32;
+  } while (i < adjusted_tx_height);
+}
+
+LIBGAV1_ALWAYS_INLINE void StoreToFrameWithRound(uint8_t* LIBGAV1_RESTRICT dst,
+                                                 const __m512i residual) {
+  const __m512i v_eight = _mm512_set1_epi16(8);
+  // Saturate to prevent overflowing int16_t
+  const __m512i a = _mm512_adds_epi16(residual, v_eight);
+  const __m512i b = _mm512_srai_epi16(a, 4);
+  const __m512i c = _mm512_cvtepu8_epi16(LoadUnaligned32(dst));
+  const __m512i d = _mm512_adds_epi16(c, b);
+  // The unsigned saturating narrow needs the negative sums clamped first.
+  StoreUnaligned32(dst, _mm512_cvtusepi16_epi8(
+                            _mm512_max_epi16(d, _mm512_setzero_si512())));
+}
+
+// Applies |transform1d| (or |dc_only| when only the first row is non-zero) to
+// each group of 32 columns of |src| and adds the result to the frame.
+// |tx_width| must be 32 or 64.
+template <int tx_height, Transform1dFunc transform1d, DcOnlyColumnFunc dc_only>
+LIBGAV1_ALWAYS_INLINE void TransformColumns(const int16_t* src, int tx_width,
+                                            int adjusted_tx_height,
+                                            int start_x, int start_y,
+                                            void* dst_frame) {
+  // The last 32 rows are always zero if the |tx_height| is 64.
+  constexpr int kNonZeroHeight = (tx_height < 64) ? tx_height : 32;
+  auto& frame = *static_cast<Array2DView<uint8_t>*>(dst_frame);
+  const int stride = frame.columns();
+  const __m512i min = _mm512_set1_epi16(INT16_MIN);
+  const __m512i max = _mm512_set1_epi16(INT16_MAX);
+  int j = 0;
+  do {
+    __m512i x[tx_height];
+    if (adjusted_tx_height == 1) {
+      x[0] = LoadUnaligned64(&src[j]);
+      dc_only(x);
+    } else {
+      for (int i = 0; i < kNonZeroHeight; ++i) {
+        x[i] = LoadUnaligned64(&src[i * tx_width + j]);
+      }
+      transform1d(x, min, max);
+    }
+    uint8_t* dst = frame[start_y] + start_x + j;
+    for (int i = 0; i < tx_height; ++i) {
+      StoreToFrameWithRound(dst, x[i]);
+      dst += stride;
+    }
+    j += 32;
+  } while (j < tx_width);
+}
+
+template <int height>
+LIBGAV1_ALWAYS_INLINE void DctDcOnlyColumn(__m512i* x) {
+  const int16_t cos128 = Cos128(32);
+  const __m512i xy = _mm512_mulhrs_epi16(x[0], _mm512_set1_epi16(cos128 << 3));
+  for (int i = 0; i < height; ++i) {
+    x[i] = xy;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Transform loops.
+
+// Row passes of more than 16 rows fill the 4 lanes, smaller ones (including the
+// dc only case) are left to the AVX2 version. Neither transform size has flip
+// variants.
+
+void Dct32TransformLoopRow_AVX512(TransformType tx_type, TransformSize tx_size,
+                                  int adjusted_tx_height, void* src_buffer,
+                                  int start_x, int start_y, void* dst_frame) {
+  if (adjusted_tx_height <= 16) {
+    dct32_row_avx2(tx_type, tx_size, adjusted_tx_height, src_buffer, start_x,
+                   start_y, dst_frame);
+    return;
+  }
+  TransformRows<32, Dct32>(static_cast<int16_t*>(src_buffer),
+                           adjusted_tx_height, kShouldRound[tx_size],
+                           kTransformRowShift[tx_size]);
+}
+
+void Dct32TransformLoopColumn_AVX512(TransformType tx_type,
+                                     TransformSize tx_size,
+                                     int adjusted_tx_height,
+                                     void* LIBGAV1_RESTRICT src_buffer,
+                                     int start_x, int start_y,
+                                     void* LIBGAV1_RESTRICT dst_frame) {
+  const int tx_width = kTransformWidth[tx_size];
+  if (tx_width < 32) {
+    dct32_column_avx2(tx_type, tx_size, adjusted_tx_height, src_buffer,
+                      start_x, start_y, dst_frame);
+    return;
+  }
+  TransformColumns<32, Dct32, DctDcOnlyColumn<32>>(
+      static_cast<int16_t*>(src_buffer), tx_width, adjusted_tx_height,
+      start_x, start_y, dst_frame);
+}
+
+void Dct64TransformLoopRow_AVX512(TransformType tx_type, TransformSize tx_size,
+                                  int adjusted_tx_height, void* src_buffer,
+                                  int start_x, int start_y, void* dst_frame) {
+  if (adjusted_tx_height <= 16) {
+    dct64_row_avx2(tx_type, tx_size, adjusted_tx_height, src_buffer, start_x,
+                   start_y, dst_frame);
+    return;
+  }
+  TransformRows<64, Dct64>(static_cast<int16_t*>(src_buffer),
+                           adjusted_tx_height, kShouldRound[tx_size],
+                           kTransformRowShift[tx_size]);
+}
+
+void Dct64TransformLoopColumn_AVX512(TransformType tx_type,
+                                     TransformSize tx_size,
+                                     int adjusted_tx_height,
+                                     void* LIBGAV1_RESTRICT src_buffer,
+                                     int start_x, int start_y,
+                                     void* LIBGAV1_RESTRICT dst_frame) {
+  const int tx_width = kTransformWidth[tx_size];
+  if (tx_width < 32) {
+    dct64_column_avx2(tx_type, tx_size, adjusted_tx_height, src_buffer,
+                      start_x, start_y, dst_frame);
+    return;
+  }
+  TransformColumns<64, Dct64, DctDcOnlyColumn<64>>(
+      static_cast<int16_t*>(src_buffer), tx_width, adjusted_tx_height,
+      start_x, start_y, dst_frame);
+}
+
+void Init8bpp() {
+  Dsp* const dsp = dsp_internal::GetWritableDspTable(kBitdepth8);
+  assert(dsp != nullptr);
+  static_cast<void>(dsp);
+#if DSP_ENABLED_8BPP_AVX512(Transform1dSize32_Transform1dDct)
+  dct32_row_avx2 =
+      dsp->inverse_transforms[kTransform1dDct][kTransform1dSize32][kRow];
+  dct32_column_avx2 =
+      dsp->inverse_transforms[kTransform1dDct][kTransform1dSize32][kColumn];
+  dsp->inverse_transforms[kTransform1dDct][kTransform1dSize32][kRow] =
+      Dct32TransformLoopRow_AVX512;
+  dsp->inverse_transforms[kTransform1dDct][kTransform1dSize32][kColumn] =
+      Dct32TransformLoopColumn_AVX512;
+#endif
+#if DSP_ENABLED_8BPP_AVX512(Transform1dSize64_Transform1dDct)
+  dct64_row_avx2 =
+      dsp->inverse_transforms[kTransform1dDct][kTransform1dSize64][kRow];
+  dct64_column_avx2 =
+      dsp->inverse_transforms[kTransform1dDct][kTransform1dSize64][kColumn];
+  dsp->inverse_transforms[kTransform1dDct][kTransform1dSize64][kRow] =
+      Dct64TransformLoopRow_AVX512;
+  dsp->inverse_transforms[kTransform1dDct][kTransform1dSize64][kColumn] =
+      Dct64TransformLoopColumn_AVX512;
+#endif
+}
+
+}  // namespace
+}  // namespace low_bitdepth
+
+void InverseTransformInit_AVX512() { low_bitdepth::Init8bpp(); }
+
+}  // namespace dsp
+}  // namespace libgav1
+
+#else   // !LIBGAV1_TARGETING_AVX512
+namespace libgav1 {
+namespace dsp {
+
+void InverseTransformInit_AVX512() {}
+
+}  // namespace dsp
+}  // namespace libgav1
+#endif  // LIBGAV1_TARGETING_AVX512
@@ -0,0 +1,548 @@
+// Copyright 2021 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/dsp/loop_filter.h"
+#include "src/utils/cpu.h"
+
+#if LIBGAV1_TARGETING_AVX2
+#include <immintrin.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "src/dsp/constants.h"
+#include "src/dsp/dsp.h"
+#include "src/dsp/x86/common_avx2.h"
+#include "src/dsp/x86/transpose_sse4.h"
+
+namespace libgav1 {
+namespace dsp {
+namespace {
+
+// These functions filter two adjacent 4-pixel edge segments, 8 pixels along
+// the edge, in one pass. Both bitdepths use 16-bit arithmetic. The pixels at
+// distance i from the edge are held in one vector |qp[i]|, with the 8 p-side
+// pixels in the low 128-bit lane and the 8 q-side pixels in the high lane. This
+// is the layout of the 10bpp SSE4.1 functions widened from 4 to 8 pixels: the
+// filters are symmetric, so both sides are computed together and the masks,
+// which combine the two sides, end up the same in both lanes.
+
+inline __m256i SwapLanes(const __m256i& a) {
+  return _mm256_permute4x64_epi64(a, 0x4e);
+}
+
+inline __m128i LowLane(const __m256i& a) { return _mm256_castsi256_si128(a); }
+
+inline __m128i HighLane(const __m256i& a) {
+  return _mm256_extracti128_si256(a, 1);
+}
+
+inline __m256i AbsDiff(const __m256i& a, const __m256i& b) {
+  return _mm256_or_si256(_mm256_subs_epu16(a, b), _mm256_subs_epu16(b, a));
+}
+
+// Returns the maximum of the p and q values of |a| in both lanes.
+inline __m256i MaxPQ(const __m256i& a) {
+  return _mm256_max_epu16(a, SwapLanes(a));
+}
+
+inline __m256i Clamp(const __m256i& min, const __m256i& max,
+                     const __m256i& val) {
+  return _mm256_max_epi16(_mm256_min_epi16(val, max), min);
+}
+
+inline __m256i AddShift3(const __m256i& a, const __m256i& b,
+                         const __m256i& vmin, const __m256i& vmax) {
+  return _mm256_srai_epi16(Clamp(vmin, vmax, _mm256_adds_epi16(a, b)), 3);
+}
+
+inline __m256i AddShift1(const __m256i& a, const __m256i& b) {
+  return _mm256_srai_epi16(_mm256_adds_epi16(a, b), 1);
+}
+
+inline __m256i FilterAdd2Sub2(const __m256i& total, const __m256i& a1,
+                              const __m256i& a2, const __m256i& s1,
+                              const __m256i& s2) {
+  __m256i x = _mm256_add_epi16(a1, total);
+  x = _mm256_add_epi16(_mm256_sub_epi16(x, _mm256_add_epi16(s1, s2)), a2);
+  return x;
+}
+
+inline __m256i Hev(const __m256i& qp1, const __m256i& qp0,
+                   const __m256i& hev_thresh) {
+  return _mm256_cmpgt_epi16(MaxPQ(AbsDiff(qp1, qp0)), hev_thresh);
+}
+
+// Returns a nonzero value where
+//   abs(p0 - q0) * 2 + abs(p1 - q1) / 2 > outer_thresh.
+inline __m256i CheckOuterThresh(const __m256i& qp1, const __m256i& qp0,
+                                const __m256i& outer_thresh) {
+  const __m256i abs_p0mq0 = AbsDiff(qp0, SwapLanes(qp0));
+  const __m256i abs_p1mq1 = AbsDiff(qp1, SwapLanes(qp1));
+  const __m256i sum = _mm256_adds_epu16(
+      _mm256_adds_epu16(abs_p0mq0, abs_p0mq0), _mm256_srli_epi16(abs_p1mq1, 1));
+  return _mm256_subs_epu16(sum, outer_thresh);
+}
+
+// |max_diff| is the largest difference between adjacent pixels on either side
+// of the edge.
+inline __m256i NeedsFilter(const __m256i& qp1, const __m256i& qp0,
+                           const __m256i& max_diff,
+                           const __m256i& outer_thresh,
+                           const __m256i& inner_thresh) {
+  const __m256i outer_mask = CheckOuterThresh(qp1, qp0, outer_thresh);
+  const __m256i inner_mask =
+      _mm256_subs_epu16(MaxPQ(max_diff), inner_thresh);
+  // ~mask
+  return _mm256_cmpeq_epi16(_mm256_or_si256(outer_mask, inner_mask),
+                            _mm256_setzero_si256());
+}
+
+inline __m256i NeedsFilter4(const __m256i& qp1, const __m256i& qp0,
+                            const __m256i& outer_thresh,
+                            const __m256i& inner_thresh) {
+  return NeedsFilter(qp1, qp0, AbsDiff(qp1, qp0), outer_thresh, inner_thresh);
+}
+
+inline __m256i NeedsFilter6(const __m256i& qp2, const __m256i& qp1,
+                            const __m256i& qp0, const __m256i& outer_thresh,
+                            const __m256i& inner_thresh) {
+  const __m256i max_diff =
+      _mm256_max_epu16(AbsDiff(qp2, qp1), AbsDiff(qp1, qp0));
+  return NeedsFilter(qp1, qp0, max_diff, outer_thresh, inner_thresh);
+}
+
+inline __m256i NeedsFilter8(const __m256i& qp3, const __m256i& qp2,
+                            const __m256i& qp1, const __m256i& qp0,
+                            const __m256i& outer_thresh,
+                            const __m256i& inner_thresh) {
+  const __m256i max_diff = _mm256_max_epu16(
+      _mm256_max_epu16(AbsDiff(qp2, qp1), AbsDiff(qp1, qp0)),
+      AbsDiff(qp3, qp2));
+  return NeedsFilter(qp1, qp0, max_diff, outer_thresh, inner_thresh);
+}
+
+inline __m256i IsFlat3(const __m256i& qp2, const __m256i& qp1,
+                       const __m256i& qp0, const __m256i& flat_thresh) {
+  const __m256i max_diff =
+      _mm256_max_epu16(AbsDiff(qp2, qp0), AbsDiff(qp1, qp0));
+  return _mm256_cmpeq_epi16(
+      _mm256_subs_epu16(MaxPQ(max_diff), flat_thresh), _mm256_setzero_si256());
+}
+
+inline __m256i IsFlat4(const __m256i& qp3, const __m256i& qp2,
+                       const __m256i& qp1, const __m256i& qp0,
+                       const __m256i& flat_thresh) {
+  const __m256i max_diff = _mm256_max_epu16(
+      _mm256_max_epu16(AbsDiff(qp2, qp0), AbsDiff(qp1, qp0)),
+      AbsDiff(qp3, qp0));
+  return _mm256_cmpeq_epi16(
+      _mm256_subs_epu16(MaxPQ(max_diff), flat_thresh), _mm256_setzero_si256());
+}
+
+// Returns |p_delta| in the low lane and -|q_delta| in the high lane. Only the
+// low lanes of the inputs are used.
+inline __m256i SignedDeltas(const __m256i& p_delta, const __m256i& q_delta) {
+  return _mm256_permute2x128_si256(
+      p_delta, _mm256_sub_epi16(_mm256_setzero_si256(), q_delta), 0x20);
+}
+
+template <int bitdepth>
+inline void Filter4(const __m256i& qp1, const __m256i& qp0, __m256i* oqp1,
+                    __m256i* oqp0, const __m256i& mask, const __m256i& hev) {
+  const __m256i t4 = _mm256_set1_epi16(4);
+  const __m256i t3 = _mm256_set1_epi16(3);
+  const __m256i t80 =
+      _mm256_set1_epi16(static_cast<int16_t>(1 << (bitdepth - 1)));
+  const __m256i t1 = _mm256_set1_epi16(0x1);
+  const __m256i vmin = _mm256_subs_epi16(_mm256_setzero_si256(), t80);
+  const __m256i vmax = _mm256_subs_epi16(t80, t1);
+  const __m256i ps1 = _mm256_subs_epi16(qp1, t80);
+  const __m256i ps0 = _mm256_subs_epi16(qp0, t80);
+  const __m256i qs1 = SwapLanes(ps1);
+  const __m256i qs0 = SwapLanes(ps0);
+
+  // The filter values are computed in the low lane.
+  __m256i a = _mm256_subs_epi16(ps1, qs1);
+  a = _mm256_and_si256(Clamp(vmin, vmax, a), hev);
+
+  const __m256i x = _mm256_subs_epi16(qs0, ps0);
+  a = _mm256_adds_epi16(a, x);
+  a = _mm256_adds_epi16(a, x);
+  a = _mm256_adds_epi16(a, x);
+  a = _mm256_and_si256(Clamp(vmin, vmax, a), mask);
+
+  const __m256i a1 = AddShift3(a, t4, vmin, vmax);
+  const __m256i a2 = AddShift3(a, t3, vmin, vmax);
+  const __m256i a3 = _mm256_andnot_si256(hev, AddShift1(a1, t1));
+
+  // p1 + a3 | q1 - a3 and p0 + a2 | q0 - a1.
+  const __m256i oqps1 = _mm256_adds_epi16(ps1, SignedDeltas(a3, a3));
+  const __m256i oqps0 = _mm256_adds_epi16(ps0, SignedDeltas(a2, a1));
+
+  *oqp1 = _mm256_adds_epi16(Clamp(vmin, vmax, oqps1), t80);
+  *oqp0 = _mm256_adds_epi16(Clamp(vmin, vmax, oqps0), t80);
+}
+
+inline void Filter6(const __m256i& qp2, const __m256i& qp1, const __m256i& qp0,
+                    __m256i* oqp1, __m256i* oqp0) {
+  const __m256i four = _mm256_set1_epi16(4);
+  const __m256i pq1 = SwapLanes(qp1);
+  const __m256i pq0 = SwapLanes(qp0);
+
+  __m256i f6 =
+      _mm256_add_epi16(_mm256_add_epi16(qp2, four), _mm256_add_epi16(qp2, qp2));
+  f6 = _mm256_add_epi16(_mm256_add_epi16(f6, qp1), qp1);
+  f6 = _mm256_add_epi16(_mm256_add_epi16(f6, qp0), _mm256_add_epi16(qp0, pq0));
+
+  // p2 * 3 + p1 * 2 + p0 * 2 + q0
+  // q2 * 3 + q1 * 2 + q0 * 2 + p0
+  *oqp1 = _mm256_srli_epi16(f6, 3);
+
+  // p2 + p1 * 2 + p0 * 2 + q0 * 2 + q1
+  // q2 + q1 * 2 + q0 * 2 + p0 * 2 + p1
+  f6 = FilterAdd2Sub2(f6, pq0, pq1, qp2, qp2);
+  *oqp0 = _mm256_srli_epi16(f6, 3);
+}
+
+inline void Filter8(const __m256i& qp3, const __m256i& qp2, const __m256i& qp1,
+                    const __m256i& qp0, __m256i* oqp2, __m256i* oqp1,
+                    __m256i* oqp0) {
+  const __m256i four = _mm256_set1_epi16(4);
+  const __m256i pq2 = SwapLanes(qp2);
+  const __m256i pq1 = SwapLanes(qp1);
+  const __m256i pq0 = SwapLanes(qp0);
+
+  __m256i f8 =
+      _mm256_add_epi16(_mm256_add_epi16(qp3, four), _mm256_add_epi16(qp3, qp3));
+  f8 = _mm256_add_epi16(_mm256_add_epi16(f8, qp2), qp2);
+  f8 = _mm256_add_epi16(_mm256_add_epi16(f8, qp1), _mm256_add_epi16(qp0, pq0));
+
+  // p3 + p3 + p3 + 2 * p2 + p1 + p0 + q0
+  // q3 + q3 + q3 + 2 * q2 + q1 + q0 + p0
+  *oqp2 = _mm256_srli_epi16(f8, 3);
+
+  // p3 + p3 + p2 + 2 * p1 + p0 + q0 + q1
+  // q3 + q3 + q2 + 2 * q1 + q0 + p0 + p1
+  f8 = FilterAdd2Sub2(f8, qp1, pq1, qp3, qp2);
+  *oqp1 = _mm256_srli_epi16(f8, 3);
+
+  // p3 + p2 + p1 + 2 * p0 + q0 + q1 + q2
+  // q3 + q2 + q1 + 2 * q0 + p0 + p1 + p2
+  f8 = FilterAdd2Sub2(f8, qp0, pq2, qp3, qp1);
+  *oqp0 = _mm256_srli_epi16(f8, 3);
+}
+
+inline void Filter14(const __m256i* const qp, __m256i* oqp5, __m256i* oqp4,
+                     __m256i* oqp3, __m256i* oqp2, __m256i* oqp1,
+                     __m256i* oqp0) {
+  const __m256i eight = _mm256_set1_epi16(8);
+  const __m256i pq5 = SwapLanes(qp[5]);
+  const __m256i pq4 = SwapLanes(qp[4]);
+  const __m256i pq3 = SwapLanes(qp[3]);
+  const __m256i pq2 = SwapLanes(qp[2]);
+  const __m256i pq1 = SwapLanes(qp[1]);
+  const __m256i pq0 = SwapLanes(qp[0]);
+
+  __m256i f14 = _mm256_add_epi16(
+      eight, _mm256_sub_epi16(_mm256_slli_epi16(qp[6], 3), qp[6]));
+  f14 = _mm256_add_epi16(_mm256_add_epi16(f14, qp[5]),
+                         _mm256_add_epi16(qp[5], qp[4]));
+  f14 = _mm256_add_epi16(_mm256_add_epi16(f14, qp[4]),
+                         _mm256_add_epi16(qp[3], qp[2]));
+  f14 = _mm256_add_epi16(_mm256_add_epi16(f14, qp[1]),
+                         _mm256_add_epi16(qp[0], pq0));
+
+  // p6 * 7 + p5 * 2 + p4 * 2 + p3 + p2 + p1 + p0 + q0
+  // q6 * 7 + q5 * 2 + q4 * 2 + q3 + q2 + q1 + q0 + p0
+  *oqp5 = _mm256_srli_epi16(f14, 4);
+
+  // p6 * 5 + p5 * 2 + p4 * 2 + p3 * 2 + p2 + p1 + p0 + q0 + q1
+  // q6 * 5 + q5 * 2 + q4 * 2 + q3 * 2 + q2 + q1 + q0 + p0 + p1
+  f14 = FilterAdd2Sub2(f14, qp[3], pq1, qp[6], qp[6]);
+  *oqp4 = _mm256_srli_epi16(f14, 4);
+
+  // p6 * 4 + p5 + p4 * 2 + p3 * 2 + p2 * 2 + p1 + p0 + q0 + q1 + q2
+  // q6 * 4 + q5 + q4 * 2 + q3 * 2 + q2 * 2 + q1 + q0 + p0 + p1 + p2
+  f14 = FilterAdd2Sub2(f14, qp[2], pq2, qp[6], qp[5]);
+  *oqp3 = _mm256_srli_epi16(f14, 4);
+
+  // p6 * 3 + p5 + p4 + p3 * 2 + p2 * 2 + p1 * 2 + p0 + q0 + q1 + q2 + q3
+  // q6 * 3 + q5 + q4 + q3 * 2 + q2 * 2 + q1 * 2 + q0 + p0 + p1 + p2 + p3
+  f14 = FilterAdd2Sub2(f14, qp[1], pq3, qp[6], qp[4]);
+  *oqp2 = _mm256_srli_epi16(f14, 4);
+
+  // p6 * 2 + p5 + p4 + p3 + p2 * 2 + p1 * 2 + p0 * 2 + q0 + q1 + q2 + q3 + q4
+  // q6 * 2 + q5 + q4 + q3 + q2 * 2 + q1 * 2 + q0 * 2 + p0 + p1 + p2 + p3 + p4
+  f14 = FilterAdd2Sub2(f14, qp[0], pq4, qp[6], qp[3]);
+  *oqp1 = _mm256_srli_epi16(f14, 4);
+
+  // p6 + p5 + p4 + p3 + p2 + p1 * 2 + p0 * 2 + q0 * 2 + q1 + q2 + q3 + q4 + q5
+  // q6 + q5 + q4 + q3 + q2 + q1 * 2 + q0 * 2 + p0 * 2 + p1 + p2 + p3 + p4 + p5
+  f14 = FilterAdd2Sub2(f14, pq0, pq5, qp[6], qp[2]);
+  *oqp0 = _mm256_srli_epi16(f14, 4);
+}
+
+// Returns the number of pixels read on each side of the edge by a filter of
+// |size| taps.
+constexpr int NumInputs(const int size) { return (size == 14) ? 7 : size / 2; }
+
+// Returns the number of pixels modified on each side of the edge.
+constexpr int NumOutputs(const int size) {
+  return (size == 4) ? 2 : NumInputs(size) - 1;
+}
+
+// Section 7.14.6. Applies the |size|-tap filter to |qp|, replacing the
+// modified entries.
+template <int bitdepth, int size>
+inline void FilterEdge(__m256i* const qp, const int outer_thresh,
+                       const int inner_thresh, const int hev_thresh) {
+  constexpr int kThreshShift = bitdepth - 8;
+  const __m256i v_flat_thresh = _mm256_set1_epi16(1 << kThreshShift);
+  const __m256i v_outer_thresh =
+      _mm256_set1_epi16(static_cast<int16_t>(outer_thresh << kThreshShift));
+  const __m256i v_inner_thresh =
+      _mm256_set1_epi16(static_cast<int16_t>(inner_thresh << kThreshShift));
+  const __m256i v_hev_thresh =
+      _mm256_set1_epi16(static_cast<int16_t>(hev_thresh << kThreshShift));
+
+  const __m256i v_hev_mask = Hev(qp[1], qp[0], v_hev_thresh);
+  __m256i v_needs_mask;
+  if (size == 4) {
+    v_needs_mask = NeedsFilter4(qp[1], qp[0], v_outer_thresh, v_inner_thresh);
+  } else if (size == 6) {
+    v_needs_mask =
+        NeedsFilter6(qp[2], qp[1], qp[0], v_outer_thresh, v_inner_thresh);
+  } else {
+    v_needs_mask = NeedsFilter8(qp[3], qp[2], qp[1], qp[0], v_outer_thresh,
+                                v_inner_thresh);
+  }
+
+  __m256i oqp1;
+  __m256i oqp0;
+  Filter4<bitdepth>(qp[1], qp[0], &oqp1, &oqp0, v_needs_mask, v_hev_mask);
+  if (size != 4) {
+    const __m256i v_isflat_mask =
+        (size == 6) ? IsFlat3(qp[2], qp[1], qp[0], v_flat_thresh)
+                    : IsFlat4(qp[3], qp[2], qp[1], qp[0], v_flat_thresh);
+    const __m256i v_mask = _mm256_and_si256(v_needs_mask, v_isflat_mask);
+    if (!_mm256_testz_si256(v_mask, v_mask)) {
+      if (size == 6) {
+        __m256i oqp1_f6;
+        __m256i oqp0_f6;
+        Filter6(qp[2], qp[1], qp[0], &oqp1_f6, &oqp0_f6);
+        oqp1 = _mm256_blendv_epi8(oqp1, oqp1_f6, v_mask);
+        oqp0 = _mm256_blendv_epi8(oqp0, oqp0_f6, v_mask);
+      } else {
+        __m256i oqp2_f8;
+        __m256i oqp1_f8;
+        __m256i oqp0_f8;
+        Filter8(qp[3], qp[2], qp[1], qp[0], &oqp2_f8, &oqp1_f8, &oqp0_f8);
+        __m256i oqp2 = _mm256_blendv_epi8(qp[2], oqp2_f8, v_mask);
+        oqp1 = _mm256_blendv_epi8(oqp1, oqp1_f8, v_mask);
+        oqp0 = _mm256_blendv_epi8(oqp0, oqp0_f8, v_mask);
+
+        if (size == 14) {
+          const __m256i v_flat4_mask = _mm256_and_si256(
+              v_mask, IsFlat4(qp[6], qp[5], qp[4], qp[0], v_flat_thresh));
+          if (!_mm256_testz_si256(v_flat4_mask, v_flat4_mask)) {
+            __m256i oqp5_f14;
+            __m256i oqp4_f14;
+            __m256i oqp3_f14;
+            __m256i oqp2_f14;
+            __m256i oqp1_f14;
+            __m256i oqp0_f14;
+            Filter14(qp, &oqp5_f14, &oqp4_f14, &oqp3_f14, &oqp2_f14, &oqp1_f14,
+                     &oqp0_f14);
+            qp[5] = _mm256_blendv_epi8(qp[5], oqp5_f14, v_flat4_mask);
+            qp[4] = _mm256_blendv_epi8(qp[4], oqp4_f14, v_flat4_mask);
+            qp[3] = _mm256_blendv_epi8(qp[3], oqp3_f14, v_flat4_mask);
+            oqp2 = _mm256_blendv_epi8(oqp2, oqp2_f14, v_flat4_mask);
+            oqp1 = _mm256_blendv_epi8(oqp1, oqp1_f14, v_flat4_mask);
+            oqp0 = _mm256_blendv_epi8(oqp0, oqp0_f14, v_flat4_mask);
+          }
+        }
+        qp[2] = oqp2;
+      }
+    }
+  }
+  qp[1] = oqp1;
+  qp[0] = oqp0;
+}
+
+//------------------------------------------------------------------------------
+// Loads and stores of 8 pixels, widened to 16 bits.
+
+inline __m128i LoadPixels8(const uint8_t* const src) {
+  return _mm_cvtepu8_epi16(LoadLo8(src));
+}
+
+inline __m128i LoadPixels8(const uint16_t* const src) {
+  return LoadUnaligned16(src);
+}
+
+inline void StorePixels8(uint8_t* const dst, const __m128i& v) {
+  StoreLo8(dst, _mm_packus_epi16(v, v));
+}
+
+inline void StorePixels8(uint16_t* const dst, const __m128i& v) {
+  StoreUnaligned16(dst, v);
+}
+
+// Loads 8 rows of 8 pixels from |src| and transposes them, so that |columns[i]|
+// holds column i of the rows.
+template <typename Pixel>
+inline void LoadColumns8x8(const Pixel* src, const ptrdiff_t stride,
+                           __m128i* const columns) {
+  __m128i rows[8];
+  for (int i = 0; i < 8; ++i) {
+    rows[i] = LoadPixels8(src);
+    src += stride;
+  }
+  Transpose8x8_U16(rows, columns);
+}
+
+template <typename Pixel>
+inline void StoreColumns8x8(Pixel* dst, const ptrdiff_t stride,
+                            const __m128i* const columns) {
+  __m128i rows[8];
+  Transpose8x8_U16(columns, rows);
+  for (int i = 0; i < 8; ++i) {
+    StorePixels8(dst, rows[i]);
+    dst += stride;
+  }
+}
+
+// Filters a horizontal edge, i.e., 8 columns with the p side in the rows above
+// |dest|.
+template <int bitdepth, typename Pixel, int size>
+void HorizontalX2_AVX2(void* dest, ptrdiff_t stride, int outer_thresh,
+                       int inner_thresh, int hev_thresh) {
+  auto* const dst = static_cast<Pixel*>(dest);
+  stride /= sizeof(Pixel);
+  __m256i qp[7];
+  for (int i = 0; i < NumInputs(size); ++i) {
+    qp[i] = SetrM128i(LoadPixels8(dst - (i + 1) * stride),
+                      LoadPixels8(dst + i * stride));
+  }
+  FilterEdge<bitdepth, size>(qp, outer_thresh, inner_thresh, hev_thresh);
+  for (int i = 0; i < NumOutputs(size); ++i) {
+    StorePixels8(dst - (i + 1) * stride, LowLane(qp[i]));
+    StorePixels8(dst + i * stride, HighLane(qp[i]));
+  }
+}
+
+// Filters a vertical edge, i.e., 8 rows with the p side to the left of |dest|.
+// The rows are transposed so that each vector holds one column.
+template <int bitdepth, typename Pixel, int size>
+void VerticalX2_AVX2(void* dest, ptrdiff_t stride, int outer_thresh,
+                     int inner_thresh, int hev_thresh) {
+  auto* const dst = static_cast<Pixel*>(dest);
+  stride /= sizeof(Pixel);
+  __m256i qp[7];
+  if (size == 14) {
+    // |p_columns| holds p7-p0 and |q_columns| q0-q7.
+    __m128i p_columns[8];
+    __m128i q_columns[8];
+    LoadColumns8x8(dst - 8, stride, p_columns);
+    LoadColumns8x8(dst, stride, q_columns);
+    for (int i = 0; i < 7; ++i) {
+      qp[i] = SetrM128i(p_columns[7 - i], q_columns[i]);
+    }
+    FilterEdge<bitdepth, size>(qp, outer_thresh, inner_thresh, hev_thresh);
+    for (int i = 0; i < NumOutputs(size); ++i) {
+      p_columns[7 - i] = LowLane(qp[i]);
+      q_columns[i] = HighLane(qp[i]);
+    }
+    StoreColumns8x8(dst - 8, stride, p_columns);
+    StoreColumns8x8(dst, stride, q_columns);
+    return;
+  }
+
+  // |columns| holds p3-p0 followed by q0-q3.
+  __m128i columns[8];
+  LoadColumns8x8(dst - 4, stride, columns);
+  for (int i = 0; i < 4; ++i) {
+    qp[i] = SetrM128i(columns[3 - i], columns[4 + i]);
+  }
+  FilterEdge<bitdepth, size>(qp, outer_thresh, inner_thresh, hev_thresh);
+  for (int i = 0; i < NumOutputs(size); ++i) {
+    columns[3 - i] = LowLane(qp[i]);
+    columns[4 + i] = HighLane(qp[i]);
+  }
+  StoreColumns8x8(dst - 4, stride, columns);
+}
+
+template <int bitdepth, typename Pixel>
+void InitX2(Dsp* const dsp) {
+  dsp->loop_filters_x2[kLoopFilterSize4][kLoopFilterTypeHorizontal] =
+      HorizontalX2_AVX2<bitdepth, Pixel, 4>;
+  dsp->loop_filters_x2[kLoopFilterSize4][kLoopFilterTypeVertical] =
+      VerticalX2_AVX2<bitdepth, Pixel, 4>;
+  dsp->loop_filters_x2[kLoopFilterSize6][kLoopFilterTypeHorizontal] =
+      HorizontalX2_AVX2<bitdepth, Pixel, 6>;
+  dsp->loop_filters_x2[kLoopFilterSize6][kLoopFilterTypeVertical] =
+      VerticalX2_AVX2<bitdepth, Pixel, 6>;
+  dsp->loop_filters_x2[kLoopFilterSize8][kLoopFilterTypeHorizontal] =
+      HorizontalX2_AVX2<bitdepth, Pixel, 8>;
+  dsp->loop_filters_x2[kLoopFilterSize8][kLoopFilterTypeVertical] =
+      VerticalX2_AVX2<bitdepth, Pixel, 8>;
+  dsp->loop_filters_x2[kLoopFilterSize14][kLoopFilterTypeHorizontal] =
+      HorizontalX2_AVX2<bitdepth, Pixel, 14>;
+  dsp->loop_filters_x2[kLoopFilterSize14][kLoopFilterTypeVertical] =
+      VerticalX2_AVX2<bitdepth, Pixel, 14>;
+}
+
+void Init8bpp() {
+  Dsp* const dsp = dsp_internal::GetWritableDspTable(kBitdepth8);
+  assert(dsp != nullptr);
+  static_cast<void>(dsp);
+#if DSP_ENABLED_8BPP_AVX2(LoopFiltersX2)
+  InitX2<kBitdepth8, uint8_t>(dsp);
+#endif
+}
+
+#if LIBGAV1_MAX_BITDEPTH >= 10
+void Init10bpp() {
+  Dsp* const dsp = dsp_internal::GetWritableDspTable(kBitdepth10);
+  assert(dsp != nullptr);
+  static_cast<void>(dsp);
+#if DSP_ENABLED_10BPP_AVX2(LoopFiltersX2)
+  InitX2<kBitdepth10, uint16_t>(dsp);
+#endif
+}
+#endif  // LIBGAV1_MAX_BITDEPTH >= 10
+
+}  // namespace
+
+void LoopFilterInit_AVX2() {
+  Init8bpp();
+#if LIBGAV1_MAX_BITDEPTH >= 10
+  Init10bpp();
+#endif
+}
+
+}  // namespace dsp
+}  // namespace libgav1
+
+#else   // !LIBGAV1_TARGETING_AVX2
+namespace libgav1 {
+namespace dsp {
+
+void LoopFilterInit_AVX2() {}
+
+}  // namespace dsp
+}  // namespace libgav1
+#endif  // LIBGAV1_TARGETING_AVX2
@@ -0,0 +1,207 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the SSE4.1 and AVX2 deblocking filters (loop_filter_sse4.cc and
+// loop_filter_avx2.cc) with the C ones at 8 and 10bpp. Each filter the tier
+// installs in Dsp::loop_filters is compared with the C filter, and each paired
+// filter in Dsp::loop_filters_x2 with two C calls on adjacent segments, for
+// every filter level and sharpness, on edges that are smooth, stepped or
+// random so that every filter mask is reached.
+//
+// The SIMD functions are reached through their Init functions, so this file
+// is built without SIMD flags and each tier is skipped on CPUs without it.
+
+#include "src/dsp/loop_filter.h"
+
+#include "gtest/gtest.h"
+#include "src/utils/cpu.h"
+
+#if LIBGAV1_ENABLE_SSE4_1
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "src/dsp/dsp.h"
+#include "src/dsp/x86/loop_filter_avx2.h"
+#include "src/dsp/x86/loop_filter_sse4.h"
+#include "src/utils/common.h"
+#include "src/utils/constants.h"
+
+namespace libgav1 {
+namespace dsp {
+namespace {
+
+// Import the thresholds PostFilter passes to the filters.
+#include "src/post_filter/deblock_thresholds.inc"
+
+struct LoopFilterTier {
+  const char* name;
+  CpuFeatures feature;
+  void (*init)();
+};
+
+const LoopFilterTier kLoopFilterTiers[] = {
+    {"SSE4_1", kSSE4_1, LoopFilterInit_SSE4_1},
+    {"AVX2", kAVX2, LoopFilterInit_AVX2}};
+
+class LoopFilterTest : public testing::TestWithParam<LoopFilterTier> {
+ protected:
+  // The edge is at the center of the block, which has room for the 14-tap
+  // filter on both sides of two 4-pixel segments.
+  static constexpr int kBlockSize = 32;
+  static constexpr int kEdge = kBlockSize / 2;
+
+  void SetUp() override {
+    if ((GetCpuInfo() & GetParam().feature) == 0) {
+      GTEST_SKIP() << GetParam().name << " is not supported by this CPU.";
+    }
+    DspInit();
+  }
+
+  // Fills |block| with one of: a smooth area with noise of a random
+  // amplitude, the same with a step across the edge, or random pixels.
+  template <int bitdepth, typename Pixel>
+  void RandomBlock(int iteration, LoopFilterType type,
+                   std::vector<Pixel>* block) {
+    constexpr int kPixelMax = (1 << bitdepth) - 1;
+    constexpr int kAmplitudes[] = {0, 1, 2, 4, 8, 16, 64};
+    std::uniform_int_distribution<int> pixel(0, kPixelMax);
+    std::uniform_int_distribution<int> amplitude_index(0, 6);
+    const int amplitude = kAmplitudes[amplitude_index(rng_)]
+                          << (bitdepth - 8);
+    std::uniform_int_distribution<int> noise(-amplitude, amplitude);
+    const int base = pixel(rng_);
+    const int step = ((iteration % 3) == 1) ? noise(rng_) * 4 : 0;
+    for (int y = 0; y < kBlockSize; ++y) {
+      for (int x = 0; x < kBlockSize; ++x) {
+        const int position = (type == kLoopFilterTypeVertical) ? x : y;
+        const int value = ((iteration % 3) == 2)
+                              ? pixel(rng_)
+                              : base + noise(rng_) +
+                                    ((position >= kEdge) ? step : 0);
+        (*block)[y * kBlockSize + x] =
+            static_cast<Pixel>(Clip3(value, 0, kPixelMax));
+      }
+    }
+  }
+
+  template <int bitdepth, typename Pixel>
+  void TestLoopFilters(bool paired);
+
+  std::mt19937 rng_{kBlockSize};
+};
+
+template <int bitdepth, typename Pixel>
+void LoopFilterTest::TestLoopFilters(bool paired) {
+  // loop_filter.cc is built without SIMD flags, so LoopFilterInit_C()
+  // installs every C function. The tier then replaces the ones it has.
+  // The paired filters are optional and only set by the SIMD tiers, so they
+  // are cleared to drop those of the tiers initialized before.
+  LoopFilterInit_C();
+  Dsp* const dsp = dsp_internal::GetWritableDspTable(bitdepth);
+  memset(dsp->loop_filters_x2, 0, sizeof(dsp->loop_filters_x2));
+  LoopFilterFuncs c_filters;
+  memcpy(c_filters, dsp->loop_filters, sizeof(c_filters));
+  GetParam().init();
+  LoopFilterFuncs simd_filters;
+  memcpy(simd_filters, paired ? dsp->loop_filters_x2 : dsp->loop_filters,
+         sizeof(simd_filters));
+  const ptrdiff_t stride = kBlockSize * sizeof(Pixel);
+  std::vector<Pixel> c_block(kBlockSize * kBlockSize);
+  std::vector<Pixel> simd_block(kBlockSize * kBlockSize);
+  int num_simd = 0;
+  for (int size = 0; size < kNumLoopFilterSizes; ++size) {
+    for (int type = 0; type < kNumLoopFilterTypes; ++type) {
+      const LoopFilterFunc c_filter = c_filters[size][type];
+      const LoopFilterFunc simd_filter = simd_filters[size][type];
+      if (simd_filter == nullptr || simd_filter == c_filter) continue;
+      ++num_simd;
+      const auto filter_type = static_cast<LoopFilterType>(type);
+      // The second segment of a pair is 4 rows below the first for a
+      // vertical edge and 4 pixels to the right for a horizontal one.
+      const ptrdiff_t segment_offset =
+          (filter_type == kLoopFilterTypeVertical) ? 4 * kBlockSize : 4;
+      const ptrdiff_t dst_offset =
+          (filter_type == kLoopFilterTypeVertical)
+              ? (kEdge - 4) * kBlockSize + kEdge
+              : kEdge * kBlockSize + kEdge - 4;
+      for (int sharpness = 0; sharpness < 8; ++sharpness) {
+        for (int level = 1; level <= kMaxLoopFilterValue; ++level) {
+          for (int iteration = 0; iteration < 6; ++iteration) {
+            RandomBlock<bitdepth>(iteration, filter_type, &c_block);
+            simd_block = c_block;
+            const int outer_thresh = kOuterThresh[sharpness][level];
+            const int inner_thresh = kInnerThresh[sharpness][level];
+            const int hev_thresh = DivideBy16(level);
+            Pixel* const c_dst = c_block.data() + dst_offset;
+            c_filter(c_dst, stride, outer_thresh, inner_thresh, hev_thresh);
+            if (paired) {
+              c_filter(c_dst + segment_offset, stride, outer_thresh,
+                       inner_thresh, hev_thresh);
+            }
+            simd_filter(simd_block.data() + dst_offset, stride, outer_thresh,
+                        inner_thresh, hev_thresh);
+            ASSERT_EQ(c_block, simd_block)
+                << bitdepth << "bpp" << (paired ? " paired" : "") << " size "
+                << size << ", type " << type << ", sharpness " << sharpness
+                << ", level " << level << ", iteration " << iteration;
+          }
+        }
+      }
+    }
+  }
+  if (num_simd == 0) {
+    GTEST_SKIP() << "No " << GetParam().name << (paired ? " paired" : "")
+                 << " filters at " << bitdepth << "bpp.";
+  }
+}
+
+TEST_P(LoopFilterTest, Filters8bpp) {
+  TestLoopFilters<kBitdepth8, uint8_t>(/*paired=*/false);
+}
+TEST_P(LoopFilterTest, PairedFilters8bpp) {
+  TestLoopFilters<kBitdepth8, uint8_t>(/*paired=*/true);
+}
+
+#if LIBGAV1_MAX_BITDEPTH >= 10
+TEST_P(LoopFilterTest, Filters10bpp) {
+  TestLoopFilters<kBitdepth10, uint16_t>(/*paired=*/false);
+}
+TEST_P(LoopFilterTest, PairedFilters10bpp) {
+  TestLoopFilters<kBitdepth10, uint16_t>(/*paired=*/true);
+}
+#endif  // LIBGAV1_MAX_BITDEPTH >= 10
+
+INSTANTIATE_TEST_SUITE_P(
+    X86, LoopFilterTest, testing::ValuesIn(kLoopFilterTiers),
+    [](const testing::TestParamInfo<LoopFilterTier>& info) {
+      return std::string(info.param.name);
+    });
+
+}  // namespace
+}  // namespace dsp
+}  // namespace libgav1
+
+#else  // !LIBGAV1_ENABLE_SSE4_1
+
+TEST(LoopFilterTest, X86) {
+  GTEST_SKIP() << "Build this module for x86(-64) to enable the tests.";
+}
+
+#endif  // LIBGAV1_ENABLE_SSE4_1
@@ -0,0 +1,254 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the 10bpp SSE4.1 and AVX2 Wiener and self-guided filters
+// (loop_restoration_10bit_sse4.cc and loop_restoration_10bit_avx2.cc) with the
+// C ones on random and extreme pixels, for the unit sizes PostFilter passes
+// and random filter coefficients, including those with leading zero taps, and
+// every self-guided parameter set.
+//
+// The SIMD functions are reached through their Init functions, so this file
+// is built without SIMD flags and each tier is skipped on CPUs without it.
+
+#include "src/dsp/loop_restoration.h"
+
+#include "gtest/gtest.h"
+#include "src/utils/cpu.h"
+
+#if LIBGAV1_ENABLE_SSE4_1 && LIBGAV1_MAX_BITDEPTH >= 10
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "src/dsp/common.h"
+#include "src/dsp/dsp.h"
+#include "src/dsp/x86/loop_restoration_avx2.h"
+#include "src/dsp/x86/loop_restoration_sse4.h"
+#include "src/utils/constants.h"
+#include "src/utils/memory.h"
+
+namespace libgav1 {
+namespace dsp {
+namespace {
+
+struct LoopRestorationTier {
+  const char* name;
+  CpuFeatures feature;
+  void (*init)();
+};
+
+const LoopRestorationTier kLoopRestorationTiers[] = {
+    {"SSE4_1", kSSE4_1, LoopRestorationInit10bpp_SSE4_1},
+    {"AVX2", kAVX2, LoopRestorationInit10bpp_AVX2}};
+
+// The same count as in loop_restoration_info.cc.
+int CountLeadingZeroCoefficients(const int16_t* const filter) {
+  int number_zero_coefficients = 0;
+  if (filter[0] == 0) {
+    number_zero_coefficients++;
+    if (filter[1] == 0) {
+      number_zero_coefficients++;
+      if (filter[2] == 0) {
+        number_zero_coefficients++;
+      }
+    }
+  }
+  return number_zero_coefficients;
+}
+
+class LoopRestoration10bppTest
+    : public testing::TestWithParam<LoopRestorationTier> {
+ protected:
+  // Room around the unit for the filter taps, the borders PostFilter keeps
+  // above and below it and SIMD loads that read past the end of a row.
+  static constexpr int kBorder = 32;
+  static constexpr int kStride = kRestorationUnitWidth + 2 * kBorder;
+  static constexpr int kRows = kRestorationUnitHeight + 2 * kBorder;
+  static constexpr int kPixelMax = (1 << kBitdepth10) - 1;
+
+  void SetUp() override {
+    if ((GetCpuInfo() & GetParam().feature) == 0) {
+      GTEST_SKIP() << GetParam().name << " is not supported by this CPU.";
+    }
+    DspInit();
+    // loop_restoration.cc is built without SIMD flags, so
+    // LoopRestorationInit_C() installs every C function. The tier then
+    // replaces the ones it has.
+    LoopRestorationInit_C();
+    memcpy(c_, GetDspTable(kBitdepth10)->loop_restorations, sizeof(c_));
+    GetParam().init();
+    memcpy(simd_, GetDspTable(kBitdepth10)->loop_restorations, sizeof(simd_));
+  }
+
+  // Pixels are random on even iterations and either 0 or the maximum on odd
+  // ones.
+  void FillSource(int iteration) {
+    std::uniform_int_distribution<int> pixel(0, kPixelMax);
+    std::uniform_int_distribution<int> extreme(0, 1);
+    for (auto& value : source_) {
+      value = static_cast<uint16_t>(
+          ((iteration & 1) == 0) ? pixel(rng_) : extreme(rng_) * kPixelMax);
+    }
+  }
+
+  // Draws the taps as ReadWienerInfo() does. Chroma units have no outer tap,
+  // and one in four passes zeroes the leading taps to reach the shorter
+  // filters.
+  void RandomWienerInfo(bool is_chroma, RestorationUnitInfo* info) {
+    std::uniform_int_distribution<int> zero_taps(0, 3);
+    for (int i = WienerInfo::kVertical; i <= WienerInfo::kHorizontal; ++i) {
+      int16_t* const filter = info->wiener_info.filter[i];
+      int sum = 0;
+      int num_zero_taps = static_cast<int>(is_chroma);
+      if (zero_taps(rng_) == 0) {
+        num_zero_taps = std::max(num_zero_taps, zero_taps(rng_));
+      }
+      for (int j = 0; j < kNumWienerCoefficients; ++j) {
+        std::uniform_int_distribution<int> tap(kWienerTapsMin[j],
+                                               kWienerTapsMax[j]);
+        filter[j] = (j < num_zero_taps) ? 0 : tap(rng_);
+        sum += filter[j];
+      }
+      filter[3] = 128 - 2 * sum;
+      info->wiener_info.number_leading_zero_coefficients[i] =
+          CountLeadingZeroCoefficients(filter);
+    }
+  }
+
+  // Draws the multipliers as ReadSgrProjInfo() does for |index|.
+  void RandomSgrProjInfo(int index, RestorationUnitInfo* info) {
+    static constexpr int kMultiplier[2] = {0, 95};
+    info->sgr_proj_info.index = index;
+    for (int i = 0; i < 2; ++i) {
+      std::uniform_int_distribution<int> multiplier(kSgrProjMultiplierMin[i],
+                                                    kSgrProjMultiplierMax[i]);
+      info->sgr_proj_info.multiplier[i] =
+          (kSgrProjParams[index][i * 2] != 0) ? multiplier(rng_)
+                                               : kMultiplier[i];
+    }
+  }
+
+  void TestFilter(LoopRestorationType type, const RestorationUnitInfo& info,
+                  int width, int height, int iteration);
+
+  LoopRestorationFuncs c_;
+  LoopRestorationFuncs simd_;
+  std::vector<uint16_t> source_ = std::vector<uint16_t>(kStride * kRows);
+  std::mt19937 rng_{kBitdepth10};
+};
+
+void LoopRestoration10bppTest::TestFilter(LoopRestorationType type,
+                                          const RestorationUnitInfo& info,
+                                          int width, int height,
+                                          int iteration) {
+  const int index = type - kLoopRestorationTypeWiener;
+  const uint16_t* const src = source_.data() + kBorder * kStride + kBorder;
+  // The borders are the rows above and below the unit, as when PostFilter
+  // does not restore in place.
+  const uint16_t* const top_border = src - kRestorationVerticalBorder * kStride;
+  const uint16_t* const bottom_border = src + height * kStride;
+  AlignedUniquePtr<RestorationBuffer> c_buffer =
+      MakeAlignedUniquePtr<RestorationBuffer>(kMaxAlignment, 1);
+  AlignedUniquePtr<RestorationBuffer> simd_buffer =
+      MakeAlignedUniquePtr<RestorationBuffer>(kMaxAlignment, 1);
+  ASSERT_NE(c_buffer, nullptr);
+  ASSERT_NE(simd_buffer, nullptr);
+  std::vector<uint16_t> c_dest(kStride * kRows);
+  std::vector<uint16_t> simd_dest(kStride * kRows);
+  uint16_t* const c_dst = c_dest.data() + kBorder * kStride + kBorder;
+  uint16_t* const simd_dst = simd_dest.data() + kBorder * kStride + kBorder;
+  c_[index](info, src, kStride, top_border, kStride, bottom_border, kStride,
+            width, height, c_buffer.get(), c_dst);
+  simd_[index](info, src, kStride, top_border, kStride, bottom_border, kStride,
+                width, height, simd_buffer.get(), simd_dst);
+  for (int y = 0; y < height; ++y) {
+    const uint16_t* const c_row = c_dst + y * kStride;
+    const uint16_t* const simd_row = simd_dst + y * kStride;
+    ASSERT_TRUE(std::equal(c_row, c_row + width, simd_row))
+        << ((type == kLoopRestorationTypeWiener) ? "Wiener" : "self-guided")
+        << " " << width << "x" << height << ", row " << y << ", iteration "
+        << iteration << ", sgr index " << info.sgr_proj_info.index
+        << ", wiener zero taps "
+        << info.wiener_info.number_leading_zero_coefficients[0] << "/"
+        << info.wiener_info.number_leading_zero_coefficients[1];
+  }
+}
+
+// Unit widths up to kRestorationUnitWidth, including the partial units at the
+// right edge of a plane, and stripe heights up to kRestorationUnitHeight,
+// including the first stripe of 56 rows and the last ones of a plane.
+constexpr int kWidths[] = {4, 9, 16, 31, 32, 64, 100, 128, 195, 256};
+constexpr int kHeights[] = {1, 4, 7, 28, 32, 56, 64};
+
+TEST_P(LoopRestoration10bppTest, WienerFilter) {
+  if (simd_[0] == c_[0]) {
+    GTEST_SKIP() << "No " << GetParam().name << " Wiener filter.";
+  }
+  RestorationUnitInfo info = {};
+  info.type = kLoopRestorationTypeWiener;
+  for (const int width : kWidths) {
+    for (const int height : kHeights) {
+      for (int iteration = 0; iteration < 8; ++iteration) {
+        FillSource(iteration);
+        RandomWienerInfo(/*is_chroma=*/(iteration & 2) != 0, &info);
+        TestFilter(kLoopRestorationTypeWiener, info, width, height, iteration);
+        if (HasFatalFailure()) return;
+      }
+    }
+  }
+}
+
+TEST_P(LoopRestoration10bppTest, SelfGuidedFilter) {
+  if (simd_[1] == c_[1]) {
+    GTEST_SKIP() << "No " << GetParam().name << " self-guided filter.";
+  }
+  RestorationUnitInfo info = {};
+  info.type = kLoopRestorationTypeSgrProj;
+  for (const int width : kWidths) {
+    for (const int height : kHeights) {
+      for (int index = 0; index < (1 << kSgrProjParamsBits); ++index) {
+        const int iteration = index & 1;
+        FillSource(iteration);
+        RandomSgrProjInfo(index, &info);
+        TestFilter(kLoopRestorationTypeSgrProj, info, width, height,
+                   iteration);
+        if (HasFatalFailure()) return;
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    X86, LoopRestoration10bppTest, testing::ValuesIn(kLoopRestorationTiers),
+    [](const testing::TestParamInfo<LoopRestorationTier>& info) {
+      return std::string(info.param.name);
+    });
+
+}  // namespace
+}  // namespace dsp
+}  // namespace libgav1
+
+#else  // !(LIBGAV1_ENABLE_SSE4_1 && LIBGAV1_MAX_BITDEPTH >= 10)
+
+TEST(LoopRestoration10bppTest, X86) {
+  GTEST_SKIP() << "Build this module for x86(-64) with 10-bit support to "
+                  "enable the tests.";
+}
+
+#endif  // LIBGAV1_ENABLE_SSE4_1 && LIBGAV1_MAX_BITDEPTH >= 10
@@ -0,0 +1,525 @@
+// Copyright 2021 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/dsp/loop_restoration.h"
+#include "src/utils/cpu.h"
+
+#if LIBGAV1_TARGETING_AVX512
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "src/dsp/common.h"
+#include "src/dsp/constants.h"
+#include "src/dsp/dsp.h"
+#include "src/dsp/x86/common_avx512.h"
+#include "src/utils/common.h"
+#include "src/utils/constants.h"
+
+namespace libgav1 {
+namespace dsp {
+namespace low_bitdepth {
+namespace {
+
+// The AVX2 version filters 16 pixels per 256-bit register. Here each 128-bit
+// lane k of the source register holds pixels 8k to 8k + 15, so the kernels
+// below produce 32 outputs per row in their natural order.
+inline __m512i LoadWienerSource(const uint8_t* const src) {
+  const __m512i s = LoadBytes(src, 40);
+  return _mm512_permutexvar_epi64(_mm512_setr_epi64(0, 1, 1, 2, 2, 3, 3, 4),
+                                  s);
+}
+
+inline void WienerHorizontalClip(const __m512i s[2], const __m512i s_3x128,
+                                 int16_t* const wiener_buffer) {
+  constexpr int offset =
+      1 << (8 + kWienerFilterBits - kInterRoundBitsHorizontal - 1);
+  constexpr int limit =
+      (1 << (8 + 1 + kWienerFilterBits - kInterRoundBitsHorizontal)) - 1;
+  const __m512i offsets = _mm512_set1_epi16(-offset);
+  const __m512i limits = _mm512_set1_epi16(limit - offset);
+  const __m512i round = _mm512_set1_epi16(1 << (kInterRoundBitsHorizontal - 1));
+  // The sum range here is [-128 * 255, 90 * 255].
+  const __m512i madd = _mm512_add_epi16(s[0], s[1]);
+  const __m512i sum = _mm512_add_epi16(madd, round);
+  const __m512i rounded_sum0 =
+      _mm512_srai_epi16(sum, kInterRoundBitsHorizontal);
+  // Add back scaled down offset correction.
+  const __m512i rounded_sum1 = _mm512_add_epi16(rounded_sum0, s_3x128);
+  const __m512i d0 = _mm512_max_epi16(rounded_sum1, offsets);
+  const __m512i d1 = _mm512_min_epi16(d0, limits);
+  StoreUnaligned64(wiener_buffer, d1);
+}
+
+inline void WienerHorizontalTap7Kernel(const __m512i s[2],
+                                       const __m512i filter[4],
+                                       int16_t* const wiener_buffer) {
+  const auto s01 = _mm512_alignr_epi8(s[1], s[0], 1);
+  const auto s23 = _mm512_alignr_epi8(s[1], s[0], 5);
+  const auto s45 = _mm512_alignr_epi8(s[1], s[0], 9);
+  const auto s67 = _mm512_alignr_epi8(s[1], s[0], 13);
+  __m512i madds[4];
+  madds[0] = _mm512_maddubs_epi16(s01, filter[0]);
+  madds[1] = _mm512_maddubs_epi16(s23, filter[1]);
+  madds[2] = _mm512_maddubs_epi16(s45, filter[2]);
+  madds[3] = _mm512_maddubs_epi16(s67, filter[3]);
+  madds[0] = _mm512_add_epi16(madds[0], madds[2]);
+  madds[1] = _mm512_add_epi16(madds[1], madds[3]);
+  const __m512i s_3x128 = _mm512_slli_epi16(_mm512_srli_epi16(s23, 8),
+                                            7 - kInterRoundBitsHorizontal);
+  WienerHorizontalClip(madds, s_3x128, wiener_buffer);
+}
+
+inline void WienerHorizontalTap5Kernel(const __m512i s[2],
+                                       const __m512i filter[3],
+                                       int16_t* const wiener_buffer) {
+  const auto s01 = _mm512_alignr_epi8(s[1], s[0], 1);
+  const auto s23 = _mm512_alignr_epi8(s[1], s[0], 5);
+  const auto s45 = _mm512_alignr_epi8(s[1], s[0], 9);
+  __m512i madds[3];
+  madds[0] = _mm512_maddubs_epi16(s01, filter[0]);
+  madds[1] = _mm512_maddubs_epi16(s23, filter[1]);
+  madds[2] = _mm512_maddubs_epi16(s45, filter[2]);
+  madds[0] = _mm512_add_epi16(madds[0], madds[2]);
+  const __m512i s_3x128 = _mm512_srli_epi16(_mm512_slli_epi16(s23, 8),
+                                            kInterRoundBitsHorizontal + 1);
+  WienerHorizontalClip(madds, s_3x128, wiener_buffer);
+}
+
+inline void WienerHorizontalTap3Kernel(const __m512i s[2],
+                                       const __m512i filter[2],
+                                       int16_t* const wiener_buffer) {
+  const auto s01 = _mm512_alignr_epi8(s[1], s[0], 1);
+  const auto s23 = _mm512_alignr_epi8(s[1], s[0], 5);
+  __m512i madds[2];
+  madds[0] = _mm512_maddubs_epi16(s01, filter[0]);
+  madds[1] = _mm512_maddubs_epi16(s23, filter[1]);
+  const __m512i s_3x128 = _mm512_slli_epi16(_mm512_srli_epi16(s01, 8),
+                                            7 - kInterRoundBitsHorizontal);
+  WienerHorizontalClip(madds, s_3x128, wiener_buffer);
+}
+
+inline void WienerHorizontalTap7(const uint8_t* src, const ptrdiff_t src_stride,
+                                 const ptrdiff_t width, const int height,
+                                 const __m512i coefficients,
+                                 int16_t** const wiener_buffer) {
+  __m512i filter[4];
+  filter[0] = _mm512_shuffle_epi8(coefficients, _mm512_set1_epi16(0x0100));
+  filter[1] = _mm512_shuffle_epi8(coefficients, _mm512_set1_epi16(0x0302));
+  filter[2] = _mm512_shuffle_epi8(coefficients, _mm512_set1_epi16(0x0102));
+  filter[3] = _mm512_shuffle_epi8(
+      coefficients, _mm512_set1_epi16(static_cast<int16_t>(0x8000)));
+  for (int y = height; y != 0; --y) {
+    ptrdiff_t x = 0;
+    do {
+      const __m512i s = LoadWienerSource(src + x);
+      __m512i ss[2];
+      ss[0] = _mm512_unpacklo_epi8(s, s);
+      ss[1] = _mm512_unpackhi_epi8(s, s);
+      WienerHorizontalTap7Kernel(ss, filter, *wiener_buffer + x);
+      x += 32;
+    } while (x < width);
+    src += src_stride;
+    *wiener_buffer += width;
+  }
+}
+
+inline void WienerHorizontalTap5(const uint8_t* src, const ptrdiff_t src_stride,
+                                 const ptrdiff_t width, const int height,
+                                 const __m512i coefficients,
+                                 int16_t** const wiener_buffer) {
+  __m512i filter[3];
+  filter[0] = _mm512_shuffle_epi8(coefficients, _mm512_set1_epi16(0x0201));
+  filter[1] = _mm512_shuffle_epi8(coefficients, _mm512_set1_epi16(0x0203));
+  filter[2] = _mm512_shuffle_epi8(
+      coefficients, _mm512_set1_epi16(static_cast<int16_t>(0x8001)));
+  for (int y = height; y != 0; --y) {
+    ptrdiff_t x = 0;
+    do {
+      const __m512i s = LoadWienerSource(src + x);
+      __m512i ss[2];
+      ss[0] = _mm512_unpacklo_epi8(s, s);
+      ss[1] = _mm512_unpackhi_epi8(s, s);
+      WienerHorizontalTap5Kernel(ss, filter, *wiener_buffer + x);
+      x += 32;
+    } while (x < width);
+    src += src_stride;
+    *wiener_buffer += width;
+  }
+}
+
+inline void WienerHorizontalTap3(const uint8_t* src, const ptrdiff_t src_stride,
+                                 const ptrdiff_t width, const int height,
+                                 const __m512i coefficients,
+                                 int16_t** const wiener_buffer) {
+  __m512i filter[2];
+  filter[0] = _mm512_shuffle_epi8(coefficients, _mm512_set1_epi16(0x0302));
+  filter[1] = _mm512_shuffle_epi8(
+      coefficients, _mm512_set1_epi16(static_cast<int16_t>(0x8002)));
+  for (int y = height; y != 0; --y) {
+    ptrdiff_t x = 0;
+    do {
+      const __m512i s = LoadWienerSource(src + x);
+      __m512i ss[2];
+      ss[0] = _mm512_unpacklo_epi8(s, s);
+      ss[1] = _mm512_unpackhi_epi8(s, s);
+      WienerHorizontalTap3Kernel(ss, filter, *wiener_buffer + x);
+      x += 32;
+    } while (x < width);
+    src += src_stride;
+    *wiener_buffer += width;
+  }
+}
+
+inline void WienerHorizontalTap1(const uint8_t* src, const ptrdiff_t src_stride,
+                                 const ptrdiff_t width, const int height,
+                                 int16_t** const wiener_buffer) {
+  for (int y = height; y != 0; --y) {
+    ptrdiff_t x = 0;
+    do {
+      const __m512i s = _mm512_cvtepu8_epi16(LoadUnaligned32(src + x));
+      StoreUnaligned64(*wiener_buffer + x, _mm512_slli_epi16(s, 4));
+      x += 32;
+    } while (x < width);
+    src += src_stride;
+    *wiener_buffer += width;
+  }
+}
+
+inline __m512i WienerVertical7(const __m512i a[2], const __m512i filter[2]) {
+  const __m512i round = _mm512_set1_epi32(1 << (kInterRoundBitsVertical - 1));
+  const __m512i madd0 = _mm512_madd_epi16(a[0], filter[0]);
+  const __m512i madd1 = _mm512_madd_epi16(a[1], filter[1]);
+  const __m512i sum0 = _mm512_add_epi32(round, madd0);
+  const __m512i sum1 = _mm512_add_epi32(sum0, madd1);
+  return _mm512_srai_epi32(sum1, kInterRoundBitsVertical);
+}
+
+inline __m512i WienerVertical5(const __m512i a[2], const __m512i filter[2]) {
+  const __m512i madd0 = _mm512_madd_epi16(a[0], filter[0]);
+  const __m512i madd1 = _mm512_madd_epi16(a[1], filter[1]);
+  const __m512i sum = _mm512_add_epi32(madd0, madd1);
+  return _mm512_srai_epi32(sum, kInterRoundBitsVertical);
+}
+
+inline __m512i WienerVertical3(const __m512i a, const __m512i filter) {
+  const __m512i round = _mm512_set1_epi32(1 << (kInterRoundBitsVertical - 1));
+  const __m512i madd = _mm512_madd_epi16(a, filter);
+  const __m512i sum = _mm512_add_epi32(round, madd);
+  return _mm512_srai_epi32(sum, kInterRoundBitsVertical);
+}
+
+inline __m512i WienerVerticalFilter7(const __m512i a[7],
+                                     const __m512i filter[2]) {
+  __m512i b[2];
+  const __m512i a06 = _mm512_add_epi16(a[0], a[6]);
+  const __m512i a15 = _mm512_add_epi16(a[1], a[5]);
+  const __m512i a24 = _mm512_add_epi16(a[2], a[4]);
+  b[0] = _mm512_unpacklo_epi16(a06, a15);
+  b[1] = _mm512_unpacklo_epi16(a24, a[3]);
+  const __m512i sum0 = WienerVertical7(b, filter);
+  b[0] = _mm512_unpackhi_epi16(a06, a15);
+  b[1] = _mm512_unpackhi_epi16(a24, a[3]);
+  const __m512i sum1 = WienerVertical7(b, filter);
+  return _mm512_packs_epi32(sum0, sum1);
+}
+
+inline __m512i WienerVerticalFilter5(const __m512i a[5],
+                                     const __m512i filter[2]) {
+  const __m512i round = _mm512_set1_epi16(1 << (kInterRoundBitsVertical - 1));
+  __m512i b[2];
+  const __m512i a04 = _mm512_add_epi16(a[0], a[4]);
+  const __m512i a13 = _mm512_add_epi16(a[1], a[3]);
+  b[0] = _mm512_unpacklo_epi16(a04, a13);
+  b[1] = _mm512_unpacklo_epi16(a[2], round);
+  const __m512i sum0 = WienerVertical5(b, filter);
+  b[0] = _mm512_unpackhi_epi16(a04, a13);
+  b[1] = _mm512_unpackhi_epi16(a[2], round);
+  const __m512i sum1 = WienerVertical5(b, filter);
+  return _mm512_packs_epi32(sum0, sum1);
+}
+
+inline __m512i WienerVerticalFilter3(const __m512i a[3], const __m512i filter) {
+  __m512i b;
+  const __m512i a02 = _mm512_add_epi16(a[0], a[2]);
+  b = _mm512_unpacklo_epi16(a02, a[1]);
+  const __m512i sum0 = WienerVertical3(b, filter);
+  b = _mm512_unpackhi_epi16(a02, a[1]);
+  const __m512i sum1 = WienerVertical3(b, filter);
+  return _mm512_packs_epi32(sum0, sum1);
+}
+
+// Saturates the 32 results in |d| to 8 bits and stores them.
+inline void StoreWienerOutput(uint8_t* const dst, const __m512i d) {
+  const __m512i d0 = _mm512_max_epi16(d, _mm512_setzero_si512());
+  StoreUnaligned32(dst, _mm512_cvtusepi16_epi8(d0));
+}
+
+inline void LoadWienerRows(const int16_t* const wiener_buffer,
+                              const ptrdiff_t wiener_stride, const int count,
+                              __m512i* const a) {
+  for (int i = 0; i < count; ++i) {
+    a[i] = LoadUnaligned64(wiener_buffer + i * wiener_stride);
+  }
+}
+
+inline __m512i PackCoefficients(const int16_t c0, const int16_t c1) {
+  return _mm512_set1_epi32(static_cast<int>(
+      (static_cast<uint32_t>(static_cast<uint16_t>(c1)) << 16) |
+      static_cast<uint16_t>(c0)));
+}
+
+inline void WienerVerticalTap7(const int16_t* wiener_buffer,
+                               const ptrdiff_t width, const int height,
+                               const int16_t coefficients[4], uint8_t* dst,
+                               const ptrdiff_t dst_stride) {
+  __m512i filter[2];
+  filter[0] = PackCoefficients(coefficients[0], coefficients[1]);
+  filter[1] = PackCoefficients(coefficients[2], coefficients[3]);
+  for (int y = height >> 1; y > 0; --y) {
+    ptrdiff_t x = 0;
+    do {
+      __m512i a[8];
+      LoadWienerRows(wiener_buffer + x, width, 8, a);
+      StoreWienerOutput(dst + x, WienerVerticalFilter7(a, filter));
+      StoreWienerOutput(dst + dst_stride + x,
+                        WienerVerticalFilter7(a + 1, filter));
+      x += 32;
+    } while (x < width);
+    dst += 2 * dst_stride;
+    wiener_buffer += 2 * width;
+  }
+
+  if ((height & 1) != 0) {
+    ptrdiff_t x = 0;
+    do {
+      __m512i a[7];
+      LoadWienerRows(wiener_buffer + x, width, 7, a);
+      StoreWienerOutput(dst + x, WienerVerticalFilter7(a, filter));
+      x += 32;
+    } while (x < width);
+  }
+}
+
+inline void WienerVerticalTap5(const int16_t* wiener_buffer,
+                               const ptrdiff_t width, const int height,
+                               const int16_t coefficients[3], uint8_t* dst,
+                               const ptrdiff_t dst_stride) {
+  __m512i filter[2];
+  filter[0] = PackCoefficients(coefficients[0], coefficients[1]);
+  filter[1] = PackCoefficients(coefficients[2], 1);
+  for (int y = height >> 1; y > 0; --y) {
+    ptrdiff_t x = 0;
+    do {
+      __m512i a[6];
+      LoadWienerRows(wiener_buffer + x, width, 6, a);
+      StoreWienerOutput(dst + x, WienerVerticalFilter5(a, filter));
+      StoreWienerOutput(dst + dst_stride + x,
+                        WienerVerticalFilter5(a + 1, filter));
+      x += 32;
+    } while (x < width);
+    dst += 2 * dst_stride;
+    wiener_buffer += 2 * width;
+  }
+
+  if ((height & 1) != 0) {
+    ptrdiff_t x = 0;
+    do {
+      __m512i a[5];
+      LoadWienerRows(wiener_buffer + x, width, 5, a);
+      StoreWienerOutput(dst + x, WienerVerticalFilter5(a, filter));
+      x += 32;
+    } while (x < width);
+  }
+}
+
+inline void WienerVerticalTap3(const int16_t* wiener_buffer,
+                               const ptrdiff_t width, const int height,
+                               const int16_t coefficients[2], uint8_t* dst,
+                               const ptrdiff_t dst_stride) {
+  const __m512i filter = PackCoefficients(coefficients[0], coefficients[1]);
+  for (int y = height >> 1; y > 0; --y) {
+    ptrdiff_t x = 0;
+    do {
+      __m512i a[4];
+      LoadWienerRows(wiener_buffer + x, width, 4, a);
+      StoreWienerOutput(dst + x, WienerVerticalFilter3(a, filter));
+      StoreWienerOutput(dst + dst_stride + x,
+                        WienerVerticalFilter3(a + 1, filter));
+      x += 32;
+    } while (x < width);
+    dst += 2 * dst_stride;
+    wiener_buffer += 2 * width;
+  }
+
+  if ((height & 1) != 0) {
+    ptrdiff_t x = 0;
+    do {
+      __m512i a[3];
+      LoadWienerRows(wiener_buffer + x, width, 3, a);
+      StoreWienerOutput(dst + x, WienerVerticalFilter3(a, filter));
+      x += 32;
+    } while (x < width);
+  }
+}
+
+inline void WienerVerticalTap1(const int16_t* wiener_buffer,
+                               const ptrdiff_t width, const int height,
+                               uint8_t* dst, const ptrdiff_t dst_stride) {
+  for (int y = height; y > 0; --y) {
+    ptrdiff_t x = 0;
+    do {
+      const __m512i a = LoadUnaligned64(wiener_buffer + x);
+      StoreWienerOutput(dst + x, RightShiftWithRounding_S16(a, 4));
+      x += 32;
+    } while (x < width);
+    dst += dst_stride;
+    wiener_buffer += width;
+  }
+}
+
+void WienerFilter_AVX512(
+    const RestorationUnitInfo& LIBGAV1_RESTRICT restoration_info,
+    const void* LIBGAV1_RESTRICT const source, const ptrdiff_t stride,
+    const void* LIBGAV1_RESTRICT const top_border,
+    const ptrdiff_t top_border_stride,
+    const void* LIBGAV1_RESTRICT const bottom_border,
+    const ptrdiff_t bottom_border_stride, const int width, const int height,
+    RestorationBuffer* LIBGAV1_RESTRICT const restoration_buffer,
+    void* LIBGAV1_RESTRICT const dest) {
+  const int16_t* const number_leading_zero_coefficients =
+      restoration_info.wiener_info.number_leading_zero_coefficients;
+  const int number_rows_to_skip = std::max(
+      static_cast<int>(number_leading_zero_coefficients[WienerInfo::kVertical]),
+      1);
+  const ptrdiff_t wiener_stride = Align(width, 32);
+  int16_t* const wiener_buffer_vertical = restoration_buffer->wiener_buffer;
+  // The values are saturated to 13 bits before storing.
+  int16_t* wiener_buffer_horizontal =
+      wiener_buffer_vertical + number_rows_to_skip * wiener_stride;
+
+  // horizontal filtering.
+  // The masked loads read at most 7 values past each group of 32.
+  const int height_horizontal =
+      height + kWienerFilterTaps - 1 - 2 * number_rows_to_skip;
+  const int height_extra = (height_horizontal - height) >> 1;
+  assert(height_extra <= 2);
+  const auto* const src = static_cast<const uint8_t*>(source);
+  const auto* const top = static_cast<const uint8_t*>(top_border);
+  const auto* const bottom = static_cast<const uint8_t*>(bottom_border);
+  const __m128i c =
+      LoadLo8(restoration_info.wiener_info.filter[WienerInfo::kHorizontal]);
+  // In order to keep the horizontal pass intermediate values within 16 bits we
+  // offset |filter[3]| by 128. The 128 offset will be added back in the loop.
+  __m128i c_horizontal =
+      _mm_sub_epi16(c, _mm_setr_epi16(0, 0, 0, 128, 0, 0, 0, 0));
+  c_horizontal = _mm_packs_epi16(c_horizontal, c_horizontal);
+  const __m512i coefficients_horizontal = _mm512_broadcastd_epi32(c_horizontal);
+  if (number_leading_zero_coefficients[WienerInfo::kHorizontal] == 0) {
+    WienerHorizontalTap7(top + (2 - height_extra) * top_border_stride - 3,
+                         top_border_stride, wiener_stride, height_extra,
+                         coefficients_horizontal, &wiener_buffer_horizontal);
+    WienerHorizontalTap7(src - 3, stride, wiener_stride, height,
+                         coefficients_horizontal, &wiener_buffer_horizontal);
+    WienerHorizontalTap7(bottom - 3, bottom_border_stride, wiener_stride,
+                         height_extra, coefficients_horizontal,
+                         &wiener_buffer_horizontal);
+  } else if (number_leading_zero_coefficients[WienerInfo::kHorizontal] == 1) {
+    WienerHorizontalTap5(top + (2 - height_extra) * top_border_stride - 2,
+                         top_border_stride, wiener_stride, height_extra,
+                         coefficients_horizontal, &wiener_buffer_horizontal);
+    WienerHorizontalTap5(src - 2, stride, wiener_stride, height,
+                         coefficients_horizontal, &wiener_buffer_horizontal);
+    WienerHorizontalTap5(bottom - 2, bottom_border_stride, wiener_stride,
+                         height_extra, coefficients_horizontal,
+                         &wiener_buffer_horizontal);
+  } else if (number_leading_zero_coefficients[WienerInfo::kHorizontal] == 2) {
+    WienerHorizontalTap3(top + (2 - height_extra) * top_border_stride - 1,
+                         top_border_stride, wiener_stride, height_extra,
+                         coefficients_horizontal, &wiener_buffer_horizontal);
+    WienerHorizontalTap3(src - 1, stride, wiener_stride, height,
+                         coefficients_horizontal, &wiener_buffer_horizontal);
+    WienerHorizontalTap3(bottom - 1, bottom_border_stride, wiener_stride,
+                         height_extra, coefficients_horizontal,
+                         &wiener_buffer_horizontal);
+  } else {
+    assert(number_leading_zero_coefficients[WienerInfo::kHorizontal] == 3);
+    WienerHorizontalTap1(top + (2 - height_extra) * top_border_stride,
+                         top_border_stride, wiener_stride, height_extra,
+                         &wiener_buffer_horizontal);
+    WienerHorizontalTap1(src, stride, wiener_stride, height,
+                         &wiener_buffer_horizontal);
+    WienerHorizontalTap1(bottom, bottom_border_stride, wiener_stride,
+                         height_extra, &wiener_buffer_horizontal);
+  }
+
+  // vertical filtering.
+  // Over-writes up to 31 values.
+  const int16_t* const filter_vertical =
+      restoration_info.wiener_info.filter[WienerInfo::kVertical];
+  auto* dst = static_cast<uint8_t*>(dest);
+  if (number_leading_zero_coefficients[WienerInfo::kVertical] == 0) {
+    // Because the top row of |source| is a duplicate of the second row, and the
+    // bottom row of |source| is a duplicate of its above row, we can duplicate
+    // the top and bottom row of |wiener_buffer| accordingly.
+    memcpy(wiener_buffer_horizontal, wiener_buffer_horizontal - wiener_stride,
+           sizeof(*wiener_buffer_horizontal) * wiener_stride);
+    memcpy(restoration_buffer->wiener_buffer,
+           restoration_buffer->wiener_buffer + wiener_stride,
+           sizeof(*restoration_buffer->wiener_buffer) * wiener_stride);
+    WienerVerticalTap7(wiener_buffer_vertical, wiener_stride, height,
+                       filter_vertical, dst, stride);
+  } else if (number_leading_zero_coefficients[WienerInfo::kVertical] == 1) {
+    WienerVerticalTap5(wiener_buffer_vertical + wiener_stride, wiener_stride,
+                       height, filter_vertical + 1, dst, stride);
+  } else if (number_leading_zero_coefficients[WienerInfo::kVertical] == 2) {
+    WienerVerticalTap3(wiener_buffer_vertical + 2 * wiener_stride,
+                       wiener_stride, height, filter_vertical + 2, dst, stride);
+  } else {
+    assert(number_leading_zero_coefficients[WienerInfo::kVertical] == 3);
+    WienerVerticalTap1(wiener_buffer_vertical + 3 * wiener_stride,
+                       wiener_stride, height, dst, stride);
+  }
+}
+
+void Init8bpp() {
+  Dsp* const dsp = dsp_internal::GetWritableDspTable(kBitdepth8);
+  assert(dsp != nullptr);
+  static_cast<void>(dsp);
+#if DSP_ENABLED_8BPP_AVX512(WienerFilter)
+  dsp->loop_restorations[0] = WienerFilter_AVX512;
+#endif
+}
+
+}  // namespace
+}  // namespace low_bitdepth
+
+void LoopRestorationInit_AVX512() { low_bitdepth::Init8bpp(); }
+
+}  // namespace dsp
+}  // namespace libgav1
+
+#else   // !LIBGAV1_TARGETING_AVX512
+namespace libgav1 {
+namespace dsp {
+
+void LoopRestorationInit_AVX512() {}
+
+}  // namespace dsp
+}  // namespace libgav1
+#endif  // LIBGAV1_TARGETING_AVX512
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2021 The libgav1 Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LIBGAV1_SRC_DSP_X86_LOOP_RESTORATION_AVX512_H_
+#define LIBGAV1_SRC_DSP_X86_LOOP_RESTORATION_AVX512_H_
+
+#include "src/dsp/dsp.h"
+#include "src/utils/cpu.h"
+
+namespace libgav1 {
+namespace dsp {
+
+// Replaces the 8-bit Wiener entry of Dsp::loop_restorations with an AVX-512
+// version where the AVX2 version is enabled, see DSP_ENABLED_8BPP_AVX512. Must
+// be called after LoopRestorationInit_AVX2(). This function is not
+// thread-safe.
+void LoopRestorationInit_AVX512();
+
+}  // namespace dsp
+}  // namespace libgav1
+
+#endif  // LIBGAV1_SRC_DSP_X86_LOOP_RESTORATION_AVX512_H_
@@ -0,0 +1,190 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the 8bpp AVX-512 Wiener filter (loop_restoration_avx512.cc) with
+// the C one on random and extreme pixels, for the unit sizes PostFilter passes
+// and random filter coefficients, including those with leading zero taps. The
+// self-guided filter has no AVX-512 version.
+//
+// The AVX-512 function is reached through its Init function, so this file is
+// built without SIMD flags and the tests are skipped on CPUs without AVX-512.
+
+#include "src/dsp/loop_restoration.h"
+
+#include "gtest/gtest.h"
+#include "src/utils/cpu.h"
+
+#if LIBGAV1_ENABLE_AVX512
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "src/dsp/common.h"
+#include "src/dsp/dsp.h"
+#include "src/dsp/x86/loop_restoration_avx2.h"
+#include "src/dsp/x86/loop_restoration_avx512.h"
+#include "src/utils/constants.h"
+#include "src/utils/memory.h"
+
+namespace libgav1 {
+namespace dsp {
+namespace {
+
+// The same count as in loop_restoration_info.cc.
+int CountLeadingZeroCoefficients(const int16_t* const filter) {
+  int number_zero_coefficients = 0;
+  if (filter[0] == 0) {
+    number_zero_coefficients++;
+    if (filter[1] == 0) {
+      number_zero_coefficients++;
+      if (filter[2] == 0) {
+        number_zero_coefficients++;
+      }
+    }
+  }
+  return number_zero_coefficients;
+}
+
+class LoopRestorationAvx512Test : public testing::Test {
+ protected:
+  // Room around the unit for the filter taps, the borders PostFilter keeps
+  // above and below it and SIMD loads that read past the end of a row.
+  static constexpr int kBorder = 64;
+  static constexpr int kStride = kRestorationUnitWidth + 2 * kBorder;
+  static constexpr int kRows = kRestorationUnitHeight + 2 * kBorder;
+  static constexpr int kPixelMax = (1 << kBitdepth8) - 1;
+
+  void SetUp() override {
+    if ((GetCpuInfo() & kAVX512) == 0) {
+      GTEST_SKIP() << "AVX-512 is not supported by this CPU.";
+    }
+    DspInit();
+    // loop_restoration.cc is built without SIMD flags, so
+    // LoopRestorationInit_C() installs every C function.
+    // LoopRestorationInit_AVX512() must follow LoopRestorationInit_AVX2().
+    LoopRestorationInit_C();
+    c_wiener_ = GetDspTable(kBitdepth8)->loop_restorations[0];
+    LoopRestorationInit_AVX2();
+    avx2_wiener_ = GetDspTable(kBitdepth8)->loop_restorations[0];
+    LoopRestorationInit_AVX512();
+    avx512_wiener_ = GetDspTable(kBitdepth8)->loop_restorations[0];
+  }
+
+  // Pixels are random on even iterations and either 0 or the maximum on odd
+  // ones.
+  void FillSource(int iteration) {
+    std::uniform_int_distribution<int> pixel(0, kPixelMax);
+    std::uniform_int_distribution<int> extreme(0, 1);
+    for (auto& value : source_) {
+      value = static_cast<uint8_t>(
+          ((iteration & 1) == 0) ? pixel(rng_) : extreme(rng_) * kPixelMax);
+    }
+  }
+
+  // Draws the taps as ReadWienerInfo() does. Chroma units have no outer tap,
+  // and one in four passes zeroes the leading taps to reach the shorter
+  // filters.
+  void RandomWienerInfo(bool is_chroma, RestorationUnitInfo* info) {
+    std::uniform_int_distribution<int> zero_taps(0, 3);
+    for (int i = WienerInfo::kVertical; i <= WienerInfo::kHorizontal; ++i) {
+      int16_t* const filter = info->wiener_info.filter[i];
+      int sum = 0;
+      int num_zero_taps = static_cast<int>(is_chroma);
+      if (zero_taps(rng_) == 0) {
+        num_zero_taps = std::max(num_zero_taps, zero_taps(rng_));
+      }
+      for (int j = 0; j < kNumWienerCoefficients; ++j) {
+        std::uniform_int_distribution<int> tap(kWienerTapsMin[j],
+                                               kWienerTapsMax[j]);
+        filter[j] = (j < num_zero_taps) ? 0 : tap(rng_);
+        sum += filter[j];
+      }
+      filter[3] = 128 - 2 * sum;
+      info->wiener_info.number_leading_zero_coefficients[i] =
+          CountLeadingZeroCoefficients(filter);
+    }
+  }
+
+  LoopRestorationFunc c_wiener_;
+  LoopRestorationFunc avx2_wiener_;
+  LoopRestorationFunc avx512_wiener_;
+  std::vector<uint8_t> source_ = std::vector<uint8_t>(kStride * kRows);
+  std::mt19937 rng_{kBitdepth8};
+};
+
+// Unit widths up to kRestorationUnitWidth, including the partial units at the
+// right edge of a plane, and stripe heights up to kRestorationUnitHeight,
+// including the first stripe of 56 rows and the last ones of a plane.
+constexpr int kWidths[] = {4, 9, 16, 31, 32, 33, 64, 100, 128, 195, 256};
+constexpr int kHeights[] = {1, 4, 7, 28, 32, 56, 64};
+
+TEST_F(LoopRestorationAvx512Test, WienerFilter8bpp) {
+  ASSERT_NE(avx512_wiener_, avx2_wiener_)
+      << "The AVX-512 Wiener filter was not installed.";
+  RestorationUnitInfo info = {};
+  info.type = kLoopRestorationTypeWiener;
+  const uint8_t* const src = source_.data() + kBorder * kStride + kBorder;
+  AlignedUniquePtr<RestorationBuffer> c_buffer =
+      MakeAlignedUniquePtr<RestorationBuffer>(kMaxAlignment, 1);
+  AlignedUniquePtr<RestorationBuffer> simd_buffer =
+      MakeAlignedUniquePtr<RestorationBuffer>(kMaxAlignment, 1);
+  ASSERT_NE(c_buffer, nullptr);
+  ASSERT_NE(simd_buffer, nullptr);
+  std::vector<uint8_t> c_dest(kStride * kRows);
+  std::vector<uint8_t> simd_dest(kStride * kRows);
+  uint8_t* const c_dst = c_dest.data() + kBorder * kStride + kBorder;
+  uint8_t* const simd_dst = simd_dest.data() + kBorder * kStride + kBorder;
+  for (const int width : kWidths) {
+    for (const int height : kHeights) {
+      // The borders are the rows above and below the unit, as when
+      // PostFilter does not restore in place.
+      const uint8_t* const top_border =
+          src - kRestorationVerticalBorder * kStride;
+      const uint8_t* const bottom_border = src + height * kStride;
+      for (int iteration = 0; iteration < 8; ++iteration) {
+        FillSource(iteration);
+        RandomWienerInfo(/*is_chroma=*/(iteration & 2) != 0, &info);
+        c_wiener_(info, src, kStride, top_border, kStride, bottom_border,
+                  kStride, width, height, c_buffer.get(), c_dst);
+        avx512_wiener_(info, src, kStride, top_border, kStride, bottom_border,
+                       kStride, width, height, simd_buffer.get(), simd_dst);
+        for (int y = 0; y < height; ++y) {
+          const uint8_t* const c_row = c_dst + y * kStride;
+          const uint8_t* const simd_row = simd_dst + y * kStride;
+          ASSERT_TRUE(std::equal(c_row, c_row + width, simd_row))
+              << width << "x" << height << ", row " << y << ", iteration "
+              << iteration << ", zero taps "
+              << info.wiener_info.number_leading_zero_coefficients[0] << "/"
+              << info.wiener_info.number_leading_zero_coefficients[1];
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+}  // namespace dsp
+}  // namespace libgav1
+
+#else  // !LIBGAV1_ENABLE_AVX512
+
+TEST(LoopRestorationAvx512Test, X86) {
+  GTEST_SKIP() << "Build this module for x86(-64) to enable the tests.";
+}
+
+#endif  // LIBGAV1_ENABLE_AVX512
@@ -0,0 +1,191 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the SSE4.1 warp and compound warp (warp_sse4.cc) with the C ones at
+// each bitdepth, on random and extreme pixels, for random valid warp models
+// that reach inside and past the edges of the reference plane, with and
+// without chroma subsampling.
+//
+// The SIMD functions are reached through their Init functions, so this file
+// is built without SIMD flags and each tier is skipped on CPUs without it.
+
+#include "src/dsp/warp.h"
+
+#include "gtest/gtest.h"
+#include "src/utils/cpu.h"
+
+#if LIBGAV1_ENABLE_SSE4_1
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "src/dsp/dsp.h"
+#include "src/dsp/x86/warp_sse4.h"
+#include "src/utils/constants.h"
+#include "src/utils/types.h"
+#include "src/warp_prediction.h"
+
+namespace libgav1 {
+namespace dsp {
+namespace {
+
+struct WarpTier {
+  const char* name;
+  CpuFeatures feature;
+  void (*init)();
+};
+
+const WarpTier kWarpTiers[] = {{"SSE4_1", kSSE4_1, WarpInit_SSE4_1}};
+
+class WarpTest : public testing::TestWithParam<WarpTier> {
+ protected:
+  // The luma plane of the reference frame, placed inside a border for SIMD
+  // loads that read past its edges.
+  static constexpr int kPlaneSize = 64;
+  static constexpr int kBorder = 32;
+  static constexpr int kStride = kPlaneSize + 2 * kBorder;
+  static constexpr int kMaxBlockSize = 64;
+
+  void SetUp() override {
+    if ((GetCpuInfo() & GetParam().feature) == 0) {
+      GTEST_SKIP() << GetParam().name << " is not supported by this CPU.";
+    }
+    DspInit();
+  }
+
+  // Draws a model whose affine part stays close to the identity, with a
+  // translation of up to 32 pixels, until SetupShear() accepts it.
+  void RandomWarpParams(GlobalMotion* warp_params) {
+    std::uniform_int_distribution<int> translation(-(1 << 21), 1 << 21);
+    std::uniform_int_distribution<int> shear(-(1 << 13), 1 << 13);
+    do {
+      warp_params->params[0] = translation(rng_);
+      warp_params->params[1] = translation(rng_);
+      warp_params->params[2] = (1 << kWarpedModelPrecisionBits) + shear(rng_);
+      warp_params->params[3] = shear(rng_);
+      warp_params->params[4] = shear(rng_);
+      warp_params->params[5] = (1 << kWarpedModelPrecisionBits) + shear(rng_);
+    } while (!SetupShear(warp_params));
+  }
+
+  template <int bitdepth, typename Pixel>
+  void TestWarp(bool is_compound);
+
+  std::mt19937 rng_{kPlaneSize};
+};
+
+template <int bitdepth, typename Pixel>
+void WarpTest::TestWarp(bool is_compound) {
+  // warp.cc is built without SIMD flags, so WarpInit_C() installs every C
+  // function. The tier then replaces the ones it has.
+  WarpInit_C();
+  const Dsp* const dsp = GetDspTable(bitdepth);
+  const WarpFunc c_warp = is_compound ? dsp->warp_compound : dsp->warp;
+  GetParam().init();
+  const WarpFunc simd_warp = is_compound ? dsp->warp_compound : dsp->warp;
+  if (simd_warp == c_warp) {
+    GTEST_SKIP() << "No " << GetParam().name
+                 << (is_compound ? " compound" : "") << " warp at " << bitdepth
+                 << "bpp.";
+  }
+  // Compound predictions are uint16_t with a stride of the block width. The
+  // others are Pixels with a stride in bytes.
+  constexpr int kPixelMax = (1 << bitdepth) - 1;
+  std::vector<Pixel> source(kStride * kStride);
+  std::vector<uint16_t> c_dest(kMaxBlockSize * kMaxBlockSize);
+  std::vector<uint16_t> simd_dest(kMaxBlockSize * kMaxBlockSize);
+  std::uniform_int_distribution<int> pixel(0, kPixelMax);
+  std::uniform_int_distribution<int> extreme(0, 1);
+  const Pixel* const plane = source.data() + kBorder * kStride + kBorder;
+  GlobalMotion warp_params = {};
+  for (int subsampling = 0; subsampling < 2; ++subsampling) {
+    const int plane_size = kPlaneSize >> subsampling;
+    std::uniform_int_distribution<int> block_start(0, plane_size - 8);
+    for (const int block_width : {8, 16, 32, 64}) {
+      for (const int block_height : {8, 16, 32, 64}) {
+        for (int iteration = 0; iteration < 16; ++iteration) {
+          for (auto& value : source) {
+            value = static_cast<Pixel>(((iteration & 1) == 0)
+                                           ? pixel(rng_)
+                                           : extreme(rng_) * kPixelMax);
+          }
+          RandomWarpParams(&warp_params);
+          // Blocks are 8x8 aligned in the plane being predicted.
+          const int block_start_x = block_start(rng_) & ~7;
+          const int block_start_y = block_start(rng_) & ~7;
+          const ptrdiff_t dest_stride =
+              is_compound ? block_width : kMaxBlockSize * sizeof(Pixel);
+          std::fill(c_dest.begin(), c_dest.end(), 0);
+          std::fill(simd_dest.begin(), simd_dest.end(), 0);
+          for (const WarpFunc warp : {c_warp, simd_warp}) {
+            warp(plane, kStride * sizeof(Pixel), plane_size, plane_size,
+                 warp_params.params, subsampling, subsampling, block_start_x,
+                 block_start_y, block_width, block_height, warp_params.alpha,
+                 warp_params.beta, warp_params.gamma, warp_params.delta,
+                 (warp == c_warp) ? c_dest.data() : simd_dest.data(),
+                 dest_stride);
+          }
+          const auto* const c_bytes =
+              reinterpret_cast<const uint8_t*>(c_dest.data());
+          const auto* const simd_bytes =
+              reinterpret_cast<const uint8_t*>(simd_dest.data());
+          const size_t element_size =
+              is_compound ? sizeof(uint16_t) : sizeof(Pixel);
+          const ptrdiff_t row_bytes =
+              is_compound ? block_width * sizeof(uint16_t) : dest_stride;
+          for (int y = 0; y < block_height; ++y) {
+            ASSERT_TRUE(std::equal(c_bytes + y * row_bytes,
+                                   c_bytes + y * row_bytes +
+                                       block_width * element_size,
+                                   simd_bytes + y * row_bytes))
+                << bitdepth << "bpp" << (is_compound ? " compound " : " ")
+                << block_width << "x" << block_height << " at "
+                << block_start_x << "," << block_start_y << ", subsampling "
+                << subsampling << ", row " << y << ", iteration "
+                << iteration;
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_P(WarpTest, Warp8bpp) { TestWarp<kBitdepth8, uint8_t>(false); }
+TEST_P(WarpTest, WarpCompound8bpp) { TestWarp<kBitdepth8, uint8_t>(true); }
+
+#if LIBGAV1_MAX_BITDEPTH >= 10
+TEST_P(WarpTest, Warp10bpp) { TestWarp<kBitdepth10, uint16_t>(false); }
+TEST_P(WarpTest, WarpCompound10bpp) { TestWarp<kBitdepth10, uint16_t>(true); }
+#endif  // LIBGAV1_MAX_BITDEPTH >= 10
+
+INSTANTIATE_TEST_SUITE_P(X86, WarpTest, testing::ValuesIn(kWarpTiers),
+                         [](const testing::TestParamInfo<WarpTier>& info) {
+                           return std::string(info.param.name);
+                         });
+
+}  // namespace
+}  // namespace dsp
+}  // namespace libgav1
+
+#else  // !LIBGAV1_ENABLE_SSE4_1
+
+TEST(WarpTest, X86) {
+  GTEST_SKIP() << "Build this module for x86(-64) to enable the tests.";
+}
+
+#endif  // LIBGAV1_ENABLE_SSE4_1
@@ -19,6 +19,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <mutex>  // NOLINT (unapproved c++11 header)
 #include <new>
 
 #include "src/dsp/common.h"
@@ -257,14 +258,36 @@ inline void CopyImagePlane(const uint8_t* source_plane, ptrdiff_t source_stride,
   } while (++y < height);
 }
 
+// Returns true if the scaling lookup tables generated for |a| and |b| are the
+// same. The comparison is conservative: it also compares points that are not
+// used.
+bool ScalingLutsAreEqual(const FilmGrainParams& a, const FilmGrainParams& b) {
+  return a.chroma_scaling_from_luma == b.chroma_scaling_from_luma &&
+         a.num_y_points == b.num_y_points &&
+         a.num_u_points == b.num_u_points &&
+         a.num_v_points == b.num_v_points &&
+         memcmp(a.point_y_value, b.point_y_value, sizeof(a.point_y_value)) ==
+             0 &&
+         memcmp(a.point_y_scaling, b.point_y_scaling,
+                sizeof(a.point_y_scaling)) == 0 &&
+         memcmp(a.point_u_value, b.point_u_value, sizeof(a.point_u_value)) ==
+             0 &&
+         memcmp(a.point_u_scaling, b.point_u_scaling,
+                sizeof(a.point_u_scaling)) == 0 &&
+         memcmp(a.point_v_value, b.point_v_value, sizeof(a.point_v_value)) ==
+             0 &&
+         memcmp(a.point_v_scaling, b.point_v_scaling,
+                sizeof(a.point_v_scaling)) == 0;
+}
+
 }  // namespace
 
 template <int bitdepth>
-FilmGrain<bitdepth>::FilmGrain(const FilmGrainParams& params,
-                               bool is_monochrome,
-                               bool color_matrix_is_identity, int subsampling_x,
-                               int subsampling_y, int width, int height,
-                               ThreadPool* thread_pool)
+FilmGrain<bitdepth>::FilmGrain(
+    const FilmGrainParams& params, bool is_monochrome,
+    bool color_matrix_is_identity, int subsampling_x, int subsampling_y,
+    int width, int height, ThreadPool* thread_pool,
+    FilmGrainScalingLutCache<bitdepth>* scaling_lut_cache)
     : params_(params),
       is_monochrome_(is_monochrome),
       color_matrix_is_identity_(color_matrix_is_identity),
@@ -276,46 +299,24 @@ FilmGrain<bitdepth>::FilmGrain(const FilmGrainParams& params,
                                               : kMaxChromaWidth),
       template_uv_height_((subsampling_y != 0) ? kMinChromaHeight
                                                : kMaxChromaHeight),
-      thread_pool_(thread_pool) {}
+      thread_pool_(thread_pool),
+      scaling_lut_cache_(scaling_lut_cache) {}
 
 template <int bitdepth>
 bool FilmGrain<bitdepth>::Init() {
-  // Section 7.18.3.3. Generate grain process.
-  const dsp::Dsp& dsp = *dsp::GetDspTable(bitdepth);
   // If params_.num_y_points is 0, luma_grain_ will never be read, so we don't
   // need to generate it.
   const bool use_luma = params_.num_y_points > 0;
-  if (use_luma) {
-    GenerateLumaGrain(params_, luma_grain_);
-    // If params_.auto_regression_coeff_lag is 0, the filter is the identity
-    // filter and therefore can be skipped.
-    if (params_.auto_regression_coeff_lag > 0) {
-      dsp.film_grain
-          .luma_auto_regression[params_.auto_regression_coeff_lag - 1](
-              params_, luma_grain_);
-    }
-  } else {
+  if (!use_luma) {
     // Have AddressSanitizer warn if luma_grain_ is used.
     ASAN_POISON_MEMORY_REGION(luma_grain_, sizeof(luma_grain_));
   }
-  if (!is_monochrome_) {
-    GenerateChromaGrains(params_, template_uv_width_, template_uv_height_,
-                         u_grain_, v_grain_);
-    if (params_.auto_regression_coeff_lag > 0 || use_luma) {
-      dsp.film_grain.chroma_auto_regression[static_cast<int>(
-          use_luma)][params_.auto_regression_coeff_lag](
-          params_, luma_grain_, subsampling_x_, subsampling_y_, u_grain_,
-          v_grain_);
-    }
-  }
-
-  // Section 7.18.3.4. Scaling lookup initialization process.
 
-  // Initialize scaling_lut_y_. If params_.num_y_points > 0, scaling_lut_y_
-  // is used for the Y plane. If params_.chroma_scaling_from_luma is true,
-  // scaling_lut_u_ and scaling_lut_v_ are the same as scaling_lut_y_ and are
-  // set up as aliases. So we need to initialize scaling_lut_y_ under these
-  // two conditions.
+  // Set up the scaling lookup tables. If params_.num_y_points > 0,
+  // scaling_lut_y_ is used for the Y plane. If params_.chroma_scaling_from_luma
+  // is true, scaling_lut_u_ and scaling_lut_v_ are the same as scaling_lut_y_
+  // and are set up as aliases. So we need to initialize scaling_lut_y_ under
+  // these two conditions.
   //
   // Note: Although it does not seem to make sense, there are test vectors
   // with chroma_scaling_from_luma=true and params_.num_y_points=0.
@@ -323,11 +324,9 @@ bool FilmGrain<bitdepth>::Init() {
   // Quiet film grain / md5 msan warnings.
   memset(scaling_lut_y_, 0, sizeof(scaling_lut_y_));
 #endif
-  if (use_luma || params_.chroma_scaling_from_luma) {
-    dsp.film_grain.initialize_scaling_lut(
-        params_.num_y_points, params_.point_y_value, params_.point_y_scaling,
-        scaling_lut_y_, kScalingLutLength);
-  } else {
+  const bool use_scaling_lut_y =
+      use_luma || params_.chroma_scaling_from_luma;
+  if (!use_scaling_lut_y) {
     ASAN_POISON_MEMORY_REGION(scaling_lut_y_, sizeof(scaling_lut_y_));
   }
   if (!is_monochrome_) {
@@ -348,19 +347,60 @@ bool FilmGrain<bitdepth>::Init() {
 #endif
       if (params_.num_u_points > 0) {
         scaling_lut_u_ = buffer;
-        dsp.film_grain.initialize_scaling_lut(
-            params_.num_u_points, params_.point_u_value,
-            params_.point_u_scaling, scaling_lut_u_, kScalingLutLength);
         buffer += kScalingLutLength;
       }
       if (params_.num_v_points > 0) {
         scaling_lut_v_ = buffer;
-        dsp.film_grain.initialize_scaling_lut(
-            params_.num_v_points, params_.point_v_value,
-            params_.point_v_scaling, scaling_lut_v_, kScalingLutLength);
       }
     }
   }
+
+  // Section 7.18.3.3. Generate grain process.
+  const dsp::Dsp& dsp = *dsp::GetDspTable(bitdepth);
+  if (use_luma) {
+    GenerateLumaGrain(params_, luma_grain_);
+    // If params_.auto_regression_coeff_lag is 0, the filter is the identity
+    // filter and therefore can be skipped.
+    if (params_.auto_regression_coeff_lag > 0) {
+      dsp.film_grain
+          .luma_auto_regression[params_.auto_regression_coeff_lag - 1](
+              params_, luma_grain_);
+    }
+  }
+  if (!is_monochrome_) {
+    GenerateChromaGrains(params_, template_uv_width_, template_uv_height_,
+                         u_grain_, v_grain_);
+    if (params_.auto_regression_coeff_lag > 0 || use_luma) {
+      dsp.film_grain.chroma_auto_regression[static_cast<int>(
+          use_luma)][params_.auto_regression_coeff_lag](
+          params_, luma_grain_, subsampling_x_, subsampling_y_, u_grain_,
+          v_grain_);
+    }
+  }
+
+  // Section 7.18.3.4. Scaling lookup initialization process.
+  if (scaling_lut_cache_ != nullptr && scaling_lut_cache_->Load(this)) {
+    return true;
+  }
+  if (use_scaling_lut_y) {
+    dsp.film_grain.initialize_scaling_lut(
+        params_.num_y_points, params_.point_y_value, params_.point_y_scaling,
+        scaling_lut_y_, kScalingLutLength);
+  }
+  if (!is_monochrome_ && !params_.chroma_scaling_from_luma) {
+    if (params_.num_u_points > 0) {
+      dsp.film_grain.initialize_scaling_lut(
+          params_.num_u_points, params_.point_u_value, params_.point_u_scaling,
+          scaling_lut_u_, kScalingLutLength);
+    }
+    if (params_.num_v_points > 0) {
+      dsp.film_grain.initialize_scaling_lut(
+          params_.num_v_points, params_.point_v_value, params_.point_v_scaling,
+          scaling_lut_v_, kScalingLutLength);
+    }
+  }
+
+  if (scaling_lut_cache_ != nullptr) scaling_lut_cache_->Store(this);
   return true;
 }
 
@@ -766,7 +806,7 @@ bool FilmGrain<bitdepth>::AddNoise(
           source_plane_y, source_stride_y, source_plane_u, source_plane_v,
           source_stride_uv, dest_plane_u, dest_plane_v, dest_stride_uv);
 
-      pending_workers.Wait();
+      pending_workers.Wait(thread_pool_);
     } else {
       // Single threaded.
       if (params_.num_u_points > 0 || params_.chroma_scaling_from_luma) {
@@ -804,7 +844,7 @@ bool FilmGrain<bitdepth>::AddNoise(
       BlendNoiseLumaWorker(dsp, &job_counter, min_value, max_luma,
                            source_plane_y, source_stride_y, dest_plane_y,
                            dest_stride_y);
-      pending_workers.Wait();
+      pending_workers.Wait(thread_pool_);
     } else {
       dsp.film_grain.blend_noise_luma(
           noise_image_, min_value, max_luma, params_.chroma_scaling, width_,
@@ -819,10 +859,85 @@ bool FilmGrain<bitdepth>::AddNoise(
   return true;
 }
 
+template <int bitdepth>
+bool FilmGrainScalingLutCache<bitdepth>::Load(
+    FilmGrain<bitdepth>* film_grain) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (tables_ == nullptr ||
+      tables_->is_monochrome != film_grain->is_monochrome_ ||
+      !ScalingLutsAreEqual(tables_->params, film_grain->params_)) {
+    ++num_misses_;
+    return false;
+  }
+  ++num_hits_;
+  Copy(/*load=*/true, film_grain, tables_.get());
+  return true;
+}
+
+template <int bitdepth>
+void FilmGrainScalingLutCache<bitdepth>::Store(
+    FilmGrain<bitdepth>* film_grain) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (tables_ == nullptr) {
+    tables_.reset(new (std::nothrow) Tables);
+    // The cache is an optimization, so running out of memory is not an error.
+    if (tables_ == nullptr) return;
+  }
+  tables_->params = film_grain->params_;
+  tables_->is_monochrome = film_grain->is_monochrome_;
+  Copy(/*load=*/false, film_grain, tables_.get());
+}
+
+template <int bitdepth>
+int FilmGrainScalingLutCache<bitdepth>::num_hits() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_hits_;
+}
+
+template <int bitdepth>
+int FilmGrainScalingLutCache<bitdepth>::num_misses() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_misses_;
+}
+
+template <int bitdepth>
+void FilmGrainScalingLutCache<bitdepth>::Copy(bool load,
+                                              FilmGrain<bitdepth>* film_grain,
+                                              Tables* tables) {
+  const auto copy = [load](int16_t* film_grain_lut, int16_t* cached_lut) {
+    if (load) {
+      memcpy(film_grain_lut, cached_lut,
+             sizeof(int16_t) * FilmGrain<bitdepth>::kScalingLutLength);
+    } else {
+      memcpy(cached_lut, film_grain_lut,
+             sizeof(int16_t) * FilmGrain<bitdepth>::kScalingLutLength);
+    }
+  };
+  const FilmGrainParams& params = film_grain->params_;
+  // The same conditions as in FilmGrain::Init(), so that poisoned or
+  // unallocated tables are never touched.
+  if (params.num_y_points > 0 || params.chroma_scaling_from_luma) {
+    copy(film_grain->scaling_lut_y_, tables->scaling_lut_y);
+  }
+  if (film_grain->is_monochrome_ || params.chroma_scaling_from_luma) return;
+  if (params.num_u_points > 0) {
+    copy(film_grain->scaling_lut_u_, tables->scaling_lut_u);
+  }
+  if (params.num_v_points > 0) {
+    copy(film_grain->scaling_lut_v_, tables->scaling_lut_v);
+  }
+}
+
 // Explicit instantiations.
 template class FilmGrain<kBitdepth8>;
+template class FilmGrainScalingLutCache<kBitdepth8>;
 #if LIBGAV1_MAX_BITDEPTH >= 10
 template class FilmGrain<kBitdepth10>;
+template class FilmGrainScalingLutCache<kBitdepth10>;
+#endif
+#if LIBGAV1_MAX_BITDEPTH == 12
+template class FilmGrain<kBitdepth12>;
+template class FilmGrainScalingLutCache<kBitdepth12>;
 #endif
 
 }  // namespace libgav1
@@ -21,12 +21,14 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>  // NOLINT (unapproved c++11 header)
 #include <type_traits>
 
 #include "src/dsp/common.h"
 #include "src/dsp/dsp.h"
 #include "src/dsp/film_grain_common.h"
 #include "src/utils/array_2d.h"
+#include "src/utils/compiler_attributes.h"
 #include "src/utils/constants.h"
 #include "src/utils/cpu.h"
 #include "src/utils/threadpool.h"
@@ -63,6 +65,9 @@ using FilmGrainSynthesisFunc = bool (*)(
     void* dest_plane_u, ptrdiff_t dest_stride_u, void* dest_plane_v,
     ptrdiff_t dest_stride_v);
 
+template <int bitdepth>
+class FilmGrainScalingLutCache;
+
 // Section 7.18.3.5. Add noise synthesis process.
 template <int bitdepth>
 class FilmGrain {
@@ -70,9 +75,13 @@ class FilmGrain {
   using GrainType =
       typename std::conditional<bitdepth == 8, int8_t, int16_t>::type;
 
+  // |scaling_lut_cache| may be nullptr. Otherwise the scaling lookup tables
+  // are taken from it when it holds them for the scaling points of |params|,
+  // and are stored in it when they have to be generated.
   FilmGrain(const FilmGrainParams& params, bool is_monochrome,
             bool color_matrix_is_identity, int subsampling_x, int subsampling_y,
-            int width, int height, ThreadPool* thread_pool);
+            int width, int height, ThreadPool* thread_pool,
+            FilmGrainScalingLutCache<bitdepth>* scaling_lut_cache);
 
   // Note: These static methods are declared public so that the unit tests can
   // call them.
@@ -101,10 +110,14 @@ class FilmGrain {
                 uint8_t* dest_plane_v, ptrdiff_t dest_stride_uv);
 
  private:
+  friend class FilmGrainScalingLutCache<bitdepth>;
+
   using Pixel =
       typename std::conditional<bitdepth == 8, uint8_t, uint16_t>::type;
   static constexpr int kScalingLutLength =
-      (kScalingLookupTableSize + kScalingLookupTablePadding) << (bitdepth - 8);
+      (bitdepth == 10)
+          ? (kScalingLookupTableSize + kScalingLookupTablePadding) << 2
+          : kScalingLookupTableSize + kScalingLookupTablePadding;
 
   bool Init();
 
@@ -188,6 +201,54 @@ class FilmGrain {
 
   Array2D<GrainType> noise_image_[kMaxPlanes];
   ThreadPool* const thread_pool_;
+  FilmGrainScalingLutCache<bitdepth>* const scaling_lut_cache_;
+};
+
+// Holds the scaling lookup tables (Section 7.18.3.4) generated for the last
+// scaling points stored in it. The tables only depend on the scaling points,
+// which streams usually keep from frame to frame. The grain templates are not
+// cached: they depend on |grain_seed|, which encoders such as libaom change
+// for every frame. The storage is allocated on the first Store(). This class
+// is thread-safe.
+template <int bitdepth>
+class FilmGrainScalingLutCache {
+ public:
+  FilmGrainScalingLutCache() = default;
+
+  // Not copyable or movable.
+  FilmGrainScalingLutCache(const FilmGrainScalingLutCache&) = delete;
+  FilmGrainScalingLutCache& operator=(const FilmGrainScalingLutCache&) =
+      delete;
+
+  // Copies the cached tables into |film_grain| and returns true if they were
+  // generated for the scaling points of |film_grain|. Returns false
+  // otherwise.
+  bool Load(FilmGrain<bitdepth>* film_grain);
+
+  // Replaces the cached tables with the ones generated by |film_grain|.
+  void Store(FilmGrain<bitdepth>* film_grain);
+
+  // The number of Load() calls that returned true and false.
+  int num_hits() const;
+  int num_misses() const;
+
+ private:
+  struct Tables {
+    FilmGrainParams params;
+    bool is_monochrome;
+    int16_t scaling_lut_y[FilmGrain<bitdepth>::kScalingLutLength];
+    int16_t scaling_lut_u[FilmGrain<bitdepth>::kScalingLutLength];
+    int16_t scaling_lut_v[FilmGrain<bitdepth>::kScalingLutLength];
+  };
+
+  // Copies the tables that |film_grain| uses from |tables| to |film_grain| if
+  // |load| is true, and in the other direction otherwise.
+  static void Copy(bool load, FilmGrain<bitdepth>* film_grain, Tables* tables);
+
+  mutable std::mutex mutex_;
+  std::unique_ptr<Tables> tables_ LIBGAV1_GUARDED_BY(mutex_);
+  int num_hits_ LIBGAV1_GUARDED_BY(mutex_) = 0;
+  int num_misses_ LIBGAV1_GUARDED_BY(mutex_) = 0;
 };
 
 }  // namespace libgav1
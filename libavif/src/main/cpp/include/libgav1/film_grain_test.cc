@@ -863,6 +863,8 @@ class AutoRegressionTestLuma
 #if LIBGAV1_ENABLE_NEON
       FilmGrainInit_NEON();
 #endif
+    } else if (absl::StartsWith(test_case, "SSE41/")) {
+      FilmGrainInit_SSE4_1();
     }
     luma_auto_regression_func_ = dsp->film_grain.luma_auto_regression[index];
   }
@@ -986,6 +988,12 @@ INSTANTIATE_TEST_SUITE_P(
     C, AutoRegressionTestLuma8bpp,
     testing::Combine(testing::Range(1, 4) /* coeff_lag */,
                      testing::Range(0, 10) /* param_index */));
+#if LIBGAV1_ENABLE_SSE4_1
+INSTANTIATE_TEST_SUITE_P(
+    SSE41, AutoRegressionTestLuma8bpp,
+    testing::Combine(testing::Range(1, 4) /* coeff_lag */,
+                     testing::Range(0, 10) /* param_index */));
+#endif
 #if LIBGAV1_ENABLE_NEON
 INSTANTIATE_TEST_SUITE_P(
     NEON, AutoRegressionTestLuma8bpp,
@@ -998,6 +1006,12 @@ INSTANTIATE_TEST_SUITE_P(
     C, AutoRegressionTestLuma10bpp,
     testing::Combine(testing::Range(1, 4) /* coeff_lag */,
                      testing::Range(0, 10) /* param_index */));
+#if LIBGAV1_ENABLE_SSE4_1
+INSTANTIATE_TEST_SUITE_P(
+    SSE41, AutoRegressionTestLuma10bpp,
+    testing::Combine(testing::Range(1, 4) /* coeff_lag */,
+                     testing::Range(0, 10) /* param_index */));
+#endif
 #if LIBGAV1_ENABLE_NEON
 INSTANTIATE_TEST_SUITE_P(
     NEON, AutoRegressionTestLuma10bpp,
@@ -1054,6 +1068,8 @@ class AutoRegressionTestChroma
 #if LIBGAV1_ENABLE_NEON
       FilmGrainInit_NEON();
 #endif
+    } else if (absl::StartsWith(test_case, "SSE41/")) {
+      FilmGrainInit_SSE4_1();
     }
     chroma_auto_regression_func_ =
         dsp->film_grain.chroma_auto_regression[1][test_param.coeff_lag];
@@ -1257,6 +1273,20 @@ INSTANTIATE_TEST_SUITE_P(NEON, AutoRegressionTestChroma10bpp,
 #endif  // LIBGAV1_MAX_BITDEPTH >= 10
 #endif  // LIBGAV1_ENABLE_NEON
 
+#if LIBGAV1_ENABLE_SSE4_1
+INSTANTIATE_TEST_SUITE_P(SSE41, AutoRegressionTestChroma8bpp,
+                         testing::Combine(testing::Range(0, 4) /* coeff_lag */,
+                                          testing::Range(0,
+                                                         3) /* subsampling */));
+
+#if LIBGAV1_MAX_BITDEPTH >= 10
+INSTANTIATE_TEST_SUITE_P(SSE41, AutoRegressionTestChroma10bpp,
+                         testing::Combine(testing::Range(0, 4) /* coeff_lag */,
+                                          testing::Range(0,
+                                                         3) /* subsampling */));
+#endif  // LIBGAV1_MAX_BITDEPTH >= 10
+#endif  // LIBGAV1_ENABLE_SSE4_1
+
 template <int bitdepth>
 class GrainGenerationTest : public testing::TestWithParam<int> {
  protected:
@@ -1554,6 +1584,8 @@ class ConstructImageTest : public testing::TestWithParam<std::tuple<int, int>> {
 #if LIBGAV1_ENABLE_NEON
       FilmGrainInit_NEON();
 #endif
+    } else if (absl::StartsWith(test_case, "SSE41/")) {
+      FilmGrainInit_SSE4_1();
     }
     construct_noise_image_overlap_func_ =
         dsp->film_grain.construct_noise_image_overlap;
@@ -1736,6 +1768,12 @@ INSTANTIATE_TEST_SUITE_P(C, ConstructImageTest8bpp,
                          testing::Combine(testing::Range(0, 2),
                                           testing::Range(0, 3)));
 
+#if LIBGAV1_ENABLE_SSE4_1
+INSTANTIATE_TEST_SUITE_P(SSE41, ConstructImageTest8bpp,
+                         testing::Combine(testing::Range(0, 2),
+                                          testing::Range(0, 3)));
+#endif  // LIBGAV1_ENABLE_SSE4_1
+
 #if LIBGAV1_ENABLE_NEON
 INSTANTIATE_TEST_SUITE_P(NEON, ConstructImageTest8bpp,
                          testing::Combine(testing::Range(0, 2),
@@ -1746,6 +1784,12 @@ INSTANTIATE_TEST_SUITE_P(NEON, ConstructImageTest8bpp,
 INSTANTIATE_TEST_SUITE_P(C, ConstructImageTest10bpp,
                          testing::Combine(testing::Range(0, 2),
                                           testing::Range(0, 3)));
+
+#if LIBGAV1_ENABLE_SSE4_1
+INSTANTIATE_TEST_SUITE_P(SSE41, ConstructImageTest10bpp,
+                         testing::Combine(testing::Range(0, 2),
+                                          testing::Range(0, 3)));
+#endif  // LIBGAV1_ENABLE_SSE4_1
 #endif  // LIBGAV1_MAX_BITDEPTH >= 10
 
 template <int bitdepth>
@@ -1763,6 +1807,8 @@ class ScalingLookupTableTest : public testing::TestWithParam<int> {
 #if LIBGAV1_ENABLE_NEON
       FilmGrainInit_NEON();
 #endif
+    } else if (absl::StartsWith(test_case, "SSE41/")) {
+      FilmGrainInit_SSE4_1();
     }
     initialize_func_ = dsp->film_grain.initialize_scaling_lut;
   }
@@ -1843,6 +1889,11 @@ TEST_P(ScalingLookupTableTest10bpp, DISABLED_Speed) {
 INSTANTIATE_TEST_SUITE_P(C, ScalingLookupTableTest8bpp,
                          testing::Range(0, kNumFilmGrainTestParams));
 
+#if LIBGAV1_ENABLE_SSE4_1
+INSTANTIATE_TEST_SUITE_P(SSE41, ScalingLookupTableTest8bpp,
+                         testing::Range(0, kNumFilmGrainTestParams));
+#endif
+
 #if LIBGAV1_ENABLE_NEON
 INSTANTIATE_TEST_SUITE_P(NEON, ScalingLookupTableTest8bpp,
                          testing::Range(0, kNumFilmGrainTestParams));
@@ -1852,6 +1903,11 @@ INSTANTIATE_TEST_SUITE_P(NEON, ScalingLookupTableTest8bpp,
 INSTANTIATE_TEST_SUITE_P(C, ScalingLookupTableTest10bpp,
                          testing::Range(0, kNumFilmGrainTestParams));
 
+#if LIBGAV1_ENABLE_SSE4_1
+INSTANTIATE_TEST_SUITE_P(SSE41, ScalingLookupTableTest10bpp,
+                         testing::Range(0, kNumFilmGrainTestParams));
+#endif
+
 #if LIBGAV1_ENABLE_NEON
 INSTANTIATE_TEST_SUITE_P(NEON, ScalingLookupTableTest10bpp,
                          testing::Range(0, kNumFilmGrainTestParams));
@@ -2290,7 +2346,8 @@ void FilmGrainSpeedTest<bitdepth, Pixel>::TestSpeed(const int num_runs) {
       FilmGrain<bitdepth> film_grain(params, /*is_monochrome=*/false,
                                      /*color_matrix_is_identity=*/false,
                                      subsampling_x_, subsampling_y_, width_,
-                                     height_, thread_pool_.get());
+                                     height_, thread_pool_.get(),
+                                     /*scaling_lut_cache=*/nullptr);
       EXPECT_TRUE(film_grain.AddNoise(
           source_plane_y_, y_stride_, source_plane_u_, source_plane_v_,
           uv_stride_, dest_plane_y_, y_stride_, dest_plane_u_, dest_plane_v_,
@@ -19,12 +19,14 @@
 
 #include <array>
 #include <condition_variable>  // NOLINT (unapproved c++11 header)
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <mutex>  // NOLINT (unapproved c++11 header)
 #include <new>
 #include <utility>
 
+#include "src/gav1/memory_usage.h"
 #include "src/loop_restoration_info.h"
 #include "src/residual_buffer_pool.h"
 #include "src/symbol_decoder_context.h"
@@ -84,6 +86,10 @@ struct FrameScratchBuffer : public MaxAlignedAllocable {
   // subsampling). The indices of the rows that are stored are specified in
   // |kLoopRestorationBorderRows|.
   YuvBuffer loop_restoration_border;
+  // The size of this buffer is one more than the number of 64 pixel rows of
+  // the frame. Used by PostFilter::ApplyFilteringThreaded() to track how far
+  // each row has been filtered.
+  DynamicBuffer<int> post_filter_band_progress;
   // The size of this dynamic buffer is |tile_rows|.
   DynamicBuffer<IntraPredictionBuffer> intra_prediction_buffers;
   TileScratchBufferPool tile_scratch_buffer_pool;
@@ -100,6 +106,9 @@ struct FrameScratchBuffer : public MaxAlignedAllocable {
   DynamicBuffer<std::condition_variable> superblock_row_progress_condvar;
   // Used to signal tile decoding failure in the combined multithreading mode.
   bool tile_decoding_failed LIBGAV1_GUARDED_BY(superblock_row_mutex);
+  // The bytes of this buffer last reported to the decoder's MemoryTracker, by
+  // memory class.
+  size_t accounted_bytes[kNumMemoryClasses] = {};
 };
 
 class FrameScratchBufferPool {
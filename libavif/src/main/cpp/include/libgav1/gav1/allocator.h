@@ -0,0 +1,74 @@
+/*
+ * Copyright 2022 The libgav1 Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LIBGAV1_SRC_GAV1_ALLOCATOR_H_
+#define LIBGAV1_SRC_GAV1_ALLOCATOR_H_
+
+// All the declarations in this file are part of the public ABI. This file may
+// be included by both C and C++ files.
+
+#if defined(__cplusplus)
+#include <cstddef>
+#else
+#include <stddef.h>
+#endif  // defined(__cplusplus)
+
+#include "gav1/symbol_visibility.h"
+
+// The callback functions use the C linkage conventions.
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+// This callback is invoked by the decoder to allocate |size| bytes aligned to
+// |alignment| bytes. |alignment| is a power of 2 and may be smaller than
+// sizeof(void*). Returns a null pointer on failure.
+typedef void* (*Libgav1AlignedAllocCallback)(void* callback_private_data,
+                                             size_t alignment, size_t size);
+
+// This callback is invoked by the decoder to free memory returned by the
+// corresponding Libgav1AlignedAllocCallback. |ptr| may be a null pointer.
+typedef void (*Libgav1AlignedFreeCallback)(void* callback_private_data,
+                                           void* ptr);
+
+// Routes the decoder's aligned allocations (frame buffers and per-frame
+// scratch and filter buffers) through |alloc| and |free|. Passing null
+// callbacks restores the system allocator.
+//
+// The allocator is process wide. It must be installed before any decoder is
+// created and must not be changed while any memory allocated through the
+// previous callbacks is still live.
+LIBGAV1_PUBLIC void Libgav1SetAllocator(Libgav1AlignedAllocCallback alloc,
+                                        Libgav1AlignedFreeCallback free,
+                                        void* callback_private_data);
+
+#if defined(__cplusplus)
+}  // extern "C"
+
+namespace libgav1 {
+
+using AlignedAllocCallback = Libgav1AlignedAllocCallback;
+using AlignedFreeCallback = Libgav1AlignedFreeCallback;
+
+inline void SetAllocator(AlignedAllocCallback alloc, AlignedFreeCallback free,
+                         void* callback_private_data) {
+  Libgav1SetAllocator(alloc, free, callback_private_data);
+}
+
+}  // namespace libgav1
+#endif  // defined(__cplusplus)
+
+#endif  // LIBGAV1_SRC_GAV1_ALLOCATOR_H_
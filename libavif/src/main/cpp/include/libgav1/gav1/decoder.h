@@ -29,7 +29,9 @@
 // IWYU pragma: begin_exports
 #include "gav1/decoder_buffer.h"
 #include "gav1/decoder_settings.h"
+#include "gav1/decoder_thread_pool.h"
 #include "gav1/frame_buffer.h"
+#include "gav1/memory_usage.h"
 #include "gav1/status_code.h"
 #include "gav1/symbol_visibility.h"
 #include "gav1/version.h"
@@ -45,6 +47,14 @@ typedef struct Libgav1Decoder Libgav1Decoder;
 LIBGAV1_PUBLIC Libgav1StatusCode Libgav1DecoderCreate(
     const Libgav1DecoderSettings* settings, Libgav1Decoder** decoder_out);
 
+// Like Libgav1DecoderCreate(), with the settings of |extension|, which must
+// have been initialized by Libgav1DecoderSettingsExtensionInitDefault(). A NULL
+// |extension| selects the defaults.
+LIBGAV1_PUBLIC Libgav1StatusCode Libgav1DecoderCreateWithExtension(
+    const Libgav1DecoderSettings* settings,
+    const Libgav1DecoderSettingsExtension* extension,
+    Libgav1Decoder** decoder_out);
+
 LIBGAV1_PUBLIC void Libgav1DecoderDestroy(Libgav1Decoder* decoder);
 
 LIBGAV1_PUBLIC Libgav1StatusCode Libgav1DecoderEnqueueFrame(
@@ -59,6 +69,9 @@ Libgav1DecoderSignalEOS(Libgav1Decoder* decoder);
 
 LIBGAV1_PUBLIC int Libgav1DecoderGetMaxBitdepth(void);
 
+LIBGAV1_PUBLIC Libgav1StatusCode Libgav1DecoderGetMemoryUsage(
+    const Libgav1Decoder* decoder, Libgav1MemoryUsage* usage);
+
 #if defined(__cplusplus)
 }  // extern "C"
 
@@ -117,8 +130,10 @@ class LIBGAV1_PUBLIC Decoder {
   // frame parallel mode (|settings_.frame_parallel| is true and the video
   // stream passes the decoder's heuristics for enabling frame parallel mode),
   // then this call will return kStatusTryAgain if an enqueued frame is not yet
-  // decoded (it is a non blocking call in this case). In all other cases, this
-  // call will block until an enqueued frame has been decoded.
+  // decoded (it is a non blocking call in this case). The same holds if
+  // |settings_.frame_ready| is not nullptr, which then signals when the call
+  // can return a frame. In all other cases, this call will block until an
+  // enqueued frame has been decoded.
   StatusCode DequeueFrame(const DecoderBuffer** out_ptr);
 
   // Signals the end of stream.
@@ -136,6 +151,11 @@ class LIBGAV1_PUBLIC Decoder {
   // Returns the maximum bitdepth that is supported by this decoder.
   static int GetMaxBitdepth();
 
+  // Stores the memory the decoder holds, by class, and its peak since Init()
+  // or the last SignalEOS() in |*usage|. May be called from any thread.
+  // Returns kStatusNotInitialized if Init() has not succeeded.
+  StatusCode GetMemoryUsage(MemoryUsage* usage) const;
+
  private:
   DecoderSettings settings_;
   // The object is initialized if and only if impl_ != nullptr.
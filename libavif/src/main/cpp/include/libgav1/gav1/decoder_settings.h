@@ -18,8 +18,10 @@
 #define LIBGAV1_SRC_GAV1_DECODER_SETTINGS_H_
 
 #if defined(__cplusplus)
+#include <cstddef>
 #include <cstdint>
 #else
+#include <stddef.h>
 #include <stdint.h>
 #endif  // defined(__cplusplus)
 
@@ -40,6 +42,24 @@ extern "C" {
 typedef void (*Libgav1ReleaseInputBufferCallback)(void* callback_private_data,
                                                   void* buffer_private_data);
 
+// This callback is invoked by the decoder when a temporal unit enqueued with
+// |user_private_data| is decoded, or failed to decode, so that the next
+// DequeueFrame() call does not block or return kStatusTryAgain because of it.
+// Temporal units are still dequeued in the order they were enqueued, so
+// DequeueFrame() returns kStatusTryAgain if an earlier temporal unit is not
+// decoded yet; the callback follows for that one too. The callback may be
+// invoked more than once for a temporal unit after a failure.
+//
+// The callback is invoked on a decoder thread, or on the thread that called
+// EnqueueFrame() for a temporal unit that has no frame to decode. It must not
+// call the decoder; it would typically write to an eventfd or post a task to
+// the event loop that dequeues the frames.
+typedef void (*Libgav1FrameReadyCallback)(void* callback_private_data,
+                                          int64_t user_private_data);
+
+// Declared in gav1/decoder_thread_pool.h.
+struct Libgav1DecoderThreadPool;
+
 typedef struct Libgav1DecoderSettings {
   // Number of threads to use when decoding. Must be greater than 0. The library
   // will create at most |threads| new threads. Defaults to 1 (no new threads
@@ -49,10 +69,12 @@ typedef struct Libgav1DecoderSettings {
   // Note that this is just a request and the decoder will decide the number of
   // frames to be decoded in parallel based on the video stream being decoded.
   int frame_parallel;
-  // A boolean. In frame parallel mode, should Libgav1DecoderDequeueFrame wait
-  // until a enqueued frame is available for dequeueing.
+  // A boolean. In frame parallel mode, or if
+  // Libgav1DecoderSettingsExtension::frame_ready is not NULL, should
+  // Libgav1DecoderDequeueFrame wait until a enqueued frame is available for
+  // dequeueing.
   //
-  // If frame_parallel is 0, this setting is ignored.
+  // Otherwise this setting is ignored.
   int blocking_dequeue;
   // Called when the first sequence header or a sequence header with a
   // different frame size (which includes bitdepth, monochrome, subsampling_x,
@@ -88,12 +110,81 @@ typedef struct Libgav1DecoderSettings {
 LIBGAV1_PUBLIC void Libgav1DecoderSettingsInitDefault(
     Libgav1DecoderSettings* settings);
 
+// The settings added after Libgav1DecoderSettings. The layout of
+// Libgav1DecoderSettings is frozen because code built against it, such as a
+// prebuilt libavif, reserves its size and calls
+// Libgav1DecoderSettingsInitDefault() on it. New settings are appended here
+// instead: |size| tells the library how many bytes of the structure the caller
+// knows about, and the fields past it take their defaults.
+typedef struct Libgav1DecoderSettingsExtension {
+  // sizeof(Libgav1DecoderSettingsExtension) as seen by the caller. Set by
+  // Libgav1DecoderSettingsExtensionInitDefault().
+  size_t size;
+  // If not NULL, the decoder runs its multi-threaded work on the threads of
+  // |thread_pool| instead of creating its own, and
+  // Libgav1DecoderSettings::threads is the number of those threads (including
+  // the thread calling the decoder) that it may keep busy at a time.
+  // |thread_pool| must outlive the decoder. Frame parallel decoding is not used
+  // with a shared pool.
+  struct Libgav1DecoderThreadPool* thread_pool;
+  // Output frames downscaled by 2^|preview_shift| in each dimension (rounded
+  // up), for thumbnails. 0 (the default) outputs full size frames. 1 to 3
+  // also skip deblocking, CDEF, loop restoration and film grain (but not
+  // super resolution), so the output is not bit exact and inter frames drift
+  // from their reference frames.
+  int preview_shift;
+  // If not NULL, the decoder decodes asynchronously: EnqueueFrame() hands the
+  // temporal unit to a decoder thread, which calls |frame_ready| when it is
+  // decoded, instead of Libgav1DecoderDequeueFrame decoding it. This lets an
+  // event loop drive many decoders without blocking. In frame parallel mode
+  // the frame threads call it. Otherwise the decoder runs the temporal units
+  // on the threads of |thread_pool| if it is set and
+  // Libgav1DecoderSettings::threads is 1, and on a thread of its own if not.
+  // It is passed Libgav1DecoderSettings::callback_private_data.
+  Libgav1FrameReadyCallback frame_ready;
+  // A boolean. If set, and |thread_pool| is NULL, the worker threads the
+  // decoder creates are pinned to the fastest cluster of CPUs (e.g. the big
+  // cores of a big.LITTLE SoC), then the next fastest, with at most one worker
+  // per CPU; the threads that parse get the fastest CPUs. Ignored where the CPU
+  // topology cannot be read or all the CPUs are alike.
+  int prefer_fast_cores;
+  // If not 0, the bytes the decoder may hold for frame buffers and scratch
+  // memory. To stay within it the decoder runs fewer threads and forgoes frame
+  // parallel mode, and fails with kLibgav1StatusOutOfMemory if it still would
+  // not fit. Transient allocations, such as the film grain noise, are not
+  // counted. 0 (the default) means no limit.
+  size_t memory_limit;
+} Libgav1DecoderSettingsExtension;
+
+LIBGAV1_PUBLIC void Libgav1DecoderSettingsExtensionInitDefault(
+    Libgav1DecoderSettingsExtension* extension);
+
+// This callback is invoked by Libgav1DecoderCreate() and
+// Libgav1DecoderCreateWithExtension() with a copy of the settings and of the
+// extension they were given (a default one if there was none), which the
+// callback may change before the decoder is created. It lets an application
+// adjust the decoders that a library such as libavif creates on its behalf.
+typedef void (*Libgav1DecoderSettingsCallback)(
+    void* callback_private_data, Libgav1DecoderSettings* settings,
+    Libgav1DecoderSettingsExtension* extension);
+
+// Installs |callback| for the Libgav1DecoderCreate() and
+// Libgav1DecoderCreateWithExtension() calls made on the calling thread. Pass a
+// null callback to remove it. Decoders created through the C++ API are not
+// affected.
+LIBGAV1_PUBLIC void Libgav1SetDecoderSettingsCallback(
+    Libgav1DecoderSettingsCallback callback, void* callback_private_data);
+
 #if defined(__cplusplus)
 }  // extern "C"
 
 namespace libgav1 {
 
+// Declared in gav1/decoder_thread_pool.h.
+class DecoderThreadPool;
+
 using ReleaseInputBufferCallback = Libgav1ReleaseInputBufferCallback;
+using FrameReadyCallback = Libgav1FrameReadyCallback;
 
 // Applications must populate this structure before creating a decoder instance.
 struct DecoderSettings {
@@ -105,10 +196,10 @@ struct DecoderSettings {
   // this is just a request and the decoder will decide the number of frames to
   // be decoded in parallel based on the video stream being decoded.
   bool frame_parallel = false;
-  // In frame parallel mode, should DequeueFrame wait until a enqueued frame is
-  // available for dequeueing.
+  // In frame parallel mode, or if |frame_ready| is not nullptr, should
+  // DequeueFrame wait until a enqueued frame is available for dequeueing.
   //
-  // If frame_parallel is false, this setting is ignored.
+  // Otherwise this setting is ignored.
   bool blocking_dequeue = false;
   // Called when the first sequence header or a sequence header with a
   // different frame size (which includes bitdepth, monochrome, subsampling_x,
@@ -139,6 +230,38 @@ struct DecoderSettings {
   //   Bit 4: Film grain synthesis.
   //   All the bits other than the last 5 are ignored.
   uint8_t post_filter_mask = 0x1f;
+  // If not nullptr, the decoder runs its multi-threaded work on the threads of
+  // |thread_pool| instead of creating its own, and |threads| is the number of
+  // those threads (including the thread calling the decoder) that it may keep
+  // busy at a time. |thread_pool| must outlive the decoder. Frame parallel
+  // decoding is not used with a shared pool.
+  DecoderThreadPool* thread_pool = nullptr;
+  // Output frames downscaled by 2^|preview_shift| in each dimension (rounded
+  // up), for thumbnails. 0 (the default) outputs full size frames. 1 to 3
+  // also skip deblocking, CDEF, loop restoration and film grain (but not
+  // super resolution), so the output is not bit exact and inter frames drift
+  // from their reference frames.
+  int preview_shift = 0;
+  // If not nullptr, the decoder decodes asynchronously: EnqueueFrame() hands
+  // the temporal unit to a decoder thread, which calls |frame_ready| when it is
+  // decoded, instead of DequeueFrame() decoding it. This lets an event loop
+  // drive many decoders without blocking. In frame parallel mode the frame
+  // threads call it. Otherwise the decoder runs the temporal units on the
+  // threads of |thread_pool| if it is set and |threads| is 1, and on a thread
+  // of its own if not.
+  FrameReadyCallback frame_ready = nullptr;
+  // If true, and |thread_pool| is nullptr, the worker threads the decoder
+  // creates are pinned to the fastest cluster of CPUs (e.g. the big cores of a
+  // big.LITTLE SoC), then the next fastest, with at most one worker per CPU;
+  // the threads that parse get the fastest CPUs. Ignored where the CPU
+  // topology cannot be read or all the CPUs are alike.
+  bool prefer_fast_cores = false;
+  // If not 0, the bytes the decoder may hold for frame buffers and scratch
+  // memory. To stay within it the decoder runs fewer threads and forgoes frame
+  // parallel mode, and fails with kStatusOutOfMemory if it still would not fit.
+  // Transient allocations, such as the film grain noise, are not counted. 0
+  // (the default) means no limit.
+  size_t memory_limit = 0;
 };
 
 }  // namespace libgav1
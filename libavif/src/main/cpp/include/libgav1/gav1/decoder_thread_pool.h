@@ -0,0 +1,85 @@
+/*
+ * Copyright 2021 The libgav1 Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LIBGAV1_SRC_GAV1_DECODER_THREAD_POOL_H_
+#define LIBGAV1_SRC_GAV1_DECODER_THREAD_POOL_H_
+
+#if defined(__cplusplus)
+#include <memory>
+#endif  // defined(__cplusplus)
+
+#include "gav1/status_code.h"
+#include "gav1/symbol_visibility.h"
+
+// All the declarations in this file are part of the public ABI.
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+// A set of worker threads that any number of decoders in the process can share
+// by pointing the thread_pool field of their Libgav1DecoderSettingsExtension at
+// it.
+struct Libgav1DecoderThreadPool;
+typedef struct Libgav1DecoderThreadPool Libgav1DecoderThreadPool;
+
+LIBGAV1_PUBLIC Libgav1StatusCode Libgav1DecoderThreadPoolCreate(
+    int threads, Libgav1DecoderThreadPool** thread_pool_out);
+
+// All the decoders that use |thread_pool| must have been destroyed before this
+// is called.
+LIBGAV1_PUBLIC void Libgav1DecoderThreadPoolDestroy(
+    Libgav1DecoderThreadPool* thread_pool);
+
+#if defined(__cplusplus)
+}  // extern "C"
+
+namespace libgav1 {
+
+// Forward declarations.
+class DecoderImpl;
+class ThreadPool;
+
+// A set of worker threads shared by several decoders. Each decoder that has
+// DecoderSettings::thread_pool pointing at this object runs its multi-threaded
+// work on these threads instead of creating its own. DecoderSettings::threads
+// then limits how many of the threads one decoder keeps busy at a time (the
+// thread that calls DequeueFrame() counts as one of them), so that the decoders
+// get a fair share of the pool. Frame parallel mode is not used with a shared
+// pool.
+//
+// The pool must outlive all the decoders that use it.
+class LIBGAV1_PUBLIC DecoderThreadPool {
+ public:
+  DecoderThreadPool();
+  ~DecoderThreadPool();
+
+  // Init must be called exactly once per instance. Starts |threads| worker
+  // threads, which must be greater than 0. Returns kStatusOk on success, an
+  // error status otherwise.
+  StatusCode Init(int threads);
+
+ private:
+  friend class DecoderImpl;
+
+  // The object is initialized if and only if impl_ != nullptr.
+  std::unique_ptr<ThreadPool> impl_;
+};
+
+}  // namespace libgav1
+#endif  // defined(__cplusplus)
+
+#endif  // LIBGAV1_SRC_GAV1_DECODER_THREAD_POOL_H_
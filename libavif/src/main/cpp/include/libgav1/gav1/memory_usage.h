@@ -0,0 +1,87 @@
+/*
+ * Copyright 2022 The libgav1 Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LIBGAV1_SRC_GAV1_MEMORY_USAGE_H_
+#define LIBGAV1_SRC_GAV1_MEMORY_USAGE_H_
+
+// All the declarations in this file are part of the public ABI. This file may
+// be included by both C and C++ files.
+
+#if defined(__cplusplus)
+#include <cstddef>
+#else
+#include <stddef.h>
+#endif  // defined(__cplusplus)
+
+typedef enum Libgav1MemoryClass {
+  // Reference and output frames, with their segmentation maps and motion field
+  // references. Frame buffers allocated by libgav1 stay allocated for reuse
+  // while they are not in use; those returned by the get_frame_buffer callback
+  // are counted while the decoder holds them.
+  kLibgav1MemoryClassFrameBuffers,
+  // Frames that film grain is applied into, while the decoder holds them.
+  kLibgav1MemoryClassFilmGrainFrames,
+  // Per frame block parameters, motion field, CDEF and loop restoration
+  // parameters and symbol contexts of the frame scratch buffers.
+  kLibgav1MemoryClassFrameScratch,
+  // Residual buffers that carry the coefficients from parsing to
+  // reconstruction.
+  kLibgav1MemoryClassResiduals,
+  // Prediction scratch buffers of the tile workers and the intra prediction
+  // rows of each tile row.
+  kLibgav1MemoryClassTileScratch,
+  // CDEF and loop restoration borders and SuperRes line buffers.
+  kLibgav1MemoryClassPostFilterBorders,
+  kLibgav1NumMemoryClasses
+} Libgav1MemoryClass;
+
+typedef struct Libgav1MemoryUsage {
+  // The bytes held by the decoder in each Libgav1MemoryClass.
+  size_t bytes[kLibgav1NumMemoryClasses];
+  // The sum of |bytes|.
+  size_t total_bytes;
+  // The highest |total_bytes| since the decoder was created.
+  size_t peak_total_bytes;
+  // Libgav1DecoderSettingsExtension::memory_limit.
+  size_t limit_bytes;
+  // Number of times the decoder chose a strategy that needs less memory to
+  // stay within |limit_bytes|: fewer threads or no frame parallel mode.
+  int num_reductions;
+} Libgav1MemoryUsage;
+
+#if defined(__cplusplus)
+namespace libgav1 {
+
+using MemoryClass = Libgav1MemoryClass;
+using MemoryUsage = Libgav1MemoryUsage;
+
+constexpr MemoryClass kMemoryClassFrameBuffers =
+    kLibgav1MemoryClassFrameBuffers;
+constexpr MemoryClass kMemoryClassFilmGrainFrames =
+    kLibgav1MemoryClassFilmGrainFrames;
+constexpr MemoryClass kMemoryClassFrameScratch =
+    kLibgav1MemoryClassFrameScratch;
+constexpr MemoryClass kMemoryClassResiduals = kLibgav1MemoryClassResiduals;
+constexpr MemoryClass kMemoryClassTileScratch =
+    kLibgav1MemoryClassTileScratch;
+constexpr MemoryClass kMemoryClassPostFilterBorders =
+    kLibgav1MemoryClassPostFilterBorders;
+constexpr int kNumMemoryClasses = kLibgav1NumMemoryClasses;
+
+}  // namespace libgav1
+#endif  // defined(__cplusplus)
+
+#endif  // LIBGAV1_SRC_GAV1_MEMORY_USAGE_H_
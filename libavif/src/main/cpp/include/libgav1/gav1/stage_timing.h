@@ -0,0 +1,90 @@
+/*
+ * Copyright 2022 The libgav1 Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LIBGAV1_SRC_GAV1_STAGE_TIMING_H_
+#define LIBGAV1_SRC_GAV1_STAGE_TIMING_H_
+
+// All the declarations in this file are part of the public ABI. This file may
+// be included by both C and C++ files.
+
+#if defined(__cplusplus)
+#include <cstdint>
+#else
+#include <stdint.h>
+#endif  // defined(__cplusplus)
+
+#include "gav1/symbol_visibility.h"
+
+// The callback functions use the C linkage conventions.
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+typedef enum Libgav1DecodeStage {
+  // OBU parsing, up to and including the tile group headers.
+  kLibgav1DecodeStageParse,
+  // Entropy decoding, prediction and reconstruction of the tiles.
+  kLibgav1DecodeStageTileDecode,
+  kLibgav1DecodeStageDeblock,
+  kLibgav1DecodeStageCdef,
+  kLibgav1DecodeStageSuperRes,
+  // Loop restoration, including the border setup it needs.
+  kLibgav1DecodeStageLoopRestoration,
+  // Border extension of reference frames.
+  kLibgav1DecodeStageBorderExtension,
+  kLibgav1DecodeStageFilmGrain,
+  // Downscaling previews (see DecoderSettings::preview_shift) and copying the
+  // output frame into the DecoderBuffer.
+  kLibgav1DecodeStageOutput,
+  kLibgav1NumDecodeStages
+} Libgav1DecodeStage;
+
+// This callback is invoked on the decoding thread each time the decoder
+// finishes a timed section of |stage|. |wall_time_ns| is the elapsed time and
+// |cpu_time_ns| is the CPU time consumed by the whole process (including the
+// decoder's worker threads) during the section. A stage may be reported many
+// times per frame, e.g., once per superblock row when decoding with a single
+// thread, so the callback should accumulate.
+typedef void (*Libgav1StageTimingCallback)(void* callback_private_data,
+                                           Libgav1DecodeStage stage,
+                                           int64_t wall_time_ns,
+                                           int64_t cpu_time_ns);
+
+// Installs |callback| for decodes running on the calling thread. Pass a null
+// callback to stop timing. Timing has no cost while no callback is installed.
+//
+// Stages are timed on the thread that calls Libgav1DecoderDequeueFrame(), so
+// only decoders that are not in frame parallel mode are covered.
+LIBGAV1_PUBLIC void Libgav1SetStageTimingCallback(
+    Libgav1StageTimingCallback callback, void* callback_private_data);
+
+#if defined(__cplusplus)
+}  // extern "C"
+
+namespace libgav1 {
+
+using DecodeStage = Libgav1DecodeStage;
+using StageTimingCallback = Libgav1StageTimingCallback;
+
+inline void SetStageTimingCallback(StageTimingCallback callback,
+                                   void* callback_private_data) {
+  Libgav1SetStageTimingCallback(callback, callback_private_data);
+}
+
+}  // namespace libgav1
+#endif  // defined(__cplusplus)
+
+#endif  // LIBGAV1_SRC_GAV1_STAGE_TIMING_H_
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2022 The libgav1 Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LIBGAV1_SRC_GAV1_TRACING_H_
+#define LIBGAV1_SRC_GAV1_TRACING_H_
+
+// All the declarations in this file are part of the public ABI. This file may
+// be included by both C and C++ files.
+
+#if defined(__cplusplus)
+#include <cstddef>
+#else
+#include <stddef.h>
+#endif  // defined(__cplusplus)
+
+#include "gav1/symbol_visibility.h"
+
+// Process wide tracing of the decoder threads. While tracing is on, every
+// thread that works on a decode (the calling thread and the thread pool
+// workers, including frame parallel decodes) records the sections of the
+// stages in gav1/stage_timing.h, each tile it decodes and each time it blocks
+// waiting for other threads. The events go to a lock-free ring buffer that
+// keeps the most recent ones, and can be exported in the Chrome trace event
+// format, to be viewed in chrome://tracing or https://ui.perfetto.dev.
+//
+// Tracing costs a single load per section while it is off.
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+// Clears the recorded events and starts tracing into a ring buffer of
+// |max_events| events (at least 1). Returns 0 if the buffer cannot be
+// allocated, in which case tracing stays off. Must not be called while a
+// decode is in progress.
+LIBGAV1_PUBLIC int Libgav1StartTracing(int max_events);
+
+// Stops recording. The recorded events are kept until the next
+// Libgav1StartTracing() call. May be called at any time.
+LIBGAV1_PUBLIC void Libgav1StopTracing(void);
+
+// Writes the recorded events as a Chrome trace event JSON object into
+// |buffer|, which is |size| bytes long, and null terminates it. Like
+// snprintf(), returns the length of the whole trace excluding the terminating
+// null, so a return value of |size| or more means that the trace was
+// truncated. |buffer| may be null if |size| is 0. Must not be called while a
+// decode is in progress.
+LIBGAV1_PUBLIC size_t Libgav1GetTraceJson(char* buffer, size_t size);
+
+#if defined(__cplusplus)
+}  // extern "C"
+
+namespace libgav1 {
+
+inline bool StartTracing(int max_events) {
+  return Libgav1StartTracing(max_events) != 0;
+}
+
+inline void StopTracing() { Libgav1StopTracing(); }
+
+inline size_t GetTraceJson(char* buffer, size_t size) {
+  return Libgav1GetTraceJson(buffer, size);
+}
+
+}  // namespace libgav1
+#endif  // defined(__cplusplus)
+
+#endif  // LIBGAV1_SRC_GAV1_TRACING_H_
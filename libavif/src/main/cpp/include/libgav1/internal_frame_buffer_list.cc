@@ -15,6 +15,7 @@
 #include "src/internal_frame_buffer_list.h"
 
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <new>
@@ -95,9 +96,24 @@ StatusCode InternalFrameBufferList::GetFrameBuffer(
   }
 
   if (buffer->size < min_size) {
-    std::unique_ptr<uint8_t[], MallocDeleter> new_data(
-        static_cast<uint8_t*>(malloc(min_size)));
-    if (new_data == nullptr) return kStatusOutOfMemory;
+    const size_t growth = min_size - buffer->size;
+    if (memory_tracker_ != nullptr &&
+        !memory_tracker_->Reserve(kMemoryClassFrameBuffers, growth)) {
+      return kStatusOutOfMemory;
+    }
+    // Use AlignedAlloc() so that frame buffers, the largest allocations made
+    // while decoding, go through the allocator installed with
+    // Libgav1SetAllocator(). The planes are aligned by
+    // Libgav1SetFrameBuffer(), so no extra alignment is needed here.
+    AlignedUniquePtr<uint8_t> new_data(
+        MakeAlignedUniquePtr<uint8_t>(alignof(std::max_align_t), min_size));
+    if (new_data == nullptr) {
+      if (memory_tracker_ != nullptr) {
+        memory_tracker_->Add(kMemoryClassFrameBuffers,
+                             -static_cast<int64_t>(growth));
+      }
+      return kStatusOutOfMemory;
+    }
     buffer->data = std::move(new_data);
     buffer->size = min_size;
   }
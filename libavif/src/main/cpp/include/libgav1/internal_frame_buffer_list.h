@@ -23,6 +23,7 @@
 
 #include "src/gav1/frame_buffer.h"
 #include "src/utils/memory.h"
+#include "src/utils/memory_tracker.h"
 #include "src/utils/vector.h"
 
 namespace libgav1 {
@@ -66,14 +67,21 @@ class InternalFrameBufferList : public Allocable {
 
   void ReleaseFrameBuffer(void* buffer_private_data);
 
+  // Reports the growth of the buffers to |memory_tracker|, and fails
+  // GetFrameBuffer() when it would exceed its limit.
+  void set_memory_tracker(MemoryTracker* memory_tracker) {
+    memory_tracker_ = memory_tracker;
+  }
+
  private:
   struct Buffer : public Allocable {
-    std::unique_ptr<uint8_t[], MallocDeleter> data;
+    AlignedUniquePtr<uint8_t> data;
     size_t size = 0;
     bool in_use = false;
   };
 
   Vector<std::unique_ptr<Buffer>> buffers_;
+  MemoryTracker* memory_tracker_ = nullptr;
 };
 
 }  // namespace libgav1
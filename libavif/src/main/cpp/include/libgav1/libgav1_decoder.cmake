@@ -73,17 +73,26 @@ list(APPEND libgav1_decoder_sources
             "${libgav1_source}/yuv_buffer.cc"
             "${libgav1_source}/yuv_buffer.h")
 
-list(APPEND libgav1_api_includes "${libgav1_source}/gav1/decoder.h"
+list(APPEND libgav1_api_includes "${libgav1_source}/gav1/allocator.h"
+            "${libgav1_source}/gav1/decoder.h"
             "${libgav1_source}/gav1/decoder_buffer.h"
             "${libgav1_source}/gav1/decoder_settings.h"
+            "${libgav1_source}/gav1/decoder_thread_pool.h"
             "${libgav1_source}/gav1/frame_buffer.h"
+            "${libgav1_source}/gav1/memory_usage.h"
+            "${libgav1_source}/gav1/stage_timing.h"
             "${libgav1_source}/gav1/status_code.h"
             "${libgav1_source}/gav1/symbol_visibility.h"
+            "${libgav1_source}/gav1/tracing.h"
             "${libgav1_source}/gav1/version.h")
 
-list(APPEND libgav1_api_sources "${libgav1_source}/decoder.cc"
+list(APPEND libgav1_api_sources "${libgav1_source}/allocator.cc"
+            "${libgav1_source}/decoder.cc"
             "${libgav1_source}/decoder_settings.cc"
+            "${libgav1_source}/decoder_thread_pool.cc"
+            "${libgav1_source}/stage_timing.cc"
             "${libgav1_source}/status_code.cc"
+            "${libgav1_source}/tracing.cc"
             "${libgav1_source}/version.cc"
             ${libgav1_api_includes})
 
@@ -82,6 +82,10 @@ class LoopRestorationInfo {
   }
   int num_units(Plane plane) const { return num_units_[plane]; }
 
+  size_t allocated_bytes() const {
+    return loop_restoration_info_buffer_.allocated_bytes();
+  }
+
  private:
   // If plane_needs_filtering_[plane] is true, loop_restoration_info_[plane]
   // points to an array of num_units_[plane] elements.
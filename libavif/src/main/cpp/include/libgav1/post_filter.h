@@ -20,9 +20,11 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <condition_variable>  // NOLINT (unapproved c++11 header)
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <mutex>  // NOLINT (unapproved c++11 header)
 #include <type_traits>
 
 #include "src/dsp/common.h"
@@ -33,7 +35,9 @@
 #include "src/utils/array_2d.h"
 #include "src/utils/block_parameters_holder.h"
 #include "src/utils/common.h"
+#include "src/utils/compiler_attributes.h"
 #include "src/utils/constants.h"
+#include "src/utils/dynamic_buffer.h"
 #include "src/utils/memory.h"
 #include "src/utils/threadpool.h"
 #include "src/yuv_buffer.h"
@@ -116,6 +120,10 @@ class PostFilter {
   //                as the input and the output is written into
   //                |loop_restoration_buffer_| (which is just |superres_buffer_|
   //                with a shift to the left).
+  // Unless SuperRes is on, the filters are not run as separate passes over the
+  // whole frame. Instead each job runs all of them on one 64 pixel row of the
+  // frame at a time (see ApplyFilteringWorker()), so that the pixels stay in
+  // the cache between the filters.
   void ApplyFilteringThreaded();
 
   // Does the overall post processing filter for one superblock row starting at
@@ -296,6 +304,23 @@ class PostFilter {
   // thread and returns once all the jobs are completed.
   void RunJobs(WorkerFunction worker);
 
+  // Functions for the fused multi-threaded filtering.
+
+  // Worker function used by ApplyFilteringThreaded() when SuperRes is off.
+  // Each iteration takes the next 64 pixel row (band) of the frame, deblocks
+  // it, saves the CDEF and loop restoration borders, and then applies CDEF and
+  // loop restoration to the band above it. The lag is needed because the
+  // horizontal deblocking of a band changes the last rows of the band above.
+  // |post_filter_band_progress_| orders the work of neighboring bands.
+  void ApplyFilteringWorker(std::atomic<int>* band_atomic);
+  static_assert(std::is_same<decltype(&PostFilter::ApplyFilteringWorker),
+                             WorkerFunction>::value,
+                "");
+  // Blocks until the progress of |band| is at least |progress|. Returns at once
+  // if |band| is negative.
+  void WaitForBandProgress(int band, int progress);
+  void SetBandProgress(int band, int progress);
+
   // Functions for the Deblocking filter.
 
   bool GetHorizontalDeblockFilterEdgeInfo(int row4x4, int column4x4,
@@ -313,6 +338,18 @@ class PostFilter {
                                           BlockParameters* const* bp_ptr,
                                           uint8_t* level_u, uint8_t* level_v,
                                           int* step, int* filter_length) const;
+  // Filter the luma edges of the 4x4 column |column4x4| and the column to its
+  // right (HorizontalDeblockFilterColumnPair) or of the 4x4 row |row4x4| and
+  // the row below it (VerticalDeblockFilterRowPair). Edges at the same position
+  // in both with the same level and filter length are filtered with one
+  // |dsp_.loop_filters_x2| call. |src| points to the first pixel of
+  // |column4x4| or |row4x4| in the superblock row being filtered.
+  void HorizontalDeblockFilterColumnPair(int row4x4_start, int row4x4_end,
+                                         int column4x4, uint8_t* src);
+  void VerticalDeblockFilterRowPair(int row4x4, int column4x4_start,
+                                    int column4x4_end,
+                                    BlockParameters* const* bp_row,
+                                    uint8_t* src);
   void HorizontalDeblockFilter(int row4x4_start, int row4x4_end,
                                int column4x4_start, int column4x4_end);
   void VerticalDeblockFilter(int row4x4_start, int row4x4_end,
@@ -342,8 +379,9 @@ class PostFilter {
   // Functions for the cdef filter.
 
   // Copies the deblocked pixels necessary for use by the multi-threaded cdef
-  // implementation into |cdef_border_|.
-  void SetupCdefBorder(int row4x4);
+  // implementation into |cdef_border_|. Only the rows at indices
+  // [|index_start|, |index_end|) of |kCdefBorderRows| are copied.
+  void SetupCdefBorder(int row4x4, int index_start, int index_end);
   // This function prepares the input source block for cdef filtering. The input
   // source block contains a 12x12 block, with the inner 8x8 as the desired
   // filter region. It pads the block if the 12x12 block includes out of frame
@@ -466,6 +504,9 @@ class PostFilter {
   const bool do_deblock_;
   const bool do_restoration_;
   const bool do_superres_;
+  // True if the frame will be saved as a reference frame. The only frame of a
+  // still picture never is.
+  const bool is_reference_frame_;
   // This stores the deblocking filter levels assuming that the delta is zero.
   // This will be used by all superblocks whose delta is zero (without having to
   // recompute them). The dimensions (in order) are: segment_id, level_index
@@ -517,6 +558,12 @@ class PostFilter {
   YuvBuffer& loop_restoration_border_;
   ThreadPool* const thread_pool_;
 
+  // Used by ApplyFilteringWorker() to wait for the neighboring bands.
+  std::mutex band_mutex_;
+  std::condition_variable band_condvar_;
+  DynamicBuffer<int>& post_filter_band_progress_
+      LIBGAV1_GUARDED_BY(band_mutex_);
+
   // Tracks the progress of the post filters.
   int progress_row_ = -1;
 
@@ -86,7 +86,8 @@ void CopyPixels(const uint8_t* src, int src_stride, uint8_t* dst,
 
 }  // namespace
 
-void PostFilter::SetupCdefBorder(int row4x4) {
+void PostFilter::SetupCdefBorder(int row4x4, int index_start,
+                                 int index_end) {
   assert(row4x4 >= 0);
   assert(DoCdef());
   int plane = kPlaneY;
@@ -99,7 +100,7 @@ void PostFilter::SetupCdefBorder(int row4x4) {
     const int row_width = num_pixels << pixel_size_log2_;
     const int plane_height = SubsampledValue(MultiplyBy4(frame_header_.rows4x4),
                                              subsampling_y_[plane]);
-    for (int i = 0; i < 4; ++i) {
+    for (int i = index_start; i < index_end; ++i) {
       const int row = kCdefBorderRows[subsampling_y_[plane]][i];
       const int absolute_row =
           (MultiplyBy4(row4x4) >> subsampling_y_[plane]) + row;
@@ -295,6 +295,102 @@ void PostFilter::GetVerticalDeblockFilterEdgeInfoUV(
   *filter_length = std::min(*step, step_prev);
 }
 
+void PostFilter::HorizontalDeblockFilterColumnPair(int row4x4_start,
+                                                   int row4x4_end,
+                                                   int column4x4,
+                                                   uint8_t* const src) {
+  const ptrdiff_t src_stride = frame_buffer_.stride(kPlaneY);
+  const int src_step = 4 << pixel_size_log2_;
+  const int height = frame_header_.height;
+  // The two columns are walked together. Each column's edges are still
+  // filtered from top to bottom, and the columns do not share any pixels.
+  int row4x4[2] = {row4x4_start, row4x4_start};
+  while (true) {
+    const int row = std::min(row4x4[0], row4x4[1]);
+    if (row >= row4x4_end || MultiplyBy4(row) >= height) break;
+    bool need_filter[2] = {false, false};
+    uint8_t level[2];
+    int filter_length[2];
+    for (int i = 0; i < 2; ++i) {
+      if (row4x4[i] != row) continue;
+      int row_step;
+      need_filter[i] = GetHorizontalDeblockFilterEdgeInfo(
+          row, column4x4 + i, &level[i], &row_step, &filter_length[i]);
+      row4x4[i] += DivideBy4(row_step);
+    }
+    uint8_t* const src_row =
+        src + MultiplyBy4(row - row4x4_start) * src_stride;
+    if (need_filter[0] && need_filter[1] && level[0] == level[1] &&
+        filter_length[0] == filter_length[1]) {
+      const dsp::LoopFilterSize size = GetLoopFilterSizeY(filter_length[0]);
+      const dsp::LoopFilterFunc filter_x2 =
+          dsp_.loop_filters_x2[size][kLoopFilterTypeHorizontal];
+      if (filter_x2 != nullptr) {
+        filter_x2(src_row, src_stride, outer_thresh_[level[0]],
+                  inner_thresh_[level[0]], HevThresh(level[0]));
+        continue;
+      }
+    }
+    for (int i = 0; i < 2; ++i) {
+      if (!need_filter[i]) continue;
+      assert(level[i] > 0 && level[i] <= kMaxLoopFilterValue);
+      const dsp::LoopFilterSize size = GetLoopFilterSizeY(filter_length[i]);
+      dsp_.loop_filters[size][kLoopFilterTypeHorizontal](
+          src_row + i * src_step, src_stride, outer_thresh_[level[i]],
+          inner_thresh_[level[i]], HevThresh(level[i]));
+    }
+  }
+}
+
+void PostFilter::VerticalDeblockFilterRowPair(int row4x4, int column4x4_start,
+                                              int column4x4_end,
+                                              BlockParameters* const* bp_row,
+                                              uint8_t* const src) {
+  const ptrdiff_t src_stride = frame_buffer_.stride(kPlaneY);
+  const ptrdiff_t row_stride = MultiplyBy4(src_stride);
+  const int bp_stride = block_parameters_.columns4x4();
+  const int width = frame_header_.width;
+  // The two rows are walked together. Each row's edges are still filtered
+  // from left to right, and the rows do not share any pixels.
+  int column4x4[2] = {column4x4_start, column4x4_start};
+  while (true) {
+    const int column = std::min(column4x4[0], column4x4[1]);
+    if (column >= column4x4_end || MultiplyBy4(column) >= width) break;
+    bool need_filter[2] = {false, false};
+    uint8_t level[2];
+    int filter_length[2];
+    for (int i = 0; i < 2; ++i) {
+      if (column4x4[i] != column) continue;
+      int column_step;
+      need_filter[i] = GetVerticalDeblockFilterEdgeInfo(
+          row4x4 + i, column, bp_row + i * bp_stride + column - column4x4_start,
+          &level[i], &column_step, &filter_length[i]);
+      column4x4[i] += DivideBy4(column_step);
+    }
+    uint8_t* const src_column =
+        src + (MultiplyBy4(column - column4x4_start) << pixel_size_log2_);
+    if (need_filter[0] && need_filter[1] && level[0] == level[1] &&
+        filter_length[0] == filter_length[1]) {
+      const dsp::LoopFilterSize size = GetLoopFilterSizeY(filter_length[0]);
+      const dsp::LoopFilterFunc filter_x2 =
+          dsp_.loop_filters_x2[size][kLoopFilterTypeVertical];
+      if (filter_x2 != nullptr) {
+        filter_x2(src_column, src_stride, outer_thresh_[level[0]],
+                  inner_thresh_[level[0]], HevThresh(level[0]));
+        continue;
+      }
+    }
+    for (int i = 0; i < 2; ++i) {
+      if (!need_filter[i]) continue;
+      assert(level[i] > 0 && level[i] <= kMaxLoopFilterValue);
+      const dsp::LoopFilterSize size = GetLoopFilterSizeY(filter_length[i]);
+      dsp_.loop_filters[size][kLoopFilterTypeVertical](
+          src_column + i * row_stride, src_stride, outer_thresh_[level[i]],
+          inner_thresh_[level[i]], HevThresh(level[i]));
+    }
+  }
+}
+
 void PostFilter::HorizontalDeblockFilter(int row4x4_start, int row4x4_end,
                                          int column4x4_start,
                                          int column4x4_end) {
@@ -302,7 +398,7 @@ void PostFilter::HorizontalDeblockFilter(int row4x4_start, int row4x4_end,
   const int width4x4 = column4x4_end - column4x4_start;
   if (height4x4 <= 0 || width4x4 <= 0) return;
 
-  const int column_step = 1;
+  int column_step;
   const int src_step = 4 << pixel_size_log2_;
   const ptrdiff_t src_stride = frame_buffer_.stride(kPlaneY);
   uint8_t* src = GetSourceBuffer(kPlaneY, row4x4_start, column4x4_start);
@@ -312,9 +408,21 @@ void PostFilter::HorizontalDeblockFilter(int row4x4_start, int row4x4_end,
 
   const int width = frame_header_.width;
   const int height = frame_header_.height;
+  // All the sizes are set together, see Dsp::loop_filters_x2.
+  const bool pair_columns =
+      dsp_.loop_filters_x2[dsp::kLoopFilterSize4][kLoopFilterTypeHorizontal] !=
+      nullptr;
   for (int column4x4 = 0;
        column4x4 < width4x4 && MultiplyBy4(column4x4_start + column4x4) < width;
-       column4x4 += column_step, src += src_step) {
+       column4x4 += column_step, src += column_step * src_step) {
+    if (pair_columns && column4x4 + 1 < width4x4 &&
+        MultiplyBy4(column4x4_start + column4x4 + 1) < width) {
+      HorizontalDeblockFilterColumnPair(row4x4_start, row4x4_start + height4x4,
+                                        column4x4_start + column4x4, src);
+      column_step = 2;
+      continue;
+    }
+    column_step = 1;
     uint8_t* src_row = src;
     for (int row4x4 = 0;
          row4x4 < height4x4 && MultiplyBy4(row4x4_start + row4x4) < height;
@@ -398,9 +506,23 @@ void PostFilter::VerticalDeblockFilter(int row4x4_start, int row4x4_end,
   const int column_step_shift = pixel_size_log2_;
   const int width = frame_header_.width;
   const int height = frame_header_.height;
+  // All the sizes are set together, see Dsp::loop_filters_x2.
+  const bool pair_rows =
+      dsp_.loop_filters_x2[dsp::kLoopFilterSize4][kLoopFilterTypeVertical] !=
+      nullptr;
+  int row_step;
   for (int row4x4 = 0;
        row4x4 < height4x4 && MultiplyBy4(row4x4_start + row4x4) < height;
-       ++row4x4, src += row_stride, bp_row_base += bp_stride) {
+       row4x4 += row_step, src += row_step * row_stride,
+           bp_row_base += row_step * bp_stride) {
+    if (pair_rows && row4x4 + 1 < height4x4 &&
+        MultiplyBy4(row4x4_start + row4x4 + 1) < height) {
+      VerticalDeblockFilterRowPair(row4x4_start + row4x4, column4x4_start,
+                                   column4x4_end, bp_row_base, src);
+      row_step = 2;
+      continue;
+    }
+    row_step = 1;
     uint8_t* src_row = src;
     BlockParameters* const* bp = bp_row_base;
     for (int column4x4 = 0; column4x4 < width4x4 &&
@@ -20,6 +20,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <mutex>  // NOLINT (unapproved c++11 header)
 
 #include "src/dsp/constants.h"
 #include "src/dsp/dsp.h"
@@ -29,6 +30,8 @@
 #include "src/utils/compiler_attributes.h"
 #include "src/utils/constants.h"
 #include "src/utils/memory.h"
+#include "src/utils/stage_timer.h"
+#include "src/utils/tracer.h"
 #include "src/utils/types.h"
 
 namespace libgav1 {
@@ -42,6 +45,25 @@ namespace {
 // enabled. The dimension is subsampling_y.
 constexpr int kLoopRestorationBorderRows[2] = {54, 26};
 
+// The progress of a band in PostFilter::ApplyFilteringWorker(). The values
+// are increasing.
+//
+// The vertical edges of the band have been deblocked.
+constexpr int kBandVerticalDeblockDone = 1;
+// The band has been deblocked (except for the last rows, which are filtered
+// along with the band below), and its CDEF and loop restoration borders have
+// been saved.
+constexpr int kBandBordersSaved = 2;
+// CDEF has been applied to the band.
+constexpr int kBandCdefDone = 3;
+
+// Returns the number of bands processed by PostFilter::ApplyFilteringWorker().
+// The last one is below the frame and only finishes the filtering of the band
+// above it.
+int GetNumBands(int rows4x4) {
+  return DivideBy16(rows4x4 + kNum4x4InLoopFilterUnit - 1) + 1;
+}
+
 }  // namespace
 
 PostFilter::PostFilter(const ObuFrameHeader& frame_header,
@@ -71,6 +93,8 @@ PostFilter::PostFilter(const ObuFrameHeader& frame_header,
       do_restoration_(
           DoRestoration(loop_restoration_, do_post_filter_mask, planes_)),
       do_superres_(DoSuperRes(frame_header, do_post_filter_mask)),
+      is_reference_frame_(frame_header.refresh_frame_flags != 0 &&
+                          !sequence_header.still_picture),
       cdef_index_(frame_scratch_buffer->cdef_index),
       cdef_skip_(frame_scratch_buffer->cdef_skip),
       inter_transform_sizes_(frame_scratch_buffer->inter_transform_sizes),
@@ -90,7 +114,9 @@ PostFilter::PostFilter(const ObuFrameHeader& frame_header,
       cdef_border_(frame_scratch_buffer->cdef_border),
       loop_restoration_border_(frame_scratch_buffer->loop_restoration_border),
       thread_pool_(
-          frame_scratch_buffer->threading_strategy.post_filter_thread_pool()) {
+          frame_scratch_buffer->threading_strategy.post_filter_thread_pool()),
+      post_filter_band_progress_(
+          frame_scratch_buffer->post_filter_band_progress) {
   const int8_t zero_delta_lf[kFrameLfCount] = {};
   ComputeDeblockFilterLevels(zero_delta_lf, deblock_filter_levels_);
   if (DoSuperRes()) {
@@ -281,7 +307,7 @@ void PostFilter::ExtendFrameBoundary(uint8_t* const frame_start,
 }
 
 void PostFilter::ExtendBordersForReferenceFrame() {
-  if (frame_header_.refresh_frame_flags == 0) return;
+  if (!is_reference_frame_) return;
   const int upscaled_width = frame_header_.upscaled_width;
   const int height = frame_header_.height;
   int plane = kPlaneY;
@@ -548,29 +574,147 @@ void PostFilter::RunJobs(WorkerFunction worker) {
   // Run the jobs on the current thread.
   (this->*worker)(&row4x4);
   // Wait for the threadpool jobs to finish.
-  pending_workers.Wait();
+  pending_workers.Wait(thread_pool_);
+}
+
+void PostFilter::WaitForBandProgress(int band, int progress) {
+  if (band < 0) return;
+  std::unique_lock<std::mutex> lock(band_mutex_);
+  if (post_filter_band_progress_.get()[band] >= progress) return;
+  ScopedTraceEvent trace_event(kTraceEventWait);
+  do {
+    band_condvar_.wait(lock);
+  } while (post_filter_band_progress_.get()[band] < progress);
+}
+
+void PostFilter::SetBandProgress(int band, int progress) {
+  {
+    std::lock_guard<std::mutex> lock(band_mutex_);
+    post_filter_band_progress_.get()[band] = progress;
+  }
+  band_condvar_.notify_all();
+}
+
+void PostFilter::ApplyFilteringWorker(std::atomic<int>* band_atomic) {
+  const int rows4x4 = frame_header_.rows4x4;
+  const int columns4x4 = frame_header_.columns4x4;
+  const int num_bands = GetNumBands(rows4x4);
+  uint16_t cdef_block[kCdefUnitSizeWithBorders * kCdefUnitSizeWithBorders * 2];
+  alignas(kMaxAlignment) uint8_t border_columns[2][kMaxPlanes][256];
+  int band;
+  while ((band = band_atomic->fetch_add(1, std::memory_order_relaxed)) <
+         num_bands) {
+    const int row4x4 = band * kNum4x4InLoopFilterUnit;
+    if (row4x4 < rows4x4) {
+      if (DoDeblock()) {
+        ScopedStageTimer timer(kLibgav1DecodeStageDeblock);
+        VerticalDeblockFilter(row4x4, row4x4 + kNum4x4InLoopFilterUnit, 0,
+                              columns4x4);
+        SetBandProgress(band, kBandVerticalDeblockDone);
+        // The horizontal edges at the top of the band also filter the last
+        // rows of the band above, which must have their vertical edges
+        // filtered first.
+        WaitForBandProgress(band - 1, kBandVerticalDeblockDone);
+        HorizontalDeblockFilter(row4x4, row4x4 + kNum4x4InLoopFilterUnit, 0,
+                                columns4x4);
+      }
+      if (DoRestoration()) {
+        ScopedStageTimer timer(kLibgav1DecodeStageLoopRestoration);
+        if (DoCdef()) {
+          SetupLoopRestorationBorder(row4x4, kNum4x4InLoopFilterUnit);
+        } else {
+          SetupLoopRestorationBorder(row4x4);
+        }
+      }
+      if (DoCdef()) {
+        ScopedStageTimer timer(kLibgav1DecodeStageCdef);
+        // The first two border rows of this band and the last two border rows
+        // of the band above are final now.
+        SetupCdefBorder(row4x4, 0, 2);
+        if (band > 0) {
+          SetupCdefBorder(row4x4 - kNum4x4InLoopFilterUnit, 2, 4);
+        }
+      }
+    }
+    SetBandProgress(band, kBandBordersSaved);
+    if (band == 0) continue;
+    // Apply CDEF and loop restoration to the band above. Its CDEF input
+    // includes the border rows saved by the bands above and below it.
+    const int row4x4_above = row4x4 - kNum4x4InLoopFilterUnit;
+    WaitForBandProgress(band - 1, kBandBordersSaved);
+    if (DoCdef()) {
+      ScopedStageTimer timer(kLibgav1DecodeStageCdef);
+      ApplyCdefForOneSuperBlockRowHelper(
+          cdef_block, border_columns, row4x4_above,
+          std::min(static_cast<int>(kNum4x4InLoopFilterUnit),
+                   rows4x4 - row4x4_above));
+    }
+    SetBandProgress(band - 1, kBandCdefDone);
+    if (DoRestoration()) {
+      ScopedStageTimer timer(kLibgav1DecodeStageLoopRestoration);
+      // Loop restoration operates with a lag of 8 rows, so it also filters the
+      // last rows of the band two above, after their CDEF.
+      WaitForBandProgress(band - 2, kBandCdefDone);
+      CopyBordersForOneSuperBlockRow(row4x4_above, kNum4x4InLoopFilterUnit,
+                                     /*for_loop_restoration=*/true);
+      ApplyLoopRestoration(row4x4_above, kNum4x4InLoopFilterUnit);
+      if (band == num_bands - 1) {
+        // Cover the last rows of the frame.
+        CopyBordersForOneSuperBlockRow(row4x4, kNum4x4InLoopFilterUnit,
+                                       /*for_loop_restoration=*/true);
+        ApplyLoopRestoration(row4x4, kNum4x4InLoopFilterUnit);
+      }
+    }
+  }
 }
 
 void PostFilter::ApplyFilteringThreaded() {
+  if (!DoSuperRes()) {
+    const int num_bands = GetNumBands(frame_header_.rows4x4);
+    bool fused = false;
+    {
+      std::lock_guard<std::mutex> lock(band_mutex_);
+      if (post_filter_band_progress_.Resize(num_bands)) {
+        memset(post_filter_band_progress_.get(), 0,
+               num_bands * sizeof(post_filter_band_progress_.get()[0]));
+        fused = true;
+      }
+    }
+    // If the allocation fails, fall back to filtering the frame one filter at a
+    // time.
+    if (fused) {
+      RunJobs(&PostFilter::ApplyFilteringWorker);
+      ScopedStageTimer timer(kLibgav1DecodeStageBorderExtension);
+      ExtendBordersForReferenceFrame();
+      return;
+    }
+  }
   if (DoDeblock()) {
+    ScopedStageTimer timer(kLibgav1DecodeStageDeblock);
     RunJobs(&PostFilter::DeblockFilterWorker<kLoopFilterTypeVertical>);
     RunJobs(&PostFilter::DeblockFilterWorker<kLoopFilterTypeHorizontal>);
   }
   if (DoCdef() && DoRestoration()) {
+    ScopedStageTimer timer(kLibgav1DecodeStageLoopRestoration);
     for (int row4x4 = 0; row4x4 < frame_header_.rows4x4;
          row4x4 += kNum4x4InLoopFilterUnit) {
       SetupLoopRestorationBorder(row4x4, kNum4x4InLoopFilterUnit);
     }
   }
   if (DoCdef()) {
+    ScopedStageTimer timer(kLibgav1DecodeStageCdef);
     for (int row4x4 = 0; row4x4 < frame_header_.rows4x4;
          row4x4 += kNum4x4InLoopFilterUnit) {
-      SetupCdefBorder(row4x4);
+      SetupCdefBorder(row4x4, 0, 4);
     }
     RunJobs(&PostFilter::ApplyCdefWorker);
   }
-  if (DoSuperRes()) ApplySuperResThreaded();
+  if (DoSuperRes()) {
+    ScopedStageTimer timer(kLibgav1DecodeStageSuperRes);
+    ApplySuperResThreaded();
+  }
   if (DoRestoration()) {
+    ScopedStageTimer timer(kLibgav1DecodeStageLoopRestoration);
     if (!DoCdef()) {
       int row4x4 = 0;
       do {
@@ -580,6 +724,7 @@ void PostFilter::ApplyFilteringThreaded() {
     }
     RunJobs(&PostFilter::ApplyLoopRestorationWorker);
   }
+  ScopedStageTimer timer(kLibgav1DecodeStageBorderExtension);
   ExtendBordersForReferenceFrame();
 }
 
@@ -588,20 +733,25 @@ int PostFilter::ApplyFilteringForOneSuperBlockRow(int row4x4, int sb4x4,
                                                   bool do_deblock) {
   if (row4x4 < 0) return -1;
   if (DoDeblock() && do_deblock) {
+    ScopedStageTimer timer(kLibgav1DecodeStageDeblock);
     VerticalDeblockFilter(row4x4, row4x4 + sb4x4, 0, frame_header_.columns4x4);
     HorizontalDeblockFilter(row4x4, row4x4 + sb4x4, 0,
                             frame_header_.columns4x4);
   }
   if (DoRestoration() && DoCdef()) {
+    ScopedStageTimer timer(kLibgav1DecodeStageLoopRestoration);
     SetupLoopRestorationBorder(row4x4, sb4x4);
   }
   if (DoCdef()) {
+    ScopedStageTimer timer(kLibgav1DecodeStageCdef);
     ApplyCdefForOneSuperBlockRow(row4x4, sb4x4, is_last_row);
   }
   if (DoSuperRes()) {
+    ScopedStageTimer timer(kLibgav1DecodeStageSuperRes);
     ApplySuperResForOneSuperBlockRow(row4x4, sb4x4, is_last_row);
   }
   if (DoRestoration()) {
+    ScopedStageTimer timer(kLibgav1DecodeStageLoopRestoration);
     CopyBordersForOneSuperBlockRow(row4x4, sb4x4, true);
     ApplyLoopRestoration(row4x4, sb4x4);
     if (is_last_row) {
@@ -611,13 +761,15 @@ int PostFilter::ApplyFilteringForOneSuperBlockRow(int row4x4, int sb4x4,
       ApplyLoopRestoration(row4x4 + sb4x4, 16);
     }
   }
-  if (frame_header_.refresh_frame_flags != 0 && DoBorderExtensionInLoop()) {
+  if (is_reference_frame_ && DoBorderExtensionInLoop()) {
+    ScopedStageTimer timer(kLibgav1DecodeStageBorderExtension);
     CopyBordersForOneSuperBlockRow(row4x4, sb4x4, false);
     if (is_last_row) {
       CopyBordersForOneSuperBlockRow(row4x4 + sb4x4, 16, false);
     }
   }
   if (is_last_row && !DoBorderExtensionInLoop()) {
+    ScopedStageTimer timer(kLibgav1DecodeStageBorderExtension);
     ExtendBordersForReferenceFrame();
   }
   return is_last_row ? frame_header_.height : progress_row_;
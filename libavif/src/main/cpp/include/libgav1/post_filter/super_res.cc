@@ -206,7 +206,7 @@ void PostFilter::ApplySuperResThreaded() {
     }
   }
   // Wait for the threadpool jobs to finish.
-  pending_workers.Wait();
+  pending_workers.Wait(thread_pool_);
 }
 
 }  // namespace libgav1
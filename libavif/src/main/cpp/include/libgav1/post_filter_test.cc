@@ -474,8 +474,9 @@ void PostFilterSuperResTest<bitdepth, Pixel>::TestApplySuperRes(
   constexpr int kNumThreads = 4;
   FrameScratchBuffer frame_scratch_buffer;
   if (multi_threaded) {
-    ASSERT_TRUE(frame_scratch_buffer.threading_strategy.Reset(frame_header,
-                                                              kNumThreads));
+    ASSERT_TRUE(frame_scratch_buffer.threading_strategy.Reset(
+        frame_header, kNumThreads, /*shared_thread_pool=*/nullptr,
+        /*placement=*/nullptr));
   }
   const int pixel_size = sequence_header.color_config.bitdepth == 8
                              ? sizeof(uint8_t)
@@ -874,8 +875,9 @@ void PostFilterApplyCdefTest<bitdepth, Pixel>::TestMultiThread(
   libvpx_test::ACMRandom rnd(libvpx_test::ACMRandom::DeterministicSeed());
   SetInput(&rnd);
 
-  ASSERT_TRUE(frame_scratch_buffer_.threading_strategy.Reset(frame_header_,
-                                                             num_threads));
+  ASSERT_TRUE(frame_scratch_buffer_.threading_strategy.Reset(
+      frame_header_, num_threads, /*shared_thread_pool=*/nullptr,
+      /*placement=*/nullptr));
   if (num_threads > 1) {
     const int num_units =
         MultiplyBy4(RightShiftWithCeiling(frame_header_.rows4x4, 4));
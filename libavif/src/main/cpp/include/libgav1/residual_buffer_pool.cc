@@ -140,4 +140,14 @@ size_t ResidualBufferPool::Size() const {
   return buffers_.Size();
 }
 
+size_t ResidualBufferPool::buffer_bytes() const {
+  return sizeof(ResidualBuffer) + buffer_size_ +
+         queue_size_ *
+             (sizeof(TransformParameters) + sizeof(PartitionTreeNode));
+}
+
+size_t ResidualBufferPool::allocated_bytes() const {
+  return Size() * buffer_bytes();
+}
+
 }  // namespace libgav1
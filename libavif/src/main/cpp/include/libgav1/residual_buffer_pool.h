@@ -136,6 +136,13 @@ class ResidualBufferPool : public Allocable {
   // Used only in the tests. Returns the number of buffers in the stack.
   size_t Size() const;
 
+  // Returns the bytes of one buffer, as allocated by Get().
+  size_t buffer_bytes() const;
+
+  // Returns the bytes of the buffers in the stack. The buffers handed out by
+  // Get() are not counted until they are released.
+  size_t allocated_bytes() const;
+
  private:
   mutable std::mutex mutex_;
   ResidualBufferStack buffers_ LIBGAV1_GUARDED_BY(mutex_);
@@ -67,12 +67,15 @@ int ComputeFrameThreadCount(int thread_count, int tile_count,
 }  // namespace
 
 bool ThreadingStrategy::Reset(const ObuFrameHeader& frame_header,
-                              int thread_count) {
+                              int thread_count,
+                              ThreadPool* const shared_thread_pool,
+                              CpuPlacement* const placement) {
   assert(thread_count > 0);
   frame_parallel_ = false;
 
   if (thread_count == 1) {
     thread_pool_.reset(nullptr);
+    shared_thread_pool_ = nullptr;
     tile_thread_count_ = 0;
     max_tile_index_for_row_threads_ = 0;
     return true;
@@ -81,9 +84,18 @@ bool ThreadingStrategy::Reset(const ObuFrameHeader& frame_header,
   // We do work in the current thread, so it is sufficient to create
   // |thread_count|-1 threads in the threadpool.
   thread_count = std::min(thread_count, static_cast<int>(kMaxThreads)) - 1;
+  // There is no point in claiming more workers than the shared pool has.
+  if (shared_thread_pool != nullptr) {
+    thread_count = std::min(thread_count, shared_thread_pool->num_threads());
+  }
 
-  if (thread_pool_ == nullptr || thread_pool_->num_threads() != thread_count) {
-    thread_pool_ = ThreadPool::Create("libgav1", thread_count);
+  if (thread_pool_ == nullptr || thread_pool_->num_threads() != thread_count ||
+      shared_thread_pool_ != shared_thread_pool) {
+    thread_pool_ = (shared_thread_pool != nullptr)
+                       ? ThreadPool::Create(shared_thread_pool, thread_count)
+                       : ThreadPool::Create("libgav1", thread_count, placement);
+    shared_thread_pool_ =
+        (thread_pool_ != nullptr) ? shared_thread_pool : nullptr;
     if (thread_pool_ == nullptr) {
       LIBGAV1_DLOG(ERROR, "Failed to create a thread pool with %d threads.",
                    thread_count);
@@ -149,7 +161,8 @@ bool ThreadingStrategy::Reset(const ObuFrameHeader& frame_header,
   return true;
 }
 
-bool ThreadingStrategy::Reset(int thread_count) {
+bool ThreadingStrategy::Reset(int thread_count,
+                              CpuPlacement* const placement) {
   assert(thread_count > 0);
   frame_parallel_ = true;
 
@@ -160,8 +173,10 @@ bool ThreadingStrategy::Reset(int thread_count) {
   tile_thread_count_ = 0;
   max_tile_index_for_row_threads_ = 0;
 
-  if (thread_pool_ == nullptr || thread_pool_->num_threads() != thread_count) {
-    thread_pool_ = ThreadPool::Create("libgav1-fp", thread_count);
+  if (thread_pool_ == nullptr || thread_pool_->num_threads() != thread_count ||
+      shared_thread_pool_ != nullptr) {
+    thread_pool_ = ThreadPool::Create("libgav1-fp", thread_count, placement);
+    shared_thread_pool_ = nullptr;
     if (thread_pool_ == nullptr) {
       LIBGAV1_DLOG(ERROR, "Failed to create a thread pool with %d threads.",
                    thread_count);
@@ -173,6 +188,7 @@ bool ThreadingStrategy::Reset(int thread_count) {
 
 bool InitializeThreadPoolsForFrameParallel(
     int thread_count, int tile_count, int tile_columns,
+    CpuPlacement* const placement,
     std::unique_ptr<ThreadPool>* const frame_thread_pool,
     FrameScratchBufferPool* const frame_scratch_buffer_pool) {
   assert(*frame_thread_pool == nullptr);
@@ -180,7 +196,10 @@ bool InitializeThreadPoolsForFrameParallel(
   const int frame_threads =
       ComputeFrameThreadCount(thread_count, tile_count, tile_columns);
   if (frame_threads == 0) return true;
-  *frame_thread_pool = ThreadPool::Create(frame_threads);
+  // The frame threads parse, which is the critical path, so they are created
+  // first to get the fastest CPUs.
+  *frame_thread_pool =
+      ThreadPool::Create(/*name_prefix=*/"", frame_threads, placement);
   if (*frame_thread_pool == nullptr) {
     LIBGAV1_DLOG(ERROR, "Failed to create frame thread pool with %d threads.",
                  frame_threads);
@@ -205,7 +224,7 @@ bool InitializeThreadPoolsForFrameParallel(
     const int current_frame_thread_count =
         threads_per_frame + static_cast<int>(i < extra_threads);
     if (!frame_scratch_buffer->threading_strategy.Reset(
-            current_frame_thread_count)) {
+            current_frame_thread_count, placement)) {
       return false;
     }
     remaining_threads -= current_frame_thread_count;
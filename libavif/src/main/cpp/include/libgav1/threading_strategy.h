@@ -47,18 +47,28 @@ class ThreadingStrategy {
   //   * One thread is allocated for decoding each Tile.
   //   * Any remaining threads are allocated for superblock row multi-threading
   //     within each of the tile in a round robin fashion.
+  // If |shared_thread_pool| is not nullptr, no threads are created. The work is
+  // run on the workers of |shared_thread_pool| instead, and |thread_count| is
+  // the number of those workers (plus the current thread) that this decoder
+  // may keep busy at a time. It is capped at the size of |shared_thread_pool|
+  // plus one. Otherwise, if |placement| is not nullptr, the worker threads are
+  // pinned to the CPUs it hands out.
   // Note: During the lifetime of a ThreadingStrategy object, only one of the
   // Reset() variants will be used.
   LIBGAV1_MUST_USE_RESULT bool Reset(const ObuFrameHeader& frame_header,
-                                     int thread_count);
+                                     int thread_count,
+                                     ThreadPool* shared_thread_pool,
+                                     CpuPlacement* placement);
 
   // Creates or re-allocates a thread pool with |thread_count| threads. This
   // function is used only in frame parallel mode. This function is idempotent
   // if the |thread_count| doesn't change between calls (it will only create new
-  // threads on the first call and do nothing on the subsequent calls).
+  // threads on the first call and do nothing on the subsequent calls). If
+  // |placement| is not nullptr, the worker threads are pinned to the CPUs it
+  // hands out.
   // Note: During the lifetime of a ThreadingStrategy object, only one of the
   // Reset() variants will be used.
-  LIBGAV1_MUST_USE_RESULT bool Reset(int thread_count);
+  LIBGAV1_MUST_USE_RESULT bool Reset(int thread_count, CpuPlacement* placement);
 
   // Returns a pointer to the ThreadPool that is to be used for Tile
   // multi-threading.
@@ -95,6 +105,9 @@ class ThreadingStrategy {
 
  private:
   std::unique_ptr<ThreadPool> thread_pool_;
+  // The pool that |thread_pool_| runs its jobs on, if it has no threads of its
+  // own.
+  ThreadPool* shared_thread_pool_ = nullptr;
   int tile_thread_count_ = 0;
   int max_tile_index_for_row_threads_ = 0;
   bool frame_parallel_ = false;
@@ -121,8 +134,10 @@ class ThreadingStrategy {
 //    * |frame_thread_pool| is nullptr. |frame_scratch_buffer_pool| is not
 //      modified. This means that frame threading will not be used and the
 //      decoder will continue to operate normally in non frame parallel mode.
+//  If |placement| is not nullptr, all the threads are pinned to the CPUs it
+//  hands out, the frame threads first.
 LIBGAV1_MUST_USE_RESULT bool InitializeThreadPoolsForFrameParallel(
-    int thread_count, int tile_count, int tile_columns,
+    int thread_count, int tile_count, int tile_columns, CpuPlacement* placement,
     std::unique_ptr<ThreadPool>* frame_thread_pool,
     FrameScratchBufferPool* frame_scratch_buffer_pool);
 
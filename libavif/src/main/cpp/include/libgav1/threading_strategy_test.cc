@@ -37,7 +37,7 @@ class ThreadingStrategyTest : public testing::Test {
 
 TEST_F(ThreadingStrategyTest, MaxThreadEnforced) {
   frame_header_.tile_info.tile_count = 32;
-  ASSERT_TRUE(strategy_.Reset(frame_header_, 32));
+  ASSERT_TRUE(strategy_.Reset(frame_header_, 32, nullptr, nullptr));
   EXPECT_NE(strategy_.tile_thread_pool(), nullptr);
   for (int i = 0; i < 32; ++i) {
     EXPECT_EQ(strategy_.row_thread_pool(i), nullptr);
@@ -47,7 +47,7 @@ TEST_F(ThreadingStrategyTest, MaxThreadEnforced) {
 
 TEST_F(ThreadingStrategyTest, UseAllThreadsForTiles) {
   frame_header_.tile_info.tile_count = 8;
-  ASSERT_TRUE(strategy_.Reset(frame_header_, 8));
+  ASSERT_TRUE(strategy_.Reset(frame_header_, 8, nullptr, nullptr));
   EXPECT_NE(strategy_.tile_thread_pool(), nullptr);
   for (int i = 0; i < 8; ++i) {
     EXPECT_EQ(strategy_.row_thread_pool(i), nullptr);
@@ -57,7 +57,7 @@ TEST_F(ThreadingStrategyTest, UseAllThreadsForTiles) {
 
 TEST_F(ThreadingStrategyTest, RowThreads) {
   frame_header_.tile_info.tile_count = 2;
-  ASSERT_TRUE(strategy_.Reset(frame_header_, 8));
+  ASSERT_TRUE(strategy_.Reset(frame_header_, 8, nullptr, nullptr));
   EXPECT_NE(strategy_.tile_thread_pool(), nullptr);
   // Each tile should get 3 threads each.
   for (int i = 0; i < 2; ++i) {
@@ -69,7 +69,7 @@ TEST_F(ThreadingStrategyTest, RowThreads) {
 TEST_F(ThreadingStrategyTest, RowThreadsUnequal) {
   frame_header_.tile_info.tile_count = 2;
 
-  ASSERT_TRUE(strategy_.Reset(frame_header_, 9));
+  ASSERT_TRUE(strategy_.Reset(frame_header_, 9, nullptr, nullptr));
   EXPECT_NE(strategy_.tile_thread_pool(), nullptr);
   EXPECT_NE(strategy_.row_thread_pool(0), nullptr);
   EXPECT_NE(strategy_.row_thread_pool(1), nullptr);
@@ -79,7 +79,7 @@ TEST_F(ThreadingStrategyTest, RowThreadsUnequal) {
 // Test a random combination of tile_count and thread_count.
 TEST_F(ThreadingStrategyTest, MultipleCalls) {
   frame_header_.tile_info.tile_count = 2;
-  ASSERT_TRUE(strategy_.Reset(frame_header_, 8));
+  ASSERT_TRUE(strategy_.Reset(frame_header_, 8, nullptr, nullptr));
   EXPECT_NE(strategy_.tile_thread_pool(), nullptr);
   for (int i = 0; i < 2; ++i) {
     EXPECT_NE(strategy_.row_thread_pool(i), nullptr);
@@ -87,7 +87,7 @@ TEST_F(ThreadingStrategyTest, MultipleCalls) {
   EXPECT_NE(strategy_.post_filter_thread_pool(), nullptr);
 
   frame_header_.tile_info.tile_count = 8;
-  ASSERT_TRUE(strategy_.Reset(frame_header_, 8));
+  ASSERT_TRUE(strategy_.Reset(frame_header_, 8, nullptr, nullptr));
   EXPECT_NE(strategy_.tile_thread_pool(), nullptr);
   // Row threads must have been reset.
   for (int i = 0; i < 8; ++i) {
@@ -96,7 +96,7 @@ TEST_F(ThreadingStrategyTest, MultipleCalls) {
   EXPECT_NE(strategy_.post_filter_thread_pool(), nullptr);
 
   frame_header_.tile_info.tile_count = 8;
-  ASSERT_TRUE(strategy_.Reset(frame_header_, 16));
+  ASSERT_TRUE(strategy_.Reset(frame_header_, 16, nullptr, nullptr));
   EXPECT_NE(strategy_.tile_thread_pool(), nullptr);
   for (int i = 0; i < 8; ++i) {
     EXPECT_NE(strategy_.row_thread_pool(i), nullptr);
@@ -104,7 +104,7 @@ TEST_F(ThreadingStrategyTest, MultipleCalls) {
   EXPECT_NE(strategy_.post_filter_thread_pool(), nullptr);
 
   frame_header_.tile_info.tile_count = 4;
-  ASSERT_TRUE(strategy_.Reset(frame_header_, 16));
+  ASSERT_TRUE(strategy_.Reset(frame_header_, 16, nullptr, nullptr));
   EXPECT_NE(strategy_.tile_thread_pool(), nullptr);
   for (int i = 0; i < 4; ++i) {
     EXPECT_NE(strategy_.row_thread_pool(i), nullptr);
@@ -116,7 +116,7 @@ TEST_F(ThreadingStrategyTest, MultipleCalls) {
   EXPECT_NE(strategy_.post_filter_thread_pool(), nullptr);
 
   frame_header_.tile_info.tile_count = 4;
-  ASSERT_TRUE(strategy_.Reset(frame_header_, 6));
+  ASSERT_TRUE(strategy_.Reset(frame_header_, 6, nullptr, nullptr));
   EXPECT_NE(strategy_.tile_thread_pool(), nullptr);
   // First two tiles will get 1 thread each.
   for (int i = 0; i < 2; ++i) {
@@ -128,7 +128,7 @@ TEST_F(ThreadingStrategyTest, MultipleCalls) {
   }
   EXPECT_NE(strategy_.post_filter_thread_pool(), nullptr);
 
-  ASSERT_TRUE(strategy_.Reset(frame_header_, 1));
+  ASSERT_TRUE(strategy_.Reset(frame_header_, 1, nullptr, nullptr));
   EXPECT_EQ(strategy_.tile_thread_pool(), nullptr);
   for (int i = 0; i < 8; ++i) {
     EXPECT_EQ(strategy_.row_thread_pool(i), nullptr);
@@ -140,7 +140,7 @@ TEST_F(ThreadingStrategyTest, MultipleCalls) {
 //  * 1 Tile - 2 Tiles - 1 Tile.
 TEST_F(ThreadingStrategyTest, MultipleCalls2) {
   frame_header_.tile_info.tile_count = 1;
-  ASSERT_TRUE(strategy_.Reset(frame_header_, 4));
+  ASSERT_TRUE(strategy_.Reset(frame_header_, 4, nullptr, nullptr));
   // When there is only one tile, tile thread pool must be nullptr.
   EXPECT_EQ(strategy_.tile_thread_pool(), nullptr);
   EXPECT_NE(strategy_.row_thread_pool(0), nullptr);
@@ -150,7 +150,7 @@ TEST_F(ThreadingStrategyTest, MultipleCalls2) {
   EXPECT_NE(strategy_.post_filter_thread_pool(), nullptr);
 
   frame_header_.tile_info.tile_count = 2;
-  ASSERT_TRUE(strategy_.Reset(frame_header_, 4));
+  ASSERT_TRUE(strategy_.Reset(frame_header_, 4, nullptr, nullptr));
   EXPECT_NE(strategy_.tile_thread_pool(), nullptr);
   for (int i = 0; i < 2; ++i) {
     EXPECT_NE(strategy_.row_thread_pool(i), nullptr);
@@ -161,7 +161,7 @@ TEST_F(ThreadingStrategyTest, MultipleCalls2) {
   EXPECT_NE(strategy_.post_filter_thread_pool(), nullptr);
 
   frame_header_.tile_info.tile_count = 1;
-  ASSERT_TRUE(strategy_.Reset(frame_header_, 4));
+  ASSERT_TRUE(strategy_.Reset(frame_header_, 4, nullptr, nullptr));
   EXPECT_EQ(strategy_.tile_thread_pool(), nullptr);
   EXPECT_NE(strategy_.row_thread_pool(0), nullptr);
   for (int i = 1; i < 8; ++i) {
@@ -170,6 +170,30 @@ TEST_F(ThreadingStrategyTest, MultipleCalls2) {
   EXPECT_NE(strategy_.post_filter_thread_pool(), nullptr);
 }
 
+TEST_F(ThreadingStrategyTest, SharedThreadPool) {
+  std::unique_ptr<ThreadPool> shared_thread_pool = ThreadPool::Create(4);
+  ASSERT_NE(shared_thread_pool, nullptr);
+  frame_header_.tile_info.tile_count = 2;
+  ASSERT_TRUE(strategy_.Reset(frame_header_, 3, shared_thread_pool.get(), nullptr));
+  ASSERT_NE(strategy_.thread_pool(), nullptr);
+  EXPECT_NE(strategy_.thread_pool(), shared_thread_pool.get());
+  EXPECT_EQ(strategy_.thread_pool()->num_threads(), 2);
+  EXPECT_EQ(strategy_.tile_thread_count(), 1);
+  EXPECT_NE(strategy_.row_thread_pool(0), nullptr);
+  EXPECT_EQ(strategy_.row_thread_pool(1), nullptr);
+
+  // The share is capped at the size of the shared pool.
+  ASSERT_TRUE(strategy_.Reset(frame_header_, 16, shared_thread_pool.get(), nullptr));
+  ASSERT_NE(strategy_.thread_pool(), nullptr);
+  EXPECT_EQ(strategy_.thread_pool()->num_threads(), 4);
+  EXPECT_EQ(strategy_.tile_thread_count(), 1);
+  EXPECT_NE(strategy_.row_thread_pool(0), nullptr);
+  EXPECT_NE(strategy_.row_thread_pool(1), nullptr);
+
+  ASSERT_TRUE(strategy_.Reset(frame_header_, 1, shared_thread_pool.get(), nullptr));
+  EXPECT_EQ(strategy_.thread_pool(), nullptr);
+}
+
 void VerifyFrameParallel(int thread_count, int tile_count, int tile_columns,
                          int expected_frame_threads,
                          const std::vector<int>& expected_tile_threads) {
@@ -178,8 +202,8 @@ void VerifyFrameParallel(int thread_count, int tile_count, int tile_columns,
   std::unique_ptr<ThreadPool> frame_thread_pool;
   FrameScratchBufferPool frame_scratch_buffer_pool;
   ASSERT_TRUE(InitializeThreadPoolsForFrameParallel(
-      thread_count, tile_count, tile_columns, &frame_thread_pool,
-      &frame_scratch_buffer_pool));
+      thread_count, tile_count, tile_columns, /*placement=*/nullptr,
+      &frame_thread_pool, &frame_scratch_buffer_pool));
   if (expected_frame_threads == 0) {
     EXPECT_EQ(frame_thread_pool, nullptr);
     return;
@@ -255,7 +279,7 @@ TEST(FrameParallelStrategyTest, ThreadCountDoesNotExceedkMaxThreads) {
   FrameScratchBufferPool frame_scratch_buffer_pool;
   ASSERT_TRUE(InitializeThreadPoolsForFrameParallel(
       /*thread_count=*/kMaxThreads + 10, /*tile_count=*/2, /*tile_columns=*/2,
-      &frame_thread_pool, &frame_scratch_buffer_pool));
+      /*placement=*/nullptr, &frame_thread_pool, &frame_scratch_buffer_pool));
   EXPECT_NE(frame_thread_pool.get(), nullptr);
   std::vector<std::unique_ptr<FrameScratchBuffer>> frame_scratch_buffers;
   int actual_thread_count = frame_thread_pool->num_threads();
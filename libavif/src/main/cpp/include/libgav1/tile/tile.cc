@@ -35,6 +35,7 @@
 #include "src/utils/logging.h"
 #include "src/utils/segmentation.h"
 #include "src/utils/stack.h"
+#include "src/utils/tracer.h"
 
 namespace libgav1 {
 namespace {
@@ -601,6 +602,13 @@ bool Tile::ProcessSuperBlockRow(int row4x4,
                                 TileScratchBuffer* const scratch_buffer) {
   if (row4x4 < row4x4_start_ || row4x4 >= row4x4_end_) return true;
   assert(scratch_buffer != nullptr);
+  ScopedTraceEvent trace_event(
+      (processing_mode == kProcessingModeParseOnly)
+          ? kTraceEventTileParse
+          : (processing_mode == kProcessingModeDecodeOnly)
+                ? kTraceEventTileDecode
+                : kTraceEventTileParseAndDecode,
+      number_, row4x4);
   const int block_width4x4 = kNum4x4BlocksWide[SuperBlockSize()];
   for (int column4x4 = column4x4_start_; column4x4 < column4x4_end_;
        column4x4 += block_width4x4) {
@@ -765,6 +773,7 @@ bool Tile::ThreadedParseAndDecode() {
   }
   for (int row4x4 = row4x4_start_, row_index = 0; row4x4 < row4x4_end_;
        row4x4 += block_width4x4, ++row_index) {
+    ScopedTraceEvent trace_event(kTraceEventTileParse, number_, row4x4);
     for (int column4x4 = column4x4_start_, column_index = 0;
          column4x4 < column4x4_end_;
          column4x4 += block_width4x4, ++column_index) {
@@ -850,6 +859,7 @@ void Tile::DecodeSuperBlock(int row_index, int column_index,
                             int block_width4x4) {
   const int row4x4 = row4x4_start_ + (row_index * block_width4x4);
   const int column4x4 = column4x4_start_ + (column_index * block_width4x4);
+  ScopedTraceEvent trace_event(kTraceEventSuperBlockDecode, number_, row4x4);
   std::unique_ptr<TileScratchBuffer> scratch_buffer =
       tile_scratch_buffer_pool_->Get();
   bool ok = scratch_buffer != nullptr;
@@ -858,6 +868,7 @@ void Tile::DecodeSuperBlock(int row_index, int column_index,
                            kProcessingModeDecodeOnly);
     tile_scratch_buffer_pool_->Release(std::move(scratch_buffer));
   }
+  trace_event.Stop();
   std::unique_lock<std::mutex> lock(threading_.mutex);
   if (ok) {
     threading_.sb_state[row_index][column_index] = kSuperBlockStateDecoded;
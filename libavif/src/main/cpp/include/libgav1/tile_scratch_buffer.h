@@ -69,6 +69,21 @@ struct TileScratchBuffer : public MaxAlignedAllocable {
     return convolve_block_buffer != nullptr;
   }
 
+  // Returns the bytes of a TileScratchBuffer initialized for |bitdepth|.
+  static size_t AllocatedBytes(int bitdepth) {
+    const int pixel_size = (bitdepth == 8) ? 1 : 2;
+    constexpr int unaligned_convolve_buffer_stride =
+        kMaxScaledSuperBlockSizeInPixels + kConvolveBorderLeftTop +
+        kConvolveScaleBorderRight;
+    constexpr int convolve_buffer_height = kMaxScaledSuperBlockSizeInPixels +
+                                           kConvolveBorderLeftTop +
+                                           kConvolveBorderBottom;
+    return sizeof(TileScratchBuffer) +
+           convolve_buffer_height *
+               Align<size_t>(unaligned_convolve_buffer_stride * pixel_size,
+                             kMaxAlignment);
+  }
+
   // kCompoundPredictionTypeDiffWeighted prediction mode needs a mask of the
   // prediction block size. This buffer is used to store that mask. The masks
   // will be created for the Y plane and will be re-used for the U & V planes.
@@ -159,6 +174,13 @@ class TileScratchBufferPool {
     buffers_.Push(std::move(scratch_buffer));
   }
 
+  // Returns the bytes of the buffers in the pool. The buffers handed out by
+  // Get() are not counted until they are released.
+  size_t allocated_bytes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return buffers_.Size() * TileScratchBuffer::AllocatedBytes(bitdepth_);
+  }
+
  private:
   std::mutex mutex_;
   // We will never need more than kMaxThreads scratch buffers since that is the
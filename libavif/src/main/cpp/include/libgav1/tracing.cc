@@ -0,0 +1,31 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/gav1/tracing.h"
+
+#include "src/utils/tracer.h"
+
+extern "C" {
+
+int Libgav1StartTracing(int max_events) {
+  return static_cast<int>(libgav1::StartTracer(max_events));
+}
+
+void Libgav1StopTracing(void) { libgav1::StopTracer(); }
+
+size_t Libgav1GetTraceJson(char* buffer, size_t size) {
+  return libgav1::GetTracerJson(buffer, size);
+}
+
+}  // extern "C"
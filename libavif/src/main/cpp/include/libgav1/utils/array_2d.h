@@ -112,6 +112,8 @@ class Array2D {
   int rows() const { return data_view_.rows(); }
   int columns() const { return data_view_.columns(); }
   size_t size() const { return size_; }
+  // The bytes of the buffer, which may be larger than size() elements.
+  size_t allocated_bytes() const { return allocated_size_ * sizeof(T); }
   T* data() { return data_.get(); }
   const T* data() const { return data_.get(); }
 
@@ -24,6 +24,13 @@
 namespace libgav1 {
 
 bool BlockParametersHolder::Reset(int rows4x4, int columns4x4) {
+  // The BlockParameters are allocated in index order and kept until
+  // |block_parameters_| grows.
+  num_allocated_ = std::min(
+      std::max(num_allocated_, static_cast<size_t>(index_.load())),
+      block_parameters_.size());
+  const size_t size = static_cast<size_t>(rows4x4) * columns4x4;
+  if (size > block_parameters_.size()) num_allocated_ = 0;
   rows4x4_ = rows4x4;
   columns4x4_ = columns4x4;
   index_ = 0;
@@ -31,6 +38,15 @@ bool BlockParametersHolder::Reset(int rows4x4, int columns4x4) {
          block_parameters_.Resize(rows4x4_ * columns4x4_);
 }
 
+size_t BlockParametersHolder::allocated_bytes() const {
+  const size_t num_allocated = std::min(
+      std::max(num_allocated_, static_cast<size_t>(index_.load())),
+      block_parameters_.size());
+  return block_parameters_cache_.allocated_bytes() +
+         block_parameters_.allocated_bytes() +
+         num_allocated * sizeof(BlockParameters);
+}
+
 BlockParameters* BlockParametersHolder::Get(int row4x4, int column4x4,
                                             BlockSize block_size) {
   const size_t index = index_.fetch_add(1, std::memory_order_relaxed);
@@ -18,6 +18,7 @@
 #define LIBGAV1_SRC_UTILS_BLOCK_PARAMETERS_HOLDER_H_
 
 #include <atomic>
+#include <cstddef>
 #include <memory>
 
 #include "src/utils/array_2d.h"
@@ -62,6 +63,10 @@ class BlockParametersHolder {
 
   int columns4x4() const { return columns4x4_; }
 
+  // Returns the bytes of the cache and of the BlockParameters allocated so
+  // far. Must not be called while blocks are being decoded.
+  size_t allocated_bytes() const;
+
  private:
   // Needs access to FillCache for testing Cdef.
   template <int bitdepth, typename Pixel>
@@ -79,7 +84,11 @@ class BlockParametersHolder {
   DynamicBuffer<std::unique_ptr<BlockParameters>> block_parameters_;
 
   // Points to the next available index of |block_parameters_|.
-  std::atomic<int> index_;
+  std::atomic<int> index_{0};
+
+  // The number of BlockParameters allocated in |block_parameters_| by the
+  // frames before the last Reset().
+  size_t num_allocated_ = 0;
 
   // This is a 2d array of size |rows4x4_| * |columns4x4_|. This is filled in by
   // FillCache() and used by Find() to perform look ups using exactly one look
@@ -22,6 +22,8 @@
 #include <mutex>               // NOLINT (unapproved c++11 header)
 
 #include "src/utils/compiler_attributes.h"
+#include "src/utils/threadpool.h"
+#include "src/utils/tracer.h"
 
 namespace libgav1 {
 
@@ -29,7 +31,8 @@ namespace libgav1 {
 // use case. Typical usage would be as follows:
 //   BlockingCounter counter(num_jobs);
 //     - spawn the jobs.
-//     - call counter.Wait() on the master thread.
+//     - call counter.Wait() on the master thread, or counter.Wait(pool) to
+//       have the master thread run the queued jobs while it waits.
 //     - worker threads will call counter.Decrement().
 //     - master thread will return from counter.Wait() when all workers are
 //     complete.
@@ -77,12 +80,31 @@ class BlockingCounterImpl {
   // |has_failure_status| is false, this function always returns true.
   bool Wait() {
     std::unique_lock<std::mutex> lock(mutex_);
-    condition_.wait(lock, [this]() { return count_ == 0; });
+    if (count_ != 0) {
+      ScopedTraceEvent trace_event(kTraceEventWait);
+      condition_.wait(lock, [this]() { return count_ == 0; });
+    }
     // If |has_failure_status| is false, we simply return true.
     return has_failure_status ? !job_failed_ : true;
   }
 
+  // Like Wait(), but until the counter becomes 0 the calling thread runs the
+  // jobs queued in |thread_pool| rather than blocking. It only blocks once no
+  // queued job is left. |thread_pool| may be nullptr.
+  bool Wait(ThreadPool* const thread_pool) {
+    if (thread_pool != nullptr) {
+      while (!IsZero() && thread_pool->RunPendingJob()) {
+      }
+    }
+    return Wait();
+  }
+
  private:
+  bool IsZero() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return count_ == 0;
+  }
+
   std::mutex mutex_;
   std::condition_variable condition_;
   int count_ LIBGAV1_GUARDED_BY(mutex_);
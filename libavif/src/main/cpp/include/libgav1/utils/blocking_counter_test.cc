@@ -15,6 +15,7 @@
 #include "src/utils/blocking_counter.h"
 
 #include <array>
+#include <atomic>
 #include <memory>
 
 #include "absl/time/clock.h"
@@ -75,6 +76,40 @@ TEST(BlockingCounterTest, IncrementBy) {
   }
 }
 
+// The only worker is blocked until all the other jobs are done, so Wait() must
+// run them on the calling thread to return.
+TEST(BlockingCounterTest, WaitRunsPendingJobs) {
+  std::unique_ptr<ThreadPool> pool = ThreadPool::Create(1);
+  ASSERT_NE(pool, nullptr);
+  BlockingCounter counter(kNumJobs);
+  std::atomic<bool> worker_started(false);
+  std::atomic<bool> release_worker(false);
+  std::array<bool, kNumJobs> done = {};
+
+  pool->Schedule([&worker_started, &release_worker]() {
+    worker_started.store(true, std::memory_order_release);
+    while (!release_worker.load(std::memory_order_acquire)) {
+      absl::SleepFor(absl::Milliseconds(1));
+    }
+  });
+  while (!worker_started.load(std::memory_order_acquire)) {
+    absl::SleepFor(absl::Milliseconds(1));
+  }
+  for (int i = 0; i < kNumJobs; ++i) {
+    pool->Schedule([&counter, &done, i]() {
+      done[i] = true;
+      counter.Decrement();
+    });
+  }
+
+  ASSERT_TRUE(counter.Wait(pool.get()));
+  release_worker.store(true, std::memory_order_release);
+
+  for (const auto& job_done : done) {
+    EXPECT_TRUE(job_done);
+  }
+}
+
 TEST(BlockingCounterWithStatusTest, BasicFunctionality) {
   std::unique_ptr<ThreadPool> pool = ThreadPool::Create(kNumWorkers);
   BlockingCounterWithStatus counter(kNumJobs);
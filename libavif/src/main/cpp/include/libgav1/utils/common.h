@@ -76,6 +76,20 @@ inline uint8_t* AlignAddr(uint8_t* const addr, const uintptr_t alignment) {
   return reinterpret_cast<uint8_t*>(Align(value, alignment));
 }
 
+// Hints the CPU to pull the first |size| bytes at |data| into the cache for
+// reading. This is a no-op on compilers without __builtin_prefetch.
+inline void PrefetchForRead(const void* const data, size_t size) {
+#if defined(__GNUC__)
+  const auto* const bytes = static_cast<const uint8_t*>(data);
+  for (size_t offset = 0; offset < size; offset += kCacheLineSize) {
+    __builtin_prefetch(bytes + offset, /*rw=*/0, /*locality=*/3);
+  }
+#else
+  static_cast<void>(data);
+  static_cast<void>(size);
+#endif
+}
+
 inline int32_t Clip3(int32_t value, int32_t low, int32_t high) {
   return value < low ? low : (value > high ? high : value);
 }
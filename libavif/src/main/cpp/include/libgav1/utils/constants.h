@@ -85,6 +85,13 @@ enum {
   // is required to be a multiple of 32 by YuvBuffer::Realloc, so that
   // subsampled chroma borders are 16-aligned.
   kBorderPixelsFilmGrain = 32,
+  // The only frame of a still picture is never used as a reference, so its
+  // borders are not extended and its left and top borders only need room for
+  // the loop restoration and SuperRes line extensions. The right and bottom
+  // borders stay at kBorderPixels (plus the extra bottom rows) because
+  // Reconstruct() and the in-place post filters write into them. A multiple of
+  // 32 like kBorderPixelsFilmGrain.
+  kStillPictureBorderPixels = 32,
   // These constants are the minimum left, right, top, and bottom border sizes
   // in pixels as an extension of the frame boundary. The minimum border sizes
   // are derived from the following requirements:
@@ -21,7 +21,18 @@
 #include <intrin.h>
 #endif
 
+#include <atomic>
+
 namespace libgav1 {
+namespace {
+
+std::atomic<uint32_t> cpu_feature_mask(~0u);
+
+}  // namespace
+
+void SetCpuFeatureMask(uint32_t mask) {
+  cpu_feature_mask.store(mask, std::memory_order_relaxed);
+}
 
 #if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || \
     defined(_M_X64)
@@ -49,7 +60,7 @@ uint64_t Xgetbv() { return _xgetbv(0); }
 
 }  // namespace
 
-uint32_t GetCpuInfo() {
+uint32_t GetCpuFeatures() {
   uint32_t info[4];
 
   // Get the highest feature value cpuid supports
@@ -71,6 +82,14 @@ uint32_t GetCpuInfo() {
       if (max_cpuid_value >= 7) {
         CpuId(7, info);
         if ((info[1] & (1 << 5)) != 0) features |= kAVX2;
+        // Bits 16 (AVX512F), 30 (AVX512BW) and 31 (AVX512VL), with the
+        // opmask, upper ZMM0-15 and ZMM16-31 states enabled by the OS.
+        constexpr uint32_t kAvx512Bits = (1u << 16) | (1u << 30) | (1u << 31);
+        if ((features & kAVX2) != 0 &&
+            (info[1] & kAvx512Bits) == kAvx512Bits &&
+            (Xgetbv() & 0xe6) == 0xe6) {
+          features |= kAVX512;
+        }
       }
     }
   }
@@ -78,7 +97,11 @@ uint32_t GetCpuInfo() {
   return features;
 }
 #else
-uint32_t GetCpuInfo() { return 0; }
+uint32_t GetCpuFeatures() { return 0; }
 #endif  // x86 || x86_64
 
+uint32_t GetCpuInfo() {
+  return GetCpuFeatures() & cpu_feature_mask.load(std::memory_order_relaxed);
+}
+
 }  // namespace libgav1
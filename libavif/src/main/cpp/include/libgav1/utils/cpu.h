@@ -44,8 +44,20 @@ namespace libgav1 {
 #define LIBGAV1_ENABLE_AVX2 0
 #endif  // LIBGAV1_ENABLE_SSE4_1
 
+#if LIBGAV1_ENABLE_AVX2
+#if !defined(LIBGAV1_ENABLE_AVX512)
+#define LIBGAV1_ENABLE_AVX512 1
+#endif  // !defined(LIBGAV1_ENABLE_AVX512)
+#else   // !LIBGAV1_ENABLE_AVX2
+// The AVX-512 functions fall back to the AVX2 versions for some block sizes.
+#undef LIBGAV1_ENABLE_AVX512
+#define LIBGAV1_ENABLE_AVX512 0
+#endif  // LIBGAV1_ENABLE_AVX2
+
 #else  // !LIBGAV1_X86
 
+#undef LIBGAV1_ENABLE_AVX512
+#define LIBGAV1_ENABLE_AVX512 0
 #undef LIBGAV1_ENABLE_AVX2
 #define LIBGAV1_ENABLE_AVX2 0
 #undef LIBGAV1_ENABLE_SSE4_1
@@ -57,6 +69,15 @@ namespace libgav1 {
 // (at least) that instruction set. This prevents disabling other instruction
 // sets if the current instruction set isn't a global target, e.g., building
 // *_avx2.cc w/-mavx2, but the remaining files without the flag.
+// The AVX-512 tier requires the byte/word (BW) and 128/256-bit (VL)
+// extensions on top of the foundation (F).
+#if LIBGAV1_ENABLE_AVX512 && defined(__AVX512F__) && defined(__AVX512BW__) && \
+    defined(__AVX512VL__)
+#define LIBGAV1_TARGETING_AVX512 1
+#else
+#define LIBGAV1_TARGETING_AVX512 0
+#endif
+
 #if LIBGAV1_ENABLE_AVX2 && defined(__AVX2__)
 #define LIBGAV1_TARGETING_AVX2 1
 #else
@@ -97,11 +118,21 @@ enum CpuFeatures : uint8_t {
 #define LIBGAV1_CPU_AVX2 (1 << 4)
   kNEON = 1 << 5,
 #define LIBGAV1_CPU_NEON (1 << 5)
+  // AVX-512 F, BW and VL.
+  kAVX512 = 1 << 6,
+#define LIBGAV1_CPU_AVX512 (1 << 6)
 };
 
-// Returns a bit-wise OR of CpuFeatures supported by this platform.
+// Returns a bit-wise OR of CpuFeatures supported by this platform, limited to
+// the mask set with SetCpuFeatureMask().
 uint32_t GetCpuInfo();
 
+// Limits the features returned by GetCpuInfo() to those in |mask|, e.g.,
+// ~kAVX512 to compare the AVX2 and AVX-512 functions on the same machine. The
+// Dsp tables are initialized once per process, so this must be called before
+// the first Decoder is initialized.
+void SetCpuFeatureMask(uint32_t mask);
+
 }  // namespace libgav1
 
 #endif  // LIBGAV1_SRC_UTILS_CPU_H_
@@ -244,5 +244,15 @@ TEST(CpuTest, GetNumberOfPerformanceCoresOnline) {
 #endif  // defined(__linux__)
 }
 
+TEST(CpuTest, SetCpuFeatureMask) {
+  const uint32_t features = GetCpuInfo();
+  SetCpuFeatureMask(~static_cast<uint32_t>(kAVX512));
+  EXPECT_EQ(GetCpuInfo(), features & ~static_cast<uint32_t>(kAVX512));
+  SetCpuFeatureMask(0);
+  EXPECT_EQ(GetCpuInfo(), 0u);
+  SetCpuFeatureMask(~0u);
+  EXPECT_EQ(GetCpuInfo(), features);
+}
+
 }  // namespace
 }  // namespace libgav1
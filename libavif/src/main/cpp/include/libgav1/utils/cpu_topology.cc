@@ -0,0 +1,188 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/utils/cpu_topology.h"
+
+#if defined(__ANDROID__) || defined(__linux__)
+#include <sched.h>
+#endif
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace libgav1 {
+namespace {
+
+// Reads the first line of the file |dir|/|name| into |buffer|. Returns false
+// if the file cannot be read.
+bool ReadLine(const char* dir, const char* name, char* buffer, int size) {
+  char path[512];
+  const int length = snprintf(path, sizeof(path), "%s/%s", dir, name);
+  if (length < 0 || length >= static_cast<int>(sizeof(path))) return false;
+  FILE* const file = fopen(path, "r");
+  if (file == nullptr) return false;
+  const bool ok = fgets(buffer, size, file) != nullptr;
+  fclose(file);
+  return ok;
+}
+
+// Returns the integer in the file |dir|/|name|, or -1 if there is none.
+int ReadInt(const char* dir, const char* name) {
+  char line[32];
+  if (!ReadLine(dir, name, line, sizeof(line))) return -1;
+  char* end;
+  const long value = strtol(line, &end, 10);
+  if (end == line || value < 0 || value > INT32_MAX) return -1;
+  return static_cast<int>(value);
+}
+
+// Parses a CPU list such as "0-3,6,8-11" into |cpus|.
+bool ParseCpuList(const char* list, CpuSet* cpus) {
+  const char* p = list;
+  bool any = false;
+  while (*p != '\0' && *p != '\n') {
+    char* end;
+    const long first = strtol(p, &end, 10);
+    if (end == p) return false;
+    long last = first;
+    p = end;
+    if (*p == '-') {
+      ++p;
+      last = strtol(p, &end, 10);
+      if (end == p) return false;
+      p = end;
+    }
+    if (first < 0 || last < first || last >= CpuSet::kMaxCpus) return false;
+    for (long cpu = first; cpu <= last; ++cpu) cpus->Add(static_cast<int>(cpu));
+    any = true;
+    if (*p == ',') ++p;
+  }
+  return any;
+}
+
+}  // namespace
+
+void CpuSet::Add(int cpu) {
+  if (cpu < 0 || cpu >= kMaxCpus) return;
+  bits_[cpu >> 6] |= uint64_t{1} << (cpu & 63);
+}
+
+bool CpuSet::Contains(int cpu) const {
+  if (cpu < 0 || cpu >= kMaxCpus) return false;
+  return ((bits_[cpu >> 6] >> (cpu & 63)) & 1) != 0;
+}
+
+int CpuSet::Count() const {
+  int count = 0;
+  for (const uint64_t word : bits_) {
+    for (uint64_t w = word; w != 0; w &= w - 1) ++count;
+  }
+  return count;
+}
+
+bool CpuTopology::Read(const char* const cpu_dir) {
+  num_clusters_ = 0;
+  char line[4096];
+  CpuSet online;
+  if (!ReadLine(cpu_dir, "online", line, sizeof(line)) ||
+      !ParseCpuList(line, &online)) {
+    return false;
+  }
+  for (int cpu = 0; cpu < CpuSet::kMaxCpus; ++cpu) {
+    if (!online.Contains(cpu)) continue;
+    char name[64];
+    snprintf(name, sizeof(name), "cpu%d/cpu_capacity", cpu);
+    int capacity = ReadInt(cpu_dir, name);
+    if (capacity < 0) {
+      snprintf(name, sizeof(name), "cpu%d/cpufreq/cpuinfo_max_freq", cpu);
+      capacity = ReadInt(cpu_dir, name);
+    }
+    if (capacity < 0) capacity = 0;
+    snprintf(name, sizeof(name), "cpu%d/topology/physical_package_id", cpu);
+    const int package = ReadInt(cpu_dir, name);
+    int index = 0;
+    while (index < num_clusters_ && (clusters_[index].capacity != capacity ||
+                                     clusters_[index].package != package)) {
+      ++index;
+    }
+    if (index == num_clusters_) {
+      if (num_clusters_ == kMaxClusters) continue;
+      clusters_[index] = CpuCluster();
+      clusters_[index].num_cpus = 0;
+      clusters_[index].capacity = capacity;
+      clusters_[index].package = package;
+      ++num_clusters_;
+    }
+    clusters_[index].cpus.Add(cpu);
+    ++clusters_[index].num_cpus;
+  }
+  // Fastest first, then by package. Insertion sort: there are few clusters.
+  for (int i = 1; i < num_clusters_; ++i) {
+    const CpuCluster cluster = clusters_[i];
+    int j = i;
+    for (; j > 0 && (clusters_[j - 1].capacity < cluster.capacity ||
+                     (clusters_[j - 1].capacity == cluster.capacity &&
+                      clusters_[j - 1].package > cluster.package));
+         --j) {
+      clusters_[j] = clusters_[j - 1];
+    }
+    clusters_[j] = cluster;
+  }
+  return num_clusters_ != 0;
+}
+
+bool CpuPlacement::NextWorkerCpus(CpuSet* const cpus) {
+  int worker = next_worker_.fetch_add(1, std::memory_order_relaxed);
+  for (int i = 0; i < topology_.num_clusters(); ++i) {
+    const CpuCluster& cluster = topology_.cluster(i);
+    if (worker < cluster.num_cpus) {
+      *cpus = cluster.cpus;
+      return true;
+    }
+    worker -= cluster.num_cpus;
+  }
+  return false;
+}
+
+#if defined(__ANDROID__) || defined(__linux__)
+
+bool SetCurrentThreadCpus(const CpuSet& cpus) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu = 0; cpu < CpuSet::kMaxCpus && cpu < CPU_SETSIZE; ++cpu) {
+    if (cpus.Contains(cpu)) CPU_SET(cpu, &set);
+  }
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+bool GetCurrentThreadCpus(CpuSet* const cpus) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) != 0) return false;
+  *cpus = CpuSet();
+  for (int cpu = 0; cpu < CpuSet::kMaxCpus && cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &set)) cpus->Add(cpu);
+  }
+  return true;
+}
+
+#else  // !(defined(__ANDROID__) || defined(__linux__))
+
+bool SetCurrentThreadCpus(const CpuSet& /*cpus*/) { return false; }
+
+bool GetCurrentThreadCpus(CpuSet* /*cpus*/) { return false; }
+
+#endif  // defined(__ANDROID__) || defined(__linux__)
+
+}  // namespace libgav1
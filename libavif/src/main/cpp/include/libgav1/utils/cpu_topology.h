@@ -0,0 +1,110 @@
+/*
+ * Copyright 2022 The libgav1 Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LIBGAV1_SRC_UTILS_CPU_TOPOLOGY_H_
+#define LIBGAV1_SRC_UTILS_CPU_TOPOLOGY_H_
+
+#include <atomic>
+#include <cstdint>
+
+#include "src/utils/compiler_attributes.h"
+
+namespace libgav1 {
+
+// A set of CPU numbers, as used by sched_setaffinity().
+class CpuSet {
+ public:
+  // Matches CPU_SETSIZE of glibc and bionic.
+  static constexpr int kMaxCpus = 1024;
+
+  void Add(int cpu);
+  bool Contains(int cpu) const;
+  int Count() const;
+
+ private:
+  uint64_t bits_[kMaxCpus / 64] = {};
+};
+
+// CPUs of equal capacity in one physical package, e.g. the big cores of a
+// big.LITTLE phone or one socket of a server.
+struct CpuCluster {
+  CpuSet cpus;
+  int num_cpus;
+  // cpu_capacity (normalized to 1024 for the fastest core) where the kernel
+  // reports it, the maximum frequency in kHz otherwise, or 0 if unknown.
+  int capacity;
+  // physical_package_id, or -1 if unknown.
+  int package;
+};
+
+// The clusters of the online CPUs, fastest first, as read from sysfs.
+class CpuTopology {
+ public:
+  static constexpr int kMaxClusters = 16;
+
+  // Reads the topology from |cpu_dir|, normally "/sys/devices/system/cpu":
+  // the "online" CPU list, and for every online CPU N the files
+  // cpuN/cpu_capacity, cpuN/cpufreq/cpuinfo_max_freq and
+  // cpuN/topology/physical_package_id, of which any may be missing. CPUs that
+  // would form a cluster beyond kMaxClusters are left out. Returns false if
+  // the online CPU list cannot be read.
+  LIBGAV1_MUST_USE_RESULT bool Read(const char* cpu_dir);
+
+  int num_clusters() const { return num_clusters_; }
+  const CpuCluster& cluster(int index) const { return clusters_[index]; }
+
+ private:
+  CpuCluster clusters_[kMaxClusters];
+  int num_clusters_ = 0;
+};
+
+// Hands out the CPUs that the worker threads of a decoder should run on. The
+// workers are placed in the order they are created, which puts the critical
+// path first: the frame threads or the asynchronous decode thread (which
+// parse), then the tile and superblock row workers. The fastest cluster is
+// filled first, and no cluster gets more workers than it has CPUs; workers
+// beyond the number of CPUs are not pinned. A worker is pinned to its whole
+// cluster rather than to one CPU, so the scheduler still balances within it.
+//
+// Thread-safe.
+class CpuPlacement {
+ public:
+  explicit CpuPlacement(const CpuTopology& topology) : topology_(topology) {}
+
+  // Not copyable or movable.
+  CpuPlacement(const CpuPlacement&) = delete;
+  CpuPlacement& operator=(const CpuPlacement&) = delete;
+
+  // Returns true and stores the CPUs of the next worker in |cpus|, or returns
+  // false if the worker should not be pinned.
+  bool NextWorkerCpus(CpuSet* cpus);
+
+ private:
+  const CpuTopology topology_;
+  std::atomic<int> next_worker_{0};
+};
+
+// Restricts the calling thread to |cpus|. Returns false if that failed or is
+// not supported on this platform.
+bool SetCurrentThreadCpus(const CpuSet& cpus);
+
+// Stores the CPUs the calling thread may run on in |cpus|. Returns false if
+// that is not supported on this platform.
+bool GetCurrentThreadCpus(CpuSet* cpus);
+
+}  // namespace libgav1
+
+#endif  // LIBGAV1_SRC_UTILS_CPU_TOPOLOGY_H_
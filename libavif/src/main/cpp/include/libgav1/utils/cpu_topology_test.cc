@@ -0,0 +1,257 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/utils/cpu_topology.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/obu_parser.h"
+#include "src/threading_strategy.h"
+#include "src/utils/blocking_counter.h"
+#include "src/utils/threadpool.h"
+
+namespace libgav1 {
+namespace {
+
+// Builds a fake /sys/devices/system/cpu tree in a temporary directory.
+class FakeCpuDir {
+ public:
+  FakeCpuDir() {
+    const char* const tmp = getenv("TMPDIR");
+    std::string pattern = std::string(tmp != nullptr ? tmp : "/tmp") +
+                          "/cpu_topology_test.XXXXXX";
+    std::vector<char> buffer(pattern.begin(), pattern.end());
+    buffer.push_back('\0');
+    if (mkdtemp(buffer.data()) != nullptr) dir_ = buffer.data();
+  }
+
+  ~FakeCpuDir() {
+    for (auto it = paths_.rbegin(); it != paths_.rend(); ++it) {
+      remove(it->c_str());
+    }
+    if (!dir_.empty()) rmdir(dir_.c_str());
+  }
+
+  const char* dir() const { return dir_.c_str(); }
+
+  // Writes |contents| to |name|, creating its directories.
+  void Write(const std::string& name, const std::string& contents) {
+    for (size_t slash = name.find('/'); slash != std::string::npos;
+         slash = name.find('/', slash + 1)) {
+      const std::string path = dir_ + "/" + name.substr(0, slash);
+      if (mkdir(path.c_str(), 0700) == 0) paths_.push_back(path);
+    }
+    const std::string path = dir_ + "/" + name;
+    FILE* const file = fopen(path.c_str(), "w");
+    ASSERT_NE(file, nullptr) << path;
+    fputs(contents.c_str(), file);
+    fclose(file);
+    paths_.push_back(path);
+  }
+
+  void WriteCpu(int cpu, const char* file, int value) {
+    Write("cpu" + std::to_string(cpu) + "/" + file,
+          std::to_string(value) + "\n");
+  }
+
+ private:
+  std::string dir_;
+  std::vector<std::string> paths_;
+};
+
+TEST(CpuTopologyTest, CpuSet) {
+  CpuSet cpus;
+  EXPECT_EQ(cpus.Count(), 0);
+  cpus.Add(0);
+  cpus.Add(63);
+  cpus.Add(64);
+  cpus.Add(CpuSet::kMaxCpus - 1);
+  cpus.Add(CpuSet::kMaxCpus);
+  cpus.Add(-1);
+  cpus.Add(64);
+  EXPECT_EQ(cpus.Count(), 4);
+  EXPECT_TRUE(cpus.Contains(63));
+  EXPECT_TRUE(cpus.Contains(64));
+  EXPECT_FALSE(cpus.Contains(1));
+  EXPECT_FALSE(cpus.Contains(CpuSet::kMaxCpus));
+}
+
+TEST(CpuTopologyTest, MissingDirectory) {
+  CpuTopology topology;
+  EXPECT_FALSE(topology.Read("/nonexistent/cpu"));
+  EXPECT_EQ(topology.num_clusters(), 0);
+}
+
+// A phone with 4 little, 3 mid and 1 prime core, of which cpu5 is offline.
+TEST(CpuTopologyTest, BigLittle) {
+  FakeCpuDir fake;
+  ASSERT_NE(fake.dir()[0], '\0');
+  fake.Write("online", "0-4,6-7\n");
+  const int capacities[8] = {325, 325, 325, 325, 829, 829, 829, 1024};
+  for (int cpu = 0; cpu < 8; ++cpu) {
+    fake.WriteCpu(cpu, "cpu_capacity", capacities[cpu]);
+    fake.WriteCpu(cpu, "topology/physical_package_id", 0);
+  }
+  CpuTopology topology;
+  ASSERT_TRUE(topology.Read(fake.dir()));
+  ASSERT_EQ(topology.num_clusters(), 3);
+  EXPECT_EQ(topology.cluster(0).capacity, 1024);
+  EXPECT_EQ(topology.cluster(0).num_cpus, 1);
+  EXPECT_TRUE(topology.cluster(0).cpus.Contains(7));
+  EXPECT_EQ(topology.cluster(1).capacity, 829);
+  EXPECT_EQ(topology.cluster(1).num_cpus, 2);
+  EXPECT_TRUE(topology.cluster(1).cpus.Contains(4));
+  EXPECT_FALSE(topology.cluster(1).cpus.Contains(5));
+  EXPECT_TRUE(topology.cluster(1).cpus.Contains(6));
+  EXPECT_EQ(topology.cluster(2).capacity, 325);
+  EXPECT_EQ(topology.cluster(2).num_cpus, 4);
+  EXPECT_EQ(topology.cluster(2).cpus.Count(), 4);
+
+  // Fastest first, no more workers per cluster than it has CPUs, and nothing
+  // beyond the online CPUs.
+  CpuPlacement placement(topology);
+  const int expected_first_cpus[7] = {7, 4, 4, 0, 0, 0, 0};
+  for (const int first_cpu : expected_first_cpus) {
+    CpuSet cpus;
+    ASSERT_TRUE(placement.NextWorkerCpus(&cpus));
+    EXPECT_TRUE(cpus.Contains(first_cpu)) << first_cpu;
+    EXPECT_EQ(cpus.Count(), (first_cpu == 7) ? 1 : (first_cpu == 4) ? 2 : 4);
+  }
+  CpuSet cpus;
+  EXPECT_FALSE(placement.NextWorkerCpus(&cpus));
+}
+
+// Without cpu_capacity, the maximum frequency ranks the clusters. Equal CPUs in
+// two packages form one cluster per package, the lower package first.
+TEST(CpuTopologyTest, TwoSocketsByFrequency) {
+  FakeCpuDir fake;
+  ASSERT_NE(fake.dir()[0], '\0');
+  fake.Write("online", "0-3\n");
+  for (int cpu = 0; cpu < 4; ++cpu) {
+    fake.WriteCpu(cpu, "cpufreq/cpuinfo_max_freq", 3000000);
+    fake.WriteCpu(cpu, "topology/physical_package_id", 1 - cpu / 2);
+  }
+  CpuTopology topology;
+  ASSERT_TRUE(topology.Read(fake.dir()));
+  ASSERT_EQ(topology.num_clusters(), 2);
+  EXPECT_EQ(topology.cluster(0).package, 0);
+  EXPECT_EQ(topology.cluster(0).capacity, 3000000);
+  EXPECT_TRUE(topology.cluster(0).cpus.Contains(2));
+  EXPECT_TRUE(topology.cluster(0).cpus.Contains(3));
+  EXPECT_EQ(topology.cluster(1).package, 1);
+  EXPECT_TRUE(topology.cluster(1).cpus.Contains(0));
+}
+
+TEST(CpuTopologyTest, NothingKnownButOnline) {
+  FakeCpuDir fake;
+  ASSERT_NE(fake.dir()[0], '\0');
+  fake.Write("online", "0\n");
+  CpuTopology topology;
+  ASSERT_TRUE(topology.Read(fake.dir()));
+  ASSERT_EQ(topology.num_clusters(), 1);
+  EXPECT_EQ(topology.cluster(0).capacity, 0);
+  EXPECT_EQ(topology.cluster(0).package, -1);
+}
+
+TEST(CpuTopologyTest, MalformedOnlineList) {
+  FakeCpuDir fake;
+  ASSERT_NE(fake.dir()[0], '\0');
+  fake.Write("online", "3-1\n");
+  CpuTopology topology;
+  EXPECT_FALSE(topology.Read(fake.dir()));
+}
+
+#if defined(__ANDROID__) || defined(__linux__)
+// The workers of a pool created with a placement run on the CPUs it handed
+// out.
+TEST(CpuTopologyTest, PinsThreadPoolWorkers) {
+  CpuSet allowed;
+  ASSERT_TRUE(GetCurrentThreadCpus(&allowed));
+  int cpu = 0;
+  while (!allowed.Contains(cpu)) ++cpu;
+  FakeCpuDir fake;
+  ASSERT_NE(fake.dir()[0], '\0');
+  fake.Write("online", std::to_string(cpu) + "\n");
+  CpuTopology topology;
+  ASSERT_TRUE(topology.Read(fake.dir()));
+  CpuPlacement placement(topology);
+  // The second worker is not pinned and keeps the affinity of this thread.
+  std::unique_ptr<ThreadPool> pool =
+      ThreadPool::Create("cpu-test", 2, &placement);
+  ASSERT_NE(pool, nullptr);
+  CpuSet worker_cpus[2];
+  BlockingCounter counter(2);
+  // Each job blocks until both have started, so each runs on its own worker.
+  std::atomic<int> started{0};
+  for (int i = 0; i < 2; ++i) {
+    pool->Schedule([&, i]() {
+      started.fetch_add(1);
+      while (started.load() < 2) {
+      }
+      EXPECT_TRUE(GetCurrentThreadCpus(&worker_cpus[i]));
+      counter.Decrement();
+    });
+  }
+  counter.Wait();
+  const int pinned = static_cast<int>(worker_cpus[1].Count() == 1);
+  EXPECT_EQ(worker_cpus[pinned].Count(), 1);
+  EXPECT_TRUE(worker_cpus[pinned].Contains(cpu));
+  EXPECT_EQ(worker_cpus[1 - pinned].Count(), allowed.Count());
+}
+
+// ThreadingStrategy passes its placement to the pool that the tile, row and
+// post filter jobs run on.
+TEST(CpuTopologyTest, PinsThreadingStrategyWorkers) {
+  CpuSet allowed;
+  ASSERT_TRUE(GetCurrentThreadCpus(&allowed));
+  int cpu = 0;
+  while (!allowed.Contains(cpu)) ++cpu;
+  FakeCpuDir fake;
+  ASSERT_NE(fake.dir()[0], '\0');
+  fake.Write("online", std::to_string(cpu) + "\n");
+  CpuTopology topology;
+  ASSERT_TRUE(topology.Read(fake.dir()));
+  CpuPlacement placement(topology);
+  ObuFrameHeader frame_header = {};
+  frame_header.tile_info.tile_count = 1;
+  ThreadingStrategy strategy;
+  // One worker besides the calling thread, which the placement pins.
+  ASSERT_TRUE(strategy.Reset(frame_header, 2, /*shared_thread_pool=*/nullptr,
+                             &placement));
+  ThreadPool* const pool = strategy.post_filter_thread_pool();
+  ASSERT_NE(pool, nullptr);
+  ASSERT_EQ(pool->num_threads(), 1);
+  CpuSet worker_cpus;
+  BlockingCounter counter(1);
+  pool->Schedule([&]() {
+    EXPECT_TRUE(GetCurrentThreadCpus(&worker_cpus));
+    counter.Decrement();
+  });
+  counter.Wait();
+  EXPECT_EQ(worker_cpus.Count(), 1);
+  EXPECT_TRUE(worker_cpus.Contains(cpu));
+}
+#endif  // defined(__ANDROID__) || defined(__linux__)
+
+}  // namespace
+}  // namespace libgav1
@@ -48,6 +48,7 @@ class DynamicBuffer {
   }
 
   size_t size() const { return size_; }
+  size_t allocated_bytes() const { return size_ * sizeof(T); }
 
  private:
   std::unique_ptr<T[]> buffer_;
@@ -75,6 +76,8 @@ class AlignedDynamicBuffer {
     return true;
   }
 
+  size_t allocated_bytes() const { return size_ * sizeof(T); }
+
  private:
   AlignedUniquePtr<T> buffer_;
   size_t size_ = 0;
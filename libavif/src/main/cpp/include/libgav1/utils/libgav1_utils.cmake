@@ -31,14 +31,19 @@ list(APPEND libgav1_utils_sources
             "${libgav1_source}/utils/constants.h"
             "${libgav1_source}/utils/cpu.cc"
             "${libgav1_source}/utils/cpu.h"
+            "${libgav1_source}/utils/cpu_topology.cc"
+            "${libgav1_source}/utils/cpu_topology.h"
             "${libgav1_source}/utils/dynamic_buffer.h"
             "${libgav1_source}/utils/entropy_decoder.cc"
             "${libgav1_source}/utils/entropy_decoder.h"
             "${libgav1_source}/utils/executor.cc"
             "${libgav1_source}/utils/executor.h"
+            "${libgav1_source}/utils/lock_free_queue.h"
             "${libgav1_source}/utils/logging.cc"
             "${libgav1_source}/utils/logging.h"
+            "${libgav1_source}/utils/memory.cc"
             "${libgav1_source}/utils/memory.h"
+            "${libgav1_source}/utils/memory_tracker.h"
             "${libgav1_source}/utils/queue.h"
             "${libgav1_source}/utils/raw_bit_reader.cc"
             "${libgav1_source}/utils/raw_bit_reader.h"
@@ -48,11 +53,16 @@ list(APPEND libgav1_utils_sources
             "${libgav1_source}/utils/segmentation_map.cc"
             "${libgav1_source}/utils/segmentation_map.h"
             "${libgav1_source}/utils/stack.h"
+            "${libgav1_source}/utils/stage_timer.cc"
+            "${libgav1_source}/utils/stage_timer.h"
             "${libgav1_source}/utils/threadpool.cc"
             "${libgav1_source}/utils/threadpool.h"
+            "${libgav1_source}/utils/tracer.cc"
+            "${libgav1_source}/utils/tracer.h"
             "${libgav1_source}/utils/types.h"
             "${libgav1_source}/utils/unbounded_queue.h"
-            "${libgav1_source}/utils/vector.h")
+            "${libgav1_source}/utils/vector.h"
+            "${libgav1_source}/utils/work_stealing_deque.h")
 
 macro(libgav1_add_utils_targets)
   libgav1_add_library(NAME
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2021 The libgav1 Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LIBGAV1_SRC_UTILS_LOCK_FREE_QUEUE_H_
+#define LIBGAV1_SRC_UTILS_LOCK_FREE_QUEUE_H_
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include "src/utils/compiler_attributes.h"
+
+namespace libgav1 {
+
+// A lock-free FIFO queue of a fixed capacity that any number of threads may
+// push to and pop from, after Dmitry Vyukov's bounded MPMC queue. Each cell
+// carries a sequence number that tells a producer when the cell is free and a
+// consumer when it is filled, so that the two ends only contend on their own
+// position counter.
+template <typename T>
+class LockFreeQueue {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "T must be trivially copyable");
+
+ public:
+  LockFreeQueue() = default;
+
+  // Not copyable or movable.
+  LockFreeQueue(const LockFreeQueue&) = delete;
+  LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+  // |capacity| must be a power of 2.
+  LIBGAV1_MUST_USE_RESULT bool Init(size_t capacity) {
+    assert(capacity != 0 && (capacity & (capacity - 1)) == 0);
+    cells_.reset(new (std::nothrow) Cell[capacity]);
+    if (cells_ == nullptr) return false;
+    for (size_t i = 0; i < capacity; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    mask_ = capacity - 1;
+    return true;
+  }
+
+  // Pushes |value| to the end of the queue. Returns false if the queue is
+  // full.
+  bool Push(T value) {
+    size_t position = push_position_.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &cells_[position & mask_];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const intptr_t difference =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+      if (difference == 0) {
+        if (push_position_.compare_exchange_weak(position, position + 1,
+                                                 std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        position = push_position_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = value;
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Pops the element at the front of the queue into |*value|. Returns false if
+  // the queue is empty, or if the element at the front is still being pushed.
+  bool Pop(T* const value) {
+    size_t position = pop_position_.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &cells_[position & mask_];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const intptr_t difference = static_cast<intptr_t>(sequence) -
+                                  static_cast<intptr_t>(position + 1);
+      if (difference == 0) {
+        if (pop_position_.compare_exchange_weak(position, position + 1,
+                                                std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        position = pop_position_.load(std::memory_order_relaxed);
+      }
+    }
+    *value = cell->value;
+    cell->sequence.store(position + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Returns true if the queue appears empty. An element whose push has
+  // started but not finished counts as present.
+  bool Empty() const {
+    return pop_position_.load(std::memory_order_acquire) ==
+           push_position_.load(std::memory_order_acquire);
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  std::atomic<size_t> push_position_{0};
+  std::atomic<size_t> pop_position_{0};
+  size_t mask_ = 0;
+  std::unique_ptr<Cell[]> cells_;
+};
+
+}  // namespace libgav1
+
+#endif  // LIBGAV1_SRC_UTILS_LOCK_FREE_QUEUE_H_
@@ -0,0 +1,108 @@
+// Copyright 2021 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/utils/lock_free_queue.h"
+
+#include <atomic>
+#include <thread>  // NOLINT (unapproved c++11 header)
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace libgav1 {
+namespace {
+
+constexpr int kQueueSize = 8;
+
+TEST(LockFreeQueueTest, Basic) {
+  LockFreeQueue<int> queue;
+  ASSERT_TRUE(queue.Init(kQueueSize));
+  EXPECT_TRUE(queue.Empty());
+
+  for (int i = 0; i < kQueueSize; ++i) {
+    EXPECT_TRUE(queue.Push(i));
+    EXPECT_FALSE(queue.Empty());
+  }
+  // The queue is full.
+  EXPECT_FALSE(queue.Push(kQueueSize));
+
+  int value;
+  for (int i = 0; i < kQueueSize; ++i) {
+    ASSERT_TRUE(queue.Pop(&value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_FALSE(queue.Pop(&value));
+}
+
+TEST(LockFreeQueueTest, WrapAround) {
+  LockFreeQueue<int> queue;
+  ASSERT_TRUE(queue.Init(kQueueSize));
+
+  int value;
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(queue.Push(i));
+    ASSERT_TRUE(queue.Pop(&value));
+    EXPECT_EQ(value, i);
+    EXPECT_TRUE(queue.Empty());
+  }
+}
+
+// Several producers and consumers share the queue. Every element must be
+// popped exactly once, and the elements of each producer in order.
+TEST(LockFreeQueueTest, MultipleProducersAndConsumers) {
+  constexpr int kNumThreads = 4;
+  constexpr int kElementsPerProducer = 50000;
+  LockFreeQueue<int> queue;
+  ASSERT_TRUE(queue.Init(64));
+  std::vector<std::atomic<int>> taken(kNumThreads * kElementsPerProducer);
+  for (auto& count : taken) count = 0;
+  std::atomic<int> num_popped(0);
+  std::atomic<bool> in_order(true);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&queue, i]() {
+      for (int j = 0; j < kElementsPerProducer; ++j) {
+        while (!queue.Push(i * kElementsPerProducer + j)) {
+        }
+      }
+    });
+  }
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&queue, &taken, &num_popped, &in_order]() {
+      int last[kNumThreads];
+      for (auto& element : last) element = -1;
+      int value;
+      while (num_popped.load(std::memory_order_relaxed) <
+             kNumThreads * kElementsPerProducer) {
+        if (!queue.Pop(&value)) continue;
+        ++taken[value];
+        ++num_popped;
+        const int producer = value / kElementsPerProducer;
+        if (value <= last[producer]) in_order = false;
+        last[producer] = value;
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  EXPECT_TRUE(in_order);
+  for (int i = 0; i < kNumThreads * kElementsPerProducer; ++i) {
+    EXPECT_EQ(taken[i], 1) << "element " << i;
+  }
+}
+
+}  // namespace
+}  // namespace libgav1
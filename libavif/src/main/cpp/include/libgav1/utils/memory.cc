@@ -0,0 +1,37 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/utils/memory.h"
+
+namespace libgav1 {
+namespace {
+
+AlignedAllocator g_aligned_allocator = {nullptr, nullptr, nullptr};
+
+}  // namespace
+
+void SetAlignedAllocator(AlignedAllocCallback alloc, AlignedFreeCallback free,
+                         void* callback_private_data) {
+  // A half-installed allocator would pair the system allocator with a custom
+  // free function (or vice versa), so only accept both or neither.
+  if (alloc == nullptr || free == nullptr) {
+    g_aligned_allocator = {nullptr, nullptr, nullptr};
+    return;
+  }
+  g_aligned_allocator = {alloc, free, callback_private_data};
+}
+
+const AlignedAllocator& GetAlignedAllocator() { return g_aligned_allocator; }
+
+}  // namespace libgav1
@@ -29,6 +29,8 @@
 #include <memory>
 #include <new>
 
+#include "src/gav1/allocator.h"
+
 namespace libgav1 {
 
 enum {
@@ -54,18 +56,24 @@ enum {
 //
 // void AlignedFree(void* aligned_memory);
 //   Free aligned memory.
+//
+// Both are routed through the callbacks installed with SetAlignedAllocator()
+// when present, and through SystemAlignedAlloc()/SystemAlignedFree()
+// otherwise.
 
 #if defined(_MSC_VER) || defined(__MINGW32__)
 
-inline void* AlignedAlloc(size_t alignment, size_t size) {
+inline void* SystemAlignedAlloc(size_t alignment, size_t size) {
   return _aligned_malloc(size, alignment);
 }
 
-inline void AlignedFree(void* aligned_memory) { _aligned_free(aligned_memory); }
+inline void SystemAlignedFree(void* aligned_memory) {
+  _aligned_free(aligned_memory);
+}
 
 #else  // !(defined(_MSC_VER) || defined(__MINGW32__))
 
-inline void* AlignedAlloc(size_t alignment, size_t size) {
+inline void* SystemAlignedAlloc(size_t alignment, size_t size) {
 #if defined(__ANDROID__)
   // Although posix_memalign() was introduced in Android API level 17, it is
   // more convenient to use memalign(). Unlike glibc, Android does not consider
@@ -87,10 +95,43 @@ inline void* AlignedAlloc(size_t alignment, size_t size) {
 #endif  // defined(__ANDROID__)
 }
 
-inline void AlignedFree(void* aligned_memory) { free(aligned_memory); }
+inline void SystemAlignedFree(void* aligned_memory) { free(aligned_memory); }
 
 #endif  // defined(_MSC_VER) || defined(__MINGW32__)
 
+struct AlignedAllocator {
+  AlignedAllocCallback alloc;
+  AlignedFreeCallback free;
+  void* callback_private_data;
+};
+
+// Installs the process-wide allocator used by AlignedAlloc() and
+// AlignedFree(). Null callbacks restore the system allocator. See
+// Libgav1SetAllocator() in gav1/allocator.h for the usage restrictions.
+void SetAlignedAllocator(AlignedAllocCallback alloc, AlignedFreeCallback free,
+                         void* callback_private_data);
+
+// Returns the allocator installed by SetAlignedAllocator(). Both callbacks
+// are null when the system allocator is in use.
+const AlignedAllocator& GetAlignedAllocator();
+
+inline void* AlignedAlloc(size_t alignment, size_t size) {
+  const AlignedAllocator& allocator = GetAlignedAllocator();
+  if (allocator.alloc != nullptr) {
+    return allocator.alloc(allocator.callback_private_data, alignment, size);
+  }
+  return SystemAlignedAlloc(alignment, size);
+}
+
+inline void AlignedFree(void* aligned_memory) {
+  const AlignedAllocator& allocator = GetAlignedAllocator();
+  if (allocator.free != nullptr) {
+    allocator.free(allocator.callback_private_data, aligned_memory);
+    return;
+  }
+  SystemAlignedFree(aligned_memory);
+}
+
 inline void Memset(uint8_t* const dst, int value, size_t count) {
   memset(dst, value, count);
 }
@@ -86,6 +86,48 @@ TEST(MemoryTest, TestAlignedUniquePtrAlloc) {
   }
 }
 
+struct AllocatorCounts {
+  int allocs = 0;
+  int frees = 0;
+};
+
+void* CountingAlignedAlloc(void* callback_private_data, size_t alignment,
+                           size_t size) {
+  ++static_cast<AllocatorCounts*>(callback_private_data)->allocs;
+  return SystemAlignedAlloc(alignment, size);
+}
+
+void CountingAlignedFree(void* callback_private_data, void* ptr) {
+  if (ptr != nullptr) {
+    ++static_cast<AllocatorCounts*>(callback_private_data)->frees;
+  }
+  SystemAlignedFree(ptr);
+}
+
+TEST(MemoryTest, TestSetAlignedAllocator) {
+  AllocatorCounts counts;
+  SetAlignedAllocator(CountingAlignedAlloc, CountingAlignedFree, &counts);
+  void* p = AlignedAlloc(32, 100);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % 32, 0);
+  AlignedFree(p);
+  {
+    auto q = MakeAlignedUniquePtr<uint16_t>(16, 8);
+    ASSERT_NE(q, nullptr);
+  }
+  EXPECT_EQ(counts.allocs, 2);
+  EXPECT_EQ(counts.frees, 2);
+
+  // A partial allocator is rejected and the system allocator is restored.
+  SetAlignedAllocator(CountingAlignedAlloc, nullptr, &counts);
+  EXPECT_EQ(GetAlignedAllocator().alloc, nullptr);
+  p = AlignedAlloc(32, 100);
+  ASSERT_NE(p, nullptr);
+  AlignedFree(p);
+  EXPECT_EQ(counts.allocs, 2);
+  EXPECT_EQ(counts.frees, 2);
+}
+
 TEST(MemoryTest, TestAllocable) {
   // Allocable::operator new (std::nothrow) is called.
   std::unique_ptr<Small> small(new (std::nothrow) Small);
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2022 The libgav1 Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LIBGAV1_SRC_UTILS_MEMORY_TRACKER_H_
+#define LIBGAV1_SRC_UTILS_MEMORY_TRACKER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "src/gav1/memory_usage.h"
+#include "src/utils/compiler_attributes.h"
+
+namespace libgav1 {
+
+// Counts the bytes a decoder holds in each MemoryClass, and enforces its
+// memory limit. The owners of the memory report what they allocate and free:
+// BufferPool the frame buffers, and DecoderImpl the frame scratch buffers.
+//
+// Thread-safe.
+class MemoryTracker {
+ public:
+  // A |limit| of 0 means no limit.
+  explicit MemoryTracker(size_t limit) : limit_(limit) {
+    for (auto& bytes : bytes_) bytes.store(0, std::memory_order_relaxed);
+  }
+
+  // Not copyable or movable.
+  MemoryTracker(const MemoryTracker&) = delete;
+  MemoryTracker& operator=(const MemoryTracker&) = delete;
+
+  size_t limit() const { return limit_; }
+
+  // Adds |bytes|, which may be negative, to |memory_class|.
+  void Add(MemoryClass memory_class, int64_t bytes) {
+    bytes_[memory_class].fetch_add(bytes, std::memory_order_relaxed);
+    UpdatePeak(total_.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+  }
+
+  // Adds |bytes| to |memory_class| if that keeps the total within the limit.
+  // Returns false, and adds nothing, otherwise.
+  LIBGAV1_MUST_USE_RESULT bool Reserve(MemoryClass memory_class, size_t bytes) {
+    if (limit_ == 0) {
+      Add(memory_class, static_cast<int64_t>(bytes));
+      return true;
+    }
+    int64_t total = total_.load(std::memory_order_relaxed);
+    do {
+      if (bytes > limit_ || total > static_cast<int64_t>(limit_ - bytes)) {
+        return false;
+      }
+    } while (!total_.compare_exchange_weak(
+        total, total + static_cast<int64_t>(bytes), std::memory_order_relaxed));
+    bytes_[memory_class].fetch_add(static_cast<int64_t>(bytes),
+                                   std::memory_order_relaxed);
+    UpdatePeak(total + static_cast<int64_t>(bytes));
+    return true;
+  }
+
+  // Moves |bytes| from |from| to |to|.
+  void Move(MemoryClass from, MemoryClass to, size_t bytes) {
+    bytes_[from].fetch_sub(static_cast<int64_t>(bytes),
+                           std::memory_order_relaxed);
+    bytes_[to].fetch_add(static_cast<int64_t>(bytes),
+                         std::memory_order_relaxed);
+  }
+
+  size_t total_bytes() const {
+    return static_cast<size_t>(
+        std::max<int64_t>(total_.load(std::memory_order_relaxed), 0));
+  }
+
+  // Returns the bytes that may still be allocated within the limit, or
+  // SIZE_MAX if there is no limit.
+  size_t available_bytes() const {
+    if (limit_ == 0) return SIZE_MAX;
+    const size_t total = total_bytes();
+    return (total < limit_) ? limit_ - total : 0;
+  }
+
+  // Records that a strategy that needs less memory was chosen.
+  void CountReduction() {
+    num_reductions_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void GetUsage(MemoryUsage* const usage) const {
+    for (int i = 0; i < kNumMemoryClasses; ++i) {
+      usage->bytes[i] = static_cast<size_t>(
+          std::max<int64_t>(bytes_[i].load(std::memory_order_relaxed), 0));
+    }
+    usage->total_bytes = total_bytes();
+    usage->peak_total_bytes =
+        static_cast<size_t>(peak_.load(std::memory_order_relaxed));
+    usage->limit_bytes = limit_;
+    usage->num_reductions = num_reductions_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  void UpdatePeak(int64_t total) {
+    int64_t peak = peak_.load(std::memory_order_relaxed);
+    while (total > peak && !peak_.compare_exchange_weak(
+                               peak, total, std::memory_order_relaxed)) {
+    }
+  }
+
+  const size_t limit_;
+  std::atomic<int64_t> bytes_[kNumMemoryClasses];
+  std::atomic<int64_t> total_{0};
+  std::atomic<int64_t> peak_{0};
+  std::atomic<int> num_reductions_{0};
+};
+
+}  // namespace libgav1
+
+#endif  // LIBGAV1_SRC_UTILS_MEMORY_TRACKER_H_
@@ -0,0 +1,111 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/utils/memory_tracker.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>  // NOLINT (unapproved c++11 header)
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace libgav1 {
+namespace {
+
+TEST(MemoryTrackerTest, AddAndMove) {
+  MemoryTracker tracker(0);
+  tracker.Add(kMemoryClassFrameBuffers, 1000);
+  tracker.Add(kMemoryClassTileScratch, 200);
+  tracker.Move(kMemoryClassFrameBuffers, kMemoryClassFilmGrainFrames, 300);
+  tracker.Add(kMemoryClassTileScratch, -50);
+
+  MemoryUsage usage;
+  tracker.GetUsage(&usage);
+  EXPECT_EQ(usage.bytes[kMemoryClassFrameBuffers], 700u);
+  EXPECT_EQ(usage.bytes[kMemoryClassFilmGrainFrames], 300u);
+  EXPECT_EQ(usage.bytes[kMemoryClassTileScratch], 150u);
+  EXPECT_EQ(usage.bytes[kMemoryClassResiduals], 0u);
+  EXPECT_EQ(usage.total_bytes, 1150u);
+  EXPECT_EQ(usage.peak_total_bytes, 1200u);
+  EXPECT_EQ(usage.limit_bytes, 0u);
+  EXPECT_EQ(usage.num_reductions, 0);
+  EXPECT_EQ(tracker.available_bytes(), SIZE_MAX);
+}
+
+TEST(MemoryTrackerTest, NoLimitReservesEverything) {
+  MemoryTracker tracker(0);
+  EXPECT_TRUE(tracker.Reserve(kMemoryClassFrameBuffers, SIZE_MAX / 2));
+  EXPECT_EQ(tracker.total_bytes(), SIZE_MAX / 2);
+}
+
+TEST(MemoryTrackerTest, ReserveRespectsLimit) {
+  MemoryTracker tracker(1000);
+  EXPECT_EQ(tracker.limit(), 1000u);
+  EXPECT_TRUE(tracker.Reserve(kMemoryClassFrameBuffers, 600));
+  EXPECT_EQ(tracker.available_bytes(), 400u);
+  EXPECT_FALSE(tracker.Reserve(kMemoryClassFrameBuffers, 401));
+  EXPECT_FALSE(tracker.Reserve(kMemoryClassFrameBuffers, SIZE_MAX));
+  EXPECT_EQ(tracker.total_bytes(), 600u);
+  EXPECT_TRUE(tracker.Reserve(kMemoryClassResiduals, 400));
+  EXPECT_EQ(tracker.available_bytes(), 0u);
+
+  // Add() is not checked against the limit.
+  tracker.Add(kMemoryClassFrameScratch, 100);
+  EXPECT_EQ(tracker.total_bytes(), 1100u);
+  EXPECT_EQ(tracker.available_bytes(), 0u);
+  EXPECT_FALSE(tracker.Reserve(kMemoryClassFrameScratch, 1));
+
+  tracker.Add(kMemoryClassFrameBuffers, -600);
+  EXPECT_EQ(tracker.available_bytes(), 500u);
+  tracker.CountReduction();
+
+  MemoryUsage usage;
+  tracker.GetUsage(&usage);
+  EXPECT_EQ(usage.bytes[kMemoryClassFrameBuffers], 0u);
+  EXPECT_EQ(usage.bytes[kMemoryClassResiduals], 400u);
+  EXPECT_EQ(usage.bytes[kMemoryClassFrameScratch], 100u);
+  EXPECT_EQ(usage.total_bytes, 500u);
+  EXPECT_EQ(usage.peak_total_bytes, 1100u);
+  EXPECT_EQ(usage.limit_bytes, 1000u);
+  EXPECT_EQ(usage.num_reductions, 1);
+}
+
+TEST(MemoryTrackerTest, ConcurrentReservesStayWithinLimit) {
+  constexpr int kNumThreads = 4;
+  constexpr int kReservesPerThread = 1000;
+  constexpr size_t kLimit = 100 * 64;
+  MemoryTracker tracker(kLimit);
+  std::atomic<int> num_reserved(0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&tracker, &num_reserved]() {
+      for (int j = 0; j < kReservesPerThread; ++j) {
+        if (tracker.Reserve(kMemoryClassTileScratch, 64)) ++num_reserved;
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  EXPECT_EQ(num_reserved.load(), 100);
+  MemoryUsage usage;
+  tracker.GetUsage(&usage);
+  EXPECT_EQ(usage.total_bytes, kLimit);
+  EXPECT_EQ(usage.bytes[kMemoryClassTileScratch], kLimit);
+  EXPECT_EQ(usage.peak_total_bytes, kLimit);
+}
+
+}  // namespace
+}  // namespace libgav1
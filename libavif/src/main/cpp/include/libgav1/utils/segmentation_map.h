@@ -17,6 +17,7 @@
 #ifndef LIBGAV1_SRC_UTILS_SEGMENTATION_MAP_H_
 #define LIBGAV1_SRC_UTILS_SEGMENTATION_MAP_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 
@@ -56,6 +57,12 @@ class SegmentationMap {
   void FillBlock(int row4x4, int column4x4, int block_width4x4,
                  int block_height4x4, int8_t segment_id);
 
+  size_t allocated_bytes() const {
+    return (segment_id_buffer_ == nullptr)
+               ? 0
+               : static_cast<size_t>(rows4x4_) * columns4x4_;
+  }
+
  private:
   int32_t rows4x4_ = 0;
   int32_t columns4x4_ = 0;
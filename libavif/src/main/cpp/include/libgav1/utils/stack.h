@@ -47,6 +47,9 @@ class Stack {
   // Returns true if the stack is empty.
   bool Empty() const { return top_ < 0; }
 
+  // Returns the number of elements in the stack.
+  int Size() const { return top_ + 1; }
+
  private:
   static_assert(capacity > 0, "");
   T elements_[capacity];
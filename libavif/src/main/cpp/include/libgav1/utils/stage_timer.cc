@@ -0,0 +1,71 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/utils/stage_timer.h"
+
+#include <chrono>  // NOLINT (unapproved c++11 header)
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace libgav1 {
+namespace {
+
+thread_local StageTimingCallbackInfo thread_stage_timing_callback = {nullptr,
+                                                                     nullptr};
+
+}  // namespace
+
+void SetThreadStageTimingCallback(StageTimingCallback callback,
+                                  void* callback_private_data) {
+  thread_stage_timing_callback = {callback, callback_private_data};
+}
+
+const StageTimingCallbackInfo& GetThreadStageTimingCallback() {
+  return thread_stage_timing_callback;
+}
+
+int64_t GetWallTimeNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+int64_t GetProcessCpuTimeNs() {
+#if defined(_WIN32)
+  FILETIME creation_time;
+  FILETIME exit_time;
+  FILETIME kernel_time;
+  FILETIME user_time;
+  if (!GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time,
+                       &kernel_time, &user_time)) {
+    return 0;
+  }
+  const auto to_ns = [](const FILETIME& t) {
+    // FILETIME is in 100 ns units.
+    return ((static_cast<int64_t>(t.dwHighDateTime) << 32) | t.dwLowDateTime) *
+           100;
+  };
+  return to_ns(kernel_time) + to_ns(user_time);
+#else
+  struct timespec ts;
+  if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) != 0) return 0;
+  return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+}  // namespace libgav1
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2022 The libgav1 Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LIBGAV1_SRC_UTILS_STAGE_TIMER_H_
+#define LIBGAV1_SRC_UTILS_STAGE_TIMER_H_
+
+#include <cstdint>
+
+#include "src/gav1/stage_timing.h"
+#include "src/utils/tracer.h"
+
+namespace libgav1 {
+
+struct StageTimingCallbackInfo {
+  StageTimingCallback callback;
+  void* callback_private_data;
+};
+
+// Sets the stage timing callback of the calling thread.
+void SetThreadStageTimingCallback(StageTimingCallback callback,
+                                  void* callback_private_data);
+
+// Returns the stage timing callback of the calling thread. |callback| is null
+// when timing is disabled.
+const StageTimingCallbackInfo& GetThreadStageTimingCallback();
+
+// Monotonic wall clock and process CPU clock readings in nanoseconds.
+int64_t GetWallTimeNs();
+int64_t GetProcessCpuTimeNs();
+
+// Reports the time spent between construction and destruction to the stage
+// timing callback of the current thread, and records it as a trace event
+// while tracing. Does nothing (and reads no clocks) when the thread has no
+// callback and tracing is off.
+class ScopedStageTimer {
+ public:
+  explicit ScopedStageTimer(DecodeStage stage)
+      : info_(GetThreadStageTimingCallback()),
+        stage_(stage),
+        trace_event_(static_cast<TraceEventType>(stage)) {
+    if (info_.callback == nullptr) return;
+    start_wall_ns_ = GetWallTimeNs();
+    start_cpu_ns_ = GetProcessCpuTimeNs();
+  }
+
+  // Not copyable or movable.
+  ScopedStageTimer(const ScopedStageTimer&) = delete;
+  ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+  ~ScopedStageTimer() { Stop(); }
+
+  // Reports the time spent so far. Later calls and the destructor do nothing.
+  void Stop() {
+    trace_event_.Stop();
+    if (stopped_ || info_.callback == nullptr) return;
+    stopped_ = true;
+    info_.callback(info_.callback_private_data, stage_,
+                   GetWallTimeNs() - start_wall_ns_,
+                   GetProcessCpuTimeNs() - start_cpu_ns_);
+  }
+
+ private:
+  // A copy, so that a callback change within the scope does not send the stop
+  // to a different callback than the start.
+  const StageTimingCallbackInfo info_;
+  bool stopped_ = false;
+  const DecodeStage stage_;
+  int64_t start_wall_ns_ = 0;
+  int64_t start_cpu_ns_ = 0;
+  ScopedTraceEvent trace_event_;
+};
+
+}  // namespace libgav1
+
+#endif  // LIBGAV1_SRC_UTILS_STAGE_TIMER_H_
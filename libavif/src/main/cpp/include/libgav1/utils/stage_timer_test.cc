@@ -0,0 +1,108 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/utils/stage_timer.h"
+
+#include <cstdint>
+#include <thread>  // NOLINT (unapproved c++11 header)
+
+#include "gtest/gtest.h"
+#include "src/gav1/stage_timing.h"
+
+namespace libgav1 {
+namespace {
+
+struct StageTotals {
+  int calls[kLibgav1NumDecodeStages] = {};
+  int64_t wall_time_ns[kLibgav1NumDecodeStages] = {};
+  int64_t cpu_time_ns[kLibgav1NumDecodeStages] = {};
+};
+
+void AccumulateStageTime(void* callback_private_data, DecodeStage stage,
+                         int64_t wall_time_ns, int64_t cpu_time_ns) {
+  auto* const totals = static_cast<StageTotals*>(callback_private_data);
+  ++totals->calls[stage];
+  totals->wall_time_ns[stage] += wall_time_ns;
+  totals->cpu_time_ns[stage] += cpu_time_ns;
+}
+
+TEST(StageTimerTest, NoCallback) {
+  SetStageTimingCallback(nullptr, nullptr);
+  EXPECT_EQ(GetThreadStageTimingCallback().callback, nullptr);
+  // Must not crash or report anything.
+  ScopedStageTimer timer(kLibgav1DecodeStageParse);
+}
+
+TEST(StageTimerTest, ReportsOncePerScope) {
+  StageTotals totals;
+  SetStageTimingCallback(AccumulateStageTime, &totals);
+  {
+    ScopedStageTimer timer(kLibgav1DecodeStageCdef);
+    volatile int sink = 0;
+    for (int i = 0; i < 100000; ++i) sink = sink + i;
+  }
+  {
+    ScopedStageTimer timer(kLibgav1DecodeStageCdef);
+  }
+  {
+    ScopedStageTimer timer(kLibgav1DecodeStageOutput);
+    timer.Stop();
+    timer.Stop();
+  }
+  SetStageTimingCallback(nullptr, nullptr);
+  {
+    ScopedStageTimer timer(kLibgav1DecodeStageCdef);
+  }
+
+  EXPECT_EQ(totals.calls[kLibgav1DecodeStageCdef], 2);
+  EXPECT_EQ(totals.calls[kLibgav1DecodeStageOutput], 1);
+  EXPECT_EQ(totals.calls[kLibgav1DecodeStageParse], 0);
+  EXPECT_GT(totals.wall_time_ns[kLibgav1DecodeStageCdef], 0);
+  EXPECT_GE(totals.cpu_time_ns[kLibgav1DecodeStageCdef], 0);
+}
+
+TEST(StageTimerTest, CallbackIsPerThread) {
+  StageTotals totals;
+  SetStageTimingCallback(AccumulateStageTime, &totals);
+  std::thread other([]() {
+    EXPECT_EQ(GetThreadStageTimingCallback().callback, nullptr);
+    ScopedStageTimer timer(kLibgav1DecodeStageTileDecode);
+  });
+  other.join();
+  SetStageTimingCallback(nullptr, nullptr);
+  EXPECT_EQ(totals.calls[kLibgav1DecodeStageTileDecode], 0);
+}
+
+// A scope reports to the callback that was installed when it started.
+TEST(StageTimerTest, ReportsToCallbackAtStart) {
+  StageTotals first;
+  StageTotals second;
+  SetStageTimingCallback(AccumulateStageTime, &first);
+  {
+    ScopedStageTimer timer(kLibgav1DecodeStageDeblock);
+    SetStageTimingCallback(AccumulateStageTime, &second);
+  }
+  SetStageTimingCallback(nullptr, nullptr);
+  EXPECT_EQ(first.calls[kLibgav1DecodeStageDeblock], 1);
+  EXPECT_EQ(second.calls[kLibgav1DecodeStageDeblock], 0);
+}
+
+TEST(StageTimerTest, Clocks) {
+  const int64_t wall = GetWallTimeNs();
+  EXPECT_GE(GetWallTimeNs(), wall);
+  EXPECT_GE(GetProcessCpuTimeNs(), 0);
+}
+
+}  // namespace
+}  // namespace libgav1
@@ -25,6 +25,7 @@
 #include <unistd.h>
 #endif
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cinttypes>
 #include <cstddef>
@@ -54,17 +55,31 @@ static pid_t GetTid() { return static_cast<pid_t>(syscall(SYS_gettid)); }
 #endif  // defined(__GLIBC__)
 
 namespace libgav1 {
-
-#if defined(__ANDROID__)
 namespace {
 
+// The capacity of each worker's deque. A worker that fills its deque schedules
+// further jobs in the shared queue.
+constexpr size_t kWorkerQueueSize = 256;
+// The capacity of the shared queue. Further jobs go to the overflow queue.
+constexpr size_t kSharedQueueSize = 1024;
+
+#if defined(__ANDROID__)
 using Clock = std::chrono::steady_clock;
 using Duration = Clock::duration;
 constexpr Duration kBusyWaitDuration =
     std::chrono::duration_cast<Duration>(std::chrono::duration<double>(2e-3));
+#endif  // defined(__ANDROID__)
+
+// Identifies the pool and the worker index of the calling thread, if it is a
+// worker thread.
+struct WorkerIdentity {
+  const void* pool;
+  int index;
+};
+
+thread_local WorkerIdentity current_worker = {nullptr, -1};
 
 }  // namespace
-#endif  // defined(__ANDROID__)
 
 // static
 std::unique_ptr<ThreadPool> ThreadPool::Create(int num_threads) {
@@ -74,18 +89,39 @@ std::unique_ptr<ThreadPool> ThreadPool::Create(int num_threads) {
 // static
 std::unique_ptr<ThreadPool> ThreadPool::Create(const char name_prefix[],
                                                int num_threads) {
+  return Create(name_prefix, num_threads, /*placement=*/nullptr);
+}
+
+// static
+std::unique_ptr<ThreadPool> ThreadPool::Create(const char name_prefix[],
+                                               int num_threads,
+                                               CpuPlacement* const placement) {
   if (name_prefix == nullptr || num_threads <= 0) return nullptr;
   std::unique_ptr<WorkerThread*[]> threads(new (std::nothrow)
                                                WorkerThread*[num_threads]);
   if (threads == nullptr) return nullptr;
   std::unique_ptr<ThreadPool> pool(new (std::nothrow) ThreadPool(
       name_prefix, std::move(threads), num_threads));
-  if (pool != nullptr && !pool->StartWorkers()) {
+  if (pool != nullptr && !pool->StartWorkers(placement)) {
     pool = nullptr;
   }
   return pool;
 }
 
+// static
+std::unique_ptr<ThreadPool> ThreadPool::Create(ThreadPool* const shared_pool,
+                                               int num_threads) {
+  if (shared_pool == nullptr || num_threads <= 0) return nullptr;
+  std::unique_ptr<ThreadPool> pool(new (std::nothrow)
+                                       ThreadPool(shared_pool, num_threads));
+  if (pool == nullptr) return nullptr;
+  pool->LockMutex();
+  const bool overflow_queue_initialized = pool->overflow_queue_.Init();
+  pool->UnlockMutex();
+  if (!overflow_queue_initialized) return nullptr;
+  return pool;
+}
+
 ThreadPool::ThreadPool(const char name_prefix[],
                        std::unique_ptr<WorkerThread*[]> threads,
                        int num_threads)
@@ -98,22 +134,161 @@ ThreadPool::ThreadPool(const char name_prefix[],
   name_prefix_[name_prefix_len] = '\0';
 }
 
+ThreadPool::ThreadPool(ThreadPool* const shared_pool, int num_threads)
+    : shared_pool_(shared_pool), num_threads_(num_threads) {
+  name_prefix_[0] = '\0';
+}
+
 ThreadPool::~ThreadPool() { Shutdown(); }
 
 void ThreadPool::Schedule(std::function<void()> closure) {
-  LockMutex();
-  if (!queue_.GrowIfNeeded()) {
-    // queue_ is full and we can't grow it. Run |closure| directly.
-    UnlockMutex();
+  auto* const job = new (std::nothrow) Closure(std::move(closure));
+  if (job == nullptr) {
+    // The allocation failed before |closure| was moved from. Run it directly.
     closure();
     return;
   }
-  queue_.Push(std::move(closure));
+  if (shared_pool_ != nullptr) {
+    ScheduleOnSharedPool(job);
+    return;
+  }
+  const int worker_index = CurrentWorkerIndex();
+  if ((worker_index < 0 || !worker_queues_[worker_index].Push(job)) &&
+      !PushSharedJob(job)) {
+    // The queues are full and we can't grow them. Run |job| directly.
+    (*job)();
+    delete job;
+    return;
+  }
+  SignalIdleWorker();
+}
+
+bool ThreadPool::RunPendingJob() {
+  Closure* job;
+  if (shared_pool_ != nullptr) {
+    // Prefer the jobs of this pool that are still waiting for a slot. If there
+    // are none, help with whatever is queued on the shared pool.
+    LockMutex();
+    const bool found = !overflow_queue_.Empty();
+    if (found) {
+      job = overflow_queue_.Front();
+      overflow_queue_.Pop();
+    }
+    UnlockMutex();
+    if (!found) return shared_pool_->RunPendingJob();
+    (*job)();
+    delete job;
+    return true;
+  }
+  if (!TakeJob(CurrentWorkerIndex(), &job)) return false;
+  (*job)();
+  delete job;
+  return true;
+}
+
+int ThreadPool::num_threads() const { return num_threads_; }
+
+int ThreadPool::CurrentWorkerIndex() const {
+  return (current_worker.pool == this) ? current_worker.index : -1;
+}
+
+bool ThreadPool::PushSharedJob(Closure* const job) {
+  // Once jobs have spilled over, keep using |overflow_queue_| until it drains
+  // so that the jobs are still taken in the order they were scheduled.
+  if (overflow_size_.load(std::memory_order_acquire) == 0 &&
+      shared_queue_.Push(job)) {
+    return true;
+  }
+  LockMutex();
+  if (!overflow_queue_.GrowIfNeeded()) {
+    UnlockMutex();
+    return false;
+  }
+  overflow_queue_.Push(job);
+  overflow_size_.fetch_add(1, std::memory_order_release);
+  UnlockMutex();
+  return true;
+}
+
+bool ThreadPool::TakeJob(int worker_index, Closure** const job) {
+  if (worker_index >= 0 && worker_queues_[worker_index].Pop(job)) return true;
+  if (shared_queue_.Pop(job)) return true;
+  if (overflow_size_.load(std::memory_order_acquire) != 0) {
+    LockMutex();
+    const bool found = !overflow_queue_.Empty();
+    if (found) {
+      *job = overflow_queue_.Front();
+      overflow_queue_.Pop();
+      overflow_size_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    UnlockMutex();
+    if (found) return true;
+  }
+  // Start with the worker after |worker_index| so that the thieves spread out
+  // over the deques.
+  for (int i = 1; i <= num_threads_; ++i) {
+    const int victim = (worker_index + i) % num_threads_;
+    if (victim == worker_index) continue;
+    if (worker_queues_[victim].Steal(job)) return true;
+  }
+  return false;
+}
+
+bool ThreadPool::HasPendingJobs() const {
+  if (!shared_queue_.Empty() ||
+      overflow_size_.load(std::memory_order_acquire) != 0) {
+    return true;
+  }
+  for (int i = 0; i < num_threads_; ++i) {
+    if (!worker_queues_[i].Empty()) return true;
+  }
+  return false;
+}
+
+void ThreadPool::SignalIdleWorker() {
+  // Pairs with the fence in WorkerFunction(): either this thread sees the idle
+  // worker, or the worker sees the job that was just queued.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (num_idle_workers_.load(std::memory_order_relaxed) == 0) return;
+  // An idle worker holds the mutex from the time it counts itself as idle
+  // until it waits, so taking the mutex here ensures the signal is not lost.
+  LockMutex();
   UnlockMutex();
   SignalOne();
 }
 
-int ThreadPool::num_threads() const { return num_threads_; }
+void ThreadPool::ScheduleOnSharedPool(Closure* const job) {
+  LockMutex();
+  if (num_shared_pool_jobs_ == num_threads_) {
+    const bool queued = overflow_queue_.GrowIfNeeded();
+    if (queued) overflow_queue_.Push(job);
+    UnlockMutex();
+    if (!queued) {
+      // The queue is full and we can't grow it. Run |job| directly.
+      (*job)();
+      delete job;
+    }
+    return;
+  }
+  ++num_shared_pool_jobs_;
+  UnlockMutex();
+  shared_pool_->Schedule([this, job]() { RunSharedPoolJobs(job); });
+}
+
+void ThreadPool::RunSharedPoolJobs(Closure* job) {
+  while (true) {
+    (*job)();
+    delete job;
+    LockMutex();
+    if (overflow_queue_.Empty()) break;
+    job = overflow_queue_.Front();
+    overflow_queue_.Pop();
+    UnlockMutex();
+  }
+  // Shutdown() waits for the last job to finish.
+  if (--num_shared_pool_jobs_ == 0) SignalAll();
+  UnlockMutex();
+}
 
 // A simple implementation that mirrors the non-portable Thread.  We may
 // choose to expand this in the future as a portable implementation of
@@ -121,7 +296,7 @@ int ThreadPool::num_threads() const { return num_threads_; }
 class ThreadPool::WorkerThread : public Allocable {
  public:
   // Creates and starts a thread that runs pool->WorkerFunction().
-  explicit WorkerThread(ThreadPool* pool);
+  WorkerThread(ThreadPool* pool, int index);
 
   // Not copyable or movable.
   WorkerThread(const WorkerThread&) = delete;
@@ -131,6 +306,13 @@ class ThreadPool::WorkerThread : public Allocable {
   // succeeded.
   ~WorkerThread() = default;
 
+  // Restricts the thread to |cpus| once it runs. Must be called before
+  // Start().
+  void SetCpus(const CpuSet& cpus) {
+    cpus_ = cpus;
+    pinned_ = true;
+  }
+
   LIBGAV1_MUST_USE_RESULT bool Start();
 
   // Joins with the running thread.
@@ -147,6 +329,9 @@ class ThreadPool::WorkerThread : public Allocable {
   void Run();
 
   ThreadPool* pool_;
+  const int index_;
+  CpuSet cpus_;
+  bool pinned_ = false;
 #if defined(_MSC_VER)
   HANDLE handle_;
 #else
@@ -154,7 +339,8 @@ class ThreadPool::WorkerThread : public Allocable {
 #endif
 };
 
-ThreadPool::WorkerThread::WorkerThread(ThreadPool* pool) : pool_(pool) {}
+ThreadPool::WorkerThread::WorkerThread(ThreadPool* pool, int index)
+    : pool_(pool), index_(index) {}
 
 #if defined(_MSC_VER)
 
@@ -235,14 +421,31 @@ void ThreadPool::WorkerThread::SetupName() {
 
 void ThreadPool::WorkerThread::Run() {
   SetupName();
-  pool_->WorkerFunction();
+  // Pinning is a hint; the worker runs wherever the scheduler puts it if the
+  // affinity cannot be set.
+  if (pinned_) static_cast<void>(SetCurrentThreadCpus(cpus_));
+  pool_->WorkerFunction(index_);
 }
 
-bool ThreadPool::StartWorkers() {
-  if (!queue_.Init()) return false;
+bool ThreadPool::StartWorkers(CpuPlacement* const placement) {
+  worker_queues_.reset(new (std::nothrow)
+                           WorkStealingDeque<Closure*>[num_threads_]);
+  if (worker_queues_ == nullptr) return false;
   for (int i = 0; i < num_threads_; ++i) {
-    threads_[i] = new (std::nothrow) WorkerThread(this);
+    if (!worker_queues_[i].Init(kWorkerQueueSize)) return false;
+  }
+  if (!shared_queue_.Init(kSharedQueueSize)) return false;
+  LockMutex();
+  const bool overflow_queue_initialized = overflow_queue_.Init();
+  UnlockMutex();
+  if (!overflow_queue_initialized) return false;
+  for (int i = 0; i < num_threads_; ++i) {
+    threads_[i] = new (std::nothrow) WorkerThread(this, i);
     if (threads_[i] == nullptr) return false;
+    CpuSet cpus;
+    if (placement != nullptr && placement->NextWorkerCpus(&cpus)) {
+      threads_[i]->SetCpus(cpus);
+    }
     if (!threads_[i]->Start()) {
       delete threads_[i];
       threads_[i] = nullptr;
@@ -252,64 +455,65 @@ bool ThreadPool::StartWorkers() {
   return true;
 }
 
-void ThreadPool::WorkerFunction() {
-  LockMutex();
+void ThreadPool::WorkerFunction(int worker_index) {
+  current_worker = {this, worker_index};
   while (true) {
-    if (queue_.Empty()) {
-      if (exit_threads_) {
-        break;  // Queue is empty and exit was requested.
-      }
+    Closure* job;
+    if (TakeJob(worker_index, &job)) {
+      // Note that it is good practice to surround this with a try/catch so
+      // the thread pool doesn't go to hell if the job throws an exception.
+      // This is omitted here because Google3 doesn't like exceptions.
+      (*job)();
+      delete job;
+      continue;
+    }
 #if defined(__ANDROID__)
-      // On android, if we go to a conditional wait right away, the CPU governor
-      // kicks in and starts shutting the cores down. So we do a very small busy
-      // wait to see if we get our next job within that period. This
-      // significantly improves the performance of common cases of tile parallel
-      // decoding. If we don't receive a job in the busy wait time, we then go
-      // to an actual conditional wait as usual.
-      UnlockMutex();
-      bool found_job = false;
-      const auto wait_start = Clock::now();
-      while (Clock::now() - wait_start < kBusyWaitDuration) {
-        LockMutex();
-        if (!queue_.Empty()) {
-          found_job = true;
-          break;
-        }
-        UnlockMutex();
+    // On android, if we go to a conditional wait right away, the CPU governor
+    // kicks in and starts shutting the cores down. So we do a very small busy
+    // wait to see if we get our next job within that period. This
+    // significantly improves the performance of common cases of tile parallel
+    // decoding. If we don't receive a job in the busy wait time, we then go
+    // to an actual conditional wait as usual. The queues are checked without
+    // taking the mutex.
+    bool found_job = false;
+    const auto wait_start = Clock::now();
+    while (Clock::now() - wait_start < kBusyWaitDuration) {
+      if (HasPendingJobs()) {
+        found_job = true;
+        break;
       }
-      // If |found_job| is true, we simply continue since we already hold the
-      // mutex and we know for sure that the |queue_| is not empty.
-      if (found_job) continue;
-      // Since |found_job_| was false, the mutex is not being held at this
-      // point.
-      LockMutex();
-      // Ensure that the queue is still empty.
-      if (!queue_.Empty()) continue;
+    }
+    if (found_job) continue;
+#endif  // defined(__ANDROID__)
+    LockMutex();
+    num_idle_workers_.fetch_add(1, std::memory_order_relaxed);
+    // Pairs with the fence in SignalIdleWorker().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    bool exit = false;
+    if (!HasPendingJobs()) {
       if (exit_threads_) {
-        break;  // Queue is empty and exit was requested.
+        exit = true;  // Queues are empty and exit was requested.
+      } else {
+        // Queues are still empty, wait for signal or broadcast.
+        Wait();
       }
-#endif  // defined(__ANDROID__)
-      // Queue is still empty, wait for signal or broadcast.
-      Wait();
-    } else {
-      // Take a job from the queue.
-      std::function<void()> job = std::move(queue_.Front());
-      queue_.Pop();
-
-      UnlockMutex();
-      // Note that it is good practice to surround this with a try/catch so
-      // the thread pool doesn't go to hell if the job throws an exception.
-      // This is omitted here because Google3 doesn't like exceptions.
-      std::move(job)();
-      job = nullptr;
-
-      LockMutex();
     }
+    num_idle_workers_.fetch_sub(1, std::memory_order_relaxed);
+    UnlockMutex();
+    if (exit) break;
   }
-  UnlockMutex();
+  current_worker = {nullptr, -1};
 }
 
 void ThreadPool::Shutdown() {
+  if (shared_pool_ != nullptr) {
+    // There are no worker threads. Wait for the jobs on |shared_pool_|, which
+    // also run the jobs in |overflow_queue_|.
+    LockMutex();
+    while (num_shared_pool_jobs_ != 0) Wait();
+    UnlockMutex();
+    return;
+  }
   // Tell worker threads how to exit.
   LockMutex();
   exit_threads_ = true;
@@ -17,6 +17,7 @@
 #ifndef LIBGAV1_SRC_UTILS_THREADPOOL_H_
 #define LIBGAV1_SRC_UTILS_THREADPOOL_H_
 
+#include <atomic>
 #include <functional>
 #include <memory>
 
@@ -44,9 +45,12 @@
 #endif
 
 #include "src/utils/compiler_attributes.h"
+#include "src/utils/cpu_topology.h"
 #include "src/utils/executor.h"
+#include "src/utils/lock_free_queue.h"
 #include "src/utils/memory.h"
 #include "src/utils/unbounded_queue.h"
+#include "src/utils/work_stealing_deque.h"
 
 namespace libgav1 {
 
@@ -57,6 +61,17 @@ namespace libgav1 {
 // - The worker threads will pick up work jobs as they arrive.
 // - If all workers are busy, work jobs are queued for later execution.
 //
+// Each worker owns a lock-free deque. Jobs scheduled from a worker thread go
+// to the bottom of its own deque and the worker runs them newest first, while
+// the other workers steal from the top when they run out of work. Jobs
+// scheduled from other threads go to a shared lock-free queue. The mutex is
+// only taken to park or wake up idle workers, and when the shared queue is full
+// and jobs spill over into an unbounded queue.
+//
+// A pool may instead be created on top of another pool, in which case it has no
+// threads of its own and limits how many of the other pool's workers its jobs
+// occupy. This lets several decoders share one set of threads.
+//
 // The thread pool is shut down when the pool is destroyed.
 //
 // Example usage of the thread pool:
@@ -69,13 +84,29 @@ namespace libgav1 {
 class ThreadPool : public Executor, public Allocable {
  public:
   // Creates the thread pool with the specified number of worker threads.
-  // If num_threads is 1, the closures are run in FIFO order.
+  // If num_threads is 1, the closures scheduled from outside the pool are run
+  // in FIFO order.
   static std::unique_ptr<ThreadPool> Create(int num_threads);
 
   // Like the above factory method, but also sets the name prefix for threads.
   static std::unique_ptr<ThreadPool> Create(const char name_prefix[],
                                             int num_threads);
 
+  // Like the above factory method, but also restricts each worker thread to
+  // the CPUs that |placement| hands out for it, if any. |placement| may be
+  // null.
+  static std::unique_ptr<ThreadPool> Create(const char name_prefix[],
+                                            int num_threads,
+                                            CpuPlacement* placement);
+
+  // Creates a pool that has no threads of its own and runs its closures on the
+  // workers of |shared_pool| instead, keeping at most |num_threads| of them
+  // busy at a time. Further closures wait in a queue of this pool, so that one
+  // client of a shared pool cannot crowd out the others. |shared_pool| must
+  // outlive the returned pool.
+  static std::unique_ptr<ThreadPool> Create(ThreadPool* shared_pool,
+                                            int num_threads);
+
   // The destructor will shut down the thread pool and all jobs are executed.
   // Note that after shutdown, the thread pool does not accept further jobs.
   ~ThreadPool() override;
@@ -92,20 +123,59 @@ class ThreadPool : public Executor, public Allocable {
   //   2. Have the current thread wait until the queue is not full.
   void Schedule(std::function<void()> closure) override;
 
+  // Takes one queued closure, if there is any, and runs it on the calling
+  // thread. Returns false if no closure was found. This lets a thread that is
+  // waiting for the pool's jobs help run them instead of sleeping.
+  bool RunPendingJob();
+
   int num_threads() const;
 
  private:
   class WorkerThread;
+  using Closure = std::function<void()>;
 
   // Creates the thread pool with the specified number of worker threads.
-  // If num_threads is 1, the closures are run in FIFO order.
+  // If num_threads is 1, the closures scheduled from outside the pool are run
+  // in FIFO order.
   ThreadPool(const char name_prefix[], std::unique_ptr<WorkerThread*[]> threads,
              int num_threads);
 
-  // Starts the worker pool.
-  LIBGAV1_MUST_USE_RESULT bool StartWorkers();
+  // Creates a pool that runs at most |num_threads| closures at a time on the
+  // workers of |shared_pool|.
+  ThreadPool(ThreadPool* shared_pool, int num_threads);
+
+  // Starts the worker pool, pinning the workers as |placement| says if it is
+  // not null.
+  LIBGAV1_MUST_USE_RESULT bool StartWorkers(CpuPlacement* placement);
+
+  void WorkerFunction(int worker_index);
+
+  // Returns the index of the worker thread of this pool that is calling, or -1
+  // if the calling thread is not one of them.
+  int CurrentWorkerIndex() const;
+
+  // Queues |job| in the shared queue, or in |overflow_queue_| if the shared
+  // queue is full. Returns false if |overflow_queue_| could not grow.
+  bool PushSharedJob(Closure* job);
+
+  // Takes a job for the worker |worker_index| (-1 for a thread outside the
+  // pool): from its own deque first, then from the shared queues, then from
+  // the other workers' deques.
+  bool TakeJob(int worker_index, Closure** job);
+
+  // Returns true if any of the queues appears non-empty.
+  bool HasPendingJobs() const;
+
+  // Wakes up an idle worker, if there is one, after a job was queued.
+  void SignalIdleWorker();
+
+  // Runs |job| on |shared_pool_| if fewer than |num_threads_| jobs of this pool
+  // are running there, or queues it in |overflow_queue_| otherwise.
+  void ScheduleOnSharedPool(Closure* job);
 
-  void WorkerFunction();
+  // Runs |job|, and then the jobs in |overflow_queue_| until it is empty, on a
+  // worker of |shared_pool_|.
+  void RunSharedPoolJobs(Closure* job);
 
   // Shuts down the thread pool, i.e. worker threads finish their work and
   // pick up new jobs until the queue is empty. This call will block until
@@ -147,7 +217,22 @@ class ThreadPool : public Executor, public Allocable {
 
 #endif  // LIBGAV1_THREADPOOL_USE_STD_MUTEX
 
-  UnboundedQueue<std::function<void()>> queue_ LIBGAV1_GUARDED_BY(queue_mutex_);
+  std::unique_ptr<WorkStealingDeque<Closure*>[]> worker_queues_;
+  LockFreeQueue<Closure*> shared_queue_;
+  // Holds the jobs scheduled from outside the pool while |shared_queue_| is
+  // full. |overflow_size_| mirrors its size so that it can be checked without
+  // the mutex. If |shared_pool_| is not null, holds the jobs that wait for one
+  // of the |num_threads_| slots on |shared_pool_| instead.
+  UnboundedQueue<Closure*> overflow_queue_ LIBGAV1_GUARDED_BY(queue_mutex_);
+  std::atomic<int> overflow_size_{0};
+  // If not null, this pool has no worker threads and runs its jobs on the
+  // workers of |shared_pool_|.
+  ThreadPool* const shared_pool_ = nullptr;
+  // The number of jobs of this pool that are queued or running on
+  // |shared_pool_|.
+  int num_shared_pool_jobs_ LIBGAV1_GUARDED_BY(queue_mutex_) = 0;
+  // The number of workers that are parked, or about to be, in Wait().
+  std::atomic<int> num_idle_workers_{0};
   // If not all the worker threads are created, the first entry after the
   // created worker threads is a null pointer.
   const std::unique_ptr<WorkerThread*[]> threads_;
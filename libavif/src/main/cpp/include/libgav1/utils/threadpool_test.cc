@@ -14,6 +14,7 @@
 
 #include "src/utils/threadpool.h"
 
+#include <atomic>
 #include <cassert>
 #include <cstdint>
 #include <memory>
@@ -129,5 +130,103 @@ TEST(ThreadPoolTest, OneThreadRunsClosuresFIFO) {
   }
 }
 
+// Jobs scheduled from a worker go to that worker's deque. While it is blocked,
+// the other worker must steal them.
+TEST(ThreadPoolTest, IdleWorkerStealsJobs) {
+  std::unique_ptr<ThreadPool> pool = ThreadPool::Create(2);
+  ASSERT_NE(pool, nullptr);
+  SimpleGuardedInteger count(10);
+  std::atomic<bool> release_worker(false);
+  pool->Schedule([&pool, &count, &release_worker]() {
+    for (int i = 0; i < 10; ++i) {
+      pool->Schedule([&count]() { count.Decrement(); });
+    }
+    while (!release_worker.load(std::memory_order_acquire)) {
+      LoopForMs(1);
+    }
+  });
+  count.WaitForZero();
+  release_worker.store(true, std::memory_order_release);
+}
+
+TEST(ThreadPoolTest, RunPendingJob) {
+  std::unique_ptr<ThreadPool> pool = ThreadPool::Create(1);
+  ASSERT_NE(pool, nullptr);
+  std::atomic<bool> worker_started(false);
+  std::atomic<bool> release_worker(false);
+  pool->Schedule([&worker_started, &release_worker]() {
+    worker_started.store(true, std::memory_order_release);
+    while (!release_worker.load(std::memory_order_acquire)) {
+      LoopForMs(1);
+    }
+  });
+  while (!worker_started.load(std::memory_order_acquire)) {
+    LoopForMs(1);
+  }
+  int count = 0;
+  pool->Schedule([&count]() { ++count; });
+  pool->Schedule([&count]() { ++count; });
+  EXPECT_TRUE(pool->RunPendingJob());
+  EXPECT_TRUE(pool->RunPendingJob());
+  EXPECT_FALSE(pool->RunPendingJob());
+  EXPECT_EQ(count, 2);
+  release_worker.store(true, std::memory_order_release);
+}
+
+// A pool created on a shared pool never keeps more of the shared workers busy
+// than its number of threads, and its destructor waits for all its jobs.
+TEST(ThreadPoolTest, SharedPoolLimitsConcurrency) {
+  std::unique_ptr<ThreadPool> shared_pool = ThreadPool::Create(8);
+  ASSERT_NE(shared_pool, nullptr);
+  EXPECT_EQ(ThreadPool::Create(shared_pool.get(), 0), nullptr);
+  std::unique_ptr<ThreadPool> pool = ThreadPool::Create(shared_pool.get(), 2);
+  ASSERT_NE(pool, nullptr);
+  EXPECT_EQ(pool->num_threads(), 2);
+  std::atomic<int> running(0);
+  std::atomic<int> max_running(0);
+  std::atomic<int> count(0);
+  for (int i = 0; i < 50; ++i) {
+    pool->Schedule([&running, &max_running, &count]() {
+      const int now_running = ++running;
+      int expected = max_running.load();
+      while (now_running > expected &&
+             !max_running.compare_exchange_weak(expected, now_running)) {
+      }
+      LoopForMs(1);
+      --running;
+      ++count;
+    });
+  }
+  pool.reset(nullptr);
+  EXPECT_EQ(count, 50);
+  EXPECT_LE(max_running, 2);
+}
+
+// Two pools on the same shared pool both make progress while one of them has a
+// long backlog.
+TEST(ThreadPoolTest, SharedPoolIsFair) {
+  std::unique_ptr<ThreadPool> shared_pool = ThreadPool::Create(2);
+  ASSERT_NE(shared_pool, nullptr);
+  std::unique_ptr<ThreadPool> busy_pool =
+      ThreadPool::Create(shared_pool.get(), 1);
+  std::unique_ptr<ThreadPool> pool = ThreadPool::Create(shared_pool.get(), 1);
+  ASSERT_NE(busy_pool, nullptr);
+  ASSERT_NE(pool, nullptr);
+  std::atomic<int> busy_count(0);
+  for (int i = 0; i < 1000; ++i) {
+    busy_pool->Schedule([&busy_count]() {
+      LoopForMs(1);
+      ++busy_count;
+    });
+  }
+  SimpleGuardedInteger count(1);
+  pool->Schedule([&count]() { count.Decrement(); });
+  count.WaitForZero();
+  // |pool| did not have to wait for the backlog of |busy_pool|.
+  EXPECT_LT(busy_count, 500);
+  busy_pool.reset(nullptr);
+  EXPECT_EQ(busy_count, 1000);
+}
+
 }  // namespace
 }  // namespace libgav1
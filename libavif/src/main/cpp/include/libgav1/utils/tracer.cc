@@ -0,0 +1,261 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/utils/tracer.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>  // NOLINT (unapproved c++11 header)
+#include <vector>
+
+#include "src/utils/compiler_attributes.h"
+#include "src/utils/stage_timer.h"
+
+namespace libgav1 {
+namespace internal {
+
+std::atomic<bool> tracing_enabled(false);
+
+}  // namespace internal
+
+namespace {
+
+constexpr int kMaxTraceEvents = 1 << 24;
+
+static_assert(kLibgav1NumDecodeStages == 9,
+              "kTraceEventNames must be updated.");
+const char* const kTraceEventNames[kNumTraceEventTypes] = {
+    "parse",
+    "tile_decode",
+    "deblock",
+    "cdef",
+    "super_res",
+    "loop_restoration",
+    "border_extension",
+    "film_grain",
+    "output",
+    "tile_parse",
+    "tile_reconstruct",
+    "tile_parse_and_decode",
+    "superblock_decode",
+    "wait"};
+
+// One slot of the ring buffer. The fields are atomics so that a slot can be
+// read while it is being overwritten; |sequence| is 0 while the slot is being
+// written and the event index plus 1 once it is complete, as in a seqlock.
+struct TraceSlot {
+  std::atomic<uint64_t> sequence;
+  std::atomic<int64_t> start_ns;
+  std::atomic<int64_t> duration_ns;
+  // The type, thread id, tile + 1 and row4x4 + 1, 16 bits each.
+  std::atomic<uint64_t> info;
+};
+
+struct TraceEvent {
+  int64_t start_ns;
+  int64_t duration_ns;
+  int type;
+  int thread;
+  int tile;
+  int row4x4;
+};
+
+// The ring buffer. Buffer and mask are published together, so that a recorder
+// never indexes one buffer with the mask of another.
+struct TraceBuffer {
+  TraceSlot* slots;
+  size_t mask;
+};
+
+// Replaced only by StartTracer().
+std::atomic<TraceBuffer*> trace_buffer(nullptr);
+// The number of RecordTraceEvent() calls that may be using |trace_buffer|.
+// StartTracer() frees a replaced buffer once this drops to 0, which happens
+// quickly as each call only holds it for a few stores.
+std::atomic<int> trace_writers(0);
+std::atomic<uint64_t> trace_write_index(0);
+std::atomic<int> trace_thread_count(0);
+
+// Small ids are easier to read in the trace viewer than native thread ids.
+int GetTraceThreadId() {
+  thread_local int thread_id = 0;
+  if (thread_id == 0) {
+    thread_id = trace_thread_count.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+  return thread_id;
+}
+
+void AppendFormat(std::string* out, const char* format, ...)
+    LIBGAV1_PRINTF_ATTRIBUTE(2, 3);
+
+void AppendFormat(std::string* out, const char* format, ...) {
+  char line[256];
+  va_list args;
+  va_start(args, format);
+  const int length = vsnprintf(line, sizeof(line), format, args);
+  va_end(args);
+  if (length <= 0) return;
+  out->append(line, std::min(static_cast<size_t>(length), sizeof(line) - 1));
+}
+
+}  // namespace
+
+bool StartTracer(int max_events) {
+  internal::tracing_enabled.store(false, std::memory_order_relaxed);
+  trace_write_index.store(0, std::memory_order_relaxed);
+  const int events = std::min(max_events, kMaxTraceEvents);
+  size_t capacity = 1;
+  while (capacity < static_cast<size_t>(events)) capacity <<= 1;
+  TraceBuffer* const buffer = trace_buffer.load(std::memory_order_relaxed);
+  if (buffer != nullptr && buffer->mask + 1 == capacity) {
+    for (size_t i = 0; i < capacity; ++i) {
+      buffer->slots[i].sequence.store(0, std::memory_order_relaxed);
+    }
+  } else {
+    std::unique_ptr<TraceBuffer> new_buffer(new (std::nothrow) TraceBuffer);
+    if (new_buffer == nullptr) return false;
+    new_buffer->slots = new (std::nothrow) TraceSlot[capacity]();
+    if (new_buffer->slots == nullptr) return false;
+    new_buffer->mask = capacity - 1;
+    TraceBuffer* const old_buffer =
+        trace_buffer.exchange(new_buffer.release(), std::memory_order_seq_cst);
+    if (old_buffer != nullptr) {
+      // A recorder that loaded |old_buffer| incremented |trace_writers| before
+      // the exchange above, so it is counted until it is done with it.
+      while (trace_writers.load(std::memory_order_seq_cst) != 0) {
+        std::this_thread::yield();
+      }
+      delete[] old_buffer->slots;
+      delete old_buffer;
+    }
+  }
+  internal::tracing_enabled.store(true, std::memory_order_release);
+  return true;
+}
+
+void StopTracer() {
+  internal::tracing_enabled.store(false, std::memory_order_relaxed);
+}
+
+int64_t GetTraceTimeNs() { return GetWallTimeNs(); }
+
+void RecordTraceEvent(TraceEventType type, int64_t start_ns, int tile,
+                      int row4x4) {
+  const int64_t end_ns = GetWallTimeNs();
+  if (!IsTracing()) return;
+  trace_writers.fetch_add(1, std::memory_order_seq_cst);
+  TraceBuffer* const buffer = trace_buffer.load(std::memory_order_seq_cst);
+  if (buffer == nullptr) {
+    trace_writers.fetch_sub(1, std::memory_order_release);
+    return;
+  }
+  const uint64_t index =
+      trace_write_index.fetch_add(1, std::memory_order_relaxed);
+  TraceSlot& slot = buffer->slots[index & buffer->mask];
+  slot.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.start_ns.store(start_ns, std::memory_order_relaxed);
+  slot.duration_ns.store(end_ns - start_ns, std::memory_order_relaxed);
+  slot.info.store(static_cast<uint64_t>(type) |
+                      (static_cast<uint64_t>(GetTraceThreadId() & 0xffff)
+                       << 16) |
+                      (static_cast<uint64_t>((tile + 1) & 0xffff) << 32) |
+                      (static_cast<uint64_t>((row4x4 + 1) & 0xffff) << 48),
+                  std::memory_order_relaxed);
+  slot.sequence.store(index + 1, std::memory_order_release);
+  trace_writers.fetch_sub(1, std::memory_order_release);
+}
+
+size_t GetTracerJson(char* buffer, size_t size) {
+  std::vector<TraceEvent> events;
+  const uint64_t written = trace_write_index.load(std::memory_order_acquire);
+  const TraceBuffer* const trace =
+      trace_buffer.load(std::memory_order_acquire);
+  const size_t capacity = (trace == nullptr) ? 0 : trace->mask + 1;
+  const uint64_t count = std::min<uint64_t>(written, capacity);
+  events.reserve(count);
+  for (uint64_t i = 0; i < count; ++i) {
+    TraceSlot& slot = trace->slots[i];
+    const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence == 0) continue;
+    TraceEvent event;
+    event.start_ns = slot.start_ns.load(std::memory_order_relaxed);
+    event.duration_ns = slot.duration_ns.load(std::memory_order_relaxed);
+    const uint64_t info = slot.info.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // Skip slots that were overwritten while being read.
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence) continue;
+    event.type = static_cast<int>(info & 0xffff);
+    event.thread = static_cast<int>((info >> 16) & 0xffff);
+    event.tile = static_cast<int>((info >> 32) & 0xffff) - 1;
+    event.row4x4 = static_cast<int>((info >> 48) & 0xffff) - 1;
+    if (event.type >= kNumTraceEventTypes) continue;
+    events.push_back(event);
+  }
+  std::sort(events.begin(), events.end(),
+            [](const TraceEvent& a, const TraceEvent& b) {
+              return a.start_ns < b.start_ns;
+            });
+
+  std::string json = "{\"traceEvents\":[";
+  std::vector<int> threads;
+  for (const TraceEvent& event : events) threads.push_back(event.thread);
+  std::sort(threads.begin(), threads.end());
+  threads.erase(std::unique(threads.begin(), threads.end()), threads.end());
+  bool first = true;
+  for (const int thread : threads) {
+    AppendFormat(&json,
+                 "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                 "\"tid\":%d,\"args\":{\"name\":\"libgav1 thread %d\"}}",
+                 first ? "" : ",", thread, thread);
+    first = false;
+  }
+  const int64_t origin_ns = events.empty() ? 0 : events[0].start_ns;
+  for (const TraceEvent& event : events) {
+    // Timestamps are in microseconds.
+    AppendFormat(&json,
+                 "%s\n{\"name\":\"%s\",\"cat\":\"libgav1\",\"ph\":\"X\","
+                 "\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f",
+                 first ? "" : ",", kTraceEventNames[event.type], event.thread,
+                 (event.start_ns - origin_ns) * 1e-3,
+                 event.duration_ns * 1e-3);
+    first = false;
+    if (event.tile >= 0 && event.row4x4 >= 0) {
+      AppendFormat(&json, ",\"args\":{\"tile\":%d,\"row4x4\":%d}}",
+                   event.tile, event.row4x4);
+    } else if (event.tile >= 0) {
+      AppendFormat(&json, ",\"args\":{\"tile\":%d}}", event.tile);
+    } else {
+      json += '}';
+    }
+  }
+  AppendFormat(&json,
+               "\n],\"displayTimeUnit\":\"ns\","
+               "\"otherData\":{\"dropped_events\":%llu}}\n",
+               static_cast<unsigned long long>(written - count));
+
+  if (size > 0) {
+    const size_t length = std::min(json.size(), size - 1);
+    memcpy(buffer, json.data(), length);
+    buffer[length] = '\0';
+  }
+  return json.size();
+}
+
+}  // namespace libgav1
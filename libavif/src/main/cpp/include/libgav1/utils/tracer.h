@@ -0,0 +1,107 @@
+/*
+ * Copyright 2022 The libgav1 Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LIBGAV1_SRC_UTILS_TRACER_H_
+#define LIBGAV1_SRC_UTILS_TRACER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "src/gav1/stage_timing.h"
+
+namespace libgav1 {
+
+// The kinds of trace events. The decode stages come first so that a
+// DecodeStage can be used as a TraceEventType.
+enum TraceEventType : uint8_t {
+  // Parsing of one superblock row of a tile.
+  kTraceEventTileParse = kLibgav1NumDecodeStages,
+  // Reconstruction of one superblock row of a tile.
+  kTraceEventTileDecode,
+  // Parsing and reconstruction of one superblock row of a tile.
+  kTraceEventTileParseAndDecode,
+  // Reconstruction of one superblock when a tile is decoded by several
+  // threads.
+  kTraceEventSuperBlockDecode,
+  // Blocked waiting for other threads.
+  kTraceEventWait,
+  kNumTraceEventTypes
+};
+
+namespace internal {
+
+extern std::atomic<bool> tracing_enabled;
+
+}  // namespace internal
+
+// Returns true while Libgav1StartTracing() is in effect.
+inline bool IsTracing() {
+  return internal::tracing_enabled.load(std::memory_order_relaxed);
+}
+
+// Starts and stops recording into a ring buffer of |max_events| events. See
+// gav1/tracing.h.
+bool StartTracer(int max_events);
+void StopTracer();
+
+// Returns the current trace clock reading in nanoseconds.
+int64_t GetTraceTimeNs();
+
+// Records an event of |type| on the calling thread that started at
+// |start_ns| and ends now. |tile| and |row4x4| are -1 if not applicable.
+void RecordTraceEvent(TraceEventType type, int64_t start_ns, int tile,
+                      int row4x4);
+
+// Writes the recorded events as Chrome trace event JSON. Behaves like
+// Libgav1GetTraceJson().
+size_t GetTracerJson(char* buffer, size_t size);
+
+// Records the section between construction and destruction (or Stop()) as an
+// event on the calling thread. Does nothing (and reads no clock) when tracing
+// was off at construction.
+class ScopedTraceEvent {
+ public:
+  explicit ScopedTraceEvent(TraceEventType type, int tile = -1,
+                            int row4x4 = -1)
+      : type_(type),
+        tile_(tile),
+        row4x4_(row4x4),
+        start_ns_(IsTracing() ? GetTraceTimeNs() : -1) {}
+
+  // Not copyable or movable.
+  ScopedTraceEvent(const ScopedTraceEvent&) = delete;
+  ScopedTraceEvent& operator=(const ScopedTraceEvent&) = delete;
+
+  ~ScopedTraceEvent() { Stop(); }
+
+  // Ends the section now. Later calls and the destructor do nothing.
+  void Stop() {
+    if (start_ns_ < 0) return;
+    RecordTraceEvent(type_, start_ns_, tile_, row4x4_);
+    start_ns_ = -1;
+  }
+
+ private:
+  const TraceEventType type_;
+  const int tile_;
+  const int row4x4_;
+  int64_t start_ns_;
+};
+
+}  // namespace libgav1
+
+#endif  // LIBGAV1_SRC_UTILS_TRACER_H_
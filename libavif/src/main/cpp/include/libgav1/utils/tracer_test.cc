@@ -0,0 +1,145 @@
+// Copyright 2022 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/utils/tracer.h"
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>  // NOLINT (unapproved c++11 header)
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/gav1/tracing.h"
+#include "src/utils/stage_timer.h"
+
+namespace libgav1 {
+namespace {
+
+std::string GetTrace() {
+  const size_t length = GetTraceJson(nullptr, 0);
+  std::vector<char> buffer(length + 1);
+  EXPECT_EQ(GetTraceJson(buffer.data(), buffer.size()), length);
+  return std::string(buffer.data());
+}
+
+int CountOccurrences(const std::string& s, const std::string& pattern) {
+  int count = 0;
+  for (size_t i = s.find(pattern); i != std::string::npos;
+       i = s.find(pattern, i + 1)) {
+    ++count;
+  }
+  return count;
+}
+
+TEST(TracerTest, NothingRecordedWhileOff) {
+  StopTracing();
+  EXPECT_FALSE(IsTracing());
+  {
+    ScopedTraceEvent event(kTraceEventWait);
+  }
+  ASSERT_TRUE(StartTracing(16));
+  EXPECT_TRUE(IsTracing());
+  StopTracing();
+  {
+    ScopedTraceEvent event(kTraceEventWait);
+  }
+  const std::string trace = GetTrace();
+  EXPECT_EQ(trace.find("\"ph\":\"X\""), std::string::npos) << trace;
+  EXPECT_NE(trace.find("\"dropped_events\":0"), std::string::npos) << trace;
+}
+
+TEST(TracerTest, RecordsEventsPerThread) {
+  ASSERT_TRUE(StartTracing(64));
+  {
+    ScopedStageTimer timer(kLibgav1DecodeStageCdef);
+  }
+  std::thread other([]() {
+    ScopedTraceEvent event(kTraceEventTileDecode, /*tile=*/3,
+                           /*row4x4=*/16);
+    ScopedTraceEvent nested(kTraceEventWait);
+    nested.Stop();
+    nested.Stop();
+  });
+  other.join();
+  StopTracing();
+
+  const std::string trace = GetTrace();
+  EXPECT_EQ(trace.compare(0, 15, "{\"traceEvents\":"), 0) << trace;
+  EXPECT_EQ(CountOccurrences(trace, "\"ph\":\"X\""), 3) << trace;
+  EXPECT_EQ(CountOccurrences(trace, "\"name\":\"cdef\""), 1) << trace;
+  EXPECT_EQ(CountOccurrences(trace, "\"name\":\"wait\""), 1) << trace;
+  EXPECT_NE(trace.find("\"name\":\"tile_reconstruct\""), std::string::npos)
+      << trace;
+  EXPECT_NE(trace.find("\"args\":{\"tile\":3,\"row4x4\":16}"),
+            std::string::npos)
+      << trace;
+  // One thread_name record per thread.
+  EXPECT_EQ(CountOccurrences(trace, "\"ph\":\"M\""), 2) << trace;
+}
+
+TEST(TracerTest, KeepsMostRecentEvents) {
+  ASSERT_TRUE(StartTracing(3));  // Rounded up to 4.
+  for (int i = 0; i < 10; ++i) {
+    ScopedTraceEvent event(kTraceEventTileParse, 0, i * 16);
+  }
+  StopTracing();
+  const std::string trace = GetTrace();
+  EXPECT_EQ(CountOccurrences(trace, "\"ph\":\"X\""), 4) << trace;
+  EXPECT_NE(trace.find("\"row4x4\":144"), std::string::npos) << trace;
+  EXPECT_EQ(trace.find("\"row4x4\":80}"), std::string::npos) << trace;
+  EXPECT_NE(trace.find("\"dropped_events\":6"), std::string::npos) << trace;
+}
+
+TEST(TracerTest, TruncatesLikeSnprintf) {
+  ASSERT_TRUE(StartTracing(4));
+  {
+    ScopedTraceEvent event(kTraceEventWait);
+  }
+  StopTracing();
+  const std::string trace = GetTrace();
+  char buffer[8];
+  EXPECT_EQ(GetTraceJson(buffer, sizeof(buffer)), trace.size());
+  EXPECT_EQ(std::string(buffer), trace.substr(0, sizeof(buffer) - 1));
+}
+
+// Restarting with another capacity while other threads record must leave them
+// a valid buffer to write to.
+TEST(TracerTest, RestartWhileRecording) {
+  ASSERT_TRUE(StartTracing(4));
+  std::atomic<bool> done(false);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 3; ++i) {
+    threads.emplace_back([&done, i]() {
+      while (!done.load(std::memory_order_relaxed)) {
+        ScopedTraceEvent event(kTraceEventTileParse, i, 0);
+      }
+    });
+  }
+  for (int i = 0; i < 200; ++i) {
+    ASSERT_TRUE(StartTracing((i & 1) ? 4 : 1024));
+  }
+  done.store(true, std::memory_order_relaxed);
+  for (auto& thread : threads) thread.join();
+  {
+    ScopedTraceEvent event(kTraceEventWait);
+  }
+  StopTracing();
+  const std::string trace = GetTrace();
+  EXPECT_EQ(trace.compare(0, 15, "{\"traceEvents\":"), 0) << trace;
+  EXPECT_NE(trace.find("\"name\":\"wait\""), std::string::npos) << trace;
+}
+
+}  // namespace
+}  // namespace libgav1
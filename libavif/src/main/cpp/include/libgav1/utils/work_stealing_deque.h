@@ -0,0 +1,126 @@
+/*
+ * Copyright 2021 The libgav1 Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LIBGAV1_SRC_UTILS_WORK_STEALING_DEQUE_H_
+#define LIBGAV1_SRC_UTILS_WORK_STEALING_DEQUE_H_
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include "src/utils/compiler_attributes.h"
+
+namespace libgav1 {
+
+// A lock-free deque of a fixed capacity with a single owner thread, after
+// Chase and Lev, "Dynamic Circular Work-Stealing Deque" (SPAA 2005), with the
+// memory orderings of Le et al., "Correct and Efficient Work-Stealing for Weak
+// Memory Models" (PPoPP 2013).
+//
+// The owner pushes and pops at the bottom, so it sees its own elements in LIFO
+// order. Any thread may steal from the top, in FIFO order. |T| must be
+// trivially copyable since a thief may read an element that the owner is
+// overwriting; the thief then loses the race on |top_| and discards it.
+template <typename T>
+class WorkStealingDeque {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "T must be trivially copyable");
+
+ public:
+  WorkStealingDeque() = default;
+
+  // Not copyable or movable.
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+  // |capacity| must be a power of 2.
+  LIBGAV1_MUST_USE_RESULT bool Init(size_t capacity) {
+    assert(capacity != 0 && (capacity & (capacity - 1)) == 0);
+    elements_.reset(new (std::nothrow) std::atomic<T>[capacity]);
+    if (elements_ == nullptr) return false;
+    mask_ = static_cast<int64_t>(capacity) - 1;
+    return true;
+  }
+
+  // Pushes |value| to the bottom of the deque. Returns false if the deque is
+  // full. Must only be called by the owner.
+  bool Push(T value) {
+    const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    const int64_t top = top_.load(std::memory_order_acquire);
+    if (bottom - top > mask_) return false;
+    elements_[bottom & mask_].store(value, std::memory_order_relaxed);
+    // Publishes the element, and whatever it points to, to the thieves.
+    bottom_.store(bottom + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Pops the element at the bottom of the deque into |*value|. Returns false
+  // if the deque is empty or a thief took the last element. Must only be
+  // called by the owner.
+  bool Pop(T* const value) {
+    const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    if (top > bottom) {
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return false;
+    }
+    *value = elements_[bottom & mask_].load(std::memory_order_relaxed);
+    if (top != bottom) return true;
+    // This is the last element. Race the thieves for it.
+    const bool won = top_.compare_exchange_strong(
+        top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return won;
+  }
+
+  // Steals the element at the top of the deque into |*value|. Returns false if
+  // the deque is empty or another thread took the element first. May be called
+  // by any thread.
+  bool Steal(T* const value) {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) return false;
+    *value = elements_[top & mask_].load(std::memory_order_relaxed);
+    return top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed);
+  }
+
+  // Returns true if the deque appears empty. The result may be stale by the
+  // time it is used unless the caller is the owner.
+  bool Empty() const {
+    return top_.load(std::memory_order_acquire) >=
+           bottom_.load(std::memory_order_acquire);
+  }
+
+ private:
+  // |top_| only grows and is advanced by whoever takes the top element.
+  // |bottom_| is only written by the owner.
+  std::atomic<int64_t> top_{0};
+  std::atomic<int64_t> bottom_{0};
+  int64_t mask_ = 0;
+  std::unique_ptr<std::atomic<T>[]> elements_;
+};
+
+}  // namespace libgav1
+
+#endif  // LIBGAV1_SRC_UTILS_WORK_STEALING_DEQUE_H_
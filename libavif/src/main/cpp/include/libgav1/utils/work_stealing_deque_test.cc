@@ -0,0 +1,107 @@
+// Copyright 2021 The libgav1 Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/utils/work_stealing_deque.h"
+
+#include <atomic>
+#include <thread>  // NOLINT (unapproved c++11 header)
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace libgav1 {
+namespace {
+
+constexpr int kDequeSize = 8;
+
+TEST(WorkStealingDequeTest, OwnerIsLifoThiefIsFifo) {
+  WorkStealingDeque<int> deque;
+  ASSERT_TRUE(deque.Init(kDequeSize));
+  EXPECT_TRUE(deque.Empty());
+
+  for (int i = 0; i < kDequeSize; ++i) {
+    EXPECT_TRUE(deque.Push(i));
+    EXPECT_FALSE(deque.Empty());
+  }
+  // The deque is full.
+  EXPECT_FALSE(deque.Push(kDequeSize));
+
+  int value;
+  ASSERT_TRUE(deque.Steal(&value));
+  EXPECT_EQ(value, 0);
+  ASSERT_TRUE(deque.Steal(&value));
+  EXPECT_EQ(value, 1);
+  for (int i = kDequeSize - 1; i >= 2; --i) {
+    ASSERT_TRUE(deque.Pop(&value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_TRUE(deque.Empty());
+  EXPECT_FALSE(deque.Pop(&value));
+  EXPECT_FALSE(deque.Steal(&value));
+}
+
+TEST(WorkStealingDequeTest, WrapAround) {
+  WorkStealingDeque<int> deque;
+  ASSERT_TRUE(deque.Init(kDequeSize));
+
+  int value;
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(deque.Push(i));
+    EXPECT_TRUE(deque.Push(i + 1000));
+    ASSERT_TRUE(deque.Steal(&value));
+    EXPECT_EQ(value, i);
+    ASSERT_TRUE(deque.Pop(&value));
+    EXPECT_EQ(value, i + 1000);
+    EXPECT_TRUE(deque.Empty());
+  }
+}
+
+// The owner pushes and pops while several thieves steal. Every element must be
+// taken exactly once.
+TEST(WorkStealingDequeTest, ConcurrentSteal) {
+  constexpr int kNumElements = 100000;
+  constexpr int kNumThieves = 4;
+  WorkStealingDeque<int> deque;
+  ASSERT_TRUE(deque.Init(64));
+  std::vector<std::atomic<int>> taken(kNumElements);
+  for (auto& count : taken) count = 0;
+  std::atomic<bool> done(false);
+
+  std::vector<std::thread> thieves;
+  for (int i = 0; i < kNumThieves; ++i) {
+    thieves.emplace_back([&deque, &taken, &done]() {
+      int value;
+      while (!done.load(std::memory_order_acquire) || !deque.Empty()) {
+        if (deque.Steal(&value)) ++taken[value];
+      }
+    });
+  }
+  int value;
+  for (int i = 0; i < kNumElements; ++i) {
+    while (!deque.Push(i)) {
+      if (deque.Pop(&value)) ++taken[value];
+    }
+    if ((i & 3) == 0 && deque.Pop(&value)) ++taken[value];
+  }
+  while (deque.Pop(&value)) ++taken[value];
+  done.store(true, std::memory_order_release);
+  for (auto& thief : thieves) thief.join();
+
+  for (int i = 0; i < kNumElements; ++i) {
+    EXPECT_EQ(taken[i], 1) << "element " << i;
+  }
+}
+
+}  // namespace
+}  // namespace libgav1
@@ -253,4 +253,14 @@ bool YuvBuffer::Realloc(int bitdepth, bool is_monochrome, int width, int height,
   return true;
 }
 
+size_t YuvBuffer::plane_bytes() const {
+  size_t bytes = 0;
+  const int num_planes = is_monochrome_ ? 1 : kMaxPlanes;
+  for (int plane = kPlaneY; plane < num_planes; ++plane) {
+    bytes += static_cast<size_t>(stride_[plane]) *
+             (height(plane) + top_border_[plane] + bottom_border_[plane]);
+  }
+  return bytes;
+}
+
 }  // namespace libgav1
@@ -113,6 +113,13 @@ class YuvBuffer {
   // Returns the alignment of frame buffer row in bytes.
   int alignment() const { return kFrameBufferRowAlignment; }
 
+  // Returns the bytes the buffer allocated itself, i.e. 0 if it uses memory
+  // from the get_frame_buffer callback.
+  size_t allocated_bytes() const { return buffer_alloc_size_; }
+
+  // Returns the bytes spanned by the rows of the planes, borders included.
+  size_t plane_bytes() const;
+
   // Backup the current set of warnings and disable -Warray-bounds for the
   // following three functions as the compiler cannot, in all cases, determine
   // whether |plane| is within [0, kMaxPlanes), e.g., with a variable based for
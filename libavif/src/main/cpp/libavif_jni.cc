@@ -1,9 +1,13 @@
 #include <android/bitmap.h>
 #include <android/log.h>
 #include <jni.h>
-#include <string.h>
 
 #include "avif/avif.h"
+#include "avif_codec.h"
+#include "codec_stats.h"
+#include "frame_buffer_pool.h"
+#include "image_cache.h"
+#include "memory_pool.h"
 
 #define LOG_TAG "avif_jni"
 #define LOGE(...) \
@@ -17,70 +21,149 @@
   JNIEXPORT RETURN_TYPE Java_com_gain_libavif_AvifCodec_##NAME( \
       JNIEnv* env, jobject /*thiz*/, ##__VA_ARGS__)
 
+using avif_sample::CodecStats;
+using avif_sample::FrameBufferPool;
+using avif_sample::ImageCache;
+using avif_sample::MemoryPool;
+using avif_sample::StatsCollector;
+
 namespace {
 
     jfieldID global_info_width;
     jfieldID global_info_height;
     jfieldID global_info_depth;
-
-// RAII wrapper class that properly frees the decoder related objects on
-// destruction.
-    struct AvifDecoderWrapper {
+    jfieldID global_memory_stats_allocation_count;
+    jfieldID global_memory_stats_pool_hit_count;
+    jfieldID global_memory_stats_current_bytes;
+    jfieldID global_memory_stats_peak_bytes;
+    jfieldID global_memory_stats_pooled_bytes;
+    jfieldID global_memory_stats_frame_buffer_bytes;
+    jfieldID global_memory_stats_pooled_frame_buffer_bytes;
+    jfieldID global_memory_stats_page_faults_avoided;
+    jfieldID global_stats_wall_time_ns;
+    jfieldID global_stats_cpu_time_ns;
+    jfieldID global_stats_total_wall_time_ns;
+    jfieldID global_stats_total_cpu_time_ns;
+    jfieldID global_stats_bytes_read;
+    jfieldID global_stats_bytes_written;
+    jfieldID global_stats_color_obu_size;
+    jfieldID global_stats_alpha_obu_size;
+    jfieldID global_stats_threads;
+    jfieldID global_stats_peak_memory_bytes;
+    jfieldID global_stats_cache_hit;
+
+    // Collects CodecStats for the duration of one JNI call and copies them into
+    // the AvifCodec.Stats object |stats| when the call returns. Collection is
+    // disabled when |stats| is null.
+    class JavaStatsReporter {
     public:
-        AvifDecoderWrapper() = default;
+        JavaStatsReporter(JNIEnv *env, jobject stats)
+                : env_(env),
+                  stats_(stats),
+                  collector_(stats != nullptr ? &codec_stats_ : nullptr) {}
 
         // Not copyable or movable.
-        AvifDecoderWrapper(const AvifDecoderWrapper &) = delete;
+        JavaStatsReporter(const JavaStatsReporter &) = delete;
+
+        JavaStatsReporter &operator=(const JavaStatsReporter &) = delete;
+
+        ~JavaStatsReporter() {
+            if (stats_ == nullptr) return;
+            collector_.Finish();
+            WriteStats();
+        }
 
-        AvifDecoderWrapper &operator=(const AvifDecoderWrapper &) = delete;
+        StatsCollector *collector() { return &collector_; }
 
-        ~AvifDecoderWrapper() {
-            if (decoder != nullptr) {
-                avifDecoderDestroy(decoder);
+    private:
+        void WriteStats() {
+            const jobject wall_time_ns = env_->GetObjectField(stats_, global_stats_wall_time_ns);
+            const jobject cpu_time_ns = env_->GetObjectField(stats_, global_stats_cpu_time_ns);
+            jlong values[avif_sample::kNumCodecStages];
+            for (int i = 0; i < avif_sample::kNumCodecStages; ++i) {
+                values[i] = codec_stats_.wall_time_ns[i];
             }
+            env_->SetLongArrayRegion(static_cast<jlongArray>(wall_time_ns), 0,
+                                     avif_sample::kNumCodecStages, values);
+            for (int i = 0; i < avif_sample::kNumCodecStages; ++i) {
+                values[i] = codec_stats_.cpu_time_ns[i];
+            }
+            env_->SetLongArrayRegion(static_cast<jlongArray>(cpu_time_ns), 0,
+                                     avif_sample::kNumCodecStages, values);
+            env_->SetLongField(stats_, global_stats_total_wall_time_ns,
+                               codec_stats_.total_wall_time_ns);
+            env_->SetLongField(stats_, global_stats_total_cpu_time_ns,
+                               codec_stats_.total_cpu_time_ns);
+            env_->SetLongField(stats_, global_stats_bytes_read,
+                               static_cast<jlong>(codec_stats_.bytes_read));
+            env_->SetLongField(stats_, global_stats_bytes_written,
+                               static_cast<jlong>(codec_stats_.bytes_written));
+            env_->SetLongField(stats_, global_stats_color_obu_size,
+                               static_cast<jlong>(codec_stats_.color_obu_size));
+            env_->SetLongField(stats_, global_stats_alpha_obu_size,
+                               static_cast<jlong>(codec_stats_.alpha_obu_size));
+            env_->SetIntField(stats_, global_stats_threads, codec_stats_.threads);
+            env_->SetLongField(stats_, global_stats_peak_memory_bytes,
+                               static_cast<jlong>(codec_stats_.peak_memory_bytes));
+            env_->SetBooleanField(stats_, global_stats_cache_hit, codec_stats_.cache_hit);
         }
 
-        avifDecoder *decoder = nullptr;
+        JNIEnv *const env_;
+        const jobject stats_;
+        CodecStats codec_stats_;
+        StatsCollector collector_;
     };
 
-    struct AvifEncoderWrapper {
+    // Exposes a locked-on-demand Android Bitmap to the decoder.
+    class BitmapSurface : public avif_sample::RgbSurface {
     public:
-        AvifEncoderWrapper() = default;
-
-        // Not copyable or movable.
-        AvifEncoderWrapper(const AvifEncoderWrapper &) = delete;
-
-        AvifEncoderWrapper &operator=(const AvifEncoderWrapper &) = delete;
+        BitmapSurface(JNIEnv *env, jobject bitmap, const AndroidBitmapInfo &info)
+                : env_(env), bitmap_(bitmap), info_(info) {}
+
+        uint32_t width() const override { return info_.width; }
+        uint32_t height() const override { return info_.height; }
+        uint32_t stride() const override { return info_.stride; }
+
+        bool GetFormat(avif_sample::RgbFormat *format) const override {
+            // Ensure that the bitmap format is either RGBA_8888 or RGBA_F16.
+            if (info_.format == ANDROID_BITMAP_FORMAT_RGBA_8888) {
+                *format = avif_sample::kRgbFormatRgba8888;
+                return true;
+            }
+            if (info_.format == ANDROID_BITMAP_FORMAT_RGBA_F16) {
+                *format = avif_sample::kRgbFormatRgbaF16;
+                return true;
+            }
+            LOGE("Bitmap format (%d) is not supported.", info_.format);
+            return false;
+        }
 
-        ~AvifEncoderWrapper() {
-            if (encoder != nullptr) {
-                avifEncoderDestroy(encoder);
+        uint8_t *LockPixels() override {
+            void *pixels = nullptr;
+            if (AndroidBitmap_lockPixels(env_, bitmap_, &pixels) !=
+                ANDROID_BITMAP_RESULT_SUCCESS) {
+                LOGE("Failed to lock Bitmap.");
+                return nullptr;
             }
+            return static_cast<uint8_t *>(pixels);
         }
 
-        avifEncoder *encoder = nullptr;
+        void UnlockPixels() override { AndroidBitmap_unlockPixels(env_, bitmap_); }
+
+    private:
+        JNIEnv *const env_;
+        const jobject bitmap_;
+        const AndroidBitmapInfo info_;
     };
 
-    bool CreateDecoderAndParse(AvifDecoderWrapper *const decoder,
-                               const uint8_t *const buffer, int length) {
-        decoder->decoder = avifDecoderCreate();
-        if (decoder->decoder == nullptr) {
-            LOGE("Failed to create AVIF Decoder.");
-            return false;
-        }
-        decoder->decoder->ignoreXMP = AVIF_TRUE;
-        decoder->decoder->ignoreExif = AVIF_TRUE;
-        avifResult res = avifDecoderSetIOMemory(decoder->decoder, buffer, length);
-        if (res != AVIF_RESULT_OK) {
-            LOGE("Failed to set AVIF IO to a memory reader.");
-            return false;
+    jbyteArray ToByteArray(JNIEnv *env, avifRWData *data) {
+        jbyteArray jarr = env->NewByteArray(data->size);
+        if (jarr != nullptr) {
+            env->SetByteArrayRegion(jarr, 0, data->size,
+                                    reinterpret_cast<const jbyte *>(data->data));
         }
-        res = avifDecoderParse(decoder->decoder);
-        if (res != AVIF_RESULT_OK) {
-            LOGE("Failed to parse AVIF image: %s.", avifResultToString(res));
-            return false;
-        }
-        return true;
+        avifRWDataFree(data);
+        return jarr;
     }
 
 }  // namespace
@@ -95,204 +178,168 @@ jint JNI_OnLoad(JavaVM *vm, void * /*reserved*/) {
     global_info_width = env->GetFieldID(info_class, "width", "I");
     global_info_height = env->GetFieldID(info_class, "height", "I");
     global_info_depth = env->GetFieldID(info_class, "depth", "I");
+    const jclass memory_stats_class =
+            env->FindClass("com/gain/libavif/AvifCodec$MemoryStats");
+    global_memory_stats_allocation_count =
+            env->GetFieldID(memory_stats_class, "allocationCount", "J");
+    global_memory_stats_pool_hit_count =
+            env->GetFieldID(memory_stats_class, "poolHitCount", "J");
+    global_memory_stats_current_bytes =
+            env->GetFieldID(memory_stats_class, "currentBytes", "J");
+    global_memory_stats_peak_bytes =
+            env->GetFieldID(memory_stats_class, "peakBytes", "J");
+    global_memory_stats_pooled_bytes =
+            env->GetFieldID(memory_stats_class, "pooledBytes", "J");
+    global_memory_stats_frame_buffer_bytes =
+            env->GetFieldID(memory_stats_class, "frameBufferBytes", "J");
+    global_memory_stats_pooled_frame_buffer_bytes =
+            env->GetFieldID(memory_stats_class, "pooledFrameBufferBytes", "J");
+    global_memory_stats_page_faults_avoided =
+            env->GetFieldID(memory_stats_class, "pageFaultsAvoided", "J");
+    const jclass stats_class = env->FindClass("com/gain/libavif/AvifCodec$Stats");
+    global_stats_wall_time_ns = env->GetFieldID(stats_class, "wallTimeNs", "[J");
+    global_stats_cpu_time_ns = env->GetFieldID(stats_class, "cpuTimeNs", "[J");
+    global_stats_total_wall_time_ns =
+            env->GetFieldID(stats_class, "totalWallTimeNs", "J");
+    global_stats_total_cpu_time_ns =
+            env->GetFieldID(stats_class, "totalCpuTimeNs", "J");
+    global_stats_bytes_read = env->GetFieldID(stats_class, "bytesRead", "J");
+    global_stats_bytes_written = env->GetFieldID(stats_class, "bytesWritten", "J");
+    global_stats_color_obu_size = env->GetFieldID(stats_class, "colorObuSize", "J");
+    global_stats_alpha_obu_size = env->GetFieldID(stats_class, "alphaObuSize", "J");
+    global_stats_threads = env->GetFieldID(stats_class, "threads", "I");
+    global_stats_peak_memory_bytes =
+            env->GetFieldID(stats_class, "peakMemoryBytes", "J");
+    global_stats_cache_hit = env->GetFieldID(stats_class, "cacheHit", "Z");
+    // Route libgav1's allocations through the shared pool before any decoder
+    // exists. libavif and libaom are redirected at link time.
+    avif_sample::InstallCodecAllocators();
     return JNI_VERSION_1_6;
 }
 
 FUNC(jboolean, isAvifImage, jobject encoded, int length) {
     const uint8_t *const buffer =
             static_cast<const uint8_t *>(env->GetDirectBufferAddress(encoded));
-    const avifROData avif = {buffer, static_cast<size_t>(length)};
-    return avifPeekCompatibleFileType(&avif);
+    return avif_sample::IsAvifImage(buffer, length);
 }
 
-FUNC(jboolean, getInfo, jobject encoded, int length, jobject info) {
+FUNC(jboolean, getInfo, jobject encoded, int length, jobject info, jobject stats) {
+    JavaStatsReporter reporter(env, stats);
     const uint8_t *const buffer =
             static_cast<const uint8_t *>(env->GetDirectBufferAddress(encoded));
-    AvifDecoderWrapper decoder;
-    if (!CreateDecoderAndParse(&decoder, buffer, length)) {
+    avif_sample::ImageInfo image_info;
+    if (!avif_sample::GetImageInfo(buffer, length, &image_info, reporter.collector())) {
         return false;
     }
-    env->SetIntField(info, global_info_width, decoder.decoder->image->width);
-    env->SetIntField(info, global_info_height, decoder.decoder->image->height);
-    env->SetIntField(info, global_info_depth, decoder.decoder->image->depth);
+    env->SetIntField(info, global_info_width, image_info.width);
+    env->SetIntField(info, global_info_height, image_info.height);
+    env->SetIntField(info, global_info_depth, image_info.depth);
     return true;
 }
 
-FUNC(jboolean, decode, jobject encoded, int length, jobject bitmap) {
-    const uint8_t *const buffer =
-            static_cast<const uint8_t *>(env->GetDirectBufferAddress(encoded));
-    AvifDecoderWrapper decoder;
-    if (!CreateDecoderAndParse(&decoder, buffer, length)) {
-        return false;
-    }
-    avifResult res = avifDecoderNextImage(decoder.decoder);
-    if (res != AVIF_RESULT_OK) {
-        LOGE("Failed to decode AVIF image. Status: %d", res);
+FUNC(jboolean, decode, jobject encoded, int length, jobject bitmap, jint quality,
+     jobject stats) {
+    JavaStatsReporter reporter(env, stats);
+    if (quality < 0 || quality >= avif_sample::kNumDecodeQualities) {
+        LOGE("Invalid decode quality %d.", quality);
         return false;
     }
+    const uint8_t *const buffer =
+            static_cast<const uint8_t *>(env->GetDirectBufferAddress(encoded));
     AndroidBitmapInfo bitmap_info;
     if (AndroidBitmap_getInfo(env, bitmap, &bitmap_info) < 0) {
         LOGE("AndroidBitmap_getInfo failed.");
         return false;
     }
-    // Ensure that the bitmap is large enough to store the decoded image.
-    if (bitmap_info.width < decoder.decoder->image->width ||
-        bitmap_info.height < decoder.decoder->image->height) {
-        LOGE(
-                "Bitmap is not large enough to fit the image. Bitmap %dx%d Image "
-                "%dx%d.",
-                bitmap_info.width, bitmap_info.height, decoder.decoder->image->width,
-                decoder.decoder->image->height);
-        return false;
-    }
-    // Ensure that the bitmap format is either RGBA_8888 or RGBA_F16.
-    if (bitmap_info.format != ANDROID_BITMAP_FORMAT_RGBA_8888 &&
-        bitmap_info.format != ANDROID_BITMAP_FORMAT_RGBA_F16) {
-        LOGE("Bitmap format (%d) is not supported.", bitmap_info.format);
-        return false;
-    }
-    void *bitmap_pixels = nullptr;
-    if (AndroidBitmap_lockPixels(env, bitmap, &bitmap_pixels) !=
-        ANDROID_BITMAP_RESULT_SUCCESS) {
-        LOGE("Failed to lock Bitmap.");
-        return false;
-    }
-    avifRGBImage rgb_image;
-    avifRGBImageSetDefaults(&rgb_image, decoder.decoder->image);
-    if (bitmap_info.format == ANDROID_BITMAP_FORMAT_RGBA_F16) {
-        rgb_image.depth = 16;
-        rgb_image.isFloat = AVIF_TRUE;
-    } else {
-        rgb_image.depth = 8;
-    }
-    rgb_image.pixels = static_cast<uint8_t *>(bitmap_pixels);
-    rgb_image.rowBytes = bitmap_info.stride;
-    res = avifImageYUVToRGB(decoder.decoder->image, &rgb_image);
-    AndroidBitmap_unlockPixels(env, bitmap);
-    if (res != AVIF_RESULT_OK) {
-        LOGE("Failed to convert YUV Pixels to RGB. Status: %d", res);
-        return false;
-    }
-    return true;
+    BitmapSurface surface(env, bitmap, bitmap_info);
+    avif_sample::DecodeOptions options;
+    options.quality = static_cast<avif_sample::DecodeQuality>(quality);
+    return avif_sample::DecodeToSurface(buffer, length, options, &surface,
+                                        reporter.collector());
 }
 
-FUNC(jbyteArray, encodeRGBA8888, jobject pixels, int length, int width, int height) {
-    AvifEncoderWrapper encode;
-    avifRWData avifOutput = AVIF_DATA_EMPTY;
-    avifRGBImage rgb;
-    memset(&rgb, 0, sizeof(rgb));
+FUNC(void, setCacheBudget, jlong bytes) {
+    ImageCache::Global().SetBudget(bytes > 0 ? static_cast<size_t>(bytes) : 0);
+}
 
-    avifImage *image = avifImageCreate(width, height, 8,
-                                       AVIF_PIXEL_FORMAT_YUV444); // these values dictate what goes into the final AVIF
-    avifRGBImageSetDefaults(&rgb, image);
-    // Override RGB(A)->YUV(A) defaults here: depth, format, chromaUpsampling, ignoreAlpha, alphaPremultiplied, libYUVUsage, etc
+FUNC(void, trimCache, jlong target_bytes) {
+    ImageCache::Global().Trim(target_bytes > 0 ? static_cast<size_t>(target_bytes) : 0);
+}
 
-    // Alternative: set rgb.pixels and rgb.rowBytes yourself, which should match your chosen rgb.format
-    // Be sure to use uint16_t* instead of uint8_t* for rgb.pixels/rgb.rowBytes if (rgb.depth > 8)
-    avifRGBImageAllocatePixels(&rgb);
+FUNC(jlong, getCacheSize) {
+    return static_cast<jlong>(ImageCache::Global().size_bytes());
+}
 
-    // Fill your RGB(A) data here
-    const uint8_t *const pixelBuffer =
-            static_cast<const uint8_t *>(env->GetDirectBufferAddress(pixels));
-    memcpy(rgb.pixels, pixelBuffer, rgb.rowBytes * image->height);
+FUNC(void, getMemoryStats, jobject stats) {
+    const avif_sample::MemoryPoolStats pool_stats = MemoryPool::Global().GetStats();
+    env->SetLongField(stats, global_memory_stats_allocation_count,
+                      static_cast<jlong>(pool_stats.allocation_count));
+    env->SetLongField(stats, global_memory_stats_pool_hit_count,
+                      static_cast<jlong>(pool_stats.pool_hit_count));
+    env->SetLongField(stats, global_memory_stats_current_bytes,
+                      static_cast<jlong>(pool_stats.current_bytes));
+    env->SetLongField(stats, global_memory_stats_peak_bytes,
+                      static_cast<jlong>(pool_stats.peak_bytes));
+    env->SetLongField(stats, global_memory_stats_pooled_bytes,
+                      static_cast<jlong>(pool_stats.pooled_bytes));
+    const avif_sample::FrameBufferPoolStats frame_stats = FrameBufferPool::Global().GetStats();
+    env->SetLongField(stats, global_memory_stats_frame_buffer_bytes,
+                      static_cast<jlong>(frame_stats.current_bytes));
+    env->SetLongField(stats, global_memory_stats_pooled_frame_buffer_bytes,
+                      static_cast<jlong>(frame_stats.pooled_bytes));
+    env->SetLongField(stats, global_memory_stats_page_faults_avoided,
+                      static_cast<jlong>(frame_stats.page_faults_avoided));
+}
 
-    avifResult convertResult = avifImageRGBToYUV(image, &rgb);
+FUNC(void, resetPeakMemory) {
+    MemoryPool::Global().ResetPeak();
+}
 
-    if (convertResult != AVIF_RESULT_OK) {
-        LOGE("Failed to convert to YUV(A): %s\n", avifResultToString(convertResult));
-        return NULL;
-    }
+FUNC(void, setMemoryPoolRetainLimit, jlong bytes) {
+    MemoryPool::Global().SetRetainLimit(bytes > 0 ? static_cast<size_t>(bytes) : 0);
+}
 
-    encode.encoder = avifEncoderCreate();
-    encode.encoder->maxThreads = 64;
-    encode.encoder->speed = AVIF_SPEED_FASTEST;
-    encode.encoder->maxQuantizer = 24;
-    encode.encoder->minQuantizer = 22;
-
-    // Call avifEncoderAddImage() for each image in your sequence
-    // Only set AVIF_ADD_IMAGE_FLAG_SINGLE if you're not encoding a sequence
-    // Use avifEncoderAddImageGrid() instead with an array of avifImage* to make a grid image
-    avifResult addImageResult = avifEncoderAddImage(encode.encoder, image, 1,
-                                                    AVIF_ADD_IMAGE_FLAG_SINGLE);
-    if (addImageResult != AVIF_RESULT_OK) {
-        LOGE("Failed to add image to encoder: %s\n", avifResultToString(addImageResult));
-        return NULL;
-    }
+FUNC(void, trimMemoryPool) {
+    MemoryPool::Global().Trim();
+    FrameBufferPool::Global().Trim();
+}
 
-    avifResult finishResult = avifEncoderFinish(encode.encoder, &avifOutput);
-    if (finishResult != AVIF_RESULT_OK) {
-        LOGE("Failed to finish encode: %s\n", avifResultToString(finishResult));
-        return NULL;
+FUNC(void, setFrameBuffers, jint backing) {
+    if (backing < 0 || backing >= avif_sample::kNumFrameBufferBackings) {
+        LOGE("Invalid frame buffer backing %d.", backing);
+        return;
     }
+    FrameBufferPool::Global().SetBacking(static_cast<avif_sample::FrameBufferBacking>(backing));
+}
 
-    jbyteArray jarr = env->NewByteArray(avifOutput.size);
-    env->SetByteArrayRegion(jarr, 0, avifOutput.size,
-                            reinterpret_cast<const jbyte *>(avifOutput.data));
-
-    if (image) {
-        avifImageDestroy(image);
+FUNC(jbyteArray, encodeRGBA8888, jobject pixels, int length, int width, int height,
+     jobject stats) {
+    JavaStatsReporter reporter(env, stats);
+    const uint8_t *const pixel_buffer =
+            static_cast<const uint8_t *>(env->GetDirectBufferAddress(pixels));
+    avifRWData output = AVIF_DATA_EMPTY;
+    if (!avif_sample::EncodeRgba8888(pixel_buffer, width, height,
+                                     avif_sample::EncodeOptions(), &output,
+                                     reporter.collector())) {
+        return NULL;
     }
-
-    avifRWDataFree(&avifOutput);
-    avifRGBImageFreePixels(&rgb); // Only use in conjunction with avifRGBImageAllocatePixels()
-
-    return jarr;
+    return ToByteArray(env, &output);
 }
 
-FUNC(jbyteArray, encodeY420, jobject yBuf, jobject uBuf, jobject vBuf, int strideY, int strideU, int strideV, int width, int height) {
-    AvifEncoderWrapper encode;
-    avifRWData avifOutput = AVIF_DATA_EMPTY;
-    avifRGBImage rgb;
-    memset(&rgb, 0, sizeof(rgb));
-
-    avifImage *image = avifImageCreate(width, height, 8,
-                                       AVIF_PIXEL_FORMAT_YUV420); // these values dictate what goes into the final AVIF
-
-    avifImageAllocatePlanes(image, AVIF_PLANES_YUV | AVIF_PLANES_A);
-
-    // Fill your YUV(A) data here
+FUNC(jbyteArray, encodeY420, jobject yBuf, jobject uBuf, jobject vBuf, int strideY, int strideU, int strideV, int width, int height,
+     jobject stats) {
+    JavaStatsReporter reporter(env, stats);
     const uint8_t *const pYBuf =
             static_cast<const uint8_t *>(env->GetDirectBufferAddress(yBuf));
     const uint8_t *const pUBuf =
             static_cast<const uint8_t *>(env->GetDirectBufferAddress(uBuf));
     const uint8_t *const pVBuf =
             static_cast<const uint8_t *>(env->GetDirectBufferAddress(vBuf));
-    memcpy(image->yuvPlanes[AVIF_CHAN_Y], pYBuf, image->yuvRowBytes[AVIF_CHAN_Y] * image->height);
-    memcpy(image->yuvPlanes[AVIF_CHAN_U], pUBuf, image->yuvRowBytes[AVIF_CHAN_U] * image->height/2);
-    memcpy(image->yuvPlanes[AVIF_CHAN_V], pVBuf, image->yuvRowBytes[AVIF_CHAN_V] * image->height/2);
-    memset(image->alphaPlane, 255, image->alphaRowBytes * image->height);
-
-    encode.encoder = avifEncoderCreate();
-    encode.encoder->maxThreads = 64;
-    encode.encoder->speed = AVIF_SPEED_FASTEST;
-    encode.encoder->maxQuantizer = 24;
-    encode.encoder->minQuantizer = 22;
-
-    // Call avifEncoderAddImage() for each image in your sequence
-    // Only set AVIF_ADD_IMAGE_FLAG_SINGLE if you're not encoding a sequence
-    // Use avifEncoderAddImageGrid() instead with an array of avifImage* to make a grid image
-    avifResult addImageResult = avifEncoderAddImage(encode.encoder, image, 1,
-                                                    AVIF_ADD_IMAGE_FLAG_SINGLE);
-    if (addImageResult != AVIF_RESULT_OK) {
-        LOGE("Failed to add image to encoder: %s\n", avifResultToString(addImageResult));
+    avifRWData output = AVIF_DATA_EMPTY;
+    if (!avif_sample::EncodeY420(pYBuf, pUBuf, pVBuf, strideY, strideU, strideV, width,
+                                 height, avif_sample::EncodeOptions(), &output,
+                                 reporter.collector())) {
         return NULL;
     }
-
-    avifResult finishResult = avifEncoderFinish(encode.encoder, &avifOutput);
-    if (finishResult != AVIF_RESULT_OK) {
-        LOGE("Failed to finish encode: %s\n", avifResultToString(finishResult));
-        return NULL;
-    }
-
-    jbyteArray jarr = env->NewByteArray(avifOutput.size);
-    env->SetByteArrayRegion(jarr, 0, avifOutput.size,
-                            reinterpret_cast<const jbyte *>(avifOutput.data));
-
-    if (image) {
-        avifImageDestroy(image);
-    }
-    avifRWDataFree(&avifOutput);
-    avifRGBImageFreePixels(&rgb); // Only use in conjunction with avifRGBImageAllocatePixels()
-
-    return jarr;
-}
\ No newline at end of file
+    return ToByteArray(env, &output);
+}
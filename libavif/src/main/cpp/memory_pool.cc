@@ -0,0 +1,272 @@
+#include "memory_pool.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <cstddef>
+
+#include "gav1/allocator.h"
+
+namespace avif_sample {
+
+namespace {
+
+// Every block starts with a BlockHeader padded to kHeaderSpace bytes, so
+// pointers handed out are kBlockAlignment aligned, which covers the largest
+// SIMD alignment libaom and libgav1 ask for.
+constexpr size_t kBlockAlignment = 64;
+constexpr size_t kHeaderSpace = 64;
+constexpr uint32_t kBlockMagic = 0xA71FB10Cu;
+constexpr int kMinPooledShift = 12;
+static_assert(MemoryPool::kMinPooledSize == size_t{1} << kMinPooledShift,
+              "kMinPooledShift does not match kMinPooledSize");
+
+void *SystemAlloc(size_t alignment, size_t size) {
+    void *ptr = nullptr;
+    if (posix_memalign(&ptr, alignment, size) != 0) return nullptr;
+    return ptr;
+}
+
+}  // namespace
+
+struct MemoryPool::BlockHeader {
+    BlockHeader *next;  // Free list link while the block is idle.
+    void *base;         // Address returned by the system allocator.
+    size_t size;        // Bytes requested by the current owner.
+    int32_t size_class;  // -1 for unpooled blocks.
+    uint32_t magic;
+};
+
+MemoryPool::MemoryPool()
+        : retain_limit_(kDefaultRetainLimit),
+          pooled_bytes_(0),
+          current_bytes_(0),
+          peak_bytes_(0),
+          allocation_count_(0),
+          pool_hit_count_(0) {
+    static_assert(sizeof(BlockHeader) <= kHeaderSpace,
+                  "BlockHeader does not fit in the reserved header space");
+    for (int i = 0; i < kNumSizeClasses; ++i) {
+        if (i == 0) {
+            classes_[i].capacity = kMinPooledSize;
+            continue;
+        }
+        const size_t base = kMinPooledSize << ((i - 1) / kClassesPerDoubling);
+        const size_t step = base / kClassesPerDoubling;
+        classes_[i].capacity = base + ((i - 1) % kClassesPerDoubling + 1) * step;
+    }
+}
+
+MemoryPool::~MemoryPool() { Trim(); }
+
+MemoryPool &MemoryPool::Global() {
+    // Never destroyed: codec threads may still free blocks during exit.
+    static MemoryPool *const pool = new MemoryPool();
+    return *pool;
+}
+
+int MemoryPool::SizeClassIndex(size_t size) {
+    if (size <= kMinPooledSize) return 0;
+    const size_t n = size - 1;
+    int msb = 0;
+    while ((n >> (msb + 1)) != 0) ++msb;
+    // The two bits below the most significant one select the quarter step.
+    const int sub = static_cast<int>((n - (size_t{1} << msb)) >> (msb - 2));
+    return (msb - kMinPooledShift) * kClassesPerDoubling + sub + 1;
+}
+
+void *MemoryPool::Allocate(size_t size, size_t alignment) {
+    if (size == 0) size = 1;
+    allocation_count_.fetch_add(1, std::memory_order_relaxed);
+    if (size < kMinPooledSize || size > kMaxPooledSize ||
+        alignment > kBlockAlignment) {
+        return AllocateUnpooled(size, alignment);
+    }
+    const int index = SizeClassIndex(size);
+    SizeClass &size_class = classes_[index];
+    BlockHeader *header = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(size_class.mutex);
+        header = size_class.free_list;
+        if (header != nullptr) size_class.free_list = header->next;
+    }
+    if (header != nullptr) {
+        pooled_bytes_.fetch_sub(size_class.capacity, std::memory_order_relaxed);
+        pool_hit_count_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        void *const base = SystemAlloc(kBlockAlignment, kHeaderSpace + size_class.capacity);
+        if (base == nullptr) return nullptr;
+        header = static_cast<BlockHeader *>(base);
+        header->base = base;
+        header->size_class = index;
+        header->magic = kBlockMagic;
+    }
+    header->next = nullptr;
+    header->size = size;
+    TrackAllocation(size);
+    return reinterpret_cast<uint8_t *>(header) + kHeaderSpace;
+}
+
+void *MemoryPool::AllocateUnpooled(size_t size, size_t alignment) {
+    // The header sits in the kHeaderSpace bytes just below the returned
+    // pointer. With a larger alignment the whole first alignment unit is
+    // reserved so that the pointer stays aligned.
+    const size_t block_alignment = std::max(alignment, kBlockAlignment);
+    const size_t offset = std::max(block_alignment, kHeaderSpace);
+    if (size > SIZE_MAX - offset) return nullptr;
+    void *const base = SystemAlloc(block_alignment, offset + size);
+    if (base == nullptr) return nullptr;
+    uint8_t *const ptr = static_cast<uint8_t *>(base) + offset;
+    BlockHeader *const header = reinterpret_cast<BlockHeader *>(ptr - kHeaderSpace);
+    header->next = nullptr;
+    header->base = base;
+    header->size = size;
+    header->size_class = -1;
+    header->magic = kBlockMagic;
+    TrackAllocation(size);
+    return ptr;
+}
+
+void MemoryPool::TrackAllocation(size_t size) {
+    const size_t current =
+            current_bytes_.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peak = peak_bytes_.load(std::memory_order_relaxed);
+    while (current > peak &&
+           !peak_bytes_.compare_exchange_weak(peak, current,
+                                              std::memory_order_relaxed)) {
+    }
+}
+
+void MemoryPool::Free(void *ptr) {
+    if (ptr == nullptr) return;
+    BlockHeader *const header = reinterpret_cast<BlockHeader *>(
+            static_cast<uint8_t *>(ptr) - kHeaderSpace);
+    if (header->magic != kBlockMagic) {
+        // Not ours; this would be a mismatched allocator pair in a codec.
+        abort();
+    }
+    current_bytes_.fetch_sub(header->size, std::memory_order_relaxed);
+    if (header->size_class < 0) {
+        header->magic = 0;
+        free(header->base);
+        return;
+    }
+    SizeClass &size_class = classes_[header->size_class];
+    const size_t pooled =
+            pooled_bytes_.fetch_add(size_class.capacity, std::memory_order_relaxed) +
+            size_class.capacity;
+    if (pooled > retain_limit_.load(std::memory_order_relaxed)) {
+        pooled_bytes_.fetch_sub(size_class.capacity, std::memory_order_relaxed);
+        header->magic = 0;
+        free(header->base);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(size_class.mutex);
+    header->next = size_class.free_list;
+    size_class.free_list = header;
+}
+
+MemoryPoolStats MemoryPool::GetStats() const {
+    MemoryPoolStats stats;
+    stats.allocation_count = allocation_count_.load(std::memory_order_relaxed);
+    stats.pool_hit_count = pool_hit_count_.load(std::memory_order_relaxed);
+    stats.current_bytes = current_bytes_.load(std::memory_order_relaxed);
+    stats.peak_bytes = peak_bytes_.load(std::memory_order_relaxed);
+    stats.pooled_bytes = pooled_bytes_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void MemoryPool::ResetPeak() {
+    peak_bytes_.store(current_bytes_.load(std::memory_order_relaxed),
+                      std::memory_order_relaxed);
+}
+
+void MemoryPool::SetRetainLimit(size_t bytes) {
+    retain_limit_.store(bytes, std::memory_order_relaxed);
+    ReleaseIdle(bytes);
+}
+
+void MemoryPool::Trim() { ReleaseIdle(0); }
+
+void MemoryPool::ReleaseIdle(size_t target_bytes) {
+    // Release the largest blocks first; they are the most expensive to keep.
+    for (int i = kNumSizeClasses - 1; i >= 0; --i) {
+        SizeClass &size_class = classes_[i];
+        while (pooled_bytes_.load(std::memory_order_relaxed) > target_bytes) {
+            BlockHeader *header;
+            {
+                std::lock_guard<std::mutex> lock(size_class.mutex);
+                header = size_class.free_list;
+                if (header == nullptr) break;
+                size_class.free_list = header->next;
+            }
+            pooled_bytes_.fetch_sub(size_class.capacity, std::memory_order_relaxed);
+            header->magic = 0;
+            free(header->base);
+        }
+    }
+}
+
+namespace {
+
+void *Gav1AlignedAlloc(void *callback_private_data, size_t alignment, size_t size) {
+    return static_cast<MemoryPool *>(callback_private_data)->Allocate(size, alignment);
+}
+
+void Gav1AlignedFree(void *callback_private_data, void *ptr) {
+    static_cast<MemoryPool *>(callback_private_data)->Free(ptr);
+}
+
+}  // namespace
+
+void InstallCodecAllocators() {
+    libgav1::SetAllocator(Gav1AlignedAlloc, Gav1AlignedFree, &MemoryPool::Global());
+}
+
+}  // namespace avif_sample
+
+// Link-time replacements for the libavif and libaom allocation functions,
+// enabled with -Wl,--wrap=<symbol> in CMakeLists.txt.
+extern "C" {
+
+void *__wrap_avifAlloc(size_t size);
+void __wrap_avifFree(void *p);
+void *__wrap_aom_memalign(size_t align, size_t size);
+void *__wrap_aom_malloc(size_t size);
+void *__wrap_aom_calloc(size_t num, size_t size);
+void __wrap_aom_free(void *memblk);
+
+void *__wrap_avifAlloc(size_t size) {
+    return avif_sample::MemoryPool::Global().Allocate(size, alignof(std::max_align_t));
+}
+
+void __wrap_avifFree(void *p) { avif_sample::MemoryPool::Global().Free(p); }
+
+// Mirrors AOM_MAX_ALLOCABLE_MEMORY and DEFAULT_ALIGNMENT in aom_mem.
+#if SIZE_MAX > 0xffffffffu
+static const uint64_t kAomMaxAllocableMemory = 8589934592ull;
+#else
+static const uint64_t kAomMaxAllocableMemory = (1ull << 31) - (1 << 16);
+#endif
+static const size_t kAomDefaultAlignment = 2 * sizeof(size_t);
+
+void *__wrap_aom_memalign(size_t align, size_t size) {
+    if (static_cast<uint64_t>(size) > kAomMaxAllocableMemory) return nullptr;
+    return avif_sample::MemoryPool::Global().Allocate(size, align);
+}
+
+void *__wrap_aom_malloc(size_t size) {
+    return __wrap_aom_memalign(kAomDefaultAlignment, size);
+}
+
+void *__wrap_aom_calloc(size_t num, size_t size) {
+    if (size != 0 && num > SIZE_MAX / size) return nullptr;
+    void *const ptr = __wrap_aom_malloc(num * size);
+    if (ptr != nullptr) memset(ptr, 0, num * size);
+    return ptr;
+}
+
+void __wrap_aom_free(void *memblk) { avif_sample::MemoryPool::Global().Free(memblk); }
+
+}  // extern "C"
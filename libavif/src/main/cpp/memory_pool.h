@@ -0,0 +1,109 @@
+#ifndef AVIF_SAMPLE_MEMORY_POOL_H_
+#define AVIF_SAMPLE_MEMORY_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <mutex>
+
+namespace avif_sample {
+
+struct MemoryPoolStats {
+    // Number of allocations served since the process started.
+    uint64_t allocation_count;
+    // Number of those allocations that reused an idle pooled block.
+    uint64_t pool_hit_count;
+    // Bytes currently handed out to libavif, libaom and libgav1.
+    size_t current_bytes;
+    // High-water mark of |current_bytes| since the last ResetPeak().
+    size_t peak_bytes;
+    // Bytes held in idle blocks waiting to be reused.
+    size_t pooled_bytes;
+};
+
+// Size-class pool shared by libavif (avifAlloc), libaom (aom_malloc and
+// friends) and libgav1 (AlignedAlloc). Mid-size and large requests are rounded
+// up to one of four classes per power of two, and freed blocks are kept on a
+// per-class free list for the next decode instead of going back to the heap.
+// This keeps the working set of a long-running decoder stable and avoids the
+// fragmentation caused by many differently sized short-lived buffers.
+//
+// Blocks are freed from arbitrary threads and in arbitrary order by the
+// codecs, so a bump arena cannot be used; the pool is thread-safe with one
+// lock per size class.
+class MemoryPool {
+public:
+    // Requests smaller than this are not pooled; the system allocator handles
+    // them well.
+    static constexpr size_t kMinPooledSize = 4 * 1024;
+    // Requests larger than this are not pooled.
+    static constexpr size_t kMaxPooledSize = 64 * 1024 * 1024;
+    static constexpr size_t kDefaultRetainLimit = 64 * 1024 * 1024;
+
+    MemoryPool();
+
+    // Not copyable or movable.
+    MemoryPool(const MemoryPool &) = delete;
+
+    MemoryPool &operator=(const MemoryPool &) = delete;
+
+    ~MemoryPool();
+
+    // The process-wide pool the codec allocation hooks route through.
+    static MemoryPool &Global();
+
+    // Returns |size| bytes aligned to |alignment| (a power of 2), or nullptr.
+    void *Allocate(size_t size, size_t alignment);
+
+    // Frees memory returned by Allocate(). |ptr| may be nullptr.
+    void Free(void *ptr);
+
+    MemoryPoolStats GetStats() const;
+
+    // Restarts peak tracking from the current usage, e.g. at the start of a
+    // decode session.
+    void ResetPeak();
+
+    // Caps the number of idle bytes kept for reuse and releases the excess.
+    void SetRetainLimit(size_t bytes);
+
+    // Returns all idle blocks to the system.
+    void Trim();
+
+private:
+    struct BlockHeader;
+
+    // Four classes per power of two from kMinPooledSize to kMaxPooledSize.
+    static constexpr int kClassesPerDoubling = 4;
+    static constexpr int kNumSizeClasses = 14 * kClassesPerDoubling + 1;
+
+    struct SizeClass {
+        std::mutex mutex;
+        BlockHeader *free_list = nullptr;
+        size_t capacity = 0;
+    };
+
+    static int SizeClassIndex(size_t size);
+
+    void *AllocateUnpooled(size_t size, size_t alignment);
+    void TrackAllocation(size_t size);
+    void ReleaseIdle(size_t target_bytes);
+
+    SizeClass classes_[kNumSizeClasses];
+    std::atomic<size_t> retain_limit_;
+    std::atomic<size_t> pooled_bytes_;
+    std::atomic<size_t> current_bytes_;
+    std::atomic<size_t> peak_bytes_;
+    std::atomic<uint64_t> allocation_count_;
+    std::atomic<uint64_t> pool_hit_count_;
+};
+
+// Points libgav1's AlignedAlloc() at MemoryPool::Global(). libavif and libaom
+// are redirected at link time with -Wl,--wrap (see CMakeLists.txt). Must be
+// called before the first decoder is created.
+void InstallCodecAllocators();
+
+}  // namespace avif_sample
+
+#endif  // AVIF_SAMPLE_MEMORY_POOL_H_
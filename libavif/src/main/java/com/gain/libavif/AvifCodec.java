@@ -1,5 +1,6 @@
 package com.gain.libavif;
 
+import android.content.ComponentCallbacks2;
 import android.graphics.Bitmap;
 
 import java.nio.ByteBuffer;
@@ -15,6 +16,35 @@ public class AvifCodec {
     }
   }
 
+  /** Bit exact decode. */
+  public static final int QUALITY_FULL = 0;
+  /**
+   * Skips the CDEF, loop restoration and film grain AV1 filters and uses the fastest chroma
+   * upsampling. Fine detail may soften slightly; block edges stay hidden.
+   */
+  public static final int QUALITY_FAST = 1;
+  /** Like QUALITY_FAST, and also skips deblocking, so block edges may show at low bitrates. */
+  public static final int QUALITY_FASTEST = 2;
+  /**
+   * Like QUALITY_FASTEST, at a quarter of the width and height (rounded up), for thumbnails. The
+   * bitmap then needs to be only (width + 3) / 4 by (height + 3) / 4. Grid images fail to decode
+   * in this mode; decode them with QUALITY_FASTEST instead.
+   */
+  public static final int QUALITY_PREVIEW = 3;
+
+  /** The AV1 decoder allocates its own frame buffers from the memory pool. */
+  public static final int FRAME_BUFFERS_DEFAULT = 0;
+  /**
+   * Decoded frames go to pooled buffers whose pages are faulted in when first mapped, and are
+   * reused for later images of a similar size.
+   */
+  public static final int FRAME_BUFFERS_PREFAULTED = 1;
+  /**
+   * Like FRAME_BUFFERS_PREFAULTED, with the buffers backed by transparent huge pages where the
+   * kernel allows it. Best for large camera frames.
+   */
+  public static final int FRAME_BUFFERS_HUGE_PAGES = 2;
+
   // This is a utility class and cannot be instantiated.
   private AvifCodec() {}
 
@@ -25,6 +55,91 @@ public class AvifCodec {
     public int depth;
   }
 
+  /**
+   * Statistics of the native memory pool that libavif, the AV1 encoder and the AV1 decoder allocate
+   * from.
+   */
+  public static class MemoryStats {
+    /** Number of allocations served since the library was loaded. */
+    public long allocationCount;
+    /** Number of allocations served by reusing an idle pooled block. */
+    public long poolHitCount;
+    /** Bytes currently allocated by the codecs. */
+    public long currentBytes;
+    /** Highest value of currentBytes since the last {@link #resetPeakMemory()}. */
+    public long peakBytes;
+    /** Bytes held in idle blocks kept for reuse. */
+    public long pooledBytes;
+    /** Bytes of decoded frame buffers currently in use, see {@link #setFrameBuffers(int)}. */
+    public long frameBufferBytes;
+    /** Bytes of idle frame buffers kept for reuse. */
+    public long pooledFrameBufferBytes;
+    /**
+     * Page faults the decoder did not take while writing frames, thanks to the pooled frame
+     * buffers.
+     */
+    public long pageFaultsAvoided;
+  }
+
+  /**
+   * Per-call timings and sizes, filled by the overloads that take a Stats argument. Collection is
+   * opt-in: calls without a Stats object read no clocks.
+   */
+  public static class Stats {
+    /** avifDecoderParse(): the AVIF container and the AV1 sequence header. */
+    public static final int STAGE_CONTAINER_PARSE = 0;
+    /** AV1 OBU parsing, up to and including the tile group headers. */
+    public static final int STAGE_AV1_PARSE = 1;
+    /** AV1 entropy decoding, prediction and reconstruction. */
+    public static final int STAGE_AV1_TILE_DECODE = 2;
+    public static final int STAGE_AV1_DEBLOCK = 3;
+    public static final int STAGE_AV1_CDEF = 4;
+    public static final int STAGE_AV1_SUPER_RES = 5;
+    public static final int STAGE_AV1_LOOP_RESTORATION = 6;
+    public static final int STAGE_AV1_BORDER_EXTENSION = 7;
+    public static final int STAGE_AV1_FILM_GRAIN = 8;
+    /** Copying the decoded AV1 frame out of the decoder. */
+    public static final int STAGE_AV1_OUTPUT = 9;
+    /** avifDecoderNextImage() as a whole, including all the STAGE_AV1_* stages. */
+    public static final int STAGE_IMAGE_DECODE = 10;
+    public static final int STAGE_YUV_TO_RGB = 11;
+    public static final int STAGE_RGB_TO_YUV = 12;
+    /** avifEncoderAddImage(), which runs the AV1 encoder. */
+    public static final int STAGE_ENCODE = 13;
+    /** avifEncoderFinish(), which writes the AVIF container. */
+    public static final int STAGE_ENCODE_FINISH = 14;
+    public static final int NUM_STAGES = 15;
+
+    /** Wall time per stage, indexed by the STAGE_* constants. */
+    public final long[] wallTimeNs = new long[NUM_STAGES];
+    /**
+     * Process CPU time per stage. A value above the wall time of the stage means that it kept
+     * several threads busy.
+     */
+    public final long[] cpuTimeNs = new long[NUM_STAGES];
+    /** Wall time of the whole call. */
+    public long totalWallTimeNs;
+    /** Process CPU time during the whole call. */
+    public long totalCpuTimeNs;
+    /** Encoded bytes consumed by a decode. */
+    public long bytesRead;
+    /** Encoded bytes produced by an encode. */
+    public long bytesWritten;
+    /** Size of the color AV1 payload. */
+    public long colorObuSize;
+    /** Size of the alpha AV1 payload. */
+    public long alphaObuSize;
+    /** Thread limit the codec ran with. */
+    public int threads;
+    /**
+     * Native memory high-water mark at the end of the call; see {@link MemoryStats#peakBytes}. Call
+     * {@link #resetPeakMemory()} before the call to measure a single call.
+     */
+    public long peakMemoryBytes;
+    /** True if the decode was served from the decoded-image cache. */
+    public boolean cacheHit;
+  }
+
   /**
    * Returns true if the bytes in the buffer seem like an AVIF image.
    *
@@ -45,7 +160,16 @@ public class AvifCodec {
    * @param info Output parameter whose fields will be populated.
    * @return true on success and false on failure.
    */
-  public static native boolean getInfo(ByteBuffer encoded, int length, Info info);
+  public static boolean getInfo(ByteBuffer encoded, int length, Info info) {
+    return getInfo(encoded, length, info, null);
+  }
+
+  /**
+   * Same as {@link #getInfo(ByteBuffer, int, Info)}, and also fills stats.
+   *
+   * @param stats Output parameter whose fields will be populated, or null.
+   */
+  public static native boolean getInfo(ByteBuffer encoded, int length, Info info, Stats stats);
 
   /**
    * Decodes the AVIF image into the bitmap.
@@ -56,7 +180,98 @@ public class AvifCodec {
    * @return true on success and false on failure. A few possible reasons for failure are: 1) Input
    *     was not valid AVIF. 2) Bitmap was not large enough to store the decoded image.
    */
-  public static native boolean decode(ByteBuffer encoded, int length, Bitmap bitmap);
+  public static boolean decode(ByteBuffer encoded, int length, Bitmap bitmap) {
+    return decode(encoded, length, bitmap, null);
+  }
+
+  /**
+   * Same as {@link #decode(ByteBuffer, int, Bitmap)}, and also fills stats.
+   *
+   * @param stats Output parameter whose fields will be populated, or null.
+   */
+  public static boolean decode(ByteBuffer encoded, int length, Bitmap bitmap, Stats stats) {
+    return decode(encoded, length, bitmap, QUALITY_FULL, stats);
+  }
+
+  /**
+   * Same as {@link #decode(ByteBuffer, int, Bitmap, Stats)}, trading fidelity for speed, e.g. for
+   * images in a scrolling gallery. Images are cached per quality.
+   *
+   * @param quality One of the QUALITY_* constants.
+   * @param stats Output parameter whose fields will be populated, or null.
+   */
+  public static native boolean decode(
+      ByteBuffer encoded, int length, Bitmap bitmap, int quality, Stats stats);
+
+  /**
+   * Sets the memory budget of the decoded-image cache. Decoded images are cached as YUV keyed by
+   * the content of the encoded buffer, the size of the destination bitmap and the decode quality,
+   * so decoding the same image again only costs the colour conversion. Defaults to 32 MiB.
+   *
+   * @param bytes Maximum number of bytes to hold. 0 disables the cache and releases its memory.
+   */
+  public static native void setCacheBudget(long bytes);
+
+  /**
+   * Evicts least recently used images until the cache holds at most targetBytes.
+   *
+   * @param targetBytes Number of bytes to keep. The budget itself is unchanged.
+   */
+  public static native void trimCache(long targetBytes);
+
+  /** Returns the number of bytes currently held by the decoded-image cache. */
+  public static native long getCacheSize();
+
+  /** Releases all cached decoded images. */
+  public static void clearCache() {
+    trimCache(0);
+  }
+
+  /**
+   * Shrinks the decoded-image cache in response to memory pressure. Call this from
+   * {@link ComponentCallbacks2#onTrimMemory(int)}.
+   *
+   * @param level The trim level passed to onTrimMemory().
+   */
+  public static void trimMemory(int level) {
+    if (level >= ComponentCallbacks2.TRIM_MEMORY_BACKGROUND
+        || level == ComponentCallbacks2.TRIM_MEMORY_RUNNING_CRITICAL) {
+      clearCache();
+      trimMemoryPool();
+    } else if (level >= ComponentCallbacks2.TRIM_MEMORY_RUNNING_LOW) {
+      trimCache(getCacheSize() / 2);
+      trimMemoryPool();
+    }
+  }
+
+  /**
+   * Fills stats with the current statistics of the native memory pool.
+   *
+   * @param stats Output parameter whose fields will be populated.
+   */
+  public static native void getMemoryStats(MemoryStats stats);
+
+  /** Restarts peak tracking from the current usage, e.g. at the start of a decode session. */
+  public static native void resetPeakMemory();
+
+  /**
+   * Limits how many bytes of freed codec memory the native pool keeps for reuse. Defaults to 64
+   * MiB.
+   *
+   * @param bytes Maximum number of idle bytes to keep. 0 disables reuse.
+   */
+  public static native void setMemoryPoolRetainLimit(long bytes);
+
+  /** Returns all idle pooled memory, including idle frame buffers, to the system. */
+  public static native void trimMemoryPool();
+
+  /**
+   * Selects where the AV1 decoder puts decoded frames. Takes effect for the decodes started
+   * afterwards. Defaults to FRAME_BUFFERS_DEFAULT.
+   *
+   * @param backing One of the FRAME_BUFFERS_* constants.
+   */
+  public static native void setFrameBuffers(int backing);
 
   /**
    * Encode the rgba data into AVIF image.
@@ -66,7 +281,17 @@ public class AvifCodec {
    * @param height
    * @return AVIF image's content
    */
-  public static native byte[] encodeRGBA8888(ByteBuffer rgbaData, int length, int width, int height);
+  public static byte[] encodeRGBA8888(ByteBuffer rgbaData, int length, int width, int height) {
+    return encodeRGBA8888(rgbaData, length, width, height, null);
+  }
+
+  /**
+   * Same as {@link #encodeRGBA8888(ByteBuffer, int, int, int)}, and also fills stats.
+   *
+   * @param stats Output parameter whose fields will be populated, or null.
+   */
+  public static native byte[] encodeRGBA8888(
+      ByteBuffer rgbaData, int length, int width, int height, Stats stats);
 
   /**
    * Encode the Y420 data into AVIF image.
@@ -80,6 +305,23 @@ public class AvifCodec {
    * @param height
    * @return AVIF image's content
    */
+  public static byte[] encodeY420(ByteBuffer yData,
+                                 ByteBuffer uData,
+                                 ByteBuffer vData,
+                                 int strideY,
+                                 int strideU,
+                                 int strideV,
+                                 int width,
+                                 int height) {
+    return encodeY420(yData, uData, vData, strideY, strideU, strideV, width, height, null);
+  }
+
+  /**
+   * Same as {@link #encodeY420(ByteBuffer, ByteBuffer, ByteBuffer, int, int, int, int, int)}, and
+   * also fills stats.
+   *
+   * @param stats Output parameter whose fields will be populated, or null.
+   */
   public static native byte[] encodeY420(ByteBuffer yData,
                                         ByteBuffer uData,
                                         ByteBuffer vData,
@@ -87,5 +329,6 @@ public class AvifCodec {
                                         int strideU,
                                         int strideV,
                                         int width,
-                                        int height);
+                                        int height,
+                                        Stats stats);
 }